@@ -0,0 +1,448 @@
+/**
+ * @file friture_bench.cpp
+ * @brief Per-stage pipeline benchmarks (Google Benchmark)
+ *
+ * Covers every stage a spectrogram column passes through, parameterized
+ * the way the application varies them:
+ * - FFTProcessor::process / processBatch per FFT size and window
+ * - FrequencyResampler::resample per scale and output height
+ * - ColorTransform::transformColumn / transformColumnDb per height
+ * - SpectrogramImage::addColumn per height and layout
+ * - RingBuffer write / read / readWindow per block size
+ * - Dirty-span texture upload as in FritureApp::renderFrame (SDL software
+ *   renderer; only when built with SDL2)
+ * - WavReader decode per sample format and channel count
+ *
+ * Items are columns (or samples for the ring, frames for WAV decode), so
+ * items_per_second is directly comparable with the budgets quoted in the
+ * class documentation.
+ *
+ * Usage:
+ *   friture_bench --benchmark_out=results.json --benchmark_out_format=json
+ *   scripts/bench_compare.py baseline.json results.json --threshold 10
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/ringbuffer.hpp>
+#include <friture/fft_processor.hpp>
+#include <friture/frequency_resampler.hpp>
+#include <friture/color_transform.hpp>
+#include <friture/spectrogram_image.hpp>
+#include <friture/audio/wav_reader.hpp>
+
+#ifdef FRITURE_BENCH_SDL
+#include <SDL2/SDL.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+
+/**
+ * @brief Deterministic noise + tone test signal
+ */
+std::vector<float> testSignal(size_t count) {
+    std::vector<float> samples(count);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-0.1f, 0.1f);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * 1000.0f * i / SAMPLE_RATE) +
+                     noise(rng);
+    }
+    return samples;
+}
+
+/**
+ * @brief Spectrum-like dB values in [-140, 0]
+ */
+std::vector<float> testDb(size_t count) {
+    std::vector<float> db(count);
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> level(-140.0f, 0.0f);
+    for (float& v : db) {
+        v = level(rng);
+    }
+    return db;
+}
+
+const char* windowName(int64_t window) {
+    return window == 0 ? "Hann" : "Hamming";
+}
+
+// ============================================================================
+// FFT
+// ============================================================================
+
+void BM_FFTProcess(benchmark::State& state) {
+    const size_t fft_size = static_cast<size_t>(state.range(0));
+    const WindowFunction window = state.range(1) == 0 ? WindowFunction::Hann : WindowFunction::Hamming;
+
+    FFTProcessor fft(fft_size, window);
+    std::vector<float> input = testSignal(fft_size);
+    std::vector<float> output(fft.getNumBins());
+
+    for (auto _ : state) {
+        fft.process(input.data(), output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(windowName(state.range(1)));
+}
+BENCHMARK(BM_FFTProcess)
+    ->ArgsProduct({benchmark::CreateRange(256, 16384, 2), {0, 1}})
+    ->ArgNames({"size", "window"});
+
+void BM_FFTProcessBatch(benchmark::State& state) {
+    const size_t fft_size = static_cast<size_t>(state.range(0));
+    const size_t frames = 2 * FFTProcessor::BATCH_FRAMES;
+    const size_t hop = fft_size / 4;
+
+    FFTProcessor fft(fft_size, WindowFunction::Hann);
+    fft.prepareBatch();
+    std::vector<float> input = testSignal((frames - 1) * hop + fft_size);
+    std::vector<float> output(frames * fft.getNumBins());
+
+    for (auto _ : state) {
+        fft.processBatch(input.data(), hop, frames, output.data(), fft.getNumBins());
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * frames);
+}
+BENCHMARK(BM_FFTProcessBatch)->RangeMultiplier(2)->Range(256, 16384)->ArgName("size");
+
+// ============================================================================
+// Frequency Resampling
+// ============================================================================
+
+void BM_Resample(benchmark::State& state) {
+    const FrequencyScale scale = static_cast<FrequencyScale>(state.range(0));
+    const size_t height = static_cast<size_t>(state.range(1));
+    const BinAggregation aggregation = static_cast<BinAggregation>(state.range(2));
+    const size_t fft_size = 4096;
+
+    FrequencyResampler resampler(scale, 20.0f, SAMPLE_RATE / 2.0f, SAMPLE_RATE,
+                                 fft_size, height, aggregation);
+    std::vector<float> input = testDb(fft_size / 2 + 1);
+    std::vector<float> output(height);
+
+    for (auto _ : state) {
+        resampler.resample(input.data(), output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(std::string(toString(scale)) + "/" + toString(aggregation));
+}
+BENCHMARK(BM_Resample)
+    ->ArgsProduct({{0, 1, 2, 3, 4}, {256, 1080}, {0, 1, 2}})
+    ->ArgNames({"scale", "height", "aggregation"});
+
+// ============================================================================
+// Color Transform
+// ============================================================================
+
+void BM_TransformColumn(benchmark::State& state) {
+    const size_t height = static_cast<size_t>(state.range(0));
+    ColorTransform transform(ColorTheme::CMRMAP);
+
+    std::vector<float> normalized = testDb(height);
+    for (float& v : normalized) {
+        v = (v + 140.0f) / 140.0f;
+    }
+    std::vector<uint32_t> colors(height);
+
+    for (auto _ : state) {
+        transform.transformColumn(normalized.data(), height, colors.data());
+        benchmark::DoNotOptimize(colors.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransformColumn)->Arg(512)->Arg(1080)->Arg(2160)->ArgName("height");
+
+void BM_TransformColumnDb(benchmark::State& state) {
+    const size_t height = static_cast<size_t>(state.range(0));
+    ColorTransform transform(ColorTheme::CMRMAP);
+    std::vector<float> db = testDb(height);
+    std::vector<uint32_t> colors(height);
+
+    for (auto _ : state) {
+        transform.transformColumnDb(db.data(), height, -140.0f, 0.0f, colors.data());
+        benchmark::DoNotOptimize(colors.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransformColumnDb)->Arg(512)->Arg(1080)->Arg(2160)->ArgName("height");
+
+// ============================================================================
+// Spectrogram Image
+// ============================================================================
+
+void BM_AddColumn(benchmark::State& state) {
+    const size_t height = static_cast<size_t>(state.range(0));
+    const ImageLayout layout = state.range(1) == 0 ? ImageLayout::ColumnMajor : ImageLayout::RowMajor;
+
+    SpectrogramImage image(1920, height, layout);
+    std::vector<uint32_t> column(height, 0xFF336699u);
+
+    for (auto _ : state) {
+        image.addColumn(column.data(), height);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(layout == ImageLayout::ColumnMajor ? "ColumnMajor" : "RowMajor");
+}
+BENCHMARK(BM_AddColumn)
+    ->ArgsProduct({{512, 1080, 2160}, {0, 1}})
+    ->ArgNames({"height", "layout"});
+
+// ============================================================================
+// Ring Buffer
+// ============================================================================
+
+void BM_RingWrite(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    RingBuffer<float> ring(static_cast<size_t>(SAMPLE_RATE * 10));
+    std::vector<float> block = testSignal(count);
+
+    for (auto _ : state) {
+        ring.write(block.data(), count);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RingWrite)->Arg(512)->Arg(4096)->ArgName("samples");
+
+void BM_RingRead(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    RingBuffer<float> ring(static_cast<size_t>(SAMPLE_RATE * 10));
+    std::vector<float> signal = testSignal(ring.capacity());
+    ring.write(signal.data(), signal.size());
+    std::vector<float> output(count);
+
+    size_t offset = 0;
+    for (auto _ : state) {
+        ring.read(offset, output.data(), count);
+        benchmark::DoNotOptimize(output.data());
+        offset += count / 4;
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RingRead)->Arg(512)->Arg(4096)->Arg(16384)->ArgName("samples");
+
+void BM_RingReadWindow(benchmark::State& state) {
+    const size_t window = static_cast<size_t>(state.range(0));
+    const size_t hop = window / 4;
+    RingBuffer<float> ring(static_cast<size_t>(SAMPLE_RATE * 10));
+    std::vector<float> block = testSignal(hop);
+    std::vector<float> output(window);
+
+    // Keep exactly one hop ahead of the reader, as the live path does
+    RingBuffer<float>::Cursor cursor;
+    std::vector<float> prefill = testSignal(window);
+    ring.write(prefill.data(), window);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ring.readWindow(cursor, output.data(), window, hop));
+        ring.write(block.data(), hop);
+    }
+    state.SetItemsProcessed(state.iterations() * window);
+}
+BENCHMARK(BM_RingReadWindow)->Arg(1024)->Arg(4096)->Arg(16384)->ArgName("window");
+
+// ============================================================================
+// Texture Upload
+// ============================================================================
+
+#ifdef FRITURE_BENCH_SDL
+/**
+ * @brief Dirty-span upload of renderFrame() into a streaming texture
+ *
+ * Uses SDL's software renderer on an offscreen surface, so it runs without
+ * a display and measures the CPU side of SDL_UpdateTexture. range(0)
+ * columns are added per frame (1 = steady scrolling, 1920 = full refresh).
+ */
+void BM_TextureUpload(benchmark::State& state) {
+    const size_t columns = static_cast<size_t>(state.range(0));
+    const size_t width = 1920;
+    const size_t height = 1080;
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(width),
+                                                          static_cast<int>(height), 32,
+                                                          SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = surface ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+    SDL_Texture* texture = renderer ? SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                                        SDL_TEXTUREACCESS_STREAMING,
+                                                        static_cast<int>(width),
+                                                        static_cast<int>(height))
+                                    : nullptr;
+    if (!texture) {
+        state.SkipWithError(SDL_GetError());
+        if (renderer) SDL_DestroyRenderer(renderer);
+        if (surface) SDL_FreeSurface(surface);
+        return;
+    }
+
+    SpectrogramImage image(width, height, ImageLayout::RowMajor);
+    std::vector<uint32_t> column(height, 0xFF336699u);
+    const int pitch = static_cast<int>(image.getRowPitch() * sizeof(uint32_t));
+    image.clearDirty();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (size_t c = 0; c < columns; ++c) {
+            image.addColumn(column.data(), height);
+        }
+        state.ResumeTiming();
+
+        ColumnSpan spans[2];
+        size_t num_spans = image.getDirtySpans(spans);
+        for (size_t i = 0; i < num_spans; ++i) {
+            SDL_Rect rect = {static_cast<int>(spans[i].texture_column), 0,
+                             static_cast<int>(spans[i].count), static_cast<int>(height)};
+            SDL_UpdateTexture(texture, &rect, image.getPixelData() + spans[i].image_column, pitch);
+        }
+        image.clearDirty();
+    }
+    state.SetItemsProcessed(state.iterations() * columns);
+    state.SetBytesProcessed(state.iterations() * columns * height * sizeof(uint32_t));
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+}
+BENCHMARK(BM_TextureUpload)->Arg(1)->Arg(16)->Arg(1920)->ArgName("columns");
+#endif
+
+// ============================================================================
+// WAV Decode
+// ============================================================================
+
+/**
+ * @brief Temporary WAV files, one per format/channel combination
+ *
+ * Each file is written and mapped once, so repeated benchmark runs only
+ * measure decoding.
+ */
+class WavFixtures {
+public:
+    ~WavFixtures() {
+        for (auto& entry : files_) {
+            entry.second.reader->close();
+            std::remove(entry.second.path.c_str());
+        }
+    }
+
+    /**
+     * @brief Get reader of a 10 s test file (written and opened on first use)
+     * @param bits 16, 24 or 32 (32 = IEEE float)
+     * @return Open reader, or nullptr if the file could not be opened
+     */
+    const WavReader* get(int bits, int channels) {
+        int key = bits * 16 + channels;
+        auto it = files_.find(key);
+        if (it == files_.end()) {
+            File file;
+            file.path = (std::filesystem::temp_directory_path() /
+                         ("friture_bench_" + std::to_string(bits) + "_" +
+                          std::to_string(channels) + ".wav")).string();
+            write(file.path, bits, channels);
+            file.reader = std::make_unique<WavReader>();
+            file.reader->open(file.path.c_str());
+            it = files_.emplace(key, std::move(file)).first;
+        }
+        return it->second.reader->isOpen() ? it->second.reader.get() : nullptr;
+    }
+
+private:
+    struct File {
+        std::string path;
+        std::unique_ptr<WavReader> reader;
+    };
+
+    static void write(const std::string& path, int bits, int channels) {
+        const uint32_t frames = static_cast<uint32_t>(SAMPLE_RATE * 10);
+        const uint16_t bytes = static_cast<uint16_t>(bits / 8);
+        const uint32_t data_bytes = frames * channels * bytes;
+        std::vector<float> signal = testSignal(frames);
+
+        std::ofstream f(path, std::ios::binary);
+        auto u32 = [&](uint32_t v) { f.write(reinterpret_cast<const char*>(&v), 4); };
+        auto u16 = [&](uint16_t v) { f.write(reinterpret_cast<const char*>(&v), 2); };
+        f.write("RIFF", 4);
+        u32(36 + data_bytes);
+        f.write("WAVEfmt ", 8);
+        u32(16);
+        u16(bits == 32 ? 3 : 1);  // IEEE float or PCM
+        u16(static_cast<uint16_t>(channels));
+        u32(static_cast<uint32_t>(SAMPLE_RATE));
+        u32(static_cast<uint32_t>(SAMPLE_RATE) * channels * bytes);
+        u16(static_cast<uint16_t>(channels * bytes));
+        u16(static_cast<uint16_t>(bits));
+        f.write("data", 4);
+        u32(data_bytes);
+
+        for (uint32_t i = 0; i < frames; ++i) {
+            for (int c = 0; c < channels; ++c) {
+                if (bits == 32) {
+                    f.write(reinterpret_cast<const char*>(&signal[i]), 4);
+                } else {
+                    int32_t v = static_cast<int32_t>(signal[i] * ((1 << (bits - 1)) - 1));
+                    f.write(reinterpret_cast<const char*>(&v), bytes);  // Little-endian low bytes
+                }
+            }
+        }
+    }
+
+    std::map<int, File> files_;
+};
+
+WavFixtures& wavFixtures() {
+    static WavFixtures fixtures;
+    return fixtures;
+}
+
+void BM_WavDecodeMono(benchmark::State& state) {
+    const int bits = static_cast<int>(state.range(0));
+    const int channels = static_cast<int>(state.range(1));
+    const size_t window = 4096;
+
+    const WavReader* reader = wavFixtures().get(bits, channels);
+    if (!reader) {
+        state.SkipWithError("Could not open test WAV file");
+        return;
+    }
+    std::vector<float> output(window);
+
+    // Walk the file at the default hop, wrapping at the end
+    uint64_t position = 0;
+    for (auto _ : state) {
+        if (position + window > reader->getFrameCount()) {
+            position = 0;
+        }
+        benchmark::DoNotOptimize(reader->readMono(position, output.data(), window));
+        position += window / 4;
+    }
+    state.SetItemsProcessed(state.iterations() * window);
+    state.SetBytesProcessed(state.iterations() * window * channels * (bits / 8));
+}
+BENCHMARK(BM_WavDecodeMono)
+    ->ArgsProduct({{16, 24, 32}, {1, 2}})
+    ->ArgNames({"bits", "channels"});
+
+} // namespace
+
+BENCHMARK_MAIN();
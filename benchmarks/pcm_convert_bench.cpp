@@ -0,0 +1,122 @@
+/**
+ * @file pcm_convert_bench.cpp
+ * @brief Throughput of the PCM to float converters
+ *
+ * Converts a buffer much larger than the last-level cache once per format,
+ * both as plain decode and as fused stereo to mono downmix, and reports
+ * the encoded input bandwidth in MB/s. A memcpy of the same float output
+ * size is printed as the memory-bandwidth reference: a converter close to
+ * it is bound by memory, not by arithmetic.
+ *
+ * Usage: pcm_convert_bench [input_megabytes]   (default 64)
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#include <friture/audio/pcm_convert.hpp>
+#include <friture/simd_kernels.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace friture;
+using pcm::SampleFormat;
+
+namespace {
+
+/**
+ * @brief Run a kernel repeatedly for at least 0.5 s
+ * @return Best seconds per run (least disturbed by other processes)
+ */
+template <typename Kernel>
+double timeBest(Kernel&& kernel) {
+    kernel();  // Fault pages in and warm up
+
+    double best = 1e30;
+    double total = 0.0;
+    int runs = 0;
+    while (total < 0.5 || runs < 3) {
+        auto start = std::chrono::steady_clock::now();
+        kernel();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds);
+        total += seconds;
+        ++runs;
+    }
+    return best;
+}
+
+const char* formatName(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Int16:   return "PCM16";
+        case SampleFormat::Int24:   return "PCM24";
+        case SampleFormat::Int32:   return "PCM32";
+        case SampleFormat::Float32: return "Float32";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = 64;
+    if (argc > 1) {
+        megabytes = std::max(1, std::atoi(argv[1]));
+    }
+    const size_t input_bytes = megabytes * 1024 * 1024;
+
+    std::cout << "=== PCM Conversion Benchmark ===" << std::endl;
+    std::cout << "Kernels: " << simd::toString(simd::activeIsa())
+              << ", input: " << megabytes << " MB per format" << std::endl << std::endl;
+
+    std::vector<uint8_t> input(input_bytes);
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < input.size(); i += 4) {
+        uint32_t r = rng() & 0x3F7FFFFFu;  // Finite, |x| < 2 when read as float
+        std::memcpy(input.data() + i, &r, std::min<size_t>(4, input.size() - i));
+    }
+
+    // Largest output: 16-bit decode writes two floats per input sample pair
+    std::vector<float> output(input_bytes / 2);
+
+    std::cout << std::left << std::setw(10) << "Format"
+              << std::right << std::setw(16) << "decode MB/s"
+              << std::setw(20) << "stereo->mono MB/s" << std::endl;
+
+    for (SampleFormat format : {SampleFormat::Int16, SampleFormat::Int24,
+                                SampleFormat::Int32, SampleFormat::Float32}) {
+        const size_t bytes = pcm::bytesPerSample(format);
+        const size_t samples = input_bytes / bytes / 2 * 2;  // Whole stereo frames
+        const double mb = static_cast<double>(samples * bytes) / 1e6;
+
+        double decode = timeBest([&] {
+            pcm::toFloat(format, input.data(), output.data(), samples);
+        });
+        double mix = timeBest([&] {
+            pcm::toFloatMono(format, input.data(), output.data(), samples / 2, 2);
+        });
+
+        std::cout << std::left << std::setw(10) << formatName(format)
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(16) << mb / decode
+                  << std::setw(20) << mb / mix << std::endl;
+    }
+
+    // Reference: copy the float output of a 32-bit decode
+    const size_t copy_bytes = input_bytes / 4 * 4;
+    double copy = timeBest([&] {
+        std::memcpy(output.data(), input.data(), copy_bytes);
+    });
+    std::cout << std::left << std::setw(10) << "memcpy"
+              << std::right << std::setw(16) << static_cast<double>(copy_bytes) / 1e6 / copy
+              << std::endl;
+
+    return 0;
+}
@@ -196,7 +196,6 @@ void processAudioToSpectrogram(const std::vector<float>& audio_samples,
     std::vector<float> fft_input(settings.fft_size);
     std::vector<float> fft_output(settings.fft_size / 2 + 1);
     std::vector<float> resampled(image_height);
-    std::vector<float> normalized(image_height);
     std::vector<uint32_t> colors(image_height);
 
     // Process each frame
@@ -211,15 +210,10 @@ void processAudioToSpectrogram(const std::vector<float>& audio_samples,
         // Frequency resampling
         freq_resampler.resample(fft_output.data(), resampled.data());
 
-        // Normalize to [0, 1] range
-        for (size_t i = 0; i < image_height; ++i) {
-            normalized[i] = (resampled[i] - settings.spec_min_db) /
-                          (settings.spec_max_db - settings.spec_min_db);
-            normalized[i] = std::clamp(normalized[i], 0.0f, 1.0f);
-        }
-
-        // Color transformation
-        color_transform.transformColumn(normalized.data(), image_height, colors.data());
+        // Normalize + color transformation in one pass
+        color_transform.transformColumnDb(resampled.data(), image_height,
+                                          settings.spec_min_db, settings.spec_max_db,
+                                          colors.data());
 
         // Add column to spectrogram image
         spectrogram.addColumn(colors.data(), image_height);
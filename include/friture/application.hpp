@@ -16,16 +16,46 @@
 #include <friture/settings.hpp>
 #include <friture/ringbuffer.hpp>
 #include <friture/fft_processor.hpp>
+#include <friture/fft_wisdom.hpp>
+#include <friture/processing_chain.hpp>
 #include <friture/frequency_resampler.hpp>
 #include <friture/color_transform.hpp>
 #include <friture/spectrogram_image.hpp>
+#include <friture/spectrogram_history.hpp>
+#include <friture/spectrogram_recording.hpp>
+#include <friture/column_stream.hpp>
+#include <friture/spectrum_views.hpp>
+#include <friture/spsc_queue.hpp>
+#include <friture/level_meter.hpp>
+#include <friture/peak_detector.hpp>
+#include <friture/spectral_averager.hpp>
+#include <friture/multichannel_analyzer.hpp>
+#include <friture/cross_spectrum_analyzer.hpp>
+#include <friture/multi_resolution_analyzer.hpp>
+#include <friture/sliding_dft.hpp>
+#include <friture/zoom_analyzer.hpp>
+#include <friture/column_scheduler.hpp>
+#include <friture/task_pool.hpp>
+#include <friture/stage_profiler.hpp>
+#include <friture/quality_governor.hpp>
 #include <friture/ui/text_renderer.hpp>
+#include <friture/ui/ui_batch.hpp>
+#include <friture/ui/gpu_colormap.hpp>
+#include <friture/ui/spectrum_panel.hpp>
 #include <friture/audio/audio_engine.hpp>
+#include <friture/audio/wav_reader.hpp>
+#include <friture/audio/file_streamer.hpp>
+#include <friture/audio/trigger_capture.hpp>
 
 #include <SDL2/SDL.h>
 #include <memory>
+#include <string>
 #include <vector>
 #include <chrono>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <mutex>
 
 namespace friture {
 
@@ -38,6 +68,15 @@ namespace friture {
  * - User input handling
  * - Frame timing and display
  *
+ * Threading:
+ * - Render thread: SDL events, texture upload, input metering, UI overlay (run())
+ * - Analysis thread: ring buffer → FFT → resample → color (analysisLoop())
+ * - Startup thread: builds the AudioEngine and scans the input devices
+ *   while the window comes up; run() takes the engine over when it is done
+ * - Finished columns travel from analysis to render thread through a
+ *   lock-free SPSC queue, so render stalls never delay analysis and
+ *   large FFTs never eat into the frame budget.
+ *
  * Usage:
  * @code
  * FritureApp app(1920, 1080);
@@ -51,9 +90,11 @@ public:
      * @brief Construct application with window dimensions
      * @param window_width Window width in pixels
      * @param window_height Window height in pixels
+     * @param gpu_colormap Store dB levels and colormap them on the GPU
+     *        (OpenGL renderer only; falls back to CPU colormapping)
      * @throws std::runtime_error if SDL initialization fails
      */
-    FritureApp(int window_width = 1280, int window_height = 720);
+    FritureApp(int window_width = 1280, int window_height = 720, bool gpu_colormap = false);
 
     /**
      * @brief Destructor - cleans up SDL resources
@@ -68,7 +109,14 @@ public:
      * - Event processing (keyboard, mouse, window events)
      * - Audio frame processing (FFT pipeline)
      * - Rendering to screen
-     * - Frame timing (targets 60 FPS)
+     *
+     * Event driven: a frame is drawn only when columns arrived, the UI
+     * changed (keys, window events, quality level) or the idle refresh of
+     * the meter and overlay text is due, and never more often than the
+     * refresh rate / quality frame_interval. In between, the thread sleeps
+     * in SDL_WaitEventTimeout() and is woken by the analysis thread's
+     * column-ready event, so a paused or idle viewer costs almost no CPU
+     * and the frame rate follows the column rate.
      */
     void run();
 
@@ -78,10 +126,27 @@ public:
      * @return true if successful, false on error
      *
      * Loads audio into ring buffer for processing.
-     * Currently supports: 16-bit PCM, mono/stereo, any sample rate
+     * Currently supports: 16-bit PCM, mono/stereo, any sample rate; other
+     * rates are converted to the analysis rate while streaming.
      */
     bool loadAudioFromFile(const char* filename);
 
+    /**
+     * @brief Set the rate the whole pipeline analyzes at
+     * @param rate Rate in Hz, [MIN_ANALYSIS_RATE, MAX_ANALYSIS_RATE]
+     * @return true if applied
+     *
+     * Files and the device are converted to this rate. A rate below the
+     * source rate decimates (e.g. 96 kHz → 24 kHz): the display loses the
+     * bands above the new Nyquist and the FFT work per second drops by
+     * the same factor. A loaded file restarts at the new rate; generated
+     * test signals keep the rate they were made at.
+     */
+    bool setAnalysisRate(float rate);
+
+    static constexpr float MIN_ANALYSIS_RATE = 8000.0f;    ///< Lowest setAnalysisRate()
+    static constexpr float MAX_ANALYSIS_RATE = 192000.0f;  ///< Highest setAnalysisRate()
+
     /**
      * @brief Generate synthetic sine wave for testing
      * @param frequency Frequency in Hz
@@ -105,6 +170,237 @@ public:
      */
     SpectrogramSettings& getSettings() { return settings_; }
 
+    /**
+     * @brief Set live input stream options (buffer size, scheduling)
+     * @param options Options for the audio input stream
+     * @return true if accepted (takes effect on the next/current live stream)
+     *
+     * While the input devices are still being scanned the options are kept
+     * and checked once the engine is ready.
+     */
+    bool setAudioStreamOptions(const AudioStreamOptions& options);
+
+    /**
+     * @brief Set how much live input history the rings keep
+     * @param seconds Ring length per channel (> 0)
+     * @return true if applied; the history kept so far is dropped
+     *
+     * The rings are also the pre-trigger buffer of capture to disk, which
+     * grows them to its pre-trigger time plus CAPTURE_HEADROOM_SECONDS if
+     * they are shorter.
+     */
+    bool setRingDuration(size_t seconds);
+
+    /// Live ring length per channel (seconds) unless set otherwise
+    static constexpr size_t DEFAULT_RING_SECONDS = 10;
+
+    /// Ring time beyond the pre-trigger audio, for the capture writer to lag by
+    static constexpr size_t CAPTURE_HEADROOM_SECONDS = 5;
+
+    /**
+     * @brief Write live input around triggers to WAV files (T key, peak onsets)
+     * @param options Pre/post-trigger times and output directory/prefix
+     * @return true if the options fit the input rings (grown if needed)
+     *
+     * A T key press captures around the newest input; with peak detection
+     * on (K key), every Onset event does too. Capture runs in live mode
+     * only; see TriggerCapture.
+     */
+    bool enableCapture(const TriggerCapture::Options& options);
+
+    /**
+     * @brief Record a Chrome trace of the pipeline stages
+     * @param path JSON file written when run() returns
+     *
+     * Call before run(). Keeps the first TRACE_EVENTS_PER_STAGE scopes of
+     * every stage; the histograms behind the P overlay are always on.
+     */
+    void enableTrace(const std::string& path);
+
+    /// Trace events kept per stage (16 bytes each)
+    static constexpr size_t TRACE_EVENTS_PER_STAGE = 1 << 16;
+
+    /**
+     * @brief Print how long each startup phase took
+     *
+     * Phases are always timed (a clock read each); this prints the table
+     * once startup is over: the first frame with labels is up, the device
+     * scan is done and the neighbour chains are built.
+     */
+    void enableStartupTrace();
+
+    /**
+     * @brief Quit on its own after this long (0 = when the user quits)
+     *
+     * For unattended runs, e.g. the real-time check (--rt-check).
+     */
+    void setRunDuration(double seconds);
+
+    /**
+     * @brief Set the memory budget of the column history (V key)
+     * @param bytes Bytes shared by all history levels
+     * @return true if accepted; history recorded so far is dropped
+     */
+    bool setHistoryMemory(size_t bytes);
+
+    /**
+     * @brief Set frame overlap (O key cycles it)
+     * @param percent Overlap in percent, [0, SpectrogramSettings::MAX_OVERLAP_PERCENT]
+     * @return true if accepted
+     *
+     * Small hops may switch the chain to incremental updates (SlidingDFT).
+     */
+    bool setOverlap(float percent);
+
+    /**
+     * @brief Set the displayed frequency range
+     * @param min_freq Lowest displayed frequency in Hz (> 0)
+     * @param max_freq Highest displayed frequency in Hz (<= Nyquist)
+     * @return true if accepted (see SpectrogramSettings::setFrequencyRange)
+     */
+    bool setFrequencyRange(float min_freq, float max_freq);
+
+    /**
+     * @brief Enable the zoom FFT for narrow ranges (Z key toggles it)
+     * @param enabled Zoom into min_freq..max_freq when the range allows
+     *
+     * Narrow ranges (e.g. 40-400 Hz) get bins up to ZoomAnalyzer::MAX_DECIMATION
+     * times finer than the FFT size alone gives, for a correspondingly
+     * longer analysis window. Wide ranges keep the plain FFT.
+     */
+    void setZoom(bool enabled);
+
+    /**
+     * @brief Select the analysis window
+     * @param window Window function
+     * @param kaiser_beta Kaiser β (used only with WindowFunction::Kaiser)
+     * @return true if accepted (see SpectrogramSettings::setWindow)
+     *
+     * Coefficients come from the shared window table cache, and levels are
+     * corrected for the window's coherent gain, so switching windows
+     * changes leakage and resolution but not the level of a tone.
+     */
+    bool setWindow(WindowFunction window, float kaiser_beta = DEFAULT_KAISER_BETA);
+
+    /**
+     * @brief Apply an A/B/C frequency weighting to the display (W key cycles it)
+     * @param weighting Weighting, or WeightingType::None for a flat response
+     *
+     * The weighting is folded into the resampler's per-row gains, so it
+     * costs nothing per column. The FFT and spectral analysis are unchanged.
+     */
+    void setWeighting(WeightingType weighting);
+
+    /**
+     * @brief Average consecutive columns over time (E key cycles the mode)
+     * @param mode Exponential, Linear (N spectra), PeakHold or None
+     * @param time_seconds Exponential time constant / PeakHold decay time
+     * @param frames Spectra in the Linear average
+     * @return true if the values were valid and applied
+     *
+     * Averages are taken in linear power on the display rows, after
+     * resampling, so every analysis path is covered (see SpectralAverager).
+     */
+    bool setAveraging(AveragingMode mode, float time_seconds, size_t frames);
+
+    /**
+     * @brief Display one column per `hops` analysis hops (X key cycles it)
+     * @param hops Hops per column, in [1, SpectrogramSettings::MAX_COLUMN_DECIMATION]
+     * @return true if hops was valid and applied
+     *
+     * The hops of a column are averaged by the current averaging mode
+     * (their mean power with AveragingMode::None). Fewer columns mean
+     * less colorizing, history, texture upload and recording work, and a
+     * longer time span on screen.
+     */
+    bool setColumnDecimation(size_t hops);
+
+    /**
+     * @brief Show a dual-channel transfer function instead of spectra (F key cycles it)
+     * @param view Magnitude, Phase, Coherence, or TransferView::Off
+     *
+     * Needs live input with at least two channels (--channels 2): channel 0
+     * is the reference, channel 1 the measured signal. Both go through one
+     * complex FFT per hop; the cross and auto spectra are averaged with the
+     * current averaging mode (exponential when it is None, since one hop
+     * always has a coherence of 1) and column decimation does not apply.
+     * Phase (-180..180°) and coherence (0..1) span the displayed dB range.
+     */
+    void setTransferView(TransferView view);
+
+    /**
+     * @brief Set colormap theme and displayed dB range (C, [ and ] keys)
+     * @param theme Palette
+     * @param min_db Level shown as the first palette color
+     * @param max_db Level shown as the last palette color
+     * @return true if the range is valid (see SpectrogramSettings::setAmplitudeRange)
+     *
+     * Everything on screen changes at once: the GPU path applies both at
+     * draw time, the CPU path recolors the image from its stored levels.
+     */
+    bool setColormap(ColorTheme theme, float min_db, float max_db);
+
+    /// Default history budget: for 432 rows and a 1024-sample hop at 48 kHz,
+    /// ~7 min at full resolution and ~1.8 h at the coarsest (16×) level
+    static constexpr size_t DEFAULT_HISTORY_BYTES = size_t{64} << 20;
+
+    /// Shortest file-mode catch-up burst spread over task_pool_; shorter
+    /// ones are not worth waking the workers
+    static constexpr size_t PARALLEL_BURST_COLUMNS = 4 * ProcessingChain::BATCH_COLUMNS;
+
+    /// dB range shift per [ / ] key press
+    static constexpr float DB_RANGE_STEP = 10.0f;
+
+    /**
+     * @brief Record every displayed column to a .frspec file
+     * @param path Output file
+     * @return true if the file was created
+     *
+     * A change of FFT size, scale or frequency range continues in a new
+     * file (path with -2, -3, ... before the extension), since a recording
+     * holds one column format. The recording is finalized when run() returns.
+     */
+    bool startRecording(const std::string& path);
+
+    /**
+     * @brief Finalize the recording (writes its time index)
+     */
+    void stopRecording();
+
+    /**
+     * @brief Publish every displayed column over UDP
+     * @param address IPv4 destination, unicast or multicast group
+     * @param port UDP port
+     * @return true if the socket was opened
+     *
+     * Columns go out at most 50 per second (see ColumnStreamSender), so
+     * the stream costs a few hundred kbit/s whatever the analysis rate.
+     */
+    bool startStreaming(const std::string& address, uint16_t port);
+
+    /**
+     * @brief Show columns from a remote startStreaming() instead of analyzing
+     * @param address Multicast group, or a local address for unicast
+     * @param port UDP port
+     * @return true if the socket was opened
+     *
+     * Call before run(). The analysis thread never starts; scale, range
+     * and FFT size follow the stream, while colormap, dB range and the
+     * history view stay local.
+     */
+    bool startViewing(const std::string& address, uint16_t port);
+
+    /**
+     * @brief Let a QualityGovernor lower display quality when over budget
+     * @param options Budgets and the lowest quality allowed
+     *
+     * Judged once a second from the stage profiler: status and axis text
+     * go first, then the redraw rate, and analysis resamples to fewer rows
+     * when the analysis thread is short of time. The G key toggles it.
+     * @throws std::invalid_argument on invalid options (see QualityGovernor)
+     */
+    void enableQualityGovernor(const QualityGovernor::Options& options);
+
     /**
      * @brief Check if application is running
      * @return true if running, false if quit
@@ -134,6 +430,11 @@ public:
     void cycleInputDevice();
 
 private:
+    /**
+     * @brief Stream wav_reader_ from its start, converted to the analysis rate
+     */
+    void startFileSource();
+
     /**
      * @brief Initialize SDL2 components
      * @throws std::runtime_error on failure
@@ -141,10 +442,58 @@ private:
     void initializeSDL();
 
     /**
-     * @brief Handle SDL events (keyboard, mouse, window)
+     * @brief Create column_queue_ for the image's width and height
+     */
+    void createColumnQueue();
+
+    /**
+     * @brief (Re)create texture_ at the image's size (CPU colormapping)
+     * @throws std::runtime_error if SDL cannot create it
+     */
+    void createSpectrogramTexture();
+
+    /**
+     * @brief Fit the spectrogram to the current window size
+     *
+     * Stops the analysis thread, takes the queued columns, then rescales
+     * the image and the history from their stored levels (rows spread over
+     * task_pool_), reallocates the textures and the column queue, and
+     * switches to chains with the new row count. The chains share the
+     * FFTs already planned, so only their resamplers are new; nothing is
+     * analyzed again. No-op if the size did not change.
+     */
+    void applyWindowSize();
+
+    /**
+     * @brief Handle pending SDL events (keyboard, mouse, window)
      */
     void handleEvents();
 
+    /**
+     * @brief Handle one SDL event
+     *
+     * Any key or window event requests a redraw; column-ready wake-ups
+     * from the analysis thread carry nothing to handle.
+     */
+    void handleEvent(const SDL_Event& event);
+
+    /**
+     * @brief Sleep until an event, a column-ready wake-up or the deadline
+     * @param deadline Latest time to return
+     *
+     * The event that ends the wait is handled before returning.
+     */
+    void waitForWork(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Wake the render thread for a newly queued column
+     *
+     * Called by the analysis thread. Pushes at most one column-ready event
+     * until the render thread re-arms column_wake_pending_ before its next
+     * idle wait, so high column rates do not flood the event queue.
+     */
+    void notifyColumnReady();
+
     /**
      * @brief Process one audio frame through FFT pipeline
      *
@@ -153,32 +502,295 @@ private:
      * 2. FFT processing → spectrum
      * 3. Frequency resampling → screen height
      * 4. Normalize to [0,1]
-     * 5. Color transform → RGBA
-     * 6. Add column to spectrogram image
+     * 5. Color transform → RGBA (or quantize to levels for GPU colormapping)
+     * 6. Push column to the render thread via column_queue_
+     *
+     * In live mode samples are read through live_cursor_, so consecutive
+     * calls analyze consecutive hops; overruns are counted as dropped columns.
+     *
+     * Called from the analysis thread only.
+     *
+     * @return true if a column was computed, false if no complete window is available
      */
-    void processAudioFrame();
+    bool processAudioFrame();
+
+    /**
+     * @brief Process several consecutive file-mode hops in one batched FFT
+     * @param max_columns Maximum columns to compute (<= ProcessingChain::BATCH_COLUMNS)
+     * @return Number of columns computed (0 at end of file)
+     *
+     * Reads all overlapping frames with a single ring buffer read and
+     * transforms them with FFTProcessor::processBatch(). Used for catch-up
+     * bursts; called from the analysis thread only.
+     */
+    size_t processFileBatch(size_t max_columns);
+
+    /**
+     * @brief Compute a long file-mode catch-up burst on every core
+     * @param max_columns Maximum columns to compute
+     * @return Number of columns computed (0 if the burst should run serially)
+     *
+     * Computes at most the columns one FileStreamer::read() can cover
+     * (getMaxWindows()); the caller bursts again for the rest. Reads the whole span once, then task_pool_ spreads BATCH_COLUMNS
+     * chunks over its workers (worker 0 uses active_chain_, the others
+     * burst_chains_ with their own FFTProcessor); each chunk resamples
+     * into its slot of burst_columns_, which are then queued in order.
+     * Declines multi-resolution and sliding-DFT chains, whose state runs
+     * from column to column. Called from the analysis thread only.
+     */
+    size_t processFileBurst(size_t max_columns);
+
+    /**
+     * @brief Copy file-mode samples starting at a position
+     * @param position First sample index
+     * @param output Destination [count]
+     * @param count Number of samples (caller keeps it inside total_audio_samples_)
+     *
+     * Reads from file_streamer_, which decodes the mapped WAV file or
+     * synthesizes the generated signal just ahead of playback.
+     */
+    void readFileSamples(size_t position, float* output, size_t count);
+
+    /**
+     * @brief Analyze the next hop of every live channel in parallel
+     * @return true if a column was computed, false if no complete window is available
+     *
+     * Multichannel counterpart of the live branch of processAudioFrame():
+     * live_cursor_ follows the last channel (published last by the audio
+     * callback), the other channels read the same window, and
+     * active_multichannel_ transforms all of them concurrently before the
+     * combined column is queued. Called from the analysis thread only.
+     */
+    bool processMultichannelFrame();
+
+    /**
+     * @brief Analyze the next hop of the reference and measured channels
+     * @return true if a column was computed, false if no complete window is available
+     *
+     * Transfer function counterpart of processMultichannelFrame():
+     * live_cursor_ follows channel 1, channel 0 reads the same window, and
+     * active_transfer_ adds both to its averages before the selected view
+     * is queued on the dB display scale. Called from the analysis thread only.
+     */
+    bool processTransferFrame();
+
+    /**
+     * @brief Resample, normalize, colorize and queue one spectrum
+     * @param spectrum_db FFT output in dB (fft_size/2 + 1 bins)
+     * @param window_end Stream sample position of the end of its window
+     */
+    void emitColumn(const float* spectrum_db, uint64_t window_end);
+
+    /**
+     * @brief Run the peak detector on one spectrum (if enabled)
+     * @param spectrum_db FFT output in dB (bins of the resampler input range)
+     * @param window_end Stream sample position of the end of its window
+     *
+     * The detector is rebuilt here when FFT size or hop change, like the
+     * burst chains, and its events are moved to peak_events_. Called from
+     * the analysis thread only.
+     */
+    void detectPeaks(const float* spectrum_db, uint64_t window_end);
+
+    /**
+     * @brief Log the peak events queued by the analysis thread (onsets
+     *        trigger capture_)
+     */
+    void drainPeakEvents();
+
+    /**
+     * @brief Start capture_ if capture is enabled and live input runs
+     *        (called with the analysis thread)
+     */
+    void startCapture();
+
+    /**
+     * @brief Log the files capture_ completed since the last call
+     */
+    void reportCaptures();
+
+    /**
+     * @brief Normalize, colorize and queue one display column
+     * @param column_db Column in dB [rows]
+     * @param rows Analysis rows; fewer than the image height are stretched
+     *        to it (coarser analysis from the quality governor)
+     *
+     * With averaging or column decimation on, the column goes through
+     * averageColumn() first and only every column_decimation-th one is
+     * queued.
+     */
+    void queueColumn(const float* column_db, size_t rows);
+
+    /**
+     * @brief Fold one column into the time average (if enabled)
+     * @param column_db Column in dB [rows]; replaced by the averaged column
+     *        when one is due
+     * @param rows Values in the column
+     * @return true if a column is due for display
+     *
+     * Averaging runs on the display rows of every analysis path (FFT,
+     * zoom, multi-resolution, multichannel, bursts), so its cost follows
+     * the image height rather than the FFT size. The averager is rebuilt
+     * here when rows, hop or averaging settings change. Called from the
+     * analysis thread only.
+     */
+    bool averageColumn(const float*& column_db, size_t rows);
+
+    /**
+     * @brief Samples between displayed columns (hop × column decimation)
+     */
+    size_t getColumnHop() const;
+
+    /**
+     * @brief Rows the chains resample to (image height / quality divisor)
+     */
+    size_t getAnalysisHeight() const;
+
+    /**
+     * @brief Build the multichannel analyzer for the current input
+     * @param settings Settings to build for
+     * @return Analyzer, or nullptr unless live input has several channels
+     *
+     * Runs on the UI thread (FFT planning).
+     */
+    std::unique_ptr<MultiChannelAnalyzer> makeMultichannelAnalyzer(
+        const SpectrogramSettings& settings) const;
+
+    /**
+     * @brief Build the transfer function analyzer for the current input
+     * @param settings Settings to build for
+     * @return Analyzer, or nullptr unless settings.transfer is on and live
+     *         input has at least two channels
+     *
+     * Runs on the UI thread (FFT planning).
+     */
+    std::unique_ptr<CrossSpectrumAnalyzer> makeTransferAnalyzer(
+        const SpectrogramSettings& settings) const;
+
+    /**
+     * @brief Analysis thread body
+     *
+     * File mode: advances a sample clock by wall time (while not paused),
+     * asks column_scheduler_ how many hops came due, and calls
+     * processAudioFrame() for each of them. Live mode is paced by the audio
+     * device instead: every complete hop in the ring buffer is analyzed
+     * exactly once. Runs until stopAnalysisThread()
+     * is called.
+     */
+    void analysisLoop();
+
+    /**
+     * @brief Start the analysis thread (no-op if already running)
+     *
+     * Snapshots settings_ into pipeline_settings_ so the worker never
+     * reads settings while the UI thread modifies them.
+     */
+    void startAnalysisThread();
+
+    /**
+     * @brief Stop and join the analysis thread (no-op if not running)
+     *
+     * Must be called before touching any processing component, the
+     * audio position, or the input mode from the UI thread.
+     */
+    void stopAnalysisThread();
+
+    /**
+     * @brief Move finished columns from column_queue_ into spectrogram_image_
+     *
+     * Called from the render thread once per frame.
+     */
+    void drainColumnQueue();
 
     /**
      * @brief Render current spectrogram to screen
      *
-     * Updates SDL texture with spectrogram pixels and renders.
-     * Also draws UI overlay (FPS, settings, etc.)
+     * Uploads the columns added since the last frame into the ring
+     * texture and draws it in two pieces split at the ring seam. With GPU
+     * colormapping the level ring is drawn in one pass by gpu_colormap_,
+     * using the current dB range. Also draws UI overlay (FPS, settings, etc.)
      */
     void renderFrame();
 
+    /**
+     * @brief Move finished (or received) columns into the image
+     *
+     * Runs every loop iteration, also those that wait for the next allowed
+     * redraw, so the column queue never backs up.
+     */
+    void takeColumns();
+
+    /**
+     * @brief Judge the last second of stage timings and apply any change
+     */
+    void updateQualityGovernor();
+
+    /**
+     * @brief Switch to a quality level (rebuilds chains if the row count changes)
+     */
+    void applyQualityLevel(const QualityLevel& level);
+
     /**
      * @brief Draw UI overlay with status info
-     * @param renderer SDL renderer
+     * @param batch Overlay batch; the whole overlay is one flush
      */
-    void drawUI(SDL_Renderer* renderer);
+    void drawUI(UiBatch& batch);
 
     /**
-     * @brief Draw UI fallback without text (colored rectangles)
-     * @param renderer SDL renderer
+     * @brief Queue the UI fallback without text (colored rectangles)
+     * @param batch Untextured overlay batch
      *
      * Used when text rendering is unavailable
      */
-    void drawUIFallback(SDL_Renderer* renderer);
+    void drawUIFallback(UiBatch& batch);
+
+    /**
+     * @brief Queue the per-stage latency overlay (P key)
+     * @param batch Overlay batch bound to the glyph atlas
+     *
+     * Shows p50/p99/max of every profiled stage over the last completed
+     * one-second window.
+     */
+    void drawProfilerOverlay(UiBatch& batch);
+
+    /**
+     * @brief Draw the history window over the live spectrogram
+     *
+     * Re-renders the window from history_ only when it moved or zoomed;
+     * otherwise redraws the cached texture.
+     */
+    void drawHistoryView();
+
+    /**
+     * @brief Draw the spectrum or octave band view over the live image
+     */
+    void drawSpectrumView();
+
+    /**
+     * @brief Handle history view keys (pan, zoom)
+     * @return true if the key was used
+     */
+    bool handleHistoryKey(SDL_Keycode key);
+
+    /**
+     * @brief Column format of the current settings
+     */
+    RecordingHeader makeRecordingHeader() const;
+
+    /**
+     * @brief Continue the recording in a new file if the column format changed
+     */
+    void updateRecordingFormat();
+
+    /**
+     * @brief Send the new column format to stream viewers if it changed
+     */
+    void updateStreamFormat();
+
+    /**
+     * @brief Add the columns received from the stream to the display
+     */
+    void pollViewer();
 
     /**
      * @brief Handle keyboard input
@@ -187,12 +799,97 @@ private:
     void handleKeyboard(const SDL_KeyboardEvent& event);
 
     /**
-     * @brief Update settings and recreate processing components
+     * @brief Switch the pipeline to the chain matching settings_
      *
      * Called when user changes settings (FFT size, frequency scale, etc.)
+     * The chain comes from chain_cache_ (usually prebuilt). If the analysis
+     * thread runs, it is handed over via pending_chain_ and adopted at the
+     * next column boundary; the thread keeps running and history is kept.
      */
     void updateProcessingComponents();
 
+    /**
+     * @brief Take over a chain handed over by updateProcessingComponents()
+     * @return true if the active chain changed
+     *
+     * Called from the analysis thread between columns. Never blocks: if the
+     * UI thread holds the lock, the switch is retried at the next boundary.
+     */
+    bool adoptPendingChain();
+
+    /**
+     * @brief Build chains for the settings one keypress away
+     *
+     * Covers every frequency scale at the current size and the next FFT
+     * size up and down. Runs on the UI thread, from advanceStartup() once
+     * FFT planning is done (or has run too long), then after each settings
+     * change.
+     */
+    void prewarmNeighbourChains();
+
+    // ========================================================================
+    // Startup
+    // ========================================================================
+
+    /**
+     * @brief AudioEngine and device list built by the startup thread
+     */
+    struct AudioInit {
+        std::unique_ptr<AudioEngine> engine;       ///< nullptr if construction failed
+        std::vector<AudioDeviceInfo> devices;
+        std::string error;                         ///< Construction error
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+    };
+
+    /**
+     * @brief Start building the AudioEngine on the startup thread
+     */
+    void beginAudioInit();
+
+    /**
+     * @brief Take over the AudioEngine built by the startup thread
+     * @param wait Block until it is ready (false: only take it if done)
+     * @return true once no engine is being built
+     *
+     * Applies the stream options, analysis rate and ring length set while
+     * it was being built. Until then the input mode is File, so the
+     * analysis thread never looks at audio_engine_.
+     */
+    bool finishAudioInit(bool wait);
+
+    /**
+     * @brief Run the startup work deferred past the first frame (render thread)
+     *
+     * Called every loop iteration until startup_done_: fonts after the
+     * first frame, the neighbour chains once background FFT planning is
+     * over (so they come from wisdom), the engine when it is ready.
+     */
+    void advanceStartup();
+
+    /**
+     * @brief Record the render thread phase since the previous mark
+     */
+    void markStartupPhase(const char* name);
+
+    /**
+     * @brief Record a phase with explicit bounds
+     */
+    void addStartupPhase(const char* name, std::chrono::steady_clock::time_point start,
+                         std::chrono::steady_clock::time_point end, bool background);
+
+    void reportStartup() const;
+
+    /**
+     * @brief One timed startup phase
+     */
+    struct StartupPhase {
+        std::string name;
+        double start_ms;       ///< Since construction began
+        double duration_ms;
+        bool background;       ///< Ran off the render thread
+    };
+
     // ========================================================================
     // Settings and State
     // ========================================================================
@@ -206,9 +903,11 @@ private:
     };
 
     SpectrogramSettings settings_;  ///< Current settings
+    SpectrogramSettings pipeline_settings_;  ///< Settings snapshot owned by analysis thread
     bool running_;                   ///< Application running flag
-    bool paused_;                    ///< Playback paused flag
+    std::atomic<bool> paused_;       ///< Playback paused flag (read by analysis thread)
     bool show_help_;                 ///< Show help overlay
+    bool show_profiler_;             ///< Show per-stage latency overlay
     InputMode input_mode_;           ///< Current input mode
 
     // ========================================================================
@@ -217,7 +916,9 @@ private:
 
     SDL_Window* window_;             ///< SDL window
     SDL_Renderer* renderer_;         ///< SDL renderer
-    SDL_Texture* texture_;           ///< Spectrogram texture
+    SDL_Texture* texture_;           ///< Spectrogram texture (CPU colormapping)
+    std::unique_ptr<GpuColormap> gpu_colormap_;  ///< Level texture + shader (GPU colormapping)
+    bool use_gpu_colormap_;          ///< Columns carry levels, not colors (fixed after init)
     int window_width_;               ///< Window width
     int window_height_;              ///< Window height
 
@@ -225,7 +926,8 @@ private:
     // Audio Data
     // ========================================================================
 
-    std::unique_ptr<RingBuffer<float>> ring_buffer_;  ///< Audio sample buffer (file mode)
+    std::unique_ptr<WavReader> wav_reader_;           ///< Mapped WAV file (streamer source)
+    std::unique_ptr<FileStreamer> file_streamer_;     ///< File mode read-ahead (destroyed before wav_reader_)
     size_t current_audio_position_;  ///< Current read position in audio
     size_t total_audio_samples_;     ///< Total audio samples loaded
 
@@ -233,36 +935,178 @@ private:
     std::unique_ptr<AudioEngine> audio_engine_;       ///< Real-time audio engine
     std::vector<AudioDeviceInfo> available_devices_;  ///< Available input devices
     size_t current_device_index_;                     ///< Currently selected device index
+    std::future<AudioInit> audio_init_;               ///< Engine being built (valid until taken over)
+    size_t ring_seconds_;                             ///< Ring length per channel (applied on takeover)
+    AudioStreamOptions pending_stream_options_;       ///< Stream options set before takeover
+    bool stream_options_pending_;
 
     // ========================================================================
     // Processing Components
     // ========================================================================
 
-    std::unique_ptr<FFTProcessor> fft_processor_;
-    std::unique_ptr<FrequencyResampler> freq_resampler_;
+    std::unique_ptr<FFTWisdom> fft_wisdom_;  ///< Persistent FFTW plans (loaded first)
+    ProcessingChainCache chain_cache_{12};                ///< Prebuilt FFT/resampler chains (UI thread)
+    std::shared_ptr<ProcessingChain> current_chain_;    ///< Chain for settings_ (UI thread)
+    std::shared_ptr<ProcessingChain> active_chain_;     ///< Chain in use (analysis thread while it runs)
+    std::unique_ptr<MultiChannelAnalyzer> active_multichannel_;  ///< Per-channel chains (live, > 1 channel)
+    std::vector<float> multichannel_column_;    ///< Combined column scratch (analysis thread)
+    std::unique_ptr<CrossSpectrumAnalyzer> active_transfer_;  ///< Transfer function (live, >= 2 channels)
+    std::vector<float> expanded_column_;        ///< Coarse column at the image height (analysis thread)
+    std::unique_ptr<SpectralAverager> averager_;  ///< Time averaging / decimation (analysis thread)
+    std::vector<float> averaged_column_;        ///< Averager output (analysis thread)
     std::unique_ptr<ColorTransform> color_transform_;
+    std::unique_ptr<LevelMeter> level_meter_;     ///< Live input meter (render thread)
     std::unique_ptr<SpectrogramImage> spectrogram_image_;
     std::unique_ptr<TextRenderer> text_renderer_;
+    std::unique_ptr<UiBatch> ui_batch_;         ///< Overlay quads and labels of a frame
 
     // ========================================================================
-    // Temporary Buffers (reused each frame)
+    // History (render thread)
     // ========================================================================
 
-    std::vector<float> fft_input_;       ///< FFT input buffer
-    std::vector<float> fft_output_;      ///< FFT output (spectrum)
-    std::vector<float> resampled_;       ///< Resampled spectrum
-    std::vector<float> normalized_;      ///< Normalized [0,1] values
-    std::vector<uint32_t> colors_;       ///< RGBA color column
+    std::unique_ptr<SpectrogramHistory> history_;  ///< Every displayed column, multi-resolution
+    SDL_Texture* history_texture_;       ///< Rendered history window (created on first use)
+    bool history_view_;                  ///< Showing history instead of the live image
+    bool history_dirty_;                 ///< Window changed since history_texture_ was drawn
+    uint64_t history_end_;               ///< Newest column of the window (exclusive)
+    uint64_t history_span_;              ///< Columns in the window
+    size_t history_level_;               ///< Level the window was drawn from
+    std::vector<uint16_t> history_levels_;   ///< Window levels, column-major
+    std::vector<float> history_db_;          ///< One column in dB
+    std::vector<uint32_t> history_colors_;   ///< One column of colors
+    std::vector<uint32_t> history_pixels_;   ///< Window colors, row-major for the texture
+
+    // ========================================================================
+    // Spectrum Views (render thread, fed from the displayed columns)
+    // ========================================================================
+
+    /**
+     * @brief Extra view shown below the live image (S key cycles)
+     */
+    enum class SpectrumView {
+        Off,       ///< Spectrogram only
+        Spectrum,  ///< Latest column as a curve, with peak hold
+        Bands      ///< 1/3-octave band power bars, with peak hold
+    };
+
+    SpectrumView spectrum_view_ = SpectrumView::Off;
+    SpectrumViews spectrum_views_;
+    std::unique_ptr<SpectrumPanel> spectrum_panel_;
+    RecordingHeader spectrum_views_format_;   ///< Row layout spectrum_views_ is configured for
+    std::chrono::steady_clock::time_point spectrum_views_time_;  ///< Last update() (peak decay)
+
+    // ========================================================================
+    // Recording (render thread produces, writer thread encodes)
+    // ========================================================================
+
+    SpectrogramRecorder recorder_;
+    std::string record_path_;            ///< Path given to startRecording()
+    int record_segment_;                 ///< File number after format changes (1 = record_path_)
+
+    // ========================================================================
+    // Network Streaming (render thread sends / receives)
+    // ========================================================================
+
+    ColumnStreamSender stream_sender_;
+    RecordingHeader stream_format_;      ///< Analysis format given to stream_sender_
+    std::unique_ptr<ColumnStreamReceiver> viewer_;  ///< Set in viewer mode (no local analysis)
+    RecordingHeader viewer_format_;      ///< Stream format adopted into settings_
+    std::vector<uint16_t> viewer_levels_;   ///< Received column at the display height
+    std::vector<float> viewer_db_;          ///< Same in dB (CPU colormap)
+    std::vector<uint32_t> viewer_colors_;   ///< Same colorized (CPU colormap)
+
+    // ========================================================================
+    // Analysis Thread
+    // ========================================================================
+
+    /**
+     * @brief One finished column; only the plane the image stores is filled
+     */
+    struct QueuedColumn {
+        std::vector<uint32_t> colors;  ///< RGBA colors (CPU colormapping)
+        std::vector<uint16_t> levels;  ///< Quantized dB levels (GPU colormapping)
+    };
+
+    using ColumnQueue = SpscQueue<QueuedColumn>;
+
+    std::unique_ptr<ColumnQueue> column_queue_;  ///< Finished columns (analysis → render)
+    std::thread analysis_thread_;                ///< DSP worker thread
+    std::atomic<bool> analysis_running_;         ///< Worker keep-running flag
+    ColumnScheduler column_scheduler_;           ///< Hop scheduling (analysis thread only)
+    std::unique_ptr<TaskPool> task_pool_;        ///< Catch-up burst workers (driven by the analysis thread)
+    std::vector<std::unique_ptr<ProcessingChain>> burst_chains_;  ///< Chains of pool workers 1.. (analysis thread)
+    std::vector<float> burst_input_;             ///< Burst samples (analysis thread)
+    std::vector<float> burst_columns_;           ///< Burst columns in dB, column-major (analysis thread)
+    RingBuffer<float>::Cursor live_cursor_;      ///< Live stream position (analysis thread only)
+    uint64_t live_samples_lost_;                 ///< live_cursor_ overrun samples already counted
+    std::atomic<uint64_t> dropped_columns_;      ///< Columns dropped (batch cap or full queue)
+
+    // Chain hand-off (UI → analysis thread)
+    std::mutex chain_mutex_;                     ///< Guards pending_chain_ / pending_settings_
+    std::shared_ptr<ProcessingChain> pending_chain_;  ///< Chain to adopt (or the retired one after a swap)
+    std::unique_ptr<MultiChannelAnalyzer> pending_multichannel_;  ///< Adopted with pending_chain_
+    std::unique_ptr<CrossSpectrumAnalyzer> pending_transfer_;     ///< Adopted with pending_chain_
+    SpectrogramSettings pending_settings_;       ///< Settings matching pending_chain_
+    std::atomic<bool> chain_pending_;            ///< pending_chain_ is waiting to be adopted
+
+    // Tonal peak events (K toggles)
+    std::atomic<bool> peak_detection_;           ///< Detector enabled (set by the UI thread)
+    std::unique_ptr<PeakDetector> peak_detector_;  ///< Follows the active chain (analysis thread)
+    SpscQueue<PeakEvent> peak_events_;           ///< Detector events (analysis → render)
+    std::atomic<uint64_t> dropped_peak_events_;  ///< Events lost to a full peak_events_
+    uint64_t reported_peak_drops_;               ///< dropped_peak_events_ already logged (render thread)
+
+    // Capture to disk around triggers (render thread; lives with the analysis thread)
+    bool capture_enabled_;
+    TriggerCapture::Options capture_options_;
+    std::unique_ptr<TriggerCapture> capture_;    ///< Live mode only; reads the engine rings
+    uint64_t reported_captures_;                 ///< capture_ files already logged
+    std::string capture_error_;                  ///< capture_ error already logged
 
     // ========================================================================
     // Timing
     // ========================================================================
 
     std::chrono::steady_clock::time_point last_frame_time_;
-    std::chrono::steady_clock::time_point last_fft_time_;
+    std::chrono::steady_clock::time_point last_fft_time_;  ///< Analysis thread only
     float fps_;                          ///< Current FPS
     int frame_count_;                    ///< Total frames rendered
 
+    // Event-driven redraw (render thread, except the wake-up flag)
+    bool redraw_requested_;              ///< UI state changed since the last frame
+    bool resize_pending_;                ///< Window resized, image not yet fitted
+    std::chrono::steady_clock::time_point resize_time_;  ///< Last resize event
+    Uint32 column_ready_event_;          ///< Registered SDL event type, (Uint32)-1 if unavailable
+    std::atomic<bool> column_wake_pending_;  ///< A column-ready event is on its way
+
+    // Per-stage latency (analysis stages written by the analysis thread,
+    // render stages by the render thread)
+    StageProfiler profiler_;
+    StageProfileSnapshot profile_baseline_;   ///< Counters at the start of the current window
+    StageProfileSnapshot profile_window_;     ///< Last completed window (render thread)
+    std::chrono::steady_clock::time_point profile_window_start_;
+    std::string trace_path_;                  ///< Chrome trace output ("" = off)
+
+    // Startup phases (render thread)
+    std::chrono::steady_clock::time_point startup_begin_;  ///< Construction began
+    std::chrono::steady_clock::time_point startup_mark_;   ///< End of the last phase
+    std::chrono::steady_clock::time_point planning_start_; ///< Background FFT planning began
+    std::vector<StartupPhase> startup_phases_;
+    bool startup_trace_;              ///< Print the phases when startup is over
+    bool startup_done_;               ///< All deferred startup work finished
+    bool labels_shown_;               ///< A frame with text has been drawn
+    bool chains_prewarmed_;           ///< Neighbour chains built after the first frames
+    bool planning_recorded_;          ///< Background planning phase recorded
+    double run_duration_;             ///< Seconds until run() returns by itself (0 = off)
+
+    // Adaptive quality (render thread)
+    std::unique_ptr<QualityGovernor> governor_;   ///< Set while the governor is on
+    QualityGovernor::Options governor_options_;   ///< Bounds used by the G key
+    QualityLevel quality_;                        ///< Level in effect
+    StageProfileSnapshot governor_baseline_;      ///< Counters at the start of its window
+    std::chrono::steady_clock::time_point governor_window_start_;
+    std::chrono::steady_clock::time_point next_draw_time_;  ///< Earliest next redraw (refresh rate / frame_interval)
+
     // Prevent copying
     FritureApp(const FritureApp&) = delete;
     FritureApp& operator=(const FritureApp&) = delete;
@@ -14,6 +14,8 @@
 
 #include <friture/ringbuffer.hpp>
 #include <friture/audio/audio_device_info.hpp>
+#include <friture/audio/callback_stats.hpp>
+#include <friture/sample_rate_converter.hpp>
 #include <RtAudio.h>
 #include <memory>
 #include <vector>
@@ -22,6 +24,41 @@
 
 namespace friture {
 
+/**
+ * @brief Stream opening options (buffer size, scheduling)
+ *
+ * Maps onto RtAudio::StreamOptions. Changing the options takes effect the
+ * next time the stream is opened.
+ */
+struct AudioStreamOptions {
+    /// Input channels to capture, starting at the device's first channel
+    /// (clamped to what the device has). Each gets its own ring buffer.
+    unsigned int channels = 1;
+
+    /// Frames per callback requested from the device. The API may choose
+    /// another size; see AudioEngine::getBufferSize() after start().
+    size_t buffer_frames = 512;
+
+    /// Number of device buffers (ALSA periods, ASIO/DS buffers); 0 lets
+    /// the API choose. Fewer buffers means lower latency, less headroom.
+    unsigned int number_of_buffers = 0;
+
+    /// RTAUDIO_MINIMIZE_LATENCY: ask the API for its smallest safe latency
+    bool minimize_latency = false;
+
+    /// RTAUDIO_SCHEDULE_REALTIME: run the callback thread SCHED_RR
+    /// (may need rtprio permission; RtAudio falls back silently)
+    bool schedule_realtime = false;
+
+    /// Callback thread priority with schedule_realtime (0 = API default)
+    int priority = 0;
+
+    /// Rate to open the device at (0 = the engine's sample rate). Any other
+    /// rate is converted to the engine's rate in the callback, so the rings
+    /// always hold samples at the analysis rate.
+    unsigned int device_sample_rate = 0;
+};
+
 /**
  * @brief Real-time audio input engine
  *
@@ -29,11 +66,18 @@ namespace friture {
  * enumeration, format conversion, and ring buffer integration.
  *
  * Features:
- * - Thread-safe audio callback
+ * - Wait-free audio callback: copy into the rings and publish, nothing else
+ * - Multichannel capture, de-interleaved into one ring buffer per channel
+ * - Devices at another rate converted to the engine's rate (SampleRateConverter)
  * - Automatic device enumeration
- * - Input level monitoring (RMS)
+ * - Tunable stream options (AudioStreamOptions)
+ * - Wait-free callback telemetry: overflows, duration histogram, latency
  * - Graceful error handling
  *
+ * Metering (RMS, peak, clipping) is not done here; readers run a
+ * LevelMeter on the ring buffer instead, keeping the callback's worst
+ * case small enough for very short device buffers.
+ *
  * Example usage:
  * @code
  * AudioEngine engine(48000, 512);
@@ -48,7 +92,7 @@ class AudioEngine {
 public:
     /**
      * @brief Construct audio engine with parameters
-     * @param sample_rate Desired sample rate (Hz)
+     * @param sample_rate Ring buffer (analysis) sample rate (Hz)
      * @param buffer_size Audio buffer size in frames
      * @param ring_buffer_seconds Size of ring buffer in seconds (default 60s)
      * @throws std::runtime_error if RtAudio initialization fails
@@ -57,6 +101,17 @@ public:
                 size_t buffer_size = 512,
                 size_t ring_buffer_seconds = 60);
 
+    /**
+     * @brief Construct audio engine with full stream options
+     * @param sample_rate Ring buffer (analysis) sample rate (Hz)
+     * @param options Buffer size and scheduling options
+     * @param ring_buffer_seconds Size of ring buffer in seconds
+     * @throws std::runtime_error if RtAudio initialization fails
+     */
+    AudioEngine(size_t sample_rate,
+                const AudioStreamOptions& options,
+                size_t ring_buffer_seconds = 60);
+
     /**
      * @brief Destructor - stops audio stream if running
      */
@@ -105,22 +160,93 @@ public:
     bool isRunning() const;
 
     /**
-     * @brief Get access to the ring buffer
+     * @brief Get access to a channel's ring buffer
+     * @param channel Channel index (< getChannelCount())
      * @return Reference to ring buffer
      *
-     * Thread-safe for reading while audio callback is writing.
+     * Thread-safe for reading while audio callback is writing. Within one
+     * callback the channels are written in order, so once the last
+     * channel's ring holds a sample, every other channel's does too.
+     * start() reallocates the rings (invalidating references) when the
+     * channel count changes.
+     */
+    RingBuffer<float>& getRingBuffer(size_t channel = 0) { return *ring_buffers_[channel]; }
+    const RingBuffer<float>& getRingBuffer(size_t channel = 0) const { return *ring_buffers_[channel]; }
+
+    /**
+     * @brief Get number of captured channels (ring buffers)
+     *
+     * options.channels clamped to the device, once start() succeeded.
+     */
+    size_t getChannelCount() const { return ring_buffers_.size(); }
+
+    /**
+     * @brief Set stream options
+     * @param options New options
+     * @return true if applied (restarting the stream if it was running),
+     *         false if options.buffer_frames is 0 or the restart failed
+     */
+    bool setStreamOptions(const AudioStreamOptions& options);
+
+    /**
+     * @brief Set the ring buffer (analysis) sample rate
+     * @param sample_rate Rate in Hz (> 0)
+     * @return true if applied (restarting the stream if it was running)
+     *
+     * Reallocates the rings, invalidating references to them. With
+     * options.device_sample_rate 0 the device is reopened at this rate.
+     */
+    bool setSampleRate(size_t sample_rate);
+
+    /**
+     * @brief Set how much input history the rings keep
+     * @param seconds Ring length per channel (> 0)
+     * @return true if applied (restarting the stream if it was running)
+     *
+     * The rings are the pre-trigger buffer of capture to disk and the
+     * history analysis can reach back into. Reallocates them, invalidating
+     * references to them and dropping the history.
+     */
+    bool setRingDuration(size_t seconds);
+
+    /**
+     * @brief Get ring length per channel in seconds
+     */
+    size_t getRingDuration() const { return ring_buffer_seconds_; }
+
+    /**
+     * @brief Get requested stream options
      */
-    RingBuffer<float>& getRingBuffer() { return *ring_buffer_; }
-    const RingBuffer<float>& getRingBuffer() const { return *ring_buffer_; }
+    const AudioStreamOptions& getStreamOptions() const { return options_; }
 
     /**
-     * @brief Get current input level (RMS)
-     * @return RMS level in range [0.0, 1.0]
+     * @brief Get number of callbacks that reported an input overflow
      *
-     * Updated in real-time by audio callback.
-     * Useful for input level meters in UI.
+     * Counted by the audio callback instead of logged, since printing is
+     * not real-time safe.
      */
-    float getInputLevel() const { return input_level_.load(); }
+    uint64_t getInputOverflowCount() const {
+        return callback_stats_.getOverflowCount();
+    }
+
+    /**
+     * @brief Get callback telemetry since the stream was last started
+     *
+     * Safe to call from any thread while the stream runs.
+     */
+    CallbackStatsSnapshot getCallbackStats() const {
+        return callback_stats_.getSnapshot();
+    }
+
+    /**
+     * @brief Get input latency of the open stream
+     * @return Seconds from the ADC to the sample reaching the ring buffer
+     *         (API-reported device latency + one callback buffer), 0 if
+     *         the stream is not running
+     */
+    double getInputLatency() const {
+        return input_latency_seconds_.load(std::memory_order_relaxed);
+    }
 
     /**
      * @brief Get last error message
@@ -129,14 +255,22 @@ public:
     std::string getError() const { return error_message_; }
 
     /**
-     * @brief Get current sample rate
+     * @brief Get ring buffer (analysis) sample rate
      * @return Sample rate in Hz
      */
     size_t getSampleRate() const { return sample_rate_; }
 
+    /**
+     * @brief Get rate the device stream runs at
+     * @return options.device_sample_rate, or getSampleRate() if that is 0
+     */
+    size_t getDeviceSampleRate() const {
+        return options_.device_sample_rate ? options_.device_sample_rate : sample_rate_;
+    }
+
     /**
      * @brief Get current buffer size
-     * @return Buffer size in frames
+     * @return Buffer size in frames (as granted by the device once started)
      */
     size_t getBufferSize() const { return buffer_size_; }
 
@@ -162,32 +296,44 @@ private:
      * @brief Process audio samples in callback
      * @param input Interleaved audio samples
      * @param frame_count Number of frames
+     *
+     * Only copies (de-interleaving) into the ring buffers, whose writes
+     * publish the new sample counts; no allocation, locking or logging.
+     * The only per-sample math is the rate conversion of a device opened
+     * at another rate, into buffers sized in start().
      */
     void processAudioCallback(const float* input, unsigned int frame_count);
 
     /**
-     * @brief Calculate RMS level of audio buffer
-     * @param buffer Audio samples
-     * @param count Number of samples
-     * @return RMS level [0.0, 1.0]
+     * @brief Re-create every ring at sample_rate_ × ring_buffer_seconds_
+     *        (stream must be stopped)
      */
-    static float calculateRMS(const float* buffer, size_t count);
+    void reallocateRings();
 
     // RtAudio instance
     std::unique_ptr<RtAudio> audio_;
 
     // Configuration
     size_t sample_rate_;
-    size_t buffer_size_;
+    size_t buffer_size_;            ///< Granted frames per callback
+    AudioStreamOptions options_;    ///< Requested options
+    uint64_t period_ns_;            ///< buffer_size_ in ns (late-callback threshold)
+    size_t ring_buffer_seconds_;    ///< Ring length per channel
     unsigned int current_device_id_;
     bool device_set_;
 
-    // Audio buffer
-    std::unique_ptr<RingBuffer<float>> ring_buffer_;
+    // Audio buffers, one per captured channel
+    std::vector<std::unique_ptr<RingBuffer<float>>> ring_buffers_;
+
+    // Rate conversion (empty when the device runs at sample_rate_)
+    std::vector<std::unique_ptr<SampleRateConverter>> converters_;  ///< One per channel
+    std::vector<float> channel_scratch_;    ///< One de-interleaved device block
+    std::vector<float> converted_scratch_;  ///< Converted samples of one block
 
     // State
     std::atomic<bool> is_running_;
-    std::atomic<float> input_level_;
+    CallbackStats callback_stats_;
+    std::atomic<double> input_latency_seconds_;
     std::string error_message_;
 
     // Prevent copying
@@ -5,17 +5,14 @@
  * Supports loading WAV files in various formats:
  * - PCM 16-bit, 24-bit, 32-bit
  * - IEEE Float 32-bit
- * - Mono and stereo (stereo is converted to mono by averaging channels)
+ * - 1 to MAX_CHANNELS channels, either averaged to mono (load()) or
+ *   kept as separate channels (loadChannels())
  * - Various sample rates (stored as-is, resampling not implemented)
  *
- * Implementation handles:
- * - RIFF chunk-based parsing
- * - Non-standard chunk ordering
- * - Metadata chunks (skipped gracefully)
- * - File validation and error reporting
- *
- * Current limitation: Loads entire file into memory.
- * For large files (>100MB), see TODO.md for streaming implementation notes.
+ * Header parsing and sample decoding are done by WavReader, which maps
+ * the file instead of reading it; the loader decodes the whole data chunk
+ * straight into the output vectors in one pass. Callers that only need
+ * windows of a large file should use WavReader directly.
  *
  * @author Friture C++ Port
  * @date 2025-11-06
@@ -35,7 +32,7 @@ namespace friture {
  */
 struct WavInfo {
     uint32_t sample_rate = 0;        ///< Sample rate in Hz
-    uint16_t channels = 0;            ///< Number of channels (1=mono, 2=stereo)
+    uint16_t channels = 0;            ///< Number of channels (1=mono, 2=stereo, ...)
     uint16_t bits_per_sample = 0;     ///< Bits per sample (16, 24, 32)
     uint16_t audio_format = 0;        ///< Audio format (1=PCM, 3=IEEE float)
     uint32_t num_samples = 0;         ///< Total samples per channel
@@ -73,6 +70,8 @@ struct WavInfo {
  */
 class AudioFileLoader {
 public:
+    static constexpr uint16_t MAX_CHANNELS = 32;  ///< Largest accepted channel count
+
     /**
      * @brief Construct AudioFileLoader
      */
@@ -90,11 +89,21 @@ public:
      * @param sample_rate Output sample rate in Hz
      * @return true on success, false on error
      *
-     * If file is stereo, channels are averaged to mono.
+     * Multichannel files are averaged to mono.
      * All formats are converted to float [-1, 1] range.
      */
     bool load(const char* filename, std::vector<float>& samples, float& sample_rate);
 
+    /**
+     * @brief Load entire WAV file keeping every channel
+     * @param filename Path to WAV file
+     * @param channels Output: one sample vector per channel (normalized to [-1, 1])
+     * @param sample_rate Output sample rate in Hz
+     * @return true on success, false on error
+     */
+    bool loadChannels(const char* filename, std::vector<std::vector<float>>& channels,
+                      float& sample_rate);
+
     /**
      * @brief Get metadata from last loaded file
      * @return WAV file information
@@ -108,64 +117,6 @@ public:
     const std::string& getError() const { return error_; }
 
 private:
-    /**
-     * @brief Parse WAV file header and chunks
-     * @param fp File pointer
-     * @param data_offset Output: offset to audio data
-     * @param data_size Output: size of audio data in bytes
-     * @return true if header is valid
-     */
-    bool parseWavHeader(FILE* fp, size_t& data_offset, size_t& data_size);
-
-    /**
-     * @brief Read RIFF chunk header
-     * @param fp File pointer
-     * @param chunk_id Output: 4-character chunk ID
-     * @param chunk_size Output: chunk size in bytes
-     * @return true on success
-     */
-    bool readChunkHeader(FILE* fp, char chunk_id[4], uint32_t& chunk_size);
-
-    /**
-     * @brief Parse 'fmt ' chunk
-     * @param fp File pointer
-     * @param chunk_size Size of fmt chunk
-     * @return true if format is supported
-     */
-    bool parseFmtChunk(FILE* fp, uint32_t chunk_size);
-
-    /**
-     * @brief Convert PCM 16-bit to float [-1, 1]
-     * @param src Source buffer (16-bit signed integers)
-     * @param dst Destination buffer (float)
-     * @param num_samples Number of samples to convert
-     */
-    void convertPCM16ToFloat(const int16_t* src, float* dst, size_t num_samples);
-
-    /**
-     * @brief Convert PCM 24-bit to float [-1, 1]
-     * @param src Source buffer (packed 24-bit data)
-     * @param dst Destination buffer (float)
-     * @param num_samples Number of samples to convert
-     */
-    void convertPCM24ToFloat(const uint8_t* src, float* dst, size_t num_samples);
-
-    /**
-     * @brief Convert PCM 32-bit to float [-1, 1]
-     * @param src Source buffer (32-bit signed integers)
-     * @param dst Destination buffer (float)
-     * @param num_samples Number of samples to convert
-     */
-    void convertPCM32ToFloat(const int32_t* src, float* dst, size_t num_samples);
-
-    /**
-     * @brief Convert stereo to mono by averaging channels
-     * @param stereo Input stereo samples (interleaved L,R,L,R,...)
-     * @param mono Output mono samples
-     * @param num_frames Number of stereo frames
-     */
-    void stereoToMono(const float* stereo, float* mono, size_t num_frames);
-
     /**
      * @brief Set error message
      * @param message Error description
@@ -0,0 +1,185 @@
+/**
+ * @file callback_stats.hpp
+ * @brief Wait-free audio callback telemetry (xruns, duration histogram)
+ *
+ * CallbackStats is written by the real-time audio callback with relaxed
+ * atomic stores only, and read from any other thread as a snapshot. It
+ * answers "are we dropping input?" (overflow count, frames captured) and
+ * "how much of the buffer period does the callback use?" (log2 duration
+ * histogram, maximum).
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_CALLBACK_STATS_HPP
+#define FRITURE_CALLBACK_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Point-in-time copy of CallbackStats
+ *
+ * Histogram bucket 0 holds callbacks shorter than 2 µs; bucket i > 0 holds
+ * durations in [2^i, 2^(i+1)) µs; the last bucket also collects everything
+ * longer.
+ */
+struct CallbackStatsSnapshot {
+    static constexpr size_t HISTOGRAM_BUCKETS = 16;   ///< Up to ~32 ms resolved
+
+    uint64_t callbacks = 0;         ///< Callbacks recorded
+    uint64_t frames = 0;            ///< Frames delivered by the device
+    uint64_t overflows = 0;         ///< Callbacks flagged RTAUDIO_INPUT_OVERFLOW
+    uint64_t late_callbacks = 0;    ///< Callbacks longer than their buffer period
+    uint64_t max_duration_ns = 0;   ///< Longest callback
+    std::array<uint64_t, HISTOGRAM_BUCKETS> histogram{};  ///< Duration buckets
+
+    /**
+     * @brief Estimate a duration percentile from the histogram
+     * @param fraction Quantile in [0, 1] (0.99 for p99)
+     * @return Upper edge of the bucket holding the quantile (µs), or 0 if
+     *         nothing was recorded
+     *
+     * Buckets are a factor of two wide, so this is an upper bound within 2×.
+     */
+    double percentileMicros(double fraction) const {
+        if (callbacks == 0) {
+            return 0.0;
+        }
+        const double target = fraction * static_cast<double>(callbacks);
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+            cumulative += histogram[i];
+            if (static_cast<double>(cumulative) >= target) {
+                return static_cast<double>(uint64_t{2} << i);
+            }
+        }
+        return static_cast<double>(uint64_t{2} << (HISTOGRAM_BUCKETS - 1));
+    }
+};
+
+/**
+ * @brief Callback counters shared between the audio thread and readers
+ *
+ * Thread Safety:
+ * - record() from exactly one thread (the audio callback); it is wait-free
+ *   (relaxed loads/stores, no read-modify-write loops)
+ * - getSnapshot() from any thread; fields are individually consistent
+ * - reset() only while no callback can run (stream closed)
+ *
+ * Example:
+ * @code
+ * // Audio callback:
+ * auto t0 = std::chrono::steady_clock::now();
+ * ring.write(input, frames);
+ * stats.record(elapsed_ns(t0), frames, status & RTAUDIO_INPUT_OVERFLOW, period_ns);
+ *
+ * // UI thread:
+ * auto s = stats.getSnapshot();
+ * draw("xruns " + std::to_string(s.overflows));
+ * @endcode
+ */
+class CallbackStats {
+public:
+    static constexpr size_t HISTOGRAM_BUCKETS = CallbackStatsSnapshot::HISTOGRAM_BUCKETS;
+
+    CallbackStats() = default;
+
+    /**
+     * @brief Record one callback (audio thread)
+     * @param duration_ns Time spent in the callback
+     * @param frames Frames delivered
+     * @param overflow Device reported an input overflow before this block
+     * @param period_ns Buffer period; longer callbacks count as late (0 = skip)
+     */
+    void record(uint64_t duration_ns, unsigned int frames, bool overflow, uint64_t period_ns) {
+        bump(callbacks_);
+        frames_.store(frames_.load(std::memory_order_relaxed) + frames, std::memory_order_relaxed);
+        if (overflow) {
+            bump(overflows_);
+        }
+        if (period_ns > 0 && duration_ns > period_ns) {
+            bump(late_callbacks_);
+        }
+        if (duration_ns > max_duration_ns_.load(std::memory_order_relaxed)) {
+            max_duration_ns_.store(duration_ns, std::memory_order_relaxed);
+        }
+        bump(histogram_[bucketFor(duration_ns)]);
+    }
+
+    /**
+     * @brief Copy all counters (any thread)
+     */
+    CallbackStatsSnapshot getSnapshot() const {
+        CallbackStatsSnapshot snapshot;
+        snapshot.callbacks = callbacks_.load(std::memory_order_relaxed);
+        snapshot.frames = frames_.load(std::memory_order_relaxed);
+        snapshot.overflows = overflows_.load(std::memory_order_relaxed);
+        snapshot.late_callbacks = late_callbacks_.load(std::memory_order_relaxed);
+        snapshot.max_duration_ns = max_duration_ns_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+            snapshot.histogram[i] = histogram_[i].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    /**
+     * @brief Get overflow count without a full snapshot
+     */
+    uint64_t getOverflowCount() const {
+        return overflows_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Zero all counters (only while the stream is closed)
+     */
+    void reset() {
+        callbacks_.store(0, std::memory_order_relaxed);
+        frames_.store(0, std::memory_order_relaxed);
+        overflows_.store(0, std::memory_order_relaxed);
+        late_callbacks_.store(0, std::memory_order_relaxed);
+        max_duration_ns_.store(0, std::memory_order_relaxed);
+        for (auto& bucket : histogram_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Histogram bucket for a duration
+     */
+    static size_t bucketFor(uint64_t duration_ns) {
+        const uint64_t micros = duration_ns / 1000;
+        if (micros < 2) {
+            return 0;
+        }
+        const size_t bucket = static_cast<size_t>(std::bit_width(micros)) - 1;
+        return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+    }
+
+private:
+    // Single writer: a plain load + store is enough and never spins
+    static void bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> callbacks_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> overflows_{0};
+    std::atomic<uint64_t> late_callbacks_{0};
+    std::atomic<uint64_t> max_duration_ns_{0};
+    std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> histogram_{};
+
+    // Prevent copying (shared with the audio thread)
+    CallbackStats(const CallbackStats&) = delete;
+    CallbackStats& operator=(const CallbackStats&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_CALLBACK_STATS_HPP
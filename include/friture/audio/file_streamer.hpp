@@ -0,0 +1,192 @@
+/**
+ * @file file_streamer.hpp
+ * @brief Producer thread streaming decoded file audio through a ring buffer
+ *
+ * FileStreamer decodes a sample source block by block on its own thread
+ * into a fixed-size RingBuffer, staying at most one buffer ahead of the
+ * reader. Memory use is therefore set by the buffer capacity, not by the
+ * length of the file, and decoding (page faults, PCM conversion, signal
+ * synthesis) overlaps with analysis instead of stalling it.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_FILE_STREAMER_HPP
+#define FRITURE_FILE_STREAMER_HPP
+
+#include <friture/ringbuffer.hpp>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Bounded read-ahead of a sample source for one reader
+ *
+ * The producer fills the ring in blocks of getBlockSize() samples and
+ * blocks (back-pressure) while the next block would overwrite samples at
+ * or after the reader's last read position. read() blocks until the
+ * requested range has been produced.
+ *
+ * Reads are expected to move forward. A read before the previous one, or
+ * far beyond what has been buffered, restarts the producer at that
+ * position (rewind / seek).
+ *
+ * Thread Safety: One reader thread calls read(); start()/stop() must not
+ * race it. The source is called only on the producer thread.
+ *
+ * Example:
+ * @code
+ * FileStreamer streamer(480000);
+ * streamer.start([&](uint64_t pos, float* out, size_t n) {
+ *     return reader.readMono(pos, out, n);
+ * }, reader.getFrameCount());
+ *
+ * for (uint64_t pos = 0; streamer.read(pos, window, 4096); pos += 1024) {
+ *     analyze(window);
+ * }
+ * @endcode
+ */
+class FileStreamer {
+public:
+    /**
+     * @brief Decode callback: fill output with samples [position, position + count)
+     * @return Samples produced (a short count is padded with silence)
+     */
+    using Source = std::function<size_t(uint64_t position, float* output, size_t count)>;
+
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 8192;  ///< Samples decoded per step
+
+    /**
+     * @brief Construct streamer (no source, no thread)
+     * @param capacity Ring buffer size in samples
+     * @param block_size Samples decoded per producer step
+     * @throws std::invalid_argument if block_size is 0 or capacity < 2 × block_size
+     */
+    explicit FileStreamer(size_t capacity, size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    /**
+     * @brief Destructor - stops the producer thread
+     */
+    ~FileStreamer();
+
+    /**
+     * @brief Stream a new source from its beginning
+     * @param source Decode callback (called on the producer thread)
+     * @param length Total samples in the source
+     *
+     * Stops the producer of the previous source first, so whatever that
+     * source referenced may be released once start() returns.
+     */
+    void start(Source source, uint64_t length);
+
+    /**
+     * @brief Stop the producer and drop the source
+     */
+    void stop();
+
+    /**
+     * @brief Copy samples of the source, waiting for the producer if needed
+     * @param position First sample
+     * @param output Destination [count]
+     * @param count Samples to read (<= getMaxRead())
+     * @return true if copied, false if the range ends past the source (or no source)
+     * @throws std::invalid_argument if count > getMaxRead()
+     *
+     * Samples before position are released to the producer.
+     */
+    bool read(uint64_t position, float* output, size_t count);
+
+    /**
+     * @brief Get source length in samples (0 without a source)
+     */
+    uint64_t getLength() const;
+
+    /**
+     * @brief Get end of the samples produced so far
+     */
+    uint64_t getBufferedEnd() const;
+
+    /**
+     * @brief Get number of reads that had to wait for the producer
+     */
+    uint64_t getStallCount() const;
+
+    /**
+     * @brief Get ring buffer capacity in samples
+     */
+    size_t getCapacity() const { return capacity_; }
+
+    /**
+     * @brief Get producer block size in samples
+     */
+    size_t getBlockSize() const { return block_size_; }
+
+    /**
+     * @brief Get largest count accepted by read()
+     */
+    size_t getMaxRead() const { return capacity_ - block_size_; }
+
+    /**
+     * @brief Get most overlapping windows one read() can cover
+     * @param window Samples per window
+     * @param hop Samples between consecutive windows (> 0)
+     * @return Windows whose span (count - 1) · hop + window fits getMaxRead(),
+     *         0 if a single window does not
+     */
+    size_t getMaxWindows(size_t window, size_t hop) const {
+        return window > getMaxRead() ? 0 : (getMaxRead() - window) / hop + 1;
+    }
+
+private:
+    /**
+     * @brief Stop the producer thread (source is kept)
+     */
+    void stopProducer();
+
+    /**
+     * @brief Restart production at a position
+     * @param position First sample the producer decodes
+     */
+    void restartAt(uint64_t position);
+
+    /**
+     * @brief Producer thread body
+     */
+    void producerLoop();
+
+    RingBuffer<float> ring_;        ///< Decoded samples
+    const size_t capacity_;         ///< Ring size in samples
+    const size_t block_size_;       ///< Samples per producer step
+    std::vector<float> block_;      ///< Producer decode buffer
+
+    Source source_;                 ///< Current source (producer thread only while running)
+    uint64_t length_ = 0;           ///< Source length in samples
+
+    // Stream bookkeeping (guarded by mutex_)
+    mutable std::mutex mutex_;
+    std::condition_variable space_cv_;  ///< Reader released space / stop requested
+    std::condition_variable data_cv_;   ///< Producer appended a block
+    uint64_t ring_base_ = 0;        ///< Ring stream index of file_base_
+    uint64_t file_base_ = 0;        ///< Source position the producer started at
+    uint64_t produced_end_ = 0;     ///< End of produced samples (source position)
+    uint64_t reader_pos_ = 0;       ///< Oldest sample the reader may still need
+    uint64_t stalls_ = 0;           ///< Reads that waited for the producer
+    bool stopping_ = false;         ///< Producer exit requested
+
+    std::thread producer_;          ///< Producer thread
+
+    // Prevent copying (owns a thread)
+    FileStreamer(const FileStreamer&) = delete;
+    FileStreamer& operator=(const FileStreamer&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_FILE_STREAMER_HPP
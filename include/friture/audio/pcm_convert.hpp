@@ -0,0 +1,92 @@
+/**
+ * @file pcm_convert.hpp
+ * @brief Little-endian PCM / float sample decoding
+ *
+ * Conversions from the raw sample encodings found in WAV data chunks to
+ * float in [-1, 1). Sources are byte pointers with no alignment
+ * requirement, so they can point straight into a memory-mapped file.
+ *
+ * Each converter has AVX2, NEON and scalar implementations, selected with
+ * the same simd::activeIsa() as the spectrum kernels. 24-bit samples are
+ * unpacked with a byte shuffle (AVX2) or a 3-way de-interleaving load
+ * (NEON). toFloatMono() fuses decoding with the mono downmix so a stereo
+ * file is read once instead of decoded to a temporary and mixed again.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_PCM_CONVERT_HPP
+#define FRITURE_PCM_CONVERT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+namespace pcm {
+
+/**
+ * @brief Encoding of one sample in a data chunk
+ */
+enum class SampleFormat {
+    Int16,    ///< 16-bit signed PCM
+    Int24,    ///< 24-bit signed PCM, packed in 3 bytes
+    Int32,    ///< 32-bit signed PCM
+    Float32   ///< IEEE 754 single precision
+};
+
+/**
+ * @brief Get encoded size of one sample
+ */
+size_t bytesPerSample(SampleFormat format);
+
+/**
+ * @brief Decode 16-bit PCM (scale 1/32768)
+ * @param src Encoded samples (any alignment)
+ * @param dst Output floats
+ * @param count Number of samples
+ */
+void int16ToFloat(const uint8_t* src, float* dst, size_t count);
+
+/**
+ * @brief Decode packed 24-bit PCM (scale 1/2^23)
+ */
+void int24ToFloat(const uint8_t* src, float* dst, size_t count);
+
+/**
+ * @brief Decode 32-bit PCM (scale 1/2^31)
+ */
+void int32ToFloat(const uint8_t* src, float* dst, size_t count);
+
+/**
+ * @brief Copy 32-bit float samples
+ */
+void float32ToFloat(const uint8_t* src, float* dst, size_t count);
+
+/**
+ * @brief Decode samples of any supported format
+ * @param format Encoding of src
+ * @param src Encoded samples (any alignment)
+ * @param dst Output floats
+ * @param count Number of samples
+ */
+void toFloat(SampleFormat format, const uint8_t* src, float* dst, size_t count);
+
+/**
+ * @brief Decode interleaved frames averaged to mono
+ * @param format Encoding of src
+ * @param src Interleaved frames (any alignment)
+ * @param dst Output floats [frames]
+ * @param frames Number of frames
+ * @param channels Samples per frame (1 to 4096)
+ *
+ * Mono and stereo are decoded and mixed in registers. Wider layouts are
+ * decoded in chunks into a stack buffer and averaged, so no call allocates.
+ */
+void toFloatMono(SampleFormat format, const uint8_t* src, float* dst,
+                 size_t frames, size_t channels);
+
+} // namespace pcm
+} // namespace friture
+
+#endif // FRITURE_PCM_CONVERT_HPP
@@ -0,0 +1,216 @@
+/**
+ * @file trigger_capture.hpp
+ * @brief Capture-to-disk of live input around a trigger
+ *
+ * TriggerCapture turns the live input rings into a pre-trigger buffer:
+ * when something interesting happens (a key press, a detected peak), the
+ * last few seconds before it and the audio that follows are written to a
+ * WAV file by a background thread. The audio callback is not involved; it
+ * keeps writing the rings as always, and the capture thread reads them
+ * with its own cursor like any other reader.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_TRIGGER_CAPTURE_HPP
+#define FRITURE_TRIGGER_CAPTURE_HPP
+
+#include <friture/ringbuffer.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief Writes pre- and post-trigger audio from the input rings to WAV
+ *
+ * A trigger at stream position P captures [P - pre_trigger, P +
+ * post_trigger) of every channel into <directory>/<prefix>-NNNN.wav
+ * (32-bit float, interleaved; the first unused number is taken). A
+ * trigger that arrives while a capture runs extends it to its own
+ * post-trigger end, up to max_seconds per file, so a burst of events
+ * lands in one file; a trigger past that limit starts the next file.
+ * Triggers that arrive within one writer poll are merged into the first.
+ *
+ * The writer thread reads chunk_seconds at a time through a
+ * RingBuffer::Cursor and appends them with one fwrite each through a
+ * FILE_BUFFER_BYTES stdio buffer, so the disk sees large sequential
+ * writes. The rings must hold the pre-trigger time plus a chunk; audio
+ * the writer falls too far behind on is skipped (the cursor jumps to the
+ * newest window) and counted in getSamplesLost(). Pre-trigger audio older
+ * than the rings is not available and the capture starts at the oldest
+ * sample they still hold.
+ *
+ * Multichannel rings are published in channel order, so the last ring
+ * decides when a chunk is complete and the others are read at the same
+ * position (as the multichannel analysis does).
+ *
+ * Thread Safety: trigger() may be called from any one thread at a time
+ * (it only stores a position); the getters from any thread. Construction
+ * and destruction from the owning thread; the rings must outlive the
+ * object and must not be reallocated while it exists.
+ *
+ * Example:
+ * @code
+ * TriggerCapture::Options options;
+ * options.directory = "captures";
+ * TriggerCapture capture({&engine.getRingBuffer()}, 48000, options);
+ * // UI thread, on a key press:
+ * capture.trigger();
+ * @endcode
+ */
+class TriggerCapture {
+public:
+    /**
+     * @brief Capture lengths, write size and file naming
+     */
+    struct Options {
+        float pre_trigger_seconds = 5.0f;    ///< Audio kept before the trigger
+        float post_trigger_seconds = 5.0f;   ///< Audio written after the (last) trigger
+        float max_seconds = 60.0f;           ///< Longest file when triggers keep coming
+        float chunk_seconds = 0.5f;          ///< Audio per ring read and fwrite
+        std::string directory = ".";         ///< Existing directory for the files
+        std::string prefix = "capture";      ///< File name prefix
+    };
+
+    static constexpr size_t FILE_BUFFER_BYTES = 1 << 20;   ///< stdio buffer of the writer
+
+    /**
+     * @brief Construct and start the (idle) writer thread
+     * @param channels Ring per channel, all written in lockstep (non-empty)
+     * @param sample_rate Rate of the ring samples (Hz, > 0)
+     * @param options Lengths and naming
+     * @throws std::invalid_argument if there are no channels, the rate is
+     *         0, a length is negative, chunk or max length is not positive,
+     *         max is shorter than pre plus post, or the smallest ring cannot
+     *         hold the pre-trigger time plus one chunk
+     */
+    TriggerCapture(const std::vector<const RingBuffer<float>*>& channels, uint32_t sample_rate,
+                   const Options& options);
+    TriggerCapture(const std::vector<const RingBuffer<float>*>& channels, uint32_t sample_rate)
+        : TriggerCapture(channels, sample_rate, Options{}) {}
+
+    /**
+     * @brief Destructor - calls stop()
+     */
+    ~TriggerCapture();
+
+    /**
+     * @brief Finish a running or requested capture with the audio already
+     *        in the rings and join the writer
+     *
+     * Later triggers are ignored. Safe to call more than once.
+     */
+    void stop();
+
+    /**
+     * @brief Request a capture around a stream position
+     * @param position Trigger position in ring samples (e.g. a PeakEvent
+     *        position of live analysis)
+     *
+     * Returns at once; the writer thread picks the request up.
+     */
+    void trigger(uint64_t position);
+
+    /**
+     * @brief Request a capture around the newest sample in the rings
+     */
+    void trigger();
+
+    /**
+     * @brief Check whether a file is being written
+     */
+    bool isCapturing() const { return capturing_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Number of files completed
+     */
+    uint64_t getCapturesWritten() const { return captures_written_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Samples per channel skipped because the writer fell behind
+     */
+    uint64_t getSamplesLost() const { return samples_lost_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Path of the last completed file (empty before the first)
+     */
+    std::string getLastPath() const;
+
+    /**
+     * @brief Last file error (empty if none)
+     */
+    std::string getError() const;
+
+    const Options& getOptions() const { return options_; }
+    uint32_t getSampleRate() const { return sample_rate_; }
+
+private:
+    static constexpr uint64_t NO_TRIGGER = UINT64_MAX;
+
+    void writerLoop();
+
+    /**
+     * @brief Write one file for a trigger at position
+     * @return A trigger that came too late to extend this file (it starts
+     *         the next one), or NO_TRIGGER
+     */
+    uint64_t capture(uint64_t position);
+
+    /**
+     * @brief Open the next free <prefix>-NNNN.wav and write a placeholder header
+     */
+    bool openFile();
+
+    /**
+     * @brief Patch the header sizes for `frames` frames and close the file
+     */
+    bool closeFile(uint64_t frames);
+
+    void setError(const std::string& message);
+
+    /**
+     * @brief Wait up to the poll interval for stop (or a new trigger)
+     */
+    void wait(bool wake_on_trigger);
+
+    std::vector<const RingBuffer<float>*> channels_;
+    uint32_t sample_rate_;
+    Options options_;
+    size_t pre_samples_;
+    size_t post_samples_;
+    size_t max_samples_;
+    size_t chunk_samples_;
+
+    std::vector<float> scratch_;        ///< One chunk per channel
+    std::vector<float> interleaved_;    ///< One chunk, interleaved
+    std::FILE* file_;
+    std::string path_;
+    unsigned int next_number_;          ///< First file number to try
+
+    std::atomic<uint64_t> pending_trigger_;
+    std::atomic<bool> stop_requested_;
+    std::atomic<bool> capturing_;
+    std::atomic<uint64_t> captures_written_;
+    std::atomic<uint64_t> samples_lost_;
+
+    mutable std::mutex status_mutex_;   ///< Guards last_path_ / error_
+    std::string last_path_;
+    std::string error_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::thread writer_;
+};
+
+} // namespace friture
+
+#endif // FRITURE_TRIGGER_CAPTURE_HPP
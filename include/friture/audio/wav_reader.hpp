@@ -0,0 +1,201 @@
+/**
+ * @file wav_reader.hpp
+ * @brief Memory-mapped WAV reader with on-demand sample decoding
+ *
+ * WavReader maps a WAV file into the address space and decodes only the
+ * frames a caller asks for, so opening an hour-long multichannel
+ * recording costs a header parse, not a full read and conversion. Pages
+ * are faulted in by the OS as windows are requested and can be dropped
+ * again under memory pressure.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_WAV_READER_HPP
+#define FRITURE_WAV_READER_HPP
+
+#include <friture/audio/audio_file_loader.hpp>
+#include <friture/audio/pcm_convert.hpp>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Read-only random access to the frames of a mapped WAV file
+ *
+ * Supports the same encodings as AudioFileLoader (PCM 16/24/32-bit,
+ * IEEE float 32-bit, 1 to AudioFileLoader::MAX_CHANNELS channels), plus
+ * WAVE_FORMAT_EXTENSIBLE headers carrying one of them. A data chunk whose
+ * size field overruns the file (recorders that crashed before patching
+ * the header) is truncated to the bytes present.
+ *
+ * Thread Safety: After open(), the read functions are const and may be
+ * called from several threads at once. open()/close() must not race them.
+ *
+ * Example:
+ * @code
+ * WavReader reader;
+ * if (reader.open("field_recording.wav")) {
+ *     std::vector<float> window(4096);
+ *     for (uint64_t pos = 0; pos + 4096 <= reader.getFrameCount(); pos += 1024) {
+ *         reader.readMono(pos, window.data(), 4096);
+ *         analyze(window);
+ *     }
+ * }
+ * @endcode
+ */
+class WavReader {
+public:
+    /**
+     * @brief Construct reader (no file open)
+     */
+    WavReader();
+
+    /**
+     * @brief Destructor - unmaps the file
+     */
+    ~WavReader();
+
+    /**
+     * @brief Map a file and parse its header
+     * @param filename Path to WAV file
+     * @return true on success, false on error (see getError())
+     *
+     * Closes any previously opened file first.
+     */
+    bool open(const char* filename);
+
+    /**
+     * @brief Unmap the file (safe to call when nothing is open)
+     */
+    void close();
+
+    /**
+     * @brief Check whether a file is open
+     */
+    bool isOpen() const { return data_ != nullptr; }
+
+    /**
+     * @brief Get metadata of the open file
+     */
+    const WavInfo& getInfo() const { return info_; }
+
+    /**
+     * @brief Get number of frames (samples per channel)
+     */
+    uint64_t getFrameCount() const { return frame_count_; }
+
+    /**
+     * @brief Get number of channels
+     */
+    size_t getChannelCount() const { return info_.channels; }
+
+    /**
+     * @brief Get sample rate (Hz)
+     */
+    float getSampleRate() const { return static_cast<float>(info_.sample_rate); }
+
+    /**
+     * @brief Decode frames averaged to mono
+     * @param first_frame Index of the first frame
+     * @param output Destination [count]
+     * @param count Frames wanted
+     * @return Frames decoded (fewer at the end of the file, 0 past it)
+     */
+    size_t readMono(uint64_t first_frame, float* output, size_t count) const;
+
+    /**
+     * @brief Decode one channel
+     * @param channel Channel index (< getChannelCount())
+     * @param first_frame Index of the first frame
+     * @param output Destination [count]
+     * @param count Frames wanted
+     * @return Frames decoded (0 if channel is out of range)
+     */
+    size_t readChannel(size_t channel, uint64_t first_frame, float* output, size_t count) const;
+
+    /**
+     * @brief Decode frames keeping the interleaving
+     * @param first_frame Index of the first frame
+     * @param output Destination [count × channels]
+     * @param count Frames wanted
+     * @return Frames decoded
+     */
+    size_t readInterleaved(uint64_t first_frame, float* output, size_t count) const;
+
+    /**
+     * @brief Let the OS drop mapped pages before a frame
+     * @param frame Frames before this one will not be read again soon
+     *
+     * Keeps the resident set of a front-to-back pass constant: pages are
+     * re-read from the file if those frames are requested later. A call
+     * with an earlier frame (after a rewind) restarts the tracking there.
+     * Must not race reads of the released range.
+     */
+    void releaseBefore(uint64_t frame);
+
+    /**
+     * @brief Get last error message
+     */
+    const std::string& getError() const { return error_; }
+
+private:
+    /**
+     * @brief Parse RIFF header and find the fmt / data chunks
+     * @return true if the file is a supported WAV
+     */
+    bool parseHeader();
+
+    /**
+     * @brief Parse a 'fmt ' chunk body
+     * @param chunk Chunk body
+     * @param size Body size in bytes
+     * @return true if the encoding is supported
+     */
+    bool parseFmtChunk(const uint8_t* chunk, size_t size);
+
+    /**
+     * @brief Clamp a request to the frames present
+     */
+    size_t availableFrames(uint64_t first_frame, size_t count) const;
+
+    /**
+     * @brief Get address of a frame in the data chunk
+     */
+    const uint8_t* frameAddress(uint64_t frame) const {
+        return audio_data_ + frame * frame_bytes_;
+    }
+
+    /**
+     * @brief Set error message
+     */
+    void setError(const std::string& message);
+
+    // Mapping
+    const uint8_t* data_;           ///< Start of the mapped file
+    size_t size_;                   ///< Mapped size in bytes
+#ifdef _WIN32
+    void* file_handle_;             ///< Windows file handle
+    void* mapping_handle_;          ///< Windows file mapping handle
+#endif
+
+    // Format
+    WavInfo info_;                  ///< File metadata
+    pcm::SampleFormat format_;      ///< Sample encoding
+    const uint8_t* audio_data_;     ///< First byte of the data chunk
+    size_t frame_bytes_;            ///< Bytes per interleaved frame
+    uint64_t frame_count_;          ///< Complete frames in the data chunk
+    size_t released_bytes_;         ///< Mapped bytes already handed back to the OS
+    std::string error_;             ///< Last error message
+
+    // Prevent copying (owns the mapping)
+    WavReader(const WavReader&) = delete;
+    WavReader& operator=(const WavReader&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_WAV_READER_HPP
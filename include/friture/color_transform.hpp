@@ -132,6 +132,25 @@ public:
     void transformColumn(const float* input, size_t height,
                         uint32_t* output) const;
 
+    /**
+     * @brief Transform column of dB values to colors in one pass
+     * @param db Input levels in dB
+     * @param height Number of values/pixels in column
+     * @param min_db Level shown as the first palette color
+     * @param max_db Level shown as the last palette color (must be > min_db)
+     * @param output Output RGBA colors (must be pre-allocated)
+     *
+     * Equivalent to normalizing with (db - min_db) / (max_db - min_db),
+     * clamping to [0,1] and calling transformColumn(), but fused into a
+     * single vectorized affine map + clamp + palette lookup, so no
+     * intermediate normalized buffer is needed. Results may differ from
+     * the two-pass path by one palette entry exactly at entry boundaries.
+     *
+     * Note: Input and output buffers must not overlap.
+     */
+    void transformColumnDb(const float* db, size_t height, float min_db, float max_db,
+                           uint32_t* output) const;
+
     /**
      * @brief Change color theme
      * @param theme New color theme
@@ -149,6 +168,14 @@ public:
      */
     ColorTheme getTheme() const { return current_theme_; }
 
+    /**
+     * @brief Get the 256-entry lookup table of the current theme
+     * @return Palette, index 0 = min level, index 255 = max level
+     *
+     * Lets a renderer apply the same colormap itself (e.g. as a GPU texture).
+     */
+    const std::array<uint32_t, 256>& getPalette() const { return color_lut_; }
+
     /**
      * @brief Get luminance of a color
      * @param color RGBA color value
@@ -0,0 +1,163 @@
+/**
+ * @file column_scheduler.hpp
+ * @brief Sample-clock-driven scheduling of spectrogram columns
+ *
+ * This file contains the ColumnScheduler class which decides how many
+ * FFT columns are due for a given sample clock. It replaces "at most one
+ * column per loop iteration" pacing, so the spectrogram time axis stays
+ * correct for any FFT size and hop size.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_COLUMN_SCHEDULER_HPP
+#define FRITURE_COLUMN_SCHEDULER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace friture {
+
+/**
+ * @brief Result of one scheduling step
+ */
+struct ColumnBatch {
+    size_t count = 0;    ///< Columns to compute now (oldest first)
+    size_t dropped = 0;  ///< Columns skipped before them because the batch cap was exceeded
+};
+
+/**
+ * @brief Computes how many hops have come due on a sample clock
+ *
+ * Column k is due once the sample clock reaches (k + 1) × hop_size.
+ * Each call to schedule() returns every column that became due since the
+ * previous call, so a slow caller catches up in one batch instead of
+ * falling behind real time.
+ *
+ * If max_batch is non-zero and more columns are pending than that, the
+ * oldest excess columns are reported as dropped and the caller should skip
+ * their hops. This keeps the display real-time after long stalls (e.g. a
+ * window drag) without computing columns that would scroll off at once.
+ *
+ * Thread Safety: Not thread-safe. Owned by the analysis thread.
+ *
+ * Example:
+ * @code
+ * ColumnScheduler scheduler(settings.getSamplesPerColumn(), 1280);
+ *
+ * // In analysis loop:
+ * ColumnBatch batch = scheduler.schedule(samples_played);
+ * position += batch.dropped * hop;
+ * for (size_t i = 0; i < batch.count; ++i) {
+ *     processColumn(position);
+ *     position += hop;
+ * }
+ * @endcode
+ */
+class ColumnScheduler {
+public:
+    /**
+     * @brief Construct scheduler
+     * @param hop_size Samples between consecutive columns (must be > 0)
+     * @param max_batch Maximum columns per batch (0 = unlimited)
+     * @throws std::invalid_argument if hop_size is 0
+     */
+    explicit ColumnScheduler(size_t hop_size = 1, size_t max_batch = 0) {
+        configure(hop_size, max_batch);
+    }
+
+    /**
+     * @brief Change hop size and batch cap, and reset the clock origin
+     * @param hop_size Samples between consecutive columns (must be > 0)
+     * @param max_batch Maximum columns per batch (0 = unlimited)
+     * @throws std::invalid_argument if hop_size is 0
+     */
+    void configure(size_t hop_size, size_t max_batch) {
+        if (hop_size == 0) {
+            throw std::invalid_argument("Hop size must be > 0");
+        }
+        hop_size_ = hop_size;
+        max_batch_ = max_batch;
+        reset();
+    }
+
+    /**
+     * @brief Restart counting from sample clock 0
+     *
+     * Statistics (getColumnsScheduled/getColumnsDropped) are also cleared.
+     */
+    void reset() {
+        next_column_ = 0;
+        columns_scheduled_ = 0;
+        columns_dropped_ = 0;
+    }
+
+    /**
+     * @brief Get the columns that came due since the previous call
+     * @param sample_clock Samples elapsed since reset() (monotonic)
+     * @return Number of columns to compute and number dropped before them
+     */
+    ColumnBatch schedule(uint64_t sample_clock) {
+        ColumnBatch batch;
+
+        const uint64_t due = sample_clock / hop_size_;
+        if (due <= next_column_) {
+            return batch;
+        }
+
+        uint64_t pending = due - next_column_;
+        if (max_batch_ > 0 && pending > max_batch_) {
+            batch.dropped = static_cast<size_t>(pending - max_batch_);
+            pending = max_batch_;
+        }
+        batch.count = static_cast<size_t>(pending);
+
+        next_column_ = due;
+        columns_scheduled_ += batch.count;
+        columns_dropped_ += batch.dropped;
+        return batch;
+    }
+
+    /**
+     * @brief Get samples remaining until the next column is due
+     * @param sample_clock Current sample clock
+     * @return Sample count (0 if a column is already due)
+     */
+    uint64_t samplesUntilNextColumn(uint64_t sample_clock) const {
+        const uint64_t next_due = (next_column_ + 1) * hop_size_;
+        return (sample_clock >= next_due) ? 0 : next_due - sample_clock;
+    }
+
+    /**
+     * @brief Get hop size in samples
+     */
+    size_t getHopSize() const { return hop_size_; }
+
+    /**
+     * @brief Get batch cap (0 = unlimited)
+     */
+    size_t getMaxBatch() const { return max_batch_; }
+
+    /**
+     * @brief Get total columns handed out for computation since reset()
+     */
+    uint64_t getColumnsScheduled() const { return columns_scheduled_; }
+
+    /**
+     * @brief Get total columns dropped by the batch cap since reset()
+     */
+    uint64_t getColumnsDropped() const { return columns_dropped_; }
+
+private:
+    size_t hop_size_ = 1;            ///< Samples per column
+    size_t max_batch_ = 0;           ///< Batch cap (0 = unlimited)
+    uint64_t next_column_ = 0;       ///< Index of next column not yet handed out
+    uint64_t columns_scheduled_ = 0; ///< Columns handed out since reset
+    uint64_t columns_dropped_ = 0;   ///< Columns dropped since reset
+};
+
+} // namespace friture
+
+#endif // FRITURE_COLUMN_SCHEDULER_HPP
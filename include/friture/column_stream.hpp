@@ -0,0 +1,418 @@
+/**
+ * @file column_stream.hpp
+ * @brief Spectrogram columns over UDP to remote viewers
+ *
+ * A capture box analyzes locally and publishes every displayed column;
+ * viewers in a control room draw them without any DSP of their own. The
+ * columns travel in the same form the recorder stores them (quantized
+ * SpectrogramImage levels, delta and zero-run coded against the previous
+ * column), one datagram per slice of rows, to a multicast group or a
+ * unicast address.
+ *
+ * Datagram layout (all integers little-endian):
+ * @code
+ * Header   24 bytes   "FRSC", version, flags, format generation, level_bits,
+ *                     sequence, timestamp (Unix ms), first_row, row_count
+ * Format   32 bytes   Only with FLAG_FORMAT: fft_size, hop_size, sample_rate,
+ *                     min/max frequency, height, scale, reserved
+ * Payload             Rows first_row.. of the column: zigzag deltas against
+ *                     the previous column (against 0 in keyframes) and
+ *                     zero runs, as LEB128 varints
+ * @endcode
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_COLUMN_STREAM_HPP
+#define FRITURE_COLUMN_STREAM_HPP
+
+#include <friture/spectrogram_recording.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief Turns columns into datagrams
+ *
+ * Every column is split into fixed slices of getRowsPerPacket() rows, so
+ * no datagram exceeds MAX_DATAGRAM bytes even if every row changes.
+ * Every keyframe_interval-th column (and the first after setFormat()) is
+ * a keyframe: coded against 0 and carrying the format, so a viewer can
+ * join at any time and recovers from lost datagrams within one interval.
+ *
+ * Thread Safety: Not thread-safe.
+ *
+ * Example:
+ * @code
+ * ColumnStreamEncoder encoder;
+ * encoder.setFormat(header);
+ * for (const auto& datagram : encoder.encode(levels, now_ms)) {
+ *     send(datagram.data(), datagram.size());
+ * }
+ * @endcode
+ */
+class ColumnStreamEncoder {
+public:
+    static constexpr size_t MAX_DATAGRAM = 1400;    ///< Stays under a 1500-byte Ethernet MTU
+    static constexpr size_t HEADER_BYTES = 24;      ///< Datagram header
+    static constexpr size_t FORMAT_BYTES = 32;      ///< Format block of keyframes
+    static constexpr uint8_t FLAG_KEYFRAME = 1;     ///< Coded against 0 instead of the previous column
+    static constexpr uint8_t FLAG_FORMAT = 2;       ///< Format block follows the header
+
+    /**
+     * @brief Construct encoder
+     * @param keyframe_interval Columns per keyframe (> 0)
+     * @param level_bits Bits sent per level (8-16; 8 gives ~0.6 dB steps)
+     * @throws std::invalid_argument if a parameter is out of range
+     */
+    explicit ColumnStreamEncoder(uint32_t keyframe_interval = 50, uint32_t level_bits = 8);
+
+    /**
+     * @brief Set the column format (starts a new format generation)
+     * @param header Format; level_bits and columns_per_chunk are ignored
+     * @throws std::invalid_argument if height is 0 or above 65535
+     *
+     * The next column is a keyframe.
+     */
+    void setFormat(const RecordingHeader& header);
+
+    /**
+     * @brief Encode one column
+     * @param levels SpectrogramImage levels (format height elements)
+     * @param timestamp_ms Wall-clock time of the column (Unix ms)
+     * @return Datagrams for the column, valid until the next call
+     * @throws std::logic_error if no format is set
+     */
+    const std::vector<std::vector<uint8_t>>& encode(const uint16_t* levels, int64_t timestamp_ms);
+
+    /**
+     * @brief Check whether setFormat() was called
+     */
+    bool hasFormat() const { return format_.height > 0; }
+
+    /**
+     * @brief Get the column format (level_bits as sent)
+     */
+    const RecordingHeader& getFormat() const { return format_; }
+
+    /**
+     * @brief Get rows per datagram
+     */
+    size_t getRowsPerPacket() const { return rows_per_packet_; }
+
+    /**
+     * @brief Get number of columns encoded so far
+     */
+    uint64_t getSequence() const { return sequence_; }
+
+private:
+    uint32_t keyframe_interval_;
+    uint32_t level_bits_;
+    RecordingHeader format_;
+    uint8_t generation_ = 0;                        ///< Increments with every setFormat()
+    size_t rows_per_packet_ = 0;
+    uint64_t sequence_ = 0;                         ///< Next column number
+    uint64_t next_keyframe_ = 0;                    ///< Sequence of the next keyframe
+    std::vector<uint16_t> previous_;                ///< Quantized previous column
+    std::vector<std::vector<uint8_t>> datagrams_;   ///< Output of encode() (capacity reused)
+};
+
+/**
+ * @brief Reassembles columns from datagrams
+ *
+ * Datagrams may arrive lost, duplicated or out of order. A delta slice is
+ * applied only if its rows hold the previous column; otherwise the slice
+ * waits for the next keyframe. A column is complete when all its rows
+ * arrived; columns that never complete count as lost.
+ *
+ * Thread Safety: Not thread-safe.
+ */
+class ColumnStreamDecoder {
+public:
+    ColumnStreamDecoder() = default;
+
+    /**
+     * @brief Process one datagram
+     * @param data Datagram bytes
+     * @param size Datagram size
+     * @return true if it completed a column (see getColumn())
+     *
+     * Malformed datagrams are counted (getRejectedPackets()) and ignored.
+     */
+    bool feed(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Check whether a keyframe with the format has arrived
+     */
+    bool hasFormat() const { return format_.height > 0; }
+
+    /**
+     * @brief Get the sender's column format
+     */
+    const RecordingHeader& getFormat() const { return format_; }
+
+    /**
+     * @brief Get the sender's format generation (changes with the format)
+     */
+    uint8_t getGeneration() const { return generation_; }
+
+    /**
+     * @brief Get the last completed column (SpectrogramImage levels, format height)
+     */
+    const std::vector<uint16_t>& getColumn() const { return column_; }
+
+    /**
+     * @brief Get sender timestamp of the last completed column (Unix ms)
+     */
+    int64_t getTimestamp() const { return timestamp_ms_; }
+
+    /**
+     * @brief Get sender sequence number of the last completed column
+     */
+    uint64_t getSequence() const { return completed_sequence_; }
+
+    /**
+     * @brief Get number of completed columns
+     */
+    uint64_t getColumnCount() const { return columns_; }
+
+    /**
+     * @brief Get number of columns skipped between completed ones
+     */
+    uint64_t getLostColumns() const { return lost_columns_; }
+
+    /**
+     * @brief Get number of malformed or unusable datagrams
+     */
+    uint64_t getRejectedPackets() const { return rejected_; }
+
+private:
+    /**
+     * @brief Adopt a new format and forget all rows
+     */
+    void reset(const RecordingHeader& format, uint8_t generation);
+
+    RecordingHeader format_;
+    uint8_t generation_ = 0;
+    std::vector<uint16_t> rows_;            ///< Quantized rows, newest known value each
+    std::vector<uint32_t> row_sequence_;    ///< Sequence each row's value belongs to (+1; 0: none)
+    std::vector<uint16_t> column_;          ///< Last completed column (levels)
+    std::vector<uint16_t> decoded_;         ///< Slice being decoded
+    uint32_t current_sequence_ = 0;         ///< Column being assembled
+    size_t current_rows_ = 0;               ///< Rows of it received
+    bool have_completed_ = false;
+    uint32_t completed_sequence_ = 0;
+    int64_t timestamp_ms_ = 0;
+    uint64_t columns_ = 0;
+    uint64_t lost_columns_ = 0;
+    uint64_t rejected_ = 0;
+};
+
+/**
+ * @brief Publishes columns to a UDP address
+ *
+ * push() combines columns to at most max_columns_per_second (maximum per
+ * row, so short events survive), which keeps the bandwidth independent of
+ * the sample rate and hop: the format sent has hop_size multiplied by the
+ * number of columns combined. At the defaults a 432-row display of noisy
+ * input costs about 200 kbit/s; steady rows cost next to nothing.
+ *
+ * The socket is non-blocking; a datagram the OS cannot take is dropped
+ * and counted, so push() never stalls the caller.
+ *
+ * Thread Safety: Not thread-safe.
+ *
+ * Example:
+ * @code
+ * ColumnStreamSender sender;
+ * if (!sender.open("239.255.70.82", 7082)) {
+ *     std::cerr << sender.getError() << std::endl;
+ * }
+ * sender.setFormat(header);
+ * sender.push(levels, header.height);   // Every displayed column
+ * @endcode
+ */
+class ColumnStreamSender {
+public:
+    /**
+     * @brief Stream parameters
+     */
+    struct Options {
+        float max_columns_per_second = 50.0f;   ///< Column rate cap (> 0)
+        uint32_t keyframe_interval = 50;        ///< Sent columns per keyframe
+        uint32_t level_bits = 8;                ///< Bits per level (8-16)
+        int multicast_ttl = 1;                  ///< Router hops for multicast (1: local network)
+    };
+
+    /**
+     * @brief Construct a closed sender
+     * @throws std::invalid_argument if an option is out of range
+     */
+    explicit ColumnStreamSender(const Options& options);
+    ColumnStreamSender() : ColumnStreamSender(Options{}) {}
+
+    ~ColumnStreamSender();
+
+    /**
+     * @brief Create the socket
+     * @param address IPv4 destination, unicast or multicast (224.0.0.0/4)
+     * @param port UDP port
+     * @return true on success, false on error (see getError())
+     */
+    bool open(const std::string& address, uint16_t port);
+
+    /**
+     * @brief Close the socket
+     */
+    void close();
+
+    /**
+     * @brief Check whether the socket is open
+     */
+    bool isOpen() const { return socket_ >= 0; }
+
+    /**
+     * @brief Set the format of the pushed columns
+     * @param header Analysis format (hop_size and sample_rate give the column rate)
+     * @return false if the format is invalid (see getError())
+     *
+     * A pending partly combined column is discarded.
+     */
+    bool setFormat(const RecordingHeader& header);
+
+    /**
+     * @brief Add one analysis column
+     * @param levels SpectrogramImage levels
+     * @param height Must equal the format height
+     * @return true if a column was sent
+     */
+    bool push(const uint16_t* levels, size_t height);
+
+    /**
+     * @brief Get analysis columns combined into each sent column
+     */
+    uint32_t getDecimation() const { return decimation_; }
+
+    /**
+     * @brief Get the format as sent (hop_size includes the decimation)
+     */
+    const RecordingHeader& getFormat() const { return encoder_.getFormat(); }
+
+    /**
+     * @brief Get columns sent
+     */
+    uint64_t getColumnsSent() const { return encoder_.getSequence(); }
+
+    /**
+     * @brief Get bytes handed to the socket
+     */
+    uint64_t getBytesSent() const { return bytes_sent_; }
+
+    /**
+     * @brief Get datagrams the socket refused
+     */
+    uint64_t getDroppedPackets() const { return dropped_packets_; }
+
+    /**
+     * @brief Get last error message
+     */
+    const std::string& getError() const { return error_; }
+
+private:
+    Options options_;
+    ColumnStreamEncoder encoder_;
+    intptr_t socket_ = -1;
+    uint8_t destination_[16] = {};          ///< sockaddr_in of the destination
+    uint32_t decimation_ = 1;
+    uint32_t pending_count_ = 0;            ///< Analysis columns in pending_
+    std::vector<uint16_t> pending_;         ///< Per-row maximum of the pending columns
+    uint64_t bytes_sent_ = 0;
+    uint64_t dropped_packets_ = 0;
+    std::string error_;
+
+    // Prevent copying (owns the socket)
+    ColumnStreamSender(const ColumnStreamSender&) = delete;
+    ColumnStreamSender& operator=(const ColumnStreamSender&) = delete;
+};
+
+/**
+ * @brief Receives columns from a ColumnStreamSender
+ *
+ * Thread Safety: Not thread-safe.
+ *
+ * Example:
+ * @code
+ * ColumnStreamReceiver receiver;
+ * receiver.open("239.255.70.82", 7082);
+ * // Every frame:
+ * while (receiver.poll()) {
+ *     const auto& levels = receiver.decoder().getColumn();
+ *     image.addColumnLevels(levels.data(), levels.size());
+ * }
+ * @endcode
+ */
+class ColumnStreamReceiver {
+public:
+    ColumnStreamReceiver() = default;
+    ~ColumnStreamReceiver();
+
+    /**
+     * @brief Bind the port (and join the group if the address is multicast)
+     * @param address Multicast group, or a local IPv4 address ("0.0.0.0": any) for unicast
+     * @param port UDP port
+     * @return true on success, false on error (see getError())
+     */
+    bool open(const std::string& address, uint16_t port);
+
+    /**
+     * @brief Close the socket
+     */
+    void close();
+
+    /**
+     * @brief Check whether the socket is open
+     */
+    bool isOpen() const { return socket_ >= 0; }
+
+    /**
+     * @brief Read pending datagrams until one completes a column
+     * @return true if a column completed (decoder().getColumn()), false once none is pending
+     *
+     * Never blocks.
+     */
+    bool poll();
+
+    /**
+     * @brief Get the decoder (format, last column, loss counters)
+     */
+    const ColumnStreamDecoder& decoder() const { return decoder_; }
+
+    /**
+     * @brief Get bytes received
+     */
+    uint64_t getBytesReceived() const { return bytes_received_; }
+
+    /**
+     * @brief Get last error message
+     */
+    const std::string& getError() const { return error_; }
+
+private:
+    ColumnStreamDecoder decoder_;
+    intptr_t socket_ = -1;
+    std::vector<uint8_t> buffer_;           ///< One datagram
+    uint64_t bytes_received_ = 0;
+    std::string error_;
+
+    // Prevent copying (owns the socket)
+    ColumnStreamReceiver(const ColumnStreamReceiver&) = delete;
+    ColumnStreamReceiver& operator=(const ColumnStreamReceiver&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_COLUMN_STREAM_HPP
@@ -0,0 +1,217 @@
+/**
+ * @file cross_spectrum_analyzer.hpp
+ * @brief Dual-channel analysis: transfer function and coherence
+ *
+ * For measurements with a reference signal x (e.g. the mic at the
+ * speaker, or the generator output) and a measured signal y (the device
+ * under test), CrossSpectrumAnalyzer averages the auto spectra Gxx, Gyy
+ * and the cross spectrum Gxy = X*·Y over time and derives, per bin:
+ * - the H1 transfer function magnitude |Gxy| / Gxx (dB),
+ * - its phase arg Gxy (degrees),
+ * - the coherence |Gxy|² / (Gxx · Gyy), which shows where the estimate
+ *   can be trusted (1 = y is linear in x, 0 = unrelated noise).
+ *
+ * Both real channels go through one complex FFT of the chain's size
+ * (z = x + j·y, separated afterwards by the conjugate symmetry of real
+ * spectra), so a hop costs one transform instead of two.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_CROSS_SPECTRUM_ANALYZER_HPP
+#define FRITURE_CROSS_SPECTRUM_ANALYZER_HPP
+
+#include <friture/types.hpp>
+#include <friture/frequency_resampler.hpp>
+#include <friture/processing_chain.hpp>
+#include <friture/window_functions.hpp>
+#include <fftw3.h>
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Averaged cross and auto spectra of two channels
+ *
+ * Per hop, with w the window and N = key.fft_size:
+ * 1. z[n] = w[n]·(x[n] + j·y[n]), Z = FFT(z) (one complex plan)
+ * 2. X[k] = (Z[k] + Z*[N-k]) / 2, Y[k] = (Z[k] - Z*[N-k]) / 2j
+ * 3. Gxx, Gyy and Gxy averaged in linear power (options.averaging):
+ *    Exponential (time constant, the first hop seeds it; PeakHold is
+ *    treated the same way), Linear (mean of the last options.frames hops)
+ *    or None (the last hop only, so the coherence is 1 everywhere).
+ *
+ * Only the bins the display rows read (getInputRange()) are separated
+ * and averaged. Levels use the same (N · coherent gain)² normalization as
+ * FFTProcessor; H1 and the coherence do not depend on it.
+ *
+ * Display: resample() maps one view to key.height rows with the chain's
+ * scale and range. The magnitude uses key.aggregation; phase (as a unit
+ * vector, so ±180° does not average to 0°) and coherence are interpolated.
+ * Frequency weighting does not apply to a ratio and is ignored, as are
+ * key.zoom and key.multi_resolution.
+ *
+ * All buffers are allocated by the constructor; process() and resample()
+ * do not allocate or lock.
+ *
+ * Thread Safety: Not thread-safe; owned by the analysis thread.
+ *
+ * Example:
+ * @code
+ * CrossSpectrumAnalyzer analyzer(ChainKey::fromSettings(settings, 400));
+ * // Analysis thread, every hop:
+ * reference_ring.readWindow(cursor_x, analyzer.reference_input.data(), n, hop);
+ * measured_ring.readWindow(cursor_y, analyzer.measured_input.data(), n, hop);
+ * analyzer.process();
+ * analyzer.resample(TransferView::Coherence, column.data());
+ * @endcode
+ */
+class CrossSpectrumAnalyzer {
+public:
+    /**
+     * @brief Averaging of the cross and auto spectra
+     */
+    struct Options {
+        AveragingMode averaging = AveragingMode::Exponential;  ///< How hops are combined
+        float time_seconds = 1.0f;   ///< Exponential time constant (s)
+        size_t frames = 8;           ///< Linear: hops in the moving mean
+    };
+
+    /**
+     * @brief Construct analyzer
+     * @param key Chain configuration (fft_size, window, overlap, rate, scale, range, height)
+     * @param options Averaging
+     * @throws std::invalid_argument if the key or options are invalid
+     * @throws std::runtime_error if FFTW initialization fails
+     *
+     * Plans a complex FFT; must not race other FFT planning.
+     */
+    CrossSpectrumAnalyzer(const ChainKey& key, const Options& options);
+    explicit CrossSpectrumAnalyzer(const ChainKey& key)
+        : CrossSpectrumAnalyzer(key, Options{}) {}
+
+    ~CrossSpectrumAnalyzer();
+
+    /**
+     * @brief Get configuration
+     */
+    const ChainKey& getKey() const { return key_; }
+
+    /**
+     * @brief Get averaging options
+     */
+    const Options& getOptions() const { return options_; }
+
+    /**
+     * @brief Get samples between consecutive hops (key.overlap_percent)
+     */
+    size_t getHopSize() const { return hop_size_; }
+
+    /**
+     * @brief Get bins per spectrum (fft_size / 2 + 1)
+     */
+    size_t getNumBins() const { return key_.fft_size / 2 + 1; }
+
+    /**
+     * @brief Get the bins process() computes and the views are valid for
+     */
+    FrequencyResampler::BinRange getInputRange() const { return range_; }
+
+    /**
+     * @brief Get hops in the current average (0 after reset())
+     */
+    size_t getAveragedFrames() const { return count_; }
+
+    /**
+     * @brief Get the display mapping
+     */
+    const FrequencyResampler& resampler() const { return resampler_; }
+
+    /**
+     * @brief Transform both input windows and add them to the averages
+     */
+    void process();
+
+    /**
+     * @brief Forget the averages
+     */
+    void reset();
+
+    /**
+     * @brief Get one view of the averaged spectra per bin
+     * @param view Magnitude (dB), Phase (degrees) or Coherence (0..1)
+     * @param output Destination [getNumBins()]; only getInputRange() is written
+     * @throws std::invalid_argument if view is TransferView::Off
+     */
+    void getSpectrum(TransferView view, float* output) const;
+
+    /**
+     * @brief Map one view of the averaged spectra to the display rows
+     * @param view Magnitude (dB), Phase (degrees) or Coherence (0..1)
+     * @param column Output [key.height]
+     * @throws std::invalid_argument if view is TransferView::Off
+     */
+    void resample(TransferView view, float* column);
+
+    /**
+     * @brief Scale a Phase or Coherence column onto a dB display range
+     * @param view View the column holds (Magnitude columns are left alone)
+     * @param column Values to scale in place
+     * @param rows Values in column
+     * @param min_db Level shown for -180° / coherence 0
+     * @param max_db Level shown for +180° / coherence 1
+     *
+     * Lets those views go through the dB colormap, history and recording
+     * unchanged: the palette spans the full phase or coherence range.
+     */
+    static void toDisplayLevels(TransferView view, float* column, size_t rows,
+                                float min_db, float max_db);
+
+    std::span<float> reference_input;   ///< Reference channel window x [fft_size]
+    std::span<float> measured_input;    ///< Measured channel window y [fft_size]
+
+private:
+    ChainKey key_;                      ///< Configuration
+    Options options_;                   ///< Averaging
+    size_t hop_size_;                   ///< Samples per hop
+    FrequencyResampler resampler_;      ///< Display mapping (no weighting)
+    FrequencyResampler::BinRange range_;  ///< Bins the rows read
+    WindowTable window_;                ///< Shared window coefficients
+    float power_scale_;                 ///< 1 / (N · coherent gain)²
+    double weight_;                     ///< Exponential weight of a new hop
+
+    std::vector<float> inputs_;         ///< Backing store of the input spans [2 × fft_size]
+    fftwf_complex* fft_in_ = nullptr;   ///< Packed windowed input [N]
+    fftwf_complex* fft_out_ = nullptr;  ///< Packed spectrum [N]
+    fftwf_plan plan_ = nullptr;         ///< Complex forward FFT
+
+    // Averages per bin (sums of the last count_ hops in Linear mode)
+    std::vector<double> gxx_;           ///< Reference auto spectrum
+    std::vector<double> gyy_;           ///< Measured auto spectrum
+    std::vector<double> gxy_re_;        ///< Cross spectrum, real part
+    std::vector<double> gxy_im_;        ///< Cross spectrum, imaginary part
+
+    // Linear mode: the last options_.frames hops, 4 values per bin
+    std::vector<float> ring_;           ///< [frames × bins × 4] (Gxx, Gyy, Re, Im)
+    size_t ring_slot_ = 0;              ///< Slot the next hop replaces
+    size_t count_ = 0;                  ///< Hops in the average
+
+    // resample() scratch
+    std::vector<float> spectrum_;       ///< One view per bin [bins]
+    std::vector<float> phase_re_;       ///< Unit phase vector per bin / row
+    std::vector<float> phase_im_;
+    std::vector<float> row_re_;         ///< [height]
+    std::vector<float> row_im_;         ///< [height]
+
+    // Prevent copying (owns an FFTW plan)
+    CrossSpectrumAnalyzer(const CrossSpectrumAnalyzer&) = delete;
+    CrossSpectrumAnalyzer& operator=(const CrossSpectrumAnalyzer&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_CROSS_SPECTRUM_ANALYZER_HPP
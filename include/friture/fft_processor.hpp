@@ -14,6 +14,7 @@
 #define FRITURE_FFT_PROCESSOR_HPP
 
 #include <friture/types.hpp>
+#include <friture/window_functions.hpp>
 #include <fftw3.h>
 #include <vector>
 #include <memory>
@@ -25,12 +26,28 @@ namespace friture {
  * @brief Real-time FFT processor for audio spectrum analysis
  *
  * This class performs FFT processing on audio samples with the following pipeline:
- * 1. Apply window function (Hann or Hamming)
+ * 1. Apply window function (see WindowFunction)
  * 2. Compute real FFT using FFTW3
- * 3. Calculate power spectrum: |FFT|² / N²
+ * 3. Calculate power spectrum: |FFT|² / (N · coherent gain)²
  * 4. Convert to dB scale: 10 * log10(power)
  *
+ * Dividing by the window's coherent gain makes a bin-centred sine of
+ * amplitude A read 20·log10(A/2) dB with every window, so switching
+ * windows does not shift levels (the flat-top window keeps that reading
+ * within 0.01 dB between bins too). Window coefficients come from the
+ * shared windowTable() cache and are never copied per instance.
+ *
+ * Steps 1, 3 and 4 run on SIMD kernels (see simd_kernels.hpp). By default
+ * the dB conversion uses a fast log10 approximation accurate to
+ * simd::FAST_LOG10_MAX_ERROR_DB; setExactLog10(true) selects std::log10.
+ *
+ * Steps 3 and 4 can be limited to a bin range (see
+ * FrequencyResampler::getInputRange()): a display zoomed to 20-2000 Hz at
+ * 48 kHz reads under a tenth of the bins, so the rest are left at the floor.
+ *
  * Thread Safety: Not thread-safe. Create separate instances for concurrent use.
+ * Plan creation is serialized through FFTWisdom::plannerMutex(), so
+ * instances may be constructed on any thread.
  *
  * Performance:
  * - Target: <100 μs for 4096-point FFT
@@ -57,15 +74,18 @@ public:
     /**
      * @brief Construct FFT processor with specified size and window
      * @param fft_size FFT size (must be power of 2, 32-16384)
-     * @param window_type Window function type (Hann or Hamming)
-     * @throws std::invalid_argument if fft_size is invalid
+     * @param window_type Window function type
+     * @param kaiser_beta Kaiser β (used only with WindowFunction::Kaiser)
+     * @throws std::invalid_argument if fft_size or kaiser_beta is invalid
      *
      * This constructor allocates all necessary buffers and creates an
-     * FFTW3 plan using FFTW_MEASURE for optimal performance.
+     * FFTW3 plan using FFTW_MEASURE for optimal performance. The plan is
+     * taken from FFTW wisdom when available (see FFTWisdom).
      *
      * Valid FFT sizes: 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192, 16384
      */
-    FFTProcessor(size_t fft_size, WindowFunction window_type);
+    FFTProcessor(size_t fft_size, WindowFunction window_type,
+                 float kaiser_beta = DEFAULT_KAISER_BETA);
 
     /**
      * @brief Destructor - cleans up FFTW resources
@@ -83,7 +103,7 @@ public:
      * Pipeline:
      * 1. Apply window function to input
      * 2. Compute real FFT
-     * 3. Calculate power spectrum: |FFT|² / N²
+     * 3. Calculate power spectrum: |FFT|² / (N · coherent gain)²
      * 4. Convert to dB: 10 * log10(power + epsilon)
      *
      * Performance: <100 μs for 4096-point FFT (typical: 30-40 μs)
@@ -93,6 +113,73 @@ public:
      */
     void process(const float* input, float* output);
 
+    /**
+     * @brief Process audio samples, converting only a range of bins to dB
+     * @param input Input samples (must be fft_size length)
+     * @param output Output spectrum in dB (must be fft_size/2 + 1 length)
+     * @param first_bin First bin to compute
+     * @param end_bin One past the last bin to compute (<= fft_size/2 + 1)
+     * @throws std::invalid_argument if first_bin > end_bin or end_bin exceeds the bins
+     *
+     * Bins [first_bin, end_bin) get the same values as process(); all other
+     * bins are set to the floor, 10 * log10(epsilon).
+     */
+    void process(const float* input, float* output, size_t first_bin, size_t end_bin);
+
+    /**
+     * @brief Process a frame stored in two pieces (e.g. wrapped ring memory)
+     * @param first First part of the frame
+     * @param first_count Samples in first (<= fft_size)
+     * @param second Remaining fft_size - first_count samples (may be null if none)
+     * @param output Output spectrum in dB (must be fft_size/2 + 1 length)
+     * @throws std::invalid_argument if first_count > fft_size
+     *
+     * Same result as process() on the concatenated frame; the window is
+     * applied to each piece directly, so no staging copy is needed. Pairs
+     * with SpscRingBuffer::peek().
+     */
+    void processSplit(const float* first, size_t first_count, const float* second, float* output);
+
+    /**
+     * @brief Process many overlapping frames to a [frames × bins] dB matrix
+     * @param input Input samples ((num_frames - 1) * hop + fft_size length)
+     * @param hop Samples between the starts of consecutive frames (must be > 0)
+     * @param num_frames Number of frames to transform
+     * @param output Output matrix; frame f starts at output + f * out_stride
+     * @param out_stride Floats between consecutive output rows (must be >= getNumBins())
+     * @throws std::invalid_argument if hop is 0 or out_stride < getNumBins()
+     *
+     * Produces the same values as calling process() once per frame, but
+     * windows frames straight into one contiguous block and transforms
+     * BATCH_FRAMES of them per fftwf_plan_many_dft_r2c execution. Use for
+     * offline rendering and catch-up bursts where many frames are due at once.
+     *
+     * The batch plan is created on first use (FFTW_MEASURE), so the first
+     * call is slower; FFTW planning must not run concurrently on other threads.
+     */
+    void processBatch(const float* input, size_t hop, size_t num_frames,
+                      float* output, size_t out_stride);
+
+    /**
+     * @brief Batched processing, converting only a range of bins to dB
+     * @param first_bin First bin to compute
+     * @param end_bin One past the last bin to compute (<= fft_size/2 + 1)
+     * @throws std::invalid_argument as processBatch(), or if the bin range is invalid
+     *
+     * Other parameters and results as processBatch(); bins outside the
+     * range are set to the floor as in the ranged process().
+     */
+    void processBatch(const float* input, size_t hop, size_t num_frames,
+                      float* output, size_t out_stride, size_t first_bin, size_t end_bin);
+
+    /**
+     * @brief Create the batch plan now instead of on the first processBatch()
+     * @throws std::runtime_error if FFTW initialization fails
+     *
+     * No-op if the plan already exists.
+     */
+    void prepareBatch();
+
     /**
      * @brief Change FFT size dynamically
      * @param new_size New FFT size (must be valid: power of 2, 32-16384)
@@ -106,10 +193,43 @@ public:
     /**
      * @brief Change window function
      * @param type New window function type
+     * @param kaiser_beta Kaiser β (used only with WindowFunction::Kaiser)
+     * @throws std::invalid_argument if kaiser_beta is invalid
+     *
+     * Picks up the shared coefficient table: no computation for a window
+     * any processor has used before.
+     */
+    void setWindowFunction(WindowFunction type, float kaiser_beta = DEFAULT_KAISER_BETA);
+
+    /**
+     * @brief Get current window function type
+     */
+    WindowFunction getWindowFunction() const { return window_type_; }
+
+    /**
+     * @brief Get current Kaiser β (meaningful only for WindowFunction::Kaiser)
+     */
+    float getKaiserBeta() const { return kaiser_beta_; }
+
+    /**
+     * @brief Get the shared window table in use
+     */
+    const WindowTable& getWindow() const { return window_; }
+
+    /**
+     * @brief Choose exact std::log10 or the fast approximation for dB conversion
+     * @param exact true for std::log10, false for simd fast log10 (default)
      *
-     * Recomputes window coefficients. Relatively cheap operation.
+     * The fast path is within simd::FAST_LOG10_MAX_ERROR_DB of the exact
+     * result; use exact mode when validating against reference data.
      */
-    void setWindowFunction(WindowFunction type);
+    void setExactLog10(bool exact) { exact_log10_ = exact; }
+
+    /**
+     * @brief Check whether exact std::log10 is used
+     * @return true if exact mode is enabled
+     */
+    bool isExactLog10() const { return exact_log10_; }
 
     /**
      * @brief Get current FFT size
@@ -128,6 +248,8 @@ public:
      */
     size_t getNumBins() const { return fft_size_ / 2 + 1; }
 
+    static constexpr size_t BATCH_FRAMES = 16;  ///< Frames per batched FFTW execution
+
 private:
     /**
      * @brief Initialize FFTW3 plan and allocate buffers
@@ -135,6 +257,27 @@ private:
      */
     void initialize();
 
+    /**
+     * @brief Allocate batch buffers and create the many-frame plan
+     * @throws std::runtime_error if FFTW initialization fails
+     */
+    void initializeBatch();
+
+    /**
+     * @brief Convert one FFTW spectrum to dB
+     * @param spectrum FFT output [fft_size_/2 + 1]
+     * @param output dB values [fft_size_/2 + 1]
+     * @param first_bin First bin converted; bins before it are set to the floor
+     * @param end_bin One past the last bin converted; bins from it on are set to the floor
+     */
+    void spectrumToDb(const fftwf_complex* spectrum, float* output,
+                      size_t first_bin, size_t end_bin) const;
+
+    /**
+     * @brief Throw std::invalid_argument unless first_bin <= end_bin <= bins
+     */
+    void validateBinRange(size_t first_bin, size_t end_bin) const;
+
     /**
      * @brief Clean up FFTW3 resources
      *
@@ -143,16 +286,20 @@ private:
     void cleanup();
 
     /**
-     * @brief Compute window function coefficients
+     * @brief Release the batch plan and buffers only
      *
-     * Fills window_ vector with appropriate coefficients based on window_type_.
-     *
-     * Hann window: w[n] = 0.5 * (1 - cos(2π*n/(N-1)))
-     * Hamming window: w[n] = 0.54 - 0.46 * cos(2π*n/(N-1))
+     * Used when initializeBatch() fails, so process() keeps working on the
+     * single-frame plan. Safe to call multiple times.
+     */
+    void cleanupBatch();
+
+    /**
+     * @brief Fetch the shared window table and derive the power scale
      *
-     * Both windows have good frequency resolution and sidelobe suppression.
+     * Sets window_ from windowTable() for window_type_, fft_size_ and
+     * kaiser_beta_, and power_scale_ to 1 / (N · coherent gain)².
      */
-    void computeWindow();
+    void loadWindow();
 
     /**
      * @brief Validate FFT size
@@ -166,15 +313,23 @@ private:
     // Configuration
     size_t fft_size_;              ///< FFT size in samples
     WindowFunction window_type_;   ///< Current window function type
+    float kaiser_beta_;            ///< Kaiser β (Kaiser window only)
+    bool exact_log10_;             ///< Use std::log10 instead of fast approximation
 
-    // Pre-computed window coefficients
-    std::vector<float> window_;    ///< Window function coefficients [fft_size_]
+    // Shared window coefficients
+    WindowTable window_;           ///< Window coefficients [fft_size_] (shared, read-only)
+    float power_scale_;            ///< 1 / (N · coherent gain)²
 
     // FFTW3 buffers and plan
     float* fftw_input_;            ///< FFTW input buffer (aligned) [fft_size_]
     fftwf_complex* fftw_output_;   ///< FFTW output buffer (aligned) [fft_size_/2 + 1]
     fftwf_plan fft_plan_;          ///< FFTW plan handle
 
+    // Batched processing (allocated on first processBatch())
+    float* batch_input_;           ///< Windowed frames [BATCH_FRAMES × fft_size_]
+    fftwf_complex* batch_output_;  ///< Spectra [BATCH_FRAMES × (fft_size_/2 + 1)]
+    fftwf_plan batch_plan_;        ///< fftwf_plan_many_dft_r2c over BATCH_FRAMES frames
+
     // Constants
     static constexpr float EPSILON = 1e-30f;  ///< Small value to avoid log(0)
 
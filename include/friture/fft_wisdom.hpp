@@ -0,0 +1,147 @@
+/**
+ * @file fft_wisdom.hpp
+ * @brief Persistent FFTW wisdom cache and background pre-planning
+ *
+ * FFTW_MEASURE planning of large transforms takes long enough to stall the
+ * UI when the FFT size changes. This file contains the FFTWisdom class,
+ * which loads accumulated wisdom from a per-user cache file, pre-plans
+ * every valid FFT size on a background thread, and saves the result so
+ * later plans (and later runs) are near-instant.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_FFT_WISDOM_HPP
+#define FRITURE_FFT_WISDOM_HPP
+
+#include <fftw3.h>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cstddef>
+
+namespace friture {
+
+/**
+ * @brief FFTW wisdom store with background planning
+ *
+ * FFTW's planner and wisdom are process-global and not thread-safe, so
+ * every plan creation/destruction in the library must hold plannerMutex().
+ * FFTProcessor does this internally.
+ *
+ * Wisdom recorded at a higher planning rigor satisfies lower-rigor
+ * requests, so after warmUp() with FFTW_PATIENT every FFTW_MEASURE plan
+ * FFTProcessor creates is taken straight from wisdom.
+ *
+ * Example:
+ * @code
+ * FFTWisdom wisdom(FFTWisdom::defaultCachePath());
+ * wisdom.load();
+ * wisdom.startBackgroundPlanning();   // fills in any missing sizes
+ * // ... run application ...
+ * wisdom.stopBackgroundPlanning();
+ * wisdom.save();
+ * @endcode
+ */
+class FFTWisdom {
+public:
+    static constexpr size_t MIN_FFT_SIZE = 32;     ///< Smallest size pre-planned
+    static constexpr size_t MAX_FFT_SIZE = 16384;  ///< Largest size pre-planned
+
+    /**
+     * @brief Construct wisdom store for a cache file
+     * @param cache_path Wisdom file path (empty = in-memory only)
+     */
+    explicit FFTWisdom(std::string cache_path);
+
+    /**
+     * @brief Destructor - stops background planning (does not save)
+     */
+    ~FFTWisdom();
+
+    /**
+     * @brief Import wisdom from the cache file
+     * @return true if the file existed and was imported
+     */
+    bool load();
+
+    /**
+     * @brief Export accumulated wisdom to the cache file
+     * @return true if written (creates parent directories as needed)
+     */
+    bool save();
+
+    /**
+     * @brief Plan all valid sizes on a background thread
+     * @param flags FFTW planner flags (FFTW_MEASURE by default)
+     *
+     * Plans the single-frame and batched transforms FFTProcessor uses for
+     * every size in [MIN_FFT_SIZE, MAX_FFT_SIZE]. The planner lock is taken
+     * per plan, so a concurrent FFTProcessor construction waits for at most
+     * one plan. No-op if planning is already running.
+     */
+    void startBackgroundPlanning(unsigned flags = FFTW_MEASURE);
+
+    /**
+     * @brief Cancel and join background planning (no-op if not running)
+     *
+     * Returns after the plan in progress finishes.
+     */
+    void stopBackgroundPlanning();
+
+    /**
+     * @brief Check whether background planning finished all sizes
+     */
+    bool isPlanningComplete() const { return planning_complete_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Offline warm-up: plan every size synchronously and save
+     * @param flags FFTW planner flags (FFTW_PATIENT by default)
+     * @return true if wisdom was saved
+     *
+     * Intended for a one-off "--fftw-warmup" run; can take minutes with
+     * FFTW_PATIENT at the largest sizes.
+     */
+    bool warmUp(unsigned flags = FFTW_PATIENT);
+
+    /**
+     * @brief Get cache file path
+     */
+    const std::string& getCachePath() const { return cache_path_; }
+
+    /**
+     * @brief Get per-user default cache file path
+     * @return $XDG_CACHE_HOME/friture/fftw3f.wisdom, ~/.cache/friture/...,
+     *         or %LOCALAPPDATA%\\friture\\... on Windows (empty if unknown)
+     */
+    static std::string defaultCachePath();
+
+    /**
+     * @brief Get the mutex that serializes all FFTW planner calls
+     */
+    static std::mutex& plannerMutex();
+
+    /**
+     * @brief Plan every valid size once (blocking)
+     * @param flags FFTW planner flags
+     * @param cancel Optional flag checked between sizes
+     * @return Number of sizes planned
+     */
+    static size_t planAllSizes(unsigned flags, const std::atomic<bool>* cancel = nullptr);
+
+private:
+    std::string cache_path_;                  ///< Wisdom file (may be empty)
+    std::thread planning_thread_;             ///< Background planner
+    std::atomic<bool> cancel_planning_;       ///< Stop request for planner
+    std::atomic<bool> planning_complete_;     ///< All sizes planned
+
+    // Prevent copying (owns a thread)
+    FFTWisdom(const FFTWisdom&) = delete;
+    FFTWisdom& operator=(const FFTWisdom&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_FFT_WISDOM_HPP
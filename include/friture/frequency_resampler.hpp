@@ -5,7 +5,8 @@
  * This class maps FFT bins (linearly spaced in Hz) to screen pixels using
  * various perceptually-motivated frequency scales. It supports Linear, Mel,
  * ERB, Logarithmic, and Octave scales with linear interpolation for smooth
- * visualization.
+ * visualization, or band aggregation (mean power / peak hold) when there
+ * are more FFT bins than output pixels.
  *
  * @author Friture C++ Port
  * @date 2025-11-06
@@ -15,6 +16,8 @@
 #define FRITURE_FREQUENCY_RESAMPLER_HPP
 
 #include <friture/types.hpp>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <cmath>
 #include <algorithm>
@@ -30,11 +33,19 @@ namespace friture {
  * It pre-computes a mapping from output pixels to FFT bin indices and uses
  * linear interpolation for smooth resampling.
  *
+ * Band aggregation: each output pixel also owns the band of bins between
+ * the midpoints to its neighbours. MeanPower and PeakHold combine every bin
+ * in that band through a precomputed sparse matrix (start bin, count and
+ * normalized weights per row), so each bin is visited at most twice per
+ * column. Rows whose band is narrower than one bin keep the interpolation
+ * weights, so zoomed-in regions look the same in every mode.
+ *
  * Thread Safety: Not thread-safe. Create separate instances for concurrent use.
  *
  * Performance:
  * - Target: <10 μs for 2049 FFT bins → 1080 pixels
  * - Actual: ~5-8 μs on modern CPUs
+ * - Aggregation: O(num_bins + output_height) per column
  * - Memory: Pre-allocated, no dynamic allocation during resampling
  *
  * Typical Usage:
@@ -67,6 +78,7 @@ public:
      * @param sample_rate Audio sample rate in Hz
      * @param fft_size FFT size (power of 2)
      * @param output_height Number of output pixels (screen height)
+     * @param aggregation How bins are combined into pixels
      * @throws std::invalid_argument if parameters are invalid
      *
      * This constructor pre-computes the frequency mapping for the given
@@ -84,9 +96,32 @@ public:
         float max_freq,
         float sample_rate,
         size_t fft_size,
-        size_t output_height
+        size_t output_height,
+        BinAggregation aggregation = BinAggregation::Interpolate
     );
 
+    /**
+     * @brief Row of the sparse bin → pixel aggregation matrix
+     *
+     * Output pixel i combines bins [start_bin, start_bin + count) with
+     * weights getBandWeights()[weight_offset ...], which sum to 1.
+     * Interpolated rows are combined in dB in every mode.
+     */
+    struct Band {
+        uint32_t start_bin;      ///< First contributing FFT bin
+        uint32_t count;          ///< Number of contributing bins (>= 1)
+        uint32_t weight_offset;  ///< Index of the first weight
+        bool interpolated;       ///< Band narrower than a bin: interpolation weights
+    };
+
+    /**
+     * @brief Half-open range of input bins
+     */
+    struct BinRange {
+        size_t first;   ///< First bin
+        size_t end;     ///< One past the last bin
+    };
+
     /**
      * @brief Resample FFT spectrum to target frequency scale
      * @param input Input FFT spectrum (fft_size/2 + 1 bins, in dB)
@@ -102,10 +137,84 @@ public:
      *
      * Performance: <10 μs for typical configurations (2049 bins → 1080 pixels)
      *
+     * In MeanPower mode each pixel is 10·log10(Σ wₖ·10^(xₖ/10)) over its
+     * band; in PeakHold mode it is the maximum over its band.
+     *
      * Note: Input and output buffers must not overlap.
      */
     void resample(const float* input, float* output) const;
 
+    /**
+     * @brief Resample only a range of output rows
+     * @param input Input FFT spectrum (fft_size/2 + 1 bins, in dB)
+     * @param output Full-height output; only rows [first_row, first_row + row_count) are written
+     * @param first_row First row to compute
+     * @param row_count Rows to compute
+     * @throws std::invalid_argument if the range exceeds the output height
+     *
+     * Same values as resample() for those rows; only the bins their bands
+     * touch are read. Lets several FFT sizes fill different row ranges of
+     * one column (see MultiResolutionAnalyzer).
+     */
+    void resampleRows(const float* input, float* output, size_t first_row, size_t row_count) const;
+
+    /**
+     * @brief Get the input bins resample() reads, in any aggregation mode
+     *
+     * Everything outside min_freq..max_freq (plus the edge bands) is never
+     * read, so FFTProcessor::process() can skip converting it to dB.
+     */
+    BinRange getInputRange() const { return getInputRange(0, output_height_); }
+
+    /**
+     * @brief Get the input bins resampleRows() reads for a row range
+     * @param first_row First row
+     * @param row_count Rows (> 0, within the output height)
+     * @throws std::invalid_argument if the row range is empty or exceeds the output height
+     *
+     * The mapping rises monotonically with the row, so the first and last
+     * rows bound the range: O(1).
+     */
+    BinRange getInputRange(size_t first_row, size_t row_count) const;
+
+    /**
+     * @brief Change bin aggregation mode
+     * @param aggregation New mode (the band matrix is always kept up to date)
+     */
+    void setAggregation(BinAggregation aggregation) { aggregation_ = aggregation; }
+
+    /**
+     * @brief Get current bin aggregation mode
+     */
+    BinAggregation getAggregation() const { return aggregation_; }
+
+    /**
+     * @brief Apply a frequency weighting (IEC 61672-1 A/B/C) to every row
+     * @param type Weighting (None restores the flat response)
+     *
+     * The shared per-bin offsets (see weightingTable()) are folded into
+     * the precomputed mapping rather than applied in an extra pass:
+     * MeanPower weights absorb the linear gain, interpolated rows add one
+     * precomputed offset, and PeakHold adds the offset inside its maximum.
+     * Kept across scale, range and height changes.
+     */
+    void setWeighting(WeightingType type);
+
+    /**
+     * @brief Get current frequency weighting
+     */
+    WeightingType getWeighting() const { return weighting_; }
+
+    /**
+     * @brief Get sparse aggregation matrix rows (one per output pixel)
+     */
+    const std::vector<Band>& getBands() const { return bands_; }
+
+    /**
+     * @brief Get sparse aggregation matrix weights (see Band)
+     */
+    const std::vector<float>& getBandWeights() const { return band_weights_; }
+
     /**
      * @brief Change frequency scale
      * @param scale New frequency scale type
@@ -198,6 +307,28 @@ private:
      */
     void computeMapping();
 
+    /**
+     * @brief Recompute the sparse band matrix from freq_mapping_
+     *
+     * Band edges are the midpoints between neighbouring pixel centres;
+     * each bin contributes in proportion to the overlap of its own
+     * [k - 0.5, k + 0.5] interval with the band.
+     *
+     * Complexity: O(num_bins + output_height)
+     */
+    void computeBands();
+
+    /**
+     * @brief Recompute the weighted matrix weights and row offsets
+     *
+     * Complexity: O(num_bins + output_height)
+     */
+    void computeWeighting();
+
+    void resampleInterpolate(const float* input, float* output, size_t first_row, size_t end_row) const;
+    void resampleMeanPower(const float* input, float* output, size_t first_row, size_t end_row) const;
+    void resamplePeakHold(const float* input, float* output, size_t first_row, size_t end_row) const;
+
     /**
      * @brief Validate configuration parameters
      * @throws std::invalid_argument if any parameter is invalid
@@ -263,6 +394,7 @@ private:
     float sample_rate_;             ///< Audio sample rate in Hz
     size_t fft_size_;               ///< FFT size (determines frequency resolution)
     size_t output_height_;          ///< Output height in pixels
+    BinAggregation aggregation_;    ///< How bins are combined into pixels
 
     /**
      * @brief Pre-computed mapping from output pixel to FFT bin index
@@ -278,6 +410,15 @@ private:
      */
     std::vector<float> freq_mapping_;
 
+    std::vector<Band> bands_;            ///< Aggregation matrix rows [output_height]
+    std::vector<float> band_weights_;    ///< Aggregation matrix weights (all rows)
+    mutable std::vector<float> power_;   ///< MeanPower scratch: bins in linear power [num_bins]
+
+    WeightingType weighting_;            ///< Current frequency weighting
+    std::shared_ptr<const std::vector<float>> weighting_db_;  ///< Per-bin offsets (null = flat)
+    std::vector<float> weighted_band_weights_;  ///< band_weights_ × linear bin gain (wide rows)
+    std::vector<float> row_offset_db_;   ///< Offset at each row's interpolation point
+
     // Prevent copying (would need deep copy of mapping)
     FrequencyResampler(const FrequencyResampler&) = delete;
     FrequencyResampler& operator=(const FrequencyResampler&) = delete;
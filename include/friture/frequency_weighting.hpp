@@ -0,0 +1,55 @@
+/**
+ * @file frequency_weighting.hpp
+ * @brief IEC 61672-1 A/B/C frequency weighting curves and per-bin tables
+ *
+ * Weighting is applied as a dB offset per FFT bin. The offsets depend only
+ * on the weighting, the FFT size and the sample rate, so each table is
+ * computed once and shared by every FrequencyResampler (and chain) that
+ * needs it, including after FFT size changes back and forth.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_FREQUENCY_WEIGHTING_HPP
+#define FRITURE_FREQUENCY_WEIGHTING_HPP
+
+#include <friture/types.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace friture {
+
+/// Lowest offset in a weighting table (the curves fall to -inf at DC)
+constexpr float WEIGHTING_FLOOR_DB = -200.0f;
+
+/**
+ * @brief Weighting curve value at one frequency
+ * @param type Weighting (None gives 0 dB everywhere)
+ * @param frequency_hz Frequency (Hz, >= 0)
+ * @return Gain in dB, normalized to 0 dB at 1 kHz; -inf at 0 Hz
+ *
+ * Analytic curves of IEC 61672-1:2013 (annex E) with the pole
+ * frequencies 20.6, 107.7, 737.9 and 12194 Hz (B: 158.5 Hz).
+ */
+double weightingDb(WeightingType type, double frequency_hz);
+
+/**
+ * @brief Shared per-bin dB offsets for a weighting and FFT layout
+ * @param type Weighting
+ * @param fft_size FFT size (bins k = 0 .. fft_size/2 at k·sample_rate/fft_size Hz)
+ * @param sample_rate Sample rate (Hz)
+ * @return fft_size/2 + 1 offsets (clamped to WEIGHTING_FLOOR_DB), or
+ *         nullptr for WeightingType::None
+ * @throws std::invalid_argument if fft_size or sample_rate is not positive
+ *
+ * Tables are cached for the life of the process (one float per bin, a
+ * few layouts in practice); any thread may call this.
+ */
+std::shared_ptr<const std::vector<float>> weightingTable(WeightingType type, size_t fft_size,
+                                                         float sample_rate);
+
+} // namespace friture
+
+#endif // FRITURE_FREQUENCY_WEIGHTING_HPP
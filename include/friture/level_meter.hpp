@@ -0,0 +1,148 @@
+/**
+ * @file level_meter.hpp
+ * @brief Consumer-side input metering (RMS, peak, true-peak, clipping)
+ *
+ * LevelMeter computes level statistics from samples that are already in a
+ * RingBuffer, on the thread that displays them, so the real-time audio
+ * callback only has to copy samples and publish the write counter.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_LEVEL_METER_HPP
+#define FRITURE_LEVEL_METER_HPP
+
+#include <friture/ringbuffer.hpp>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Level meter fed from a ring buffer cursor
+ *
+ * Measurements:
+ * - RMS: exponentially averaged mean square (integration time constant)
+ * - Peak: largest |sample|, falling with the release time constant
+ * - True peak: peak of the 4× oversampled signal (polyphase windowed-sinc
+ *   interpolator), which catches inter-sample overs that the sample peak
+ *   misses, as in ITU-R BS.1770
+ * - Clip count: samples at or above the clip level
+ *
+ * Each reader owns its meter; update() follows the ring with a private
+ * Cursor and never blocks or slows the writer.
+ *
+ * Thread Safety: Not thread-safe. Use from one (non-real-time) thread.
+ *
+ * Example:
+ * @code
+ * LevelMeter meter(48000.0f);
+ * // Once per UI frame:
+ * meter.update(engine.getRingBuffer());
+ * drawMeter(meter.getRms(), meter.getPeak(), meter.getClipCount());
+ * @endcode
+ */
+class LevelMeter {
+public:
+    static constexpr size_t OVERSAMPLING = 4;       ///< True-peak interpolation factor
+    static constexpr size_t TAPS_PER_PHASE = 16;    ///< Interpolator length per phase
+    static constexpr size_t BLOCK_SIZE = 64;        ///< Samples per ring read in update()
+
+    /**
+     * @brief Construct meter
+     * @param sample_rate Sample rate of the metered signal (Hz, must be > 0)
+     * @param integration_seconds RMS averaging time constant (must be > 0)
+     * @param release_seconds Peak / true-peak fall time constant (must be > 0)
+     * @param clip_level |sample| counted as clipped (full scale = 1.0)
+     * @throws std::invalid_argument if a rate or time constant is not positive
+     */
+    explicit LevelMeter(float sample_rate,
+                        float integration_seconds = 0.3f,
+                        float release_seconds = 1.5f,
+                        float clip_level = 1.0f);
+
+    /**
+     * @brief Meter samples that arrived in the ring since the last call
+     * @param ring Ring buffer written by the audio callback
+     * @return Number of samples metered
+     *
+     * On the first call (or after reset()) metering starts at the newest
+     * sample. If the reader fell more than max backlog (0.5 s) behind, the
+     * oldest samples are skipped so one call stays cheap. A trailing
+     * partial block is metered on a later call.
+     */
+    size_t update(const RingBuffer<float>& ring);
+
+    /**
+     * @brief Meter a block of samples directly
+     * @param samples Input samples
+     * @param count Number of samples
+     */
+    void process(const float* samples, size_t count);
+
+    /**
+     * @brief Clear all measurements and restart from the newest ring sample
+     */
+    void reset();
+
+    /**
+     * @brief Get averaged RMS level (linear, full scale = 1.0)
+     */
+    float getRms() const;
+
+    /**
+     * @brief Get sample peak with release (linear)
+     */
+    float getPeak() const { return peak_; }
+
+    /**
+     * @brief Get true (inter-sample) peak with release (linear)
+     */
+    float getTruePeak() const { return true_peak_; }
+
+    /**
+     * @brief Get number of clipped samples since construction or reset()
+     */
+    uint64_t getClipCount() const { return clip_count_; }
+
+    /**
+     * @brief Get number of samples metered since construction or reset()
+     */
+    uint64_t getSamplesMetered() const { return samples_metered_; }
+
+private:
+    /**
+     * @brief Build the polyphase interpolator (unit DC gain per phase)
+     */
+    void designInterpolator();
+
+    float sample_rate_;            ///< Sample rate (Hz)
+    float integration_seconds_;    ///< RMS time constant
+    float release_seconds_;        ///< Peak release time constant
+    float clip_level_;             ///< Clip threshold
+    size_t max_backlog_;           ///< Samples update() meters at most per call
+
+    double mean_square_;           ///< Averaged mean square
+    float peak_;                   ///< Sample peak (with release)
+    float true_peak_;              ///< Oversampled peak (with release)
+    uint64_t clip_count_;          ///< Clipped samples
+    uint64_t samples_metered_;     ///< Total samples processed
+
+    /// Interpolator taps, [phase][tap]
+    std::array<std::array<float, TAPS_PER_PHASE>, OVERSAMPLING> taps_;
+
+    /// Last TAPS_PER_PHASE inputs, duplicated so a window is contiguous
+    std::array<float, 2 * TAPS_PER_PHASE> history_;
+    size_t history_pos_;           ///< Next history slot [0, TAPS_PER_PHASE)
+
+    RingBuffer<float>::Cursor cursor_;  ///< Stream position in the metered ring
+    bool cursor_valid_;                 ///< cursor_ follows a ring (false after reset)
+    std::vector<float> block_;          ///< BLOCK_SIZE read scratch
+};
+
+} // namespace friture
+
+#endif // FRITURE_LEVEL_METER_HPP
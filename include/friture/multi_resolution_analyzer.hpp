@@ -0,0 +1,149 @@
+/**
+ * @file multi_resolution_analyzer.hpp
+ * @brief Several FFT sizes stitched into one spectrogram column
+ *
+ * On logarithmic scales the bottom rows are far narrower than one bin of
+ * a typical FFT, so they only show interpolated smear, while the top rows
+ * span hundreds of bins. MultiResolutionAnalyzer runs larger FFTs over
+ * the same input for the low rows and the chain's own FFT for the rest,
+ * and stitches the per-band rows into one column.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_MULTI_RESOLUTION_ANALYZER_HPP
+#define FRITURE_MULTI_RESOLUTION_ANALYZER_HPP
+
+#include <friture/types.hpp>
+#include <friture/fft_processor.hpp>
+#include <friture/fft_wisdom.hpp>
+#include <friture/frequency_resampler.hpp>
+#include <friture/processing_chain.hpp>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Per-row FFT size selection for log-like frequency scales
+ *
+ * Band 0 is the chain's FFT (key.fft_size); band k uses key.fft_size · 4^k,
+ * up to MAX_BANDS bands and max_fft_size. Each row goes to the smallest FFT
+ * whose bin spacing is at most the row spacing there, so rows narrower than
+ * a bin of the base FFT get real resolution instead of interpolation. On
+ * the Logarithmic and Octave scales that gives contiguous row ranges, the
+ * largest FFT at the bottom. Bands that end up without rows are dropped.
+ *
+ * Scheduling: band k keeps the base overlap relative to its own size,
+ * so it runs every 4^k columns. Its phase is offset by k, so two large
+ * FFTs never fall on the same column and the per-column cost stays close
+ * to one base FFT plus one large FFT at most. Rows of bands that did not
+ * run keep their last values.
+ *
+ * Alignment: all frames are centred in the shared input window of
+ * getWindowSize() samples, so every band describes the same instant.
+ * The price is latency: the newest (W - N0) / 2 samples of the window
+ * wait for the larger frames.
+ *
+ * Thread Safety: Not thread-safe; owned by one ProcessingChain.
+ *
+ * Example:
+ * @code
+ * MultiResolutionAnalyzer analyzer(key, fft);
+ * std::vector<float> window(analyzer.getWindowSize());
+ * ring.readWindow(cursor, window.data(), window.size(), hop);
+ * analyzer.analyze(window.data());
+ * analyzer.stitch(column_db.data());
+ * @endcode
+ */
+class MultiResolutionAnalyzer {
+public:
+    static constexpr size_t MAX_BANDS = 3;    ///< Base FFT plus two larger ones
+    static constexpr size_t SIZE_STEP = 4;    ///< FFT size ratio between bands
+
+    /**
+     * @brief One FFT size and the rows it fills
+     */
+    struct Band {
+        size_t fft_size;    ///< FFT size in samples
+        size_t first_row;   ///< First output row
+        size_t row_count;   ///< Output rows
+        size_t period;      ///< Runs every period columns
+        size_t phase;       ///< Column offset of the schedule
+    };
+
+    /**
+     * @brief Construct analyzer
+     * @param key Chain configuration (key.fft_size is the base band)
+     * @param base_fft FFT processor for key.fft_size / key.window (shared with the chain)
+     * @param max_fft_size Largest FFT size to use
+     * @throws std::invalid_argument if the key is invalid or base_fft does not match
+     *
+     * Builds one FFTProcessor and one FrequencyResampler per additional band;
+     * must not race other FFT planning.
+     */
+    MultiResolutionAnalyzer(const ChainKey& key,
+                            std::shared_ptr<FFTProcessor> base_fft,
+                            size_t max_fft_size = FFTWisdom::MAX_FFT_SIZE);
+
+    /**
+     * @brief Get input samples needed per column (largest band's FFT size)
+     */
+    size_t getWindowSize() const { return window_size_; }
+
+    /**
+     * @brief Get number of bands in use
+     */
+    size_t getBandCount() const { return bands_.size(); }
+
+    /**
+     * @brief Get band layout
+     * @param index Band index (0 = smallest FFT, top rows)
+     */
+    const Band& getBand(size_t index) const { return bands_[index].layout; }
+
+    /**
+     * @brief Run the FFTs due this column
+     * @param window getWindowSize() input samples, oldest first
+     * @return Number of bands transformed
+     *
+     * The first column after construction or reset() runs every band.
+     */
+    size_t analyze(const float* window);
+
+    /**
+     * @brief Resample the bands updated by the last analyze() and write the column
+     * @param column_db Output column (key.height rows, in dB)
+     */
+    void stitch(float* column_db);
+
+    /**
+     * @brief Restart the schedule (next column runs every band)
+     */
+    void reset();
+
+private:
+    struct BandState {
+        Band layout;
+        std::shared_ptr<FFTProcessor> fft;
+        std::unique_ptr<FrequencyResampler> resampler;
+        std::vector<float> spectrum;   ///< Last spectrum in dB [fft_size/2 + 1]
+        bool updated = false;          ///< Transformed since the last stitch()
+    };
+
+    size_t window_size_;              ///< Input samples per column
+    uint64_t column_ = 0;             ///< Columns analyzed since reset()
+    std::vector<BandState> bands_;    ///< Active bands, smallest FFT first
+    std::vector<float> output_;       ///< Stitched column, rows of idle bands persist [height]
+
+    // Prevent copying (FFT plans)
+    MultiResolutionAnalyzer(const MultiResolutionAnalyzer&) = delete;
+    MultiResolutionAnalyzer& operator=(const MultiResolutionAnalyzer&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_MULTI_RESOLUTION_ANALYZER_HPP
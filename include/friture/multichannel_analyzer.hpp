@@ -0,0 +1,165 @@
+/**
+ * @file multichannel_analyzer.hpp
+ * @brief Parallel per-channel FFT → resample pipelines
+ *
+ * MultiChannelAnalyzer owns one ProcessingChain (with its own FFTProcessor)
+ * per input channel and runs them concurrently on a small set of worker
+ * threads, then combines the per-channel columns into one display column
+ * (stacked lanes or an overlay).
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_MULTICHANNEL_ANALYZER_HPP
+#define FRITURE_MULTICHANNEL_ANALYZER_HPP
+
+#include <friture/types.hpp>
+#include <friture/processing_chain.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief N independent analysis chains processed in parallel
+ *
+ * Per column, the caller fills chain(c).fft_input for every channel and
+ * calls process(); the FFT and frequency resampling of all channels run
+ * in parallel (channel c on worker c % threads, the calling thread being
+ * worker 0), and afterwards chain(c).resampled holds each channel's
+ * column. combine() lays the columns out for display.
+ *
+ * Chains are keyed for the lane height, so a Stacked analyzer for N
+ * channels and a display height H uses chains of height H / N.
+ *
+ * Thread Safety: One thread drives process()/combine(); the worker threads
+ * are internal. Construction plans FFTs and must not race other planning
+ * (build it where other chains are built).
+ *
+ * Example:
+ * @code
+ * MultiChannelAnalyzer analyzer(key, 8, ChannelLayout::Stacked, 432);
+ * for (size_t c = 0; c < 8; ++c) {
+ *     ring[c].readWindow(cursor[c], analyzer.chain(c).fft_input.data(), fft, hop);
+ * }
+ * analyzer.process();
+ * analyzer.combine(column_db.data());
+ * @endcode
+ */
+class MultiChannelAnalyzer {
+public:
+    /**
+     * @brief Construct analyzer
+     * @param key Chain configuration (key.height is ignored, see display_height;
+     *        key.multi_resolution is ignored)
+     * @param channels Number of channels (must be > 0)
+     * @param layout Display layout for combine()
+     * @param display_height Height of the combined column (must be >= channels)
+     * @param threads Worker threads including the caller (0 = one per
+     *        channel, capped at hardware concurrency)
+     * @throws std::invalid_argument on invalid parameters
+     */
+    MultiChannelAnalyzer(const ChainKey& key,
+                         size_t channels,
+                         ChannelLayout layout,
+                         size_t display_height,
+                         size_t threads = 0);
+
+    /**
+     * @brief Destructor - stops and joins the worker threads
+     */
+    ~MultiChannelAnalyzer();
+
+    /**
+     * @brief Get number of channels
+     */
+    size_t getChannelCount() const { return chains_.size(); }
+
+    /**
+     * @brief Get number of threads process() uses (including the caller)
+     */
+    size_t getThreadCount() const { return workers_.size() + 1; }
+
+    /**
+     * @brief Get display layout
+     */
+    ChannelLayout getLayout() const { return layout_; }
+
+    /**
+     * @brief Get combined column height
+     */
+    size_t getDisplayHeight() const { return display_height_; }
+
+    /**
+     * @brief Get rows per channel lane (display height for Overlay)
+     */
+    size_t getLaneHeight() const { return lane_height_; }
+
+    /**
+     * @brief Get samples between consecutive columns
+     */
+    size_t getHopSize() const { return chains_.front()->getHopSize(); }
+
+    /**
+     * @brief Get the chain of one channel
+     * @param channel Channel index (< getChannelCount())
+     */
+    ProcessingChain& chain(size_t channel) { return *chains_[channel]; }
+
+    /**
+     * @brief FFT and resample every channel's fft_input, in parallel
+     *
+     * Returns when all channels are done. Never allocates.
+     */
+    void process();
+
+    /**
+     * @brief Combine the per-channel columns into one display column
+     * @param output Combined column in dB [display height], row 0 = lowest
+     *        frequency of the bottom lane
+     *
+     * Stacked: channel c occupies rows [H - (c + 1) * lane, H - c * lane), so
+     * channel 0 is the top lane; rows left over by the integer division are
+     * filled with the lowest level. Overlay: per-row maximum over channels.
+     */
+    void combine(float* output) const;
+
+private:
+    /**
+     * @brief Process the channels assigned to one worker
+     */
+    void processShare(size_t worker);
+
+    /**
+     * @brief Worker thread body
+     */
+    void workerLoop(size_t worker);
+
+    ChannelLayout layout_;          ///< Display layout
+    size_t display_height_;         ///< Combined height
+    size_t lane_height_;            ///< Height of every chain
+    std::vector<std::unique_ptr<ProcessingChain>> chains_;  ///< One chain per channel
+
+    // Fork-join state (guarded by mutex_)
+    std::vector<std::thread> workers_;  ///< Helper threads (thread count - 1)
+    std::mutex mutex_;
+    std::condition_variable start_cv_;  ///< Signals a new generation
+    std::condition_variable done_cv_;   ///< Signals the last worker finished
+    uint64_t generation_ = 0;           ///< Incremented per process()
+    size_t workers_busy_ = 0;           ///< Helpers still working on this generation
+    bool stopping_ = false;             ///< Destructor requested exit
+
+    // Prevent copying (owns threads)
+    MultiChannelAnalyzer(const MultiChannelAnalyzer&) = delete;
+    MultiChannelAnalyzer& operator=(const MultiChannelAnalyzer&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_MULTICHANNEL_ANALYZER_HPP
@@ -0,0 +1,256 @@
+/**
+ * @file offline_renderer.hpp
+ * @brief Headless WAV → spectrogram image rendering without pacing
+ *
+ * This file contains OfflineRenderer, which runs the same FFT → frequency
+ * resampling → color pipeline as the viewer over a whole recording as fast
+ * as the CPU allows. The columns of one file are split into batches that a
+ * work-stealing TaskPool spreads over its threads, each with its own
+ * FFTProcessor and FrequencyResampler; every batch writes straight into its
+ * slice of one column-major color matrix, which renderFile() writes to the
+ * BMP as is (render() copies it into a SpectrogramImage).
+ * Along the way it can summarize the file's spectrum (octave band energies
+ * and the strongest peaks) for batch reports.
+ *
+ * No SDL or audio device is involved; used by the friture-render tool.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_OFFLINE_RENDERER_HPP
+#define FRITURE_OFFLINE_RENDERER_HPP
+
+#include <friture/types.hpp>
+#include <friture/color_transform.hpp>
+#include <friture/fft_processor.hpp>
+#include <friture/spectrogram_image.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+class TaskPool;
+
+/**
+ * @brief Analysis and image parameters for an offline render
+ */
+struct OfflineRenderOptions {
+    static constexpr size_t DEFAULT_MAX_WIDTH = 16384;      ///< 32 MB of colors at height 512
+
+    size_t fft_size = 4096;                                  ///< FFT size in samples
+    float overlap_percent = 75.0f;                           ///< Frame overlap (sets the hop)
+    WindowFunction window = WindowFunction::Hann;            ///< Window function
+    float kaiser_beta = DEFAULT_KAISER_BETA;                 ///< Kaiser β (Kaiser window only)
+    FrequencyScale scale = FrequencyScale::Mel;              ///< Output frequency scale
+    float min_freq = 20.0f;                                  ///< Lowest row frequency (Hz)
+    float max_freq = 0.0f;                                   ///< Highest row frequency (Hz, 0 = Nyquist)
+    BinAggregation aggregation = BinAggregation::MeanPower;  ///< Bin → row combination
+    WeightingType weighting = WeightingType::None;           ///< Frequency weighting (A/B/C)
+    float min_db = -140.0f;                                  ///< Level shown as the first palette color
+    float max_db = 0.0f;                                     ///< Level shown as the last palette color
+    ColorTheme theme = ColorTheme::CMRMAP;                   ///< Palette
+    size_t height = 512;                                     ///< Image height (rows)
+    size_t max_width = DEFAULT_MAX_WIDTH;                    ///< Widen the hop to fit this many columns (0 = no limit)
+    size_t threads = 0;                                      ///< Worker threads per file (0 = hardware concurrency)
+    size_t summary_peaks = 5;                                ///< Peaks listed in an OfflineRenderSummary
+};
+
+/**
+ * @brief Timing and size of one offline render
+ */
+struct OfflineRenderStats {
+    uint64_t columns = 0;   ///< Columns rendered (image width)
+    size_t hop_size = 0;    ///< Samples between consecutive columns
+    size_t threads = 0;     ///< Worker threads used
+    double seconds = 0.0;   ///< Wall time of the analysis (excludes file I/O of the image)
+
+    /**
+     * @brief Get throughput
+     * @return Columns per second of wall time (0 if nothing was timed)
+     */
+    double getColumnsPerSecond() const {
+        return seconds > 0.0 ? static_cast<double>(columns) / seconds : 0.0;
+    }
+};
+
+/**
+ * @brief One peak of a file's mean spectrum
+ */
+struct OfflineSpectrumPeak {
+    float frequency = 0.0f;   ///< Interpolated frequency (Hz)
+    float level_db = 0.0f;    ///< Interpolated mean level (dB)
+};
+
+/**
+ * @brief Spectrum statistics of one rendered file
+ *
+ * Taken over every column's full spectrum (0 Hz to Nyquist, whatever the
+ * displayed range), averaged in power.
+ */
+struct OfflineRenderSummary {
+    static constexpr float FIRST_BAND_CENTER = 31.25f;   ///< 1 kHz / 32
+    static constexpr size_t MAX_BANDS = 10;              ///< 31.25 Hz .. 16 kHz
+
+    std::vector<float> band_centers;           ///< Octave band centres below Nyquist (Hz)
+    std::vector<float> band_db;                ///< Mean power summed over each band's bins (dB)
+    std::vector<OfflineSpectrumPeak> peaks;    ///< Strongest local maxima, strongest first
+    float mean_db = 0.0f;                      ///< Mean power summed over all bins (dB)
+    float max_db = 0.0f;                       ///< Highest bin level of any column (dB)
+};
+
+/**
+ * @brief Renders whole recordings to spectrogram images
+ *
+ * Columns are taken every getSamplesPerColumn() samples (overlap_percent) as in
+ * the viewer, unless max_width forces a larger hop. Each pool chunk is
+ * BATCH_COLUMNS frames, transformed by one FFTProcessor::processBatch() call.
+ * With idle workers stealing chunks, throughput scales with the thread
+ * count even when some parts of the source decode more slowly.
+ * Row 0 of the image is min_freq, as in examples/pipeline_test.
+ *
+ * A render holds the whole image in memory, width × height × 4 bytes
+ * (imageBytesFor()); max_width keeps that bounded for long recordings.
+ *
+ * The thread pool and the per-worker stages are kept between renders and
+ * rebuilt only when the sample rate or frequency range changes, so a batch
+ * of many short files pays for thread start-up and FFT/resampler setup
+ * once per renderer instead of once per file.
+ *
+ * Thread Safety: one render at a time per renderer; render files
+ * concurrently with one renderer each (FFT planning is serialized by
+ * FFTWisdom::plannerMutex()).
+ *
+ * Example:
+ * @code
+ * OfflineRenderOptions options;
+ * options.height = 400;
+ * OfflineRenderer renderer(options);
+ *
+ * OfflineRenderStats stats;
+ * if (renderer.renderFile("in.wav", "in.bmp", &stats)) {
+ *     std::cout << stats.getColumnsPerSecond() << " columns/s\n";
+ * }
+ * @endcode
+ */
+class OfflineRenderer {
+public:
+    /**
+     * @brief Sample callback: fill output with mono samples [position, position + count)
+     * @return Samples produced (a short count is padded with silence)
+     *
+     * Called concurrently from the worker threads.
+     */
+    using Source = std::function<size_t(uint64_t position, float* output, size_t count)>;
+
+    static constexpr size_t BATCH_COLUMNS = 2 * FFTProcessor::BATCH_FRAMES;  ///< Columns per batched FFT
+
+    /**
+     * @brief Construct renderer
+     * @param options Render parameters
+     * @throws std::invalid_argument if fft_size, height or the dB range is invalid
+     */
+    explicit OfflineRenderer(const OfflineRenderOptions& options);
+    ~OfflineRenderer();
+
+    /**
+     * @brief Render a sample source to an image
+     * @param source Mono sample callback (thread-safe)
+     * @param length Samples in the source
+     * @param sample_rate Sample rate of the source (Hz)
+     * @param stats Optional timing output
+     * @param summary Optional spectrum statistics (costs one dB to power
+     *        conversion and accumulation per bin and column)
+     * @return Image with one column per frame
+     *
+     * The image is built from the rendered columns, so the peak memory is
+     * about three times imageBytesFor(); renderFile() needs one.
+     * @throws std::invalid_argument if length is shorter than one FFT frame or
+     *         the frequency range does not fit the sample rate
+     */
+    std::unique_ptr<SpectrogramImage> render(const Source& source, uint64_t length,
+                                             float sample_rate,
+                                             OfflineRenderStats* stats = nullptr,
+                                             OfflineRenderSummary* summary = nullptr);
+
+    /**
+     * @brief Render a WAV file to a BMP image
+     * @param input_path WAV file
+     * @param output_path BMP file to write
+     * @param stats Optional timing output
+     * @param summary Optional spectrum statistics
+     * @return true on success, false on error (see getError())
+     */
+    bool renderFile(const char* input_path, const char* output_path,
+                    OfflineRenderStats* stats = nullptr,
+                    OfflineRenderSummary* summary = nullptr);
+
+    /**
+     * @brief Get render parameters
+     */
+    const OfflineRenderOptions& getOptions() const { return options_; }
+
+    /**
+     * @brief Get last renderFile() error message
+     */
+    const std::string& getError() const { return error_; }
+
+    /**
+     * @brief Get samples between columns for a source
+     * @param length Samples in the source (>= fft_size)
+     * @return Default hop, widened so at most max_width columns result
+     */
+    size_t hopSizeFor(uint64_t length) const;
+
+    /**
+     * @brief Get the color matrix a render of a source holds
+     * @param length Samples in the source
+     * @return Bytes of the width × height image (0 if shorter than one frame)
+     */
+    uint64_t imageBytesFor(uint64_t length) const;
+
+private:
+    struct WorkerStages;
+
+    /**
+     * @brief Render a sample source into a column-major color matrix
+     * @param colors Resized to columns × height and filled
+     * @return Columns rendered
+     * @throws std::invalid_argument as render()
+     */
+    uint64_t renderColumns(const Source& source, uint64_t length, float sample_rate,
+                           std::vector<uint32_t>& colors, OfflineRenderStats* stats,
+                           OfflineRenderSummary* summary);
+
+    /**
+     * @brief Render columns [first, first + count) into colors
+     * @param stages The calling worker's FFT, resampler and buffers
+     * @param colors Column-major output [count × height]
+     */
+    void renderSegment(WorkerStages& stages, const Source& source,
+                       size_t hop, uint64_t first, uint64_t count, uint32_t* colors,
+                       bool summarize) const;
+
+    /**
+     * @brief Fill summary from the workers' accumulated power
+     */
+    void summarize(uint64_t columns, float sample_rate, OfflineRenderSummary& summary) const;
+
+    OfflineRenderOptions options_;   ///< Render parameters
+    ColorTransform color_transform_; ///< Shared palette (read-only while rendering)
+    std::string error_;              ///< Last error message
+
+    // Kept between renders
+    std::unique_ptr<TaskPool> pool_;                      ///< Created on the first render
+    std::vector<std::unique_ptr<WorkerStages>> stages_;  ///< One per pool thread, built on first use
+    float stages_sample_rate_;                            ///< Rate stages_ were built for
+    float stages_max_freq_;                               ///< Top frequency stages_ were built for
+};
+
+} // namespace friture
+
+#endif // FRITURE_OFFLINE_RENDERER_HPP
@@ -0,0 +1,288 @@
+/**
+ * @file peak_detector.hpp
+ * @brief Tonal peak and event detection on FFT spectra
+ *
+ * PeakDetector runs after FFTProcessor::process() on every hop and turns
+ * tones that stand out of the noise into onset/offset events, so tonal
+ * faults can be logged or trigger actions instead of being spotted on
+ * screen. Events go through a lock-free SpscQueue to a consumer thread.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_PEAK_DETECTOR_HPP
+#define FRITURE_PEAK_DETECTOR_HPP
+
+#include <friture/spsc_queue.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief Kind of peak event
+ */
+enum class PeakEventType : uint8_t {
+    Onset,   ///< A peak rose threshold_db above its noise floor
+    Offset   ///< The peak stayed below release_db for the hold time
+};
+
+/**
+ * @brief Convert peak event type to string
+ */
+inline const char* toString(PeakEventType type) {
+    switch (type) {
+        case PeakEventType::Onset: return "Onset";
+        case PeakEventType::Offset: return "Offset";
+        default: return "Unknown";
+    }
+}
+
+/**
+ * @brief One detected event
+ *
+ * Positions are stream sample positions as passed to process(), so events
+ * line up with the audio and with each other whatever the consumer's
+ * latency.
+ */
+struct PeakEvent {
+    PeakEventType type = PeakEventType::Onset;
+    uint32_t track = 0;          ///< Same id for an onset and its offset
+    uint64_t position = 0;       ///< Sample position of the hop that raised the event
+    uint64_t duration = 0;       ///< Offset: samples from onset to last sighting (0 for onsets)
+    float frequency = 0.0f;      ///< Interpolated frequency (Hz); offset: last one seen
+    float level_db = 0.0f;       ///< Onset: interpolated level; offset: highest level of the track
+    float floor_db = 0.0f;       ///< Noise floor under the peak at onset
+};
+
+/**
+ * @brief Per-bin noise floor, peak picking and event hysteresis
+ *
+ * Per hop, over the bins [first, end) passed to process():
+ * 1. Excess over the noise floor: a per-bin exponential average in dB
+ *    that rises with floor_rise_seconds and falls with floor_fall_seconds,
+ *    updated with the simd::trackFloor() kernel. On noise it settles
+ *    about 4 dB below the mean power with the default 2:1 time constants;
+ *    a faster fall pulls it lower and lets noise cross the threshold more
+ *    often. A hop with no excess above threshold_db and no open track
+ *    ends here, as most hops of a noise-only signal do.
+ * 2. Peaks: local maxima more than threshold_db above their floor
+ *    anywhere, or more than release_db next to an open track, refined by
+ *    parabolic interpolation over the three bins around the maximum (the
+ *    strongest max_peaks per hop are kept). A peak more than mask_db
+ *    below a stronger one within mask_bins is dropped, so the window
+ *    sidelobes of a loud tone (Hann: -31 dB at 2.5 bins) are not taken
+ *    for tones of their own.
+ * 3. Tracks: each peak continues the nearest open track within
+ *    track_tolerance_bins, strongest peaks first. A peak without a track
+ *    opens one (Onset event) if it is more than threshold_db above its
+ *    floor. A track that finds no peak for hold_seconds closes (Offset
+ *    event). Opening at threshold_db and holding at release_db is the
+ *    hysteresis that keeps a tone near the threshold from chattering.
+ *
+ * The first hop (and the first after reset() or a change of bin range)
+ * seeds every floor with that spectrum's median level, so tones present
+ * from the start are detected too. A steady tone E dB above the floor
+ * raises its bins' floor and closes after about floor_rise_seconds ×
+ * ln(E / release_db) (14 s at 40 dB with the defaults); raise
+ * floor_rise_seconds to follow longer tones.
+ *
+ * All buffers are allocated by the constructor; process() does not
+ * allocate or lock. When the event queue is full, new events are counted
+ * in getDroppedEvents() instead of blocking.
+ *
+ * Thread Safety: process(), finish() and reset() from one (analysis)
+ * thread; drainEvents()/events().popWith() from one consumer thread.
+ *
+ * Example:
+ * @code
+ * PeakDetector detector(4096, 48000.0f, 1024);
+ * // Analysis thread, every hop:
+ * fft.process(window, spectrum_db);
+ * detector.process(spectrum_db, 1, 2049, position);
+ * // Consumer thread:
+ * detector.drainEvents([](const PeakEvent& event) { log(event); });
+ * @endcode
+ */
+class PeakDetector {
+public:
+    /**
+     * @brief Detection thresholds and capacities
+     */
+    struct Options {
+        float threshold_db = 18.0f;          ///< Excess over the floor that opens a track
+        float release_db = 10.0f;            ///< Excess a track needs to stay open
+        float hold_seconds = 0.05f;          ///< Time without a peak before a track closes
+        float floor_rise_seconds = 10.0f;    ///< Floor time constant upwards
+        float floor_fall_seconds = 5.0f;     ///< Floor time constant downwards
+        float track_tolerance_bins = 1.5f;   ///< Largest frequency step within a track
+        float mask_bins = 8.0f;              ///< Sidelobe masking distance (0 = off)
+        float mask_db = 20.0f;               ///< Level below a stronger peak that is masked
+        size_t max_peaks = 64;               ///< Peaks considered per hop
+        size_t max_tracks = 32;              ///< Tracks open at once
+        size_t queue_capacity = 256;         ///< Events waiting for the consumer
+    };
+
+    /**
+     * @brief Construct detector
+     * @param fft_size FFT size of the analyzed spectra (>= 4)
+     * @param sample_rate Sample rate (Hz, must be > 0)
+     * @param hop_size Samples between consecutive spectra (> 0)
+     * @param options Thresholds and capacities
+     * @throws std::invalid_argument if a size or rate is 0, release_db is
+     *         not in (0, threshold_db], a time constant or the track
+     *         tolerance is not positive, hold or masking is negative or a
+     *         capacity is 0
+     */
+    PeakDetector(size_t fft_size, float sample_rate, size_t hop_size, const Options& options);
+    PeakDetector(size_t fft_size, float sample_rate, size_t hop_size)
+        : PeakDetector(fft_size, sample_rate, hop_size, Options{}) {}
+
+    /**
+     * @brief Analyze one spectrum
+     * @param spectrum_db FFTProcessor output (fft_size / 2 + 1 bins, dB)
+     * @param first First bin to analyze
+     * @param end One past the last bin to analyze (<= fft_size / 2 + 1)
+     * @param position Stream sample position of this hop (e.g. the end of
+     *        its analysis window); must not decrease
+     * @return Number of events raised by this hop
+     *
+     * Only bins in [first, end) are read, so it can follow an FFT that
+     * computed only a bin range. Peaks need both neighbours inside the
+     * range.
+     */
+    size_t process(const float* spectrum_db, size_t first, size_t end, uint64_t position);
+
+    /**
+     * @brief Close every open track (e.g. at the end of a file)
+     * @param position Stream sample position of the end
+     * @return Number of Offset events raised
+     */
+    size_t finish(uint64_t position);
+
+    /**
+     * @brief Forget all tracks and floors without raising events
+     */
+    void reset();
+
+    /**
+     * @brief Pop every queued event (consumer thread)
+     * @param callback Called as callback(const PeakEvent&) per event
+     * @return Number of events delivered
+     */
+    template <typename Callback>
+    size_t drainEvents(Callback&& callback) {
+        size_t count = 0;
+        while (events_.popWith([&](const PeakEvent& event) { callback(event); })) {
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Event queue (consumer side)
+     */
+    SpscQueue<PeakEvent>& events() { return events_; }
+
+    /**
+     * @brief Number of events lost because the queue was full
+     */
+    uint64_t getDroppedEvents() const { return dropped_events_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Number of tracks currently open
+     */
+    size_t getOpenTracks() const { return open_tracks_; }
+
+    /**
+     * @brief Noise floor of a bin in dB (valid inside the last bin range)
+     */
+    float getFloor(size_t bin) const { return floor_[bin]; }
+
+    size_t getFftSize() const { return fft_size_; }
+    float getSampleRate() const { return sample_rate_; }
+    size_t getHopSize() const { return hop_size_; }
+    const Options& getOptions() const { return options_; }
+
+private:
+    struct Peak {
+        size_t index;    ///< Bin of the maximum
+        float bin;       ///< Interpolated bin
+        float level_db;  ///< Interpolated level
+        float floor_db;  ///< Floor at the maximum bin
+        float excess;    ///< Level over the floor at the maximum bin
+    };
+
+    struct Track {
+        uint32_t id;
+        float bin;            ///< Last interpolated bin
+        float peak_db;        ///< Highest level so far
+        float floor_db;       ///< Floor at the onset
+        uint64_t onset;       ///< Position of the onset
+        uint64_t last_seen;   ///< Position of the last matching peak
+        uint32_t missed;      ///< Hops since the last matching peak
+        bool matched;         ///< Continued by a peak this hop
+    };
+
+    /**
+     * @brief Seed the floors of [first, end) with the spectrum's median
+     */
+    void prime(const float* spectrum_db, size_t first, size_t end);
+
+    /**
+     * @brief Collect the peaks that can open or continue a track
+     *
+     * All bins are scanned only for peaks above threshold_db, and only if
+     * the hop's largest excess reaches it; peaks between release_db and
+     * threshold_db can only continue a track, so they are looked for next
+     * to the open tracks alone.
+     */
+    void findPeaks(const float* spectrum_db, size_t first, size_t end, float max_excess);
+
+    /**
+     * @brief Add the local maxima of bins [begin, end) whose excess is in
+     *        (min_excess, max_excess] to peaks_ (neighbours must be valid)
+     */
+    void scanPeaks(const float* spectrum_db, size_t begin, size_t end,
+                   float min_excess, float max_excess);
+
+    /**
+     * @brief Queue one event, counting it as dropped if the queue is full
+     */
+    void emit(const PeakEvent& event);
+
+    /**
+     * @brief Queue the Offset of track index i and remove it
+     */
+    void closeTrack(size_t i, uint64_t position);
+
+    size_t fft_size_;
+    float sample_rate_;
+    size_t hop_size_;
+    Options options_;
+    float rise_;                    ///< Floor coefficient upwards, per hop
+    float fall_;                    ///< Floor coefficient downwards, per hop
+    uint32_t hold_hops_;            ///< Missed hops before a track closes
+
+    std::vector<float> floor_;      ///< Noise floor per bin (dB)
+    std::vector<float> excess_;     ///< Level over the floor per bin, this hop
+    std::vector<Peak> peaks_;       ///< max_peaks slots
+    size_t peak_count_;
+    std::vector<Track> tracks_;     ///< max_tracks slots, first open_tracks_ in use
+    size_t open_tracks_;
+    uint32_t next_track_id_;
+
+    bool primed_;                   ///< Floors valid for [range_first_, range_end_)
+    size_t range_first_;
+    size_t range_end_;
+
+    SpscQueue<PeakEvent> events_;
+    std::atomic<uint64_t> dropped_events_;
+};
+
+} // namespace friture
+
+#endif // FRITURE_PEAK_DETECTOR_HPP
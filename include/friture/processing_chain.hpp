@@ -0,0 +1,285 @@
+/**
+ * @file processing_chain.hpp
+ * @brief Pre-built FFT → resample pipelines that can be swapped at runtime
+ *
+ * This file contains ProcessingChain, which bundles an FFTProcessor, a
+ * FrequencyResampler and every working buffer one analysis configuration
+ * needs, and ProcessingChainCache, which builds chains ahead of time so a
+ * settings change is a pointer swap instead of a teardown and rebuild.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_PROCESSING_CHAIN_HPP
+#define FRITURE_PROCESSING_CHAIN_HPP
+
+#include <friture/types.hpp>
+#include <friture/settings.hpp>
+#include <friture/fft_processor.hpp>
+#include <friture/frequency_resampler.hpp>
+#include <friture/aligned_arena.hpp>
+#include <friture/stage_profiler.hpp>
+#include <memory>
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+class MultiResolutionAnalyzer;
+class SlidingDFT;
+class ZoomAnalyzer;
+
+/**
+ * @brief Everything that determines a chain's processors and buffer sizes
+ */
+struct ChainKey {
+    size_t fft_size = 4096;                           ///< FFT size in samples
+    WindowFunction window = WindowFunction::Hann;     ///< Window function
+    float kaiser_beta = DEFAULT_KAISER_BETA;          ///< Kaiser β (default unless window is Kaiser)
+    FrequencyScale scale = FrequencyScale::Mel;       ///< Output frequency scale
+    float min_freq = 20.0f;                           ///< Lowest displayed frequency (Hz)
+    float max_freq = 24000.0f;                        ///< Highest displayed frequency (Hz)
+    float sample_rate = 48000.0f;                     ///< Sample rate (Hz)
+    size_t height = 0;                                ///< Output column height (pixels)
+    BinAggregation aggregation = BinAggregation::MeanPower;  ///< Bin → row combination
+    bool multi_resolution = false;                    ///< Larger FFTs for the low rows
+    bool zoom = false;                                ///< Zoom FFT into min_freq..max_freq
+    float overlap_percent = 75.0f;                    ///< Frame overlap (sets the hop)
+    WeightingType weighting = WeightingType::None;    ///< Frequency weighting (in the resampler)
+
+    /**
+     * @brief Build key from settings and display height
+     */
+    static ChainKey fromSettings(const SpectrogramSettings& settings, size_t height) {
+        ChainKey key;
+        key.fft_size = settings.fft_size;
+        key.window = settings.window_type;
+        if (settings.window_type == WindowFunction::Kaiser) {
+            key.kaiser_beta = settings.kaiser_beta;
+        }
+        key.scale = settings.freq_scale;
+        key.min_freq = settings.min_freq;
+        key.max_freq = settings.max_freq;
+        key.sample_rate = settings.sample_rate;
+        key.height = height;
+        key.aggregation = settings.bin_aggregation;
+        key.multi_resolution = settings.multi_resolution &&
+                               (settings.freq_scale == FrequencyScale::Logarithmic ||
+                                settings.freq_scale == FrequencyScale::Octave);
+        key.zoom = settings.zoom;
+        key.overlap_percent = settings.overlap_percent;
+        key.weighting = settings.weighting;
+        return key;
+    }
+
+    bool operator==(const ChainKey& other) const = default;
+};
+
+/**
+ * @brief One fully allocated analysis configuration
+ *
+ * All buffers are sized at construction, and the FFT batch plan is created
+ * up front, so processing through a chain never allocates. The public
+ * buffers are slices of one AlignedArena: a chain costs a single heap block
+ * for its working memory, and every buffer starts on a 64-byte boundary.
+ *
+ * With key.multi_resolution the chain also owns a MultiResolutionAnalyzer;
+ * fft_input then holds getWindowSize() samples and columns are produced by
+ * multiResolution() instead of fft() + resampler().
+ *
+ * With key.zoom, and a band narrow enough that ZoomAnalyzer::decimationFor()
+ * is at least 2, the chain owns a ZoomAnalyzer instead (it takes precedence
+ * over multi-resolution); fft_input then holds its getWindowSize() samples
+ * and columns are produced by zoom().
+ *
+ * When the window is one SlidingDFT::supports() and the hop is small
+ * enough that SlidingDFT::isCheaper() holds for the
+ * bins the resampler reads, the chain also owns a SlidingDFT, and
+ * slidingDFT() replaces fft() for single columns (batches still use fft()).
+ *
+ * Thread Safety: A chain may be used by one thread at a time. Chains that
+ * share an FFTProcessor (same size and window) must not be used concurrently.
+ */
+class ProcessingChain {
+public:
+    static constexpr size_t BATCH_COLUMNS = 2 * FFTProcessor::BATCH_FRAMES;  ///< Columns per batched FFT
+
+    /**
+     * @brief Construct chain
+     * @param key Configuration
+     * @param fft FFT processor for key.fft_size / key.window (shared)
+     * @throws std::invalid_argument if the key is invalid
+     */
+    ProcessingChain(const ChainKey& key, std::shared_ptr<FFTProcessor> fft);
+
+    ~ProcessingChain();
+
+    /**
+     * @brief Get configuration
+     */
+    const ChainKey& getKey() const { return key_; }
+
+    /**
+     * @brief Get samples between consecutive columns (key.overlap_percent)
+     */
+    size_t getHopSize() const { return hop_size_; }
+
+    /**
+     * @brief Get input samples per column (fft_size, or more in multi-resolution and zoom modes)
+     */
+    size_t getWindowSize() const { return window_size_; }
+
+    /**
+     * @brief Get FFT stage
+     */
+    FFTProcessor& fft() { return *fft_; }
+
+    /**
+     * @brief Get FFT stage for sharing with another chain
+     */
+    const std::shared_ptr<FFTProcessor>& fftShared() const { return fft_; }
+
+    /**
+     * @brief Get frequency mapping stage
+     */
+    FrequencyResampler& resampler() { return resampler_; }
+
+    /**
+     * @brief Get multi-resolution stage (null unless key.multi_resolution)
+     */
+    MultiResolutionAnalyzer* multiResolution() { return multi_resolution_.get(); }
+
+    /**
+     * @brief Get zoom FFT stage (null unless key.zoom and the band is narrow enough)
+     */
+    ZoomAnalyzer* zoom() { return zoom_.get(); }
+
+    /**
+     * @brief Get incremental spectrum stage (null unless cheaper than the FFT)
+     */
+    SlidingDFT* slidingDFT() { return sliding_dft_.get(); }
+
+    /**
+     * @brief Analyze fft_input as one single column
+     * @param profiler Receives the FFT time (and the Resample time when the
+     *        column is produced here)
+     * @return true if the dB spectrum is left in fft_output (valid for
+     *         resampler().getInputRange()) for the caller to inspect and
+     *         resample; false if the column was written to resampled
+     *         directly (zoom and multi-resolution chains)
+     *
+     * The dispatch the live analysis uses, so tools that replay a
+     * recording produce the same columns. Never allocates.
+     */
+    bool analyze(StageProfiler& profiler);
+
+    /**
+     * @brief Get the block the public buffers are carved from
+     */
+    const AlignedArena& arena() const { return arena_; }
+
+    std::span<float> fft_input;        ///< Single frame input [window size]
+    std::span<float> fft_output;       ///< Single frame spectrum [fft_size/2 + 1]
+    std::span<float> batch_input;      ///< Overlapping frames for BATCH_COLUMNS columns
+    std::span<float> batch_spectra;    ///< [BATCH_COLUMNS × bins] dB matrix
+    std::span<float> resampled;        ///< Resampled spectrum in dB [height]
+
+private:
+    AlignedArena arena_;                 ///< Backing store of the public buffers
+    ChainKey key_;                       ///< Configuration
+    size_t hop_size_;                    ///< Samples per column
+    size_t window_size_;                 ///< Input samples per column
+    std::shared_ptr<FFTProcessor> fft_;  ///< FFT stage (shared by chains of equal size/window)
+    FrequencyResampler resampler_;       ///< Frequency mapping stage
+    std::unique_ptr<MultiResolutionAnalyzer> multi_resolution_;  ///< Optional stitched bands
+    std::unique_ptr<SlidingDFT> sliding_dft_;    ///< Optional incremental spectrum
+    std::unique_ptr<ZoomAnalyzer> zoom_;         ///< Optional zoom FFT
+
+    // Prevent copying (large buffers)
+    ProcessingChain(const ProcessingChain&) = delete;
+    ProcessingChain& operator=(const ProcessingChain&) = delete;
+};
+
+/**
+ * @brief Bounded LRU cache of processing chains
+ *
+ * Chains are built on demand (or ahead of time with prewarm()) and shared
+ * via std::shared_ptr, so a chain handed to the analysis thread stays
+ * alive even if the cache evicts it. FFT processors are shared between
+ * chains that differ only in frequency mapping.
+ *
+ * Thread Safety: Not thread-safe. Used from the UI thread only.
+ *
+ * Example:
+ * @code
+ * ProcessingChainCache cache(8);
+ * auto chain = cache.acquire(ChainKey::fromSettings(settings, 432));
+ * cache.prewarm(neighbour_key);   // build before the user asks for it
+ * @endcode
+ */
+class ProcessingChainCache {
+public:
+    /**
+     * @brief Construct cache
+     * @param max_chains Maximum chains kept (must be > 0)
+     * @throws std::invalid_argument if max_chains is 0
+     */
+    explicit ProcessingChainCache(size_t max_chains = 8);
+
+    /**
+     * @brief Get the chain for a key, building it if needed
+     * @param key Configuration
+     * @return Shared chain
+     * @throws std::invalid_argument if the key is invalid
+     */
+    std::shared_ptr<ProcessingChain> acquire(const ChainKey& key);
+
+    /**
+     * @brief Build the chain for a key without marking it as used
+     * @param key Configuration
+     * @return true if built now, false if cached already or the key is invalid
+     */
+    bool prewarm(const ChainKey& key);
+
+    /**
+     * @brief Check whether a key is cached
+     */
+    bool contains(const ChainKey& key) const;
+
+    /**
+     * @brief Get number of cached chains
+     */
+    size_t size() const { return entries_.size(); }
+
+    /**
+     * @brief Get maximum number of cached chains
+     */
+    size_t capacity() const { return max_chains_; }
+
+    /**
+     * @brief Drop all chains (chains in use elsewhere stay alive)
+     */
+    void clear();
+
+private:
+    struct Entry {
+        ChainKey key;
+        std::shared_ptr<ProcessingChain> chain;
+        uint64_t last_used;
+    };
+
+    std::shared_ptr<ProcessingChain> build(const ChainKey& key);
+    std::shared_ptr<FFTProcessor> findFFT(const ChainKey& key) const;
+    void evictLeastRecentlyUsed();
+
+    size_t max_chains_;            ///< Capacity
+    uint64_t use_counter_ = 0;     ///< Monotonic LRU clock
+    std::vector<Entry> entries_;   ///< Cached chains
+};
+
+} // namespace friture
+
+#endif // FRITURE_PROCESSING_CHAIN_HPP
@@ -0,0 +1,162 @@
+/**
+ * @file quality_governor.hpp
+ * @brief Adaptive display quality from per-stage profiler windows
+ *
+ * QualityGovernor keeps both pipeline threads inside their time budgets on
+ * machines too slow for the chosen settings. It reads one StageProfiler
+ * window at a time and trades display quality for time, one step at a
+ * time and within user-set bounds:
+ * - Render thread over budget: drop the status and axis text first, then
+ *   redraw every 2nd, 3rd, ... display refresh (columns are still drained
+ *   every loop iteration, so none are lost)
+ * - Analysis thread over budget: resample to 1/2, 1/4, ... of the display
+ *   rows and stretch the columns back to full height
+ *
+ * The FFT, hop and column timing are never touched, so analysis results
+ * and recordings keep their time base; only what is drawn gets coarser.
+ * Quality comes back one step at a time after several windows in which
+ * the projected load of the better level fits with headroom.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_QUALITY_GOVERNOR_HPP
+#define FRITURE_QUALITY_GOVERNOR_HPP
+
+#include <friture/stage_profiler.hpp>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Display quality chosen by the governor
+ */
+struct QualityLevel {
+    uint32_t frame_interval = 1;   ///< Redraw every Nth display refresh (1 = every one)
+    uint32_t height_divisor = 1;   ///< Analysis rows = display rows / divisor
+    bool minimal_ui = false;       ///< Skip status and axis text (FPS, REC, overlays stay)
+
+    bool operator==(const QualityLevel& other) const = default;
+};
+
+/**
+ * @brief Steps display quality down and up from measured stage timings
+ *
+ * Loads are fractions of the budget (1.0 = exactly on budget):
+ * - Render load: mean renderFrame() work per drawn frame, Present (and
+ *   with it any vsync wait) excluded, over frame_budget_us times the
+ *   current frame interval
+ * - Analysis load: time the analysis thread spent in Read, FFT, Resample
+ *   and Colorize over the window length, divided by analysis_budget
+ *
+ * A load above 1.0 lowers that thread's quality by one step immediately.
+ * A step up needs raise_after consecutive windows in which the load
+ * projected for the better level stays below headroom. The window right
+ * after a change mixes both levels and is skipped.
+ *
+ * Usage:
+ * @code
+ * QualityGovernor governor;
+ * // Render thread, once a second:
+ * StageProfileSnapshot current = profiler.getSnapshot();
+ * if (governor.update(current.since(previous), seconds)) {
+ *     apply(governor.getLevel());
+ * }
+ * previous = current;
+ * @endcode
+ *
+ * Thread Safety: Not thread-safe. Use from the rendering thread only.
+ */
+class QualityGovernor {
+public:
+    /**
+     * @brief Budgets and bounds
+     */
+    struct Options {
+        double frame_budget_us = 16667.0;   ///< Render work per display refresh (60 Hz)
+        double analysis_budget = 0.7;       ///< Busy fraction of real time allowed for analysis
+        double headroom = 0.7;              ///< Projected load below which quality is raised
+        uint32_t raise_after = 3;           ///< Windows with headroom before a step up
+        uint32_t max_frame_interval = 3;    ///< Lowest redraw rate: 1/N of the refresh rate
+        uint32_t max_height_divisor = 4;    ///< Coarsest analysis (power of two, 1 = never)
+        bool allow_minimal_ui = true;       ///< May drop status and axis text
+    };
+
+    /**
+     * @brief Construct governor at full quality
+     * @throws std::invalid_argument if a budget is not positive, headroom is
+     *         not in (0, 1), a bound is 0 or max_height_divisor is not a
+     *         power of two
+     */
+    explicit QualityGovernor(const Options& options);
+    QualityGovernor() : QualityGovernor(Options{}) {}
+
+    /**
+     * @brief Judge one profiler window
+     * @param window Stage histograms of the window (snapshot difference)
+     * @param window_seconds Wall-clock length of the window
+     * @return true if getLevel() changed
+     */
+    bool update(const StageProfileSnapshot& window, double window_seconds);
+
+    /**
+     * @brief Current quality level
+     */
+    const QualityLevel& getLevel() const { return level_; }
+
+    /**
+     * @brief Check whether any quality is currently given up
+     */
+    bool isDegraded() const { return render_step_ > 0 || analysis_step_ > 0; }
+
+    /**
+     * @brief Render load of the last judged window (0 if none)
+     */
+    double getRenderLoad() const { return render_load_; }
+
+    /**
+     * @brief Analysis load of the last judged window (0 if none)
+     */
+    double getAnalysisLoad() const { return analysis_load_; }
+
+    /**
+     * @brief Number of level changes so far
+     */
+    uint64_t getChangeCount() const { return changes_; }
+
+    /**
+     * @brief Return to full quality and forget the load history
+     */
+    void reset();
+
+    /**
+     * @brief Get options
+     */
+    const Options& getOptions() const { return options_; }
+
+private:
+    // Render steps: [minimal UI], then frame intervals 2..max
+    uint32_t renderSteps() const;
+    uint32_t analysisSteps() const;
+    QualityLevel levelFor(uint32_t render_step, uint32_t analysis_step) const;
+
+    bool judgeRender(const StageProfileSnapshot& window);
+    bool judgeAnalysis(const StageProfileSnapshot& window, double window_seconds);
+
+    Options options_;
+    QualityLevel level_;
+    uint32_t render_step_ = 0;
+    uint32_t analysis_step_ = 0;
+    uint32_t render_calm_ = 0;       ///< Consecutive windows with render headroom
+    uint32_t analysis_calm_ = 0;     ///< Consecutive windows with analysis headroom
+    double render_load_ = 0.0;
+    double analysis_load_ = 0.0;
+    double ui_saving_us_ = 0.0;      ///< UI time per frame before text was dropped
+    bool settling_ = false;          ///< Skip the window after a change
+    uint64_t changes_ = 0;
+};
+
+} // namespace friture
+
+#endif // FRITURE_QUALITY_GOVERNOR_HPP
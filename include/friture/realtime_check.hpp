@@ -0,0 +1,188 @@
+/**
+ * @file realtime_check.hpp
+ * @brief Debug checker for allocations and locks on the real-time paths
+ *
+ * The audio callback and the per-hop analysis are written not to allocate
+ * or block, but nothing enforced it. Built with FRITURE_RT_CHECKS (CMake
+ * option of the same name), code inside a RealtimeScope is watched: heap
+ * allocations and frees (operator new/delete, and malloc/free on glibc
+ * without sanitizers) and blocking lock calls (pthread_mutex_lock and
+ * the rwlock locks on Linux; try-locks are fine) are counted as
+ * violations, together with the scope they happened in. Setting
+ * FRITURE_RT_ABORT=1 in the environment, or setAbortOnViolation(true),
+ * aborts on the first one instead, so a debugger stops right at it.
+ *
+ * Without FRITURE_RT_CHECKS the scopes are empty inline objects and
+ * nothing is hooked.
+ *
+ * The hooks replace global functions, so the checker does not work with
+ * ThreadSanitizer (which needs its own mutex interceptors).
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_REALTIME_CHECK_HPP
+#define FRITURE_REALTIME_CHECK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief What a real-time scope did that it should not have
+ */
+enum class RealtimeViolation : uint8_t {
+    Allocation,     ///< Heap allocation (operator new, malloc, calloc, realloc, ...)
+    Deallocation,   ///< Heap free (operator delete, free)
+    Lock            ///< Blocking lock (mutex lock, rwlock read/write lock)
+};
+
+/**
+ * @brief Number of RealtimeViolation kinds
+ */
+constexpr size_t REALTIME_VIOLATION_KINDS = 3;
+
+/**
+ * @brief Get violation kind name ("allocation", "deallocation", "lock")
+ */
+const char* toString(RealtimeViolation kind);
+
+/**
+ * @brief One recorded violation
+ */
+struct RealtimeViolationRecord {
+    RealtimeViolation kind;   ///< What happened
+    const char* scope;        ///< Name of the innermost RealtimeScope
+};
+
+/**
+ * @brief Process-wide violation counters
+ *
+ * Counts are kept per kind; the first MAX_RECORDS violations are also
+ * kept with their scope names. Recording neither allocates nor locks.
+ *
+ * Thread Safety: All functions may be called from any thread. Read the
+ * records once the checked threads are quiet for a consistent picture.
+ *
+ * Example (test mode):
+ * @code
+ * RealtimeCheck::reset();
+ * runPipelineFor(std::chrono::seconds(10));
+ * if (RealtimeCheck::getViolationCount() > 0) {
+ *     RealtimeCheck::report(std::cerr);
+ * }
+ * @endcode
+ */
+class RealtimeCheck {
+public:
+    static constexpr size_t MAX_RECORDS = 32;   ///< Violations kept with their scope
+
+    /**
+     * @brief Whether the checker is compiled in (FRITURE_RT_CHECKS)
+     */
+    static constexpr bool isEnabled() {
+#ifdef FRITURE_RT_CHECKS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Get violations of all kinds since the last reset()
+     */
+    static uint64_t getViolationCount();
+
+    /**
+     * @brief Get violations of one kind since the last reset()
+     */
+    static uint64_t getViolationCount(RealtimeViolation kind);
+
+    /**
+     * @brief Get the first (up to MAX_RECORDS) violations since the last reset()
+     */
+    static std::vector<RealtimeViolationRecord> getRecords();
+
+    /**
+     * @brief Clear counters and records
+     */
+    static void reset();
+
+    /**
+     * @brief Abort (after a message on stderr) on the next violation
+     *
+     * Initially set from the FRITURE_RT_ABORT environment variable.
+     */
+    static void setAbortOnViolation(bool abort);
+
+    /**
+     * @brief Whether violations abort
+     */
+    static bool getAbortOnViolation();
+
+    /**
+     * @brief Print counts per kind and the recorded violations
+     */
+    static void report(std::ostream& out);
+};
+
+/**
+ * @brief Marks the current thread as real-time while alive
+ *
+ * Scopes nest; violations are attributed to the innermost name. The name
+ * must be a string literal (it is kept, not copied).
+ *
+ * Usage:
+ * @code
+ * int audioCallback(...) {
+ *     RealtimeScope scope("audio callback");
+ *     ...   // no new, no mutex from here on
+ * }
+ * @endcode
+ */
+class RealtimeScope {
+public:
+#ifdef FRITURE_RT_CHECKS
+    explicit RealtimeScope(const char* name) noexcept;
+    ~RealtimeScope();
+#else
+    explicit RealtimeScope(const char*) noexcept {}
+#endif
+
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+
+#ifdef FRITURE_RT_CHECKS
+private:
+    const char* outer_;
+#endif
+};
+
+/**
+ * @brief Suspends the checks inside a RealtimeScope while alive
+ *
+ * For the few places on a checked path that are allowed to allocate or
+ * block by design: rebuilding state on the first column after a settings
+ * change, a fork-join hand-off to workers, waking the UI thread. Each
+ * use says why in a comment, so they stay easy to find and review.
+ */
+class RealtimeExemption {
+public:
+#ifdef FRITURE_RT_CHECKS
+    RealtimeExemption() noexcept;
+    ~RealtimeExemption();
+#else
+    RealtimeExemption() noexcept {}
+#endif
+
+    RealtimeExemption(const RealtimeExemption&) = delete;
+    RealtimeExemption& operator=(const RealtimeExemption&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_REALTIME_CHECK_HPP
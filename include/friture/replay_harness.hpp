@@ -0,0 +1,172 @@
+/**
+ * @file replay_harness.hpp
+ * @brief Deterministic replay of a recording through the live analysis path
+ *
+ * This file contains ReplayHarness, which feeds samples through the same
+ * per-hop path as live input: fixed-size blocks are written into a
+ * RingBuffer, every complete window is read back with a cursor and goes
+ * through ProcessingChain::analyze(), the peak detector, the frequency
+ * resampler and the spectral averager. Time is a virtual sample clock
+ * (blocks written so far) rather than steady_clock, so the column stream
+ * depends only on the input and the settings: two builds given the same
+ * input can be compared column for column, and their stage timings side
+ * by side.
+ *
+ * Used by the friture-replay tool; scripts/replay_compare.py diffs two of
+ * its runs.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_REPLAY_HARNESS_HPP
+#define FRITURE_REPLAY_HARNESS_HPP
+
+#include <friture/settings.hpp>
+#include <friture/stage_profiler.hpp>
+#include <functional>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Analysis parameters for a replay
+ */
+struct ReplayOptions {
+    SpectrogramSettings settings;    ///< Analysis configuration (sample_rate is taken from the input)
+    size_t height = 512;             ///< Column height (rows)
+    size_t block_frames = 512;       ///< Samples per virtual audio callback
+    bool peak_detection = false;     ///< Run the peak detector on every spectrum
+};
+
+/**
+ * @brief Result of one replay
+ */
+struct ReplayStats {
+    uint64_t hops = 0;             ///< Windows analyzed
+    uint64_t columns = 0;          ///< Columns emitted (fewer than hops with decimation)
+    size_t rows = 0;               ///< Rows per column
+    size_t hop_size = 0;           ///< Samples between consecutive windows
+    float sample_rate = 0.0f;      ///< Analysis rate (the input's)
+    uint64_t hash = 0;             ///< ReplayHarness::hashColumn() over all columns
+    uint64_t peak_events = 0;      ///< Peak onsets and offsets
+    double audio_seconds = 0.0;    ///< Virtual clock at the end (input length)
+    double seconds = 0.0;          ///< Wall time of the replay
+    StageProfileSnapshot stages;   ///< Read, FFT and Resample timings of this replay
+
+    /**
+     * @brief Get throughput
+     * @return Columns per second of wall time (0 if nothing was timed)
+     */
+    double getColumnsPerSecond() const {
+        return seconds > 0.0 ? static_cast<double>(columns) / seconds : 0.0;
+    }
+
+    /**
+     * @brief Get seconds of audio analyzed per second of wall time
+     */
+    double getRealtimeFactor() const {
+        return seconds > 0.0 ? audio_seconds / seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Replays recordings through the single-column analysis path
+ *
+ * One column per hop in stream order, exactly as the analysis thread
+ * produces them from live input (batched and parallel file modes are
+ * deliberately not used). The dB columns are hashed with FNV-1a over
+ * their float bit patterns: equal hashes mean bit-identical output.
+ *
+ * Thread Safety: one replay at a time per harness.
+ *
+ * Example:
+ * @code
+ * ReplayOptions options;
+ * options.settings.fft_size = 2048;
+ * ReplayHarness harness(options);
+ *
+ * ReplayStats stats;
+ * if (harness.replayFile("in.wav", stats)) {
+ *     std::cout << std::hex << stats.hash << "\n";
+ * }
+ * @endcode
+ */
+class ReplayHarness {
+public:
+    /**
+     * @brief Column callback: one emitted dB column
+     * @param window_end Stream position just past the column's last window sample
+     */
+    using ColumnCallback = std::function<void(uint64_t window_end, const float* column_db, size_t rows)>;
+
+    /**
+     * @brief Sample callback: fill output with mono samples [position, position + count)
+     * @return Samples produced (a short count is padded with silence)
+     */
+    using Source = std::function<size_t(uint64_t position, float* output, size_t count)>;
+
+    static constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ull;   ///< FNV-1a offset basis
+
+    /**
+     * @brief Construct harness
+     * @param options Replay parameters
+     * @throws std::invalid_argument if height or block_frames is 0
+     */
+    explicit ReplayHarness(const ReplayOptions& options);
+    ~ReplayHarness();
+
+    /**
+     * @brief Replay a sample source
+     * @param source Mono sample callback, called once per virtual block in order
+     * @param length Samples in the source
+     * @param sample_rate Sample rate of the source (Hz); becomes the analysis rate
+     * @param on_column Optional callback for every emitted column
+     * @return Replay statistics
+     * @throws std::invalid_argument if the settings are invalid at this rate
+     */
+    ReplayStats replay(const Source& source, uint64_t length, float sample_rate,
+                       const ColumnCallback& on_column = {});
+
+    /**
+     * @brief Replay mono samples held in memory
+     */
+    ReplayStats replay(const float* samples, size_t count, float sample_rate,
+                       const ColumnCallback& on_column = {});
+
+    /**
+     * @brief Replay a WAV file (mixed down to mono)
+     * @param path WAV file
+     * @param stats Replay statistics
+     * @param on_column Optional callback for every emitted column
+     * @return true on success, false on error (see getError())
+     */
+    bool replayFile(const char* path, ReplayStats& stats, const ColumnCallback& on_column = {});
+
+    /**
+     * @brief Get replay parameters
+     */
+    const ReplayOptions& getOptions() const { return options_; }
+
+    /**
+     * @brief Get last replayFile() error message
+     */
+    const std::string& getError() const { return error_; }
+
+    /**
+     * @brief Fold one column into a running FNV-1a hash
+     * @param hash HASH_SEED or the result of the previous column
+     * @return Updated hash
+     */
+    static uint64_t hashColumn(uint64_t hash, const float* column_db, size_t rows);
+
+private:
+    ReplayOptions options_;   ///< Replay parameters
+    std::string error_;       ///< Last error message
+};
+
+} // namespace friture
+
+#endif // FRITURE_REPLAY_HARNESS_HPP
@@ -4,6 +4,8 @@
  *
  * This implementation provides a thread-safe ring buffer using atomic operations.
  * It supports single-writer, multiple-reader pattern common in audio applications.
+ * Readers can either read at arbitrary offsets or follow the stream with a
+ * Cursor, which visits every hop exactly once and reports overruns.
  *
  * @author Friture C++ Port
  * @date 2025-11-06
@@ -16,9 +18,19 @@
 #include <atomic>
 #include <cstring>
 #include <algorithm>
+#include <cstdint>
 
 namespace friture {
 
+/**
+ * @brief Result of a cursor read (see RingBuffer::readWindow)
+ */
+enum class ReadStatus {
+    Ok,        ///< Window read; no samples lost since the previous read
+    NotReady,  ///< Writer has not produced the full window yet; nothing read
+    Overrun    ///< Window read, but the writer lapped the cursor and hops were skipped
+};
+
 /**
  * @brief Lock-free circular buffer template class
  *
@@ -46,9 +58,11 @@ namespace friture {
  * // In audio callback (writer thread):
  * buffer.write(audio_samples, 512);
  *
- * // In processing thread (reader):
- * size_t latest_pos = buffer.getWritePosition();
- * buffer.read(latest_pos - 4096, fft_buffer, 4096);
+ * // In processing thread (reader), analyzing every 1024-sample hop once:
+ * auto cursor = buffer.makeCursor();
+ * while (buffer.readWindow(cursor, fft_buffer, 4096, 1024) != ReadStatus::NotReady) {
+ *     process(fft_buffer);
+ * }
  * @endcode
  */
 template<typename T>
@@ -65,9 +79,65 @@ public:
     explicit RingBuffer(size_t capacity)
         : buffer_(capacity, T{}),
           capacity_(capacity),
-          write_pos_(0) {
+          write_pos_(0),
+          total_written_(0),
+          write_claim_(0) {
     }
 
+    /**
+     * @brief Stream position of one reader
+     *
+     * A cursor holds a monotonic 64-bit sample index into the stream written
+     * so far, plus overrun statistics. Cursors are plain values owned by the
+     * reader thread; any number of them can follow the same buffer.
+     */
+    class Cursor {
+    public:
+        /**
+         * @brief Construct cursor at an absolute stream position
+         * @param position Monotonic sample index (0 = first sample ever written)
+         */
+        explicit Cursor(uint64_t position = 0)
+            : position_(position) {
+        }
+
+        /**
+         * @brief Get start of the next window to be read
+         */
+        uint64_t position() const { return position_; }
+
+        /**
+         * @brief Move cursor to an absolute stream position
+         *
+         * Does not count as an overrun; use when the reader deliberately
+         * discards data (e.g. after being paused).
+         */
+        void seek(uint64_t position) {
+            position_ = position;
+            overrun_pending_ = false;
+        }
+
+        /**
+         * @brief Get number of times the writer lapped this cursor
+         */
+        uint64_t getOverrunCount() const { return overrun_count_; }
+
+        /**
+         * @brief Get total samples skipped because of overruns
+         *
+         * Always a multiple of the hop size used with readWindow().
+         */
+        uint64_t getSamplesLost() const { return samples_lost_; }
+
+    private:
+        friend class RingBuffer;
+
+        uint64_t position_;             ///< Next window start (monotonic)
+        uint64_t overrun_count_ = 0;    ///< Overrun events
+        uint64_t samples_lost_ = 0;     ///< Samples skipped by overruns
+        bool overrun_pending_ = false;  ///< Overrun not yet reported by readWindow()
+    };
+
     /**
      * @brief Write samples to the ring buffer
      * @param data Pointer to source samples
@@ -80,6 +150,12 @@ public:
      */
     void write(const T* data, size_t count) {
         size_t pos = write_pos_.load(std::memory_order_relaxed);
+        uint64_t total = total_written_.load(std::memory_order_relaxed);
+
+        // Announce which samples are about to be overwritten before touching
+        // them, so cursor readers can detect a read torn by this write
+        write_claim_.store(total + count, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
 
         // Calculate how much we can write before wrapping
         size_t end_pos = (pos + count) % capacity_;
@@ -96,6 +172,39 @@ public:
 
         // Update write position (release semantics ensures writes are visible)
         write_pos_.store(end_pos, std::memory_order_release);
+        total_written_.store(total + count, std::memory_order_release);
+    }
+
+    /**
+     * @brief Write every stride-th sample (de-interleave one channel)
+     * @param data Pointer to the first sample of the channel
+     * @param count Number of samples to write
+     * @param stride Distance between consecutive samples (channel count)
+     *
+     * Same semantics as write(), gathering data[0], data[stride], ...
+     * directly into the ring so a multichannel callback needs no scratch
+     * buffer. Thread-safe for single producer.
+     */
+    void writeStrided(const T* data, size_t count, size_t stride) {
+        size_t pos = write_pos_.load(std::memory_order_relaxed);
+        uint64_t total = total_written_.load(std::memory_order_relaxed);
+
+        write_claim_.store(total + count, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        size_t end_pos = (pos + count) % capacity_;
+        size_t first_chunk = (pos + count <= capacity_) ? count : (capacity_ - pos);
+
+        T* dst = buffer_.data() + pos;
+        for (size_t i = 0; i < first_chunk; ++i) {
+            dst[i] = data[i * stride];
+        }
+        for (size_t i = first_chunk; i < count; ++i) {
+            buffer_[i - first_chunk] = data[i * stride];
+        }
+
+        write_pos_.store(end_pos, std::memory_order_release);
+        total_written_.store(total + count, std::memory_order_release);
     }
 
     /**
@@ -105,7 +214,7 @@ public:
      * @param count Number of samples to read
      *
      * The offset is an absolute index that wraps automatically.
-     * Typically called with: getWritePosition() - fft_size
+     * No overrun check is made; prefer readWindow() for streaming reads.
      *
      * Thread-safe for multiple readers.
      *
@@ -132,11 +241,8 @@ public:
      * @return Absolute sample index (wraps at capacity)
      *
      * Use this to determine where new samples are being written.
-     * To read the most recent N samples:
-     * @code
-     * size_t pos = buffer.getWritePosition();
-     * buffer.read(pos - N, output, N);
-     * @endcode
+     * Because it wraps, it cannot tell how much data has been written;
+     * use getTotalWritten() or a Cursor for that.
      *
      * Thread-safe with acquire semantics.
      */
@@ -144,6 +250,92 @@ public:
         return write_pos_.load(std::memory_order_acquire);
     }
 
+    /**
+     * @brief Get total number of samples ever written
+     * @return Monotonic 64-bit sample counter (never wraps in practice)
+     *
+     * Thread-safe with acquire semantics.
+     */
+    uint64_t getTotalWritten() const {
+        return total_written_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Create a cursor positioned relative to the newest sample
+     * @param history Samples before the newest sample to start at (0 = only new data)
+     * @return Cursor (clamped to the oldest sample still in the buffer)
+     */
+    Cursor makeCursor(size_t history = 0) const {
+        uint64_t total = getTotalWritten();
+        uint64_t back = std::min<uint64_t>({history, total, capacity_});
+        return Cursor(total - back);
+    }
+
+    /**
+     * @brief Get number of complete windows a cursor can read right now
+     * @param cursor Reader cursor
+     * @param window Samples per window
+     * @param hop Samples the cursor advances per window (must be > 0)
+     * @return Window count (0 if the next window is not complete)
+     */
+    size_t available(const Cursor& cursor, size_t window, size_t hop) const {
+        uint64_t total = getTotalWritten();
+        if (total < cursor.position_ + window) {
+            return 0;
+        }
+        return static_cast<size_t>((total - cursor.position_ - window) / hop + 1);
+    }
+
+    /**
+     * @brief Read the next window of the stream and advance by one hop
+     * @param cursor Reader cursor (advanced by hop on success)
+     * @param output Destination buffer (at least window samples)
+     * @param window Samples to read (must be <= capacity)
+     * @param hop Samples to advance the cursor by (must be > 0)
+     * @return Ok, NotReady, or Overrun (see ReadStatus)
+     *
+     * Successive calls return windows starting exactly hop samples apart,
+     * so every hop is read once. If the writer has overwritten samples the
+     * cursor still needs, the cursor jumps forward (in whole hops) to the
+     * newest complete window and the next successful read returns Overrun;
+     * cursor.getSamplesLost() tells how much was skipped.
+     *
+     * Reads racing with a write into the same region are detected and
+     * treated as an overrun, so output never holds torn data.
+     */
+    ReadStatus readWindow(Cursor& cursor, T* output, size_t window, size_t hop) const {
+        for (;;) {
+            uint64_t total = total_written_.load(std::memory_order_acquire);
+
+            // Oldest sample needed is already overwritten
+            if (total > cursor.position_ + capacity_) {
+                skipToNewest(cursor, total, window, hop);
+                continue;
+            }
+
+            if (total < cursor.position_ + window) {
+                return ReadStatus::NotReady;
+            }
+
+            read(static_cast<size_t>(cursor.position_ % capacity_), output, window);
+
+            // Check that no write started overwriting the window while copying
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t claim = write_claim_.load(std::memory_order_relaxed);
+            if (claim > cursor.position_ + capacity_) {
+                skipToNewest(cursor, claim, window, hop);
+                continue;
+            }
+
+            cursor.position_ += hop;
+            if (cursor.overrun_pending_) {
+                cursor.overrun_pending_ = false;
+                return ReadStatus::Overrun;
+            }
+            return ReadStatus::Ok;
+        }
+    }
+
     /**
      * @brief Get buffer capacity
      * @return Maximum number of samples
@@ -153,9 +345,27 @@ public:
     }
 
 private:
-    std::vector<T> buffer_;          ///< Underlying storage (pre-allocated)
-    size_t capacity_;                ///< Maximum number of samples
-    std::atomic<size_t> write_pos_;  ///< Current write position (lock-free)
+    /**
+     * @brief Jump a lapped cursor to the newest complete window on its hop grid
+     */
+    void skipToNewest(Cursor& cursor, uint64_t total, size_t window, size_t hop) const {
+        uint64_t target = (total > window) ? total - window : 0;
+        uint64_t skip = (target > cursor.position_) ? (target - cursor.position_) / hop * hop : 0;
+        if (skip == 0) {
+            skip = hop;  // Always make progress past the overwritten hop
+        }
+
+        cursor.position_ += skip;
+        cursor.samples_lost_ += skip;
+        cursor.overrun_count_++;
+        cursor.overrun_pending_ = true;
+    }
+
+    std::vector<T> buffer_;                 ///< Underlying storage (pre-allocated)
+    size_t capacity_;                       ///< Maximum number of samples
+    std::atomic<size_t> write_pos_;         ///< Current write position (lock-free)
+    std::atomic<uint64_t> total_written_;   ///< Samples ever written (monotonic)
+    std::atomic<uint64_t> write_claim_;     ///< total_written_ once the write in progress ends
 
     // Prevent copying (would be expensive and rarely useful)
     RingBuffer(const RingBuffer&) = delete;
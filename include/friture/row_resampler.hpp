@@ -0,0 +1,148 @@
+/**
+ * @file row_resampler.hpp
+ * @brief Rescaling of stored spectrogram columns to a new row count
+ *
+ * When the window is resized, the columns already on screen (and in the
+ * history) are rescaled from their quantized levels instead of being
+ * analyzed again. Growing interpolates linearly between the two nearest
+ * source rows; shrinking keeps the maximum of the source rows each output
+ * row covers, so narrow peaks stay visible (as SpectrogramHistory pools
+ * columns).
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_ROW_RESAMPLER_HPP
+#define FRITURE_ROW_RESAMPLER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief Maps 'input rows' levels onto 'output rows' levels
+ *
+ * The taps are computed once; resampleColumn() handles contiguous
+ * (column-major) columns, resampleRows() handles row-major blocks a whole
+ * row at a time, where the inner loop runs over contiguous columns and
+ * vectorizes (a multiply-add or a max per level).
+ *
+ * Thread Safety: const methods may be called from several threads at once
+ * (e.g. on disjoint row ranges from TaskPool workers).
+ *
+ * Example:
+ * @code
+ * RowResampler rows(540, 1080);
+ * rows.resampleColumn(old_column, new_column);   // 540 → 1080 levels
+ * @endcode
+ */
+class RowResampler {
+public:
+    /**
+     * @brief Compute the taps
+     * @param input_rows Rows of the stored columns (> 0)
+     * @param output_rows Rows wanted (> 0)
+     * @throws std::invalid_argument if either count is 0
+     *
+     * Output row r is centred on input position (r + 0.5)·in/out - 0.5,
+     * the same stretch FritureApp applies to coarser analysis columns.
+     */
+    RowResampler(size_t input_rows, size_t output_rows);
+
+    /**
+     * @brief Rescale one contiguous column
+     * @param input input_rows levels
+     * @param output output_rows levels (may not alias input)
+     */
+    template <typename T>
+    void resampleColumn(const T* input, T* output) const {
+        for (size_t r = 0; r < taps_.size(); ++r) {
+            const Tap& tap = taps_[r];
+            if (pooling_) {
+                T value = input[tap.first];
+                for (size_t row = tap.first + 1; row < tap.last; ++row) {
+                    value = std::max(value, input[row]);
+                }
+                output[r] = value;
+            } else {
+                const float a = static_cast<float>(input[tap.first]);
+                const float b = static_cast<float>(input[tap.last]);
+                output[r] = static_cast<T>(a + tap.weight * (b - a) + 0.5f);
+            }
+        }
+    }
+
+    /**
+     * @brief Rescale output rows [row_begin, row_end) of a row-major block
+     * @param input First level of input row 0
+     * @param input_pitch Levels between consecutive input rows
+     * @param output First level of output row 0
+     * @param output_pitch Levels between consecutive output rows
+     * @param columns Contiguous levels per row to process
+     * @param row_begin First output row
+     * @param row_end One past the last output row (<= output_rows)
+     */
+    template <typename T>
+    void resampleRows(const T* input, size_t input_pitch, T* output, size_t output_pitch,
+                      size_t columns, size_t row_begin, size_t row_end) const {
+        for (size_t r = row_begin; r < row_end; ++r) {
+            const Tap& tap = taps_[r];
+            T* out = output + r * output_pitch;
+            const T* first = input + tap.first * input_pitch;
+
+            if (pooling_) {
+                std::copy(first, first + columns, out);
+                for (size_t row = tap.first + 1; row < tap.last; ++row) {
+                    const T* in = input + row * input_pitch;
+                    for (size_t c = 0; c < columns; ++c) {
+                        out[c] = std::max(out[c], in[c]);
+                    }
+                }
+            } else {
+                const T* second = input + tap.last * input_pitch;
+                const float t = tap.weight;
+                for (size_t c = 0; c < columns; ++c) {
+                    const float a = static_cast<float>(first[c]);
+                    const float b = static_cast<float>(second[c]);
+                    out[c] = static_cast<T>(a + t * (b - a) + 0.5f);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Get the input row nearest to an output row's centre
+     *
+     * For planes that cannot be interpolated (colors).
+     */
+    size_t nearestRow(size_t output_row) const { return nearest_[output_row]; }
+
+    size_t getInputRows() const { return input_rows_; }
+    size_t getOutputRows() const { return taps_.size(); }
+
+private:
+    /**
+     * @brief Input rows feeding one output row
+     *
+     * Interpolating: first and last (= first + 1, or first at the edges)
+     * blended by weight. Pooling: the maximum over [first, last).
+     */
+    struct Tap {
+        size_t first;
+        size_t last;
+        float weight;
+    };
+
+    size_t input_rows_;
+    bool pooling_;                 ///< Shrinking: max over covered rows
+    std::vector<Tap> taps_;        ///< One per output row
+    std::vector<size_t> nearest_;  ///< Nearest input row per output row
+};
+
+} // namespace friture
+
+#endif // FRITURE_ROW_RESAMPLER_HPP
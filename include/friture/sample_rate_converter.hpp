@@ -0,0 +1,204 @@
+/**
+ * @file sample_rate_converter.hpp
+ * @brief Polyphase sample-rate conversion to the analysis rate
+ *
+ * The FrequencyResampler mapping, the hop timing and the level meter are
+ * all built for one sample rate. Files and devices running at another
+ * rate (44.1 / 48 / 96 kHz material) are converted to it before they
+ * reach a ring buffer, and a lower analysis rate (e.g. 96 kHz → 24 kHz)
+ * decimates the input when only the lower bands matter, cutting the FFT
+ * work per second by the same factor.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_SAMPLE_RATE_CONVERTER_HPP
+#define FRITURE_SAMPLE_RATE_CONVERTER_HPP
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Rational-ratio polyphase resampler
+ *
+ * The ratio is reduced to output/input = L/M. Output sample n sits at
+ * input time n·M/L and is a dot product of the input around it with one
+ * of L phases of a Kaiser-windowed sinc, cut off at ROLLOFF × the lower
+ * Nyquist frequency (so decimation is alias-free). Each phase is stored
+ * contiguously and reversed, so an output costs one vectorized
+ * simd::dotProduct() over getTapCount() samples. The phases are
+ * normalized to unity DC gain.
+ *
+ * Filter banks are computed once per (L, M, taps) and shared by every
+ * converter with that ratio, so switching devices or files is cheap.
+ *
+ * Two ways to drive it:
+ * - Position-addressed (seekable sources): convert() computes any output
+ *   range from the input span getFirstInput() / getInputSpan() describe.
+ *   Outputs are aligned with the input (no delay); input before sample 0
+ *   is taken as silence.
+ * - Streaming (device callbacks): process() takes input blocks of any
+ *   size and returns the outputs that became computable, the same values
+ *   convert() gives. It holds back getLatency() input samples and never
+ *   allocates.
+ *
+ * Thread Safety: convert() is const and may run concurrently; process()
+ * and reset() are not thread-safe.
+ *
+ * Example:
+ * @code
+ * SampleRateConverter src(44100, 48000);
+ * std::vector<float> out(src.getMaxOutput(block.size()));
+ * size_t produced = src.process(block.data(), block.size(), out.data());
+ * ring.write(out.data(), produced);
+ * @endcode
+ */
+class SampleRateConverter {
+public:
+    static constexpr size_t DEFAULT_TAPS = 64;           ///< Taps per output at the input rate
+    static constexpr size_t MAX_TAPS = 1024;             ///< Taps per output after decimation scaling
+    static constexpr size_t MAX_PHASES = 4096;           ///< Largest reduced L
+    static constexpr size_t DEFAULT_MAX_BLOCK = 8192;    ///< process() chunk without reserve()
+    static constexpr double ROLLOFF = 0.9;               ///< Cutoff relative to the lower Nyquist
+    static constexpr double KAISER_BETA = 8.0;           ///< About 80 dB stopband
+
+    /**
+     * @brief Construct converter
+     * @param input_rate Source rate in Hz
+     * @param output_rate Target rate in Hz
+     * @param taps Filter taps per output for upsampling (multiple of 8, >= 8);
+     *             scaled by M/L when decimating so the transition band
+     *             keeps its width relative to the output rate
+     * @throws std::invalid_argument if a rate is 0, taps is invalid, the
+     *         reduced L exceeds MAX_PHASES or the scaled taps exceed MAX_TAPS
+     */
+    SampleRateConverter(uint32_t input_rate, uint32_t output_rate, size_t taps = DEFAULT_TAPS);
+
+    uint32_t getInputRate() const { return input_rate_; }
+    uint32_t getOutputRate() const { return output_rate_; }
+
+    /**
+     * @brief Get reduced upsampling factor L (number of phases)
+     */
+    size_t getPhaseCount() const { return up_; }
+
+    /**
+     * @brief Get reduced downsampling factor M
+     */
+    size_t getDecimation() const { return down_; }
+
+    /**
+     * @brief Get filter taps per output sample
+     */
+    size_t getTapCount() const { return taps_; }
+
+    /**
+     * @brief Check whether input and output rates are equal (outputs copy the input)
+     */
+    bool isPassthrough() const { return up_ == down_; }
+
+    /**
+     * @brief Get filter bank (getPhaseCount() × getTapCount() coefficients)
+     *
+     * Converters with the same ratio and taps return the same pointer.
+     */
+    const float* getFilterBank() const { return bank_->data(); }
+
+    // ------------------------------------------------------------------
+    // Position-addressed conversion
+    // ------------------------------------------------------------------
+
+    /**
+     * @brief Get number of outputs covering an input of the given length
+     * @return ceil(input_length × L / M)
+     */
+    uint64_t getOutputLength(uint64_t input_length) const;
+
+    /**
+     * @brief Get first input sample read by an output sample
+     * @param output Output sample index
+     * @return Input index (negative near the start: silence)
+     */
+    int64_t getFirstInput(uint64_t output) const;
+
+    /**
+     * @brief Get input samples needed for count consecutive outputs
+     * @param count Output samples
+     * @return Span starting at getFirstInput() of the first output (0 for count 0)
+     */
+    size_t getInputSpan(size_t count) const;
+
+    /**
+     * @brief Compute outputs [first_output, first_output + count)
+     * @param input Input samples starting at input index input_first
+     * @param input_first Input index of input[0] (<= getFirstInput(first_output))
+     * @param first_output First output sample index
+     * @param count Output samples
+     * @param output Destination [count]
+     *
+     * input must extend to getFirstInput(first_output) + getInputSpan(count).
+     */
+    void convert(const float* input, int64_t input_first,
+                 uint64_t first_output, size_t count, float* output) const;
+
+    // ------------------------------------------------------------------
+    // Streaming conversion
+    // ------------------------------------------------------------------
+
+    /**
+     * @brief Size the streaming history so process() never allocates
+     * @param max_block Input samples handled per internal step
+     *
+     * Larger process() calls are split into steps of this size. Call
+     * before streaming starts (clears buffered input like reset()).
+     */
+    void reserve(size_t max_block);
+
+    /**
+     * @brief Upper bound of process() outputs for an input block
+     * @param input_count Input samples passed to process()
+     */
+    size_t getMaxOutput(size_t input_count) const;
+
+    /**
+     * @brief Convert the next input block
+     * @param input Input samples [count]
+     * @param count Input samples
+     * @param output Destination [getMaxOutput(count)]
+     * @return Outputs written
+     */
+    size_t process(const float* input, size_t count, float* output);
+
+    /**
+     * @brief Restart the stream at output 0 with silent history
+     */
+    void reset();
+
+    /**
+     * @brief Get input samples process() holds back before their outputs
+     */
+    size_t getLatency() const { return isPassthrough() ? 0 : taps_ / 2; }
+
+private:
+    uint32_t input_rate_;
+    uint32_t output_rate_;
+    size_t up_;      ///< L
+    size_t down_;    ///< M
+    size_t taps_;    ///< Taps per phase
+    std::shared_ptr<const std::vector<float>> bank_;  ///< [phase][taps], reversed
+
+    // Streaming state
+    std::vector<float> history_;  ///< Input from history_first_ (capacity taps_ + max block)
+    size_t history_size_ = 0;     ///< Valid samples in history_
+    int64_t history_first_ = 0;   ///< Input index of history_[0]
+    uint64_t next_output_ = 0;    ///< Next output process() emits
+};
+
+} // namespace friture
+
+#endif // FRITURE_SAMPLE_RATE_CONVERTER_HPP
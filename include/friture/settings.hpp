@@ -61,14 +61,26 @@ struct SpectrogramSettings {
     WindowFunction window_type = WindowFunction::Hann;
 
     /**
-     * @brief FFT overlap percentage (fixed at 75%)
+     * @brief Kaiser window shape β (used only with WindowFunction::Kaiser)
+     *
+     * 0 is a rectangular window; larger values trade a wider main lobe
+     * for lower sidelobes. Valid range: [0, MAX_KAISER_BETA]
+     */
+    float kaiser_beta = DEFAULT_KAISER_BETA;
+
+    /**
+     * @brief FFT overlap percentage
      *
      * Overlap determines how much consecutive FFT frames share samples.
-     * 75% overlap provides good time resolution without excessive computation.
+     * 75% overlap provides good time resolution without excessive computation;
+     * 93.75% and above give smooth waterfalls, and at such small hops the
+     * chain may switch to incremental updates (see SlidingDFT).
      *
-     * Note: Currently fixed; may become configurable in future versions.
+     * Valid range: [0, MAX_OVERLAP_PERCENT]. Default: 75%
      */
-    static constexpr float overlap_percent = 75.0f;
+    float overlap_percent = 75.0f;
+
+    static constexpr float MAX_OVERLAP_PERCENT = 99.9f;  ///< Upper overlap limit
 
     // ========================================================================
     // Frequency Settings
@@ -97,6 +109,52 @@ struct SpectrogramSettings {
      */
     float max_freq = 24000.0f;
 
+    /**
+     * @brief How FFT bins are combined into display rows
+     *
+     * Default: MeanPower (every bin contributes, so narrow tones do not
+     * flicker when the FFT has more bins than the display has rows)
+     */
+    BinAggregation bin_aggregation = BinAggregation::MeanPower;
+
+    /**
+     * @brief Use larger FFTs for the low rows of log-like scales
+     *
+     * Only applies to the Logarithmic and Octave scales, where the bottom
+     * rows are narrower than one bin of fft_size (see MultiResolutionAnalyzer).
+     * Default: false
+     */
+    bool multi_resolution = false;
+
+    /**
+     * @brief Zoom FFT into min_freq..max_freq
+     *
+     * Mixes the band centre down to 0 Hz, decimates and runs a complex FFT
+     * of fft_size at the reduced rate, for bins up to ZoomAnalyzer::MAX_DECIMATION
+     * times finer. Only applies when the range is narrow compared with the
+     * sample rate (see ZoomAnalyzer::decimationFor()); takes precedence
+     * over multi_resolution.
+     * Default: false
+     */
+    bool zoom = false;
+
+    /**
+     * @brief How multichannel input shares the display
+     *
+     * Only used when more than one channel is captured.
+     * Default: Stacked (one lane per channel)
+     */
+    ChannelLayout channel_layout = ChannelLayout::Stacked;
+
+    /**
+     * @brief Dual-channel transfer function view
+     *
+     * Replaces the per-channel display when at least two live channels are
+     * captured: channel 0 is the reference, channel 1 the measured signal
+     * (see CrossSpectrumAnalyzer). Default: Off
+     */
+    TransferView transfer = TransferView::Off;
+
     // ========================================================================
     // Amplitude Settings
     // ========================================================================
@@ -129,6 +187,42 @@ struct SpectrogramSettings {
      */
     float time_range = 10.0f;
 
+    /**
+     * @brief How consecutive spectra are averaged before display
+     *
+     * Averages are taken in linear power (see SpectralAverager).
+     * Default: None
+     */
+    AveragingMode averaging = AveragingMode::None;
+
+    /**
+     * @brief Averaging time constant (seconds)
+     *
+     * Exponential averaging time constant and PeakHold decay time.
+     * Valid range: (0, MAX_AVERAGING_TIME]. Default: 1 second
+     */
+    float averaging_time = 1.0f;
+
+    /**
+     * @brief Number of spectra in the Linear average
+     *
+     * Valid range: [1, MAX_AVERAGING_FRAMES]. Default: 8
+     */
+    size_t averaging_frames = 8;
+
+    /**
+     * @brief Analysis hops per displayed column
+     *
+     * Values above 1 display one column per column_decimation hops, so
+     * long time ranges need fewer columns to colorize, store and upload.
+     * Valid range: [1, MAX_COLUMN_DECIMATION]. Default: 1
+     */
+    size_t column_decimation = 1;
+
+    static constexpr float MAX_AVERAGING_TIME = 60.0f;      ///< Upper averaging_time limit
+    static constexpr size_t MAX_AVERAGING_FRAMES = 256;     ///< Upper averaging_frames limit
+    static constexpr size_t MAX_COLUMN_DECIMATION = 64;     ///< Upper column_decimation limit
+
     // ========================================================================
     // Audio Processing Settings
     // ========================================================================
@@ -161,6 +255,7 @@ struct SpectrogramSettings {
      * - Frequency range is valid (min < max, both > 0)
      * - Amplitude range is valid (min < max)
      * - Time range is positive
+     * - Averaging time, frames and column decimation are in range
      * - Frequencies don't exceed Nyquist limit
      */
     bool isValid() const {
@@ -196,6 +291,27 @@ struct SpectrogramSettings {
             return false;
         }
 
+        // Check averaging and decimation
+        if (!(averaging_time > 0.0f && averaging_time <= MAX_AVERAGING_TIME)) {
+            return false;
+        }
+        if (averaging_frames < 1 || averaging_frames > MAX_AVERAGING_FRAMES) {
+            return false;
+        }
+        if (column_decimation < 1 || column_decimation > MAX_COLUMN_DECIMATION) {
+            return false;
+        }
+
+        // Check overlap
+        if (!(overlap_percent >= 0.0f && overlap_percent <= MAX_OVERLAP_PERCENT)) {
+            return false;
+        }
+
+        // Check Kaiser shape
+        if (!(kaiser_beta >= 0.0f && kaiser_beta <= MAX_KAISER_BETA)) {
+            return false;
+        }
+
         return true;
     }
 
@@ -214,6 +330,38 @@ struct SpectrogramSettings {
         return true;
     }
 
+    /**
+     * @brief Set window function with validation
+     * @param type Window function
+     * @param beta Kaiser β (ignored unless type is WindowFunction::Kaiser)
+     * @return true if beta was valid and the window set, false otherwise
+     *
+     * Constraints: beta must be in range [0, MAX_KAISER_BETA]
+     */
+    bool setWindow(WindowFunction type, float beta = DEFAULT_KAISER_BETA) {
+        if (!(beta >= 0.0f && beta <= MAX_KAISER_BETA)) {
+            return false;
+        }
+        window_type = type;
+        kaiser_beta = beta;
+        return true;
+    }
+
+    /**
+     * @brief Set overlap with validation
+     * @param percent Overlap between consecutive frames in percent
+     * @return true if overlap was valid and set, false otherwise
+     *
+     * Constraints: Must be in range [0, MAX_OVERLAP_PERCENT]
+     */
+    bool setOverlap(float percent) {
+        if (!(percent >= 0.0f && percent <= MAX_OVERLAP_PERCENT)) {
+            return false;
+        }
+        overlap_percent = percent;
+        return true;
+    }
+
     /**
      * @brief Set frequency range with validation
      * @param min Minimum frequency (Hz)
@@ -278,6 +426,44 @@ struct SpectrogramSettings {
         return true;
     }
 
+    /**
+     * @brief Set averaging mode with validation
+     * @param mode Averaging mode
+     * @param time Time constant in seconds (Exponential and PeakHold)
+     * @param frames Number of spectra averaged (Linear)
+     * @return true if time and frames were valid and the mode set, false otherwise
+     *
+     * Constraints: time in (0, MAX_AVERAGING_TIME], frames in
+     * [1, MAX_AVERAGING_FRAMES]
+     */
+    bool setAveraging(AveragingMode mode, float time, size_t frames) {
+        if (!(time > 0.0f && time <= MAX_AVERAGING_TIME)) {
+            return false;
+        }
+        if (frames < 1 || frames > MAX_AVERAGING_FRAMES) {
+            return false;
+        }
+        averaging = mode;
+        averaging_time = time;
+        averaging_frames = frames;
+        return true;
+    }
+
+    /**
+     * @brief Set column decimation with validation
+     * @param hops Analysis hops per displayed column
+     * @return true if hops was valid and set, false otherwise
+     *
+     * Constraints: Must be in range [1, MAX_COLUMN_DECIMATION]
+     */
+    bool setColumnDecimation(size_t hops) {
+        if (hops < 1 || hops > MAX_COLUMN_DECIMATION) {
+            return false;
+        }
+        column_decimation = hops;
+        return true;
+    }
+
     /**
      * @brief Set sample rate and adjust frequency limits if needed
      * @param rate Sample rate in Hz
@@ -312,10 +498,11 @@ struct SpectrogramSettings {
 
     /**
      * @brief Get number of samples per FFT column (based on overlap)
-     * @return Number of samples between consecutive FFT frames
+     * @return Number of samples between consecutive FFT frames (at least 1)
      */
     size_t getSamplesPerColumn() const {
-        return static_cast<size_t>(fft_size * (1.0f - overlap_percent / 100.0f));
+        size_t hop = static_cast<size_t>(fft_size * (1.0f - overlap_percent / 100.0f));
+        return hop > 0 ? hop : 1;
     }
 
     /**
@@ -0,0 +1,205 @@
+/**
+ * @file simd_kernels.hpp
+ * @brief Vectorized inner loops for spectrum processing
+ *
+ * This file declares the SIMD kernels used by FFTProcessor: window
+ * multiplication and power spectrum to dB conversion, plus the dB to
+ * linear power conversion used by FrequencyResampler, the dB to palette
+ * lookup used by ColorTransform, the dot product of the
+ * SampleRateConverter filter phases, the noise floor tracking of
+ * PeakDetector and the power averages of SpectralAverager. Each kernel has AVX2 (x86-64, selected at runtime), NEON
+ * (AArch64) and scalar implementations behind a single entry point.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_SIMD_KERNELS_HPP
+#define FRITURE_SIMD_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+namespace simd {
+
+/**
+ * @brief Instruction set used by the kernels
+ */
+enum class Isa {
+    Scalar,  ///< Portable C++ loops
+    AVX2,    ///< x86-64 AVX2 + FMA (runtime detected)
+    NEON     ///< AArch64 Advanced SIMD
+};
+
+/**
+ * @brief Maximum error of fastLog10() in dB (10 × log10 units)
+ *
+ * The approximation splits x into 2^e × m with m in [√½, √2) and evaluates
+ * ln(m) = 2·atanh((m-1)/(m+1)) with five series terms. The truncation
+ * error is below 1e-9 dB; the bound is dominated by float rounding.
+ */
+constexpr float FAST_LOG10_MAX_ERROR_DB = 0.001f;
+
+/**
+ * @brief Maximum relative error of fastDbToPower()
+ *
+ * 10^(dB/10) is evaluated as 2^round(y) × 2^f with y = dB × log2(10)/10 and
+ * f in [-½, ½], using a degree 6 polynomial for 2^f (truncation ≈ 1.2e-7).
+ * At ±370 dB the float rounding of y dominates (≈ 3e-6, i.e. 1e-5 dB).
+ */
+constexpr float FAST_DB_TO_POWER_MAX_REL_ERROR = 1e-5f;
+
+/**
+ * @brief Get the instruction set selected on this CPU
+ * @return Isa chosen once at first use
+ */
+Isa activeIsa();
+
+/**
+ * @brief Get printable instruction set name
+ * @param isa Instruction set
+ * @return "Scalar", "AVX2" or "NEON"
+ */
+const char* toString(Isa isa);
+
+/**
+ * @brief Fast log10 approximation (scalar reference of the vector kernels)
+ * @param x Input value (must be positive and normal)
+ * @return log10(x) within FAST_LOG10_MAX_ERROR_DB / 10
+ */
+float fastLog10(float x);
+
+/**
+ * @brief Fast 10^(dB/10) (scalar reference of the vector kernels)
+ * @param db Level in dB (clamped to about ±380 dB)
+ * @return Linear power within FAST_DB_TO_POWER_MAX_REL_ERROR
+ */
+float fastDbToPower(float db);
+
+/**
+ * @brief Element-wise multiply: output[i] = input[i] * window[i]
+ * @param input Input samples [n]
+ * @param window Window coefficients [n]
+ * @param output Destination [n] (may alias input)
+ * @param n Number of samples
+ */
+void applyWindow(const float* input, const float* window, float* output, size_t n);
+
+/**
+ * @brief Convert complex FFT bins to dB: 10 × log10(|X|² × scale + epsilon)
+ * @param spectrum Interleaved (re, im) pairs [2 × n]
+ * @param output dB values [n]
+ * @param n Number of bins
+ * @param scale Power normalization (e.g. 1/N²)
+ * @param epsilon Floor added before the log to avoid log(0)
+ * @param exact Use std::log10 instead of the fast approximation
+ *
+ * With exact = false the result is within FAST_LOG10_MAX_ERROR_DB of the
+ * exact value. With exact = true, the squaring is still vectorized but
+ * the log uses std::log10 per bin.
+ */
+void powerToDb(const float* spectrum, float* output, size_t n,
+               float scale, float epsilon, bool exact);
+
+/**
+ * @brief Convert dB values to linear power: output[i] = 10^(db[i] / 10)
+ * @param db Levels in dB [n]
+ * @param output Linear power [n] (may alias db)
+ * @param n Number of values
+ *
+ * Same accuracy as fastDbToPower().
+ */
+void dbToPower(const float* db, float* output, size_t n);
+
+/**
+ * @brief Map dB values straight to 256-entry palette colors
+ * @param db Levels in dB [n]
+ * @param n Number of values
+ * @param min_db Level mapped to palette[0]
+ * @param scale 255 / (max_db - min_db)
+ * @param palette 256 RGBA colors
+ * @param output Colors [n]
+ *
+ * output[i] = palette[trunc(clamp((db[i] - min_db) × scale, 0, 255))], with
+ * NaN mapped to palette[0]. AVX2 uses a gather; NEON computes the indices
+ * four at a time and looks them up per lane.
+ */
+void dbToPalette(const float* db, size_t n, float min_db, float scale,
+                 const uint32_t* palette, uint32_t* output);
+
+/**
+ * @brief Dot product: Σ a[i] × b[i]
+ * @param a First vector [n]
+ * @param b Second vector [n]
+ * @param n Number of elements
+ * @return Sum of products (summation order differs per ISA)
+ */
+float dotProduct(const float* a, const float* b, size_t n);
+
+/**
+ * @brief Update a per-bin noise floor and report each bin's excess over it
+ * @param db Levels of the new spectrum in dB [n]
+ * @param floor Running floor in dB [n], updated in place
+ * @param excess Destination for db[i] - floor[i] before the update [n]
+ * @param n Number of bins
+ * @param rise Averaging coefficient for bins above their floor
+ * @param fall Averaging coefficient for bins at or below their floor
+ * @return Largest excess (lowest float if n == 0)
+ *
+ * floor[i] += (excess[i] > 0 ? rise : fall) × excess[i], an exponential
+ * average that rises and falls at different rates. The vector code does
+ * not fuse the multiply-add, so every ISA rounds like the scalar loop.
+ */
+float trackFloor(const float* db, float* floor, float* excess, size_t n,
+                 float rise, float fall);
+
+/**
+ * @brief Exponential average in place: average[i] += weight × (power[i] - average[i])
+ * @param power New values [n]
+ * @param average Running average [n], updated in place
+ * @param n Number of values
+ * @param weight Weight of the new values, in [0, 1]
+ *
+ * Multiply and add are not fused, as in trackFloor().
+ */
+void averagePower(const float* power, float* average, size_t n, float weight);
+
+/**
+ * @brief Decaying maximum in place: held[i] = max(power[i], held[i] × decay)
+ * @param power New values [n]
+ * @param held Held maxima [n], updated in place
+ * @param n Number of values
+ * @param decay Factor applied to the held values first, in [0, 1]
+ */
+void holdPower(const float* power, float* held, size_t n, float decay);
+
+/**
+ * @brief Slide a running sum by one frame
+ * @param power Values entering the sum [n]
+ * @param oldest Values leaving the sum [n], replaced by power
+ * @param sum Running sum [n]: sum[i] += power[i] - oldest[i]
+ * @param n Number of values
+ *
+ * The sum is kept in double: a loud frame leaving a float sum would
+ * leave rounding residue about 70 dB below it in place of quiet frames.
+ */
+void slidePower(const float* power, float* oldest, double* sum, size_t n);
+
+/**
+ * @brief Convert linear power to dB: 10 × log10(max(power[i] × scale, floor))
+ * @param power Linear power [n]
+ * @param output dB values [n] (may alias power)
+ * @param n Number of values
+ * @param scale Normalization (e.g. 1 / frames averaged)
+ * @param floor Smallest power converted (positive and normal); also
+ *        absorbs the rounding of running sums below zero
+ *
+ * Within FAST_LOG10_MAX_ERROR_DB of the exact value.
+ */
+void linearToDb(const float* power, float* output, size_t n, float scale, float floor);
+
+} // namespace simd
+} // namespace friture
+
+#endif // FRITURE_SIMD_KERNELS_HPP
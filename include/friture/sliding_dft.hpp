@@ -0,0 +1,155 @@
+/**
+ * @file sliding_dft.hpp
+ * @brief Incremental spectrum update for small hops
+ *
+ * At high overlap each column only adds a handful of new samples, yet a
+ * full FFT recomputes every bin. SlidingDFT instead advances the DFT bins
+ * the display actually reads by one sample at a time, so a column costs
+ * O(hop × displayed bins) instead of O(N log N).
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_SLIDING_DFT_HPP
+#define FRITURE_SLIDING_DFT_HPP
+
+#include <friture/types.hpp>
+#include <friture/frequency_resampler.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Sliding DFT over the bins a FrequencyResampler reads
+ *
+ * FFTProcessor's Hann and Hamming windows are symmetric,
+ * w[n] = a - b·cos(2πn/(N-1)), so a
+ * windowed bin is a·Y(k) - (b/2)·(Y(k - δ) + Y(k + δ)) with δ = N/(N-1),
+ * where Y(f) = Σ x[n]·e^{-j2πfn/N} over the frame. Each displayed bin
+ * keeps those three sums, and each new sample x[n + N] advances them in
+ * O(1): Y ← (Y - x[n] + x[n + N]·e^{-j2πf})·e^{j2πf/N}. Output is the same
+ * |X_w|²/(N · coherent gain)² dB spectrum as FFTProcessor::process() (with
+ * exact log10); bins the resampler never reads are left at the floor.
+ * Other windows need more cosine terms than SUMS_PER_BIN covers, so
+ * chains using them keep the FFT (see supports()).
+ *
+ * process() receives the full frame every column, as the FFT path does,
+ * and compares it with the previous frame shifted by one hop. Any gap
+ * (dropped columns, seek, chain switch) reseeds the sums directly from the
+ * frame, which costs O(N) per sum, so once per RESEED_FRAMES frame lengths
+ * of input the same reseed also clears rounding drift. Sums are kept in
+ * double precision in between.
+ *
+ * Thread Safety: Not thread-safe.
+ *
+ * Example:
+ * @code
+ * auto bins = SlidingDFT::displayedBins(resampler, fft_size / 2 + 1);
+ * if (SlidingDFT::isCheaper(fft_size, hop, bins.size())) {
+ *     SlidingDFT sliding(fft_size, WindowFunction::Hann, hop, bins);
+ *     sliding.process(frame, spectrum_db);   // each column
+ * }
+ * @endcode
+ */
+class SlidingDFT {
+public:
+    static constexpr size_t SUMS_PER_BIN = 3;      ///< Y(k - δ), Y(k), Y(k + δ)
+    static constexpr size_t RESEED_FRAMES = 64;    ///< Frame lengths of input between drift-clearing reseeds
+
+    /**
+     * @brief Construct sliding DFT
+     * @param fft_size Frame length N (as FFTProcessor: power of 2, 32-16384)
+     * @param window Window function (as FFTProcessor; see supports())
+     * @param hop Samples between consecutive frames (1 to fft_size)
+     * @param displayed_bins Output bins to keep up to date (each < fft_size/2 + 1)
+     * @throws std::invalid_argument on invalid parameters or an unsupported window
+     */
+    SlidingDFT(size_t fft_size, WindowFunction window, size_t hop,
+               const std::vector<uint32_t>& displayed_bins);
+
+    /**
+     * @brief Check whether a window has the two-term form sliding needs
+     * @return true for Hann and Hamming
+     */
+    static bool supports(WindowFunction window) {
+        return window == WindowFunction::Hann || window == WindowFunction::Hamming;
+    }
+
+    /**
+     * @brief Bins a resampler reads, sorted and unique
+     * @param resampler Resampler of the chain
+     * @param num_bins Bins in its input spectrum (fft_size/2 + 1)
+     */
+    static std::vector<uint32_t> displayedBins(const FrequencyResampler& resampler, size_t num_bins);
+
+    /**
+     * @brief Estimate whether sliding beats a full FFT per column
+     * @param fft_size FFT size
+     * @param hop Samples per column
+     * @param displayed_bins Number of displayed bins
+     *
+     * Sliding: ~10 flops per sum and sample, plus comparing and copying
+     * the frame. Real FFT: ~2.5·N·log2(N) flops plus windowing.
+     */
+    static bool isCheaper(size_t fft_size, size_t hop, size_t displayed_bins);
+
+    /**
+     * @brief Advance to the next frame and write its dB spectrum
+     * @param frame Current frame (fft_size samples, oldest first)
+     * @param output dB spectrum (fft_size/2 + 1 bins; undisplayed bins at the floor)
+     */
+    void process(const float* frame, float* output);
+
+    /**
+     * @brief Forget the previous frame (next process() reseeds)
+     */
+    void reset();
+
+    /**
+     * @brief Get samples per column
+     */
+    size_t getHopSize() const { return hop_; }
+
+    /**
+     * @brief Get number of displayed bins
+     */
+    size_t getDisplayedBinCount() const { return displayed_bins_.size(); }
+
+    /**
+     * @brief Get number of reseeds so far
+     */
+    uint64_t getReseedCount() const { return reseeds_; }
+
+private:
+    void reseed(const float* frame);
+    void slide(const float* frame);
+
+    size_t fft_size_;                      ///< Frame length N
+    size_t hop_;                           ///< Samples per column
+    size_t reseed_columns_;                ///< Columns between periodic reseeds
+    double window_a_;                      ///< Window constant term a
+    double window_c_;                      ///< Half the cosine term, b/2
+    double power_scale_;                   ///< 1 / (N · coherent gain)², as FFTProcessor
+
+    std::vector<uint32_t> displayed_bins_; ///< Bins written to the output
+
+    // One entry per sum; sums 3i..3i+2 belong to displayed_bins_[i]
+    std::vector<double> rotate_re_;        ///< Re e^{j2πf/N}
+    std::vector<double> rotate_im_;        ///< Im e^{j2πf/N}
+    std::vector<double> enter_re_;         ///< Re e^{-j2πf} (1 for integer f)
+    std::vector<double> enter_im_;         ///< Im e^{-j2πf}
+    std::vector<double> sum_re_;           ///< Re Y(f)
+    std::vector<double> sum_im_;           ///< Im Y(f)
+
+    std::vector<float> previous_;          ///< Previous frame [fft_size]
+    bool primed_ = false;                  ///< previous_ holds a frame
+    size_t columns_since_seed_ = 0;        ///< Columns since the last reseed
+    uint64_t reseeds_ = 0;                 ///< Reseed count
+};
+
+} // namespace friture
+
+#endif // FRITURE_SLIDING_DFT_HPP
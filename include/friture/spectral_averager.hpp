@@ -0,0 +1,130 @@
+/**
+ * @file spectral_averager.hpp
+ * @brief Time averaging and column decimation of spectra in linear power
+ *
+ * SpectralAverager smooths consecutive spectra (or display columns) over
+ * time and optionally emits only one output per K inputs, so noisy
+ * signals read steadier and long time ranges need fewer columns to
+ * colorize, store and upload.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_SPECTRAL_AVERAGER_HPP
+#define FRITURE_SPECTRAL_AVERAGER_HPP
+
+#include <friture/types.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief Exponential, linear (N-frame) and peak-hold averaging in power
+ *
+ * Every input in dB is converted to linear power (simd::dbToPower) and
+ * folded into per-value state buffers by the in-place SIMD kernels:
+ * - Exponential: average += α × (power - average), α = 1 - e^(-hop / τ)
+ *   with τ = time_seconds.
+ * - Linear: mean of the last `frames` inputs, kept as a running sum in
+ *   double over a ring of the inputs (re-summed whenever the ring wraps,
+ *   so rounding cannot accumulate). While fewer inputs have arrived,
+ *   their mean.
+ * - PeakHold: held = max(power, held × d), d = e^(-hop / τ): a level falls
+ *   4.34 / τ dB per second after its peak.
+ * - None: each output is the mean power of the inputs since the previous
+ *   output (the input itself when decimation is 1).
+ *
+ * process() returns an output every `decimation` inputs, converted back
+ * to dB (simd::linearToDb). The first input seeds the Exponential and
+ * PeakHold state, so averages start at the signal rather than rising
+ * from silence.
+ *
+ * All buffers are allocated by the constructor; process() does not
+ * allocate.
+ *
+ * Thread Safety: Not thread-safe; one instance per analysis thread.
+ *
+ * Example:
+ * @code
+ * SpectralAverager::Options options;
+ * options.mode = AveragingMode::Exponential;
+ * options.time_seconds = 0.5f;
+ * options.decimation = 4;
+ * SpectralAverager averager(rows, 48000.0f, 1024, options);
+ * // Every hop:
+ * if (averager.process(column_db, averaged_db)) {
+ *     display(averaged_db);   // One column per 4 hops
+ * }
+ * @endcode
+ */
+class SpectralAverager {
+public:
+    /**
+     * @brief Averaging mode, time constant, length and decimation
+     */
+    struct Options {
+        AveragingMode mode = AveragingMode::Exponential;
+        float time_seconds = 1.0f;   ///< Exponential time constant, PeakHold decay time
+        size_t frames = 8;           ///< Inputs in the Linear average
+        size_t decimation = 1;       ///< Inputs per output
+    };
+
+    /**
+     * @brief Smallest power converted back to dB (-300 dB)
+     */
+    static constexpr float POWER_FLOOR = 1e-30f;
+
+    /**
+     * @brief Construct averager
+     * @param size Values per spectrum (> 0)
+     * @param sample_rate Sample rate (Hz, must be > 0)
+     * @param hop_size Samples between consecutive inputs (> 0)
+     * @param options Mode, time constant, length and decimation
+     * @throws std::invalid_argument if a size or rate is 0, or the time
+     *         constant, frames or decimation is not positive
+     */
+    SpectralAverager(size_t size, float sample_rate, size_t hop_size, const Options& options);
+    SpectralAverager(size_t size, float sample_rate, size_t hop_size)
+        : SpectralAverager(size, sample_rate, hop_size, Options{}) {}
+
+    /**
+     * @brief Add one spectrum
+     * @param spectrum_db Input levels in dB [size]
+     * @param output_db Destination for the averaged levels [size], written
+     *        only when an output is due (may alias spectrum_db)
+     * @return true if output_db was written (every decimation-th input)
+     */
+    bool process(const float* spectrum_db, float* output_db);
+
+    /**
+     * @brief Forget all state; the next input starts a new average
+     */
+    void reset();
+
+    size_t getSize() const { return size_; }
+    float getSampleRate() const { return sample_rate_; }
+    size_t getHopSize() const { return hop_size_; }
+    const Options& getOptions() const { return options_; }
+
+private:
+    size_t size_;
+    float sample_rate_;
+    size_t hop_size_;
+    Options options_;
+    float weight_;                 ///< Exponential α per input
+    float decay_;                  ///< PeakHold factor per input
+
+    std::vector<float> power_;     ///< Current input in linear power
+    std::vector<float> state_;     ///< Average or held maxima (Linear: output mean)
+    std::vector<float> ring_;      ///< Linear: last `frames` inputs
+    std::vector<double> sum_;      ///< Linear: running sum of ring_
+    size_t ring_slot_;             ///< Linear: slot of the oldest input
+    size_t count_;                 ///< Linear: inputs in the sum; otherwise 1 once seeded
+    size_t pending_;               ///< Inputs since the last output
+};
+
+} // namespace friture
+
+#endif // FRITURE_SPECTRAL_AVERAGER_HPP
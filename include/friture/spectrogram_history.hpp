@@ -0,0 +1,222 @@
+/**
+ * @file spectrogram_history.hpp
+ * @brief Tiered, bounded-memory store of past spectrogram columns
+ *
+ * SpectrogramHistory keeps every column the analyzer produced as quantized
+ * dB levels, independent of the on-screen SpectrogramImage: full resolution
+ * for the recent past plus max-pooled mipmap levels (2×, 4×, 16× by
+ * default) that reach further back in the same memory per level. Any past
+ * time window can be redrawn at any zoom without recomputing FFTs, and
+ * history survives display setting changes.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_SPECTROGRAM_HISTORY_HPP
+#define FRITURE_SPECTROGRAM_HISTORY_HPP
+
+#include <friture/spectrogram_image.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace friture {
+
+class TaskPool;
+
+/**
+ * @brief Bits stored per history sample
+ */
+enum class HistoryPrecision {
+    Level16,  ///< Full SpectrogramImage levels (~0.005 dB steps)
+    Level8    ///< Top byte of the level (~1.2 dB steps), half the memory
+};
+
+/**
+ * @brief SpectrogramHistory configuration
+ */
+struct SpectrogramHistoryConfig {
+    size_t height = 0;                             ///< Rows per column
+    std::vector<size_t> factors = {1, 2, 4, 16};   ///< Columns pooled per stored column, per level
+    size_t memory_bytes = size_t{64} << 20;        ///< Budget shared equally by the levels
+    HistoryPrecision precision = HistoryPrecision::Level16;
+};
+
+/**
+ * @brief Multi-resolution history of spectrogram columns
+ *
+ * Level k stores one column per factors[k] analyzed columns, each row the
+ * maximum of the pooled columns (peaks stay visible when zoomed out). All
+ * levels get the same column capacity, so level k covers factors[k] times
+ * as much time as level 0. Pooling cascades from the previous level when
+ * a pool completes, so appending costs O(height) amortized.
+ *
+ * Time is measured in analyzed columns since construction (or clear());
+ * column t was the t-th column appended.
+ *
+ * Thread Safety: Not thread-safe. Append and render from one thread.
+ *
+ * Example:
+ * @code
+ * SpectrogramHistoryConfig config;
+ * config.height = 512;
+ * SpectrogramHistory history(config);
+ *
+ * // Every analyzed column:
+ * history.append(column_db, 512);
+ *
+ * // Draw the last hour (172k columns at 48 kHz / 1024 hop) into 1280 px:
+ * std::vector<uint16_t> levels(1280 * 512);
+ * uint64_t count = 172000;
+ * history.render(history.getColumnCount() - count, count, 1280, levels.data());
+ * @endcode
+ */
+class SpectrogramHistory {
+public:
+    static constexpr size_t MAX_LEVELS = 8;
+
+    /**
+     * @brief Allocate all levels up front
+     * @param config Height, level factors and memory budget
+     * @throws std::invalid_argument if height is 0, factors are not
+     *         increasing powers of two starting at 1 (at most MAX_LEVELS),
+     *         or the budget cannot hold one column per level
+     */
+    explicit SpectrogramHistory(const SpectrogramHistoryConfig& config);
+
+    /**
+     * @brief Append one analyzed column of dB values
+     * @param column_db dB values, 'height' elements
+     * @param column_height Must equal the configured height
+     */
+    void append(const float* column_db, size_t column_height);
+
+    /**
+     * @brief Append one column already quantized with SpectrogramImage::encodeLevels()
+     */
+    void appendLevels(const uint16_t* levels, size_t column_height);
+
+    /**
+     * @brief Pick the level for a view in O(1)
+     * @param first_column Oldest column of the view
+     * @param columns_per_pixel Analyzed columns per output column
+     * @return Coarsest level that still has at least one stored column per
+     *         pixel, or a coarser one if that level no longer reaches back
+     *         to first_column
+     */
+    size_t selectLevel(uint64_t first_column, double columns_per_pixel) const;
+
+    /**
+     * @brief Resample a time window into output columns
+     * @param first_column Oldest analyzed column of the window
+     * @param column_count Analyzed columns in the window (> 0)
+     * @param width Output columns
+     * @param levels Output, column-major: width × height levels
+     * @return Level the window was drawn from
+     *
+     * Each output column is the maximum over the stored columns it spans.
+     * Parts of the window the chosen level does not hold (the newest columns
+     * still being pooled, or history older than it keeps) are taken from
+     * finer or coarser levels; columns no level holds are level 0 (silence).
+     */
+    size_t render(uint64_t first_column, uint64_t column_count, size_t width,
+                  uint16_t* levels) const;
+
+    /**
+     * @brief Drop all history (time restarts at column 0)
+     */
+    void clear();
+
+    /**
+     * @brief Rescale every stored column to a new row count
+     * @param new_height Rows per column from now on
+     * @param pool Workers to spread the columns over; nullptr runs on the
+     *        calling thread
+     * @throws std::invalid_argument if new_height is 0 or the memory
+     *         budget cannot hold one coarsest-level column per level at
+     *         that height (the history is left unchanged)
+     *
+     * Columns are rescaled with RowResampler, so nothing is analyzed
+     * again. The memory budget is kept: at a larger height each level
+     * holds fewer columns and the oldest ones are dropped. Time (column
+     * numbering) and pools in progress carry over. Levels are replaced one
+     * at a time, so the peak is the budget plus one level.
+     */
+    void resize(size_t new_height, TaskPool* pool = nullptr);
+
+    /**
+     * @brief Get number of columns appended so far
+     */
+    uint64_t getColumnCount() const { return total_columns_; }
+
+    /**
+     * @brief Get oldest analyzed column still held by any level
+     */
+    uint64_t getOldestColumn() const { return getLevelOldest(levels_.size() - 1); }
+
+    /**
+     * @brief Get oldest analyzed column still held by a level
+     */
+    uint64_t getLevelOldest(size_t level) const;
+
+    size_t getHeight() const { return height_; }
+    size_t getLevelCount() const { return levels_.size(); }
+    size_t getLevelFactor(size_t level) const { return levels_[level].factor; }
+
+    /**
+     * @brief Stored columns per level
+     */
+    size_t getLevelCapacity() const { return capacity_; }
+
+    /**
+     * @brief Bytes allocated for all levels and pooling buffers
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    struct Level {
+        size_t factor = 1;              ///< Analyzed columns per stored column
+        uint64_t count = 0;             ///< Stored columns written (ring position)
+        std::vector<uint16_t> data16;   ///< Level16 ring, column-major
+        std::vector<uint8_t> data8;     ///< Level8 ring, column-major
+        std::vector<uint16_t> pool;     ///< Running maximum of the pool being built
+        size_t pooled = 0;              ///< Columns in pool
+        uint64_t first = 0;             ///< Oldest stored column kept by the last resize()
+    };
+
+    /**
+     * @brief Oldest stored column (in level units) a level still holds
+     */
+    uint64_t storedOldest(const Level& level) const;
+
+    /**
+     * @brief Write a column into level k and feed the next level's pool
+     */
+    void store(size_t k, const uint16_t* levels);
+
+    /**
+     * @brief Fold stored columns [first, last) of level k into out (max)
+     * @return false if the level does not hold that whole range
+     */
+    bool poolRange(size_t k, uint64_t first, uint64_t last, uint16_t* out) const;
+
+    /**
+     * @brief Fold analyzed columns [first, last) into out from the best level
+     */
+    void sampleRange(size_t preferred, uint64_t first, uint64_t last, uint16_t* out) const;
+
+    size_t height_;
+    size_t capacity_;
+    size_t memory_bytes_;                      ///< Budget, kept across resize()
+    HistoryPrecision precision_;
+    std::vector<Level> levels_;
+    std::array<uint8_t, 65> level_for_log2_;   ///< floor(log2(columns per pixel)) → level
+    uint64_t total_columns_;
+    std::vector<uint16_t> encoded_;            ///< append() scratch
+};
+
+} // namespace friture
+
+#endif // FRITURE_SPECTROGRAM_HISTORY_HPP
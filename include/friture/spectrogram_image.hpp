@@ -13,6 +13,7 @@
 #ifndef FRITURE_SPECTROGRAM_IMAGE_HPP
 #define FRITURE_SPECTROGRAM_IMAGE_HPP
 
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <cstring>
@@ -20,6 +21,54 @@
 
 namespace friture {
 
+class TaskPool;
+
+/**
+ * @brief Pixel layout of the SpectrogramImage buffer
+ */
+enum class ImageLayout {
+    ColumnMajor,  ///< pixels_[column * height + row] - one memcpy per column
+    RowMajor      ///< pixels_[row * 2*width + column] - matches SDL texture rows
+};
+
+/**
+ * @brief What each pixel of a SpectrogramImage holds
+ */
+enum class ImagePlane {
+    Colors,          ///< Final RGBA colors (CPU colormapping)
+    Levels,          ///< Quantized dB levels, colormapped at draw time (GPU colormapping)
+    ColorsAndLevels  ///< Colors plus the levels they came from, so recolor() can redo them
+};
+
+/**
+ * @brief dB range representable by a quantized level
+ *
+ * Level 0 is LEVEL_MIN_DB and level 65535 is LEVEL_MAX_DB, a step of
+ * ~0.005 dB, so levels can be recolored for any display range without
+ * visible banding.
+ */
+constexpr float LEVEL_MIN_DB = -200.0f;
+constexpr float LEVEL_MAX_DB = 100.0f;
+
+/**
+ * @brief Convert a quantized level back to dB
+ */
+inline float levelToDb(uint16_t level) {
+    return LEVEL_MIN_DB + level * ((LEVEL_MAX_DB - LEVEL_MIN_DB) / 65535.0f);
+}
+
+/**
+ * @brief Run of consecutive columns that map to consecutive texture columns
+ *
+ * Used to upload only the columns that changed since the last frame into a
+ * width-wide texture that is itself treated as a ring.
+ */
+struct ColumnSpan {
+    size_t image_column;    ///< First column in the image buffer [0, 2*width)
+    size_t texture_column;  ///< First column in the texture ring [0, width)
+    size_t count;           ///< Number of columns in the run
+};
+
 /**
  * @brief Ring buffer image storage for scrolling spectrogram
  *
@@ -31,15 +80,29 @@ namespace friture {
  * - Total pixels: 2 × width × height
  * - Storage: Contiguous uint32_t array (RGBA format: 0xAABBGGRR)
  * - Columns are vertical (height pixels each)
- * - Wraps around at width boundary
+ * - Every column is written twice, at i and i ± width, so the newest
+ *   'width' columns are always contiguous starting at getReadOffset()
+ * - ColumnMajor (default) or RowMajor; RowMajor rows are 2 × width pixels
+ *   apart, so any run of columns can be handed to SDL_UpdateTexture as-is
+ * - ImagePlane::Levels stores uint16_t dB levels instead of colors, in the
+ *   same layout, for renderers that apply the colormap on the GPU
+ * - ImagePlane::ColorsAndLevels stores both (6 bytes per pixel), so a new
+ *   dB range or palette recolors everything displayed with recolor()
+ *
+ * Dirty tracking: the image remembers which columns were added since the
+ * last clearDirty(). getDirtySpans() maps them onto a width-wide texture
+ * used as a ring, so a renderer uploads only new columns and draws the
+ * texture in two pieces split at getTextureSeam(). When the whole window
+ * is dirty it is reported as the single contiguous view at getReadOffset().
  *
  * Thread Safety: Not thread-safe. Should be accessed from single thread
  * or protected with external synchronization.
  *
  * Performance:
- * - Column write: O(height) - simple memcpy
+ * - Column write: O(height) - two memcpys (ColumnMajor) or strided stores
+ * - Scrolling: pointer offset, no copy or reshuffle
  * - Memory: 8 × width × height bytes (double buffered)
- * - Resize: Expensive, allocates new buffer
+ * - Resize: Expensive, allocates new buffer; resample() keeps the content
  *
  * Example:
  * @code
@@ -51,9 +114,8 @@ namespace friture {
  * image.addColumn(column.data(), 1080);
  *
  * // For rendering:
- * const uint32_t* pixels = image.getPixelData();
- * size_t offset = image.getReadOffset();
- * // ... upload to GPU texture ...
+ * const uint32_t* visible = image.getVisibleData();
+ * // ... upload 'width' columns starting at visible to GPU texture ...
  * @endcode
  */
 class SpectrogramImage {
@@ -67,8 +129,13 @@ public:
      * All pixels are initialized to black (0x00000000).
      *
      * Example: 1920×1080 display uses ~16.6 MB
+     *
+     * @param layout Pixel layout (RowMajor for direct texture upload)
+     * @param plane Stored pixel type (Levels halves memory and upload size)
      */
-    SpectrogramImage(size_t width, size_t height);
+    SpectrogramImage(size_t width, size_t height,
+                     ImageLayout layout = ImageLayout::ColumnMajor,
+                     ImagePlane plane = ImagePlane::Colors);
 
     /**
      * @brief Add new column of pixels to the spectrogram
@@ -76,29 +143,83 @@ public:
      * @param column_height Number of pixels in column (must equal height)
      *
      * This method copies the column data into the ring buffer at the current
-     * write position and advances the write pointer. When reaching the end,
-     * it wraps around to the beginning.
+     * write position and its mirror 'width' columns away, then advances the
+     * write pointer. When reaching the end, it wraps around to the beginning.
      *
      * Performance: ~1-2 μs for 1080 pixels (simple memcpy)
      *
      * Thread Safety: Not thread-safe with concurrent addColumn() or getPixelData() calls.
      *
      * @throws std::invalid_argument if column_height doesn't match height
+     *         or the image does not store colors only
      */
     void addColumn(const uint32_t* column_data, size_t column_height);
 
+    /**
+     * @brief Add new column of colors and the levels they were computed from
+     * @param column_data RGBA colors (must have 'height' elements)
+     * @param levels Levels from encodeLevels() (must have 'height' elements)
+     * @param column_height Number of pixels in column (must equal height)
+     *
+     * Same ring and dirty-tracking behaviour as addColumn().
+     *
+     * @throws std::invalid_argument if column_height doesn't match height
+     *         or the image is not ImagePlane::ColorsAndLevels
+     */
+    void addColumn(const uint32_t* column_data, const uint16_t* levels, size_t column_height);
+
+    /**
+     * @brief Add new column of quantized dB levels
+     * @param levels Levels from encodeLevels() (must have 'height' elements)
+     * @param column_height Number of pixels in column (must equal height)
+     *
+     * Same ring and dirty-tracking behaviour as addColumn().
+     *
+     * @throws std::invalid_argument if column_height doesn't match height
+     *         or the image does not store levels only
+     */
+    void addColumnLevels(const uint16_t* levels, size_t column_height);
+
+    /**
+     * @brief Regenerate every color from the stored levels
+     * @param palette 256 RGBA colors (ColorTransform::getPalette())
+     * @param min_db Level shown as palette[0]
+     * @param max_db Level shown as palette[255] (must be > min_db)
+     * @throws std::invalid_argument if the image is not ImagePlane::ColorsAndLevels
+     *         or min_db >= max_db
+     *
+     * One pass over both halves of the ring: level → palette index is a
+     * single multiply-add and clamp (vectorized), followed by the palette
+     * lookup. Same mapping as ColorTransform::transformColumnDb() applied
+     * to levelToDb(level). The whole window is reported dirty afterwards.
+     *
+     * Performance: ~10 ms for 2 × 1920 × 1080 pixels (-O2)
+     */
+    void recolor(const std::array<uint32_t, 256>& palette, float min_db, float max_db);
+
+    /**
+     * @brief Quantize dB values to levels
+     * @param db Input dB values
+     * @param count Number of values
+     * @param levels Output levels (may not alias db)
+     *
+     * Values outside [LEVEL_MIN_DB, LEVEL_MAX_DB] are clamped, NaN maps to 0.
+     * Vectorizes to a multiply-add, clamp and convert per element.
+     */
+    static void encodeLevels(const float* db, size_t count, uint16_t* levels);
+
     /**
      * @brief Get pointer to pixel data for rendering
      * @return Pointer to RGBA pixel array (2 × width × height elements)
      *
      * The returned pointer is valid until the next resize() call.
-     * Pixels are stored in row-major order with double buffering.
+     * Pixel (column, row) is at getPixelIndex(column, row).
      *
      * To render correctly with scrolling:
      * @code
      * const uint32_t* pixels = image.getPixelData();
      * size_t offset = image.getReadOffset();
-     * // Render from column 'offset' to 'offset + width' (with wrapping)
+     * // Render from column 'offset' to 'offset + width' (never wraps)
      * @endcode
      *
      * Thread Safety: Not thread-safe with concurrent addColumn() calls.
@@ -113,16 +234,39 @@ public:
      */
     uint32_t* getPixelDataMutable() { return pixels_.data(); }
 
+    /**
+     * @brief Get pointer to level data (ImagePlane::Levels or ColorsAndLevels)
+     * @return Pointer to level array (2 × width × height elements), laid out
+     *         like getPixelData() and indexed with getPixelIndex()
+     */
+    const uint16_t* getLevelData() const { return levels_.data(); }
+
+    /**
+     * @brief Get stored pixel type
+     */
+    ImagePlane getPlane() const { return plane_; }
+
     /**
      * @brief Get current read offset for scrolling rendering
      * @return Column index where rendering should start [0, width)
      *
-     * The read offset points to the oldest column in the ring buffer.
-     * For correct scrolling, render columns from [offset, offset+width)
-     * with wrapping at the buffer edge.
+     * The read offset points to the oldest visible column. Because every
+     * column is mirrored, [offset, offset+width) never crosses the buffer
+     * edge, so scrolling is just a change of offset.
      */
     size_t getReadOffset() const { return read_offset_; }
 
+    /**
+     * @brief Get pointer to the oldest visible pixel
+     * @return getPixelData() + getPixelIndex(getReadOffset(), 0)
+     *
+     * RowMajor: 'width' columns × 'height' rows, getRowPitch() apart.
+     * ColumnMajor: 'width' consecutive columns of 'height' pixels.
+     */
+    const uint32_t* getVisibleData() const {
+        return pixels_.data() + getPixelIndex(read_offset_, 0);
+    }
+
     /**
      * @brief Get current write position
      * @return Column index where next column will be written [0, width)
@@ -143,11 +287,74 @@ public:
      */
     size_t getHeight() const { return height_; }
 
+    /**
+     * @brief Get pixel layout
+     */
+    ImageLayout getLayout() const { return layout_; }
+
+    /**
+     * @brief Get distance in pixels between consecutive rows (RowMajor only)
+     * @return 2 × width for RowMajor, 1 for ColumnMajor
+     */
+    size_t getRowPitch() const {
+        return layout_ == ImageLayout::RowMajor ? 2 * width_ : 1;
+    }
+
+    /**
+     * @brief Get index into getPixelData() of a pixel
+     * @param column Buffer column [0, 2*width)
+     * @param row Row [0, height)
+     */
+    size_t getPixelIndex(size_t column, size_t row) const {
+        return layout_ == ImageLayout::RowMajor ? row * 2 * width_ + column
+                                                : column * height_ + row;
+    }
+
+    /**
+     * @brief Get total number of columns added since construction or clear()
+     */
+    uint64_t getColumnsWritten() const { return columns_written_; }
+
+    /**
+     * @brief Get columns changed since the last clearDirty() as texture runs
+     * @param spans Output array (at most 2 runs are ever needed)
+     * @return Number of runs written (0 if nothing changed)
+     *
+     * Only the most recent 'width' columns are reported; older ones have
+     * already been overwritten in the texture ring. After construction,
+     * clear() or resize(), or once 'width' or more columns are pending, the
+     * whole window is reported as one span starting at getReadOffset().
+     */
+    size_t getDirtySpans(ColumnSpan spans[2]) const;
+
+    /**
+     * @brief Check whether anything changed since the last clearDirty()
+     * @return true if getDirtySpans() would report at least one span
+     *
+     * Lets the render loop skip frames while no column arrives.
+     */
+    bool isDirty() const { return all_dirty_ || clean_columns_ != columns_written_; }
+
+    /**
+     * @brief Mark all columns as uploaded
+     */
+    void clearDirty();
+
+    /**
+     * @brief Get texture ring column holding the oldest visible column
+     * @return Column to draw at the left edge [0, width)
+     *
+     * Draw texture columns [seam, width) first, then [0, seam).
+     */
+    size_t getTextureSeam() const {
+        return (read_offset_ + width_ - texture_origin_) % width_;
+    }
+
     /**
      * @brief Get total pixel count in buffer
      * @return Total pixels (2 × width × height)
      */
-    size_t getTotalPixels() const { return pixels_.size(); }
+    size_t getTotalPixels() const { return 2 * width_ * height_; }
 
     /**
      * @brief Clear entire image to black
@@ -173,12 +380,33 @@ public:
      */
     void resize(size_t new_width, size_t new_height);
 
+    /**
+     * @brief Change the dimensions, keeping the newest columns
+     * @param new_width New display width
+     * @param new_height New display height
+     * @param pool Workers to spread the rows (or columns) over; nullptr
+     *        runs on the calling thread
+     * @throws std::invalid_argument if width or height is 0
+     *
+     * The newest min(visible, new_width) columns are kept at one column
+     * per pixel (the time axis is unchanged) and rescaled to new_height
+     * with RowResampler: levels are interpolated (or max-pooled when
+     * shrinking), colors take the nearest source row. For
+     * ImagePlane::ColorsAndLevels call recolor() afterwards to derive the
+     * colors from the rescaled levels. Kept columns start at the left,
+     * as after that many addColumn() calls; the whole window is dirty.
+     *
+     * Performance: RowMajor rescales a whole row per step (vectorized),
+     * ~2 ms for 1920 × 1080 levels on one core
+     */
+    void resample(size_t new_width, size_t new_height, TaskPool* pool = nullptr);
+
     /**
      * @brief Get memory usage in bytes
-     * @return Memory used by pixel buffer
+     * @return Memory used by pixel or level buffer
      */
     size_t getMemoryUsage() const {
-        return pixels_.size() * sizeof(uint32_t);
+        return pixels_.size() * sizeof(uint32_t) + levels_.size() * sizeof(uint16_t);
     }
 
     /**
@@ -191,9 +419,24 @@ public:
      *
      * Note: This is a convenience method for debugging. For production,
      * use a proper image library (SDL_Surface, stb_image_write, etc.)
+     * Images storing only levels have no colors to save and return false.
      */
     bool saveToBMP(const char* filename) const;
 
+    /**
+     * @brief Save a column-major color matrix to a BMP file
+     * @param filename Output filename
+     * @param columns Pixels, column c row r at columns[c × height + r]
+     * @param width Columns in the matrix
+     * @param height Rows per column
+     * @return true if successful, false on error or an empty matrix
+     *
+     * Writes the same file saveToBMP() would for an image holding these
+     * columns, without building one (and its mirrored copy) first.
+     */
+    static bool saveColumnsToBMP(const char* filename, const uint32_t* columns,
+                                 size_t width, size_t height);
+
 private:
     /**
      * @brief Update read offset after writing a column
@@ -203,24 +446,58 @@ private:
      */
     void updateReadOffset();
 
+    /**
+     * @brief Check whether the whole window must be uploaded
+     *
+     * True after construction, clear() or resize(), or when a full
+     * window's worth of columns arrived since the last clearDirty().
+     */
+    bool needsFullUpload() const;
+
+    /**
+     * @brief Write one column and its mirror into a plane at write_offset_
+     */
+    template <typename T>
+    void writeColumn(std::vector<T>& plane, const T* column);
+
+    /**
+     * @brief Move to the next column after its planes were written
+     */
+    void advanceColumn();
+
+    /**
+     * @brief Size the storage plane for the current dimensions and clear it
+     */
+    void allocatePlane();
+
+    ImageLayout layout_;        ///< Pixel layout
+    ImagePlane plane_;          ///< Stored pixel type
     size_t width_;              ///< Display width (columns visible on screen)
     size_t height_;             ///< Display height (frequency bins / rows)
     size_t write_offset_;       ///< Current column write position [0, 2*width)
-    size_t read_offset_;        ///< Current column read position [0, 2*width)
-    size_t columns_written_;    ///< Total number of columns written (for tracking wrap)
+    size_t read_offset_;        ///< Oldest visible column [0, width)
+    uint64_t columns_written_;  ///< Total number of columns written (for tracking wrap)
+    uint64_t clean_columns_;    ///< columns_written_ at the last clearDirty()
+    bool all_dirty_;            ///< Whole window needs uploading (after clear/resize)
+    size_t texture_origin_;     ///< Buffer column (mod width) held by texture column 0
 
     /**
      * @brief Pixel storage: 2 × width × height RGBA values
      *
-     * Layout: Row-major with double buffering
+     * Layout: see ImageLayout, with double buffering
      * - Each column has 'height' pixels
      * - Total columns: 2 × width
      * - Pixel format: 0xAABBGGRR (little-endian RGBA)
      *
-     * Access pattern: pixels_[column * height + row]
+     * Access pattern: pixels_[getPixelIndex(column, row)]
      */
     std::vector<uint32_t> pixels_;
 
+    /**
+     * @brief Level storage (Levels or ColorsAndLevels), same layout as pixels_
+     */
+    std::vector<uint16_t> levels_;
+
     // Prevent copying (would be expensive)
     SpectrogramImage(const SpectrogramImage&) = delete;
     SpectrogramImage& operator=(const SpectrogramImage&) = delete;
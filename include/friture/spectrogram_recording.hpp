@@ -0,0 +1,431 @@
+/**
+ * @file spectrogram_recording.hpp
+ * @brief Append-only on-disk spectrogram recordings (.frspec)
+ *
+ * Persists the analyzed spectrogram itself (quantized dB columns, as shown
+ * on screen) rather than a screenshot. SpectrogramRecorder appends columns
+ * from a background writer thread; SpectrogramRecordingReader maps a file
+ * and returns any time range by decoding only the chunks it overlaps.
+ *
+ * File layout (all integers little-endian):
+ * @code
+ * Header   64 bytes   "FRSPCREC", version, fft_size, hop_size, sample_rate,
+ *                     scale, min/max frequency, height, level_bits,
+ *                     columns_per_chunk, start time (Unix ms)
+ * Chunk    24 bytes   "CHNK", column_count, first_column, payload_bytes
+ *          height×u16 Summary: per-row maximum over the chunk's columns
+ *          payload    Column deltas, zigzag + zero-run varints
+ * ...
+ * Index    16 bytes   "INDX", entry_count
+ *          24 bytes   Per chunk: first_column, file offset, column_count
+ * Trailer  16 bytes   Index offset, "FEND", version
+ * @endcode
+ *
+ * The index and trailer are written when recording stops. A file without
+ * them (still being recorded, or cut short by a crash) is opened by
+ * scanning chunk headers, so everything up to the last complete chunk
+ * stays readable.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_SPECTROGRAM_RECORDING_HPP
+#define FRITURE_SPECTROGRAM_RECORDING_HPP
+
+#include <friture/spectrogram_image.hpp>
+#include <friture/spsc_queue.hpp>
+#include <friture/types.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief Format of the columns in a recording
+ */
+struct RecordingHeader {
+    uint32_t fft_size = 0;
+    uint32_t hop_size = 0;                          ///< Samples between columns
+    float sample_rate = 0.0f;
+    FrequencyScale scale = FrequencyScale::Linear;  ///< Row layout of each column
+    float min_freq = 0.0f;                          ///< Frequency of the bottom row (Hz)
+    float max_freq = 0.0f;                          ///< Frequency of the top row (Hz)
+    uint32_t height = 0;                            ///< Rows per column
+    uint32_t level_bits = 12;                       ///< Stored bits per level (12: ~0.07 dB steps)
+    uint32_t columns_per_chunk = 256;               ///< Columns per compressed chunk
+    int64_t start_time_ms = 0;                      ///< Unix time of column 0 (ms)
+
+    /**
+     * @brief Get seconds between consecutive columns
+     */
+    double getSecondsPerColumn() const {
+        return sample_rate > 0.0f ? hop_size / static_cast<double>(sample_rate) : 0.0;
+    }
+
+    /**
+     * @brief Check whether two headers describe the same column format
+     */
+    bool sameFormat(const RecordingHeader& other) const;
+};
+
+/**
+ * @brief Writes a .frspec recording on a background thread
+ *
+ * push() copies a column into a lock-free queue and returns; the writer
+ * thread delta-encodes columns into chunks and appends each finished
+ * chunk through a buffered FILE. A column pushed while the queue is full
+ * is dropped and counted; later columns keep their time position, so a
+ * drop shows as a silent gap rather than shifting the recording.
+ *
+ * Thread Safety: Call all methods from one thread (the producer); encoding
+ * and file I/O happen on the internal writer thread.
+ *
+ * Example:
+ * @code
+ * SpectrogramRecorder recorder;
+ * RecordingHeader header;
+ * header.fft_size = 4096;
+ * header.hop_size = 1024;
+ * header.sample_rate = 48000.0f;
+ * header.height = 432;
+ * if (!recorder.start("capture.frspec", header)) {
+ *     std::cerr << recorder.getError() << std::endl;
+ * }
+ *
+ * // Every displayed column:
+ * recorder.push(levels, 432);
+ *
+ * recorder.stop();   // Writes the time index
+ * @endcode
+ */
+class SpectrogramRecorder {
+public:
+    static constexpr size_t DEFAULT_QUEUE_COLUMNS = 4096;  ///< ~85 s at 48 kHz / 1024 hop
+    static constexpr size_t FILE_BUFFER_BYTES = 1 << 20;   ///< stdio buffer of the writer
+
+    /**
+     * @brief Construct an idle recorder
+     * @param queue_columns Columns the writer may fall behind by before drops
+     * @throws std::invalid_argument if queue_columns is 0
+     */
+    explicit SpectrogramRecorder(size_t queue_columns = DEFAULT_QUEUE_COLUMNS);
+
+    /**
+     * @brief Destructor - stops (and finalizes) a running recording
+     */
+    ~SpectrogramRecorder();
+
+    /**
+     * @brief Create a file, write its header and start the writer thread
+     * @param path Output file (truncated)
+     * @param header Column format; start_time_ms of 0 is set to now
+     * @return true on success, false on error (see getError())
+     *
+     * A recording already running is stopped first.
+     */
+    bool start(const std::string& path, const RecordingHeader& header);
+
+    /**
+     * @brief Queue one column of SpectrogramImage levels
+     * @param levels Quantized levels, 'height' elements
+     * @param height Must equal the header height
+     * @return true if queued, false if dropped (queue full, wrong height or not recording)
+     */
+    bool push(const uint16_t* levels, size_t height);
+
+    /**
+     * @brief Write the pending chunk and the time index, then close the file
+     * @return true if every write succeeded (false: see getError())
+     */
+    bool stop();
+
+    /**
+     * @brief Check whether a recording is running
+     */
+    bool isRecording() const { return writer_.joinable(); }
+
+    /**
+     * @brief Get columns pushed since start(), including dropped ones
+     */
+    uint64_t getColumnCount() const { return pushed_columns_; }
+
+    /**
+     * @brief Get columns dropped because the writer fell behind
+     */
+    uint64_t getDroppedColumns() const { return dropped_columns_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get bytes handed to the file so far
+     */
+    uint64_t getBytesWritten() const { return bytes_written_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get header of the current (or last) recording
+     */
+    const RecordingHeader& getHeader() const { return header_; }
+
+    /**
+     * @brief Get path of the current (or last) recording
+     */
+    const std::string& getPath() const { return path_; }
+
+    /**
+     * @brief Get last error message
+     */
+    const std::string& getError() const { return error_; }
+
+private:
+    /**
+     * @brief One queued column and its time position
+     */
+    struct QueuedColumn {
+        uint64_t column = 0;
+        std::vector<uint16_t> levels;
+    };
+
+    /**
+     * @brief One chunk index entry
+     */
+    struct IndexEntry {
+        uint64_t first_column;
+        uint64_t offset;
+        uint32_t column_count;
+    };
+
+    /**
+     * @brief Writer thread body
+     */
+    void writerLoop();
+
+    /**
+     * @brief Encode a column into the current chunk (writer thread)
+     */
+    void addColumn(const QueuedColumn& column);
+
+    /**
+     * @brief Append the current chunk to the file (writer thread)
+     */
+    void flushChunk();
+
+    /**
+     * @brief Append the index and trailer (writer thread)
+     */
+    void writeIndex();
+
+    /**
+     * @brief Write bytes, recording the first failure (writer thread)
+     */
+    void writeBytes(const std::vector<uint8_t>& bytes);
+
+    size_t queue_columns_;
+    RecordingHeader header_;
+    std::string path_;
+    std::string error_;
+    FILE* file_;
+    std::unique_ptr<SpscQueue<QueuedColumn>> queue_;
+    std::thread writer_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<bool> stop_requested_;
+    uint64_t pushed_columns_;                 ///< Producer side
+    std::atomic<uint64_t> dropped_columns_;
+    std::atomic<uint64_t> bytes_written_;
+
+    // Writer thread state
+    std::atomic<bool> write_failed_;
+    std::vector<uint8_t> buffer_;             ///< Bytes of the chunk being written
+    std::vector<uint8_t> payload_;            ///< Encoded deltas of the current chunk
+    std::vector<uint16_t> previous_;          ///< Last stored column (delta reference)
+    std::vector<uint16_t> summary_;           ///< Per-row maximum of the current chunk
+    uint64_t chunk_first_;
+    uint32_t chunk_columns_;
+    uint64_t zero_run_;                       ///< Unchanged values not yet encoded
+    uint64_t file_offset_;                    ///< Bytes written, header included
+    std::vector<IndexEntry> index_;
+
+    // Prevent copying (owns the file and thread)
+    SpectrogramRecorder(const SpectrogramRecorder&) = delete;
+    SpectrogramRecorder& operator=(const SpectrogramRecorder&) = delete;
+};
+
+/**
+ * @brief Random access to a .frspec recording
+ *
+ * The file is memory-mapped; open() reads the header and time index (or
+ * scans chunk headers if the index is missing). Reads find the chunks
+ * covering a time range by binary search and decode only those, so the
+ * cost depends on the range, not on the length of the recording.
+ * readOverview() draws ranges much wider than the output from the
+ * per-chunk summaries without decoding at all.
+ *
+ * Levels are returned in SpectrogramImage::encodeLevels() units (decode
+ * with levelToDb()); columns not in the file are 0 (silence).
+ *
+ * Thread Safety: Not thread-safe (reads share a decode buffer).
+ *
+ * Example:
+ * @code
+ * SpectrogramRecordingReader reader;
+ * if (reader.open("capture.frspec")) {
+ *     const RecordingHeader& header = reader.getHeader();
+ *     // One hour starting at 10 minutes, 1280 pixels wide
+ *     uint64_t first = reader.columnAtTime(600.0);
+ *     uint64_t count = reader.columnAtTime(3600.0);
+ *     std::vector<uint16_t> levels(1280 * header.height);
+ *     reader.readOverview(first, count, 1280, levels.data());
+ * }
+ * @endcode
+ */
+class SpectrogramRecordingReader {
+public:
+    SpectrogramRecordingReader();
+    ~SpectrogramRecordingReader();
+
+    /**
+     * @brief Map a recording and load its index
+     * @param filename Path to a .frspec file
+     * @return true on success, false on error (see getError())
+     */
+    bool open(const char* filename);
+
+    /**
+     * @brief Unmap the file
+     */
+    void close();
+
+    /**
+     * @brief Check whether a file is open
+     */
+    bool isOpen() const { return data_ != nullptr; }
+
+    /**
+     * @brief Get the column format
+     */
+    const RecordingHeader& getHeader() const { return header_; }
+
+    /**
+     * @brief Get end of the recording (one past its newest column)
+     */
+    uint64_t getColumnCount() const;
+
+    /**
+     * @brief Get number of complete chunks
+     */
+    size_t getChunkCount() const { return chunks_.size(); }
+
+    /**
+     * @brief Check whether the index was read from the file (false: recovered by scanning)
+     */
+    bool hasIndex() const { return has_index_; }
+
+    /**
+     * @brief Convert seconds since the start of the recording to a column
+     */
+    uint64_t columnAtTime(double seconds) const;
+
+    /**
+     * @brief Decode consecutive columns
+     * @param first_column First column to read
+     * @param count Columns to read
+     * @param levels Output, column-major: count × height levels
+     * @return Columns that were present in the file
+     */
+    size_t readColumns(uint64_t first_column, size_t count, uint16_t* levels);
+
+    /**
+     * @brief Resample a time range into output columns (maximum per column)
+     * @param first_column First column of the range
+     * @param column_count Columns in the range (> 0)
+     * @param width Output columns
+     * @param levels Output, column-major: width × height levels
+     *
+     * Output columns spanning a whole chunk or more use the chunk summaries
+     * (a chunk contributes to every output column it overlaps); narrower
+     * ones decode the chunks they cover.
+     */
+    void readOverview(uint64_t first_column, uint64_t column_count, size_t width,
+                      uint16_t* levels);
+
+    /**
+     * @brief Get last error message
+     */
+    const std::string& getError() const { return error_; }
+
+private:
+    /**
+     * @brief Location of one chunk in the mapping
+     */
+    struct Chunk {
+        uint64_t first_column;
+        uint32_t column_count;
+        const uint8_t* summary;    ///< height little-endian u16
+        const uint8_t* payload;
+        size_t payload_bytes;
+    };
+
+    /**
+     * @brief Parse the header and locate all chunks
+     */
+    bool parse();
+
+    /**
+     * @brief Load chunk locations from the index
+     * @return false if the file has no valid index
+     */
+    bool readIndex();
+
+    /**
+     * @brief Load chunk locations by walking the chunk headers
+     */
+    void scanChunks();
+
+    /**
+     * @brief Read a chunk header at an offset
+     * @return false if there is no complete chunk there
+     */
+    bool chunkAt(uint64_t offset, Chunk& chunk) const;
+
+    /**
+     * @brief Decode all columns of a chunk into decoded_
+     * @return false if the payload is corrupt
+     */
+    bool decodeChunk(size_t index);
+
+    /**
+     * @brief Index of the first chunk ending after a column
+     */
+    size_t firstChunkAfter(uint64_t column) const;
+
+    void setError(const std::string& message);
+
+    const uint8_t* data_;           ///< Start of the mapped file
+    size_t size_;                   ///< Mapped size in bytes
+#ifdef _WIN32
+    void* file_handle_;             ///< Windows file handle
+    void* mapping_handle_;          ///< Windows file mapping handle
+#endif
+
+    RecordingHeader header_;
+    std::vector<Chunk> chunks_;     ///< Sorted by first_column
+    bool has_index_;
+    std::vector<uint16_t> decoded_; ///< Columns of decoded_chunk_, column-major
+    size_t decoded_chunk_;          ///< Chunk held in decoded_ (SIZE_MAX: none)
+    std::string error_;
+
+    // Prevent copying (owns the mapping)
+    SpectrogramRecordingReader(const SpectrogramRecordingReader&) = delete;
+    SpectrogramRecordingReader& operator=(const SpectrogramRecordingReader&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_SPECTROGRAM_RECORDING_HPP
@@ -0,0 +1,190 @@
+/**
+ * @file spectrum_views.hpp
+ * @brief Spectrum curve and fractional-octave bands from displayed columns
+ *
+ * SpectrumViews derives the instantaneous spectrum (with peak hold) and
+ * 1/N-octave band levels from the columns the spectrogram already shows,
+ * so extra views cost no FFT: whatever produced a column (plain FFT,
+ * zoom, multi-resolution, multichannel, or a network stream) feeds them.
+ * Columns are only max-pooled as they arrive; dB conversion, band sums
+ * and peak decay run once per frame in update().
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_SPECTRUM_VIEWS_HPP
+#define FRITURE_SPECTRUM_VIEWS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief One fractional-octave band
+ */
+struct OctaveBand {
+    float center_hz;    ///< Base-2 nominal center (1000 Hz * 2^(k/N))
+    float low_hz;       ///< Lower edge
+    float high_hz;      ///< Upper edge
+};
+
+/**
+ * @brief Per-frame spectrum and band levels of the displayed columns
+ *
+ * Band levels add the power of every row overlapping a band, weighted by
+ * the overlap in FFT bins, so they read as band power (like an analog
+ * 1/3-octave analyzer) rather than as the per-bin density of the
+ * spectrogram rows. Exact for MeanPower rows; an approximation for
+ * Interpolate and PeakHold rows.
+ *
+ * Thread Safety: Not thread-safe (render thread).
+ *
+ * Example:
+ * @code
+ * SpectrumViews views;
+ * views.configure(row_frequencies, sample_rate / fft_size);
+ * // For every drained column:
+ * views.addColumn(levels, height);
+ * // Once per frame:
+ * views.update(frame_seconds);
+ * draw(views.getSpectrum(), views.getSpectrumPeaks());
+ * @endcode
+ */
+class SpectrumViews {
+public:
+    /**
+     * @brief Peak hold and band parameters
+     */
+    struct Options {
+        float hold_seconds = 1.0f;          ///< Peaks stay this long before decaying
+        float decay_db_per_second = 20.0f;  ///< Peak fall rate after the hold
+        int bands_per_octave = 3;           ///< N of the 1/N-octave bands (1, 3, 6, 12, 24)
+    };
+
+    /**
+     * @brief Construct unconfigured views
+     * @throws std::invalid_argument if an option is out of range
+     */
+    explicit SpectrumViews(const Options& options);
+    SpectrumViews() : SpectrumViews(Options{}) {}
+
+    /**
+     * @brief Set the row layout of the columns
+     * @param row_frequencies Center frequency of each row (Hz, ascending)
+     * @param bin_hz Width of one FFT bin (Hz) the rows were computed from
+     * @throws std::invalid_argument if rows are not ascending or bin_hz <= 0
+     *
+     * Bands whose center lies inside the row range are kept. Clears the
+     * spectrum and peaks.
+     */
+    void configure(const std::vector<float>& row_frequencies, float bin_hz);
+
+    /**
+     * @brief Check whether configure() was called
+     */
+    bool isConfigured() const { return !row_frequencies_.empty(); }
+
+    /**
+     * @brief Add one displayed column
+     * @param levels SpectrogramImage levels
+     * @param height Must equal the configured row count (ignored otherwise)
+     */
+    void addColumn(const uint16_t* levels, size_t height);
+
+    /**
+     * @brief Refresh levels from the latest column and decay peaks
+     * @param seconds Time since the previous update()
+     *
+     * Peaks include every column added since the previous update. Without
+     * new columns the spectrum keeps its values and peaks keep decaying.
+     */
+    void update(float seconds);
+
+    /**
+     * @brief Clear spectrum, bands and peaks (to LEVEL_MIN_DB)
+     */
+    void reset();
+
+    /**
+     * @brief Get rows per spectrum
+     */
+    size_t getHeight() const { return row_frequencies_.size(); }
+
+    /**
+     * @brief Get center frequency of each row (Hz)
+     */
+    const std::vector<float>& getRowFrequencies() const { return row_frequencies_; }
+
+    /**
+     * @brief Get the latest column in dB (one value per row)
+     */
+    const std::vector<float>& getSpectrum() const { return spectrum_.values; }
+
+    /**
+     * @brief Get held spectrum peaks in dB
+     */
+    const std::vector<float>& getSpectrumPeaks() const { return spectrum_.peaks; }
+
+    /**
+     * @brief Get the bands inside the row range
+     */
+    const std::vector<OctaveBand>& getBands() const { return bands_; }
+
+    /**
+     * @brief Get band power of the latest column in dB (one value per band)
+     */
+    const std::vector<float>& getBandLevels() const { return band_levels_.values; }
+
+    /**
+     * @brief Get held band peaks in dB
+     */
+    const std::vector<float>& getBandPeaks() const { return band_levels_.peaks; }
+
+private:
+    /**
+     * @brief Values with held peaks
+     */
+    struct PeakTrack {
+        std::vector<float> values;
+        std::vector<float> peaks;
+        std::vector<float> ages;    ///< Seconds since each peak was set
+
+        void assign(size_t count);
+        void hold(size_t i, float value);
+        void decay(float seconds, float hold_seconds, float decay_db_per_second);
+    };
+
+    /**
+     * @brief Row contribution to a band (power weight in bins)
+     */
+    struct BandWeight {
+        uint32_t row;
+        float bins;
+    };
+
+    /**
+     * @brief Rebuild bands_ and the band weights from the row layout
+     */
+    void computeBands(float bin_hz);
+
+    Options options_;
+    std::vector<float> row_frequencies_;
+    std::vector<OctaveBand> bands_;
+    std::vector<uint32_t> band_offsets_;    ///< band_weights_ range of band b: [offsets[b], offsets[b+1])
+    std::vector<BandWeight> band_weights_;
+
+    std::vector<uint16_t> latest_;          ///< Last added column
+    std::vector<uint16_t> pooled_;          ///< Per-row maximum since the last update()
+    size_t pending_ = 0;                    ///< Columns added since the last update()
+    std::vector<float> row_power_;          ///< Scratch: pooled rows as linear power
+
+    PeakTrack spectrum_;
+    PeakTrack band_levels_;
+};
+
+} // namespace friture
+
+#endif // FRITURE_SPECTRUM_VIEWS_HPP
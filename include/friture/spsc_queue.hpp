@@ -0,0 +1,159 @@
+/**
+ * @file spsc_queue.hpp
+ * @brief Lock-free single-producer/single-consumer queue
+ *
+ * This queue hands fixed-size items (e.g. finished spectrogram columns)
+ * from one thread to another without locks or allocation. It is used to
+ * move analysis results from the DSP worker to the render thread.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_SPSC_QUEUE_HPP
+#define FRITURE_SPSC_QUEUE_HPP
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+namespace friture {
+
+/**
+ * @brief Bounded lock-free SPSC queue with pre-allocated slots
+ *
+ * All slots are constructed up front from a prototype value, so a slot of
+ * type std::vector<uint32_t> keeps its capacity for the lifetime of the
+ * queue. Pushing copies into (or fills) an existing slot; popping hands
+ * out a reference to it. Neither side allocates after construction.
+ *
+ * @tparam T Item type (must be copy-assignable)
+ *
+ * Thread Safety:
+ * - Exactly one producer thread may call tryPush()/pushWith()
+ * - Exactly one consumer thread may call tryPop()/popWith()
+ * - size()/empty() may be called from either thread (approximate)
+ *
+ * Performance:
+ * - Push/pop: O(1) plus the cost of copying T
+ * - Head and tail live on separate cache lines to avoid false sharing
+ *
+ * Example:
+ * @code
+ * SpscQueue<std::vector<uint32_t>> queue(256, std::vector<uint32_t>(1080));
+ *
+ * // Producer (DSP thread):
+ * queue.pushWith([&](std::vector<uint32_t>& slot) {
+ *     color_transform.transformColumn(normalized, 1080, slot.data());
+ * });
+ *
+ * // Consumer (render thread):
+ * while (queue.popWith([&](const std::vector<uint32_t>& column) {
+ *     image.addColumn(column.data(), column.size());
+ * })) {}
+ * @endcode
+ */
+template<typename T>
+class SpscQueue {
+public:
+    /**
+     * @brief Construct queue with fixed capacity
+     * @param capacity Maximum number of items held at once (must be > 0)
+     * @param prototype Value used to initialize every slot
+     */
+    explicit SpscQueue(size_t capacity, const T& prototype = T{})
+        : slots_(capacity + 1, prototype),
+          head_(0),
+          tail_(0) {
+    }
+
+    /**
+     * @brief Copy an item into the queue
+     * @param item Item to enqueue
+     * @return true if enqueued, false if the queue is full
+     */
+    bool tryPush(const T& item) {
+        return pushWith([&item](T& slot) { slot = item; });
+    }
+
+    /**
+     * @brief Fill the next free slot in place
+     * @param fill Callable invoked as fill(T& slot) before publishing
+     * @return true if enqueued, false if the queue is full (fill not called)
+     */
+    template<typename F>
+    bool pushWith(F&& fill) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t next = increment(tail);
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;  // Full
+        }
+
+        fill(slots_[tail]);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Copy the oldest item out of the queue
+     * @param out Destination for the dequeued item
+     * @return true if an item was dequeued, false if the queue is empty
+     */
+    bool tryPop(T& out) {
+        return popWith([&out](const T& slot) { out = slot; });
+    }
+
+    /**
+     * @brief Consume the oldest item in place
+     * @param consume Callable invoked as consume(const T& slot)
+     * @return true if an item was consumed, false if the queue is empty
+     */
+    template<typename F>
+    bool popWith(F&& consume) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;  // Empty
+        }
+
+        consume(static_cast<const T&>(slots_[head]));
+        head_.store(increment(head), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get number of items currently queued (approximate)
+     * @return Item count
+     */
+    size_t size() const {
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return (tail >= head) ? (tail - head) : (slots_.size() - head + tail);
+    }
+
+    /**
+     * @brief Check whether the queue is empty (approximate)
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Get maximum number of items the queue can hold
+     */
+    size_t capacity() const { return slots_.size() - 1; }
+
+private:
+    size_t increment(size_t index) const {
+        return (index + 1 == slots_.size()) ? 0 : index + 1;
+    }
+
+    std::vector<T> slots_;                    ///< Pre-allocated slots (capacity + 1)
+    alignas(64) std::atomic<size_t> head_;    ///< Next slot to consume (consumer-owned)
+    alignas(64) std::atomic<size_t> tail_;    ///< Next slot to fill (producer-owned)
+
+    // Prevent copying (slots are shared between threads)
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_SPSC_QUEUE_HPP
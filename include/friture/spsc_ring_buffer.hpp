@@ -0,0 +1,292 @@
+/**
+ * @file spsc_ring_buffer.hpp
+ * @brief Power-of-two single-producer/single-consumer sample ring
+ *
+ * A stricter sibling of RingBuffer for one writer and one reader: the
+ * capacity is a power of two so positions are masked instead of taken
+ * modulo, producer and consumer counters live on separate cache lines, and
+ * both sides can work on the ring memory in place (prepareWrite() /
+ * peek()) instead of copying through a staging buffer.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_SPSC_RING_BUFFER_HPP
+#define FRITURE_SPSC_RING_BUFFER_HPP
+
+#include <vector>
+#include <atomic>
+#include <span>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Lock-free SPSC ring with mask indexing and zero-copy regions
+ *
+ * Unlike RingBuffer, the writer never overwrites samples the reader has
+ * not consumed yet: a full ring makes write() store fewer samples and
+ * count the rest as dropped. In exchange, memory returned by peek() stays
+ * valid until consume(), so a reader can window an FFT frame directly from
+ * the ring (see FFTProcessor::processSplit()) and then advance by one hop.
+ *
+ * A region of the ring is returned as at most two spans: the part before
+ * the physical end of the buffer and the part wrapped to its start.
+ *
+ * @tparam T Sample type (trivially copyable, typically float)
+ *
+ * Thread Safety:
+ * - Exactly one producer thread may call write()/prepareWrite()/commitWrite()
+ * - Exactly one consumer thread may call peek()/consume()/read()
+ * - Counters may be read from any thread (approximate)
+ *
+ * Performance:
+ * - Index math is a single AND; no division on any path
+ * - Each side caches the other side's counter and only reloads it (one
+ *   cache miss) when the cached value says the ring is full / empty
+ * - No allocation after construction
+ *
+ * Example:
+ * @code
+ * SpscRingBuffer<float> ring(1 << 16);
+ *
+ * // Audio callback (producer):
+ * ring.write(input, frames);
+ *
+ * // Analysis thread (consumer), 4096-sample frames every 1024 samples:
+ * while (ring.readAvailable() >= 4096) {
+ *     auto frame = ring.peek(0, 4096);
+ *     fft.processSplit(frame.first.data(), frame.first.size(),
+ *                      frame.second.data(), spectrum);
+ *     ring.consume(1024);
+ * }
+ * @endcode
+ */
+template<typename T>
+class SpscRingBuffer {
+public:
+    /**
+     * @brief Up to two read-only spans covering a contiguous stream region
+     */
+    struct Regions {
+        std::span<const T> first;   ///< Region up to the physical end of the ring
+        std::span<const T> second;  ///< Remainder wrapped to the start (may be empty)
+
+        size_t size() const { return first.size() + second.size(); }
+        bool empty() const { return size() == 0; }
+    };
+
+    /**
+     * @brief Up to two writable spans covering free space
+     */
+    struct WriteRegions {
+        std::span<T> first;   ///< Free space up to the physical end of the ring
+        std::span<T> second;  ///< Remainder wrapped to the start (may be empty)
+
+        size_t size() const { return first.size() + second.size(); }
+    };
+
+    /**
+     * @brief Construct ring
+     * @param min_capacity Requested capacity; rounded up to a power of two (>= 1)
+     */
+    explicit SpscRingBuffer(size_t min_capacity)
+        : capacity_(std::bit_ceil(std::max<size_t>(min_capacity, 1))),
+          mask_(capacity_ - 1),
+          buffer_(capacity_, T{}) {
+    }
+
+    // ========================================================================
+    // Producer
+    // ========================================================================
+
+    /**
+     * @brief Copy samples into the ring
+     * @param data Source samples
+     * @param count Number of samples offered
+     * @return Number of samples stored (less than count if the ring is full;
+     *         the rest are added to getDroppedCount())
+     */
+    size_t write(const T* data, size_t count) {
+        WriteRegions regions = prepareWrite(count);
+        std::copy_n(data, regions.first.size(), regions.first.data());
+        std::copy_n(data + regions.first.size(), regions.second.size(), regions.second.data());
+        commitWrite(regions.size());
+
+        if (regions.size() < count) {
+            producer_.dropped.store(producer_.dropped.load(std::memory_order_relaxed) +
+                                        (count - regions.size()),
+                                    std::memory_order_relaxed);
+        }
+        return regions.size();
+    }
+
+    /**
+     * @brief Get free space to fill in place
+     * @param count Samples wanted
+     * @return Up to count free samples; fill them, then commitWrite()
+     */
+    WriteRegions prepareWrite(size_t count) {
+        const uint64_t write_index = producer_.write_index.load(std::memory_order_relaxed);
+        if (capacity_ - (write_index - producer_.cached_read) < count) {
+            producer_.cached_read = consumer_.read_index.load(std::memory_order_acquire);
+        }
+
+        const size_t free = capacity_ - static_cast<size_t>(write_index - producer_.cached_read);
+        const size_t n = std::min(count, free);
+        const size_t start = static_cast<size_t>(write_index) & mask_;
+        const size_t first = std::min(n, capacity_ - start);
+
+        return WriteRegions{std::span<T>(buffer_.data() + start, first),
+                            std::span<T>(buffer_.data(), n - first)};
+    }
+
+    /**
+     * @brief Publish samples filled through prepareWrite()
+     * @param count Samples to publish (<= size of the last prepareWrite())
+     */
+    void commitWrite(size_t count) {
+        const uint64_t write_index = producer_.write_index.load(std::memory_order_relaxed);
+        producer_.write_index.store(write_index + count, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get free space (producer side)
+     */
+    size_t writeAvailable() const {
+        const uint64_t write_index = producer_.write_index.load(std::memory_order_relaxed);
+        return capacity_ - static_cast<size_t>(
+            write_index - consumer_.read_index.load(std::memory_order_acquire));
+    }
+
+    // ========================================================================
+    // Consumer
+    // ========================================================================
+
+    /**
+     * @brief Get number of samples ready to read (consumer side)
+     */
+    size_t readAvailable() const {
+        consumer_.cached_write = producer_.write_index.load(std::memory_order_acquire);
+        return static_cast<size_t>(
+            consumer_.cached_write - consumer_.read_index.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Look at unread samples without consuming them
+     * @param offset Samples to skip from the oldest unread sample
+     * @param count Samples wanted
+     * @return Spans into the ring, or empty Regions if fewer than
+     *         offset + count samples are readable
+     *
+     * The spans stay valid (the producer cannot overwrite them) until
+     * consume() releases them.
+     */
+    Regions peek(size_t offset, size_t count) const {
+        const uint64_t read_index = consumer_.read_index.load(std::memory_order_relaxed);
+        if (consumer_.cached_write - read_index < offset + count) {
+            consumer_.cached_write = producer_.write_index.load(std::memory_order_acquire);
+            if (consumer_.cached_write - read_index < offset + count) {
+                return Regions{};
+            }
+        }
+
+        const size_t start = static_cast<size_t>(read_index + offset) & mask_;
+        const size_t first = std::min(count, capacity_ - start);
+
+        return Regions{std::span<const T>(buffer_.data() + start, first),
+                       std::span<const T>(buffer_.data(), count - first)};
+    }
+
+    /**
+     * @brief Release the oldest samples back to the producer
+     * @param count Samples to release (<= readAvailable())
+     */
+    void consume(size_t count) {
+        const uint64_t read_index = consumer_.read_index.load(std::memory_order_relaxed);
+        consumer_.read_index.store(read_index + count, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy out and consume the oldest samples
+     * @param output Destination buffer
+     * @param count Samples wanted
+     * @return Number of samples read (less than count if fewer are available)
+     */
+    size_t read(T* output, size_t count) {
+        const size_t n = std::min(count, readAvailable());
+        Regions regions = peek(0, n);
+        std::copy_n(regions.first.data(), regions.first.size(), output);
+        std::copy_n(regions.second.data(), regions.second.size(), output + regions.first.size());
+        consume(n);
+        return n;
+    }
+
+    // ========================================================================
+    // Counters
+    // ========================================================================
+
+    /**
+     * @brief Get capacity (a power of two)
+     */
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Get total samples ever stored (monotonic)
+     */
+    uint64_t getTotalWritten() const {
+        return producer_.write_index.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get total samples ever consumed (monotonic)
+     */
+    uint64_t getTotalRead() const {
+        return consumer_.read_index.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get samples rejected by write() because the ring was full
+     */
+    uint64_t getDroppedCount() const {
+        return producer_.dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief State written by the producer (own cache line)
+     */
+    struct alignas(64) ProducerState {
+        std::atomic<uint64_t> write_index{0};  ///< Samples published (monotonic)
+        std::atomic<uint64_t> dropped{0};      ///< Samples rejected when full
+        uint64_t cached_read = 0;              ///< Last seen consumer read_index
+    };
+
+    /**
+     * @brief State written by the consumer (own cache line)
+     */
+    struct alignas(64) ConsumerState {
+        std::atomic<uint64_t> read_index{0};   ///< Samples consumed (monotonic)
+        mutable uint64_t cached_write = 0;     ///< Last seen producer write_index
+    };
+
+    // Read-only after construction; shared freely by both threads
+    const size_t capacity_;     ///< Power-of-two capacity
+    const size_t mask_;         ///< capacity_ - 1
+    std::vector<T> buffer_;     ///< Sample storage
+
+    ProducerState producer_;    ///< Producer-owned counters
+    ConsumerState consumer_;    ///< Consumer-owned counters
+
+    // Prevent copying (shared between threads)
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_SPSC_RING_BUFFER_HPP
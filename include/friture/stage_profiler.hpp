@@ -0,0 +1,370 @@
+/**
+ * @file stage_profiler.hpp
+ * @brief Per-stage latency histograms and optional Chrome trace recording
+ *
+ * StageProfiler times each step of the pipeline (file/ring read, FFT,
+ * resampling, colorizing on the analysis thread; queue drain, texture
+ * upload, drawing, UI text and present on the render thread) so a dropped
+ * frame can be attributed to a stage. Every stage has its own wait-free
+ * histogram written by the one thread that runs it, in the same style as
+ * CallbackStats; readers take snapshots and diff them to get percentiles
+ * over a recent window.
+ *
+ * With tracing enabled, each timed scope is also appended to a fixed-size
+ * per-stage event log that can be written out as Chrome trace-event JSON
+ * (chrome://tracing, Perfetto).
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_STAGE_PROFILER_HPP
+#define FRITURE_STAGE_PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace friture {
+
+/**
+ * @brief Timed pipeline steps
+ *
+ * Analysis thread stages come first, render thread stages after; each
+ * stage is only ever recorded from its own thread.
+ */
+enum class ProfileStage : uint8_t {
+    // Analysis thread (per column unless noted)
+    Read = 0,   ///< File read-ahead / live ring window read
+    FFT,        ///< Window + FFT (+ dB); batched FFTs count once per column
+    Resample,   ///< Frequency resampling (multichannel: combining lanes)
+    Colorize,   ///< dB → color (or level) into the column queue
+
+    // Render thread (per frame)
+    Drain,      ///< Moving queued columns into the spectrogram image
+    Upload,     ///< Texture upload of the dirty columns
+    Draw,       ///< Spectrogram texture copy / shader draw
+    UI,         ///< Status bar, axis labels and overlays (text rendering)
+    Present,    ///< SDL_RenderPresent (includes any vsync wait)
+    Frame,      ///< Whole renderFrame()
+
+    Count
+};
+
+/**
+ * @brief Convert profile stage to string
+ */
+inline const char* toString(ProfileStage stage) {
+    switch (stage) {
+        case ProfileStage::Read: return "Read";
+        case ProfileStage::FFT: return "FFT";
+        case ProfileStage::Resample: return "Resample";
+        case ProfileStage::Colorize: return "Colorize";
+        case ProfileStage::Drain: return "Drain";
+        case ProfileStage::Upload: return "Upload";
+        case ProfileStage::Draw: return "Draw";
+        case ProfileStage::UI: return "UI";
+        case ProfileStage::Present: return "Present";
+        case ProfileStage::Frame: return "Frame";
+        default: return "Unknown";
+    }
+}
+
+/**
+ * @brief True for stages timed on the analysis thread
+ */
+inline bool isAnalysisStage(ProfileStage stage) {
+    return stage < ProfileStage::Drain;
+}
+
+/**
+ * @brief Point-in-time copy of one stage's histogram
+ *
+ * Buckets are log-linear: durations below 8 ns get one bucket per
+ * nanosecond, above that every power of two is split into 8 equal
+ * sub-buckets, so a percentile is resolved to within 12.5%. The last
+ * bucket also collects everything longer than ~4.3 s.
+ */
+struct StageStatsSnapshot {
+    static constexpr size_t SUB_BUCKETS = 8;          ///< Sub-buckets per power of two
+    static constexpr size_t HISTOGRAM_BUCKETS = 240;  ///< Up to 2^32 ns resolved
+
+    uint64_t count = 0;        ///< Samples recorded
+    uint64_t total_ns = 0;     ///< Sum of all durations
+    std::array<uint64_t, HISTOGRAM_BUCKETS> histogram{};  ///< Duration buckets
+
+    /**
+     * @brief Histogram bucket for a duration
+     */
+    static size_t bucketFor(uint64_t duration_ns) {
+        if (duration_ns < SUB_BUCKETS) {
+            return static_cast<size_t>(duration_ns);
+        }
+        const size_t exponent = static_cast<size_t>(std::bit_width(duration_ns)) - 1;  // >= 3
+        const size_t sub = static_cast<size_t>(duration_ns >> (exponent - 3)) & (SUB_BUCKETS - 1);
+        const size_t bucket = (exponent - 2) * SUB_BUCKETS + sub;
+        return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+    }
+
+    /**
+     * @brief Smallest duration (ns) that falls into a bucket
+     */
+    static uint64_t bucketLowerNs(size_t bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        const size_t exponent = bucket / SUB_BUCKETS + 2;
+        return (SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - 3);
+    }
+
+    /**
+     * @brief Estimate a duration percentile from the histogram
+     * @param fraction Quantile in [0, 1] (0.99 for p99)
+     * @return Upper edge of the bucket holding the quantile (µs), or 0 if
+     *         nothing was recorded
+     */
+    double percentileMicros(double fraction) const {
+        if (count == 0) {
+            return 0.0;
+        }
+        const double target = fraction * static_cast<double>(count);
+        uint64_t cumulative = 0;
+        size_t bucket = 0;
+        for (; bucket + 1 < HISTOGRAM_BUCKETS; ++bucket) {
+            cumulative += histogram[bucket];
+            if (cumulative > 0 && static_cast<double>(cumulative) >= target) {
+                break;
+            }
+        }
+        return static_cast<double>(bucketLowerNs(bucket + 1)) / 1000.0;
+    }
+
+    /**
+     * @brief Upper edge of the highest non-empty bucket (µs)
+     */
+    double maxMicros() const {
+        for (size_t bucket = HISTOGRAM_BUCKETS; bucket-- > 0; ) {
+            if (histogram[bucket] > 0) {
+                return static_cast<double>(bucketLowerNs(bucket + 1)) / 1000.0;
+            }
+        }
+        return 0.0;
+    }
+
+    /**
+     * @brief Mean duration (µs)
+     */
+    double meanMicros() const {
+        return count > 0 ? static_cast<double>(total_ns) / count / 1000.0 : 0.0;
+    }
+
+    /**
+     * @brief Samples recorded after an earlier snapshot of the same stage
+     *
+     * Counters only grow, so the difference is exactly the histogram of the
+     * interval between the two snapshots.
+     */
+    StageStatsSnapshot since(const StageStatsSnapshot& earlier) const {
+        StageStatsSnapshot delta;
+        delta.count = count - earlier.count;
+        delta.total_ns = total_ns - earlier.total_ns;
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+            delta.histogram[i] = histogram[i] - earlier.histogram[i];
+        }
+        return delta;
+    }
+};
+
+/**
+ * @brief Snapshots of all stages
+ */
+struct StageProfileSnapshot {
+    std::array<StageStatsSnapshot, static_cast<size_t>(ProfileStage::Count)> stages{};
+
+    const StageStatsSnapshot& operator[](ProfileStage stage) const {
+        return stages[static_cast<size_t>(stage)];
+    }
+
+    /**
+     * @brief Per-stage difference to an earlier snapshot
+     */
+    StageProfileSnapshot since(const StageProfileSnapshot& earlier) const {
+        StageProfileSnapshot delta;
+        for (size_t i = 0; i < stages.size(); ++i) {
+            delta.stages[i] = stages[i].since(earlier.stages[i]);
+        }
+        return delta;
+    }
+};
+
+/**
+ * @brief Per-stage latency histograms shared by the pipeline threads
+ *
+ * Thread Safety:
+ * - record() for a given stage from one thread at a time; it is wait-free
+ *   (relaxed loads/stores, no read-modify-write loops)
+ * - getSnapshot() and writeTrace() from any thread, concurrently with
+ *   recording
+ * - enableTrace() before anything is recorded
+ *
+ * Timestamps come from std::chrono::steady_clock (a vDSO read on Linux,
+ * no TSC calibration needed); two reads per scope cost well under a
+ * microsecond, so the profiler stays on in release builds.
+ *
+ * Example:
+ * @code
+ * // Analysis thread:
+ * {
+ *     ScopedStageTimer timer(profiler, ProfileStage::FFT);
+ *     fft.process(input, output);
+ * }
+ *
+ * // UI thread, once a second:
+ * auto now = profiler.getSnapshot();
+ * auto window = now.since(previous);
+ * draw(window[ProfileStage::FFT].percentileMicros(0.99));
+ * @endcode
+ */
+class StageProfiler {
+public:
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(ProfileStage::Count);
+    static constexpr size_t HISTOGRAM_BUCKETS = StageStatsSnapshot::HISTOGRAM_BUCKETS;
+
+    StageProfiler();
+    ~StageProfiler();
+
+    /**
+     * @brief Current time on the profiler clock (ns)
+     */
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Record one timed scope
+     * @param stage Stage that ran
+     * @param start_ns Start time from now()
+     * @param duration_ns Time spent
+     * @param columns Columns the scope produced; a batch of N columns adds N
+     *                samples of duration_ns / N to the histogram (one trace event)
+     */
+    void record(ProfileStage stage, uint64_t start_ns, uint64_t duration_ns, size_t columns = 1) {
+        Stage& s = stages_[static_cast<size_t>(stage)];
+        const uint64_t n = columns > 0 ? columns : 1;
+        bump(s.count, n);
+        bump(s.total_ns, duration_ns);
+        bump(s.histogram[StageStatsSnapshot::bucketFor(duration_ns / n)], n);
+
+        if (s.events) {
+            const size_t index = s.event_count.load(std::memory_order_relaxed);
+            if (index < trace_capacity_) {
+                s.events[index] = TraceEvent{start_ns, duration_ns};
+                s.event_count.store(index + 1, std::memory_order_release);
+            }
+        }
+    }
+
+    /**
+     * @brief Copy all stage histograms (any thread)
+     */
+    StageProfileSnapshot getSnapshot() const;
+
+    /**
+     * @brief Keep the first events_per_stage scopes of every stage for writeTrace()
+     * @param events_per_stage Event log size per stage (16 bytes per event)
+     *
+     * Must be called before anything is recorded. Once a stage's log is
+     * full its later scopes still reach the histograms but not the trace.
+     */
+    void enableTrace(size_t events_per_stage);
+
+    /**
+     * @brief Check whether trace events are being kept
+     */
+    bool isTracing() const { return trace_capacity_ > 0; }
+
+    /**
+     * @brief Number of trace events kept so far (all stages)
+     */
+    size_t getTraceEventCount() const;
+
+    /**
+     * @brief Write the kept events as Chrome trace-event JSON
+     * @param path Output file
+     * @return true on success; see getError() otherwise
+     *
+     * Timestamps are relative to the profiler's construction. Analysis and
+     * render stages appear as two named threads.
+     */
+    bool writeTrace(const std::string& path);
+
+    /**
+     * @brief Get last error message
+     */
+    const std::string& getError() const { return error_; }
+
+private:
+    struct TraceEvent {
+        uint64_t start_ns;
+        uint64_t duration_ns;
+    };
+
+    struct Stage {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> total_ns{0};
+        std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> histogram{};
+        std::unique_ptr<TraceEvent[]> events;   ///< Written once each, below event_count
+        std::atomic<size_t> event_count{0};
+    };
+
+    // Single writer per stage: a plain load + store is enough and never spins
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    std::array<Stage, STAGE_COUNT> stages_;
+    size_t trace_capacity_;    ///< Events per stage (0 = tracing off)
+    uint64_t epoch_ns_;        ///< Trace time origin
+    std::string error_;
+
+    // Prevent copying (shared with the pipeline threads)
+    StageProfiler(const StageProfiler&) = delete;
+    StageProfiler& operator=(const StageProfiler&) = delete;
+};
+
+/**
+ * @brief Times the enclosing scope into a StageProfiler
+ */
+class ScopedStageTimer {
+public:
+    ScopedStageTimer(StageProfiler& profiler, ProfileStage stage, size_t columns = 1)
+        : profiler_(profiler), stage_(stage), columns_(columns), start_ns_(StageProfiler::now()) {}
+
+    ~ScopedStageTimer() {
+        profiler_.record(stage_, start_ns_, StageProfiler::now() - start_ns_, columns_);
+    }
+
+    /**
+     * @brief Change the column count credited when the scope ends
+     */
+    void setColumns(size_t columns) { columns_ = columns; }
+
+private:
+    StageProfiler& profiler_;
+    ProfileStage stage_;
+    size_t columns_;
+    uint64_t start_ns_;
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_STAGE_PROFILER_HPP
@@ -0,0 +1,538 @@
+/**
+ * @file static_spectrum_pipeline.hpp
+ * @brief FFT → resample pipeline with every table built at compile time
+ *
+ * Deployments that only ever run one configuration (e.g. 4096-point Hann
+ * into a fixed-height log display) pay for FFTProcessor's and
+ * FrequencyResampler's runtime generality: window and bin mapping tables
+ * computed at startup and held in heap memory, and a switch per column
+ * on the aggregation mode. StaticSpectrumPipeline takes the whole
+ * configuration as a template argument, so the window, the pixel → bin
+ * mapping and the aggregation matrix are constexpr tables in read-only
+ * memory, and the only per-instance state is the FFT working memory.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_STATIC_SPECTRUM_PIPELINE_HPP
+#define FRITURE_STATIC_SPECTRUM_PIPELINE_HPP
+
+#include <friture/types.hpp>
+#include <friture/frequency_resampler.hpp>
+#include <friture/fft_wisdom.hpp>
+#include <friture/simd_kernels.hpp>
+#include <friture/window_functions.hpp>
+#include <fftw3.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+
+namespace friture {
+
+/**
+ * @brief Compile-time configuration of a StaticSpectrumPipeline
+ *
+ * Same meaning as the matching ChainKey fields. Used as a non-type
+ * template argument, so every field is part of the pipeline's type.
+ */
+struct StaticPipelineConfig {
+    size_t fft_size = 4096;                                  ///< FFT size (power of 2, 32-16384)
+    WindowFunction window = WindowFunction::Hann;            ///< Window function
+    FrequencyScale scale = FrequencyScale::Logarithmic;      ///< Output frequency scale
+    float min_freq = 20.0f;                                  ///< Lowest displayed frequency (Hz)
+    float max_freq = 20000.0f;                               ///< Highest displayed frequency (Hz)
+    float sample_rate = 48000.0f;                            ///< Sample rate (Hz)
+    size_t height = 512;                                     ///< Output column height (pixels)
+    BinAggregation aggregation = BinAggregation::MeanPower;  ///< Bin → row combination
+};
+
+namespace static_math {
+
+// std::cos, std::log10 and std::pow are not constexpr in C++20. These are
+// evaluated in long double and rounded once to the caller's type, which
+// reproduces the correctly rounded library results the dynamic path gets
+// in all but rare halfway cases.
+
+inline constexpr double PI = 3.14159265358979323846;
+inline constexpr long double LN2 = 0.693147180559945309417232121458176568L;
+inline constexpr long double LN10 = 2.302585092994045684017991454684364208L;
+
+/**
+ * @brief Taylor series of sin or cos for |x| <= π/4
+ */
+constexpr long double taylor(long double x, bool sine) {
+    const long double x2 = x * x;
+    long double term = sine ? x : 1.0L;
+    long double sum = term;
+    for (int n = sine ? 2 : 1; n < 24; ++n) {
+        const int k = sine ? 2 * n - 1 : 2 * n;
+        term *= -x2 / static_cast<long double>((k - 1) * k);
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief cos(x) for 0 <= x <= 2π
+ *
+ * Reduced and summed in long double, so the result is the correctly
+ * rounded double wherever long double is wider than double.
+ */
+constexpr double cos(double x) {
+    constexpr long double pi = 3.14159265358979323846264338327950288L;
+    long double y = x;
+    if (y > pi) {
+        y = 2.0L * pi - y;                // cos(2π - x) = cos(x)
+    }
+    long double sign = 1.0L;
+    if (y > 0.5L * pi) {
+        y = pi - y;                       // cos(π - x) = -cos(x)
+        sign = -1.0L;
+    }
+    return static_cast<double>(y > 0.25L * pi ? sign * taylor(0.5L * pi - y, true)
+                                              : sign * taylor(y, false));
+}
+
+/**
+ * @brief Natural logarithm (x > 0)
+ */
+constexpr long double log(long double x) {
+    int exponent = 0;
+    while (x >= 2.0L) {
+        x *= 0.5L;
+        ++exponent;
+    }
+    while (x < 1.0L) {
+        x *= 2.0L;
+        --exponent;
+    }
+    if (x > 1.41421356237309504880L) {
+        x *= 0.5L;
+        ++exponent;
+    }
+
+    // ln(x) = 2·atanh((x - 1) / (x + 1)), |z| <= 0.172
+    const long double z = (x - 1.0L) / (x + 1.0L);
+    const long double z2 = z * z;
+    long double power = z;
+    long double sum = z;
+    for (int k = 3; k < 40; k += 2) {
+        power *= z2;
+        sum += power / static_cast<long double>(k);
+    }
+    return 2.0L * sum + static_cast<long double>(exponent) * LN2;
+}
+
+/**
+ * @brief e^x (|x| < 700)
+ */
+constexpr long double exp(long double x) {
+    const long double turns = x / LN2;
+    const int64_t k = static_cast<int64_t>(turns < 0.0L ? turns - 0.5L : turns + 0.5L);
+    const long double r = x - static_cast<long double>(k) * LN2;   // |r| <= ln2 / 2
+
+    long double term = 1.0L;
+    long double sum = 1.0L;
+    for (int n = 1; n < 24; ++n) {
+        term *= r / static_cast<long double>(n);
+        sum += term;
+    }
+    for (int64_t i = 0; i < k; ++i) {
+        sum *= 2.0L;
+    }
+    for (int64_t i = 0; i > k; --i) {
+        sum *= 0.5L;
+    }
+    return sum;
+}
+
+constexpr float log10(float x) { return static_cast<float>(log(x) / LN10); }
+constexpr float log2(float x) { return static_cast<float>(log(x) / LN2); }
+constexpr float pow10(float x) { return static_cast<float>(exp(x * LN10)); }
+constexpr float pow2(float x) { return static_cast<float>(exp(x * LN2)); }
+
+} // namespace static_math
+
+/**
+ * @brief Aggregation matrix in FrequencyResampler's layout, sized at compile time
+ * @tparam NumBins Spectrum bins
+ * @tparam Height Output rows
+ */
+template<size_t NumBins, size_t Height>
+struct StaticBandTable {
+    static constexpr size_t WEIGHT_CAPACITY = NumBins + 2 * Height;  ///< Bound on the weights
+
+    std::array<FrequencyResampler::Band, Height> bands{};   ///< Row → bins
+    std::array<float, WEIGHT_CAPACITY> weights{};           ///< All rows' weights
+    size_t weight_count = 0;                                ///< Weights in use
+    size_t first_bin = 0;                                   ///< First bin any row reads
+    size_t end_bin = 0;                                     ///< One past the last bin any row reads
+};
+
+namespace static_tables {
+
+// Compile-time versions of windowTable(),
+// FrequencyResampler::computeMapping() and computeBands(), step for step.
+
+inline constexpr float ERB_A = 21.33228113095401739888262f;   ///< FrequencyResampler's ERB constant
+
+template<FrequencyScale Scale>
+constexpr float transform(float freq) {
+    if constexpr (Scale == FrequencyScale::Mel) {
+        return 2595.0f * static_math::log10(1.0f + freq / 700.0f);
+    } else if constexpr (Scale == FrequencyScale::ERB) {
+        return ERB_A * static_math::log10(1.0f + 0.00437f * freq);
+    } else if constexpr (Scale == FrequencyScale::Logarithmic) {
+        return static_math::log10(std::max(freq, 1e-20f));
+    } else if constexpr (Scale == FrequencyScale::Octave) {
+        return static_math::log2(std::max(freq, 1e-20f));
+    } else {
+        return freq;
+    }
+}
+
+template<FrequencyScale Scale>
+constexpr float inverse(float value) {
+    if constexpr (Scale == FrequencyScale::Mel) {
+        return 700.0f * (static_math::pow10(value / 2595.0f) - 1.0f);
+    } else if constexpr (Scale == FrequencyScale::ERB) {
+        return (static_math::pow10(value / ERB_A) - 1.0f) / 0.00437f;
+    } else if constexpr (Scale == FrequencyScale::Logarithmic) {
+        return static_math::pow10(value);
+    } else if constexpr (Scale == FrequencyScale::Octave) {
+        return static_math::pow2(value);
+    } else {
+        return value;
+    }
+}
+
+/**
+ * @brief Lower interpolation bin of a fractional bin index
+ */
+constexpr size_t tap(float bin_idx, size_t num_bins) {
+    return static_cast<size_t>(std::clamp(bin_idx, 0.0f, static_cast<float>(num_bins - 1)));
+}
+
+template<StaticPipelineConfig Config>
+constexpr std::array<float, Config.fft_size> window() {
+    std::array<float, Config.fft_size> window{};
+    if constexpr (Config.window == WindowFunction::Hann || Config.window == WindowFunction::Hamming) {
+        const double n = static_cast<double>(static_cast<float>(Config.fft_size - 1));
+        for (size_t i = 0; i < Config.fft_size; ++i) {
+            const double c = static_math::cos(2.0 * static_math::PI * static_cast<double>(i) / n);
+            window[i] = Config.window == WindowFunction::Hann
+                            ? static_cast<float>(0.5f * (1.0f - c))
+                            : static_cast<float>(0.54f - 0.46f * c);
+        }
+    } else {
+        // Cosine sums with reduced arguments, as windowTable()
+        const bool blackman_harris = Config.window == WindowFunction::BlackmanHarris;
+        const double* a = blackman_harris ? BLACKMAN_HARRIS_COEFFICIENTS : FLAT_TOP_COEFFICIENTS;
+        const size_t terms = blackman_harris ? 4 : 5;
+        const size_t n1 = Config.fft_size - 1;
+        for (size_t i = 0; i < Config.fft_size; ++i) {
+            double value = 0.0;
+            double sign = 1.0;
+            for (size_t k = 0; k < terms; ++k) {
+                value += sign * a[k] * static_math::cos(2.0 * static_math::PI *
+                                                        static_cast<double>((k * i) % n1) /
+                                                        static_cast<double>(n1));
+                sign = -sign;
+            }
+            window[i] = static_cast<float>(value);
+        }
+    }
+    return window;
+}
+
+/**
+ * @brief Mean window coefficient, summed as windowTable() does
+ */
+template<size_t N>
+constexpr float coherentGain(const std::array<float, N>& window) {
+    double sum = 0.0;
+    for (size_t i = 0; i < N; ++i) {
+        sum += window[i];
+    }
+    return static_cast<float>(sum / static_cast<double>(N));
+}
+
+template<StaticPipelineConfig Config>
+constexpr std::array<float, Config.height> mapping() {
+    std::array<float, Config.height> mapping{};
+    const float min_transformed = transform<Config.scale>(Config.min_freq);
+    const float max_transformed = transform<Config.scale>(Config.max_freq);
+    for (size_t i = 0; i < Config.height; ++i) {
+        const float t = static_cast<float>(i) / static_cast<float>(Config.height - 1);
+        const float transformed = min_transformed + t * (max_transformed - min_transformed);
+        mapping[i] = inverse<Config.scale>(transformed) * static_cast<float>(Config.fft_size) /
+                     Config.sample_rate;
+    }
+    return mapping;
+}
+
+template<StaticPipelineConfig Config>
+constexpr StaticBandTable<Config.fft_size / 2 + 1, Config.height>
+bands(const std::array<float, Config.height>& mapping) {
+    constexpr size_t num_bins = Config.fft_size / 2 + 1;
+    constexpr size_t height = Config.height;
+    const float max_edge = static_cast<float>(num_bins) - 0.5f;
+    StaticBandTable<num_bins, height> table{};
+
+    for (size_t i = 0; i < height; ++i) {
+        const float centre = mapping[i];
+
+        float lo = 0.0f;
+        float hi = 0.0f;
+        if (height == 1) {
+            lo = centre - 0.5f;
+            hi = centre + 0.5f;
+        } else if (i == 0) {
+            hi = 0.5f * (centre + mapping[1]);
+            lo = centre - (hi - centre);
+        } else if (i == height - 1) {
+            lo = 0.5f * (mapping[i - 1] + centre);
+            hi = centre + (centre - lo);
+        } else {
+            lo = 0.5f * (mapping[i - 1] + centre);
+            hi = 0.5f * (centre + mapping[i + 1]);
+        }
+        lo = std::clamp(lo, -0.5f, max_edge);
+        hi = std::clamp(hi, -0.5f, max_edge);
+
+        FrequencyResampler::Band& band = table.bands[i];
+        band.weight_offset = static_cast<uint32_t>(table.weight_count);
+
+        if (hi - lo <= 1.0f) {
+            const float bin_idx = std::clamp(centre, 0.0f, static_cast<float>(num_bins - 1));
+            const size_t bin0 = static_cast<size_t>(bin_idx);
+            const size_t bin1 = std::min(bin0 + 1, num_bins - 1);
+            const float frac = bin_idx - static_cast<float>(bin0);
+
+            band.start_bin = static_cast<uint32_t>(bin0);
+            band.interpolated = true;
+            table.weights[table.weight_count++] = 1.0f - frac;
+            if (bin1 > bin0) {
+                table.weights[table.weight_count++] = frac;
+                band.count = 2;
+            } else {
+                band.count = 1;
+            }
+            continue;
+        }
+
+        // lo + 0.5 >= 0, so truncation is floor()
+        const size_t first = static_cast<size_t>(lo + 0.5f);
+        const size_t last = std::min(static_cast<size_t>(hi + 0.5f), num_bins - 1);
+
+        float total = 0.0f;
+        for (size_t k = first; k <= last; ++k) {
+            const float bin_lo = std::max(lo, static_cast<float>(k) - 0.5f);
+            const float bin_hi = std::min(hi, static_cast<float>(k) + 0.5f);
+            const float overlap = std::max(bin_hi - bin_lo, 0.0f);
+            table.weights[table.weight_count++] = overlap;
+            total += overlap;
+        }
+
+        band.start_bin = static_cast<uint32_t>(first);
+        band.count = static_cast<uint32_t>(last - first + 1);
+        band.interpolated = false;
+        for (uint32_t k = 0; k < band.count; ++k) {
+            table.weights[band.weight_offset + k] /= total;
+        }
+    }
+
+    // FrequencyResampler::getInputRange() over all rows
+    const FrequencyResampler::Band& low = table.bands[0];
+    const FrequencyResampler::Band& high = table.bands[height - 1];
+    table.first_bin = std::min<size_t>(low.start_bin, tap(mapping[0], num_bins));
+    table.end_bin = std::max<size_t>(high.start_bin + high.count,
+                                     std::min(tap(mapping[height - 1], num_bins) + 2, num_bins));
+    return table;
+}
+
+} // namespace static_tables
+
+/**
+ * @brief FFT + dB + frequency resampling for one fixed configuration
+ *
+ * Produces the same columns as FFTProcessor::process() followed by
+ * FrequencyResampler::resample() for the same settings: the tables below
+ * are built by the same formulas (windowTable() and its coherent gain,
+ * computeMapping(), computeBands()), the transform is the same FFTW plan, and the dB and
+ * aggregation steps call the same simd kernels. For the linear scale the
+ * tables are bit-identical; for the other scales the transcendental
+ * functions are evaluated by static_math instead of libm, so mapping
+ * entries may differ in the last bit.
+ *
+ * Compile time:
+ * - WINDOW, MAPPING and BANDS are constexpr; nothing is computed
+ *   at startup apart from the FFTW plan (instant when in wisdom)
+ * - Only bins [FIRST_BIN, END_BIN) are converted to dB; the rest are
+ *   never read (see FrequencyResampler::getInputRange())
+ * - The aggregation mode is an if constexpr branch, not a switch per column
+ * - Invalid configurations fail a static_assert
+ *
+ * Memory: tables live in read-only data; an instance holds the FFT input
+ * and output, the dB spectrum and, for MeanPower, a power scratch, all
+ * inline (about 20 × fft_size bytes, one allocation with new or none in
+ * static storage). Instances are not movable because the FFTW plan is
+ * bound to their buffers.
+ *
+ * @tparam Config Configuration (see StaticPipelineConfig)
+ *
+ * Thread Safety: Not thread-safe; one instance per thread. Construction
+ * serializes FFT planning through FFTWisdom::plannerMutex().
+ *
+ * Example:
+ * @code
+ * using Pipeline = StaticSpectrumPipeline<StaticPipelineConfig{
+ *     4096, WindowFunction::Hann, FrequencyScale::Logarithmic, 20.0f, 20000.0f, 48000.0f, 512}>;
+ * static Pipeline pipeline;
+ *
+ * // Per column:
+ * pipeline.process(frame, column_db);
+ * @endcode
+ */
+template<StaticPipelineConfig Config>
+class StaticSpectrumPipeline {
+public:
+    static constexpr size_t FFT_SIZE = Config.fft_size;      ///< FFT size
+    static constexpr size_t NUM_BINS = FFT_SIZE / 2 + 1;     ///< Spectrum bins
+    static constexpr size_t HEIGHT = Config.height;          ///< Output rows
+
+    static_assert(FFT_SIZE >= 32 && FFT_SIZE <= 16384 && (FFT_SIZE & (FFT_SIZE - 1)) == 0,
+                  "FFT size must be a power of 2 in [32, 16384]");
+    static_assert(HEIGHT > 0, "Output height must be > 0");
+    static_assert(Config.min_freq > 0.0f, "Minimum frequency must be > 0");
+    static_assert(Config.max_freq > Config.min_freq, "Maximum frequency must be > minimum");
+    static_assert(Config.max_freq <= Config.sample_rate / 2.0f, "Maximum frequency exceeds Nyquist");
+    static_assert(Config.window != WindowFunction::Kaiser,
+                  "Kaiser windows need β at run time: use FFTProcessor");
+
+    using Band = FrequencyResampler::Band;
+
+    static constexpr std::array<float, FFT_SIZE> WINDOW =
+        static_tables::window<Config>();                      ///< windowTable() coefficients
+    static constexpr std::array<float, HEIGHT> MAPPING =
+        static_tables::mapping<Config>();                     ///< Fractional FFT bin per row
+    static constexpr StaticBandTable<NUM_BINS, HEIGHT> BANDS =
+        static_tables::bands<Config>(MAPPING);                ///< Aggregation matrix
+
+    static constexpr size_t FIRST_BIN = BANDS.first_bin;   ///< First bin converted to dB
+    static constexpr size_t END_BIN = BANDS.end_bin;       ///< One past the last bin converted to dB
+
+    /**
+     * @brief Construct pipeline (plans the FFT)
+     * @throws std::runtime_error if FFTW planning fails
+     */
+    StaticSpectrumPipeline() {
+        {
+            std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
+            plan_ = fftwf_plan_dft_r2c_1d(static_cast<int>(FFT_SIZE), fft_input_.data(),
+                                          fft_output_.data(), FFTW_MEASURE);
+        }
+        if (!plan_) {
+            throw std::runtime_error("Failed to create FFTW plan");
+        }
+
+        // Bins outside [FIRST_BIN, END_BIN) stay at the floor
+        spectrum_.fill(FLOOR_DB);
+    }
+
+    ~StaticSpectrumPipeline() {
+        std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
+        fftwf_destroy_plan(plan_);
+    }
+
+    /**
+     * @brief Transform one frame and map it to the display rows
+     * @param input FFT_SIZE samples
+     * @param column_db Output column (HEIGHT rows, in dB)
+     */
+    void process(const float* input, float* column_db) {
+        simd::applyWindow(input, WINDOW.data(), fft_input_.data(), FFT_SIZE);
+        fftwf_execute(plan_);
+        simd::powerToDb(reinterpret_cast<const float*>(fft_output_.data() + FIRST_BIN),
+                        spectrum_.data() + FIRST_BIN, END_BIN - FIRST_BIN,
+                        POWER_SCALE, EPSILON, false);
+        resample(column_db);
+    }
+
+    /**
+     * @brief Get the dB spectrum of the last process() (bins outside the input range at the floor)
+     */
+    std::span<const float, NUM_BINS> spectrum() const { return spectrum_; }
+
+private:
+    static constexpr float EPSILON = 1e-30f;                                        ///< As FFTProcessor
+    static constexpr float FLOOR_DB = -300.0f;                                      ///< 10 × log10(EPSILON)
+    static constexpr float AMPLITUDE =
+        static_cast<float>(FFT_SIZE) * static_tables::coherentGain(WINDOW);        ///< N · coherent gain
+    static constexpr float POWER_SCALE = 1.0f / (AMPLITUDE * AMPLITUDE);            ///< As FFTProcessor
+    static constexpr bool MEAN_POWER = Config.aggregation == BinAggregation::MeanPower;
+
+    void resample(float* output) const {
+        const float* input = spectrum_.data();
+
+        if constexpr (Config.aggregation == BinAggregation::Interpolate) {
+            // Two taps around each row's bin, in dB
+            for (size_t i = 0; i < HEIGHT; ++i) {
+                const float bin_idx = std::clamp(MAPPING[i], 0.0f, static_cast<float>(NUM_BINS - 1));
+                const size_t bin0 = static_cast<size_t>(bin_idx);
+                const size_t bin1 = std::min(bin0 + 1, NUM_BINS - 1);
+                const float frac = bin_idx - static_cast<float>(bin0);
+                output[i] = input[bin0] * (1.0f - frac) + input[bin1] * frac;
+            }
+            return;
+        }
+
+        if constexpr (MEAN_POWER) {
+            const size_t first = BANDS.bands[0].start_bin;
+            const size_t last = BANDS.bands[HEIGHT - 1].start_bin + BANDS.bands[HEIGHT - 1].count;
+            simd::dbToPower(input + first, power_.data() + first, last - first);
+        }
+
+        for (size_t i = 0; i < HEIGHT; ++i) {
+            const Band& band = BANDS.bands[i];
+            const float* w = BANDS.weights.data() + band.weight_offset;
+            const float* x = input + band.start_bin;
+
+            if (band.interpolated) {
+                float acc = 0.0f;
+                for (uint32_t k = 0; k < band.count; ++k) {
+                    acc += w[k] * x[k];
+                }
+                output[i] = acc;
+            } else if constexpr (MEAN_POWER) {
+                const float* p = power_.data() + band.start_bin;
+                float acc = 0.0f;
+                for (uint32_t k = 0; k < band.count; ++k) {
+                    acc += w[k] * p[k];
+                }
+                output[i] = 10.0f * simd::fastLog10(std::max(acc, 1e-30f));
+            } else {
+                output[i] = *std::max_element(x, x + band.count);
+            }
+        }
+    }
+
+    alignas(64) std::array<float, FFT_SIZE> fft_input_{};           ///< Windowed frame
+    alignas(64) std::array<fftwf_complex, NUM_BINS> fft_output_{};  ///< FFT output
+    alignas(64) std::array<float, NUM_BINS> spectrum_{};            ///< dB spectrum
+    mutable std::array<float, MEAN_POWER ? NUM_BINS : 0> power_{};  ///< MeanPower scratch
+    fftwf_plan plan_ = nullptr;                                     ///< Forward real plan
+
+    // Prevent copying and moving (plan bound to the buffers)
+    StaticSpectrumPipeline(const StaticSpectrumPipeline&) = delete;
+    StaticSpectrumPipeline& operator=(const StaticSpectrumPipeline&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_STATIC_SPECTRUM_PIPELINE_HPP
@@ -0,0 +1,145 @@
+/**
+ * @file task_pool.hpp
+ * @brief Work-stealing fork-join pool for parallel column ranges
+ *
+ * Catch-up bursts and offline renders produce many columns that depend
+ * only on the input samples, so they can be computed in any order on any
+ * thread. TaskPool splits an index range into chunks, deals them out to
+ * per-worker deques and lets idle workers steal from the others, so a
+ * slow chunk (page faults, a preempted thread) does not hold up the rest.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_TASK_POOL_HPP
+#define FRITURE_TASK_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Fixed set of worker threads running chunked index ranges
+ *
+ * parallelFor() cuts [0, count) into chunks of `grain` indices. Worker w
+ * starts with a contiguous run of chunks in its own deque and takes them
+ * from the front (ascending, so consecutive chunks share cache lines and
+ * input spans); when its deque is empty it steals from the back of the
+ * others'. The calling thread is worker 0, so a pool of one thread runs
+ * everything inline.
+ *
+ * The task gets the worker index, so callers keep per-worker state (an
+ * FFTProcessor and scratch buffers per worker) in a vector indexed by it;
+ * no two chunks run on the same worker at once.
+ *
+ * Thread Safety: One thread at a time calls parallelFor(); it must not be
+ * called from inside a task. The worker threads are internal.
+ *
+ * Example:
+ * @code
+ * TaskPool pool;   // hardware concurrency
+ * std::vector<std::unique_ptr<FFTProcessor>> ffts(pool.getThreadCount());
+ * pool.parallelFor(columns, 32, [&](size_t worker, size_t begin, size_t end) {
+ *     if (!ffts[worker]) ffts[worker] = std::make_unique<FFTProcessor>(4096, WindowFunction::Hann);
+ *     for (size_t c = begin; c < end; ++c) { ... }
+ * });
+ * @endcode
+ */
+class TaskPool {
+public:
+    /**
+     * @brief Chunk body: process indices [begin, end) on the given worker
+     */
+    using RangeTask = std::function<void(size_t worker, size_t begin, size_t end)>;
+
+    /**
+     * @brief Construct pool
+     * @param threads Worker threads including the caller (0 = hardware concurrency)
+     */
+    explicit TaskPool(size_t threads = 0);
+
+    /**
+     * @brief Destructor - stops and joins the worker threads
+     */
+    ~TaskPool();
+
+    /**
+     * @brief Get number of workers, including the calling thread
+     */
+    size_t getThreadCount() const { return queues_.size(); }
+
+    /**
+     * @brief Run task over [0, count) in chunks of grain indices and wait
+     * @param count Number of indices
+     * @param grain Indices per chunk (must be > 0)
+     * @param task Chunk body, called concurrently on different workers
+     * @throws std::invalid_argument if grain is 0
+     *
+     * If a task throws, the remaining chunks are skipped and the first
+     * exception is rethrown here once every worker has stopped.
+     */
+    void parallelFor(size_t count, size_t grain, const RangeTask& task);
+
+    /**
+     * @brief Get chunks taken from another worker's deque so far
+     */
+    uint64_t getStealCount() const { return steals_.load(std::memory_order_relaxed); }
+
+private:
+    struct Chunk {
+        size_t begin;
+        size_t end;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;   ///< Own chunks taken from the front, stolen from the back
+    };
+
+    /**
+     * @brief Worker thread body
+     */
+    void workerLoop(size_t worker);
+
+    /**
+     * @brief Run own and stolen chunks until every deque is empty
+     */
+    void runChunks(size_t worker);
+
+    bool popOwn(size_t worker, Chunk& chunk);
+    bool steal(size_t worker, Chunk& chunk);
+
+    std::vector<std::unique_ptr<Queue>> queues_;  ///< One deque per worker (index 0 = caller)
+    const RangeTask* task_ = nullptr;             ///< Task of the current run
+    std::atomic<bool> failed_{false};             ///< A task threw: skip remaining chunks
+    std::exception_ptr failure_;                  ///< First exception (guarded by mutex_)
+    std::atomic<uint64_t> steals_{0};             ///< Stolen chunk count
+
+    // Fork-join state (guarded by mutex_)
+    std::vector<std::thread> workers_;  ///< Helper threads (thread count - 1)
+    std::mutex mutex_;
+    std::condition_variable start_cv_;  ///< Signals a new generation
+    std::condition_variable done_cv_;   ///< Signals the last helper finished
+    uint64_t generation_ = 0;           ///< Incremented per parallelFor()
+    size_t workers_busy_ = 0;           ///< Helpers still working on this generation
+    bool stopping_ = false;             ///< Destructor requested exit
+
+    // Prevent copying (owns threads)
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_TASK_POOL_HPP
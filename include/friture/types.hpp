@@ -22,10 +22,19 @@ namespace friture {
  * frequency resolution and sidelobe suppression.
  */
 enum class WindowFunction {
-    Hann,      ///< Hann window (good general purpose, moderate sidelobes)
-    Hamming    ///< Hamming window (slightly better sidelobe suppression)
+    Hann,            ///< Hann window (good general purpose, moderate sidelobes)
+    Hamming,         ///< Hamming window (slightly better sidelobe suppression)
+    BlackmanHarris,  ///< 4-term Blackman-Harris (-92 dB sidelobes, wider main lobe)
+    FlatTop,         ///< Flat-top (amplitude within 0.01 dB anywhere in a bin, for calibration)
+    Kaiser           ///< Kaiser(β): sidelobes vs. main lobe set by β (see kaiser_beta)
 };
 
+/// Default Kaiser β: about -69 dB sidelobes, close to Blackman
+constexpr float DEFAULT_KAISER_BETA = 8.6f;
+
+/// Largest accepted Kaiser β (sidelobes far below float resolution)
+constexpr float MAX_KAISER_BETA = 50.0f;
+
 /**
  * @brief Frequency scale types for spectrogram display
  *
@@ -59,6 +68,54 @@ enum class WeightingType {
     C       ///< C-weighting (100 phon contour, high SPL)
 };
 
+/**
+ * @brief How FrequencyResampler combines FFT bins into one output row
+ *
+ * Interpolate samples the spectrum at each row's centre frequency. When
+ * there are more bins than rows that skips bins, so narrow tones between
+ * two row centres disappear; the aggregating modes cover every bin.
+ */
+enum class BinAggregation {
+    Interpolate,  ///< Linear interpolation between the two nearest bins
+    MeanPower,    ///< Power-weighted mean of the bins in each row's band
+    PeakHold      ///< Loudest bin in each row's band
+};
+
+/**
+ * @brief How a multichannel spectrogram shares the display
+ */
+enum class ChannelLayout {
+    Stacked,   ///< One horizontal lane per channel, channel 0 at the top
+    Overlay    ///< All channels in full height, loudest channel per row wins
+};
+
+/**
+ * @brief How SpectralAverager combines consecutive spectra over time
+ *
+ * All modes average linear power, not dB, so a level that alternates
+ * between two values averages to their power mean rather than to a
+ * value biased towards the quieter one.
+ */
+enum class AveragingMode {
+    None,         ///< No averaging (decimated columns average their own hops)
+    Exponential,  ///< Exponential average with a time constant
+    Linear,       ///< Mean of the last N spectra
+    PeakHold      ///< Maximum, decaying with a time constant
+};
+
+/**
+ * @brief What the dual-channel (transfer function) mode displays
+ *
+ * Channel 0 is the reference, channel 1 the measured signal; see
+ * CrossSpectrumAnalyzer.
+ */
+enum class TransferView {
+    Off,        ///< Ordinary per-channel spectrograms
+    Magnitude,  ///< |H1| = |Gxy| / Gxx in dB
+    Phase,      ///< arg Gxy in degrees (negative: measured lags)
+    Coherence   ///< |Gxy|² / (Gxx · Gyy), 0..1
+};
+
 /**
  * @brief Convert WindowFunction enum to string
  * @param wf Window function type
@@ -66,9 +123,12 @@ enum class WeightingType {
  */
 inline const char* toString(WindowFunction wf) {
     switch (wf) {
-        case WindowFunction::Hann:    return "Hann";
-        case WindowFunction::Hamming: return "Hamming";
-        default:                      return "Unknown";
+        case WindowFunction::Hann:           return "Hann";
+        case WindowFunction::Hamming:        return "Hamming";
+        case WindowFunction::BlackmanHarris: return "Blackman-Harris";
+        case WindowFunction::FlatTop:        return "Flat-top";
+        case WindowFunction::Kaiser:         return "Kaiser";
+        default:                             return "Unknown";
     }
 }
 
@@ -88,6 +148,63 @@ inline const char* toString(FrequencyScale fs) {
     }
 }
 
+/**
+ * @brief Convert BinAggregation enum to string
+ * @param ba Bin aggregation mode
+ * @return Human-readable string representation
+ */
+inline const char* toString(BinAggregation ba) {
+    switch (ba) {
+        case BinAggregation::Interpolate: return "Interpolate";
+        case BinAggregation::MeanPower:   return "Mean power";
+        case BinAggregation::PeakHold:    return "Peak hold";
+        default:                          return "Unknown";
+    }
+}
+
+/**
+ * @brief Convert ChannelLayout enum to string
+ * @param cl Channel layout
+ * @return Human-readable string representation
+ */
+inline const char* toString(ChannelLayout cl) {
+    switch (cl) {
+        case ChannelLayout::Stacked: return "Stacked";
+        case ChannelLayout::Overlay: return "Overlay";
+        default:                     return "Unknown";
+    }
+}
+
+/**
+ * @brief Convert AveragingMode enum to string
+ * @param am Averaging mode
+ * @return Human-readable string representation
+ */
+inline const char* toString(AveragingMode am) {
+    switch (am) {
+        case AveragingMode::None:        return "None";
+        case AveragingMode::Exponential: return "Exponential";
+        case AveragingMode::Linear:      return "Linear";
+        case AveragingMode::PeakHold:    return "Peak hold";
+        default:                         return "Unknown";
+    }
+}
+
+/**
+ * @brief Convert TransferView enum to string
+ * @param tv Transfer view
+ * @return Human-readable string representation
+ */
+inline const char* toString(TransferView tv) {
+    switch (tv) {
+        case TransferView::Off:       return "Off";
+        case TransferView::Magnitude: return "Magnitude";
+        case TransferView::Phase:     return "Phase";
+        case TransferView::Coherence: return "Coherence";
+        default:                      return "Unknown";
+    }
+}
+
 /**
  * @brief Convert WeightingType enum to string
  * @param wt Weighting type
@@ -0,0 +1,146 @@
+/**
+ * @file gpu_colormap.hpp
+ * @brief Draw a level-plane spectrogram with the colormap applied on the GPU
+ *
+ * SDL2's SDL_Renderer has no custom shader support, so this class issues
+ * its own OpenGL calls inside the "opengl" SDL renderer's context: the
+ * quantized dB levels live in a 16-bit single-channel ring texture and the
+ * ColorTransform palette in a 256-entry 1D texture, and a fragment shader
+ * maps level → dB range → palette per pixel. Changing the dB range or the
+ * theme is a uniform or 1 KB upload; already drawn history never has to be
+ * recolored.
+ *
+ * Features:
+ * - Uploads only dirty columns (same ColumnSpan ring as the RGBA path)
+ * - 2 bytes per pixel on the wire instead of 4
+ * - No per-column color transform on the CPU
+ * - GL entry points loaded through SDL_GL_GetProcAddress (no link-time GL)
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#ifndef FRITURE_GPU_COLORMAP_HPP
+#define FRITURE_GPU_COLORMAP_HPP
+
+#include <friture/spectrogram_image.hpp>
+#include <SDL2/SDL.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace friture {
+
+/**
+ * @brief GPU colormapping renderer for ImagePlane::Levels spectrograms
+ *
+ * Requires an SDL renderer created with the "opengl" driver (set
+ * SDL_HINT_RENDER_DRIVER before SDL_CreateRenderer). If the renderer is
+ * not OpenGL, or the shader cannot be built, isValid() is false and the
+ * caller should fall back to CPU colormapping.
+ *
+ * Every GL state the class touches is saved and restored around draw() and
+ * upload(), so SDL's own state cache stays correct and SDL rendering
+ * (UI overlay, text) continues normally afterwards.
+ *
+ * Usage:
+ * @code
+ * GpuColormap gpu(renderer, width, height);
+ * if (gpu.isValid()) {
+ *     gpu.setPalette(colors.getPalette());
+ *     gpu.upload(image);                        // dirty columns only
+ *     gpu.draw(dst, image.getTextureSeam(), -120.0f, 0.0f);
+ * }
+ * @endcode
+ *
+ * Thread Safety: Not thread-safe. Use from the rendering thread only.
+ */
+class GpuColormap {
+public:
+    /**
+     * @brief Build textures and shader in the renderer's GL context
+     * @param renderer SDL renderer (must use the "opengl" driver)
+     * @param width Ring texture width in columns (image width)
+     * @param height Ring texture height in rows (image height)
+     */
+    GpuColormap(SDL_Renderer* renderer, size_t width, size_t height);
+
+    /**
+     * @brief Destructor - releases GL textures and program
+     */
+    ~GpuColormap();
+
+    /**
+     * @brief Replace the colormap
+     * @param palette 256 RGBA colors (ColorTransform::getPalette())
+     */
+    void setPalette(const std::array<uint32_t, 256>& palette);
+
+    /**
+     * @brief Reallocate the ring texture for a resized image
+     * @param width New ring width in columns
+     * @param height New ring height in rows
+     *
+     * The contents are undefined until the next upload() of a fully dirty
+     * image (SpectrogramImage::resample() marks it so).
+     */
+    void resize(size_t width, size_t height);
+
+    /**
+     * @brief Upload the image's dirty level columns into the ring texture
+     * @param image Image storing ImagePlane::Levels with this size
+     *
+     * Does not call image.clearDirty(); the caller does once per frame.
+     */
+    void upload(const SpectrogramImage& image);
+
+    /**
+     * @brief Draw the ring texture, oldest column at the left
+     * @param dst Destination rectangle in renderer coordinates
+     * @param seam Texture column of the oldest visible column (getTextureSeam())
+     * @param min_db Level shown as the first palette color
+     * @param max_db Level shown as the last palette color (must be > min_db)
+     *
+     * Flushes SDL's pending draw commands first so ordering is preserved.
+     */
+    void draw(const SDL_Rect& dst, size_t seam, float min_db, float max_db);
+
+    /**
+     * @brief Check if GPU colormapping is available
+     */
+    bool isValid() const { return initialized_; }
+
+    /**
+     * @brief Get the reason initialization failed
+     */
+    const std::string& getError() const { return error_; }
+
+private:
+    struct GL;  ///< Loaded OpenGL entry points (defined in the .cpp)
+
+    bool loadFunctions();
+    bool buildProgram();
+    void createTextures();
+    void setError(const std::string& message);
+
+    SDL_Renderer* renderer_;       ///< SDL renderer owning the GL context
+    size_t width_;                 ///< Ring texture columns
+    size_t height_;                ///< Ring texture rows
+    std::unique_ptr<GL> gl_;       ///< GL function table
+    uint32_t program_ = 0;         ///< Level → color shader program
+    uint32_t level_texture_ = 0;   ///< 16-bit ring texture [width × height]
+    uint32_t palette_texture_ = 0; ///< 256-entry RGBA 1D texture
+    int seam_location_ = -1;       ///< Uniform: seam as a texture coordinate
+    int level_map_location_ = -1;  ///< Uniform: level → palette coordinate (scale, offset)
+    std::string error_;            ///< Initialization error
+    bool initialized_ = false;     ///< Ready to draw
+
+    // Prevent copying (owns GL objects)
+    GpuColormap(const GpuColormap&) = delete;
+    GpuColormap& operator=(const GpuColormap&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_GPU_COLORMAP_HPP
@@ -0,0 +1,87 @@
+/**
+ * @file spectrum_panel.hpp
+ * @brief Batched drawing of the spectrum curve and octave band bars
+ *
+ * Each panel (background, dB grid, curve or bars, peaks) is built as one
+ * untextured triangle list and drawn with a single SDL_RenderGeometry
+ * call, so the draw-call count per frame does not depend on the number
+ * of rows, points or bands. Curves are reduced to at most one point per
+ * pixel column before triangulation.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_SPECTRUM_PANEL_HPP
+#define FRITURE_SPECTRUM_PANEL_HPP
+
+#include <friture/spectrum_views.hpp>
+#include <SDL2/SDL.h>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief Draws SpectrumViews into screen rectangles
+ *
+ * Levels map linearly from min_db (bottom) to max_db (top) and are
+ * clamped to the rectangle; frequency runs left to right in the row
+ * layout of the spectrogram (same scale as its vertical axis).
+ *
+ * Usage:
+ * @code
+ * SpectrumPanel panel(renderer);
+ * panel.drawSpectrum(area, views, settings.spec_min_db, settings.spec_max_db);
+ * @endcode
+ *
+ * Thread Safety: Not thread-safe. Use from the rendering thread only.
+ */
+class SpectrumPanel {
+public:
+    /// dB between grid lines
+    static constexpr float GRID_DB = 10.0f;
+
+    /**
+     * @brief Construct panel drawer
+     * @param renderer SDL renderer (must outlive the panel)
+     */
+    explicit SpectrumPanel(SDL_Renderer* renderer);
+
+    /**
+     * @brief Draw the latest spectrum as a line with its held peaks
+     * @return true if drawn (false if views are empty or the area is degenerate)
+     */
+    bool drawSpectrum(const SDL_Rect& area, const SpectrumViews& views, float min_db, float max_db);
+
+    /**
+     * @brief Draw band levels as bars with held peak ticks
+     * @return true if drawn (false if there are no bands or the area is degenerate)
+     */
+    bool drawBands(const SDL_Rect& area, const SpectrumViews& views, float min_db, float max_db);
+
+    /**
+     * @brief Get triangles submitted by the last draw call
+     */
+    size_t getLastTriangleCount() const { return last_triangles_; }
+
+private:
+    void beginPanel(const SDL_Rect& area, float min_db, float max_db);
+    void addRect(float x0, float y0, float x1, float y1, SDL_Color color);
+    void addPolyline(float width, SDL_Color color);
+    bool submit();
+
+    /**
+     * @brief Reduce rows to one point per pixel column (maximum) in points_
+     */
+    void buildCurve(const SDL_Rect& area, const std::vector<float>& db, float min_db, float max_db);
+
+    SDL_Renderer* renderer_;
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+    std::vector<SDL_FPoint> points_;
+    size_t last_triangles_ = 0;
+};
+
+} // namespace friture
+
+#endif // FRITURE_SPECTRUM_PANEL_HPP
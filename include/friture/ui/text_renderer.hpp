@@ -9,7 +9,11 @@
  * - Simple text rendering with SDL2_ttf
  * - Multiple font sizes
  * - Configurable colors
- * - Cached font handles for performance
+ * - One glyph atlas texture shared by all font sizes, each rasterized once
+ * - Cached label layouts; a label (and its shadow) is one
+ *   SDL_RenderGeometry call, with no per-frame TTF or texture work
+ * - Labels can be queued into a UiBatch with the rest of the overlay,
+ *   so a whole frame of UI is one call
  * - Fallback to system fonts if custom fonts unavailable
  *
  * @author Friture C++ Port
@@ -19,11 +23,14 @@
 #ifndef FRITURE_TEXT_RENDERER_HPP
 #define FRITURE_TEXT_RENDERER_HPP
 
+#include <friture/ui/ui_batch.hpp>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <array>
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace friture {
 
@@ -33,6 +40,13 @@ namespace friture {
  * This class manages TTF font loading and provides convenient methods
  * for rendering text to SDL surfaces and textures.
  *
+ * The printable ASCII range of each font size is rasterized once (white)
+ * into rows of one ATLAS_WIDTH x ATLAS_HEIGHT atlas texture, below a
+ * small opaque white cell. Text is drawn as textured quads colored per
+ * vertex, so color changes are free and all labels share one texture;
+ * the white cell lets a UiBatch draw plain shapes with the same texture.
+ * Other characters are drawn as '?'. Kerning is not applied.
+ *
  * Usage:
  * @code
  * TextRenderer text(renderer);
@@ -112,6 +126,41 @@ public:
     bool renderTextCentered(const std::string& text, int x, int y,
                            SDL_Color color, int font_size = 16);
 
+    /**
+     * @brief Start a batch bound to the glyph atlas
+     *
+     * Plain shapes of the batch sample the atlas's white cell, so they
+     * and queued text draw in one call.
+     */
+    void beginBatch(UiBatch& batch) const;
+
+    /**
+     * @brief Queue text into a batch started with beginBatch()
+     * @return false on error (also if the batch is bound to another texture)
+     *
+     * Same placement as renderText(); drawn by UiBatch::flush().
+     */
+    bool queueText(UiBatch& batch, const std::string& text, int x, int y,
+                   SDL_Color color, int font_size = 16);
+
+    /**
+     * @brief Queue text with its shadow (shadow first) into a batch
+     */
+    bool queueTextWithShadow(UiBatch& batch, const std::string& text, int x, int y,
+                             SDL_Color color, SDL_Color shadow_color,
+                             int font_size = 16, int shadow_offset = 1);
+
+    /**
+     * @brief Queue text centered on x into a batch
+     */
+    bool queueTextCentered(UiBatch& batch, const std::string& text, int x, int y,
+                           SDL_Color color, int font_size = 16);
+
+    /**
+     * @brief Glyph atlas texture (nullptr if not initialized)
+     */
+    SDL_Texture* getAtlasTexture() const { return atlas_texture_; }
+
     /**
      * @brief Get text dimensions without rendering
      * @param text Text string to measure
@@ -135,7 +184,104 @@ public:
      */
     bool isValid() const { return initialized_; }
 
+    /**
+     * @brief Number of font sizes in the atlas (one per font size used)
+     */
+    size_t getAtlasCount() const { return atlases_.size(); }
+
+    /**
+     * @brief Number of cached label layouts (all font sizes)
+     */
+    size_t getCachedLabelCount() const;
+
+    /// Label layouts kept per font size before that size's cache is dropped
+    static constexpr size_t MAX_CACHED_LABELS = 512;
+
+    /// Atlas texture size; glyph rows of each font size are added below
+    /// the previous ones (about 100 px per size at 16 pt)
+    static constexpr int ATLAS_WIDTH = 512;
+    static constexpr int ATLAS_HEIGHT = 1024;
+
 private:
+    static constexpr int FIRST_GLYPH = 32;    ///< ' '
+    static constexpr int LAST_GLYPH = 126;    ///< '~'
+    static constexpr int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+    static constexpr int WHITE_CELL = 4;      ///< Opaque square at the atlas origin
+
+    /**
+     * @brief One glyph cell in an atlas
+     */
+    struct Glyph {
+        SDL_Rect src;   ///< Cell in the atlas texture (w == 0: no ink)
+        int advance;    ///< Pen advance in pixels
+    };
+
+    /**
+     * @brief Glyph quad of a laid out label
+     */
+    struct PlacedGlyph {
+        int x;          ///< Offset from the label origin
+        SDL_Rect src;   ///< Cell in the atlas texture
+    };
+
+    /**
+     * @brief Label text laid out once, drawn many times
+     */
+    struct LabelLayout {
+        std::vector<PlacedGlyph> glyphs;
+        int width = 0;
+        int height = 0;
+    };
+
+    /**
+     * @brief Glyph cells and label cache of one font size
+     */
+    struct GlyphAtlas {
+        int line_height = 0;    ///< TTF_FontHeight
+        std::array<Glyph, GLYPH_COUNT> glyphs{};
+        std::unordered_map<std::string, LabelLayout> labels;
+    };
+
+    /**
+     * @brief Get (or build) the glyph cells for a font size
+     * @return Atlas, or nullptr on error
+     */
+    GlyphAtlas* getAtlas(int font_size);
+
+    /**
+     * @brief Create the atlas texture with its white cell
+     */
+    bool createAtlasTexture();
+
+    /**
+     * @brief Rasterize the glyph range of a font into the next atlas rows
+     * @return false on error or if the atlas texture is full
+     */
+    bool buildAtlas(TTF_Font* font, GlyphAtlas& atlas);
+
+    /**
+     * @brief Get (or lay out) a label
+     * @return Layout, or nullptr on error or empty text
+     */
+    const LabelLayout* getLabel(const std::string& text, int font_size,
+                                const GlyphAtlas** atlas);
+
+    /**
+     * @brief Draw a laid out label, optionally with its shadow, in one batch
+     */
+    bool drawLabel(const LabelLayout& label, int x, int y,
+                   SDL_Color color, const SDL_Color* shadow_color, int shadow_offset);
+
+    /**
+     * @brief Append one label's quads to a batch bound to the atlas
+     */
+    void appendQuads(UiBatch& batch, const LabelLayout& label, int x, int y, SDL_Color color) const;
+
+    /**
+     * @brief Check that a batch is bound to the atlas texture
+     */
+    bool checkBatch(const UiBatch& batch);
+
     /**
      * @brief Initialize SDL_ttf library
      * @return true on success, false on failure
@@ -168,19 +314,13 @@ private:
      */
     void setError(const std::string& message);
 
-    /**
-     * @brief Render text to surface
-     * @param text Text to render
-     * @param font Font to use
-     * @param color Text color
-     * @return SDL_Surface with rendered text, or nullptr on error
-     */
-    SDL_Surface* renderTextToSurface(const std::string& text,
-                                    TTF_Font* font, SDL_Color color);
-
     SDL_Renderer* renderer_;                ///< SDL renderer
     std::string font_path_;                  ///< Path to font file
     std::unordered_map<int, TTF_Font*> fonts_; ///< Cached fonts by size
+    std::unordered_map<int, GlyphAtlas> atlases_; ///< Glyph cells by size
+    SDL_Texture* atlas_texture_;             ///< Glyph rows of every size
+    int atlas_used_height_;                  ///< First free atlas row
+    UiBatch batch_;                          ///< Single-label draws
     std::string error_;                      ///< Last error message
     bool initialized_;                       ///< Initialization status
 
@@ -0,0 +1,143 @@
+/**
+ * @file ui_batch.hpp
+ * @brief Immediate-mode batching of UI rectangles, lines and glyphs
+ *
+ * The overlay is queued as colored quads (and glyph quads from the text
+ * atlas) into one vertex list per frame and submitted with a single
+ * SDL_RenderGeometry call, so its cost stays the same as ticks, grids,
+ * cursors and labels are added.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_UI_BATCH_HPP
+#define FRITURE_UI_BATCH_HPP
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace friture {
+
+/**
+ * @brief Collects UI quads and draws them in one call
+ *
+ * Shapes are drawn in the order they were queued (later ones on top),
+ * exactly as the equivalent sequence of SDL_RenderFillRect /
+ * SDL_RenderDrawRect / SDL_RenderDrawLine and text calls would, but
+ * without a draw call and a color state change each.
+ *
+ * One texture can be bound per batch. Untextured shapes then sample an
+ * opaque white texel of it (white_uv), so they and the textured quads
+ * share the call; TextRenderer::beginBatch() sets up its glyph atlas this
+ * way. Without a texture only untextured shapes can be queued.
+ *
+ * Vertex and index storage is kept between frames; a frame allocates
+ * only when it draws more than any frame before.
+ *
+ * Usage:
+ * @code
+ * UiBatch batch(renderer);
+ * text.beginBatch(batch);
+ * batch.fillRect({0, 690, 1280, 30}, {0, 0, 0, 200});
+ * text.queueText(batch, "FPS: 60", 10, 695, {0, 255, 0, 255});
+ * batch.flush();   // One SDL_RenderGeometry
+ * @endcode
+ *
+ * Thread Safety: Not thread-safe. Use from the rendering thread only.
+ */
+class UiBatch {
+public:
+    /**
+     * @brief Construct batch
+     * @param renderer SDL renderer (must outlive the batch)
+     */
+    explicit UiBatch(SDL_Renderer* renderer);
+
+    /**
+     * @brief Drop anything queued and start a new batch
+     * @param texture Texture of the textured quads, or nullptr
+     * @param white_uv Texture coordinate of an opaque white texel of
+     *        texture (ignored without a texture)
+     */
+    void begin(SDL_Texture* texture = nullptr, SDL_FPoint white_uv = {0.0f, 0.0f});
+
+    /**
+     * @brief Queue a filled rectangle (as SDL_RenderFillRect)
+     */
+    void fillRect(const SDL_Rect& rect, SDL_Color color);
+
+    /**
+     * @brief Queue a one pixel outline inside rect (as SDL_RenderDrawRect)
+     */
+    void drawRect(const SDL_Rect& rect, SDL_Color color);
+
+    /**
+     * @brief Queue a one pixel line, both end points included (as SDL_RenderDrawLine)
+     *
+     * Horizontal and vertical lines cover exactly their pixels; other
+     * lines are a one pixel wide quad between the pixel centers.
+     */
+    void drawLine(int x0, int y0, int x1, int y1, SDL_Color color);
+
+    /**
+     * @brief Queue a textured quad
+     * @param x0,y0,x1,y1 Screen rectangle
+     * @param u0,v0,u1,v1 Normalized texture rectangle of the bound texture
+     * @param color Vertex color (modulates the texture)
+     */
+    void addTexturedQuad(float x0, float y0, float x1, float y1,
+                         float u0, float v0, float u1, float v1, SDL_Color color);
+
+    /**
+     * @brief Draw everything queued since begin() with one SDL_RenderGeometry
+     * @return true if drawn (or nothing was queued)
+     *
+     * Empties the batch and keeps the texture, so more shapes can follow.
+     * Untextured batches are blended (SDL_BLENDMODE_BLEND) like the
+     * textured ones, and the renderer's blend mode is restored afterwards.
+     */
+    bool flush();
+
+    /**
+     * @brief Texture bound by begin()
+     */
+    SDL_Texture* getTexture() const { return texture_; }
+
+    /**
+     * @brief Quads queued since begin() or the last flush()
+     */
+    size_t getQuadCount() const { return indices_.size() / 6; }
+
+    /**
+     * @brief Quads drawn by the last flush()
+     */
+    size_t getLastQuadCount() const { return last_quads_; }
+
+    /**
+     * @brief SDL_RenderGeometry calls made so far
+     */
+    uint64_t getDrawCallCount() const { return draw_calls_; }
+
+private:
+    void addQuad(float x0, float y0, float x1, float y1, SDL_Color color);
+
+    /**
+     * @brief Append the indices of the two triangles of the last 4 vertices
+     */
+    void closeQuad();
+
+    SDL_Renderer* renderer_;
+    SDL_Texture* texture_ = nullptr;
+    SDL_FPoint white_uv_ = {0.0f, 0.0f};
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+    size_t last_quads_ = 0;
+    uint64_t draw_calls_ = 0;
+};
+
+} // namespace friture
+
+#endif // FRITURE_UI_BATCH_HPP
@@ -0,0 +1,79 @@
+/**
+ * @file window_functions.hpp
+ * @brief Shared, immutable window coefficient tables
+ *
+ * Window coefficients depend only on the window, its size and (for
+ * Kaiser) β. Each table is computed once per process and handed out as a
+ * shared read-only array, so every FFTProcessor, per-channel lane, worker
+ * thread and analyzer using the same window shares one copy, and switching
+ * back to a window seen before evaluates no cos() or Bessel terms.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_WINDOW_FUNCTIONS_HPP
+#define FRITURE_WINDOW_FUNCTIONS_HPP
+
+#include <friture/types.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace friture {
+
+/// 4-term Blackman-Harris coefficients a0..a3 (alternating signs)
+inline constexpr double BLACKMAN_HARRIS_COEFFICIENTS[4] = {0.35875, 0.48829, 0.14128, 0.01168};
+
+/// 5-term flat-top coefficients a0..a4 (alternating signs)
+inline constexpr double FLAT_TOP_COEFFICIENTS[5] = {0.21557895, 0.41663158, 0.277263158,
+                                                   0.083578947, 0.006947368};
+
+/**
+ * @brief One cached window: coefficients and their coherent gain
+ */
+struct WindowTable {
+    std::shared_ptr<const float[]> coefficients;  ///< size values, symmetric (on N - 1)
+    float coherent_gain = 1.0f;                   ///< Mean coefficient, Σw / N
+
+    /**
+     * @brief Coefficient pointer for the window kernels
+     */
+    const float* data() const { return coefficients.get(); }
+};
+
+/**
+ * @brief Get the shared table of a window
+ * @param type Window function
+ * @param size Number of coefficients (> 1)
+ * @param kaiser_beta Kaiser β; ignored (and not part of the cache key)
+ *        for the other windows
+ * @return Table shared with every other caller asking for the same window
+ * @throws std::invalid_argument if size < 2, kaiser_beta is outside
+ *         [0, MAX_KAISER_BETA] or type is unknown
+ *
+ * Windows are symmetric (denominator N - 1), as FFTProcessor always used:
+ * - Hann: 0.5 - 0.5 cos(2πn/(N-1))
+ * - Hamming: 0.54 - 0.46 cos(2πn/(N-1))
+ * - Blackman-Harris, flat-top: Σ (-1)^k a_k cos(2πkn/(N-1)), with kn
+ *   reduced modulo N - 1 before the cosine
+ * - Kaiser: I0(β √(1 - (2n/(N-1) - 1)²)) / I0(β)
+ *
+ * A bin-centred sine of amplitude A has a transform peak of A·N·gain/2,
+ * so dividing the power by (N·coherent_gain)² reads the same level for
+ * every window. Tables live for the process lifetime; any thread may call this.
+ */
+WindowTable windowTable(WindowFunction type, size_t size, float kaiser_beta = DEFAULT_KAISER_BETA);
+
+/**
+ * @brief Modified Bessel function of the first kind, order 0
+ * @param x Argument (power series, summed to 1e-17 relative)
+ * @return I0(x)
+ *
+ * Shared by the Kaiser window and the Kaiser-windowed filter designs
+ * (ZoomAnalyzer's half-band, SampleRateConverter's polyphase bank).
+ */
+double besselI0(double x);
+
+} // namespace friture
+
+#endif // FRITURE_WINDOW_FUNCTIONS_HPP
@@ -0,0 +1,238 @@
+/**
+ * @file zoom_analyzer.hpp
+ * @brief Zoom FFT: fine resolution inside a narrow displayed band
+ *
+ * With min_freq/max_freq set to something like 40-400 Hz, the chain's FFT
+ * still transforms the whole band and even 16384 points only give 2.9 Hz
+ * bins at 48 kHz. ZoomAnalyzer shifts the band centre to 0 Hz, decimates
+ * the now complex signal through a cascade of half-band filters, and runs
+ * a complex FFT of the chain's size at the reduced rate, so the displayed
+ * band gets bins D times narrower for roughly the cost of the base FFT.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#ifndef FRITURE_ZOOM_ANALYZER_HPP
+#define FRITURE_ZOOM_ANALYZER_HPP
+
+#include <friture/types.hpp>
+#include <friture/fft_processor.hpp>
+#include <friture/frequency_resampler.hpp>
+#include <friture/processing_chain.hpp>
+#include <fftw3.h>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace friture {
+
+/**
+ * @brief Heterodyne + half-band decimation + complex FFT for one band
+ *
+ * Stages, per input sample x[n] at the sample rate fs:
+ * 1. Mix: x[n]·e^{-j2π·fc·n/fs}, with fc the band centre rounded to the
+ *    output bin grid.
+ * 2. Decimate: log2(D) half-band stages, each a HALF_BAND_TAPS Kaiser
+ *    lowpass at a quarter of its input rate followed by dropping every
+ *    other sample. Only the even-indexed taps and the centre are nonzero,
+ *    so each output is one contiguous simd::dotProduct() over the
+ *    even-phase samples plus the centre sample.
+ * 3. Transform: the newest N = key.fft_size decimated samples, windowed
+ *    like FFTProcessor, through a complex FFT at fs / D.
+ *
+ * Every stage passes ±PASSBAND of its output rate without aliasing, so
+ * D is the largest power of two whose usable band, 2·PASSBAND·fs / D,
+ * still holds min_freq..max_freq (see decimationFor()).
+ *
+ * Display mapping: the N zoom bins are exactly bins m..m+N-1 of a real
+ * D·N-point FFT at fs (spacing fs / (D·N)), so they are written into a
+ * virtual spectrum of that size (all other bins at the floor) and mapped
+ * by an ordinary FrequencyResampler built for D·N points. Scale, range and
+ * aggregation behave as in every other chain. For bands near 0 Hz, m is
+ * negative: those bins lie below 0 Hz, hold only the mirror images of
+ * real tones and are dropped. Tone levels match
+ * FFTProcessor: the mixer halves the amplitude the real FFT splits
+ * between ±f, and the power is normalized by (N · coherent gain)² the same
+ * way.
+ *
+ * Streaming: analyze() receives the chain's full window every column,
+ * like MultiResolutionAnalyzer, but when it continues the previous window
+ * by one hop (checked on the hop before the newest one) only the newest
+ * hop is mixed and decimated. Any gap (dropped columns, seek, chain
+ * switch) resets the filters and runs the whole window again. With a hop
+ * that is a multiple of D both paths decimate on the same sample grid.
+ *
+ * Cost per column: ~2·(HALF_BAND_TAPS / 2 + 2) flops per hop sample for
+ * the cascade plus one N-point complex FFT, against a D·N-point real FFT
+ * for the same resolution.
+ *
+ * Thread Safety: Not thread-safe; owned by one ProcessingChain.
+ *
+ * Example:
+ * @code
+ * if (ZoomAnalyzer::decimationFor(key) >= 2) {
+ *     ZoomAnalyzer zoom(key);
+ *     std::vector<float> window(zoom.getWindowSize());
+ *     ring.readWindow(cursor, window.data(), window.size(), hop);
+ *     zoom.analyze(window.data());
+ *     zoom.resample(column_db.data());
+ * }
+ * @endcode
+ */
+class ZoomAnalyzer {
+public:
+    static constexpr size_t HALF_BAND_TAPS = 51;       ///< Half-band filter length (about 80 dB stopband)
+    static constexpr double PASSBAND = 0.4;            ///< Alias-free band, ± fraction of a stage's output rate
+    static constexpr size_t MAX_DECIMATION = 256;      ///< Largest decimation factor D
+    static constexpr size_t MAX_SPAN = 262144;         ///< Largest D × fft_size (samples per frame)
+    static constexpr size_t CHUNK = 1024;              ///< Input samples mixed per internal step
+
+    /**
+     * @brief Construct analyzer
+     * @param key Chain configuration (range, rate, scale, height, window, fft_size)
+     * @throws std::invalid_argument if the key is invalid or decimationFor(key) < 2
+     * @throws std::runtime_error if FFTW initialization fails
+     *
+     * Plans a complex FFT; must not race other FFT planning.
+     */
+    explicit ZoomAnalyzer(const ChainKey& key);
+
+    ~ZoomAnalyzer();
+
+    /**
+     * @brief Largest useful decimation factor for a key
+     * @param key Chain configuration
+     * @return Power of two D (1 if the band is too wide to zoom)
+     *
+     * D is limited by MAX_DECIMATION, by MAX_SPAN / key.fft_size, and by
+     * the band: min_freq..max_freq must fit in ±PASSBAND · fs / D around
+     * its centre, rounded to the D·N-point bin grid.
+     */
+    static size_t decimationFor(const ChainKey& key);
+
+    /**
+     * @brief Get decimation factor D
+     */
+    size_t getDecimation() const { return decimation_; }
+
+    /**
+     * @brief Get mixing frequency in Hz (band centre on the bin grid)
+     */
+    double getCenterFrequency() const { return center_freq_; }
+
+    /**
+     * @brief Get spacing of the zoom bins in Hz (fs / (D · fft_size))
+     */
+    double getBinSpacing() const { return bin_spacing_; }
+
+    /**
+     * @brief Get bin of the virtual D·N-point spectrum that holds the lowest zoom bin
+     *
+     * Negative when the zoomed band reaches below 0 Hz.
+     */
+    int64_t getFirstBin() const { return first_bin_; }
+
+    /**
+     * @brief Get input samples needed per column
+     *
+     * Enough for fft_size decimated samples after every stage's filter
+     * has filled (about D × (fft_size + HALF_BAND_TAPS)).
+     */
+    size_t getWindowSize() const { return window_size_; }
+
+    /**
+     * @brief Get number of full-window restarts so far
+     */
+    uint64_t getReseedCount() const { return reseeds_; }
+
+    /**
+     * @brief Advance to the window of this column and transform it
+     * @param window getWindowSize() input samples, oldest first
+     */
+    void analyze(const float* window);
+
+    /**
+     * @brief Map the last spectrum to the display rows
+     * @param column_db Output column (key.height rows, in dB)
+     */
+    void resample(float* column_db) const;
+
+    /**
+     * @brief Get the virtual D·N-point dB spectrum of the last analyze()
+     */
+    const std::vector<float>& getSpectrum() const { return spectrum_; }
+
+    /**
+     * @brief Get the display mapping (built for D · fft_size points)
+     */
+    const FrequencyResampler& resampler() const { return *resampler_; }
+
+    /**
+     * @brief Forget the previous window (next analyze() reseeds)
+     */
+    void reset();
+
+private:
+    /**
+     * @brief One decimate-by-2 stage, split into even and odd input phases
+     *
+     * Output j reads even-phase samples [j, j + EVEN_TAPS) and odd-phase
+     * sample j + CENTER_OFFSET.
+     */
+    struct Stage {
+        std::vector<float> even_re, even_im;   ///< Pending even-index inputs
+        std::vector<float> odd_re, odd_im;     ///< Pending odd-index inputs
+        size_t even_size = 0;                  ///< Valid even samples
+        size_t odd_size = 0;                   ///< Valid odd samples
+        bool next_odd = false;                 ///< Parity of the next input
+    };
+
+    void restart();
+    void push(const float* input, size_t count);
+    size_t pushStage(Stage& stage, const float* in_re, const float* in_im, size_t count,
+                     float* out_re, float* out_im);
+    void transform();
+
+    size_t fft_size_;                  ///< Complex FFT size N
+    size_t hop_size_;                  ///< Samples per column
+    size_t decimation_;                ///< D
+    size_t window_size_;               ///< Input samples per column
+    int64_t first_bin_;                ///< Virtual bin of the lowest zoom bin (m)
+    double center_freq_;               ///< fc in Hz
+    double bin_spacing_;               ///< fs / (D·N)
+
+    std::vector<float> taps_;          ///< Even-phase half-band taps [HALF_BAND_TAPS / 2 + 1]
+    std::vector<Stage> stages_;        ///< log2(D) stages
+    double step_re_, step_im_;         ///< e^{-j2π·fc/fs}
+    double phasor_re_ = 1.0;           ///< Mixer phase, real part
+    double phasor_im_ = 0.0;           ///< Mixer phase, imaginary part
+
+    std::vector<float> mix_re_, mix_im_;        ///< Mixed chunk, decimated in place [CHUNK]
+
+    std::vector<float> ring_re_, ring_im_;      ///< Newest N decimated samples (circular)
+    size_t ring_pos_ = 0;                       ///< Next ring write
+
+    WindowTable window_;                        ///< FFT window [N] (shared table)
+    float power_scale_ = 0.0f;                  ///< 1 / (N · coherent gain)², as FFTProcessor
+    fftwf_complex* fft_in_ = nullptr;           ///< FFTW input [N]
+    fftwf_complex* fft_out_ = nullptr;          ///< FFTW output [N]
+    fftwf_plan plan_ = nullptr;                 ///< Complex forward plan
+
+    std::vector<float> zoom_db_;                ///< Zoom bins in dB, lowest frequency first [N]
+    std::vector<float> spectrum_;               ///< Virtual spectrum in dB [D·N/2 + 1]
+    std::unique_ptr<FrequencyResampler> resampler_;
+
+    std::vector<float> previous_hop_;           ///< Newest hop of the previous window
+    bool primed_ = false;                       ///< previous_hop_ is valid
+    uint64_t reseeds_ = 0;                      ///< Reseed count
+
+    // Prevent copying (FFT plan)
+    ZoomAnalyzer(const ZoomAnalyzer&) = delete;
+    ZoomAnalyzer& operator=(const ZoomAnalyzer&) = delete;
+};
+
+} // namespace friture
+
+#endif // FRITURE_ZOOM_ANALYZER_HPP
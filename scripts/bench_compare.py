@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""
+Compare two friture_bench JSON result files and flag regressions
+
+Matches benchmarks by name and compares CPU time per iteration. When the
+runs used --benchmark_repetitions, the median aggregate is compared
+instead of individual repetitions. Exits with status 1 if any benchmark
+got slower than its threshold allows, so it can gate a release build.
+
+Usage:
+    friture_bench --benchmark_out=baseline.json --benchmark_out_format=json
+    # ... change code, rebuild ...
+    friture_bench --benchmark_out=current.json --benchmark_out_format=json
+    python3 scripts/bench_compare.py baseline.json current.json --threshold 10
+
+    # Looser limit for noisy cases (regex on the benchmark name, percent)
+    python3 scripts/bench_compare.py baseline.json current.json \\
+        --case 'BM_TextureUpload.*=25' --case 'BM_WavDecode.*=20'
+"""
+
+import argparse
+import json
+import re
+import sys
+
+TIME_UNITS = {'ns': 1e-9, 'us': 1e-6, 'ms': 1e-3, 's': 1.0}
+
+
+def load_times(path):
+    """Return {benchmark name: CPU seconds per iteration}."""
+    with open(path) as f:
+        data = json.load(f)
+
+    times = {}
+    medians = {}
+    for bench in data.get('benchmarks', []):
+        if bench.get('error_occurred'):
+            continue
+        seconds = bench['cpu_time'] * TIME_UNITS[bench.get('time_unit', 'ns')]
+        if bench.get('run_type') == 'aggregate':
+            if bench.get('aggregate_name') == 'median':
+                medians[bench['run_name']] = seconds
+        else:
+            times.setdefault(bench['run_name'], seconds)
+
+    times.update(medians)
+    return times
+
+
+def parse_cases(specs):
+    """Parse 'REGEX=PERCENT' overrides."""
+    cases = []
+    for spec in specs:
+        pattern, sep, percent = spec.rpartition('=')
+        if not sep:
+            raise ValueError("--case expects REGEX=PERCENT, got '%s'" % spec)
+        cases.append((re.compile(pattern), float(percent)))
+    return cases
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Flag friture_bench regressions')
+    parser.add_argument('baseline', help='JSON output of the reference run')
+    parser.add_argument('current', help='JSON output of the run under test')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='Allowed slowdown in percent (default 10)')
+    parser.add_argument('--case', action='append', default=[],
+                        help='Per-benchmark threshold REGEX=PERCENT (first match wins)')
+    args = parser.parse_args()
+
+    try:
+        cases = parse_cases(args.case)
+        baseline = load_times(args.baseline)
+        current = load_times(args.current)
+    except (OSError, ValueError, KeyError) as e:
+        print('Error: %s' % e, file=sys.stderr)
+        return 2
+
+    regressions = 0
+    print('%-60s %12s %12s %9s' % ('Benchmark', 'Baseline', 'Current', 'Change'))
+    for name in sorted(baseline):
+        if name not in current:
+            print('%-60s %12s' % (name, 'missing'))
+            continue
+
+        limit = args.threshold
+        for pattern, percent in cases:
+            if pattern.search(name):
+                limit = percent
+                break
+
+        before = baseline[name]
+        after = current[name]
+        change = (after / before - 1.0) * 100.0 if before > 0 else 0.0
+        flag = ''
+        if change > limit:
+            flag = '  REGRESSION (> %g%%)' % limit
+            regressions += 1
+
+        print('%-60s %10.3fus %10.3fus %+8.1f%%%s' %
+              (name, before * 1e6, after * 1e6, change, flag))
+
+    for name in sorted(set(current) - set(baseline)):
+        print('%-60s %12s' % (name, 'new'))
+
+    if regressions:
+        print('\n%d benchmark(s) regressed' % regressions)
+        return 1
+    print('\nNo regressions')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
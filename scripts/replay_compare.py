@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Compare two friture-replay runs for accuracy and throughput
+
+Both runs must replay the same input with the same settings. Equal hashes
+mean bit-identical columns; otherwise, when both runs wrote --columns, the
+dB columns are diffed and the largest difference is checked against a
+tolerance. Throughput (columns per second) is checked against a slowdown
+threshold, and the per-stage mean times are listed next to each other.
+Exits with status 1 if the output drifted or the run got slower than
+allowed, so it can gate a change in CI.
+
+Usage:
+    friture-replay in.wav --columns base.cols --json base.json --repeat 5
+    # ... change code, rebuild ...
+    friture-replay in.wav --columns new.cols --json new.json --repeat 5
+    python3 scripts/replay_compare.py base.json new.json --tolerance 0.01 --threshold 10
+"""
+
+import argparse
+import array
+import json
+import math
+import os
+import struct
+import sys
+
+COLUMN_MAGIC = b'FRREPLAY'
+COLUMN_VERSION = 1
+
+
+def load_run(path):
+    """Return the JSON statistics of one run."""
+    with open(path) as f:
+        return json.load(f)
+
+
+def columns_path(run, json_path):
+    """Column file of a run, looked up next to its JSON if not found as given."""
+    path = run.get('columns_file')
+    if not path:
+        return None
+    if not os.path.exists(path) and not os.path.isabs(path):
+        candidate = os.path.join(os.path.dirname(json_path), os.path.basename(path))
+        if os.path.exists(candidate):
+            return candidate
+    return path
+
+
+def read_columns(path):
+    """Yield (window_end, column) from a --columns file."""
+    with open(path, 'rb') as f:
+        header = f.read(16)
+        if len(header) == 0:
+            return   # No column was emitted
+        if len(header) < 16 or header[:8] != COLUMN_MAGIC:
+            raise ValueError('%s is not a friture-replay column file' % path)
+        version, rows = struct.unpack('<II', header[8:])
+        if version != COLUMN_VERSION:
+            raise ValueError('%s: unsupported column file version %d' % (path, version))
+        size = 8 + 4 * rows
+        while True:
+            record = f.read(size)
+            if not record:
+                return
+            if len(record) < size:
+                raise ValueError('%s: truncated column' % path)
+            column = array.array('f')
+            column.frombytes(record[8:])
+            if sys.byteorder == 'big':
+                column.byteswap()
+            yield struct.unpack('<Q', record[:8])[0], column
+
+
+def diff_columns(baseline_path, current_path):
+    """Return (columns, max abs dB difference, RMS difference, worst column)."""
+    count = 0
+    max_diff = 0.0
+    worst = None
+    square_sum = 0.0
+    values = 0
+    baseline = read_columns(baseline_path)
+    current = read_columns(current_path)
+    for before, after in zip(baseline, current):
+        if before[0] != after[0] or len(before[1]) != len(after[1]):
+            raise ValueError('column %d: different window position or height' % count)
+        for a, b in zip(before[1], after[1]):
+            if a == b:
+                diff = 0.0
+            elif math.isfinite(a) and math.isfinite(b):
+                diff = abs(a - b)
+            else:
+                diff = math.inf
+            if diff > max_diff:
+                max_diff = diff
+                worst = count
+            square_sum += diff * diff
+            values += 1
+        count += 1
+    if next(baseline, None) is not None or next(current, None) is not None:
+        raise ValueError('runs emitted different numbers of columns')
+    rms = math.sqrt(square_sum / values) if values else 0.0
+    return count, max_diff, rms, worst
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare two friture-replay runs')
+    parser.add_argument('baseline', help='--json output of the reference run')
+    parser.add_argument('current', help='--json output of the run under test')
+    parser.add_argument('--tolerance', type=float, default=0.01,
+                        help='Allowed largest column difference in dB (default 0.01)')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='Allowed throughput loss in percent (default 10)')
+    parser.add_argument('--accuracy-only', action='store_true',
+                        help='Do not fail on throughput (e.g. runs from different machines)')
+    args = parser.parse_args()
+
+    try:
+        baseline = load_run(args.baseline)
+        current = load_run(args.current)
+    except (OSError, ValueError) as e:
+        print('Error: %s' % e, file=sys.stderr)
+        return 2
+
+    failures = 0
+    for key in ('sample_rate', 'hop_size', 'rows', 'hops', 'columns'):
+        if baseline.get(key) != current.get(key):
+            print('Runs differ in %s: %s vs %s' % (key, baseline.get(key), current.get(key)))
+            failures += 1
+    if failures:
+        print('\nNot the same replay (input or settings differ)')
+        return 1
+
+    # Accuracy
+    print('Columns: %d x %d rows' % (current['columns'], current['rows']))
+    if baseline['hash'] == current['hash']:
+        print('Hash:    %s (bit-identical)' % current['hash'])
+    else:
+        print('Hash:    %s -> %s' % (baseline['hash'], current['hash']))
+        base_path = columns_path(baseline, args.baseline)
+        current_path = columns_path(current, args.current)
+        if not base_path or not current_path:
+            print('Output changed; replay with --columns to measure by how much')
+            failures += 1
+        else:
+            try:
+                count, max_diff, rms, worst = diff_columns(base_path, current_path)
+            except (OSError, ValueError) as e:
+                print('Error: %s' % e, file=sys.stderr)
+                return 2
+            flag = ''
+            if max_diff > args.tolerance:
+                flag = '  DRIFT (> %g dB)' % args.tolerance
+                failures += 1
+            print('Diff:    max %.6f dB (column %s), RMS %.6f dB over %d columns%s' %
+                  (max_diff, worst, rms, count, flag))
+
+    if baseline.get('peak_events') != current.get('peak_events'):
+        print('Peak events: %s -> %s' % (baseline.get('peak_events'), current.get('peak_events')))
+
+    # Throughput
+    before = baseline['columns_per_second']
+    after = current['columns_per_second']
+    loss = (1.0 - after / before) * 100.0 if before > 0 else 0.0
+    flag = ''
+    if loss > args.threshold and not args.accuracy_only:
+        flag = '  REGRESSION (> %g%%)' % args.threshold
+        failures += 1
+    print('\n%-12s %14s %14s %9s' % ('', 'Baseline', 'Current', 'Change'))
+    print('%-12s %12.0f/s %12.0f/s %+8.1f%%%s' % ('Throughput', before, after,
+                                                (after / before - 1.0) * 100.0 if before > 0 else 0.0,
+                                                flag))
+    for stage in sorted(set(baseline.get('stages', {})) & set(current.get('stages', {}))):
+        mean_before = baseline['stages'][stage]['mean_us']
+        mean_after = current['stages'][stage]['mean_us']
+        change = (mean_after / mean_before - 1.0) * 100.0 if mean_before > 0 else 0.0
+        print('%-12s %12.3fus %12.3fus %+8.1f%%' % (stage, mean_before, mean_after, change))
+
+    if failures:
+        print('\n%d check(s) failed' % failures)
+        return 1
+    print('\nNo regressions')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -4,116 +4,205 @@
  */
 
 #include <friture/application.hpp>
-#include <friture/audio/audio_file_loader.hpp>
+#include <friture/audio/wav_reader.hpp>
+#include <friture/realtime_check.hpp>
+#include <friture/sample_rate_converter.hpp>
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <filesystem>
 #include <iomanip>
 
 namespace friture {
 
+namespace {
+
+// Seconds of file mode audio decoded ahead of playback
+constexpr float FILE_STREAM_SECONDS = 10.0f;
+
+// Display refresh the frame budget and reduced redraw rates refer to
+constexpr std::chrono::microseconds REFRESH_PERIOD(16666);
+
+// Redraw without new columns (level meter, FPS and profiler text) while running
+constexpr std::chrono::milliseconds IDLE_REDRAW_PERIOD(250);
+
+// Longest sleep of the render loop while paused; events wake it earlier
+constexpr std::chrono::milliseconds PAUSED_WAIT_PERIOD(1000);
+
+// Analysis thread poll period while there is nothing to analyze
+constexpr std::chrono::milliseconds ANALYSIS_IDLE_PERIOD(10);
+
+// Share of the window height used by the spectrogram
+constexpr float SPECTROGRAM_HEIGHT_FRACTION = 0.6f;
+
+// Quiet time after the last resize event before the image is rescaled,
+// so dragging a window edge does not rescale on every step
+constexpr std::chrono::milliseconds RESIZE_SETTLE_PERIOD(100);
+
+// Longest wait after the first frame for background FFT planning before
+// the neighbour chains are built anyway (planning under the lock)
+constexpr std::chrono::seconds PREWARM_PLANNING_WAIT(10);
+
+// Peak events waiting for the render thread to log them
+constexpr size_t PEAK_EVENT_QUEUE_CAPACITY = 1024;
+
+// File samples at the analysis rate: each block reads the input span its
+// outputs need (silence outside the file) and converts it
+FileStreamer::Source convertedSource(WavReader* reader,
+                                     std::shared_ptr<SampleRateConverter> converter) {
+    auto span = std::make_shared<std::vector<float>>();
+    const uint64_t length = converter->getOutputLength(reader->getFrameCount());
+    return [reader, converter, span, length](uint64_t position, float* output, size_t count) {
+        if (position >= length) {
+            return size_t{0};
+        }
+        count = static_cast<size_t>(std::min<uint64_t>(count, length - position));
+
+        const int64_t first = converter->getFirstInput(position);
+        const size_t skip = first < 0 ? static_cast<size_t>(-first) : 0;
+        span->assign(converter->getInputSpan(count), 0.0f);
+        if (skip < span->size()) {
+            const uint64_t begin = static_cast<uint64_t>(first + static_cast<int64_t>(skip));
+            reader->readMono(begin, span->data() + skip, span->size() - skip);
+            reader->releaseBefore(begin);
+        }
+        converter->convert(span->data(), first, position, count, output);
+        return count;
+    };
+}
+
+} // namespace
+
 // ============================================================================
 // Constructor / Destructor
 // ============================================================================
 
-FritureApp::FritureApp(int window_width, int window_height)
+FritureApp::FritureApp(int window_width, int window_height, bool gpu_colormap)
     : settings_(),
       running_(false),
       paused_(false),
       show_help_(false),
+      show_profiler_(false),
       input_mode_(InputMode::File),
       window_(nullptr),
       renderer_(nullptr),
       texture_(nullptr),
+      use_gpu_colormap_(gpu_colormap),
       window_width_(window_width),
       window_height_(window_height),
       current_audio_position_(0),
       total_audio_samples_(0),
       current_device_index_(0),
+      ring_seconds_(DEFAULT_RING_SECONDS),
+      stream_options_pending_(false),
+      history_texture_(nullptr),
+      history_view_(false),
+      history_dirty_(false),
+      history_end_(0),
+      history_span_(0),
+      history_level_(0),
+      record_segment_(1),
+      analysis_running_(false),
+      live_samples_lost_(0),
+      dropped_columns_(0),
+      chain_pending_(false),
+      peak_detection_(false),
+      peak_events_(PEAK_EVENT_QUEUE_CAPACITY),
+      dropped_peak_events_(0),
+      reported_peak_drops_(0),
+      capture_enabled_(false),
+      reported_captures_(0),
       fps_(0.0f),
-      frame_count_(0)
+      frame_count_(0),
+      redraw_requested_(true),
+      resize_pending_(false),
+      column_ready_event_(static_cast<Uint32>(-1)),
+      column_wake_pending_(false),
+      startup_begin_(std::chrono::steady_clock::now()),
+      startup_mark_(startup_begin_),
+      startup_trace_(false),
+      startup_done_(false),
+      labels_shown_(false),
+      chains_prewarmed_(false),
+      planning_recorded_(false),
+      run_duration_(0.0)
 {
     std::cout << "=== Friture C++ Spectrogram Viewer ===" << std::endl;
     std::cout << "Initializing application..." << std::endl;
 
-    // Initialize SDL
+    // Device enumeration can take seconds (driver probing); it runs while
+    // the window comes up and the chains are planned
+    beginAudioInit();
+
+    // Initialize SDL (presents a cleared window right away)
     initializeSDL();
+    ui_batch_ = std::make_unique<UiBatch>(renderer_);
+    markStartupPhase("window");
 
-    // Create ring buffer (60 seconds of audio at 48 kHz)
-    ring_buffer_ = std::make_unique<RingBuffer<float>>(
-        static_cast<size_t>(settings_.sample_rate * 60));
+    // File mode read-ahead: memory is bounded by this, not by file length
+    file_streamer_ = std::make_unique<FileStreamer>(
+        static_cast<size_t>(settings_.sample_rate * FILE_STREAM_SECONDS));
 
     // Calculate spectrogram display height (use 60% of window height)
-    size_t spectrogram_height = static_cast<size_t>(window_height_ * 0.6f);
+    size_t spectrogram_height = static_cast<size_t>(window_height_ * SPECTROGRAM_HEIGHT_FRACTION);
 
-    // Create processing components
-    fft_processor_ = std::make_unique<FFTProcessor>(
-        settings_.fft_size, settings_.window_type);
+    // Load FFTW wisdom so the first plan (and later size changes) are instant
+    fft_wisdom_ = std::make_unique<FFTWisdom>(FFTWisdom::defaultCachePath());
+    fft_wisdom_->load();
 
-    freq_resampler_ = std::make_unique<FrequencyResampler>(
-        settings_.freq_scale,
-        settings_.min_freq,
-        settings_.max_freq,
-        settings_.sample_rate,
-        settings_.fft_size,
-        spectrogram_height);
+    // Create processing chain (FFT + resampler + working buffers)
+    current_chain_ = chain_cache_.acquire(ChainKey::fromSettings(settings_, spectrogram_height));
+    active_chain_ = current_chain_;
 
-    color_transform_ = std::make_unique<ColorTransform>(ColorTheme::CMRMAP);
-
-    spectrogram_image_ = std::make_unique<SpectrogramImage>(
-        window_width_, spectrogram_height);
+    // Plan the remaining sizes in the background so +/- never stalls
+    fft_wisdom_->startBackgroundPlanning();
+    planning_start_ = std::chrono::steady_clock::now();
+    markStartupPhase("wisdom and first chain");
 
-    // Create text renderer for UI overlays
-    text_renderer_ = std::make_unique<TextRenderer>(renderer_);
-    if (!text_renderer_->isValid()) {
-        std::cerr << "Warning: Text rendering unavailable: "
-                  << text_renderer_->getError() << std::endl;
-        std::cerr << "UI will display without text labels" << std::endl;
+    color_transform_ = std::make_unique<ColorTransform>(ColorTheme::CMRMAP);
+    level_meter_ = std::make_unique<LevelMeter>(settings_.sample_rate);
+
+    // GPU colormapping: levels go to a 16-bit texture and the palette and
+    // dB range are applied by a shader, so no column is colorized on the CPU
+    if (use_gpu_colormap_) {
+        gpu_colormap_ = std::make_unique<GpuColormap>(
+            renderer_, static_cast<size_t>(window_width_), spectrogram_height);
+        if (gpu_colormap_->isValid()) {
+            gpu_colormap_->setPalette(color_transform_->getPalette());
+            std::cout << "GPU colormapping enabled" << std::endl;
+        } else {
+            std::cerr << "Warning: GPU colormapping unavailable: "
+                      << gpu_colormap_->getError() << std::endl;
+            std::cerr << "Falling back to CPU colormapping" << std::endl;
+            gpu_colormap_.reset();
+            use_gpu_colormap_ = false;
+        }
     }
 
-    // Allocate working buffers
-    fft_input_.resize(settings_.fft_size);
-    fft_output_.resize(settings_.fft_size / 2 + 1);
-    resampled_.resize(spectrogram_height);
-    normalized_.resize(spectrogram_height);
-    colors_.resize(spectrogram_height);
+    // Row-major so the renderer can upload new columns without transposing
+    spectrogram_image_ = std::make_unique<SpectrogramImage>(
+        window_width_, spectrogram_height, ImageLayout::RowMajor,
+        use_gpu_colormap_ ? ImagePlane::Levels : ImagePlane::ColorsAndLevels);
 
-    // Create SDL texture now that we know the spectrogram dimensions
-    texture_ = SDL_CreateTexture(
-        renderer_,
-        SDL_PIXELFORMAT_RGBA32,
-        SDL_TEXTUREACCESS_STREAMING,
-        window_width_,
-        static_cast<int>(spectrogram_height)
-    );
+    // Fonts (text renderer) and the chains one keypress away come after
+    // the first frame; see advanceStartup()
 
-    if (!texture_) {
-        throw std::runtime_error(std::string("Texture creation failed: ") + SDL_GetError());
-    }
+    // Every displayed column is also kept (quantized, multi-resolution) for
+    // the history view
+    setHistoryMemory(DEFAULT_HISTORY_BYTES);
 
-    // Initialize AudioEngine for live input (but don't start yet)
-    try {
-        audio_engine_ = std::make_unique<AudioEngine>(
-            settings_.sample_rate, 512, 60);
+    createColumnQueue();
 
-        available_devices_ = audio_engine_->getInputDevices();
+    // Long catch-up bursts (after a stall or a chain switch) and resizes use every core
+    task_pool_ = std::make_unique<TaskPool>();
 
-        if (!available_devices_.empty()) {
-            std::cout << "Found " << available_devices_.size()
-                      << " audio input device(s):" << std::endl;
-            for (const auto& dev : available_devices_) {
-                std::cout << "  [" << dev.id << "] " << dev.name
-                          << (dev.is_default ? " (default)" : "") << std::endl;
-            }
-        } else {
-            std::cout << "No audio input devices detected - live mode unavailable" << std::endl;
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "AudioEngine initialization failed: " << e.what() << std::endl;
-        std::cerr << "Live audio input will be unavailable" << std::endl;
-        audio_engine_ = nullptr;
+    // Create SDL texture now that we know the spectrogram dimensions
+    if (!use_gpu_colormap_) {
+        createSpectrogramTexture();
     }
 
+    markStartupPhase("display buffers");
+
     std::cout << "Application initialized successfully" << std::endl;
     std::cout << "  Window: " << window_width_ << "x" << window_height_ << std::endl;
     std::cout << "  Spectrogram: " << window_width_ << "x" << spectrogram_height << std::endl;
@@ -123,9 +212,27 @@ FritureApp::FritureApp(int window_width, int window_height)
 }
 
 FritureApp::~FritureApp() {
+    // The startup thread may still be probing devices
+    if (audio_init_.valid()) {
+        audio_init_.wait();
+    }
+    stopAnalysisThread();
+
+    if (fft_wisdom_) {
+        fft_wisdom_->stopBackgroundPlanning();
+        fft_wisdom_->save();
+    }
+
     if (texture_) {
         SDL_DestroyTexture(texture_);
     }
+    if (history_texture_) {
+        SDL_DestroyTexture(history_texture_);
+    }
+    // Glyph atlases and GL objects must go while the renderer still exists
+    text_renderer_.reset();
+    ui_batch_.reset();
+    gpu_colormap_.reset();
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
     }
@@ -165,6 +272,11 @@ void FritureApp::initializeSDL() {
         throw std::runtime_error(std::string("Window creation failed: ") + SDL_GetError());
     }
 
+    // The GPU colormap draws with OpenGL inside SDL's renderer context
+    if (use_gpu_colormap_) {
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "opengl");
+    }
+
     // Create renderer with hardware acceleration if available
     renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (!renderer_) {
@@ -178,26 +290,279 @@ void FritureApp::initializeSDL() {
         throw std::runtime_error(std::string("Renderer creation failed: ") + SDL_GetError());
     }
 
+    // Something on screen before the rest of startup
+    SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
+    SDL_RenderClear(renderer_);
+    SDL_RenderPresent(renderer_);
+
     // Get renderer info
     SDL_RendererInfo info;
     SDL_GetRendererInfo(renderer_, &info);
     std::cout << "SDL Renderer: " << info.name << std::endl;
 
+    // Event the analysis thread pushes to wake the render loop for new columns
+    column_ready_event_ = SDL_RegisterEvents(1);
+
     // Note: Texture will be created after spectrogram_image_ is initialized
     texture_ = nullptr;
 }
 
+void FritureApp::createColumnQueue() {
+    // Column hand-off queue: one screen width of columns in flight is enough,
+    // anything older would scroll off before it is displayed. Levels are
+    // always filled (history); colors only for CPU colormapping.
+    const size_t height = spectrogram_image_->getHeight();
+    QueuedColumn prototype;
+    prototype.levels.resize(height);
+    if (!use_gpu_colormap_) {
+        prototype.colors.resize(height);
+    }
+    column_queue_ = std::make_unique<ColumnQueue>(spectrogram_image_->getWidth(), prototype);
+}
+
+void FritureApp::createSpectrogramTexture() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+    }
+    texture_ = SDL_CreateTexture(
+        renderer_,
+        SDL_PIXELFORMAT_RGBA32,
+        SDL_TEXTUREACCESS_STREAMING,
+        static_cast<int>(spectrogram_image_->getWidth()),
+        static_cast<int>(spectrogram_image_->getHeight())
+    );
+
+    if (!texture_) {
+        throw std::runtime_error(std::string("Texture creation failed: ") + SDL_GetError());
+    }
+}
+
+void FritureApp::applyWindowSize() {
+    resize_pending_ = false;
+    const size_t width = static_cast<size_t>(std::max(window_width_, 1));
+    const size_t height = std::max<size_t>(
+        static_cast<size_t>(window_height_ * SPECTROGRAM_HEIGHT_FRACTION), 1);
+    if (width == spectrogram_image_->getWidth() && height == spectrogram_image_->getHeight()) {
+        return;
+    }
+
+    // Queued columns have the old height: stop the worker and take them first
+    const bool restart = analysis_thread_.joinable();
+    stopAnalysisThread();
+    takeColumns();
+
+    // Rescale the stored levels instead of analyzing anything again
+    spectrogram_image_->resample(width, height, task_pool_.get());
+    if (use_gpu_colormap_) {
+        gpu_colormap_->resize(width, height);
+    } else {
+        spectrogram_image_->recolor(color_transform_->getPalette(),
+                                    settings_.spec_min_db, settings_.spec_max_db);
+        createSpectrogramTexture();
+    }
+
+    try {
+        history_->resize(height, task_pool_.get());
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "History not resized (" << e.what() << "); new columns are not kept"
+                  << std::endl;
+    }
+    if (history_texture_) {
+        SDL_DestroyTexture(history_texture_);
+        history_texture_ = nullptr;  // Recreated at the new size by drawHistoryView()
+    }
+    history_dirty_ = true;
+
+    // Queue slots and chains for the new row count; the chains share the
+    // FFTs already planned and only get new resampler rows
+    createColumnQueue();
+    if (!viewer_) {
+        updateProcessingComponents();
+    }
+    if (restart) {
+        startAnalysisThread();
+    }
+    redraw_requested_ = true;
+
+    std::cout << "Spectrogram: " << width << "x" << height << std::endl;
+}
+
+// ============================================================================
+// Startup
+// ============================================================================
+
+void FritureApp::beginAudioInit() {
+    const size_t sample_rate = static_cast<size_t>(settings_.sample_rate);
+    const size_t ring_seconds = ring_seconds_;
+    audio_init_ = std::async(std::launch::async, [sample_rate, ring_seconds]() {
+        AudioInit init;
+        init.start = std::chrono::steady_clock::now();
+        try {
+            init.engine = std::make_unique<AudioEngine>(sample_rate, 512, ring_seconds);
+            init.devices = init.engine->getInputDevices();
+        } catch (const std::exception& e) {
+            init.engine.reset();
+            init.error = e.what();
+        }
+        init.end = std::chrono::steady_clock::now();
+        return init;
+    });
+}
+
+bool FritureApp::finishAudioInit(bool wait) {
+    if (!audio_init_.valid()) {
+        return true;
+    }
+    if (!wait && audio_init_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    if (wait && audio_init_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        std::cout << "Waiting for the audio device scan..." << std::endl;
+    }
+
+    AudioInit init = audio_init_.get();
+    addStartupPhase("audio devices", init.start, init.end, true);
+    redraw_requested_ = true;
+    if (!init.engine) {
+        std::cerr << "AudioEngine initialization failed: " << init.error << std::endl;
+        std::cerr << "Live audio input will be unavailable" << std::endl;
+        return true;
+    }
+
+    audio_engine_ = std::move(init.engine);
+    available_devices_ = std::move(init.devices);
+    if (!available_devices_.empty()) {
+        std::cout << "Found " << available_devices_.size()
+                  << " audio input device(s):" << std::endl;
+        for (const auto& dev : available_devices_) {
+            std::cout << "  [" << dev.id << "] " << dev.name
+                      << (dev.is_default ? " (default)" : "") << std::endl;
+        }
+    } else {
+        std::cout << "No audio input devices detected - live mode unavailable" << std::endl;
+    }
+
+    // Settings made while the devices were scanned; the engine is stopped,
+    // so these only size its rings
+    if (stream_options_pending_) {
+        stream_options_pending_ = false;
+        if (!audio_engine_->setStreamOptions(pending_stream_options_)) {
+            std::cerr << "Invalid audio stream options: " << audio_engine_->getError() << std::endl;
+        }
+    }
+    const size_t rate = static_cast<size_t>(settings_.sample_rate);
+    if (audio_engine_->getSampleRate() != rate && !audio_engine_->setSampleRate(rate)) {
+        std::cerr << "Audio input at " << rate << " Hz failed: " << audio_engine_->getError() << std::endl;
+    }
+    if (audio_engine_->getRingDuration() != ring_seconds_ &&
+        !audio_engine_->setRingDuration(ring_seconds_)) {
+        std::cerr << "Invalid ring duration: " << audio_engine_->getError() << std::endl;
+        ring_seconds_ = audio_engine_->getRingDuration();
+    }
+    return true;
+}
+
+void FritureApp::advanceStartup() {
+    finishAudioInit(false);
+
+    if (frame_count_ == 0) {
+        return;
+    }
+    if (!text_renderer_) {
+        // The first frame went out without labels; glyph atlases are built
+        // while the next one is drawn
+        markStartupPhase("first frame");
+        text_renderer_ = std::make_unique<TextRenderer>(renderer_);
+        if (!text_renderer_->isValid()) {
+            std::cerr << "Warning: Text rendering unavailable: "
+                      << text_renderer_->getError() << std::endl;
+            std::cerr << "UI will display without text labels" << std::endl;
+        }
+        redraw_requested_ = true;
+        return;
+    }
+    if (frame_count_ == 1) {
+        return;
+    }
+    if (!labels_shown_) {
+        markStartupPhase("first labelled frame");
+        labels_shown_ = true;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const bool planned = fft_wisdom_->isPlanningComplete();
+    if (planned && !planning_recorded_) {
+        addStartupPhase("FFT planning", planning_start_, now, true);
+        planning_recorded_ = true;
+    }
+    if (!chains_prewarmed_) {
+        if (!planned && now - startup_mark_ < PREWARM_PLANNING_WAIT) {
+            return;
+        }
+        // Build the chains one keypress away so switching is instant; their
+        // plans are in the wisdom by now, unless planning is slow
+        prewarmNeighbourChains();
+        addStartupPhase("neighbour chains", now, std::chrono::steady_clock::now(), false);
+        chains_prewarmed_ = true;
+    }
+
+    if (audio_init_.valid()) {
+        return;
+    }
+    startup_done_ = true;
+    if (startup_trace_) {
+        reportStartup();
+    }
+}
+
+void FritureApp::markStartupPhase(const char* name) {
+    const auto now = std::chrono::steady_clock::now();
+    addStartupPhase(name, startup_mark_, now, false);
+    startup_mark_ = now;
+}
+
+void FritureApp::addStartupPhase(const char* name, std::chrono::steady_clock::time_point start,
+                                 std::chrono::steady_clock::time_point end, bool background) {
+    using ms = std::chrono::duration<double, std::milli>;
+    startup_phases_.push_back({name, ms(start - startup_begin_).count(),
+                               ms(end - start).count(), background});
+}
+
+void FritureApp::reportStartup() const {
+    using ms = std::chrono::duration<double, std::milli>;
+    std::cout << "\nStartup phases (ms since launch):" << std::endl;
+    std::cout << "  phase                       start  duration" << std::endl;
+    for (const StartupPhase& phase : startup_phases_) {
+        char line[96];
+        std::snprintf(line, sizeof(line), "  %-24s %8.1f  %8.1f%s", phase.name.c_str(),
+                      phase.start_ms, phase.duration_ms, phase.background ? "  (background)" : "");
+        std::cout << line << std::endl;
+    }
+    std::cout << "Startup complete after "
+              << ms(std::chrono::steady_clock::now() - startup_begin_).count() << " ms" << std::endl;
+}
+
+void FritureApp::enableStartupTrace() {
+    startup_trace_ = true;
+}
+
+void FritureApp::setRunDuration(double seconds) {
+    run_duration_ = std::max(seconds, 0.0);
+}
+
 // ============================================================================
 // Mode Switching
 // ============================================================================
 
 void FritureApp::switchToLiveMode() {
+    finishAudioInit(true);
     if (!audio_engine_ || available_devices_.empty()) {
         std::cerr << "Cannot switch to live mode: no audio devices available" << std::endl;
         return;
     }
 
     // Stop current playback
+    stopAnalysisThread();
     paused_ = false;
     current_audio_position_ = 0;
     spectrogram_image_->clear();
@@ -209,8 +574,12 @@ void FritureApp::switchToLiveMode() {
             return;
         }
     }
+    level_meter_->reset();
 
     input_mode_ = InputMode::Live;
+    if (running_) {
+        startAnalysisThread();
+    }
     std::cout << "Switched to LIVE mode";
     if (current_device_index_ < available_devices_.size()) {
         std::cout << " - Device: " << available_devices_[current_device_index_].name;
@@ -219,6 +588,8 @@ void FritureApp::switchToLiveMode() {
 }
 
 void FritureApp::switchToFileMode() {
+    stopAnalysisThread();
+
     // Stop audio engine if running
     if (audio_engine_ && audio_engine_->isRunning()) {
         audio_engine_->stop();
@@ -228,10 +599,15 @@ void FritureApp::switchToFileMode() {
     current_audio_position_ = 0;
     spectrogram_image_->clear();
 
+    if (running_) {
+        startAnalysisThread();
+    }
+
     std::cout << "Switched to FILE mode" << std::endl;
 }
 
 void FritureApp::cycleInputDevice() {
+    finishAudioInit(true);
     if (!audio_engine_ || available_devices_.empty()) {
         std::cerr << "No audio devices available" << std::endl;
         return;
@@ -240,6 +616,10 @@ void FritureApp::cycleInputDevice() {
     // Cycle to next device
     current_device_index_ = (current_device_index_ + 1) % available_devices_.size();
 
+    // The analysis thread reads the engine's ring buffer; stop it first
+    // and restart once the new stream is up
+    stopAnalysisThread();
+
     // Stop current stream
     if (audio_engine_->isRunning()) {
         audio_engine_->stop();
@@ -248,6 +628,9 @@ void FritureApp::cycleInputDevice() {
     // Set new device
     if (!audio_engine_->setInputDevice(available_devices_[current_device_index_].id)) {
         std::cerr << "Failed to set input device: " << audio_engine_->getError() << std::endl;
+        if (running_) {
+            startAnalysisThread();
+        }
         return;
     }
 
@@ -256,8 +639,12 @@ void FritureApp::cycleInputDevice() {
         if (!audio_engine_->start()) {
             std::cerr << "Failed to start audio on new device: "
                       << audio_engine_->getError() << std::endl;
-            return;
         }
+        level_meter_->reset();
+    }
+
+    if (running_) {
+        startAnalysisThread();
     }
 
     std::cout << "Switched to device [" << available_devices_[current_device_index_].id
@@ -273,15 +660,17 @@ void FritureApp::generateSineWave(float frequency, float duration) {
               << duration << " seconds" << std::endl;
 
     size_t num_samples = static_cast<size_t>(duration * settings_.sample_rate);
-    std::vector<float> samples(num_samples);
-
-    for (size_t i = 0; i < num_samples; ++i) {
-        float t = static_cast<float>(i) / settings_.sample_rate;
-        samples[i] = 0.5f * std::sin(2.0f * M_PI * frequency * t);
-    }
+    const double sample_rate = settings_.sample_rate;
 
-    // Write to ring buffer
-    ring_buffer_->write(samples.data(), num_samples);
+    // Synthesized block by block on the streaming thread
+    file_streamer_->start([=](uint64_t position, float* output, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            double t = static_cast<double>(position + i) / sample_rate;
+            output[i] = static_cast<float>(0.5 * std::sin(2.0 * M_PI * frequency * t));
+        }
+        return count;
+    }, num_samples);
+    wav_reader_.reset();
     total_audio_samples_ = num_samples;
     current_audio_position_ = 0;
 
@@ -293,18 +682,19 @@ void FritureApp::generateChirp(float f_start, float f_end, float duration) {
               << " Hz, " << duration << " seconds" << std::endl;
 
     size_t num_samples = static_cast<size_t>(duration * settings_.sample_rate);
-    std::vector<float> samples(num_samples);
-
-    float k = (f_end - f_start) / duration; // Hz/sec
-
-    for (size_t i = 0; i < num_samples; ++i) {
-        float t = static_cast<float>(i) / settings_.sample_rate;
-        float phase = 2.0f * M_PI * (f_start * t + 0.5f * k * t * t);
-        samples[i] = 0.5f * std::sin(phase);
-    }
-
-    // Write to ring buffer
-    ring_buffer_->write(samples.data(), num_samples);
+    const double sample_rate = settings_.sample_rate;
+    const double k = (f_end - f_start) / duration; // Hz/sec
+
+    // Synthesized block by block on the streaming thread
+    file_streamer_->start([=](uint64_t position, float* output, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            double t = static_cast<double>(position + i) / sample_rate;
+            double phase = 2.0 * M_PI * (f_start * t + 0.5 * k * t * t);
+            output[i] = static_cast<float>(0.5 * std::sin(phase));
+        }
+        return count;
+    }, num_samples);
+    wav_reader_.reset();
     total_audio_samples_ = num_samples;
     current_audio_position_ = 0;
 
@@ -314,36 +704,75 @@ void FritureApp::generateChirp(float f_start, float f_end, float duration) {
 bool FritureApp::loadAudioFromFile(const char* filename) {
     std::cout << "\nLoading audio from file: " << filename << std::endl;
 
-    AudioFileLoader loader;
-    std::vector<float> samples;
-    float file_sample_rate;
-
-    if (!loader.load(filename, samples, file_sample_rate)) {
-        std::cerr << "Failed to load WAV file: " << loader.getError() << std::endl;
+    auto reader = std::make_unique<WavReader>();
+    if (!reader->open(filename)) {
+        std::cerr << "Failed to load WAV file: " << reader->getError() << std::endl;
         std::cerr << "Generating test chirp instead..." << std::endl;
         generateChirp(100.0f, 10000.0f, 5.0f);
         return false;
     }
 
-    // Check if sample rate matches our processing sample rate
-    if (std::abs(file_sample_rate - settings_.sample_rate) > 1.0f) {
-        std::cout << "Warning: File sample rate (" << file_sample_rate << " Hz) "
-                  << "differs from processing sample rate (" << settings_.sample_rate << " Hz)"
-                  << std::endl;
-        std::cout << "Resampling not yet implemented - using file as-is" << std::endl;
-        // TODO: Implement resampling in future version
-        settings_.sample_rate = file_sample_rate;
+    // The streamer stops the previous source before the new one starts
+    stopAnalysisThread();
+    wav_reader_ = std::move(reader);
+    startFileSource();
+    if (running_) {
+        startAnalysisThread();
     }
 
-    // Write samples to ring buffer
-    ring_buffer_->write(samples.data(), samples.size());
-    total_audio_samples_ = samples.size();
+    std::cout << "Successfully loaded: " << wav_reader_->getInfo().getFormatDescription() << std::endl;
+    std::cout << "Total samples: " << total_audio_samples_ << std::endl;
+    return true;
+}
+
+void FritureApp::startFileSource() {
+    const auto file_rate = static_cast<uint32_t>(wav_reader_->getSampleRate());
+    const auto analysis_rate = static_cast<uint32_t>(settings_.sample_rate);
+
+    if (file_rate == analysis_rate) {
+        // Decoded just ahead of playback; pages behind it are handed back
+        WavReader* source = wav_reader_.get();
+        file_streamer_->start([source](uint64_t position, float* output, size_t count) {
+            size_t frames = source->readMono(position, output, count);
+            source->releaseBefore(position + frames);
+            return frames;
+        }, source->getFrameCount());
+        total_audio_samples_ = static_cast<size_t>(source->getFrameCount());
+    } else {
+        auto converter = std::make_shared<SampleRateConverter>(file_rate, analysis_rate);
+        total_audio_samples_ = static_cast<size_t>(converter->getOutputLength(wav_reader_->getFrameCount()));
+        file_streamer_->start(convertedSource(wav_reader_.get(), converter), total_audio_samples_);
+        std::cout << "Converting " << file_rate << " Hz to " << analysis_rate << " Hz ("
+                  << converter->getTapCount() << " taps)" << std::endl;
+    }
     current_audio_position_ = 0;
+}
 
-    const WavInfo& info = loader.getInfo();
-    std::cout << "Successfully loaded: " << info.getFormatDescription() << std::endl;
-    std::cout << "Total samples: " << total_audio_samples_ << std::endl;
+bool FritureApp::setAnalysisRate(float rate) {
+    SpectrogramSettings candidate = settings_;
+    if (!(rate >= MIN_ANALYSIS_RATE && rate <= MAX_ANALYSIS_RATE) ||
+        rate != std::floor(rate) || !candidate.setSampleRate(rate)) {
+        std::cerr << "Invalid analysis rate: " << rate << " Hz" << std::endl;
+        return false;
+    }
+
+    stopAnalysisThread();
+    settings_ = candidate;
+    level_meter_ = std::make_unique<LevelMeter>(settings_.sample_rate);
+    if (audio_engine_ && !audio_engine_->setSampleRate(static_cast<size_t>(rate))) {
+        std::cerr << "Audio input at " << rate << " Hz failed: " << audio_engine_->getError() << std::endl;
+    }
+    updateProcessingComponents();
+    spectrogram_image_->clear();
+    if (wav_reader_ && input_mode_ == InputMode::File) {
+        startFileSource();
+    }
+    if (running_) {
+        startAnalysisThread();
+    }
 
+    std::cout << "Analysis rate: " << settings_.sample_rate << " Hz (display up to "
+              << settings_.max_freq << " Hz)" << std::endl;
     return true;
 }
 
@@ -354,35 +783,86 @@ bool FritureApp::loadAudioFromFile(const char* filename) {
 void FritureApp::run() {
     running_ = true;
     last_frame_time_ = std::chrono::steady_clock::now();
-    last_fft_time_ = std::chrono::steady_clock::now();
+    profile_window_start_ = last_frame_time_;
+    profile_baseline_ = profiler_.getSnapshot();
+    governor_window_start_ = last_frame_time_;
+    governor_baseline_ = profile_baseline_;
+    next_draw_time_ = last_frame_time_;
 
     std::cout << "\n=== Application Running ===" << std::endl;
     std::cout << "Press 'H' for help" << std::endl;
     std::cout << "Press 'Q' or ESC to quit" << std::endl;
+    markStartupPhase("setup");
+
+    // Audio analysis runs on its own thread from here on
+    startAnalysisThread();
+    // Unattended runs end by themselves (setRunDuration)
+    const auto run_end = last_frame_time_ +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(run_duration_));
 
     while (running_) {
-        auto frame_start = std::chrono::steady_clock::now();
+        if (run_duration_ > 0.0 && std::chrono::steady_clock::now() >= run_end) {
+            running_ = false;
+            break;
+        }
+        if (!startup_done_) {
+            advanceStartup();
+        }
 
-        // Handle events
+        // Handle events, and take the finished columns even when this
+        // iteration does not draw, so none wait in the queue
         handleEvents();
+        if (resize_pending_ &&
+            std::chrono::steady_clock::now() - resize_time_ >= RESIZE_SETTLE_PERIOD) {
+            applyWindowSize();
+        }
+        takeColumns();
+        updateQualityGovernor();
 
-        // Process audio if not paused
-        if (!paused_ && current_audio_position_ < total_audio_samples_) {
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - last_fft_time_);
-
-            // Calculate time per column based on overlap
-            float ms_per_column = settings_.getTimePerColumn() * 1000.0f;
+        auto frame_start = std::chrono::steady_clock::now();
+        const bool paused = paused_.load(std::memory_order_relaxed);
+        const bool dirty = redraw_requested_ || spectrogram_image_->isDirty() ||
+                           (!paused && frame_start - last_frame_time_ >= IDLE_REDRAW_PERIOD);
+
+        if (!dirty) {
+            // Re-arm the column wake-up, then look once more so a column
+            // queued in between is not slept through
+            column_wake_pending_.store(false);
+            takeColumns();
+            if (spectrogram_image_->isDirty()) {
+                continue;
+            }
 
-            // Process new FFT frame when enough time has elapsed
-            if (elapsed.count() >= ms_per_column) {
-                processAudioFrame();
-                last_fft_time_ = now;
+            auto deadline = paused ? frame_start + PAUSED_WAIT_PERIOD
+                                   : last_frame_time_ + IDLE_REDRAW_PERIOD;
+            if (viewer_ || column_ready_event_ == static_cast<Uint32>(-1) || !startup_done_) {
+                // Nothing wakes us for columns (or for deferred startup
+                // work): poll at the refresh rate
+                deadline = std::min(deadline, frame_start + REFRESH_PERIOD);
+            }
+            if (resize_pending_) {
+                deadline = std::min(deadline, resize_time_ + RESIZE_SETTLE_PERIOD);
             }
+            if (run_duration_ > 0.0) {
+                deadline = std::min(deadline, run_end);
+            }
+            waitForWork(deadline);
+            continue;
+        }
+
+        if (frame_start < next_draw_time_) {
+            // Columns arriving faster than the redraw rate collect in the
+            // image until the next allowed frame
+            waitForWork(std::min(next_draw_time_, frame_start + REFRESH_PERIOD));
+            continue;
         }
+        // A quarter refresh early: the vsync wait in Present lands the
+        // frame on the Nth refresh
+        next_draw_time_ = frame_start + REFRESH_PERIOD * quality_.frame_interval - REFRESH_PERIOD / 4;
+        redraw_requested_ = false;
 
-        // Render frame
+        // Render frame (pulls finished columns from the analysis thread)
         renderFrame();
 
         // Calculate FPS
@@ -392,95 +872,451 @@ void FritureApp::run() {
 
         fps_ = fps_ * 0.95f + (1000000.0f / frame_duration.count()) * 0.05f; // Smoothed FPS
         frame_count_++;
+        last_frame_time_ = frame_end;
+    }
+
+    stopAnalysisThread();
+    stopRecording();
+    if (governor_ && governor_->getChangeCount() > 0) {
+        std::cout << "Quality governor changed level " << governor_->getChangeCount()
+                  << " times" << std::endl;
+    }
+    if (stream_sender_.isOpen()) {
+        std::cout << "Streamed " << stream_sender_.getColumnsSent() << " columns ("
+                  << stream_sender_.getBytesSent() / 1024 << " KB)";
+        if (stream_sender_.getDroppedPackets() > 0) {
+            std::cout << ", " << stream_sender_.getDroppedPackets() << " datagrams dropped";
+        }
+        std::cout << std::endl;
+        stream_sender_.close();
+    }
 
-        // Cap at ~60 FPS
-        if (frame_duration.count() < 16666) {
-            SDL_Delay(1);
+    if (!trace_path_.empty()) {
+        if (profiler_.writeTrace(trace_path_)) {
+            std::cout << "Wrote " << profiler_.getTraceEventCount() << " trace events to "
+                      << trace_path_ << std::endl;
+        } else {
+            std::cerr << "Trace not written: " << profiler_.getError() << std::endl;
         }
     }
 }
 
 // ============================================================================
-// Event Handling
+// Analysis Thread
 // ============================================================================
 
-void FritureApp::handleEvents() {
-    SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-        switch (event.type) {
-            case SDL_QUIT:
-                running_ = false;
-                break;
-
-            case SDL_KEYDOWN:
-                handleKeyboard(event.key);
-                break;
-
-            case SDL_WINDOWEVENT:
-                if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
-                    window_width_ = event.window.data1;
-                    window_height_ = event.window.data2;
-                    // TODO: Resize spectrogram image and texture
-                }
-                break;
-        }
+void FritureApp::startAnalysisThread() {
+    if (analysis_thread_.joinable()) {
+        return; // Already running
+    }
+    if (viewer_) {
+        return; // Columns come from the network
+    }
+
+    // Start on the latest chain; a switch still pending is superseded
+    {
+        std::lock_guard<std::mutex> lock(chain_mutex_);
+        pending_chain_.reset();
+        pending_multichannel_.reset();
+        pending_transfer_.reset();
+        chain_pending_.store(false, std::memory_order_relaxed);
     }
+    active_chain_ = current_chain_;
+    active_multichannel_ = makeMultichannelAnalyzer(settings_);
+    active_transfer_ = makeTransferAnalyzer(settings_);
+    multichannel_column_.assign(spectrogram_image_->getHeight(), 0.0f);
+    expanded_column_.assign(spectrogram_image_->getHeight(), 0.0f);
+    pipeline_settings_ = settings_;
+    // Stream positions may start over (reset, new file, mode switch)
+    peak_detector_.reset();
+    averager_.reset();
+
+    analysis_running_.store(true, std::memory_order_release);
+    analysis_thread_ = std::thread(&FritureApp::analysisLoop, this);
+    startCapture();
 }
 
-void FritureApp::handleKeyboard(const SDL_KeyboardEvent& event) {
-    switch (event.keysym.sym) {
-        case SDLK_q:
-        case SDLK_ESCAPE:
-            running_ = false;
-            break;
+void FritureApp::stopAnalysisThread() {
+    // Every path that reallocates the engine rings stops analysis first;
+    // a capture in progress is finished with the audio already in them
+    if (capture_) {
+        capture_->stop();
+        reportCaptures();
+        capture_.reset();
+    }
 
-        case SDLK_SPACE:
-            paused_ = !paused_;
-            std::cout << (paused_ ? "Paused" : "Resumed") << std::endl;
-            break;
+    if (!analysis_thread_.joinable()) {
+        return; // Not running
+    }
 
-        case SDLK_h:
-            show_help_ = !show_help_;
-            break;
+    analysis_running_.store(false, std::memory_order_release);
+    analysis_thread_.join();
+}
 
-        case SDLK_r:
-            // Reset - go back to beginning
-            current_audio_position_ = 0;
-            spectrogram_image_->clear();
-            std::cout << "Reset to beginning" << std::endl;
-            break;
+void FritureApp::analysisLoop() {
+    using clock = std::chrono::steady_clock;
+
+    size_t hop_size = active_chain_->getHopSize();
+    const double sample_rate = pipeline_settings_.sample_rate;
+
+    // Never compute more than one screen of columns in a single catch-up
+    // batch; anything older would scroll off before it is displayed
+    const size_t max_batch = static_cast<size_t>(window_width_);
+    column_scheduler_.configure(hop_size, max_batch);
+
+    // Sample clock: samples "played" since the thread started, advanced by
+    // wall time while not paused. Columns are scheduled against it, so the
+    // time axis is correct regardless of FFT size or loop timing.
+    double sample_clock = 0.0;
+    last_fft_time_ = clock::now();
+
+    // Live mode: start at the newest complete window and follow the stream
+    // (with several channels, the last one analyzed, which the callback
+    // writes after the others)
+    auto live_lead_ring = [this]() -> RingBuffer<float>& {
+        size_t lead = active_transfer_ ? 1
+                    : active_multichannel_ ? active_multichannel_->getChannelCount() - 1 : 0;
+        return audio_engine_->getRingBuffer(lead);
+    };
+    if (input_mode_ == InputMode::Live && audio_engine_) {
+        live_cursor_ = live_lead_ring().makeCursor(active_chain_->getWindowSize());
+        live_samples_lost_ = 0;
+    }
 
-        case SDLK_c:
-            // Cycle color theme
-            // TODO: Implement theme cycling
-            std::cout << "Color theme cycling not implemented yet" << std::endl;
-            break;
+    while (analysis_running_.load(std::memory_order_acquire)) {
+        // Column boundary: pick up a settings change from the UI thread
+        if (adoptPendingChain() && active_chain_->getHopSize() != hop_size) {
+            hop_size = active_chain_->getHopSize();
+            column_scheduler_.configure(hop_size, max_batch);
+            sample_clock = 0.0;
+        }
 
-        case SDLK_l:
-            // Toggle live/file mode
-            if (input_mode_ == InputMode::File) {
-                switchToLiveMode();
-            } else {
-                switchToFileMode();
+        if (input_mode_ == InputMode::Live) {
+            if (paused_.load(std::memory_order_relaxed) || !audio_engine_) {
+                // Discard audio captured while paused instead of reporting it as an overrun
+                if (audio_engine_) {
+                    live_cursor_.seek(live_lead_ring().makeCursor(
+                        active_chain_->getWindowSize()).position());
+                }
+                std::this_thread::sleep_for(ANALYSIS_IDLE_PERIOD);
+                continue;
             }
-            break;
 
-        case SDLK_d:
-            // Cycle input devices
-            cycleInputDevice();
-            break;
+            // Analyze every complete hop exactly once (bounded per iteration
+            // so stop requests stay responsive)
+            size_t columns = 0;
+            while (columns < max_batch && processAudioFrame()) {
+                ++columns;
+            }
 
-        case SDLK_1:
-            settings_.freq_scale = FrequencyScale::Linear;
-            updateProcessingComponents();
-            std::cout << "Frequency scale: Linear" << std::endl;
-            break;
+            if (columns == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(
+                    static_cast<long long>(std::min(hop_size * 1000000.0 / sample_rate, 1000.0))));
+            }
+            continue;
+        }
 
-        case SDLK_2:
-            settings_.freq_scale = FrequencyScale::Logarithmic;
-            updateProcessingComponents();
-            std::cout << "Frequency scale: Logarithmic" << std::endl;
-            break;
+        auto now = clock::now();
+        double elapsed_sec = std::chrono::duration<double>(now - last_fft_time_).count();
+        last_fft_time_ = now;
+
+        if (paused_.load(std::memory_order_relaxed) ||
+            current_audio_position_ >= total_audio_samples_) {
+            // Idle: the sample clock does not advance while paused
+            std::this_thread::sleep_for(ANALYSIS_IDLE_PERIOD);
+            continue;
+        }
+
+        sample_clock += elapsed_sec * sample_rate;
+        uint64_t clock_samples = static_cast<uint64_t>(sample_clock);
+
+        ColumnBatch batch = column_scheduler_.schedule(clock_samples);
+
+        if (batch.dropped > 0) {
+            // Skip the dropped hops so the file stays in real time
+            dropped_columns_.fetch_add(batch.dropped, std::memory_order_relaxed);
+            current_audio_position_ += batch.dropped * hop_size;
+        }
+
+        // Long catch-up bursts fan out over the task pool, shorter ones go
+        // through the batched FFT, single hops as before
+        size_t remaining = batch.count;
+        while (remaining >= PARALLEL_BURST_COLUMNS) {
+            size_t done = processFileBurst(remaining);
+            if (done == 0) {
+                break; // Serial path, or end of file
+            }
+            remaining -= done;
+        }
+        while (remaining > 1) {
+            size_t done = processFileBatch(std::min(remaining, ProcessingChain::BATCH_COLUMNS));
+            if (done == 0) {
+                break; // End of file
+            }
+            remaining -= done;
+        }
+        if (remaining == 1) {
+            processAudioFrame();
+        }
+
+        // Sleep until the next column is due (at most 1 ms so stop requests stay responsive)
+        double wait_us = column_scheduler_.samplesUntilNextColumn(clock_samples)
+                         * 1000000.0 / sample_rate;
+        if (wait_us > 0.0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(
+                static_cast<long long>(std::min(wait_us, 1000.0))));
+        }
+    }
+}
+
+void FritureApp::drainColumnQueue() {
+    const size_t height = spectrogram_image_->getHeight();
+
+    while (column_queue_->popWith([&](const QueuedColumn& column) {
+        history_->appendLevels(column.levels.data(), height);
+        if (spectrum_view_ != SpectrumView::Off) {
+            spectrum_views_.addColumn(column.levels.data(), height);
+        }
+        recorder_.push(column.levels.data(), height);
+        stream_sender_.push(column.levels.data(), height);
+        if (use_gpu_colormap_) {
+            spectrogram_image_->addColumnLevels(column.levels.data(), height);
+        } else {
+            spectrogram_image_->addColumn(column.colors.data(), column.levels.data(), height);
+        }
+    })) {
+    }
+}
+
+// ============================================================================
+// Event Handling
+// ============================================================================
+
+void FritureApp::handleEvents() {
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        handleEvent(event);
+    }
+}
+
+void FritureApp::handleEvent(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_QUIT:
+            running_ = false;
+            break;
+
+        case SDL_KEYDOWN:
+            handleKeyboard(event.key);
+            redraw_requested_ = true;
+            break;
+
+        case SDL_WINDOWEVENT:
+            if (event.window.event == SDL_WINDOWEVENT_RESIZED) {
+                // Applied by run() once the size settles
+                window_width_ = event.window.data1;
+                window_height_ = event.window.data2;
+                resize_pending_ = true;
+                resize_time_ = std::chrono::steady_clock::now();
+            }
+            // Exposed, shown, resized...: the window contents need redrawing
+            redraw_requested_ = true;
+            break;
+    }
+}
+
+void FritureApp::waitForWork(std::chrono::steady_clock::time_point deadline) {
+    auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0) {
+        return;
+    }
+
+    // A column-ready event only ends the wait; the caller takes the columns
+    SDL_Event event;
+    if (SDL_WaitEventTimeout(&event, static_cast<int>(remaining.count())) == 1 &&
+        event.type != column_ready_event_) {
+        handleEvent(event);
+    }
+}
+
+void FritureApp::notifyColumnReady() {
+    if (column_ready_event_ == static_cast<Uint32>(-1) || column_wake_pending_.exchange(true)) {
+        return;
+    }
+    // Once per render-thread wake-up, not per column: SDL's queue lock is fine
+    RealtimeExemption exemption;
+    SDL_Event event{};
+    event.type = column_ready_event_;
+    SDL_PushEvent(&event);
+}
+
+void FritureApp::handleKeyboard(const SDL_KeyboardEvent& event) {
+    if (history_view_ && handleHistoryKey(event.keysym.sym)) {
+        return;
+    }
+
+    switch (event.keysym.sym) {
+        case SDLK_q:
+        case SDLK_ESCAPE:
+            running_ = false;
+            break;
+
+        case SDLK_SPACE:
+            paused_ = !paused_;
+            std::cout << (paused_ ? "Paused" : "Resumed") << std::endl;
+            break;
+
+        case SDLK_h:
+            show_help_ = !show_help_;
+            break;
+
+        case SDLK_v:
+            // History view: freeze on the last screenful, arrows pan and zoom
+            history_view_ = !history_view_;
+            if (history_view_) {
+                history_end_ = history_->getColumnCount();
+                history_span_ = spectrogram_image_->getWidth();
+                history_dirty_ = true;
+            }
+            break;
+
+        case SDLK_s:
+            // Spectrum curve, then 1/3-octave bars, then off
+            switch (spectrum_view_) {
+                case SpectrumView::Off:
+                    spectrum_view_ = SpectrumView::Spectrum;
+                    break;
+                case SpectrumView::Spectrum:
+                    spectrum_view_ = SpectrumView::Bands;
+                    break;
+                case SpectrumView::Bands:
+                    spectrum_view_ = SpectrumView::Off;
+                    break;
+            }
+            spectrum_views_.reset();
+            spectrum_views_time_ = std::chrono::steady_clock::now();
+            break;
+
+        case SDLK_g:
+            // Adaptive quality; turning it off restores full quality at once
+            if (governor_) {
+                governor_.reset();
+                std::cout << "Quality governor: off" << std::endl;
+                if (!(quality_ == QualityLevel())) {
+                    applyQualityLevel(QualityLevel());
+                }
+            } else {
+                enableQualityGovernor(governor_options_);
+                std::cout << "Quality governor: on" << std::endl;
+            }
+            break;
+
+        case SDLK_p:
+            // Per-stage latency overlay; first window starts now
+            show_profiler_ = !show_profiler_;
+            profile_baseline_ = profiler_.getSnapshot();
+            profile_window_ = StageProfileSnapshot();
+            profile_window_start_ = std::chrono::steady_clock::now();
+            break;
+
+        case SDLK_r:
+            // Reset - go back to beginning
+            stopAnalysisThread();
+            current_audio_position_ = 0;
+            spectrogram_image_->clear();
+            startAnalysisThread();
+            std::cout << "Reset to beginning" << std::endl;
+            break;
+
+        case SDLK_c:
+            // Cycle color theme
+            setColormap(color_transform_->getTheme() == ColorTheme::CMRMAP ? ColorTheme::Grayscale
+                                                                           : ColorTheme::CMRMAP,
+                        settings_.spec_min_db, settings_.spec_max_db);
+            break;
+
+        case SDLK_LEFTBRACKET:
+            // Shift the displayed dB range down (brighter) / up (darker)
+            setColormap(color_transform_->getTheme(),
+                        settings_.spec_min_db - DB_RANGE_STEP, settings_.spec_max_db - DB_RANGE_STEP);
+            break;
+
+        case SDLK_RIGHTBRACKET:
+            setColormap(color_transform_->getTheme(),
+                        settings_.spec_min_db + DB_RANGE_STEP, settings_.spec_max_db + DB_RANGE_STEP);
+            break;
+
+        case SDLK_l:
+            // Toggle live/file mode
+            if (input_mode_ == InputMode::File) {
+                switchToLiveMode();
+            } else {
+                switchToFileMode();
+            }
+            break;
+
+        case SDLK_k:
+            // Tonal peak events, logged to stdout; the detector starts
+            // with fresh noise floors each time
+            peak_detection_ = !peak_detection_;
+            std::cout << "Peak detection: " << (peak_detection_ ? "on" : "off") << std::endl;
+            break;
+
+        case SDLK_t:
+            // Capture around the newest input (defaults unless --capture was given)
+            if (input_mode_ != InputMode::Live) {
+                std::cout << "Capture needs live input (L)" << std::endl;
+            } else if (capture_ || enableCapture(capture_options_)) {
+                if (capture_) {
+                    capture_->trigger();
+                    std::cout << "Capture triggered" << std::endl;
+                }
+            }
+            break;
+
+        case SDLK_e:
+            // Cycle averaging: none -> exponential -> linear -> peak hold
+            switch (settings_.averaging) {
+                case AveragingMode::None:
+                    setAveraging(AveragingMode::Exponential, settings_.averaging_time,
+                                 settings_.averaging_frames);
+                    break;
+                case AveragingMode::Exponential:
+                    setAveraging(AveragingMode::Linear, settings_.averaging_time,
+                                 settings_.averaging_frames);
+                    break;
+                case AveragingMode::Linear:
+                    setAveraging(AveragingMode::PeakHold, settings_.averaging_time,
+                                 settings_.averaging_frames);
+                    break;
+                default:
+                    setAveraging(AveragingMode::None, settings_.averaging_time,
+                                 settings_.averaging_frames);
+                    break;
+            }
+            break;
+
+        case SDLK_x:
+            // Cycle hops per displayed column: 1 -> 2 -> 4 -> 8 -> 16 -> 1
+            setColumnDecimation(settings_.column_decimation >= 16 ? 1 : settings_.column_decimation * 2);
+            break;
+
+        case SDLK_d:
+            // Cycle input devices
+            cycleInputDevice();
+            break;
+
+        case SDLK_1:
+            settings_.freq_scale = FrequencyScale::Linear;
+            updateProcessingComponents();
+            std::cout << "Frequency scale: Linear" << std::endl;
+            break;
+
+        case SDLK_2:
+            settings_.freq_scale = FrequencyScale::Logarithmic;
+            updateProcessingComponents();
+            std::cout << "Frequency scale: Logarithmic" << std::endl;
+            break;
 
         case SDLK_3:
             settings_.freq_scale = FrequencyScale::Mel;
@@ -488,177 +1324,1416 @@ void FritureApp::handleKeyboard(const SDL_KeyboardEvent& event) {
             std::cout << "Frequency scale: Mel" << std::endl;
             break;
 
-        case SDLK_4:
-            settings_.freq_scale = FrequencyScale::ERB;
-            updateProcessingComponents();
-            std::cout << "Frequency scale: ERB" << std::endl;
-            break;
+        case SDLK_4:
+            settings_.freq_scale = FrequencyScale::ERB;
+            updateProcessingComponents();
+            std::cout << "Frequency scale: ERB" << std::endl;
+            break;
+
+        case SDLK_5:
+            settings_.freq_scale = FrequencyScale::Octave;
+            updateProcessingComponents();
+            std::cout << "Frequency scale: Octave" << std::endl;
+            break;
+
+        case SDLK_a:
+            // Cycle bin aggregation: mean power -> peak hold -> interpolate
+            switch (settings_.bin_aggregation) {
+                case BinAggregation::MeanPower:
+                    settings_.bin_aggregation = BinAggregation::PeakHold;
+                    break;
+                case BinAggregation::PeakHold:
+                    settings_.bin_aggregation = BinAggregation::Interpolate;
+                    break;
+                default:
+                    settings_.bin_aggregation = BinAggregation::MeanPower;
+                    break;
+            }
+            updateProcessingComponents();
+            std::cout << "Bin aggregation: " << toString(settings_.bin_aggregation) << std::endl;
+            break;
+
+        case SDLK_b:
+            // Larger FFTs for the low rows (Log and Octave scales only)
+            settings_.multi_resolution = !settings_.multi_resolution;
+            updateProcessingComponents();
+            std::cout << "Multi-resolution: " << (settings_.multi_resolution ? "on" : "off");
+            if (settings_.multi_resolution && !current_chain_->multiResolution()) {
+                std::cout << " (applies to Log and Octave scales)";
+            }
+            std::cout << std::endl;
+            break;
+
+        case SDLK_z:
+            // Zoom FFT into the displayed range (narrow ranges only)
+            setZoom(!settings_.zoom);
+            break;
+
+        case SDLK_o:
+            // Cycle overlap: 50 -> 75 -> 87.5 -> 93.75 -> 96.875 -> 98.4375 -> 50
+            setOverlap(settings_.overlap_percent >= 98.0f ? 50.0f
+                                                          : 100.0f - (100.0f - settings_.overlap_percent) / 2.0f);
+            break;
+
+        case SDLK_w:
+            // Cycle frequency weighting: none -> A -> B -> C -> none
+            switch (settings_.weighting) {
+                case WeightingType::None:
+                    setWeighting(WeightingType::A);
+                    break;
+                case WeightingType::A:
+                    setWeighting(WeightingType::B);
+                    break;
+                case WeightingType::B:
+                    setWeighting(WeightingType::C);
+                    break;
+                default:
+                    setWeighting(WeightingType::None);
+                    break;
+            }
+            break;
+
+        case SDLK_m:
+            // Multichannel layout: stacked lanes <-> overlay
+            settings_.channel_layout = (settings_.channel_layout == ChannelLayout::Stacked)
+                                           ? ChannelLayout::Overlay
+                                           : ChannelLayout::Stacked;
+            updateProcessingComponents();
+            std::cout << "Channel layout: " << toString(settings_.channel_layout) << std::endl;
+            break;
+
+        case SDLK_f:
+            // Transfer function: off -> magnitude -> phase -> coherence
+            switch (settings_.transfer) {
+                case TransferView::Off:
+                    setTransferView(TransferView::Magnitude);
+                    break;
+                case TransferView::Magnitude:
+                    setTransferView(TransferView::Phase);
+                    break;
+                case TransferView::Phase:
+                    setTransferView(TransferView::Coherence);
+                    break;
+                default:
+                    setTransferView(TransferView::Off);
+                    break;
+            }
+            break;
+
+        case SDLK_EQUALS:  // + key
+        case SDLK_PLUS:
+            // Increase FFT size
+            if (settings_.fft_size < 16384) {
+                settings_.fft_size *= 2;
+                updateProcessingComponents();
+                std::cout << "FFT size: " << settings_.fft_size << std::endl;
+            }
+            break;
+
+        case SDLK_MINUS:
+            // Decrease FFT size
+            if (settings_.fft_size > 32) {
+                settings_.fft_size /= 2;
+                updateProcessingComponents();
+                std::cout << "FFT size: " << settings_.fft_size << std::endl;
+            }
+            break;
+    }
+}
+
+bool FritureApp::handleHistoryKey(SDL_Keycode key) {
+    const uint64_t newest = history_->getColumnCount();
+    const uint64_t oldest = history_->getOldestColumn();
+    const uint64_t min_span = std::max<uint64_t>(16, spectrogram_image_->getWidth() / 8);
+    const uint64_t max_span = std::max<uint64_t>(min_span, newest - oldest);
+
+    switch (key) {
+        case SDLK_LEFT: {
+            // Pan a quarter window into the past, stopping at the oldest column
+            const uint64_t step = history_span_ / 4;
+            history_end_ = history_end_ > step ? history_end_ - step : 0;
+            history_end_ = std::max(history_end_, std::min(newest, oldest + history_span_));
+            break;
+        }
+        case SDLK_RIGHT:
+            history_end_ = std::min(newest, history_end_ + history_span_ / 4);
+            break;
+        case SDLK_UP:
+            // Zoom out around the window's end
+            history_span_ = std::min(max_span, history_span_ * 2);
+            break;
+        case SDLK_DOWN:
+            history_span_ = std::max(min_span, history_span_ / 2);
+            break;
+        case SDLK_END:
+            history_end_ = newest;  // Jump to now
+            break;
+        default:
+            return false;
+    }
+    history_dirty_ = true;
+    return true;
+}
+
+void FritureApp::updateProcessingComponents() {
+    // Look up (or build) the chain for the new settings on the UI thread
+    ChainKey key = ChainKey::fromSettings(settings_, getAnalysisHeight());
+    current_chain_ = chain_cache_.acquire(key);
+
+    if (analysis_thread_.joinable()) {
+        // Hand it to the analysis thread, which switches at the next column
+        // boundary; history already on screen is kept
+        // The per-channel chains are built here too (FFT planning is UI-thread work)
+        std::unique_ptr<MultiChannelAnalyzer> multichannel = makeMultichannelAnalyzer(settings_);
+        std::unique_ptr<CrossSpectrumAnalyzer> transfer = makeTransferAnalyzer(settings_);
+        std::shared_ptr<ProcessingChain> retired;
+        std::unique_ptr<MultiChannelAnalyzer> retired_multichannel;
+        std::unique_ptr<CrossSpectrumAnalyzer> retired_transfer;
+        {
+            std::lock_guard<std::mutex> lock(chain_mutex_);
+            retired = std::move(pending_chain_);
+            retired_multichannel = std::move(pending_multichannel_);
+            retired_transfer = std::move(pending_transfer_);
+            pending_chain_ = current_chain_;
+            pending_multichannel_ = std::move(multichannel);
+            pending_transfer_ = std::move(transfer);
+            pending_settings_ = settings_;
+            chain_pending_.store(true, std::memory_order_release);
+        }
+        // retired (the chain the worker handed back, if any) is released
+        // here, outside the lock and off the analysis thread
+    } else {
+        active_chain_ = current_chain_;
+        pipeline_settings_ = settings_;
+    }
+
+    updateRecordingFormat();
+    updateStreamFormat();
+    // While background planning runs, chain builds would wait behind it on
+    // the planner lock; advanceStartup() prewarms for the settings then current
+    if (chains_prewarmed_ || fft_wisdom_->isPlanningComplete()) {
+        prewarmNeighbourChains();
+    }
+}
+
+bool FritureApp::adoptPendingChain() {
+    if (!chain_pending_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    // Never block the worker; retry at the next column boundary instead
+    std::unique_lock<std::mutex> lock(chain_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+
+    // Swap so the old chain is released by the UI thread, not here
+    std::swap(active_chain_, pending_chain_);
+    std::swap(active_multichannel_, pending_multichannel_);
+    std::swap(active_transfer_, pending_transfer_);
+    pipeline_settings_ = pending_settings_;
+    chain_pending_.store(false, std::memory_order_relaxed);
+    return true;
+}
+
+std::unique_ptr<MultiChannelAnalyzer> FritureApp::makeMultichannelAnalyzer(
+    const SpectrogramSettings& settings) const {
+    if (input_mode_ != InputMode::Live || !audio_engine_ || audio_engine_->getChannelCount() < 2 ||
+        settings.transfer != TransferView::Off) {
+        return nullptr;   // One channel, or the transfer function replaces the lanes
+    }
+
+    const size_t height = spectrogram_image_->getHeight();
+    return std::make_unique<MultiChannelAnalyzer>(
+        ChainKey::fromSettings(settings, height), audio_engine_->getChannelCount(),
+        settings.channel_layout, height);
+}
+
+std::unique_ptr<CrossSpectrumAnalyzer> FritureApp::makeTransferAnalyzer(
+    const SpectrogramSettings& settings) const {
+    if (input_mode_ != InputMode::Live || !audio_engine_ || audio_engine_->getChannelCount() < 2 ||
+        settings.transfer == TransferView::Off) {
+        return nullptr;
+    }
+
+    // One hop always has a coherence of 1: average even when the display does not
+    CrossSpectrumAnalyzer::Options options;
+    options.averaging = settings.averaging == AveragingMode::None ? AveragingMode::Exponential
+                                                                  : settings.averaging;
+    options.time_seconds = settings.averaging_time;
+    options.frames = settings.averaging_frames;
+    return std::make_unique<CrossSpectrumAnalyzer>(
+        ChainKey::fromSettings(settings, spectrogram_image_->getHeight()), options);
+}
+
+size_t FritureApp::getAnalysisHeight() const {
+    return std::max<size_t>(spectrogram_image_->getHeight() / quality_.height_divisor, 1);
+}
+
+void FritureApp::prewarmNeighbourChains() {
+    ChainKey key = ChainKey::fromSettings(settings_, getAnalysisHeight());
+
+    // Other frequency scales at the current size (keys 1-5)
+    for (FrequencyScale scale : {FrequencyScale::Linear, FrequencyScale::Logarithmic,
+                                 FrequencyScale::Mel, FrequencyScale::ERB,
+                                 FrequencyScale::Octave}) {
+        ChainKey neighbour = key;
+        neighbour.scale = scale;
+        chain_cache_.prewarm(neighbour);
+    }
+
+    // Next size up and down (+/- keys)
+    if (key.fft_size < FFTWisdom::MAX_FFT_SIZE) {
+        ChainKey larger = key;
+        larger.fft_size *= 2;
+        chain_cache_.prewarm(larger);
+    }
+    if (key.fft_size > FFTWisdom::MIN_FFT_SIZE) {
+        ChainKey smaller = key;
+        smaller.fft_size /= 2;
+        chain_cache_.prewarm(smaller);
+    }
+}
+
+// ============================================================================
+// Audio Processing
+// ============================================================================
+
+bool FritureApp::processAudioFrame() {
+    // One hop, end to end: no allocation or blocking lock (checked with
+    // FRITURE_RT_CHECKS)
+    RealtimeScope scope("analysis");
+    ProcessingChain& chain = *active_chain_;
+    size_t samples_needed = chain.getWindowSize();
+    size_t hop_size = chain.getHopSize();
+    uint64_t window_end = 0;
+
+    // ========================================================================
+    // Dual-mode data source selection
+    // ========================================================================
+
+    if (input_mode_ == InputMode::File) {
+        // FILE MODE: Read from the mapped file or generated signal
+        if (current_audio_position_ + samples_needed > total_audio_samples_) {
+            // Reached end of audio
+            return false;
+        }
+
+        {
+            ScopedStageTimer timer(profiler_, ProfileStage::Read);
+            readFileSamples(current_audio_position_, chain.fft_input.data(), samples_needed);
+        }
+        window_end = current_audio_position_ + samples_needed;
+
+        // Advance position by hop size (based on overlap)
+        current_audio_position_ += hop_size;
+    }
+    else { // InputMode::Live
+        // LIVE MODE: Read the next hop from AudioEngine ring buffer
+        if (!audio_engine_ || !audio_engine_->isRunning()) {
+            return false; // No audio available
+        }
+
+        if (active_transfer_) {
+            return processTransferFrame();
+        }
+        if (active_multichannel_) {
+            return processMultichannelFrame();
+        }
+
+        auto& live_buffer = audio_engine_->getRingBuffer();
+        const uint64_t read_start = StageProfiler::now();
+        ReadStatus status = live_buffer.readWindow(live_cursor_, chain.fft_input.data(),
+                                                   samples_needed, hop_size);
+
+        if (status == ReadStatus::Overrun) {
+            // Writer lapped us; the skipped hops will never be analyzed
+            uint64_t lost = live_cursor_.getSamplesLost();
+            dropped_columns_.fetch_add((lost - live_samples_lost_) / hop_size,
+                                       std::memory_order_relaxed);
+            live_samples_lost_ = lost;
+        }
+
+        if (status == ReadStatus::NotReady) {
+            return false; // Next window not complete yet
+        }
+        // Only reads that produce a window are timed, not the polling
+        profiler_.record(ProfileStage::Read, read_start, StageProfiler::now() - read_start);
+        window_end = live_cursor_.position() - hop_size + samples_needed;
+    }
+
+    // Zoom and multi-resolution chains produce the column themselves
+    if (!chain.analyze(profiler_)) {
+        queueColumn(chain.resampled.data(), chain.resampled.size());
+        return true;
+    }
+
+    emitColumn(chain.fft_output.data(), window_end);
+    return true;
+}
+
+bool FritureApp::processMultichannelFrame() {
+    MultiChannelAnalyzer& analyzer = *active_multichannel_;
+    const size_t channels = analyzer.getChannelCount();
+    const size_t samples_needed = analyzer.chain(0).getKey().fft_size;
+    const size_t hop_size = analyzer.getHopSize();
+    const size_t lead = channels - 1;
+
+    // The lead channel decides whether the next window is complete
+    const uint64_t read_start = StageProfiler::now();
+    ReadStatus status = audio_engine_->getRingBuffer(lead).readWindow(
+        live_cursor_, analyzer.chain(lead).fft_input.data(), samples_needed, hop_size);
+
+    if (status == ReadStatus::Overrun) {
+        uint64_t lost = live_cursor_.getSamplesLost();
+        dropped_columns_.fetch_add((lost - live_samples_lost_) / hop_size,
+                                   std::memory_order_relaxed);
+        live_samples_lost_ = lost;
+    }
+
+    if (status == ReadStatus::NotReady) {
+        return false;
+    }
+
+    // Every earlier channel was published before the lead one: read the
+    // same window from each
+    const uint64_t window_start = live_cursor_.position() - hop_size;
+    for (size_t c = 0; c < lead; ++c) {
+        RingBuffer<float>::Cursor cursor(window_start);
+        audio_engine_->getRingBuffer(c).readWindow(
+            cursor, analyzer.chain(c).fft_input.data(), samples_needed, hop_size);
+    }
+    profiler_.record(ProfileStage::Read, read_start, StageProfiler::now() - read_start);
+
+    // FFT + resampling of all channels in parallel, then one display column
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::FFT);
+        analyzer.process();
+    }
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::Resample);
+        analyzer.combine(multichannel_column_.data());
+    }
+    queueColumn(multichannel_column_.data(), multichannel_column_.size());
+    return true;
+}
+
+bool FritureApp::processTransferFrame() {
+    CrossSpectrumAnalyzer& analyzer = *active_transfer_;
+    const size_t samples_needed = analyzer.getKey().fft_size;
+    const size_t hop_size = analyzer.getHopSize();
+
+    // The measured channel decides whether the next window is complete
+    const uint64_t read_start = StageProfiler::now();
+    ReadStatus status = audio_engine_->getRingBuffer(1).readWindow(
+        live_cursor_, analyzer.measured_input.data(), samples_needed, hop_size);
+
+    if (status == ReadStatus::Overrun) {
+        uint64_t lost = live_cursor_.getSamplesLost();
+        dropped_columns_.fetch_add((lost - live_samples_lost_) / hop_size,
+                                   std::memory_order_relaxed);
+        live_samples_lost_ = lost;
+    }
+
+    if (status == ReadStatus::NotReady) {
+        return false;
+    }
+
+    // The reference was published before it: same window
+    RingBuffer<float>::Cursor cursor(live_cursor_.position() - hop_size);
+    audio_engine_->getRingBuffer(0).readWindow(
+        cursor, analyzer.reference_input.data(), samples_needed, hop_size);
+    profiler_.record(ProfileStage::Read, read_start, StageProfiler::now() - read_start);
+
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::FFT);
+        analyzer.process();
+    }
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::Resample);
+        const TransferView view = pipeline_settings_.transfer;
+        analyzer.resample(view, multichannel_column_.data());
+        CrossSpectrumAnalyzer::toDisplayLevels(view, multichannel_column_.data(), multichannel_column_.size(),
+                                               pipeline_settings_.spec_min_db, pipeline_settings_.spec_max_db);
+    }
+    queueColumn(multichannel_column_.data(), multichannel_column_.size());
+    return true;
+}
+
+size_t FritureApp::processFileBatch(size_t max_columns) {
+    ProcessingChain& chain = *active_chain_;
+    const size_t fft_size = chain.getKey().fft_size;
+    const size_t hop_size = chain.getHopSize();
+    const size_t num_bins = fft_size / 2 + 1;
+
+    if (chain.multiResolution() || chain.slidingDFT() || chain.zoom()) {
+        // Band schedules differ per column, and sliding and zoom updates
+        // carry state from column to column: one column at a time
+        size_t columns = 0;
+        while (columns < max_columns && processAudioFrame()) {
+            ++columns;
+        }
+        return columns;
+    }
+
+    // Columns whose full window is still inside the file
+    if (current_audio_position_ + fft_size > total_audio_samples_) {
+        return 0;
+    }
+    size_t columns = std::min(max_columns,
+                              (total_audio_samples_ - current_audio_position_ - fft_size) / hop_size + 1);
+
+    // One contiguous read covers all overlapping frames
+    size_t span = (columns - 1) * hop_size + fft_size;
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::Read, columns);
+        readFileSamples(current_audio_position_, chain.batch_input.data(), span);
+    }
+    const uint64_t first_window_end = current_audio_position_ + fft_size;
+    current_audio_position_ += columns * hop_size;
+
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::FFT, columns);
+        const FrequencyResampler::BinRange range = chain.resampler().getInputRange();
+        chain.fft().processBatch(chain.batch_input.data(), hop_size, columns,
+                                 chain.batch_spectra.data(), num_bins, range.first, range.end);
+    }
+
+    for (size_t c = 0; c < columns; ++c) {
+        emitColumn(chain.batch_spectra.data() + c * num_bins, first_window_end + c * hop_size);
+    }
+    return columns;
+}
+
+size_t FritureApp::processFileBurst(size_t max_columns) {
+    ProcessingChain& chain = *active_chain_;
+    const size_t threads = task_pool_->getThreadCount();
+    if (threads < 2 || chain.multiResolution() || chain.slidingDFT() || chain.zoom() ||
+        peak_detection_.load(std::memory_order_relaxed)) {
+        // The peak detector needs every spectrum in order: batches instead
+        return 0;
+    }
+
+    const ChainKey& key = chain.getKey();
+    const size_t fft_size = key.fft_size;
+    const size_t hop_size = chain.getHopSize();
+    const size_t num_bins = fft_size / 2 + 1;
+    const size_t height = chain.resampled.size();
+
+    if (current_audio_position_ + fft_size > total_audio_samples_) {
+        return 0;
+    }
+    // A backlog of a whole screen (after a stall) can span more than the
+    // streamer's read-ahead: the caller runs the rest as further bursts
+    const size_t columns = std::min({max_columns,
+                                     (total_audio_samples_ - current_audio_position_ - fft_size) / hop_size + 1,
+                                     file_streamer_->getMaxWindows(fft_size, hop_size)});
+    if (columns == 0) {
+        return 0;
+    }
+
+    // Helper chains follow the active key. Rebuilt here, on the first burst
+    // after a settings change (plans come from wisdom), rather than for
+    // every chain the UI thread prewarms
+    if (burst_chains_.size() != threads - 1 || burst_chains_.front()->getKey() != key) {
+        burst_chains_.clear();
+        for (size_t w = 1; w < threads; ++w) {
+            burst_chains_.push_back(std::make_unique<ProcessingChain>(
+                key, std::make_shared<FFTProcessor>(fft_size, key.window, key.kaiser_beta)));
+        }
+    }
+
+    // One contiguous read covers every frame of the burst
+    const size_t span = (columns - 1) * hop_size + fft_size;
+    burst_input_.resize(span);
+    burst_columns_.resize(columns * height);
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::Read, columns);
+        readFileSamples(current_audio_position_, burst_input_.data(), span);
+    }
+    current_audio_position_ += columns * hop_size;
+
+    // FFT and resampling per chunk, straight into the chunk's columns
+    // (both timed as the FFT stage)
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::FFT, columns);
+        task_pool_->parallelFor(columns, ProcessingChain::BATCH_COLUMNS,
+                                [&](size_t worker, size_t begin, size_t end) {
+            ProcessingChain& worker_chain = worker == 0 ? chain : *burst_chains_[worker - 1];
+            const FrequencyResampler::BinRange range = worker_chain.resampler().getInputRange();
+            worker_chain.fft().processBatch(burst_input_.data() + begin * hop_size, hop_size,
+                                            end - begin, worker_chain.batch_spectra.data(),
+                                            num_bins, range.first, range.end);
+            for (size_t c = begin; c < end; ++c) {
+                worker_chain.resampler().resample(
+                    worker_chain.batch_spectra.data() + (c - begin) * num_bins,
+                    burst_columns_.data() + c * height);
+            }
+        });
+    }
+
+    for (size_t c = 0; c < columns; ++c) {
+        queueColumn(burst_columns_.data() + c * height, height);
+    }
+    return columns;
+}
+
+void FritureApp::readFileSamples(size_t position, float* output, size_t count) {
+    // Waits for the streamer thread by design; files are not live input
+    RealtimeExemption exemption;
+    if (!file_streamer_->read(position, output, count)) {
+        std::fill(output, output + count, 0.0f);
+    }
+}
+
+void FritureApp::emitColumn(const float* spectrum_db, uint64_t window_end) {
+    ProcessingChain& chain = *active_chain_;
+    std::span<float> resampled = chain.resampled;
+
+    detectPeaks(spectrum_db, window_end);
+
+    // Frequency resampling
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::Resample);
+        chain.resampler().resample(spectrum_db, resampled.data());
+    }
+    queueColumn(resampled.data(), resampled.size());
+}
+
+void FritureApp::detectPeaks(const float* spectrum_db, uint64_t window_end) {
+    // The detector is built and dropped on the first spectrum after a
+    // settings change: not part of the steady state
+    if (!peak_detection_.load(std::memory_order_relaxed)) {
+        if (peak_detector_) {
+            RealtimeExemption exemption;
+            peak_detector_.reset();   // Fresh floors when turned on again
+        }
+        return;
+    }
+
+    ProcessingChain& chain = *active_chain_;
+    const size_t fft_size = chain.getKey().fft_size;
+    const size_t hop_size = chain.getHopSize();
+    const float sample_rate = static_cast<float>(pipeline_settings_.sample_rate);
+    if (!peak_detector_ || peak_detector_->getFftSize() != fft_size ||
+        peak_detector_->getHopSize() != hop_size || peak_detector_->getSampleRate() != sample_rate) {
+        // Rebuilt here, on the first spectrum after a settings change,
+        // like the burst chains
+        RealtimeExemption exemption;
+        peak_detector_ = std::make_unique<PeakDetector>(fft_size, sample_rate, hop_size);
+    }
+
+    // Only the bins the FFT computed for the resampler are valid
+    const FrequencyResampler::BinRange range = chain.resampler().getInputRange();
+    if (peak_detector_->process(spectrum_db, range.first, range.end, window_end) > 0) {
+        peak_detector_->drainEvents([this](const PeakEvent& event) {
+            if (!peak_events_.tryPush(event)) {
+                dropped_peak_events_.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+}
+
+void FritureApp::drainPeakEvents() {
+    const double sample_rate = settings_.sample_rate;
+    while (peak_events_.popWith([&](const PeakEvent& event) {
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Peak " << toString(event.type) << " #" << event.track
+                  << " at " << static_cast<double>(event.position) / sample_rate << " s: "
+                  << std::setprecision(1) << event.frequency << " Hz, "
+                  << event.level_db << " dB (floor " << event.floor_db << " dB";
+        if (event.type == PeakEventType::Offset) {
+            std::cout << ", " << std::setprecision(3)
+                      << static_cast<double>(event.duration) / sample_rate << " s";
+        }
+        std::cout << ")" << std::defaultfloat << std::endl;
+        // Live positions are ring positions
+        if (capture_ && event.type == PeakEventType::Onset) {
+            capture_->trigger(event.position);
+        }
+    })) {
+    }
+
+    const uint64_t dropped = dropped_peak_events_.load(std::memory_order_relaxed);
+    if (dropped != reported_peak_drops_) {
+        std::cout << "Peak events dropped: " << dropped - reported_peak_drops_ << std::endl;
+        reported_peak_drops_ = dropped;
+    }
+}
+
+void FritureApp::queueColumn(const float* column_db, size_t rows) {
+    if (!averageColumn(column_db, rows)) {
+        return;   // Folded into a later column
+    }
+
+    // Normalize + color transformation in one pass, straight into the next
+    // free queue slot; the render thread adds it to the spectrogram image.
+    // Range-independent levels always go along for the history; with GPU
+    // colormapping they are all that is stored.
+    ScopedStageTimer timer(profiler_, ProfileStage::Colorize);
+    size_t height = spectrogram_image_->getHeight();
+
+    if (rows != height && rows > 0) {
+        // Coarser analysis: stretch to the display rows (linear between row
+        // centers) so the image, history, recording and stream keep one format
+        const float scale = static_cast<float>(rows) / static_cast<float>(height);
+        for (size_t r = 0; r < height; ++r) {
+            const float position = std::clamp((static_cast<float>(r) + 0.5f) * scale - 0.5f,
+                                              0.0f, static_cast<float>(rows - 1));
+            const size_t below = static_cast<size_t>(position);
+            const size_t above = std::min(below + 1, rows - 1);
+            const float t = position - static_cast<float>(below);
+            expanded_column_[r] = column_db[below] + t * (column_db[above] - column_db[below]);
+        }
+        column_db = expanded_column_.data();
+    }
+    bool queued = column_queue_->pushWith([&](QueuedColumn& column) {
+        SpectrogramImage::encodeLevels(column_db, height, column.levels.data());
+        if (!use_gpu_colormap_) {
+            color_transform_->transformColumnDb(column_db, height,
+                                                pipeline_settings_.spec_min_db,
+                                                pipeline_settings_.spec_max_db,
+                                                column.colors.data());
+        }
+    });
+
+    if (!queued) {
+        // Render thread is behind by a full screen; drop rather than block
+        dropped_columns_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        notifyColumnReady();
+    }
+}
+
+bool FritureApp::averageColumn(const float*& column_db, size_t rows) {
+    const SpectrogramSettings& settings = pipeline_settings_;
+    // The transfer function is averaged before its view is taken
+    if (active_transfer_ ||
+        (settings.averaging == AveragingMode::None && settings.column_decimation <= 1)) {
+        if (averager_) {
+            RealtimeExemption exemption;   // First column after a settings change
+            averager_.reset();
+        }
+        return true;
+    }
+
+    SpectralAverager::Options options;
+    options.mode = settings.averaging;
+    options.time_seconds = settings.averaging_time;
+    options.frames = settings.averaging_frames;
+    options.decimation = settings.column_decimation;
+    const size_t hop_size = active_multichannel_ ? active_multichannel_->getHopSize()
+                                                 : active_chain_->getHopSize();
+    const float sample_rate = static_cast<float>(settings.sample_rate);
+
+    if (!averager_ || averager_->getSize() != rows || averager_->getHopSize() != hop_size ||
+        averager_->getSampleRate() != sample_rate ||
+        averager_->getOptions().mode != options.mode ||
+        averager_->getOptions().time_seconds != options.time_seconds ||
+        averager_->getOptions().frames != options.frames ||
+        averager_->getOptions().decimation != options.decimation) {
+        // Rebuilt on the first column after a settings change, like the
+        // peak detector; the average starts over
+        RealtimeExemption exemption;
+        averager_ = std::make_unique<SpectralAverager>(rows, sample_rate, hop_size, options);
+        averaged_column_.resize(rows);
+    }
+
+    ScopedStageTimer timer(profiler_, ProfileStage::Resample);
+    if (!averager_->process(column_db, averaged_column_.data())) {
+        return false;
+    }
+    column_db = averaged_column_.data();
+    return true;
+}
+
+size_t FritureApp::getColumnHop() const {
+    if (settings_.transfer != TransferView::Off && input_mode_ == InputMode::Live &&
+        audio_engine_ && audio_engine_->getChannelCount() >= 2) {
+        return current_chain_->getHopSize();   // Not decimated
+    }
+    return current_chain_->getHopSize() * settings_.column_decimation;
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void FritureApp::renderFrame() {
+    ScopedStageTimer frame_timer(profiler_, ProfileStage::Frame);
+
+    // Clear screen to dark gray
+    SDL_SetRenderDrawColor(renderer_, 30, 30, 30, 255);
+    SDL_RenderClear(renderer_);
+
+    // Take the columns the analysis thread finished since the last frame
+    takeColumns();
+
+    // Meter the live input here rather than in the audio callback
+    if (input_mode_ == InputMode::Live && audio_engine_ && audio_engine_->isRunning()) {
+        level_meter_->update(audio_engine_->getRingBuffer());
+    }
+
+    if (use_gpu_colormap_) {
+        // Levels upload the same dirty spans; the shader applies the current
+        // dB range and palette, so range changes recolor history instantly
+        {
+            ScopedStageTimer timer(profiler_, ProfileStage::Upload);
+            gpu_colormap_->upload(*spectrogram_image_);
+            spectrogram_image_->clearDirty();
+        }
+
+        ScopedStageTimer timer(profiler_, ProfileStage::Draw);
+        SDL_Rect dst = {0, 0, static_cast<int>(spectrogram_image_->getWidth()),
+                        static_cast<int>(spectrogram_image_->getHeight())};
+        gpu_colormap_->draw(dst, spectrogram_image_->getTextureSeam(),
+                            settings_.spec_min_db, settings_.spec_max_db);
+    } else {
+        // Upload only the columns added since the last frame. The texture is a
+        // ring of the same width, and the row-major image rows can be passed to
+        // SDL_UpdateTexture directly, so no full-frame copy or transpose is needed.
+        // A full refresh (first frame, clear, or a screenful behind) is a single
+        // span: the contiguous view at the image's read offset.
+        const uint32_t* pixels = spectrogram_image_->getPixelData();
+        const int texture_width = static_cast<int>(spectrogram_image_->getWidth());
+        const int texture_height = static_cast<int>(spectrogram_image_->getHeight());
+        const int pitch = static_cast<int>(spectrogram_image_->getRowPitch() * sizeof(uint32_t));
+
+        {
+            ScopedStageTimer timer(profiler_, ProfileStage::Upload);
+            ColumnSpan spans[2];
+            size_t num_spans = spectrogram_image_->getDirtySpans(spans);
+            for (size_t i = 0; i < num_spans; ++i) {
+                SDL_Rect rect = {static_cast<int>(spans[i].texture_column), 0,
+                                 static_cast<int>(spans[i].count), texture_height};
+                SDL_UpdateTexture(texture_, &rect, pixels + spans[i].image_column, pitch);
+            }
+            spectrogram_image_->clearDirty();
+        }
+
+        // Scroll by drawing the ring in two pieces: oldest columns [seam, width)
+        // on the left, newest [0, seam) on the right
+        ScopedStageTimer timer(profiler_, ProfileStage::Draw);
+        const int seam = static_cast<int>(spectrogram_image_->getTextureSeam());
+        SDL_Rect old_src = {seam, 0, texture_width - seam, texture_height};
+        SDL_Rect old_dst = {0, 0, texture_width - seam, texture_height};
+        SDL_RenderCopy(renderer_, texture_, &old_src, &old_dst);
+
+        if (seam > 0) {
+            SDL_Rect new_src = {0, 0, seam, texture_height};
+            SDL_Rect new_dst = {texture_width - seam, 0, seam, texture_height};
+            SDL_RenderCopy(renderer_, texture_, &new_src, &new_dst);
+        }
+    }
+
+    // History view covers the live image (which keeps updating underneath)
+    if (history_view_) {
+        ScopedStageTimer timer(profiler_, ProfileStage::Draw);
+        drawHistoryView();
+    } else if (spectrum_view_ != SpectrumView::Off) {
+        ScopedStageTimer timer(profiler_, ProfileStage::Draw);
+        drawSpectrumView();
+    }
+
+    // Draw UI overlay
+    {
+        ScopedStageTimer timer(profiler_, ProfileStage::UI);
+        drawUI(*ui_batch_);
+    }
+
+    // Present
+    ScopedStageTimer timer(profiler_, ProfileStage::Present);
+    SDL_RenderPresent(renderer_);
+}
+
+void FritureApp::takeColumns() {
+    ScopedStageTimer timer(profiler_, ProfileStage::Drain);
+    drainColumnQueue();
+    drainPeakEvents();
+    reportCaptures();
+    if (viewer_) {
+        pollViewer();
+    }
+}
+
+// ============================================================================
+// Adaptive Quality
+// ============================================================================
+
+void FritureApp::enableQualityGovernor(const QualityGovernor::Options& options) {
+    governor_ = std::make_unique<QualityGovernor>(options);
+    governor_options_ = options;
+    governor_baseline_ = profiler_.getSnapshot();
+    governor_window_start_ = std::chrono::steady_clock::now();
+}
+
+void FritureApp::updateQualityGovernor() {
+    if (!governor_) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now - governor_window_start_ < std::chrono::seconds(1)) {
+        return;
+    }
+
+    StageProfileSnapshot current = profiler_.getSnapshot();
+    const double seconds = std::chrono::duration<double>(now - governor_window_start_).count();
+    const bool changed = governor_->update(current.since(governor_baseline_), seconds);
+    governor_baseline_ = current;
+    governor_window_start_ = now;
+
+    if (changed) {
+        applyQualityLevel(governor_->getLevel());
+    }
+}
+
+void FritureApp::applyQualityLevel(const QualityLevel& level) {
+    const bool rows_changed = level.height_divisor != quality_.height_divisor;
+    quality_ = level;
+    redraw_requested_ = true;
+    std::cout << "Quality: redraw 1/" << level.frame_interval
+              << ", analysis rows 1/" << level.height_divisor
+              << (level.minimal_ui ? ", minimal UI" : "") << std::endl;
+
+    // New chains at the new row count; the analysis thread switches at the
+    // next column boundary and queueColumn() stretches them to the image
+    if (rows_changed && !viewer_) {
+        updateProcessingComponents();
+    }
+}
+
+void FritureApp::enableTrace(const std::string& path) {
+    trace_path_ = path;
+    profiler_.enableTrace(path.empty() ? 0 : TRACE_EVENTS_PER_STAGE);
+}
+
+bool FritureApp::setHistoryMemory(size_t bytes) {
+    SpectrogramHistoryConfig config;
+    config.height = spectrogram_image_->getHeight();
+    config.memory_bytes = bytes;
+    try {
+        history_ = std::make_unique<SpectrogramHistory>(config);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Invalid history size: " << e.what() << std::endl;
+        return false;
+    }
+    history_view_ = false;
+    return true;
+}
+
+bool FritureApp::setOverlap(float percent) {
+    if (!settings_.setOverlap(percent)) {
+        std::cerr << "Invalid overlap: " << percent << "%" << std::endl;
+        return false;
+    }
+    updateProcessingComponents();
+    std::cout << "Overlap: " << settings_.overlap_percent << "% (hop "
+              << current_chain_->getHopSize() << " samples"
+              << (current_chain_->slidingDFT() ? ", sliding DFT" : "") << ")" << std::endl;
+    return true;
+}
+
+bool FritureApp::setFrequencyRange(float min_freq, float max_freq) {
+    if (!settings_.setFrequencyRange(min_freq, max_freq)) {
+        std::cerr << "Invalid frequency range: " << min_freq << "-" << max_freq << " Hz" << std::endl;
+        return false;
+    }
+    updateProcessingComponents();
+    std::cout << "Frequency range: " << settings_.min_freq << "-" << settings_.max_freq << " Hz" << std::endl;
+    return true;
+}
+
+void FritureApp::setZoom(bool enabled) {
+    settings_.zoom = enabled;
+    updateProcessingComponents();
+    std::cout << "Zoom FFT: " << (enabled ? "on" : "off");
+    if (const ZoomAnalyzer* zoom = current_chain_->zoom()) {
+        std::cout << " (decimation " << zoom->getDecimation() << ", "
+                  << zoom->getBinSpacing() << " Hz bins, "
+                  << 1000.0f * zoom->getWindowSize() / settings_.sample_rate << " ms window)";
+    } else if (enabled) {
+        std::cout << " (range too wide to zoom)";
+    }
+    std::cout << std::endl;
+}
 
-        case SDLK_5:
-            settings_.freq_scale = FrequencyScale::Octave;
-            updateProcessingComponents();
-            std::cout << "Frequency scale: Octave" << std::endl;
-            break;
+bool FritureApp::setWindow(WindowFunction window, float kaiser_beta) {
+    if (!settings_.setWindow(window, kaiser_beta)) {
+        std::cerr << "Invalid Kaiser beta: " << kaiser_beta << std::endl;
+        return false;
+    }
+    updateProcessingComponents();
+    std::cout << "Window: " << toString(window);
+    if (window == WindowFunction::Kaiser) {
+        std::cout << " (beta " << kaiser_beta << ")";
+    }
+    std::cout << std::endl;
+    return true;
+}
 
-        case SDLK_EQUALS:  // + key
-        case SDLK_PLUS:
-            // Increase FFT size
-            if (settings_.fft_size < 16384) {
-                settings_.fft_size *= 2;
-                updateProcessingComponents();
-                std::cout << "FFT size: " << settings_.fft_size << std::endl;
-            }
-            break;
+void FritureApp::setTransferView(TransferView view) {
+    settings_.transfer = view;
+    updateProcessingComponents();
+    std::cout << "Transfer function: " << toString(view);
+    if (view != TransferView::Off &&
+        (input_mode_ != InputMode::Live || !audio_engine_ || audio_engine_->getChannelCount() < 2)) {
+        std::cout << " (needs live input with --channels 2)";
+    }
+    std::cout << std::endl;
+}
 
-        case SDLK_MINUS:
-            // Decrease FFT size
-            if (settings_.fft_size > 32) {
-                settings_.fft_size /= 2;
-                updateProcessingComponents();
-                std::cout << "FFT size: " << settings_.fft_size << std::endl;
-            }
-            break;
+void FritureApp::setWeighting(WeightingType weighting) {
+    settings_.weighting = weighting;
+    updateProcessingComponents();
+    std::cout << "Weighting: " << toString(weighting) << std::endl;
+}
+
+bool FritureApp::setAveraging(AveragingMode mode, float time_seconds, size_t frames) {
+    if (!settings_.setAveraging(mode, time_seconds, frames)) {
+        std::cerr << "Invalid averaging: " << time_seconds << " s, " << frames << " spectra" << std::endl;
+        return false;
+    }
+    updateProcessingComponents();
+    std::cout << "Averaging: " << toString(mode);
+    if (mode == AveragingMode::Linear) {
+        std::cout << " (" << frames << " spectra)";
+    } else if (mode != AveragingMode::None) {
+        std::cout << " (" << time_seconds << " s)";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+bool FritureApp::setColumnDecimation(size_t hops) {
+    if (!settings_.setColumnDecimation(hops)) {
+        std::cerr << "Invalid column decimation: " << hops << std::endl;
+        return false;
     }
+    updateProcessingComponents();
+    std::cout << "Column decimation: 1 column per " << hops << " hop(s), "
+              << getColumnHop() / settings_.sample_rate * 1000.0f << " ms" << std::endl;
+    return true;
 }
 
-void FritureApp::updateProcessingComponents() {
-    // Recreate components with new settings
-    size_t spectrogram_height = spectrogram_image_->getHeight();
+bool FritureApp::setColormap(ColorTheme theme, float min_db, float max_db) {
+    SpectrogramSettings candidate = settings_;
+    if (!candidate.setAmplitudeRange(min_db, max_db)) {
+        std::cerr << "Invalid dB range: " << min_db << " to " << max_db << std::endl;
+        return false;
+    }
+
+    if (use_gpu_colormap_) {
+        // The shader takes the range per draw; only the palette is uploaded
+        color_transform_->setTheme(theme);
+        gpu_colormap_->setPalette(color_transform_->getPalette());
+        settings_ = candidate;
+    } else {
+        // The analysis thread colors queued columns with color_transform_ and
+        // its settings snapshot: stop it, place what it already produced so
+        // the recolor covers it, then restart with the new snapshot
+        stopAnalysisThread();
+        drainColumnQueue();
+        color_transform_->setTheme(theme);
+        settings_ = candidate;
+        spectrogram_image_->recolor(color_transform_->getPalette(),
+                                    settings_.spec_min_db, settings_.spec_max_db);
+        if (running_) {
+            startAnalysisThread();
+        }
+    }
+    history_dirty_ = true;
+
+    std::cout << "Colormap: " << toString(theme) << ", " << settings_.spec_min_db
+              << " to " << settings_.spec_max_db << " dB" << std::endl;
+    return true;
+}
 
-    fft_processor_ = std::make_unique<FFTProcessor>(
-        settings_.fft_size, settings_.window_type);
+bool FritureApp::startRecording(const std::string& path) {
+    record_path_ = path;
+    record_segment_ = 1;
+    if (!recorder_.start(path, makeRecordingHeader())) {
+        std::cerr << "Recording not started: " << recorder_.getError() << std::endl;
+        return false;
+    }
+    std::cout << "Recording spectrogram to " << path << std::endl;
+    return true;
+}
+
+void FritureApp::stopRecording() {
+    if (!recorder_.isRecording()) {
+        return;
+    }
+    if (recorder_.stop()) {
+        std::cout << "Recorded " << recorder_.getColumnCount() << " columns ("
+                  << recorder_.getBytesWritten() / 1024 << " KB) to " << recorder_.getPath();
+        if (recorder_.getDroppedColumns() > 0) {
+            std::cout << ", " << recorder_.getDroppedColumns() << " dropped";
+        }
+        std::cout << std::endl;
+    } else {
+        std::cerr << "Recording incomplete: " << recorder_.getError() << std::endl;
+    }
+}
+
+RecordingHeader FritureApp::makeRecordingHeader() const {
+    RecordingHeader header;
+    header.fft_size = static_cast<uint32_t>(settings_.fft_size);
+    header.hop_size = static_cast<uint32_t>(getColumnHop());
+    header.sample_rate = settings_.sample_rate;
+    header.scale = settings_.freq_scale;
+    header.min_freq = settings_.min_freq;
+    header.max_freq = settings_.max_freq;
+    header.height = static_cast<uint32_t>(spectrogram_image_->getHeight());
+    return header;
+}
+
+void FritureApp::updateRecordingFormat() {
+    if (!recorder_.isRecording()) {
+        return;
+    }
+    RecordingHeader header = makeRecordingHeader();
+    if (header.sameFormat(recorder_.getHeader())) {
+        return;
+    }
 
-    freq_resampler_ = std::make_unique<FrequencyResampler>(
-        settings_.freq_scale,
-        settings_.min_freq,
-        settings_.max_freq,
-        settings_.sample_rate,
-        settings_.fft_size,
-        spectrogram_height);
+    // Columns still queued from the old chain land in the new file; the
+    // switch is a few columns late at most
+    stopRecording();
+    std::filesystem::path path(record_path_);
+    path.replace_filename(path.stem().string() + "-" + std::to_string(++record_segment_) +
+                          path.extension().string());
+    if (recorder_.start(path.string(), header)) {
+        std::cout << "Column format changed; recording continues in " << path.string() << std::endl;
+    } else {
+        std::cerr << "Recording stopped: " << recorder_.getError() << std::endl;
+    }
+}
 
-    // Resize buffers
-    fft_input_.resize(settings_.fft_size);
-    fft_output_.resize(settings_.fft_size / 2 + 1);
+bool FritureApp::startStreaming(const std::string& address, uint16_t port) {
+    if (!stream_sender_.open(address, port)) {
+        std::cerr << "Streaming not started: " << stream_sender_.getError() << std::endl;
+        return false;
+    }
+    stream_format_ = RecordingHeader();
+    updateStreamFormat();
+    std::cout << "Streaming spectrogram to " << address << ":" << port << " (1 column per "
+              << stream_sender_.getDecimation() << " analyzed)" << std::endl;
+    return true;
+}
 
-    // Clear spectrogram
+bool FritureApp::startViewing(const std::string& address, uint16_t port) {
+    auto viewer = std::make_unique<ColumnStreamReceiver>();
+    if (!viewer->open(address, port)) {
+        std::cerr << "Viewer not started: " << viewer->getError() << std::endl;
+        return false;
+    }
+    stopAnalysisThread();
+    if (audio_engine_ && audio_engine_->isRunning()) {
+        audio_engine_->stop();
+    }
+    viewer_ = std::move(viewer);
+    viewer_format_ = RecordingHeader();
     spectrogram_image_->clear();
+    std::cout << "Viewing spectrogram stream on " << address << ":" << port << std::endl;
+    return true;
 }
 
-// ============================================================================
-// Audio Processing
-// ============================================================================
+void FritureApp::updateStreamFormat() {
+    if (!stream_sender_.isOpen()) {
+        return;
+    }
+    RecordingHeader header = makeRecordingHeader();
+    if (header.sameFormat(stream_format_)) {
+        return;
+    }
+    if (!stream_sender_.setFormat(header)) {
+        std::cerr << "Stream format rejected: " << stream_sender_.getError() << std::endl;
+        return;
+    }
+    stream_format_ = header;
+}
 
-void FritureApp::processAudioFrame() {
-    size_t samples_needed = settings_.fft_size;
+void FritureApp::pollViewer() {
+    const size_t height = spectrogram_image_->getHeight();
+    viewer_levels_.resize(height);
+    if (!use_gpu_colormap_) {
+        viewer_db_.resize(height);
+        viewer_colors_.resize(height);
+    }
 
-    // ========================================================================
-    // Dual-mode data source selection
-    // ========================================================================
+    while (viewer_->poll()) {
+        const ColumnStreamDecoder& decoder = viewer_->decoder();
+        const RecordingHeader& format = decoder.getFormat();
+        if (!format.sameFormat(viewer_format_)) {
+            // Axis labels and the status line describe the sender's analysis
+            viewer_format_ = format;
+            settings_.fft_size = format.fft_size;
+            settings_.freq_scale = format.scale;
+            settings_.min_freq = format.min_freq;
+            settings_.max_freq = format.max_freq;
+            std::cout << "Stream format: FFT " << format.fft_size << ", " << format.height
+                      << " rows, " << 1.0 / format.getSecondsPerColumn() << " columns/s" << std::endl;
+        }
 
-    if (input_mode_ == InputMode::File) {
-        // FILE MODE: Read from pre-loaded ring buffer
-        if (current_audio_position_ + samples_needed > total_audio_samples_) {
-            // Reached end of audio
-            return;
+        // Nearest stream row for each display row
+        const std::vector<uint16_t>& column = decoder.getColumn();
+        for (size_t r = 0; r < height; ++r) {
+            viewer_levels_[r] = column[r * column.size() / height];
         }
 
-        ring_buffer_->read(current_audio_position_, fft_input_.data(), samples_needed);
+        history_->appendLevels(viewer_levels_.data(), height);
+        if (spectrum_view_ != SpectrumView::Off) {
+            spectrum_views_.addColumn(viewer_levels_.data(), height);
+        }
+        if (use_gpu_colormap_) {
+            spectrogram_image_->addColumnLevels(viewer_levels_.data(), height);
+        } else {
+            for (size_t r = 0; r < height; ++r) {
+                viewer_db_[r] = levelToDb(viewer_levels_[r]);
+            }
+            color_transform_->transformColumnDb(viewer_db_.data(), height,
+                                                settings_.spec_min_db, settings_.spec_max_db,
+                                                viewer_colors_.data());
+            spectrogram_image_->addColumn(viewer_colors_.data(), viewer_levels_.data(), height);
+        }
+    }
+}
 
-        // Advance position by hop size (based on overlap)
-        size_t hop_size = settings_.getSamplesPerColumn();
-        current_audio_position_ += hop_size;
+bool FritureApp::setAudioStreamOptions(const AudioStreamOptions& options) {
+    if (audio_init_.valid()) {
+        pending_stream_options_ = options;
+        stream_options_pending_ = true;
+        return true;
+    }
+    if (!audio_engine_) {
+        return false;
     }
-    else { // InputMode::Live
-        // LIVE MODE: Read from AudioEngine ring buffer
-        if (!audio_engine_ || !audio_engine_->isRunning()) {
-            return; // No audio available
-        }
 
-        auto& live_buffer = audio_engine_->getRingBuffer();
-        size_t write_pos = live_buffer.getWritePosition();
+    // A running stream is reopened, which may reallocate the channel rings
+    stopAnalysisThread();
+    bool ok = audio_engine_->setStreamOptions(options);
+    if (!ok) {
+        std::cerr << "Invalid audio stream options: " << audio_engine_->getError() << std::endl;
+    }
+    level_meter_->reset();
+    if (running_) {
+        startAnalysisThread();
+    }
+    return ok;
+}
 
-        // Check if we have enough samples accumulated
-        if (write_pos < samples_needed) {
-            return; // Not enough data yet
+bool FritureApp::setRingDuration(size_t seconds) {
+    if (audio_init_.valid()) {
+        // Applied when the engine is taken over
+        if (seconds == 0) {
+            std::cerr << "Invalid ring duration: 0 s" << std::endl;
+            return false;
         }
+        ring_seconds_ = seconds;
+        std::cout << "Input ring: " << seconds << " s per channel" << std::endl;
+        return true;
+    }
+    if (!audio_engine_) {
+        return false;
+    }
 
-        // Read most recent samples (sliding window for continuous visualization)
-        size_t read_pos = write_pos - samples_needed;
-        live_buffer.read(read_pos, fft_input_.data(), samples_needed);
+    // The rings are reallocated under the analysis thread and capture
+    stopAnalysisThread();
+    const bool ok = audio_engine_->setRingDuration(seconds);
+    if (!ok) {
+        std::cerr << "Invalid ring duration: " << audio_engine_->getError() << std::endl;
+    }
+    if (running_) {
+        startAnalysisThread();
+    }
+    if (ok) {
+        ring_seconds_ = seconds;
+        std::cout << "Input ring: " << seconds << " s per channel" << std::endl;
     }
+    return ok;
+}
 
-    // FFT processing
-    fft_processor_->process(fft_input_.data(), fft_output_.data());
+bool FritureApp::enableCapture(const TriggerCapture::Options& options) {
+    if (!audio_engine_ && !audio_init_.valid()) {
+        std::cerr << "Capture unavailable: no audio input" << std::endl;
+        return false;
+    }
 
-    // Frequency resampling
-    freq_resampler_->resample(fft_output_.data(), resampled_.data());
+    // Pre-trigger audio comes from the rings: keep them long enough
+    const size_t needed = static_cast<size_t>(std::ceil(options.pre_trigger_seconds)) +
+                          CAPTURE_HEADROOM_SECONDS;
+    if (ring_seconds_ < needed && !setRingDuration(needed)) {
+        return false;
+    }
 
-    // Normalize to [0, 1] range
-    size_t height = spectrogram_image_->getHeight();
-    for (size_t i = 0; i < height; ++i) {
-        normalized_[i] = (resampled_[i] - settings_.spec_min_db) /
-                        (settings_.spec_max_db - settings_.spec_min_db);
-        normalized_[i] = std::clamp(normalized_[i], 0.0f, 1.0f);
+    stopAnalysisThread();
+    capture_options_ = options;
+    capture_enabled_ = true;
+    if (running_) {
+        startAnalysisThread();
     }
+    std::cout << "Capture: " << options.pre_trigger_seconds << " s before, "
+              << options.post_trigger_seconds << " s after each trigger to "
+              << options.directory << std::endl;
+    return true;
+}
 
-    // Color transformation
-    color_transform_->transformColumn(normalized_.data(), height, colors_.data());
+void FritureApp::startCapture() {
+    if (!capture_enabled_ || capture_ || input_mode_ != InputMode::Live ||
+        !audio_engine_ || !audio_engine_->isRunning()) {
+        return;
+    }
 
-    // Add column to spectrogram image
-    spectrogram_image_->addColumn(colors_.data(), height);
+    std::vector<const RingBuffer<float>*> channels;
+    for (size_t c = 0; c < audio_engine_->getChannelCount(); ++c) {
+        channels.push_back(&audio_engine_->getRingBuffer(c));
+    }
+    try {
+        capture_ = std::make_unique<TriggerCapture>(
+            channels, static_cast<uint32_t>(audio_engine_->getSampleRate()), capture_options_);
+        reported_captures_ = 0;
+        capture_error_.clear();
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Capture disabled: " << e.what() << std::endl;
+        capture_enabled_ = false;
+    }
 }
 
-// ============================================================================
-// Rendering
-// ============================================================================
+void FritureApp::reportCaptures() {
+    if (!capture_) {
+        return;
+    }
+    const uint64_t written = capture_->getCapturesWritten();
+    if (written != reported_captures_) {
+        reported_captures_ = written;
+        std::cout << "Captured " << capture_->getLastPath();
+        if (capture_->getSamplesLost() > 0) {
+            std::cout << " (" << capture_->getSamplesLost() << " samples lost so far)";
+        }
+        std::cout << std::endl;
+    }
+    const std::string error = capture_->getError();
+    if (!error.empty() && error != capture_error_) {
+        std::cerr << "Capture: " << error << std::endl;
+    }
+    capture_error_ = error;
+}
 
-void FritureApp::renderFrame() {
-    // Clear screen to dark gray
-    SDL_SetRenderDrawColor(renderer_, 30, 30, 30, 255);
-    SDL_RenderClear(renderer_);
+void FritureApp::drawHistoryView() {
+    const size_t width = spectrogram_image_->getWidth();
+    const size_t height = spectrogram_image_->getHeight();
+
+    if (!history_texture_) {
+        history_texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32,
+                                             SDL_TEXTUREACCESS_STREAMING,
+                                             static_cast<int>(width), static_cast<int>(height));
+        if (!history_texture_) {
+            std::cerr << "History texture creation failed: " << SDL_GetError() << std::endl;
+            history_view_ = false;
+            return;
+        }
+        history_levels_.resize(width * height);
+        history_db_.resize(height);
+        history_colors_.resize(height);
+        history_pixels_.resize(width * height);
+    }
 
-    // Update texture with spectrogram pixels
-    const uint32_t* pixels = spectrogram_image_->getPixelData();
-    int texture_width = static_cast<int>(spectrogram_image_->getWidth());
-    int texture_height = static_cast<int>(spectrogram_image_->getHeight());
-
-    // Lock texture and copy pixels
-    void* texture_pixels;
-    int pitch;
-    if (SDL_LockTexture(texture_, nullptr, &texture_pixels, &pitch) == 0) {
-        // Copy pixels - spectrogram image is stored column-major, SDL expects row-major
-        uint32_t* dst = static_cast<uint32_t*>(texture_pixels);
-
-        for (int y = 0; y < texture_height; ++y) {
-            for (int x = 0; x < texture_width; ++x) {
-                // Spectrogram image stores pixels column-major
-                size_t src_idx = x * texture_height + y;
-                size_t dst_idx = y * texture_width + x;
-                dst[dst_idx] = pixels[src_idx];
+    if (history_dirty_) {
+        // The store picks the level; only the window's columns are colorized
+        const uint64_t first = history_end_ - std::min(history_end_, history_span_);
+        history_level_ = history_->render(first, history_span_, width, history_levels_.data());
+
+        for (size_t x = 0; x < width; ++x) {
+            const uint16_t* levels = history_levels_.data() + x * height;
+            for (size_t r = 0; r < height; ++r) {
+                history_db_[r] = levelToDb(levels[r]);
+            }
+            color_transform_->transformColumnDb(history_db_.data(), height,
+                                                settings_.spec_min_db, settings_.spec_max_db,
+                                                history_colors_.data());
+            for (size_t r = 0; r < height; ++r) {
+                history_pixels_[r * width + x] = history_colors_[r];
             }
         }
+        SDL_UpdateTexture(history_texture_, nullptr, history_pixels_.data(),
+                          static_cast<int>(width * sizeof(uint32_t)));
+        history_dirty_ = false;
+    }
+
+    SDL_Rect dst = {0, 0, static_cast<int>(width), static_cast<int>(height)};
+    SDL_RenderCopy(renderer_, history_texture_, nullptr, &dst);
+}
+
+void FritureApp::drawSpectrumView() {
+    const size_t height = spectrogram_image_->getHeight();
 
-        SDL_UnlockTexture(texture_);
+    // Row layout of the displayed columns (the stream's in viewer mode)
+    RecordingHeader format = viewer_ ? viewer_format_ : makeRecordingHeader();
+    format.height = static_cast<uint32_t>(height);
+    format.level_bits = 0;
+    if (format.fft_size == 0) {
+        return; // Viewer without a stream yet
+    }
+    if (!format.sameFormat(spectrum_views_format_)) {
+        FrequencyResampler layout(format.scale, format.min_freq, format.max_freq, format.sample_rate,
+                                  format.fft_size, height);
+        const float bin_hz = format.sample_rate / static_cast<float>(format.fft_size);
+        std::vector<float> row_frequencies = layout.getFrequencyMapping();
+        for (float& frequency : row_frequencies) {
+            frequency *= bin_hz;
+        }
+        spectrum_views_.configure(row_frequencies, bin_hz);
+        spectrum_views_format_ = format;
     }
 
-    // Render texture
-    SDL_Rect dst_rect = {0, 0, window_width_, texture_height};
-    SDL_RenderCopy(renderer_, texture_, nullptr, &dst_rect);
+    if (!spectrum_panel_) {
+        spectrum_panel_ = std::make_unique<SpectrumPanel>(renderer_);
+    }
 
-    // Draw UI overlay
-    drawUI(renderer_);
+    const auto now = std::chrono::steady_clock::now();
+    spectrum_views_.update(std::chrono::duration<float>(now - spectrum_views_time_).count());
+    spectrum_views_time_ = now;
 
-    // Present
-    SDL_RenderPresent(renderer_);
+    // Lower third of the image, clear of the frequency labels
+    const int panel_h = static_cast<int>(height) / 3;
+    const SDL_Rect area = {60, static_cast<int>(height) - panel_h - 10, window_width_ - 80, panel_h};
+    const float min_db = settings_.spec_min_db;
+    const float max_db = settings_.spec_max_db;
+
+    const bool bands = spectrum_view_ == SpectrumView::Bands;
+    const bool drawn = bands ? spectrum_panel_->drawBands(area, spectrum_views_, min_db, max_db)
+                             : spectrum_panel_->drawSpectrum(area, spectrum_views_, min_db, max_db);
+    if (!drawn) {
+        return;
+    }
+
+    const SDL_Color white = {255, 255, 255, 255};
+    const SDL_Color black = {0, 0, 0, 255};
+    char title[64];
+    if (bands) {
+        const std::vector<OctaveBand>& list = spectrum_views_.getBands();
+        std::snprintf(title, sizeof(title), "1/3 octave  %.0f Hz - %.0f Hz",
+                      list.front().center_hz, list.back().center_hz);
+    } else {
+        std::snprintf(title, sizeof(title), "Spectrum  %.0f to %.0f dB", min_db, max_db);
+    }
+    if (text_renderer_ && text_renderer_->isValid()) {
+        text_renderer_->renderTextWithShadow(title, area.x + 6, area.y + 4, white, black, 12, 1);
+    }
 }
 
-void FritureApp::drawUI(SDL_Renderer* renderer) {
+void FritureApp::drawUI(UiBatch& batch) {
     if (!text_renderer_ || !text_renderer_->isValid()) {
         // Fallback to simple colored rectangles if text rendering unavailable
-        drawUIFallback(renderer);
+        batch.begin();
+        drawUIFallback(batch);
+        batch.flush();
         return;
     }
 
+    // Shapes and labels are queued in drawing order and go out in one call
+    text_renderer_->beginBatch(batch);
+
     // Define colors
     SDL_Color white = {255, 255, 255, 255};
     SDL_Color green = {0, 255, 0, 255};
@@ -672,45 +2747,86 @@ void FritureApp::drawUI(SDL_Renderer* renderer) {
     // ========================================================================
 
     // Draw semi-transparent status bar background
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
-    SDL_Rect status_bar = {0, window_height_ - 30, window_width_, 30};
-    SDL_RenderFillRect(renderer, &status_bar);
+    batch.fillRect({0, window_height_ - 30, window_width_, 30}, {0, 0, 0, 200});
 
     // FPS counter (left side)
-    std::string fps_text = "FPS: " + std::to_string(static_cast<int>(fps_));
+    // At a reduced redraw rate: frames actually drawn, and the interval
+    std::string fps_text = "FPS: " + std::to_string(static_cast<int>(fps_ / quality_.frame_interval));
+    if (quality_.frame_interval > 1) {
+        fps_text += " (1/" + std::to_string(quality_.frame_interval) + ")";
+    }
     SDL_Color fps_color = fps_ >= 55.0f ? green : (fps_ >= 30.0f ? yellow : red);
-    text_renderer_->renderTextWithShadow(fps_text, 10, window_height_ - 25,
-                                        fps_color, black, 16, 1);
-
-    // Settings display (center)
-    std::string fft_text = "FFT: " + std::to_string(settings_.fft_size);
-    text_renderer_->renderTextWithShadow(fft_text, 120, window_height_ - 25,
-                                        white, black, 16, 1);
-
-    // Frequency scale
-    const char* scale_names[] = {"Linear", "Log", "Mel", "ERB", "Octave"};
-    int scale_idx = static_cast<int>(settings_.freq_scale);
-    std::string scale_text = "Scale: " + std::string(scale_names[scale_idx]);
-    text_renderer_->renderTextWithShadow(scale_text, 250, window_height_ - 25,
-                                        white, black, 16, 1);
-
-    // Frequency range
-    char freq_range_buf[64];
-    std::snprintf(freq_range_buf, sizeof(freq_range_buf),
-                 "Range: %.0f-%.0f Hz", settings_.min_freq, settings_.max_freq);
-    text_renderer_->renderTextWithShadow(freq_range_buf, 400, window_height_ - 25,
-                                        gray, black, 16, 1);
-
-    // Mode indicator (right side)
-    std::string mode_text = (input_mode_ == InputMode::File) ? "FILE" : "LIVE";
-    SDL_Color mode_color = (input_mode_ == InputMode::File) ? gray : green;
-    text_renderer_->renderTextWithShadow(mode_text, window_width_ - 220,
-                                        window_height_ - 25, mode_color, black, 16, 1);
+    text_renderer_->queueTextWithShadow(batch, fps_text, 10, window_height_ - 25,
+                                              fps_color, black, 16, 1);
+
+    // Settings and mode text (dropped at minimal UI quality)
+    if (!quality_.minimal_ui) {
+        // Settings display (center)
+        std::string fft_text = "FFT: " + std::to_string(settings_.fft_size);
+        if (current_chain_ && current_chain_->multiResolution()) {
+            fft_text += " MR";
+        } else if (current_chain_ && current_chain_->zoom()) {
+            fft_text += " x" + std::to_string(current_chain_->zoom()->getDecimation());
+        }
+        text_renderer_->queueTextWithShadow(batch, fft_text, 120, window_height_ - 25,
+                                                  white, black, 16, 1);
+
+        // Frequency scale
+        const char* scale_names[] = {"Linear", "Log", "Mel", "ERB", "Octave"};
+        int scale_idx = static_cast<int>(settings_.freq_scale);
+        std::string scale_text = "Scale: " + std::string(scale_names[scale_idx]);
+        text_renderer_->queueTextWithShadow(batch, scale_text, 250, window_height_ - 25,
+                                                  white, black, 16, 1);
+
+        // Frequency range
+        char freq_range_buf[64];
+        const char* weighting_tags[] = {"", " (A)", " (B)", " (C)"};
+        std::snprintf(freq_range_buf, sizeof(freq_range_buf), "Range: %.0f-%.0f Hz%s",
+                     settings_.min_freq, settings_.max_freq,
+                     weighting_tags[static_cast<int>(settings_.weighting)]);
+        text_renderer_->queueTextWithShadow(batch, freq_range_buf, 400, window_height_ - 25,
+                                                  gray, black, 16, 1);
+
+        // Mode indicator (right side)
+        std::string mode_text = (input_mode_ == InputMode::File) ? "FILE" : "LIVE";
+        if (input_mode_ == InputMode::Live && settings_.transfer != TransferView::Off &&
+            audio_engine_ && audio_engine_->getChannelCount() >= 2) {
+            const char* transfer_tags[] = {"", " H1", " PHASE", " COH"};
+            mode_text += transfer_tags[static_cast<int>(settings_.transfer)];
+        }
+        SDL_Color mode_color = (input_mode_ == InputMode::File) ? gray : green;
+        text_renderer_->queueTextWithShadow(batch, mode_text, window_width_ - 220,
+                                                  window_height_ - 25, mode_color, black, 16, 1);
+    }
+
+    // Recording indicator (right side): recorded time
+    if (recorder_.isRecording()) {
+        const int seconds = static_cast<int>(recorder_.getColumnCount() *
+                                             recorder_.getHeader().getSecondsPerColumn());
+        char record_buf[32];
+        std::snprintf(record_buf, sizeof(record_buf), "REC %d:%02d:%02d",
+                     seconds / 3600, (seconds / 60) % 60, seconds % 60);
+        text_renderer_->queueTextWithShadow(batch, record_buf, window_width_ - 340,
+                                                  window_height_ - 25, red, black, 16, 1);
+    }
 
     // Paused indicator (right side)
     if (paused_) {
-        text_renderer_->renderTextWithShadow("PAUSED", window_width_ - 90,
-                                            window_height_ - 25, red, black, 16, 1);
+        text_renderer_->queueTextWithShadow(batch, "PAUSED", window_width_ - 90,
+                                                  window_height_ - 25, red, black, 16, 1);
+    }
+
+    // History window position (top left): age of its newest column and span
+    if (history_view_) {
+        const double seconds_per_column = getColumnHop() / settings_.sample_rate;
+        const double age = (history_->getColumnCount() - history_end_) * seconds_per_column;
+        const double span = history_span_ * seconds_per_column;
+        char history_buf[128];
+        std::snprintf(history_buf, sizeof(history_buf),
+                     "HISTORY  -%d:%02d  span %.1f s  (%zux)  <- -> pan, up/down zoom, End: now",
+                     static_cast<int>(age) / 60, static_cast<int>(age) % 60, span,
+                     history_->getLevelFactor(history_level_));
+        text_renderer_->queueTextWithShadow(batch, history_buf, 60, 8, yellow, black, 16, 1);
     }
 
     // ========================================================================
@@ -718,13 +2834,13 @@ void FritureApp::drawUI(SDL_Renderer* renderer) {
     // ========================================================================
 
     if (input_mode_ == InputMode::Live && audio_engine_ && audio_engine_->isRunning()) {
-        // Get input level (RMS)
-        float level = audio_engine_->getInputLevel();
+        // Get input level (RMS) and peak from the render-side meter
+        float level = level_meter_->getRms();
+        float peak = level_meter_->getPeak();
 
         // Draw level meter background
-        SDL_SetRenderDrawColor(renderer, 40, 40, 40, 200);
         SDL_Rect meter_bg = {window_width_ - 140, window_height_ - 50, 120, 12};
-        SDL_RenderFillRect(renderer, &meter_bg);
+        batch.fillRect(meter_bg, {40, 40, 40, 200});
 
         // Draw level meter bar (green -> yellow -> red gradient)
         int meter_width = static_cast<int>(level * 120.0f);
@@ -732,33 +2848,46 @@ void FritureApp::drawUI(SDL_Renderer* renderer) {
 
         if (meter_width > 0) {
             // Color based on level: green < 0.7, yellow < 0.85, red >= 0.85
-            if (level < 0.7f) {
-                SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255); // Green
-            } else if (level < 0.85f) {
-                SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Yellow
-            } else {
-                SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red
-            }
-
-            SDL_Rect level_bar = {window_width_ - 140, window_height_ - 50, meter_width, 12};
-            SDL_RenderFillRect(renderer, &level_bar);
+            SDL_Color bar_color = level < 0.7f ? green : (level < 0.85f ? yellow : red);
+            batch.fillRect({window_width_ - 140, window_height_ - 50, meter_width, 12}, bar_color);
         }
 
+        // Peak tick (white, red once anything clipped)
+        int peak_x = std::clamp(static_cast<int>(peak * 120.0f), 0, 119);
+        batch.drawLine(window_width_ - 140 + peak_x, window_height_ - 50,
+                       window_width_ - 140 + peak_x, window_height_ - 39,
+                       level_meter_->getClipCount() > 0 ? red : white);
+
         // Draw meter border
-        SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-        SDL_RenderDrawRect(renderer, &meter_bg);
+        batch.drawRect(meter_bg, {100, 100, 100, 255});
 
-        // Show device name (above level meter)
-        if (current_device_index_ < available_devices_.size()) {
-            std::string dev_name = available_devices_[current_device_index_].name;
+        // Device name and stream telemetry (dropped at minimal UI quality)
+        if (!quality_.minimal_ui) {
+            // Show device name (above level meter)
+            if (current_device_index_ < available_devices_.size()) {
+                std::string dev_name = available_devices_[current_device_index_].name;
+
+                // Truncate if too long
+                if (dev_name.length() > 25) {
+                    dev_name = dev_name.substr(0, 22) + "...";
+                }
 
-            // Truncate if too long
-            if (dev_name.length() > 25) {
-                dev_name = dev_name.substr(0, 22) + "...";
+                text_renderer_->queueTextWithShadow(batch, dev_name, window_width_ - 320,
+                                                          window_height_ - 50, white, black, 12, 1);
             }
 
-            text_renderer_->renderTextWithShadow(dev_name, window_width_ - 320,
-                                                window_height_ - 50, white, black, 12, 1);
+            // Stream telemetry (status bar): latency, buffer, drops, callback p99
+            CallbackStatsSnapshot stats = audio_engine_->getCallbackStats();
+            char stream_buf[128];
+            std::snprintf(stream_buf, sizeof(stream_buf),
+                         "In: %.1f ms  Buf: %zu  Xruns: %llu  CB p99: %.0f us",
+                         audio_engine_->getInputLatency() * 1000.0,
+                         audio_engine_->getBufferSize(),
+                         static_cast<unsigned long long>(stats.overflows),
+                         stats.percentileMicros(0.99));
+            SDL_Color stream_color = (stats.overflows > 0 || stats.late_callbacks > 0) ? red : gray;
+            text_renderer_->queueTextWithShadow(batch, stream_buf, 600, window_height_ - 23,
+                                                      stream_color, black, 12, 1);
         }
     }
 
@@ -767,47 +2896,74 @@ void FritureApp::drawUI(SDL_Renderer* renderer) {
     // ========================================================================
 
     int spectrogram_height = static_cast<int>(spectrogram_image_->getHeight());
-    int num_labels = 10; // Draw 10 frequency labels
-
-    for (int i = 0; i <= num_labels; ++i) {
-        float t = static_cast<float>(i) / num_labels;
-        int y = static_cast<int>(spectrogram_height * (1.0f - t)); // Flip Y (top = high freq)
-
-        // Calculate frequency at this position based on scale
-        float freq = 0.0f;
-        float min_f = settings_.min_freq;
-        float max_f = settings_.max_freq;
-
-        switch (settings_.freq_scale) {
-            case FrequencyScale::Linear:
-                freq = min_f + t * (max_f - min_f);
-                break;
-            case FrequencyScale::Logarithmic:
-                if (min_f > 0) {
-                    float log_min = std::log10(min_f);
-                    float log_max = std::log10(max_f);
-                    freq = std::pow(10.0f, log_min + t * (log_max - log_min));
+
+    // Stacked multichannel input: one axis per channel lane, channel 0 on top
+    int lanes = 1;
+    if (input_mode_ == InputMode::Live && audio_engine_ && audio_engine_->getChannelCount() > 1 &&
+        settings_.channel_layout == ChannelLayout::Stacked && settings_.transfer == TransferView::Off) {
+        lanes = static_cast<int>(audio_engine_->getChannelCount());
+    }
+    int lane_height = spectrogram_height / lanes;
+    int num_labels = std::max(2, 10 / lanes); // Draw 10 frequency labels in total
+
+    // Labels are dropped at minimal UI quality
+    if (!quality_.minimal_ui) {
+        for (int lane = 0; lane < lanes; ++lane) {
+            int lane_top = lane * lane_height;
+
+            if (lanes > 1) {
+                // Lane separator and channel name
+                batch.drawLine(0, lane_top, window_width_, lane_top, {255, 255, 255, 120});
+                std::string channel_text = "Ch " + std::to_string(lane + 1);
+                text_renderer_->queueTextWithShadow(batch, channel_text, window_width_ - 60, lane_top + 4,
+                                                          white, black, 12, 1);
+            }
+
+            for (int i = 0; i <= num_labels; ++i) {
+                float t = static_cast<float>(i) / num_labels;
+                int y = lane_top + static_cast<int>(lane_height * (1.0f - t)); // Flip Y (top = high freq)
+
+                // Calculate frequency at this position based on scale
+                float freq = 0.0f;
+                float min_f = settings_.min_freq;
+                float max_f = settings_.max_freq;
+
+                switch (settings_.freq_scale) {
+                    case FrequencyScale::Linear:
+                        freq = min_f + t * (max_f - min_f);
+                        break;
+                    case FrequencyScale::Logarithmic:
+                        if (min_f > 0) {
+                            float log_min = std::log10(min_f);
+                            float log_max = std::log10(max_f);
+                            freq = std::pow(10.0f, log_min + t * (log_max - log_min));
+                        }
+                        break;
+                    case FrequencyScale::Mel:
+                    case FrequencyScale::ERB:
+                    case FrequencyScale::Octave:
+                        // Approximate - just use linear for now
+                        freq = min_f + t * (max_f - min_f);
+                        break;
                 }
-                break;
-            case FrequencyScale::Mel:
-            case FrequencyScale::ERB:
-            case FrequencyScale::Octave:
-                // Approximate - just use linear for now
-                freq = min_f + t * (max_f - min_f);
-                break;
-        }
-
-        // Format frequency label
-        char freq_label[32];
-        if (freq >= 1000.0f) {
-            std::snprintf(freq_label, sizeof(freq_label), "%.1fk", freq / 1000.0f);
-        } else {
-            std::snprintf(freq_label, sizeof(freq_label), "%.0f", freq);
+
+                // Format frequency label
+                char freq_label[32];
+                if (freq >= 1000.0f) {
+                    std::snprintf(freq_label, sizeof(freq_label), "%.1fk", freq / 1000.0f);
+                } else {
+                    std::snprintf(freq_label, sizeof(freq_label), "%.0f", freq);
+                }
+
+                // Draw label on left edge
+                text_renderer_->queueTextWithShadow(batch, freq_label, 5, y - 6,
+                                                          white, black, 12, 1);
+            }
         }
+    }
 
-        // Draw label on left edge
-        text_renderer_->renderTextWithShadow(freq_label, 5, y - 6,
-                                            white, black, 12, 1);
+    if (show_profiler_) {
+        drawProfilerOverlay(batch);
     }
 
     // ========================================================================
@@ -816,126 +2972,195 @@ void FritureApp::drawUI(SDL_Renderer* renderer) {
 
     if (show_help_) {
         // Semi-transparent background
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 220);
         int help_w = window_width_ / 2;
         int help_h = window_height_ / 2;
         int help_x = window_width_ / 4;
         int help_y = window_height_ / 4;
         SDL_Rect help_bg = {help_x, help_y, help_w, help_h};
-        SDL_RenderFillRect(renderer, &help_bg);
+        batch.fillRect(help_bg, {0, 0, 0, 220});
 
         // White border
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        SDL_RenderDrawRect(renderer, &help_bg);
+        batch.drawRect(help_bg, white);
 
         // Title
-        text_renderer_->renderTextCentered("Friture C++ - Keyboard Controls",
-                                          window_width_ / 2, help_y + 20,
-                                          white, 20);
+        text_renderer_->queueTextCentered(batch, "Friture C++ - Keyboard Controls",
+                                                window_width_ / 2, help_y + 20,
+                                                white, 20);
 
         // Help text
         int line_y = help_y + 60;
-        int line_spacing = 30;
+        int line_spacing = 22;
+
+        text_renderer_->queueText(batch, "SPACE  - Pause/Resume", help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
+
+        text_renderer_->queueText(batch, "R      - Reset to beginning", help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
+
+        text_renderer_->queueText(batch, "H      - Toggle this help", help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
+
+        text_renderer_->queueText(batch, "L      - Toggle Live/File mode", help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
+
+        text_renderer_->queueText(batch, "D      - Cycle audio input devices", help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
+
+        text_renderer_->queueText(batch, "1-5    - Frequency scale (Linear/Log/Mel/ERB/Octave)",
+                                        help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
+
+        text_renderer_->queueText(batch, "+/- B O - FFT size / multi-res (Log, Octave) / overlap",
+                                        help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
 
-        text_renderer_->renderText("SPACE  - Pause/Resume", help_x + 20, line_y, white, 16);
+        text_renderer_->queueText(batch, "Z      - Zoom FFT into a narrow frequency range",
+                                        help_x + 20, line_y, white, 16);
         line_y += line_spacing;
 
-        text_renderer_->renderText("R      - Reset to beginning", help_x + 20, line_y, white, 16);
+        text_renderer_->queueText(batch, "A      - Bin aggregation (Mean/Peak/Interpolate)",
+                                        help_x + 20, line_y, white, 16);
         line_y += line_spacing;
 
-        text_renderer_->renderText("H      - Toggle this help", help_x + 20, line_y, white, 16);
+        text_renderer_->queueText(batch, "W      - Frequency weighting (None/A/B/C)",
+                                        help_x + 20, line_y, white, 16);
         line_y += line_spacing;
 
-        text_renderer_->renderText("L      - Toggle Live/File mode", help_x + 20, line_y, white, 16);
+        text_renderer_->queueText(batch, "M / F  - Channel layout / transfer function (H1/phase/coh.)",
+                                        help_x + 20, line_y, white, 16);
         line_y += line_spacing;
 
-        text_renderer_->renderText("D      - Cycle audio input devices", help_x + 20, line_y, white, 16);
+        text_renderer_->queueText(batch, "V / S  - History view (arrows pan/zoom) / spectrum, bands",
+                                        help_x + 20, line_y, white, 16);
         line_y += line_spacing;
 
-        text_renderer_->renderText("1-5    - Frequency scale (Linear/Log/Mel/ERB/Octave)",
-                                  help_x + 20, line_y, white, 16);
+        text_renderer_->queueText(batch, "P      - Per-stage latency overlay (p50/p99)",
+                                        help_x + 20, line_y, white, 16);
         line_y += line_spacing;
 
-        text_renderer_->renderText("+/-    - FFT size", help_x + 20, line_y, white, 16);
+        text_renderer_->queueText(batch, "G      - Adaptive quality (lower redraw rate / rows when slow)",
+                                        help_x + 20, line_y, white, 16);
         line_y += line_spacing;
 
-        text_renderer_->renderText("Q/ESC  - Quit", help_x + 20, line_y, white, 16);
+        text_renderer_->queueText(batch, "K      - Log tonal peak onsets/offsets to the console",
+                                        help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
+
+        text_renderer_->queueText(batch, "E / X  - Averaging (None/Exp/Linear/Peak) / hops per column",
+                                        help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
+
+        text_renderer_->queueText(batch, "C [ ]  - Color theme / shift dB range 10 dB down, up",
+                                        help_x + 20, line_y, white, 16);
+        line_y += line_spacing;
+
+        text_renderer_->queueText(batch, "Q/ESC  - Quit", help_x + 20, line_y, white, 16);
         line_y += line_spacing;
 
         // Footer
-        text_renderer_->renderTextCentered("Press H to close",
-                                          window_width_ / 2, help_y + help_h - 40,
-                                          gray, 14);
+        text_renderer_->queueTextCentered(batch, "Press H to close",
+                                                window_width_ / 2, help_y + help_h - 40,
+                                                gray, 14);
+    }
+
+    batch.flush();
+}
+
+void FritureApp::drawProfilerOverlay(UiBatch& batch) {
+    // Percentiles over the last completed second; the first second after
+    // toggling shows an empty table rather than numbers since startup
+    auto now = std::chrono::steady_clock::now();
+    if (now - profile_window_start_ >= std::chrono::seconds(1)) {
+        StageProfileSnapshot current = profiler_.getSnapshot();
+        profile_window_ = current.since(profile_baseline_);
+        profile_baseline_ = current;
+        profile_window_start_ = now;
+    }
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color yellow = {255, 255, 0, 255};
+    SDL_Color red = {255, 0, 0, 255};
+    SDL_Color gray = {180, 180, 180, 255};
+
+    const int line_spacing = 16;
+    const int panel_w = 330;
+    const int panel_h = 44 + line_spacing * static_cast<int>(StageProfiler::STAGE_COUNT);
+    const int panel_x = window_width_ - panel_w - 10;
+    const int panel_y = 10;
+
+    SDL_Rect panel = {panel_x, panel_y, panel_w, panel_h};
+    batch.fillRect(panel, {0, 0, 0, 200});
+    batch.drawRect(panel, {100, 100, 100, 255});
+
+    text_renderer_->queueText(batch, "Stage        n/s     p50     p99     max (us)",
+                                     panel_x + 8, panel_y + 6, yellow, 12);
+
+    // A render stage whose p99 exceeds a 60 Hz frame is what drops frames
+    const double frame_budget_us = 1000000.0 / 60.0;
+    int line_y = panel_y + 26;
+    for (size_t i = 0; i < StageProfiler::STAGE_COUNT; ++i) {
+        const ProfileStage stage = static_cast<ProfileStage>(i);
+        const StageStatsSnapshot& stats = profile_window_[stage];
+        if (stage == ProfileStage::Drain) {
+            line_y += 4;  // Gap between analysis and render thread stages
+        }
+
+        char line[96];
+        std::snprintf(line, sizeof(line), "%-10s %5llu %7.0f %7.0f %7.0f",
+                      toString(stage), static_cast<unsigned long long>(stats.count),
+                      stats.percentileMicros(0.50), stats.percentileMicros(0.99),
+                      stats.maxMicros());
+        SDL_Color color = isAnalysisStage(stage) ? white : gray;
+        if (!isAnalysisStage(stage) && stats.percentileMicros(0.99) > frame_budget_us) {
+            color = red;
+        }
+        text_renderer_->queueText(batch, line, panel_x + 8, line_y, color, 12);
+        line_y += line_spacing;
     }
 }
 
-void FritureApp::drawUIFallback(SDL_Renderer* renderer) {
+void FritureApp::drawUIFallback(UiBatch& batch) {
     // Fallback UI using colored rectangles (no text)
+    const SDL_Color green = {0, 255, 0, 255};
+    const SDL_Color yellow = {255, 255, 0, 255};
+    const SDL_Color red = {255, 0, 0, 255};
 
     // Status bar background
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
-    SDL_Rect status_bar = {0, window_height_ - 30, window_width_, 30};
-    SDL_RenderFillRect(renderer, &status_bar);
+    batch.fillRect({0, window_height_ - 30, window_width_, 30}, {0, 0, 0, 200});
 
     // FPS indicator (simple colored bar)
     int fps_width = static_cast<int>(fps_ * 2); // 60 FPS = 120 pixels
     fps_width = std::clamp(fps_width, 0, 200);
 
     // Color based on performance
-    if (fps_ >= 55.0f) {
-        SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255); // Green
-    } else if (fps_ >= 30.0f) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Yellow
-    } else {
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red
-    }
-
-    SDL_Rect fps_bar = {10, window_height_ - 20, fps_width, 10};
-    SDL_RenderFillRect(renderer, &fps_bar);
+    SDL_Color fps_color = fps_ >= 55.0f ? green : (fps_ >= 30.0f ? yellow : red);
+    batch.fillRect({10, window_height_ - 20, fps_width, 10}, fps_color);
 
-    // Mode indicator (colored square)
-    if (input_mode_ == InputMode::Live) {
-        SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255); // Green for LIVE
-    } else {
-        SDL_SetRenderDrawColor(renderer, 128, 128, 128, 255); // Gray for FILE
-    }
-    SDL_Rect mode_indicator = {window_width_ - 100, window_height_ - 25, 20, 20};
-    SDL_RenderFillRect(renderer, &mode_indicator);
+    // Mode indicator (colored square): green for LIVE, gray for FILE
+    SDL_Color mode_color = input_mode_ == InputMode::Live ? green : SDL_Color{128, 128, 128, 255};
+    batch.fillRect({window_width_ - 100, window_height_ - 25, 20, 20}, mode_color);
 
     // Paused indicator
     if (paused_) {
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-        SDL_Rect pause_indicator = {window_width_ - 50, window_height_ - 25, 40, 20};
-        SDL_RenderFillRect(renderer, &pause_indicator);
+        batch.fillRect({window_width_ - 50, window_height_ - 25, 40, 20}, red);
     }
 
     // Level meter for live mode (simple bar)
     if (input_mode_ == InputMode::Live && audio_engine_ && audio_engine_->isRunning()) {
-        float level = audio_engine_->getInputLevel();
+        float level = level_meter_->getRms();
         int meter_width = static_cast<int>(level * 100.0f);
         meter_width = std::clamp(meter_width, 0, 100);
 
-        if (level < 0.7f) {
-            SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-        } else if (level < 0.85f) {
-            SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-        } else {
-            SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-        }
-
-        SDL_Rect level_bar = {window_width_ - 120, window_height_ - 45, meter_width, 10};
-        SDL_RenderFillRect(renderer, &level_bar);
+        SDL_Color level_color = level < 0.7f ? green : (level < 0.85f ? yellow : red);
+        batch.fillRect({window_width_ - 120, window_height_ - 45, meter_width, 10}, level_color);
     }
 
     // Help overlay
     if (show_help_) {
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 220);
         SDL_Rect help_bg = {window_width_ / 4, window_height_ / 4,
-                           window_width_ / 2, window_height_ / 2};
-        SDL_RenderFillRect(renderer, &help_bg);
-
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        SDL_RenderDrawRect(renderer, &help_bg);
+                            window_width_ / 2, window_height_ / 2};
+        batch.fillRect(help_bg, {0, 0, 0, 220});
+        batch.drawRect(help_bg, {255, 255, 255, 255});
     }
 }
 
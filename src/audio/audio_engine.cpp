@@ -4,10 +4,13 @@
  */
 
 #include <friture/audio/audio_engine.hpp>
+#include <friture/realtime_check.hpp>
 #include <RtAudio.h>
 #include <iostream>
-#include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
 
 namespace friture {
 
@@ -18,21 +21,31 @@ namespace friture {
 AudioEngine::AudioEngine(size_t sample_rate,
                         size_t buffer_size,
                         size_t ring_buffer_seconds)
+    : AudioEngine(sample_rate, AudioStreamOptions{.buffer_frames = buffer_size}, ring_buffer_seconds)
+{
+}
+
+AudioEngine::AudioEngine(size_t sample_rate,
+                        const AudioStreamOptions& options,
+                        size_t ring_buffer_seconds)
     : sample_rate_(sample_rate),
-      buffer_size_(buffer_size),
+      buffer_size_(options.buffer_frames),
+      options_(options),
+      period_ns_(0),
+      ring_buffer_seconds_(ring_buffer_seconds),
       current_device_id_(0),
       device_set_(false),
       is_running_(false),
-      input_level_(0.0f)
+      input_latency_seconds_(0.0)
 {
     audio_ = std::make_unique<RtAudio>();
 
     // Show warnings to help with debugging
     audio_->showWarnings(true);
 
-    // Create ring buffer
+    // Create ring buffer (channel 0; more are added when a stream opens)
     size_t ring_buffer_size = sample_rate * ring_buffer_seconds;
-    ring_buffer_ = std::make_unique<RingBuffer<float>>(ring_buffer_size);
+    ring_buffers_.push_back(std::make_unique<RingBuffer<float>>(ring_buffer_size));
 
     std::cout << "AudioEngine initialized" << std::endl;
     std::cout << "  Sample rate: " << sample_rate_ << " Hz" << std::endl;
@@ -129,13 +142,38 @@ bool AudioEngine::start() {
         device_set_ = true;
     }
 
+    // Capture as many of the requested channels as the device has
+    unsigned int device_channels = audio_->getDeviceInfo(current_device_id_).inputChannels;
+    unsigned int channels = std::max(1u, std::min(options_.channels, device_channels));
+
+    // The callback is not running: the ring set can be resized safely
+    if (ring_buffers_.size() != channels) {
+        ring_buffers_.resize(1);
+        while (ring_buffers_.size() < channels) {
+            ring_buffers_.push_back(std::make_unique<RingBuffer<float>>(
+                sample_rate_ * ring_buffer_seconds_));
+        }
+    }
+
     // Set up stream parameters
     RtAudio::StreamParameters input_params;
     input_params.deviceId = current_device_id_;
-    input_params.nChannels = 1; // Mono
+    input_params.nChannels = channels;
     input_params.firstChannel = 0;
 
-    unsigned int buffer_frames = static_cast<unsigned int>(buffer_size_);
+    unsigned int buffer_frames = static_cast<unsigned int>(options_.buffer_frames);
+    const size_t device_rate = getDeviceSampleRate();
+
+    RtAudio::StreamOptions stream_options;
+    stream_options.streamName = "Friture";
+    stream_options.numberOfBuffers = options_.number_of_buffers;
+    if (options_.minimize_latency) {
+        stream_options.flags |= RTAUDIO_MINIMIZE_LATENCY;
+    }
+    if (options_.schedule_realtime) {
+        stream_options.flags |= RTAUDIO_SCHEDULE_REALTIME;
+        stream_options.priority = options_.priority;
+    }
 
     // Open stream - throws exception on error in RtAudio 5.x
     try {
@@ -143,10 +181,11 @@ bool AudioEngine::start() {
             nullptr,          // No output
             &input_params,    // Input parameters
             RTAUDIO_FLOAT32,  // Sample format
-            static_cast<unsigned int>(sample_rate_),
-            &buffer_frames,
+            static_cast<unsigned int>(device_rate),
+            &buffer_frames,   // In: requested, out: granted
             &AudioEngine::audioCallback,
-            this              // User data
+            this,             // User data
+            &stream_options
         );
     } catch (RtAudioError& e) {
         error_message_ = "Failed to open stream: " + std::string(e.what());
@@ -154,6 +193,34 @@ bool AudioEngine::start() {
         return false;
     }
 
+    // The callback has not run yet: safe to reset its counters and size
+    // the conversion buffers for the granted block here
+    buffer_size_ = buffer_frames;
+    period_ns_ = static_cast<uint64_t>(buffer_frames) * 1000000000ull / device_rate;
+    callback_stats_.reset();
+
+    converters_.clear();
+    size_t converter_latency = 0;
+    if (device_rate != sample_rate_) {
+        try {
+            for (unsigned int c = 0; c < channels; ++c) {
+                converters_.push_back(std::make_unique<SampleRateConverter>(
+                    static_cast<uint32_t>(device_rate), static_cast<uint32_t>(sample_rate_)));
+                converters_.back()->reserve(buffer_size_);
+            }
+        } catch (const std::invalid_argument& e) {
+            error_message_ = "Cannot convert " + std::to_string(device_rate) + " Hz to " +
+                             std::to_string(sample_rate_) + " Hz: " + e.what();
+            std::cerr << error_message_ << std::endl;
+            converters_.clear();
+            audio_->closeStream();
+            return false;
+        }
+        channel_scratch_.assign(buffer_size_, 0.0f);
+        converted_scratch_.assign(converters_[0]->getMaxOutput(buffer_size_), 0.0f);
+        converter_latency = converters_[0]->getLatency();
+    }
+
     // Start stream - throws exception on error in RtAudio 5.x
     try {
         audio_->startStream();
@@ -164,10 +231,32 @@ bool AudioEngine::start() {
         return false;
     }
 
+    // Device latency is only known once the stream runs (0 if unsupported)
+    long device_latency = 0;
+    try {
+        device_latency = audio_->getStreamLatency();
+    } catch (RtAudioError&) {
+        device_latency = 0;
+    }
+    input_latency_seconds_.store(
+        static_cast<double>(device_latency + static_cast<long>(buffer_size_ + converter_latency)) /
+            static_cast<double>(device_rate),
+        std::memory_order_relaxed);
+
     is_running_ = true;
     error_message_.clear();
 
     std::cout << "Audio stream started on device " << current_device_id_ << std::endl;
+    std::cout << "  Channels: " << channels << std::endl;
+    if (!converters_.empty()) {
+        std::cout << "  Sample rate: " << device_rate << " Hz, converted to "
+                  << sample_rate_ << " Hz (" << converters_[0]->getTapCount() << " taps)" << std::endl;
+    }
+    std::cout << "  Buffer: " << buffer_size_ << " frames"
+              << " x " << stream_options.numberOfBuffers << " buffers"
+              << (options_.minimize_latency ? ", minimize latency" : "")
+              << (options_.schedule_realtime ? ", realtime" : "") << std::endl;
+    std::cout << "  Input latency: " << getInputLatency() * 1000.0 << " ms" << std::endl;
     return true;
 }
 
@@ -184,9 +273,66 @@ void AudioEngine::stop() {
     }
 
     is_running_ = false;
+    input_latency_seconds_.store(0.0, std::memory_order_relaxed);
     std::cout << "Audio stream stopped" << std::endl;
 }
 
+bool AudioEngine::setStreamOptions(const AudioStreamOptions& options) {
+    if (options.buffer_frames == 0) {
+        error_message_ = "Buffer size must be > 0";
+        return false;
+    }
+
+    options_ = options;
+    if (!is_running_) {
+        buffer_size_ = options.buffer_frames;
+        return true;
+    }
+
+    // Options are fixed once open; reopen with the new ones
+    stop();
+    return start();
+}
+
+bool AudioEngine::setSampleRate(size_t sample_rate) {
+    if (sample_rate == 0) {
+        error_message_ = "Sample rate must be > 0";
+        return false;
+    }
+
+    const bool was_running = is_running_;
+    stop();
+
+    // Rings hold ring_buffer_seconds_ at the new rate
+    sample_rate_ = sample_rate;
+    reallocateRings();
+
+    return was_running ? start() : true;
+}
+
+bool AudioEngine::setRingDuration(size_t seconds) {
+    if (seconds == 0) {
+        error_message_ = "Ring duration must be > 0";
+        return false;
+    }
+
+    const bool was_running = is_running_;
+    stop();
+
+    ring_buffer_seconds_ = seconds;
+    reallocateRings();
+
+    return was_running ? start() : true;
+}
+
+void AudioEngine::reallocateRings() {
+    const size_t channels = ring_buffers_.size();
+    ring_buffers_.clear();
+    for (size_t c = 0; c < channels; ++c) {
+        ring_buffers_.push_back(std::make_unique<RingBuffer<float>>(sample_rate_ * ring_buffer_seconds_));
+    }
+}
+
 bool AudioEngine::isRunning() const {
     return is_running_.load();
 }
@@ -205,15 +351,11 @@ int AudioEngine::audioCallback(void* output_buffer,
     (void)output_buffer;  // Unused
     (void)stream_time;    // Unused
 
-    // Check for stream errors
-    if (status) {
-        std::cerr << "Audio stream status: ";
-        if (status & RTAUDIO_INPUT_OVERFLOW)
-            std::cerr << "Input overflow! ";
-        if (status & RTAUDIO_OUTPUT_UNDERFLOW)
-            std::cerr << "Output underflow! ";
-        std::cerr << std::endl;
-    }
+    // No allocation or blocking lock from here on (checked with FRITURE_RT_CHECKS)
+    RealtimeScope scope("audio callback");
+
+    // steady_clock::now() is a vDSO read on the platforms we target
+    const auto start = std::chrono::steady_clock::now();
 
     // Get engine instance
     AudioEngine* engine = static_cast<AudioEngine*>(user_data);
@@ -225,31 +367,48 @@ int AudioEngine::audioCallback(void* output_buffer,
     const float* input = static_cast<const float*>(input_buffer);
     engine->processAudioCallback(input, frame_count);
 
+    // Count rather than print: console I/O can block the real-time thread
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    engine->callback_stats_.record(
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+        frame_count, (status & RTAUDIO_INPUT_OVERFLOW) != 0, engine->period_ns_);
+
     return 0; // Continue stream
 }
 
 void AudioEngine::processAudioCallback(const float* input, unsigned int frame_count) {
-    // Write to ring buffer (thread-safe)
-    ring_buffer_->write(input, frame_count);
-
-    // Update input level (RMS)
-    float rms = calculateRMS(input, frame_count);
-    input_level_.store(rms);
-}
-
-// ============================================================================
-// Utility Functions
-// ============================================================================
-
-float AudioEngine::calculateRMS(const float* buffer, size_t count) {
-    if (count == 0) return 0.0f;
+    // Write to the ring buffers; publishing the new totals is the only other
+    // side effect. Readers (analysis, LevelMeter) follow with cursors.
+    const size_t channels = ring_buffers_.size();
+    if (!converters_.empty()) {
+        // Converters are in lockstep, so every channel gets the same count.
+        // Blocks larger than granted are taken in granted-size pieces.
+        const size_t block = channel_scratch_.size();
+        for (size_t done = 0; done < frame_count; done += block) {
+            const size_t frames = std::min<size_t>(block, frame_count - done);
+            for (size_t c = 0; c < channels; ++c) {
+                const float* src = input + done * channels + c;
+                for (size_t i = 0; i < frames; ++i) {
+                    channel_scratch_[i] = src[i * channels];
+                }
+                size_t produced = converters_[c]->process(channel_scratch_.data(), frames,
+                                                          converted_scratch_.data());
+                ring_buffers_[c]->write(converted_scratch_.data(), produced);
+            }
+        }
+        return;
+    }
 
-    float sum_squares = 0.0f;
-    for (size_t i = 0; i < count; ++i) {
-        sum_squares += buffer[i] * buffer[i];
+    if (channels == 1) {
+        ring_buffers_[0]->write(input, frame_count);
+        return;
     }
 
-    return std::sqrt(sum_squares / count);
+    // De-interleave in channel order (readers rely on the last channel
+    // being published last)
+    for (size_t c = 0; c < channels; ++c) {
+        ring_buffers_[c]->writeStrided(input + c, frame_count, channels);
+    }
 }
 
 } // namespace friture
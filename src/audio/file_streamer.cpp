@@ -0,0 +1,169 @@
+/**
+ * @file file_streamer.cpp
+ * @brief Implementation of FileStreamer
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#include <friture/audio/file_streamer.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace friture {
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+FileStreamer::FileStreamer(size_t capacity, size_t block_size)
+    : ring_(capacity),
+      capacity_(capacity),
+      block_size_(block_size)
+{
+    if (block_size == 0) {
+        throw std::invalid_argument("Block size must be > 0");
+    }
+    if (capacity < 2 * block_size) {
+        throw std::invalid_argument("Capacity must be at least two blocks");
+    }
+    block_.resize(block_size);
+}
+
+FileStreamer::~FileStreamer() {
+    stopProducer();
+}
+
+// ============================================================================
+// Control
+// ============================================================================
+
+void FileStreamer::start(Source source, uint64_t length) {
+    stopProducer();
+    source_ = std::move(source);
+    length_ = source_ ? length : 0;
+    restartAt(0);
+}
+
+void FileStreamer::stop() {
+    stopProducer();
+    source_ = nullptr;
+    length_ = 0;
+}
+
+void FileStreamer::stopProducer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    space_cv_.notify_all();
+    if (producer_.joinable()) {
+        producer_.join();
+    }
+}
+
+void FileStreamer::restartAt(uint64_t position) {
+    stopProducer();
+    {
+        // Continue the ring stream where it is; earlier contents are stale
+        std::lock_guard<std::mutex> lock(mutex_);
+        ring_base_ = ring_.getTotalWritten();
+        file_base_ = position;
+        produced_end_ = position;
+        reader_pos_ = position;
+        stopping_ = false;
+    }
+    if (source_) {
+        producer_ = std::thread(&FileStreamer::producerLoop, this);
+    }
+}
+
+// ============================================================================
+// Reader Side
+// ============================================================================
+
+bool FileStreamer::read(uint64_t position, float* output, size_t count) {
+    if (count > getMaxRead()) {
+        throw std::invalid_argument("Read larger than the streaming buffer");
+    }
+    if (!source_ || position + count > length_) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // Rewind, or a jump the producer would need longer than a buffer to reach
+    if (position < reader_pos_ || position > produced_end_ + capacity_) {
+        lock.unlock();
+        restartAt(position);
+        lock.lock();
+    }
+
+    // Everything before position may now be overwritten
+    if (position > reader_pos_) {
+        reader_pos_ = position;
+        space_cv_.notify_one();
+    }
+
+    if (produced_end_ < position + count) {
+        ++stalls_;
+        data_cv_.wait(lock, [&] { return produced_end_ >= position + count; });
+    }
+    const uint64_t ring_index = ring_base_ + (position - file_base_);
+    lock.unlock();
+
+    // The producer never writes over [reader_pos_, produced_end_), so the
+    // copy needs no lock
+    ring_.read(static_cast<size_t>(ring_index % capacity_), output, count);
+    return true;
+}
+
+uint64_t FileStreamer::getLength() const {
+    return length_;
+}
+
+uint64_t FileStreamer::getBufferedEnd() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return produced_end_;
+}
+
+uint64_t FileStreamer::getStallCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stalls_;
+}
+
+// ============================================================================
+// Producer Thread
+// ============================================================================
+
+void FileStreamer::producerLoop() {
+    while (true) {
+        uint64_t position;
+        size_t n;
+        {
+            // Back-pressure: the next block must not reach the reader's position
+            std::unique_lock<std::mutex> lock(mutex_);
+            space_cv_.wait(lock, [this] {
+                return stopping_ ||
+                       (produced_end_ < length_ && produced_end_ + block_size_ <= reader_pos_ + capacity_);
+            });
+            if (stopping_) {
+                return;
+            }
+            position = produced_end_;
+            n = static_cast<size_t>(std::min<uint64_t>(block_size_, length_ - position));
+        }
+
+        size_t got = std::min(source_(position, block_.data(), n), n);
+        std::fill(block_.begin() + got, block_.begin() + n, 0.0f);
+        ring_.write(block_.data(), n);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            produced_end_ = position + n;
+        }
+        data_cv_.notify_one();
+    }
+}
+
+} // namespace friture
@@ -0,0 +1,399 @@
+/**
+ * @file pcm_convert.cpp
+ * @brief Implementation of PCM sample decoding with runtime dispatch
+ *
+ * Like the spectrum kernels, AVX2 code is compiled with function-level
+ * target attributes and chosen by simd::activeIsa(); NEON is selected at
+ * compile time on AArch64. Integer to float conversion is exact for 16 and
+ * 24-bit samples and rounds to nearest for 32-bit ones, and the scale is a
+ * power of two, so every path produces bit-identical results.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#include <friture/audio/pcm_convert.hpp>
+#include <friture/simd_kernels.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define FRITURE_SIMD_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #define FRITURE_TARGET_AVX2
+    #else
+        #define FRITURE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define FRITURE_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace friture {
+namespace pcm {
+
+namespace {
+
+constexpr float INT16_SCALE = 1.0f / 32768.0f;        // 2^-15
+constexpr float INT24_SCALE = 1.0f / 8388608.0f;      // 2^-23
+constexpr float INT32_SCALE = 1.0f / 2147483648.0f;   // 2^-31
+
+// Decoded samples held on the stack by the generic downmix
+constexpr size_t MIX_SCRATCH_SAMPLES = 4096;
+
+// ============================================================================
+// Scalar Kernels
+// ============================================================================
+
+// One descriptor per encoding: encoded size and single-sample decode
+
+struct Int16 {
+    static constexpr size_t BYTES = 2;
+    static float load(const uint8_t* p) {
+        int16_t sample;
+        std::memcpy(&sample, p, sizeof(sample));
+        return static_cast<float>(sample) * INT16_SCALE;
+    }
+};
+
+struct Int24 {
+    static constexpr size_t BYTES = 3;
+    static float load(const uint8_t* p) {
+        // Read 3 bytes as little-endian 24-bit signed integer
+        int32_t sample = (static_cast<int32_t>(p[0])) |
+                         (static_cast<int32_t>(p[1]) << 8) |
+                         (static_cast<int32_t>(p[2]) << 16);
+
+        // Sign extend from 24-bit to 32-bit
+        if (sample & 0x800000) {
+            sample |= static_cast<int32_t>(0xFF000000);
+        }
+        return static_cast<float>(sample) * INT24_SCALE;
+    }
+};
+
+struct Int32 {
+    static constexpr size_t BYTES = 4;
+    static float load(const uint8_t* p) {
+        int32_t sample;
+        std::memcpy(&sample, p, sizeof(sample));
+        return static_cast<float>(sample) * INT32_SCALE;
+    }
+};
+
+struct Float32 {
+    static constexpr size_t BYTES = 4;
+    static float load(const uint8_t* p) {
+        float sample;
+        std::memcpy(&sample, p, sizeof(sample));
+        return sample;
+    }
+};
+
+template <class F>
+void convertScalar(const uint8_t* src, float* dst, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = F::load(src + i * F::BYTES);
+    }
+}
+
+template <class F>
+void mixStereoScalar(const uint8_t* src, float* dst, size_t frames) {
+    for (size_t i = 0; i < frames; ++i) {
+        const uint8_t* frame = src + 2 * i * F::BYTES;
+        dst[i] = (F::load(frame) + F::load(frame + F::BYTES)) * 0.5f;
+    }
+}
+
+// ============================================================================
+// AVX2 Kernels
+// ============================================================================
+
+#if defined(FRITURE_SIMD_X86)
+
+// Bytes past the 8 samples a load8Avx2() may touch, in whole samples; the
+// loops stop early by this much so reads never leave the source range
+template <class F> constexpr size_t AVX2_OVERREAD = 0;
+template <> constexpr size_t AVX2_OVERREAD<Int24> = 2;
+
+FRITURE_TARGET_AVX2
+inline __m256 load8Avx2(Int16, const uint8_t* p) {
+    __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(raw)),
+                         _mm256_set1_ps(INT16_SCALE));
+}
+
+FRITURE_TARGET_AVX2
+inline __m256 load8Avx2(Int24, const uint8_t* p) {
+    // Samples 0-3 come from bytes 0-11 and 4-7 from bytes 12-23; each
+    // 128-bit lane holds four packed samples at its start
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+    __m256i bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+    // Move each sample into the top three bytes of a 32-bit word, then
+    // shift it down arithmetically to sign-extend
+    const __m256i unpack = _mm256_setr_epi8(
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+        -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    __m256i words = _mm256_srai_epi32(_mm256_shuffle_epi8(bytes, unpack), 8);
+
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(words), _mm256_set1_ps(INT24_SCALE));
+}
+
+FRITURE_TARGET_AVX2
+inline __m256 load8Avx2(Int32, const uint8_t* p) {
+    __m256i raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return _mm256_mul_ps(_mm256_cvtepi32_ps(raw), _mm256_set1_ps(INT32_SCALE));
+}
+
+FRITURE_TARGET_AVX2
+inline __m256 load8Avx2(Float32, const uint8_t* p) {
+    return _mm256_loadu_ps(reinterpret_cast<const float*>(p));
+}
+
+template <class F>
+FRITURE_TARGET_AVX2
+void convertAvx2(const uint8_t* src, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 + AVX2_OVERREAD<F> <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, load8Avx2(F{}, src + i * F::BYTES));
+    }
+    convertScalar<F>(src + i * F::BYTES, dst + i, count - i);
+}
+
+template <class F>
+FRITURE_TARGET_AVX2
+void mixStereoAvx2(const uint8_t* src, float* dst, size_t frames) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+
+    size_t i = 0;
+    for (; 2 * i + 16 + AVX2_OVERREAD<F> <= 2 * frames; i += 8) {
+        // Frames 0-3 and 4-7 as interleaved L/R pairs
+        __m256 a = load8Avx2(F{}, src + 2 * i * F::BYTES);
+        __m256 b = load8Avx2(F{}, src + (2 * i + 8) * F::BYTES);
+
+        // hadd sums adjacent pairs per 128-bit lane: [a01 a23 b01 b23 | a45 a67 b45 b67];
+        // the 64-bit permute restores frame order
+        __m256 sums = _mm256_hadd_ps(a, b);
+        sums = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sums), 0xD8));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(sums, half));
+    }
+    mixStereoScalar<F>(src + 2 * i * F::BYTES, dst + i, frames - i);
+}
+
+#endif // FRITURE_SIMD_X86
+
+// ============================================================================
+// NEON Kernels
+// ============================================================================
+
+#if defined(FRITURE_SIMD_NEON)
+
+inline float32x4x4_t load16Neon(Int16, const uint8_t* p) {
+    int16x8_t s0 = vreinterpretq_s16_u8(vld1q_u8(p));
+    int16x8_t s1 = vreinterpretq_s16_u8(vld1q_u8(p + 16));
+
+    float32x4x4_t out;
+    out.val[0] = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s0))), INT16_SCALE);
+    out.val[1] = vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(s0)), INT16_SCALE);
+    out.val[2] = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s1))), INT16_SCALE);
+    out.val[3] = vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(s1)), INT16_SCALE);
+    return out;
+}
+
+inline float32x4_t int24WordsNeon(uint8x16_t low_pairs, uint8x16_t high_pairs, bool upper) {
+    // Zip [0, b0] and [b1, b2] halfwords into [0, b0, b1, b2] words, then
+    // shift down arithmetically to sign-extend
+    uint16x8_t a = vreinterpretq_u16_u8(low_pairs);
+    uint16x8_t b = vreinterpretq_u16_u8(high_pairs);
+    uint16x8_t words = upper ? vzip2q_u16(a, b) : vzip1q_u16(a, b);
+    int32x4_t samples = vshrq_n_s32(vreinterpretq_s32_u16(words), 8);
+    return vmulq_n_f32(vcvtq_f32_s32(samples), INT24_SCALE);
+}
+
+inline float32x4x4_t load16Neon(Int24, const uint8_t* p) {
+    // De-interleave 16 packed samples into low, middle and high bytes
+    uint8x16x3_t bytes = vld3q_u8(p);
+    const uint8x16_t zero = vdupq_n_u8(0);
+
+    uint8x16_t low_first = vzip1q_u8(zero, bytes.val[0]);
+    uint8x16_t high_first = vzip1q_u8(bytes.val[1], bytes.val[2]);
+    uint8x16_t low_second = vzip2q_u8(zero, bytes.val[0]);
+    uint8x16_t high_second = vzip2q_u8(bytes.val[1], bytes.val[2]);
+
+    float32x4x4_t out;
+    out.val[0] = int24WordsNeon(low_first, high_first, false);
+    out.val[1] = int24WordsNeon(low_first, high_first, true);
+    out.val[2] = int24WordsNeon(low_second, high_second, false);
+    out.val[3] = int24WordsNeon(low_second, high_second, true);
+    return out;
+}
+
+inline float32x4x4_t load16Neon(Int32, const uint8_t* p) {
+    float32x4x4_t out;
+    for (int k = 0; k < 4; ++k) {
+        int32x4_t raw = vreinterpretq_s32_u8(vld1q_u8(p + 16 * k));
+        out.val[k] = vmulq_n_f32(vcvtq_f32_s32(raw), INT32_SCALE);
+    }
+    return out;
+}
+
+inline float32x4x4_t load16Neon(Float32, const uint8_t* p) {
+    float32x4x4_t out;
+    for (int k = 0; k < 4; ++k) {
+        out.val[k] = vreinterpretq_f32_u8(vld1q_u8(p + 16 * k));
+    }
+    return out;
+}
+
+template <class F>
+void convertNeon(const uint8_t* src, float* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        float32x4x4_t v = load16Neon(F{}, src + i * F::BYTES);
+        vst1q_f32(dst + i, v.val[0]);
+        vst1q_f32(dst + i + 4, v.val[1]);
+        vst1q_f32(dst + i + 8, v.val[2]);
+        vst1q_f32(dst + i + 12, v.val[3]);
+    }
+    convertScalar<F>(src + i * F::BYTES, dst + i, count - i);
+}
+
+template <class F>
+void mixStereoNeon(const uint8_t* src, float* dst, size_t frames) {
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        // Pairwise add of interleaved L/R gives frames in order
+        float32x4x4_t v = load16Neon(F{}, src + 2 * i * F::BYTES);
+        vst1q_f32(dst + i, vmulq_n_f32(vpaddq_f32(v.val[0], v.val[1]), 0.5f));
+        vst1q_f32(dst + i + 4, vmulq_n_f32(vpaddq_f32(v.val[2], v.val[3]), 0.5f));
+    }
+    mixStereoScalar<F>(src + 2 * i * F::BYTES, dst + i, frames - i);
+}
+
+#endif // FRITURE_SIMD_NEON
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+template <class F>
+void convert(const uint8_t* src, float* dst, size_t count) {
+    switch (simd::activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case simd::Isa::AVX2:
+            convertAvx2<F>(src, dst, count);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case simd::Isa::NEON:
+            convertNeon<F>(src, dst, count);
+            return;
+#endif
+        default:
+            convertScalar<F>(src, dst, count);
+            return;
+    }
+}
+
+template <class F>
+void mixStereo(const uint8_t* src, float* dst, size_t frames) {
+    switch (simd::activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case simd::Isa::AVX2:
+            mixStereoAvx2<F>(src, dst, frames);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case simd::Isa::NEON:
+            mixStereoNeon<F>(src, dst, frames);
+            return;
+#endif
+        default:
+            mixStereoScalar<F>(src, dst, frames);
+            return;
+    }
+}
+
+void mixGeneric(SampleFormat format, const uint8_t* src, float* dst,
+                size_t frames, size_t channels) {
+    // Decode a chunk of frames, then average each frame
+    float scratch[MIX_SCRATCH_SAMPLES];
+    const size_t chunk_frames = MIX_SCRATCH_SAMPLES / channels;
+    const size_t frame_bytes = bytesPerSample(format) * channels;
+    const float scale = 1.0f / static_cast<float>(channels);
+
+    for (size_t done = 0; done < frames; done += chunk_frames) {
+        const size_t n = std::min(chunk_frames, frames - done);
+        toFloat(format, src + done * frame_bytes, scratch, n * channels);
+
+        for (size_t i = 0; i < n; ++i) {
+            const float* frame = scratch + i * channels;
+            float sum = 0.0f;
+            for (size_t c = 0; c < channels; ++c) {
+                sum += frame[c];
+            }
+            dst[done + i] = sum * scale;
+        }
+    }
+}
+
+} // namespace
+
+size_t bytesPerSample(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Int16:   return 2;
+        case SampleFormat::Int24:   return 3;
+        case SampleFormat::Int32:   return 4;
+        case SampleFormat::Float32: return 4;
+        default:                    return 0;
+    }
+}
+
+void int16ToFloat(const uint8_t* src, float* dst, size_t count) {
+    convert<Int16>(src, dst, count);
+}
+
+void int24ToFloat(const uint8_t* src, float* dst, size_t count) {
+    convert<Int24>(src, dst, count);
+}
+
+void int32ToFloat(const uint8_t* src, float* dst, size_t count) {
+    convert<Int32>(src, dst, count);
+}
+
+void float32ToFloat(const uint8_t* src, float* dst, size_t count) {
+    std::memcpy(dst, src, count * sizeof(float));
+}
+
+void toFloat(SampleFormat format, const uint8_t* src, float* dst, size_t count) {
+    switch (format) {
+        case SampleFormat::Int16:   int16ToFloat(src, dst, count); break;
+        case SampleFormat::Int24:   int24ToFloat(src, dst, count); break;
+        case SampleFormat::Int32:   int32ToFloat(src, dst, count); break;
+        case SampleFormat::Float32: float32ToFloat(src, dst, count); break;
+    }
+}
+
+void toFloatMono(SampleFormat format, const uint8_t* src, float* dst,
+                 size_t frames, size_t channels) {
+    if (channels == 1) {
+        toFloat(format, src, dst, frames);
+        return;
+    }
+
+    if (channels == 2) {
+        switch (format) {
+            case SampleFormat::Int16:   mixStereo<Int16>(src, dst, frames); break;
+            case SampleFormat::Int24:   mixStereo<Int24>(src, dst, frames); break;
+            case SampleFormat::Int32:   mixStereo<Int32>(src, dst, frames); break;
+            case SampleFormat::Float32: mixStereo<Float32>(src, dst, frames); break;
+        }
+        return;
+    }
+
+    mixGeneric(format, src, dst, frames, channels);
+}
+
+} // namespace pcm
+} // namespace friture
@@ -0,0 +1,385 @@
+/**
+ * @file trigger_capture.cpp
+ * @brief Implementation of TriggerCapture
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/audio/trigger_capture.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+
+namespace friture {
+
+namespace {
+
+// IEEE float WAV: RIFF, 'fmt ' (18 bytes), 'fact', then 'data'
+constexpr size_t HEADER_BYTES = 58;
+constexpr long RIFF_SIZE_OFFSET = 4;
+constexpr long FACT_FRAMES_OFFSET = 46;
+constexpr long DATA_SIZE_OFFSET = 54;
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 3;
+
+// Writer wakes this often to check for new audio (the audio callback never signals)
+constexpr auto WRITER_POLL_INTERVAL = std::chrono::milliseconds(50);
+
+// Little-endian field access
+
+void putU16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putBytes(std::vector<uint8_t>& out, const char* bytes, size_t count) {
+    out.insert(out.end(), bytes, bytes + count);
+}
+
+bool patchU32(std::FILE* file, long offset, uint32_t value) {
+    std::vector<uint8_t> bytes;
+    putU32(bytes, value);
+    return std::fseek(file, offset, SEEK_SET) == 0 &&
+           std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+}
+
+size_t toSamples(float seconds, uint32_t sample_rate) {
+    return static_cast<size_t>(static_cast<double>(seconds) * sample_rate + 0.5);
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+TriggerCapture::TriggerCapture(const std::vector<const RingBuffer<float>*>& channels,
+                               uint32_t sample_rate, const Options& options)
+    : channels_(channels),
+      sample_rate_(sample_rate),
+      options_(options),
+      pre_samples_(0),
+      post_samples_(0),
+      max_samples_(0),
+      chunk_samples_(0),
+      file_(nullptr),
+      next_number_(1),
+      pending_trigger_(NO_TRIGGER),
+      stop_requested_(false),
+      capturing_(false),
+      captures_written_(0),
+      samples_lost_(0)
+{
+    if (channels.empty() || sample_rate == 0) {
+        throw std::invalid_argument("Capture needs at least one channel and a sample rate > 0");
+    }
+    for (const RingBuffer<float>* ring : channels) {
+        if (!ring) {
+            throw std::invalid_argument("Capture channel ring is null");
+        }
+    }
+    if (!(options.pre_trigger_seconds >= 0.0f) || !(options.post_trigger_seconds >= 0.0f)) {
+        throw std::invalid_argument("Pre- and post-trigger times must be >= 0");
+    }
+    if (!(options.chunk_seconds > 0.0f) || !(options.max_seconds > 0.0f)) {
+        throw std::invalid_argument("Chunk and maximum capture times must be > 0");
+    }
+    if (options.max_seconds < options.pre_trigger_seconds + options.post_trigger_seconds) {
+        throw std::invalid_argument("Maximum capture time is shorter than pre- plus post-trigger time");
+    }
+
+    pre_samples_ = toSamples(options.pre_trigger_seconds, sample_rate);
+    post_samples_ = toSamples(options.post_trigger_seconds, sample_rate);
+    max_samples_ = std::max<size_t>(toSamples(options.max_seconds, sample_rate), 1);
+    chunk_samples_ = std::max<size_t>(toSamples(options.chunk_seconds, sample_rate), 1);
+
+    size_t capacity = std::numeric_limits<size_t>::max();
+    for (const RingBuffer<float>* ring : channels) {
+        capacity = std::min(capacity, ring->capacity());
+    }
+    if (capacity < pre_samples_ + chunk_samples_) {
+        throw std::invalid_argument("Input ring is shorter than the pre-trigger time plus one chunk");
+    }
+
+    // The data chunk size is a 32-bit field
+    const uint64_t max_bytes = static_cast<uint64_t>(max_samples_) * channels.size() * sizeof(float);
+    if (max_bytes > std::numeric_limits<uint32_t>::max() - HEADER_BYTES) {
+        throw std::invalid_argument("Maximum capture time exceeds the 4 GB WAV limit");
+    }
+
+    scratch_.assign(chunk_samples_ * channels.size(), 0.0f);
+    interleaved_.assign(chunk_samples_ * channels.size(), 0.0f);
+
+    writer_ = std::thread(&TriggerCapture::writerLoop, this);
+}
+
+TriggerCapture::~TriggerCapture() {
+    stop();
+}
+
+void TriggerCapture::stop() {
+    if (!writer_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_requested_.store(true, std::memory_order_release);
+    }
+    wake_cv_.notify_one();
+    writer_.join();
+}
+
+// ============================================================================
+// Triggers and status
+// ============================================================================
+
+void TriggerCapture::trigger(uint64_t position) {
+    // Keep the first of several triggers the writer has not taken yet
+    uint64_t expected = NO_TRIGGER;
+    if (pending_trigger_.compare_exchange_strong(expected, position, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cv_.notify_one();
+    }
+}
+
+void TriggerCapture::trigger() {
+    trigger(channels_.back()->getTotalWritten());
+}
+
+std::string TriggerCapture::getLastPath() const {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    return last_path_;
+}
+
+std::string TriggerCapture::getError() const {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    return error_;
+}
+
+void TriggerCapture::setError(const std::string& message) {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    error_ = message;
+}
+
+// ============================================================================
+// Writer thread
+// ============================================================================
+
+void TriggerCapture::wait(bool wake_on_trigger) {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_cv_.wait_for(lock, WRITER_POLL_INTERVAL, [this, wake_on_trigger] {
+        return stop_requested_.load(std::memory_order_acquire) ||
+               (wake_on_trigger && pending_trigger_.load(std::memory_order_acquire) != NO_TRIGGER);
+    });
+}
+
+void TriggerCapture::writerLoop() {
+    uint64_t next = NO_TRIGGER;
+    while (true) {
+        // Checked before taking the trigger: a trigger raised before stop is still written
+        const bool stopping = stop_requested_.load(std::memory_order_acquire);
+        if (next == NO_TRIGGER) {
+            next = pending_trigger_.exchange(NO_TRIGGER, std::memory_order_acq_rel);
+        }
+        if (next != NO_TRIGGER) {
+            next = capture(next);
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+        wait(true);
+    }
+}
+
+uint64_t TriggerCapture::capture(uint64_t position) {
+    const RingBuffer<float>& lead = *channels_.back();
+    const size_t channel_count = channels_.size();
+
+    // Start no older than the rings can still hold a chunk ahead of the writer
+    size_t capacity = std::numeric_limits<size_t>::max();
+    for (const RingBuffer<float>* ring : channels_) {
+        capacity = std::min(capacity, ring->capacity());
+    }
+    const uint64_t total = lead.getTotalWritten();
+    const uint64_t reach = capacity - chunk_samples_;
+    const uint64_t oldest = total > reach ? total - reach : 0;
+    const uint64_t start = std::max(position > pre_samples_ ? position - pre_samples_ : 0, oldest);
+    const uint64_t limit = start + max_samples_;
+    uint64_t end = std::min(std::max(position + post_samples_, start + 1), limit);
+
+    if (!openFile()) {
+        return NO_TRIGGER;
+    }
+    capturing_.store(true, std::memory_order_relaxed);
+
+    RingBuffer<float>::Cursor cursor(start);
+    uint64_t lost = 0;
+    uint64_t frames = 0;
+    uint64_t deferred = NO_TRIGGER;
+    bool ok = true;
+    float* lead_chunk = scratch_.data() + (channel_count - 1) * chunk_samples_;
+
+    while (ok) {
+        // Later triggers extend the file up to the limit; past it they start the next one
+        if (deferred == NO_TRIGGER) {
+            const uint64_t again = pending_trigger_.exchange(NO_TRIGGER, std::memory_order_acq_rel);
+            if (again != NO_TRIGGER) {
+                if (again + post_samples_ <= limit) {
+                    end = std::max(end, again + post_samples_);
+                } else {
+                    deferred = again;
+                }
+            }
+        }
+
+        const uint64_t position_now = cursor.position();
+        if (position_now >= end) {
+            break;
+        }
+        size_t count = static_cast<size_t>(std::min<uint64_t>(chunk_samples_, end - position_now));
+
+        // When stopping, finish with the audio already written
+        if (stop_requested_.load(std::memory_order_acquire)) {
+            const uint64_t written = lead.getTotalWritten();
+            const uint64_t available = written > position_now ? written - position_now : 0;
+            count = static_cast<size_t>(std::min<uint64_t>(count, available));
+            if (count == 0) {
+                break;
+            }
+        }
+
+        const ReadStatus status = lead.readWindow(cursor, lead_chunk, count, count);
+        if (status == ReadStatus::NotReady) {
+            wait(false);
+            continue;
+        }
+        if (status == ReadStatus::Overrun) {
+            lost = cursor.getSamplesLost();
+        }
+
+        // An overrun may have moved the window to the end or past it
+        const uint64_t first = cursor.position() - count;
+        if (first >= end) {
+            break;
+        }
+        const size_t frames_now = static_cast<size_t>(std::min<uint64_t>(count, end - first));
+
+        // The other channels are published before the lead one
+        for (size_t c = 0; c + 1 < channel_count; ++c) {
+            float* chunk = scratch_.data() + c * chunk_samples_;
+            RingBuffer<float>::Cursor follower(first);
+            if (channels_[c]->readWindow(follower, chunk, count, count) != ReadStatus::Ok) {
+                std::fill(chunk, chunk + count, 0.0f);
+            }
+        }
+
+        for (size_t i = 0; i < frames_now; ++i) {
+            for (size_t c = 0; c < channel_count; ++c) {
+                interleaved_[i * channel_count + c] = scratch_[c * chunk_samples_ + i];
+            }
+        }
+        // Samples in host order: little-endian on every supported target
+        const size_t values = frames_now * channel_count;
+        ok = std::fwrite(interleaved_.data(), sizeof(float), values, file_) == values;
+        frames += frames_now;
+    }
+
+    samples_lost_.fetch_add(lost, std::memory_order_relaxed);
+    if (!ok) {
+        setError("Failed to write " + path_);
+    }
+    if (closeFile(frames) && ok) {
+        {
+            std::lock_guard<std::mutex> lock(status_mutex_);
+            last_path_ = path_;
+        }
+        captures_written_.fetch_add(1, std::memory_order_relaxed);
+    }
+    capturing_.store(false, std::memory_order_relaxed);
+    return deferred;
+}
+
+// ============================================================================
+// WAV file
+// ============================================================================
+
+bool TriggerCapture::openFile() {
+    namespace fs = std::filesystem;
+
+    // First free number, so earlier captures are never overwritten
+    std::error_code ec;
+    std::string path;
+    for (;; ++next_number_) {
+        char name[16];
+        std::snprintf(name, sizeof(name), "-%04u.wav", next_number_);
+        path = (fs::path(options_.directory) / (options_.prefix + name)).string();
+        if (!fs::exists(path, ec)) {
+            break;
+        }
+    }
+    ++next_number_;
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        setError("Failed to open " + path + " for writing");
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, FILE_BUFFER_BYTES);
+    path_ = path;
+
+    // Sizes are patched by closeFile()
+    const uint16_t channels = static_cast<uint16_t>(channels_.size());
+    const uint16_t block_align = static_cast<uint16_t>(channels * sizeof(float));
+    std::vector<uint8_t> header;
+    putBytes(header, "RIFF", 4);
+    putU32(header, 0);
+    putBytes(header, "WAVE", 4);
+    putBytes(header, "fmt ", 4);
+    putU32(header, 18);
+    putU16(header, WAVE_FORMAT_IEEE_FLOAT);
+    putU16(header, channels);
+    putU32(header, sample_rate_);
+    putU32(header, sample_rate_ * block_align);
+    putU16(header, block_align);
+    putU16(header, 32);
+    putU16(header, 0);
+    putBytes(header, "fact", 4);
+    putU32(header, 4);
+    putU32(header, 0);
+    putBytes(header, "data", 4);
+    putU32(header, 0);
+
+    if (std::fwrite(header.data(), 1, header.size(), file_) != HEADER_BYTES) {
+        setError("Failed to write " + path);
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool TriggerCapture::closeFile(uint64_t frames) {
+    const uint32_t data_bytes = static_cast<uint32_t>(frames * channels_.size() * sizeof(float));
+    bool ok = patchU32(file_, RIFF_SIZE_OFFSET, static_cast<uint32_t>(HEADER_BYTES - 8) + data_bytes) &&
+              patchU32(file_, FACT_FRAMES_OFFSET, static_cast<uint32_t>(frames)) &&
+              patchU32(file_, DATA_SIZE_OFFSET, data_bytes);
+    ok = (std::fclose(file_) == 0) && ok;
+    file_ = nullptr;
+    if (!ok) {
+        setError("Failed to write " + path_);
+    }
+    return ok;
+}
+
+} // namespace friture
@@ -0,0 +1,367 @@
+/**
+ * @file wav_reader.cpp
+ * @brief Implementation of WavReader
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#include <friture/audio/wav_reader.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace friture {
+
+namespace {
+
+// WAV format constants
+constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+// Frames decoded per step when channels have to be separated or mixed
+constexpr size_t CHUNK_FRAMES = 256;
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+WavReader::WavReader()
+    : data_(nullptr),
+      size_(0),
+#ifdef _WIN32
+      file_handle_(nullptr),
+      mapping_handle_(nullptr),
+#endif
+      info_(),
+      format_(pcm::SampleFormat::Int16),
+      audio_data_(nullptr),
+      frame_bytes_(0),
+      frame_count_(0),
+      released_bytes_(0)
+{
+}
+
+WavReader::~WavReader() {
+    close();
+}
+
+// ============================================================================
+// Mapping
+// ============================================================================
+
+bool WavReader::open(const char* filename) {
+    close();
+    error_.clear();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        setError(std::string("Failed to open file: ") + filename);
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        setError(std::string("Empty or unreadable file: ") + filename);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        setError(std::string("Failed to map file: ") + filename);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        setError(std::string("Failed to map file: ") + filename);
+        return false;
+    }
+
+    file_handle_ = file;
+    mapping_handle_ = mapping;
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        setError(std::string("Failed to open file: ") + filename);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        setError(std::string("Empty or unreadable file: ") + filename);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapped == MAP_FAILED) {
+        setError(std::string("Failed to map file: ") + filename);
+        return false;
+    }
+
+    // Playback reads front to back; let the kernel read ahead aggressively
+    madvise(mapped, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+    data_ = static_cast<const uint8_t*>(mapped);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    if (!parseHeader()) {
+        close();
+        return false;
+    }
+
+    std::cout << "WAV file mapped: " << info_.getFormatDescription() << std::endl;
+    return true;
+}
+
+void WavReader::close() {
+    if (data_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mapping_handle_));
+        CloseHandle(static_cast<HANDLE>(file_handle_));
+        mapping_handle_ = nullptr;
+        file_handle_ = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    audio_data_ = nullptr;
+    frame_bytes_ = 0;
+    frame_count_ = 0;
+    released_bytes_ = 0;
+    info_ = WavInfo();
+}
+
+// ============================================================================
+// Header Parsing
+// ============================================================================
+
+bool WavReader::parseHeader() {
+    if (size_ < 12 || std::memcmp(data_, "RIFF", 4) != 0) {
+        setError("Not a valid RIFF file");
+        return false;
+    }
+    if (std::memcmp(data_ + 8, "WAVE", 4) != 0) {
+        setError("Not a valid WAVE file");
+        return false;
+    }
+
+    bool found_fmt = false;
+    size_t offset = 12;
+
+    // Walk chunks until we find 'fmt ' and 'data'
+    while (offset + 8 <= size_) {
+        const uint8_t* header = data_ + offset;
+        const size_t chunk_size = readU32(header + 4);
+        const uint8_t* body = header + 8;
+        const size_t body_available = size_ - offset - 8;
+
+        if (std::memcmp(header, "fmt ", 4) == 0) {
+            if (chunk_size > body_available || !parseFmtChunk(body, chunk_size)) {
+                if (error_.empty()) {
+                    setError("Truncated 'fmt ' chunk");
+                }
+                return false;
+            }
+            found_fmt = true;
+        } else if (std::memcmp(header, "data", 4) == 0) {
+            if (!found_fmt) {
+                setError("'data' chunk before 'fmt ' chunk");
+                return false;
+            }
+
+            // Recorders may leave the size unpatched; use what is there
+            size_t data_size = std::min(chunk_size, body_available);
+            audio_data_ = body;
+            frame_count_ = data_size / frame_bytes_;
+            info_.num_samples = static_cast<uint32_t>(frame_count_);
+            info_.duration_sec = static_cast<float>(frame_count_) / info_.sample_rate;
+            return true;
+        }
+
+        // Skip chunk (chunks are word-aligned)
+        offset += 8 + chunk_size + (chunk_size % 2);
+    }
+
+    setError(found_fmt ? "Missing 'data' chunk" : "Missing 'fmt ' chunk");
+    return false;
+}
+
+bool WavReader::parseFmtChunk(const uint8_t* chunk, size_t size) {
+    if (size < 16) {
+        setError("Invalid fmt chunk size");
+        return false;
+    }
+
+    uint16_t audio_format = readU16(chunk);
+    uint16_t num_channels = readU16(chunk + 2);
+    uint32_t sample_rate = readU32(chunk + 4);
+    uint16_t bits_per_sample = readU16(chunk + 14);
+
+    // WAVE_FORMAT_EXTENSIBLE: the real format is the sub-format GUID's first word
+    if (audio_format == WAVE_FORMAT_EXTENSIBLE) {
+        if (size < 40) {
+            setError("Invalid extensible fmt chunk");
+            return false;
+        }
+        audio_format = readU16(chunk + 24);
+    }
+
+    if (audio_format == WAVE_FORMAT_PCM && bits_per_sample == 16) {
+        format_ = pcm::SampleFormat::Int16;
+    } else if (audio_format == WAVE_FORMAT_PCM && bits_per_sample == 24) {
+        format_ = pcm::SampleFormat::Int24;
+    } else if (audio_format == WAVE_FORMAT_PCM && bits_per_sample == 32) {
+        format_ = pcm::SampleFormat::Int32;
+    } else if (audio_format == WAVE_FORMAT_IEEE_FLOAT && bits_per_sample == 32) {
+        format_ = pcm::SampleFormat::Float32;
+    } else {
+        setError("Unsupported encoding: format " + std::to_string(audio_format) + ", " +
+                 std::to_string(bits_per_sample) + "-bit");
+        return false;
+    }
+
+    if (num_channels == 0 || num_channels > AudioFileLoader::MAX_CHANNELS) {
+        setError("Unsupported channel count (1 to " +
+                 std::to_string(AudioFileLoader::MAX_CHANNELS) + " supported)");
+        return false;
+    }
+
+    if (sample_rate == 0) {
+        setError("Invalid sample rate");
+        return false;
+    }
+
+    info_.audio_format = audio_format;
+    info_.channels = num_channels;
+    info_.sample_rate = sample_rate;
+    info_.bits_per_sample = bits_per_sample;
+    frame_bytes_ = pcm::bytesPerSample(format_) * num_channels;
+    return true;
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+size_t WavReader::availableFrames(uint64_t first_frame, size_t count) const {
+    if (!data_ || first_frame >= frame_count_) {
+        return 0;
+    }
+    return static_cast<size_t>(std::min<uint64_t>(count, frame_count_ - first_frame));
+}
+
+size_t WavReader::readInterleaved(uint64_t first_frame, float* output, size_t count) const {
+    const size_t frames = availableFrames(first_frame, count);
+    pcm::toFloat(format_, frameAddress(first_frame), output, frames * info_.channels);
+    return frames;
+}
+
+size_t WavReader::readMono(uint64_t first_frame, float* output, size_t count) const {
+    const size_t frames = availableFrames(first_frame, count);
+    if (frames == 0) {
+        return 0;
+    }
+    pcm::toFloatMono(format_, frameAddress(first_frame), output, frames, info_.channels);
+    return frames;
+}
+
+size_t WavReader::readChannel(size_t channel, uint64_t first_frame, float* output, size_t count) const {
+    const size_t channels = info_.channels;
+    if (channel >= channels) {
+        return 0;
+    }
+
+    const size_t frames = availableFrames(first_frame, count);
+    if (channels == 1) {
+        pcm::toFloat(format_, frameAddress(first_frame), output, frames);
+        return frames;
+    }
+
+    float scratch[CHUNK_FRAMES * AudioFileLoader::MAX_CHANNELS];
+
+    for (size_t done = 0; done < frames; done += CHUNK_FRAMES) {
+        const size_t n = std::min(CHUNK_FRAMES, frames - done);
+        pcm::toFloat(format_, frameAddress(first_frame + done), scratch, n * channels);
+
+        for (size_t i = 0; i < n; ++i) {
+            output[done + i] = scratch[i * channels + channel];
+        }
+    }
+    return frames;
+}
+
+void WavReader::releaseBefore(uint64_t frame) {
+    if (!data_) {
+        return;
+    }
+
+    // Whole pages only, counted from the (page-aligned) start of the mapping
+#ifdef _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    const size_t page = system_info.dwPageSize;
+#else
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    const uint64_t end_frame = std::min(frame, frame_count_);
+    const size_t end = static_cast<size_t>(frameAddress(end_frame) - data_) / page * page;
+    if (end <= released_bytes_) {
+        // Rewound: pages from here on may be faulted in again
+        released_bytes_ = end;
+        return;
+    }
+
+    uint8_t* start = const_cast<uint8_t*>(data_) + released_bytes_;
+#ifdef _WIN32
+    // Trims the pages from the working set; they stay in the file cache
+    VirtualUnlock(start, end - released_bytes_);
+#else
+    madvise(start, end - released_bytes_, MADV_DONTNEED);
+#endif
+    released_bytes_ = end;
+}
+
+void WavReader::setError(const std::string& message) {
+    error_ = message;
+    std::cerr << "WavReader error: " << message << std::endl;
+}
+
+} // namespace friture
@@ -6,34 +6,231 @@
  * that demonstrates the complete signal processing pipeline.
  *
  * Usage:
- *   ./friture [audio_file.wav]
+ *   ./friture [--gpu-colormap] [stream options] [audio_file.wav]
+ *   ./friture --fftw-warmup
+ *   ./friture --view ADDR:PORT
  *
  * If no audio file is provided, generates a test chirp signal.
  *
+ * --serve ADDR:PORT publishes the displayed columns over UDP (multicast
+ * group or unicast address); --view ADDR:PORT draws such a stream without
+ * analyzing any audio. On a box without a display, run the sender with
+ * SDL_VIDEODRIVER=dummy.
+ *
  * Controls:
  *   SPACE - Pause/Resume
  *   R     - Reset to beginning
  *   H     - Toggle help
+ *   P     - Per-stage latency overlay
+ *   G     - Adaptive quality (see --governor)
+ *   V     - History view (arrows pan/zoom)
+ *   S     - Spectrum curve / 1/3-octave bars (from the displayed columns)
  *   1-5   - Change frequency scale (Linear/Log/Mel/ERB/Octave)
  *   +/-   - Adjust FFT size
+ *   B     - Multi-resolution low rows (Log/Octave scales)
+ *   Z     - Zoom FFT into a narrow frequency range (see --range)
+ *   O     - Cycle overlap (50% to 98.4%)
+ *   W     - Cycle frequency weighting (None/A/B/C)
+ *   F     - Cycle transfer function view (two live channels)
+ *   E / X - Cycle averaging (None/Exp/Linear/Peak) / hops per column
+ *   T     - Capture live input around now to WAV (see --capture)
+ *   C     - Cycle color theme
+ *   [ / ] - Shift dB range down/up
  *   Q/ESC - Quit
  */
 
 #include <friture/application.hpp>
+#include <friture/fft_wisdom.hpp>
+#include <friture/realtime_check.hpp>
 #include <iostream>
 #include <exception>
+#include <string>
+#include <cstdlib>
+#include <cctype>
+#include <vector>
+
+// Splits "ADDR:PORT"; false if the port is missing or out of range
+bool parseEndpoint(const std::string& text, std::string& address, uint16_t& port) {
+    const size_t colon = text.rfind(':');
+    if (colon == std::string::npos || colon == 0) {
+        return false;
+    }
+    const unsigned long value = std::strtoul(text.c_str() + colon + 1, nullptr, 10);
+    if (value == 0 || value > 65535) {
+        return false;
+    }
+    address = text.substr(0, colon);
+    port = static_cast<uint16_t>(value);
+    return true;
+}
+
+// MODE or MODE:VALUE (seconds for exp and peak, spectra for linear)
+bool parseAveraging(const std::string& text, friture::AveragingMode& mode,
+                    float& time_seconds, size_t& frames) {
+    using friture::AveragingMode;
+    const size_t colon = text.find(':');
+    const std::string name = text.substr(0, colon);
+    if (name == "none") { mode = AveragingMode::None; }
+    else if (name == "exp") { mode = AveragingMode::Exponential; }
+    else if (name == "linear") { mode = AveragingMode::Linear; }
+    else if (name == "peak") { mode = AveragingMode::PeakHold; }
+    else { return false; }
+    if (colon != std::string::npos) {
+        const char* value = text.c_str() + colon + 1;
+        if (mode == AveragingMode::Linear) {
+            frames = std::strtoul(value, nullptr, 10);
+        } else if (mode != AveragingMode::None) {
+            time_seconds = std::strtof(value, nullptr);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// DIR, DIR:PRE or DIR:PRE:POST (seconds); numbers are taken from the right,
+// so a drive letter in DIR is left alone
+bool parseCapture(const std::string& text, friture::TriggerCapture::Options& options) {
+    std::string rest = text;
+    std::vector<float> times;
+    while (times.size() < 2) {
+        const size_t colon = rest.rfind(':');
+        if (colon == std::string::npos) {
+            break;
+        }
+        char* end = nullptr;
+        const char* value = rest.c_str() + colon + 1;
+        const float seconds = std::strtof(value, &end);
+        if (end == value || *end != '\0') {
+            break;
+        }
+        times.insert(times.begin(), seconds);
+        rest.erase(colon);
+    }
+    if (rest.empty()) {
+        return false;
+    }
+    options.directory = rest;
+    if (!times.empty()) {
+        options.pre_trigger_seconds = times[0];
+    }
+    if (times.size() > 1) {
+        options.post_trigger_seconds = times[1];
+    }
+    return true;
+}
+
+// NAME or kaiser:BETA
+bool parseWindow(const std::string& text, friture::WindowFunction& window, float& kaiser_beta) {
+    using friture::WindowFunction;
+    const size_t colon = text.find(':');
+    const std::string name = text.substr(0, colon);
+    if (name == "hann") { window = WindowFunction::Hann; }
+    else if (name == "hamming") { window = WindowFunction::Hamming; }
+    else if (name == "blackman-harris") { window = WindowFunction::BlackmanHarris; }
+    else if (name == "flat-top") { window = WindowFunction::FlatTop; }
+    else if (name == "kaiser") { window = WindowFunction::Kaiser; }
+    else { return false; }
+    if (colon != std::string::npos) {
+        if (window != WindowFunction::Kaiser) {
+            return false;
+        }
+        kaiser_beta = std::strtof(text.c_str() + colon + 1, nullptr);
+    }
+    return true;
+}
+
+bool parseWeighting(const std::string& name, friture::WeightingType& weighting) {
+    using friture::WeightingType;
+    if (name == "none") { weighting = WeightingType::None; }
+    else if (name == "a" || name == "A") { weighting = WeightingType::A; }
+    else if (name == "b" || name == "B") { weighting = WeightingType::B; }
+    else if (name == "c" || name == "C") { weighting = WeightingType::C; }
+    else { return false; }
+    return true;
+}
+
+bool parseTransferView(const std::string& name, friture::TransferView& view) {
+    using friture::TransferView;
+    if (name == "off") { view = TransferView::Off; }
+    else if (name == "magnitude") { view = TransferView::Magnitude; }
+    else if (name == "phase") { view = TransferView::Phase; }
+    else if (name == "coherence") { view = TransferView::Coherence; }
+    else { return false; }
+    return true;
+}
 
 void printUsage(const char* program_name) {
     std::cout << "Friture C++ - Real-time Spectrogram Viewer" << std::endl;
     std::cout << "\nUsage:" << std::endl;
-    std::cout << "  " << program_name << " [audio_file.wav]" << std::endl;
+    std::cout << "  " << program_name << " [--gpu-colormap] [stream options] [audio_file.wav]" << std::endl;
+    std::cout << "  " << program_name << " --fftw-warmup" << std::endl;
+    std::cout << "  " << program_name << " --view ADDR:PORT" << std::endl;
     std::cout << "\nIf no audio file is provided, a test signal will be generated." << std::endl;
+    std::cout << "\nOptions:" << std::endl;
+    std::cout << "  --fftw-warmup  Plan all FFT sizes with FFTW_PATIENT, save wisdom and exit" << std::endl;
+    std::cout << "  --gpu-colormap Apply the colormap in an OpenGL shader (dB range changes" << std::endl;
+    std::cout << "                 recolor history instantly; falls back to CPU if unavailable)" << std::endl;
+    std::cout << "  --trace FILE   Write a Chrome trace (chrome://tracing) of the pipeline" << std::endl;
+    std::cout << "                 stages to FILE on exit" << std::endl;
+    std::cout << "  --startup-trace  Print how long each startup phase took (window, FFT" << std::endl;
+    std::cout << "                 plans, first frame, fonts, device scan) once it is over" << std::endl;
+    std::cout << "  --rt-check SECONDS  Run for SECONDS, then report allocations and locks in" << std::endl;
+    std::cout << "                 the audio callback and analysis (exit status 3 if any;" << std::endl;
+    std::cout << "                 needs a -DFRITURE_RT_CHECKS=ON build, FRITURE_RT_ABORT=1" << std::endl;
+    std::cout << "                 aborts at the first one)" << std::endl;
+    std::cout << "  --governor [N:D]  Lower display quality when frames or analysis run over" << std::endl;
+    std::cout << "                 budget: drop status text, redraw down to every Nth refresh," << std::endl;
+    std::cout << "                 analyze down to 1/D of the rows (default 3:4; D a power of 2)" << std::endl;
+    std::cout << "  --history-mb N Memory for the column history shown by V (default 64)" << std::endl;
+    std::cout << "  --record FILE  Record the spectrogram (.frspec, quantized dB columns)" << std::endl;
+    std::cout << "  --serve ADDR:PORT  Stream the displayed columns over UDP to a multicast" << std::endl;
+    std::cout << "                 group or host (e.g. 239.255.70.82:7082; at most 50" << std::endl;
+    std::cout << "                 columns/s, ~200 kbit/s). Headless: SDL_VIDEODRIVER=dummy" << std::endl;
+    std::cout << "  --view ADDR:PORT   Show a --serve stream instead of analyzing audio" << std::endl;
+    std::cout << "                 (ADDR: the multicast group, or 0.0.0.0 for unicast)" << std::endl;
+    std::cout << "  --overlap PCT  Frame overlap in percent, [0, 99.9] (default 75)" << std::endl;
+    std::cout << "  --range LO:HI  Displayed frequency range in Hz (default 20:24000)" << std::endl;
+    std::cout << "  --zoom         Zoom FFT into a narrow range: mix down, decimate, and" << std::endl;
+    std::cout << "                 transform at the lower rate (e.g. --range 40:400 --zoom" << std::endl;
+    std::cout << "                 gives 0.18 Hz bins at 48 kHz with the default FFT size)" << std::endl;
+    std::cout << "  --window NAME  hann, hamming, blackman-harris, flat-top or kaiser[:BETA]" << std::endl;
+    std::cout << "                 (default hann; levels are corrected for the window's gain)" << std::endl;
+    std::cout << "  --weighting W  Frequency weighting of the display: a, b, c or none" << std::endl;
+    std::cout << "  --average M    Average in power: exp[:SECONDS], linear[:N], peak[:SECONDS]" << std::endl;
+    std::cout << "                 or none (defaults 1 s, 8 spectra)" << std::endl;
+    std::cout << "  --decimate K   Display one column per K hops, [1, 64] (default 1)" << std::endl;
+    std::cout << "  --analysis-rate HZ  Rate the pipeline runs at (default 48000); files and" << std::endl;
+    std::cout << "                 devices are converted to it, lower rates decimate" << std::endl;
+    std::cout << "                 (e.g. 24000 for a 96 kHz source: 4x less FFT work)" << std::endl;
+    std::cout << "\nLive input stream options:" << std::endl;
+    std::cout << "  --channels N       Input channels to capture (default 1)" << std::endl;
+    std::cout << "  --transfer VIEW    With 2+ channels: magnitude, phase or coherence of the" << std::endl;
+    std::cout << "                     transfer function from channel 1 (reference) to 2" << std::endl;
+    std::cout << "  --buffer-frames N  Frames per audio callback (default 512)" << std::endl;
+    std::cout << "  --buffers N        Number of device buffers (default: API choice)" << std::endl;
+    std::cout << "  --low-latency      Ask the audio API for its minimum latency" << std::endl;
+    std::cout << "  --realtime [PRIO]  Run the audio callback with realtime scheduling" << std::endl;
+    std::cout << "  --device-rate HZ   Open the device at this rate (default: analysis rate)" << std::endl;
+    std::cout << "  --ring SECONDS     Input history kept per channel (default 10)" << std::endl;
+    std::cout << "  --capture DIR[:PRE[:POST]]  Write PRE s before and POST s after each" << std::endl;
+    std::cout << "                     trigger (T key, peak onsets with K) to DIR as WAV" << std::endl;
+    std::cout << "                     (default 5:5; the ring grows to PRE + 5 s)" << std::endl;
     std::cout << "\nKeyboard Controls:" << std::endl;
     std::cout << "  SPACE    - Pause/Resume playback" << std::endl;
     std::cout << "  R        - Reset to beginning" << std::endl;
     std::cout << "  H        - Toggle help overlay" << std::endl;
+    std::cout << "  P        - Per-stage latency overlay (p50/p99 per second)" << std::endl;
+    std::cout << "  G        - Toggle adaptive quality (--governor bounds)" << std::endl;
+    std::cout << "  V        - History view (Left/Right pan, Up/Down zoom, End: now)" << std::endl;
+    std::cout << "  S        - Cycle spectrum curve / 1/3-octave bars / off (peak hold)" << std::endl;
     std::cout << "  L        - Toggle Live/File mode" << std::endl;
     std::cout << "  D        - Cycle audio input devices" << std::endl;
+    std::cout << "  M        - Multichannel layout (stacked lanes / overlay)" << std::endl;
+    std::cout << "  K        - Log tonal peak onsets/offsets (onsets trigger capture)" << std::endl;
+    std::cout << "  T        - Capture live input around now to WAV (--capture settings)" << std::endl;
+    std::cout << "  E        - Cycle averaging (None/Exponential/Linear/Peak hold)" << std::endl;
+    std::cout << "  X        - Cycle hops per displayed column (1, 2, 4, 8, 16)" << std::endl;
     std::cout << "  1        - Linear frequency scale" << std::endl;
     std::cout << "  2        - Logarithmic frequency scale" << std::endl;
     std::cout << "  3        - Mel frequency scale" << std::endl;
@@ -41,6 +238,13 @@ void printUsage(const char* program_name) {
     std::cout << "  5        - Octave frequency scale" << std::endl;
     std::cout << "  +        - Increase FFT size" << std::endl;
     std::cout << "  -        - Decrease FFT size" << std::endl;
+    std::cout << "  B        - Multi-resolution: larger FFTs for low rows (Log/Octave)" << std::endl;
+    std::cout << "  Z        - Zoom FFT: fine bins inside a narrow --range" << std::endl;
+    std::cout << "  O        - Cycle overlap (50, 75, 87.5, 93.75, 96.9, 98.4 %)" << std::endl;
+    std::cout << "  W        - Cycle frequency weighting (None/A/B/C)" << std::endl;
+    std::cout << "  F        - Cycle transfer function (Off/Magnitude/Phase/Coherence)" << std::endl;
+    std::cout << "  C        - Cycle color theme (CMRMAP/Grayscale)" << std::endl;
+    std::cout << "  [ / ]    - Shift displayed dB range 10 dB down/up" << std::endl;
     std::cout << "  Q/ESC    - Quit application" << std::endl;
     std::cout << std::endl;
 }
@@ -53,14 +257,221 @@ int main(int argc, char* argv[]) {
             return 0;
         }
 
+        // Offline warm-up: exhaustive planning into the per-user wisdom cache
+        if (argc > 1 && std::string(argv[1]) == "--fftw-warmup") {
+            friture::FFTWisdom wisdom(friture::FFTWisdom::defaultCachePath());
+            wisdom.load();
+            if (!wisdom.warmUp(FFTW_PATIENT)) {
+                std::cerr << "Failed to save FFTW wisdom" << std::endl;
+                return 1;
+            }
+            std::cout << "FFTW wisdom saved to " << wisdom.getCachePath() << std::endl;
+            return 0;
+        }
+
+        // Remaining arguments: optional flags and at most one audio file
+        bool gpu_colormap = false;
+        friture::AudioStreamOptions stream_options;
+        const char* audio_file = nullptr;
+        std::string trace_path;
+        bool startup_trace = false;
+        double rt_check_seconds = 0.0;
+        size_t history_mb = 0;
+        float overlap = -1.0f;
+        float analysis_rate = 0.0f;
+        float min_freq = 0.0f;
+        float max_freq = 0.0f;
+        bool zoom = false;
+        friture::WeightingType weighting = friture::WeightingType::None;
+        friture::TransferView transfer = friture::TransferView::Off;
+        friture::WindowFunction window = friture::WindowFunction::Hann;
+        friture::AveragingMode averaging = friture::AveragingMode::None;
+        float averaging_time = 1.0f;
+        size_t averaging_frames = 8;
+        size_t decimation = 1;
+        float kaiser_beta = friture::DEFAULT_KAISER_BETA;
+        size_t ring_seconds = 0;
+        bool capture = false;
+        friture::TriggerCapture::Options capture_options;
+        std::string record_path;
+        std::string serve_endpoint;
+        std::string view_endpoint;
+        bool governor = false;
+        friture::QualityGovernor::Options governor_options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool has_value = (i + 1 < argc);
+            if (arg == "--gpu-colormap") {
+                gpu_colormap = true;
+            } else if (arg == "--trace" && has_value) {
+                trace_path = argv[++i];
+            } else if (arg == "--startup-trace") {
+                startup_trace = true;
+            } else if (arg == "--rt-check" && has_value) {
+                rt_check_seconds = std::atof(argv[++i]);
+            } else if (arg == "--governor") {
+                governor = true;
+                // Optional bounds argument
+                if (has_value && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                    char* end = nullptr;
+                    governor_options.max_frame_interval =
+                        static_cast<uint32_t>(std::strtoul(argv[++i], &end, 10));
+                    if (*end == ':') {
+                        governor_options.max_height_divisor =
+                            static_cast<uint32_t>(std::strtoul(end + 1, nullptr, 10));
+                    }
+                }
+            } else if (arg == "--history-mb" && has_value) {
+                history_mb = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--overlap" && has_value) {
+                overlap = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--range" && has_value) {
+                char* end = nullptr;
+                min_freq = std::strtof(argv[++i], &end);
+                max_freq = (*end == ':') ? std::strtof(end + 1, nullptr) : 0.0f;
+            } else if (arg == "--zoom") {
+                zoom = true;
+            } else if (arg == "--window" && has_value) {
+                if (!parseWindow(argv[++i], window, kaiser_beta)) {
+                    std::cerr << "Unknown window: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--weighting" && has_value) {
+                if (!parseWeighting(argv[++i], weighting)) {
+                    std::cerr << "Unknown weighting: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--transfer" && has_value) {
+                if (!parseTransferView(argv[++i], transfer)) {
+                    std::cerr << "Unknown transfer view: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--average" && has_value) {
+                if (!parseAveraging(argv[++i], averaging, averaging_time, averaging_frames)) {
+                    std::cerr << "Unknown averaging: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--decimate" && has_value) {
+                decimation = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--analysis-rate" && has_value) {
+                analysis_rate = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--device-rate" && has_value) {
+                stream_options.device_sample_rate =
+                    static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--ring" && has_value) {
+                ring_seconds = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--capture" && has_value) {
+                if (!parseCapture(argv[++i], capture_options)) {
+                    std::cerr << "Expected DIR[:PRE[:POST]], got " << argv[i] << std::endl;
+                    return 1;
+                }
+                capture = true;
+            } else if (arg == "--record" && has_value) {
+                record_path = argv[++i];
+            } else if (arg == "--serve" && has_value) {
+                serve_endpoint = argv[++i];
+            } else if (arg == "--view" && has_value) {
+                view_endpoint = argv[++i];
+            } else if (arg == "--channels" && has_value) {
+                stream_options.channels =
+                    static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--buffer-frames" && has_value) {
+                stream_options.buffer_frames = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--buffers" && has_value) {
+                stream_options.number_of_buffers =
+                    static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--low-latency") {
+                stream_options.minimize_latency = true;
+            } else if (arg == "--realtime") {
+                stream_options.schedule_realtime = true;
+                // Optional priority argument
+                if (has_value && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                    stream_options.priority = std::atoi(argv[++i]);
+                }
+            } else {
+                audio_file = argv[i];
+            }
+        }
+
+        std::string stream_address;
+        uint16_t stream_port = 0;
+        if (!serve_endpoint.empty() && !view_endpoint.empty()) {
+            std::cerr << "--serve and --view are exclusive" << std::endl;
+            return 1;
+        }
+        const std::string& endpoint = view_endpoint.empty() ? serve_endpoint : view_endpoint;
+        if (!endpoint.empty() && !parseEndpoint(endpoint, stream_address, stream_port)) {
+            std::cerr << "Expected ADDR:PORT, got " << endpoint << std::endl;
+            return 1;
+        }
+
+        if (rt_check_seconds > 0.0 && !friture::RealtimeCheck::isEnabled()) {
+            std::cerr << "--rt-check needs a build with -DFRITURE_RT_CHECKS=ON" << std::endl;
+            return 1;
+        }
+
         // Create application
-        friture::FritureApp app(1280, 720);
+        friture::FritureApp app(1280, 720, gpu_colormap);
+        app.setAudioStreamOptions(stream_options);
+        if (analysis_rate > 0.0f && !app.setAnalysisRate(analysis_rate)) {
+            return 1;
+        }
+        if (ring_seconds > 0 && !app.setRingDuration(ring_seconds)) {
+            return 1;
+        }
+        if (capture && !app.enableCapture(capture_options)) {
+            return 1;
+        }
+        if (!trace_path.empty()) {
+            app.enableTrace(trace_path);
+        }
+        if (startup_trace) {
+            app.enableStartupTrace();
+        }
+        if (rt_check_seconds > 0.0) {
+            app.setRunDuration(rt_check_seconds);
+        }
+        if (governor) {
+            app.enableQualityGovernor(governor_options);
+        }
+        if (history_mb > 0) {
+            app.setHistoryMemory(history_mb << 20);
+        }
+        if (overlap >= 0.0f && !app.setOverlap(overlap)) {
+            return 1;
+        }
+        if ((min_freq != 0.0f || max_freq != 0.0f) && !app.setFrequencyRange(min_freq, max_freq)) {
+            return 1;
+        }
+        if (zoom) {
+            app.setZoom(true);
+        }
+        if (window != friture::WindowFunction::Hann && !app.setWindow(window, kaiser_beta)) {
+            return 1;
+        }
+        if (weighting != friture::WeightingType::None) {
+            app.setWeighting(weighting);
+        }
+        if (transfer != friture::TransferView::Off) {
+            app.setTransferView(transfer);
+        }
+        if (averaging != friture::AveragingMode::None &&
+            !app.setAveraging(averaging, averaging_time, averaging_frames)) {
+            return 1;
+        }
+        if (decimation != 1 && !app.setColumnDecimation(decimation)) {
+            return 1;
+        }
 
-        // Load audio or generate test signal
-        if (argc > 1) {
+        // Load audio or generate test signal (a viewer analyzes nothing)
+        if (!view_endpoint.empty()) {
+            if (!app.startViewing(stream_address, stream_port)) {
+                return 1;
+            }
+        } else if (audio_file) {
             // Load from file
-            if (!app.loadAudioFromFile(argv[1])) {
-                std::cerr << "Failed to load audio file: " << argv[1] << std::endl;
+            if (!app.loadAudioFromFile(audio_file)) {
+                std::cerr << "Failed to load audio file: " << audio_file << std::endl;
                 std::cerr << "Generating test signal instead..." << std::endl;
                 app.generateChirp(100.0f, 10000.0f, 5.0f);
             }
@@ -72,9 +483,24 @@ int main(int argc, char* argv[]) {
             app.generateChirp(100.0f, 10000.0f, 5.0f);
         }
 
+        // Record with the final analysis rate
+        if (!record_path.empty() && !app.startRecording(record_path)) {
+            return 1;
+        }
+        if (!serve_endpoint.empty() && !app.startStreaming(stream_address, stream_port)) {
+            return 1;
+        }
+
         // Run application
         app.run();
 
+        if (rt_check_seconds > 0.0) {
+            friture::RealtimeCheck::report(std::cout);
+            if (friture::RealtimeCheck::getViolationCount() > 0) {
+                return 3;
+            }
+        }
+
         std::cout << "\nExiting normally" << std::endl;
         return 0;
 
@@ -0,0 +1,53 @@
+/**
+ * @file aligned_arena.cpp
+ * @brief Implementation of AlignedArena
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/aligned_arena.hpp>
+#include <new>
+#include <utility>
+
+namespace friture {
+
+AlignedArena::AlignedArena(size_t capacity)
+    : capacity_(alignUp(capacity))
+{
+    if (capacity_ > 0) {
+        data_ = static_cast<std::byte*>(::operator new(capacity_, std::align_val_t{ALIGNMENT}));
+    }
+}
+
+AlignedArena::~AlignedArena() {
+    release();
+}
+
+AlignedArena::AlignedArena(AlignedArena&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      used_(std::exchange(other.used_, 0))
+{
+}
+
+AlignedArena& AlignedArena::operator=(AlignedArena&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        capacity_ = std::exchange(other.capacity_, 0);
+        used_ = std::exchange(other.used_, 0);
+    }
+    return *this;
+}
+
+void AlignedArena::release() {
+    if (data_) {
+        ::operator delete(data_, std::align_val_t{ALIGNMENT});
+        data_ = nullptr;
+    }
+    capacity_ = 0;
+    used_ = 0;
+}
+
+} // namespace friture
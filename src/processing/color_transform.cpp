@@ -7,6 +7,7 @@
  */
 
 #include <friture/color_transform.hpp>
+#include <friture/simd_kernels.hpp>
 
 namespace friture {
 
@@ -313,6 +314,13 @@ void ColorTransform::transformColumn(const float* input, size_t height,
     }
 }
 
+void ColorTransform::transformColumnDb(const float* db, size_t height,
+                                       float min_db, float max_db,
+                                       uint32_t* output) const {
+    const float scale = 255.0f / (max_db - min_db);
+    simd::dbToPalette(db, height, min_db, scale, color_lut_.data(), output);
+}
+
 // ============================================================================
 // Configuration Methods
 // ============================================================================
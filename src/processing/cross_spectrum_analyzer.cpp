@@ -0,0 +1,317 @@
+/**
+ * @file cross_spectrum_analyzer.cpp
+ * @brief Implementation of CrossSpectrumAnalyzer
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/cross_spectrum_analyzer.hpp>
+#include <friture/fft_wisdom.hpp>
+#include <friture/settings.hpp>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+namespace friture {
+
+namespace {
+
+constexpr double POWER_FLOOR = 1e-30;     // Same floor as FFTProcessor
+constexpr double MIN_GAIN = 1e-10;        // -200 dB, the bottom of SpectrogramImage
+constexpr double RAD_TO_DEG = 180.0 / 3.14159265358979323846;
+constexpr size_t VALUES_PER_BIN = 4;      // Gxx, Gyy, Re Gxy, Im Gxy
+
+size_t hopSizeFor(const ChainKey& key) {
+    SpectrogramSettings settings;
+    settings.fft_size = key.fft_size;
+    settings.overlap_percent = key.overlap_percent;
+    return settings.getSamplesPerColumn();
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+CrossSpectrumAnalyzer::CrossSpectrumAnalyzer(const ChainKey& key, const Options& options)
+    : key_(key),
+      options_(options),
+      hop_size_(hopSizeFor(key)),
+      // Validates scale, range and height
+      resampler_(key.scale, key.min_freq, key.max_freq, key.sample_rate,
+                 key.fft_size, key.height, key.aggregation),
+      range_(resampler_.getInputRange()),
+      power_scale_(1.0f),
+      weight_(1.0)
+{
+    const size_t n = key.fft_size;
+    if (n < 32 || n > 16384 || (n & (n - 1)) != 0) {
+        throw std::invalid_argument("Cross spectrum FFT size must be a power of 2 in [32, 16384]");
+    }
+    if (options.averaging == AveragingMode::Linear &&
+        (options.frames == 0 || options.frames > SpectrogramSettings::MAX_AVERAGING_FRAMES)) {
+        throw std::invalid_argument("Averaging frames must be in [1, MAX_AVERAGING_FRAMES]");
+    }
+    if ((options.averaging == AveragingMode::Exponential || options.averaging == AveragingMode::PeakHold) &&
+        !(options.time_seconds > 0.0f)) {
+        throw std::invalid_argument("Averaging time must be > 0");
+    }
+
+    if (options.averaging == AveragingMode::Exponential || options.averaging == AveragingMode::PeakHold) {
+        const double hop_seconds = static_cast<double>(hop_size_) / key.sample_rate;
+        weight_ = 1.0 - std::exp(-hop_seconds / options.time_seconds);
+    }
+
+    window_ = windowTable(key.window, n, key.kaiser_beta);
+    const float amplitude = static_cast<float>(n) * window_.coherent_gain;
+    power_scale_ = 1.0f / (amplitude * amplitude);
+
+    inputs_.assign(2 * n, 0.0f);
+    reference_input = std::span<float>(inputs_.data(), n);
+    measured_input = std::span<float>(inputs_.data() + n, n);
+
+    const size_t width = range_.end - range_.first;
+    gxx_.assign(width, 0.0);
+    gyy_.assign(width, 0.0);
+    gxy_re_.assign(width, 0.0);
+    gxy_im_.assign(width, 0.0);
+    if (options.averaging == AveragingMode::Linear) {
+        ring_.assign(options.frames * width * VALUES_PER_BIN, 0.0f);
+    }
+
+    spectrum_.assign(getNumBins(), 0.0f);
+    phase_re_.assign(getNumBins(), 1.0f);
+    phase_im_.assign(getNumBins(), 0.0f);
+    row_re_.assign(key.height, 0.0f);
+    row_im_.assign(key.height, 0.0f);
+
+    fft_in_ = fftwf_alloc_complex(n);
+    fft_out_ = fftwf_alloc_complex(n);
+    if (fft_in_ && fft_out_) {
+        std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
+        plan_ = fftwf_plan_dft_1d(static_cast<int>(n), fft_in_, fft_out_,
+                                  FFTW_FORWARD, FFTW_MEASURE);
+    }
+    if (!plan_) {
+        fftwf_free(fft_in_);
+        fftwf_free(fft_out_);
+        throw std::runtime_error("Failed to create cross spectrum FFT plan");
+    }
+}
+
+CrossSpectrumAnalyzer::~CrossSpectrumAnalyzer() {
+    if (plan_) {
+        std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
+        fftwf_destroy_plan(plan_);
+    }
+    fftwf_free(fft_in_);
+    fftwf_free(fft_out_);
+}
+
+// ============================================================================
+// Analysis
+// ============================================================================
+
+void CrossSpectrumAnalyzer::reset() {
+    std::fill(gxx_.begin(), gxx_.end(), 0.0);
+    std::fill(gyy_.begin(), gyy_.end(), 0.0);
+    std::fill(gxy_re_.begin(), gxy_re_.end(), 0.0);
+    std::fill(gxy_im_.begin(), gxy_im_.end(), 0.0);
+    std::fill(ring_.begin(), ring_.end(), 0.0f);
+    ring_slot_ = 0;
+    count_ = 0;
+}
+
+void CrossSpectrumAnalyzer::process() {
+    const size_t n = key_.fft_size;
+    const float* window = window_.data();
+    const float* x = reference_input.data();
+    const float* y = measured_input.data();
+
+    // Both real signals in one complex transform
+    for (size_t i = 0; i < n; ++i) {
+        fft_in_[i][0] = window[i] * x[i];
+        fft_in_[i][1] = window[i] * y[i];
+    }
+    fftwf_execute(plan_);
+
+    const size_t first = range_.first;
+    const size_t width = range_.end - first;
+    const AveragingMode mode = options_.averaging;
+    float* slot = mode == AveragingMode::Linear
+        ? ring_.data() + ring_slot_ * width * VALUES_PER_BIN : nullptr;
+    const bool seed = count_ == 0;
+    const double scale = power_scale_;
+
+    for (size_t i = 0; i < width; ++i) {
+        // a = Z[k], b = conj(Z[N-k]); X = (a + b) / 2, Y = (a - b) / 2j
+        const size_t k = first + i;
+        const size_t mirror = (n - k) & (n - 1);
+        const double ar = fft_out_[k][0];
+        const double ai = fft_out_[k][1];
+        const double br = fft_out_[mirror][0];
+        const double bi = -fft_out_[mirror][1];
+        const double xr = 0.5 * (ar + br);
+        const double xi = 0.5 * (ai + bi);
+        const double yr = 0.5 * (ai - bi);
+        const double yi = 0.5 * (br - ar);
+
+        // Gxy = conj(X)·Y
+        const double pxx = scale * (xr * xr + xi * xi);
+        const double pyy = scale * (yr * yr + yi * yi);
+        const double pxy_re = scale * (xr * yr + xi * yi);
+        const double pxy_im = scale * (xr * yi - xi * yr);
+
+        switch (mode) {
+            case AveragingMode::None:
+                gxx_[i] = pxx;
+                gyy_[i] = pyy;
+                gxy_re_[i] = pxy_re;
+                gxy_im_[i] = pxy_im;
+                break;
+            case AveragingMode::Linear: {
+                // Running sums; the ratios do not need the mean
+                float* old = slot + i * VALUES_PER_BIN;
+                gxx_[i] += pxx - old[0];
+                gyy_[i] += pyy - old[1];
+                gxy_re_[i] += pxy_re - old[2];
+                gxy_im_[i] += pxy_im - old[3];
+                old[0] = static_cast<float>(pxx);
+                old[1] = static_cast<float>(pyy);
+                old[2] = static_cast<float>(pxy_re);
+                old[3] = static_cast<float>(pxy_im);
+                break;
+            }
+            case AveragingMode::Exponential:
+            case AveragingMode::PeakHold:
+                if (seed) {
+                    gxx_[i] = pxx;
+                    gyy_[i] = pyy;
+                    gxy_re_[i] = pxy_re;
+                    gxy_im_[i] = pxy_im;
+                } else {
+                    gxx_[i] += weight_ * (pxx - gxx_[i]);
+                    gyy_[i] += weight_ * (pyy - gyy_[i]);
+                    gxy_re_[i] += weight_ * (pxy_re - gxy_re_[i]);
+                    gxy_im_[i] += weight_ * (pxy_im - gxy_im_[i]);
+                }
+                break;
+        }
+    }
+
+    if (mode == AveragingMode::Linear) {
+        count_ = std::min(count_ + 1, options_.frames);
+        if (++ring_slot_ == options_.frames) {
+            // Once per lap: resum exactly so rounding does not accumulate
+            ring_slot_ = 0;
+            std::fill(gxx_.begin(), gxx_.end(), 0.0);
+            std::fill(gyy_.begin(), gyy_.end(), 0.0);
+            std::fill(gxy_re_.begin(), gxy_re_.end(), 0.0);
+            std::fill(gxy_im_.begin(), gxy_im_.end(), 0.0);
+            for (size_t f = 0; f < options_.frames; ++f) {
+                const float* values = ring_.data() + f * width * VALUES_PER_BIN;
+                for (size_t i = 0; i < width; ++i) {
+                    gxx_[i] += values[i * VALUES_PER_BIN];
+                    gyy_[i] += values[i * VALUES_PER_BIN + 1];
+                    gxy_re_[i] += values[i * VALUES_PER_BIN + 2];
+                    gxy_im_[i] += values[i * VALUES_PER_BIN + 3];
+                }
+            }
+        }
+    } else {
+        count_ = mode == AveragingMode::None ? 1 : count_ + 1;
+    }
+}
+
+// ============================================================================
+// Views
+// ============================================================================
+
+void CrossSpectrumAnalyzer::getSpectrum(TransferView view, float* output) const {
+    const size_t first = range_.first;
+    const size_t width = range_.end - first;
+    float* out = output + first;
+
+    switch (view) {
+        case TransferView::Magnitude:
+            // H1 = Gxy / Gxx
+            for (size_t i = 0; i < width; ++i) {
+                const double cross = std::hypot(gxy_re_[i], gxy_im_[i]);
+                const double gain = gxx_[i] > POWER_FLOOR ? cross / gxx_[i] : 0.0;
+                out[i] = static_cast<float>(20.0 * std::log10(std::max(gain, MIN_GAIN)));
+            }
+            break;
+        case TransferView::Phase:
+            for (size_t i = 0; i < width; ++i) {
+                out[i] = static_cast<float>(std::atan2(gxy_im_[i], gxy_re_[i]) * RAD_TO_DEG);
+            }
+            break;
+        case TransferView::Coherence:
+            for (size_t i = 0; i < width; ++i) {
+                const double auto_product = gxx_[i] * gyy_[i];
+                const double cross = gxy_re_[i] * gxy_re_[i] + gxy_im_[i] * gxy_im_[i];
+                out[i] = auto_product > POWER_FLOOR * POWER_FLOOR
+                    ? static_cast<float>(std::min(cross / auto_product, 1.0)) : 0.0f;
+            }
+            break;
+        case TransferView::Off:
+            throw std::invalid_argument("No transfer view selected");
+    }
+}
+
+void CrossSpectrumAnalyzer::resample(TransferView view, float* column) {
+    if (view != TransferView::Phase) {
+        getSpectrum(view, spectrum_.data());
+        resampler_.setAggregation(view == TransferView::Magnitude
+                                  ? key_.aggregation : BinAggregation::Interpolate);
+        resampler_.resample(spectrum_.data(), column);
+        return;
+    }
+
+    // Phase as a unit vector: rows between -179° and +179° read ±180°, not 0°
+    const size_t first = range_.first;
+    const size_t width = range_.end - first;
+    for (size_t i = 0; i < width; ++i) {
+        const double magnitude = std::hypot(gxy_re_[i], gxy_im_[i]);
+        if (magnitude > 0.0) {
+            phase_re_[first + i] = static_cast<float>(gxy_re_[i] / magnitude);
+            phase_im_[first + i] = static_cast<float>(gxy_im_[i] / magnitude);
+        } else {
+            phase_re_[first + i] = 1.0f;
+            phase_im_[first + i] = 0.0f;
+        }
+    }
+    resampler_.setAggregation(BinAggregation::Interpolate);
+    resampler_.resample(phase_re_.data(), row_re_.data());
+    resampler_.resample(phase_im_.data(), row_im_.data());
+    for (size_t r = 0; r < key_.height; ++r) {
+        column[r] = static_cast<float>(std::atan2(row_im_[r], row_re_[r]) * RAD_TO_DEG);
+    }
+}
+
+void CrossSpectrumAnalyzer::toDisplayLevels(TransferView view, float* column, size_t rows,
+                                            float min_db, float max_db) {
+    float low;
+    float high;
+    switch (view) {
+        case TransferView::Phase:
+            low = -180.0f;
+            high = 180.0f;
+            break;
+        case TransferView::Coherence:
+            low = 0.0f;
+            high = 1.0f;
+            break;
+        default:
+            return;
+    }
+    const float scale = (max_db - min_db) / (high - low);
+    for (size_t r = 0; r < rows; ++r) {
+        column[r] = min_db + (std::clamp(column[r], low, high) - low) * scale;
+    }
+}
+
+} // namespace friture
@@ -6,11 +6,14 @@
  * @date 2025-11-06
  */
 
-#define _USE_MATH_DEFINES  // For M_PI on Windows/MSVC
 #include <friture/fft_processor.hpp>
+#include <friture/simd_kernels.hpp>
+#include <friture/fft_wisdom.hpp>
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <sstream>
+#include <mutex>
 
 namespace friture {
 
@@ -18,13 +21,18 @@ namespace friture {
 // Constructor & Destructor
 // ============================================================================
 
-FFTProcessor::FFTProcessor(size_t fft_size, WindowFunction window_type)
+FFTProcessor::FFTProcessor(size_t fft_size, WindowFunction window_type, float kaiser_beta)
     : fft_size_(fft_size),
       window_type_(window_type),
-      window_(fft_size),
+      kaiser_beta_(kaiser_beta),
+      exact_log10_(false),
+      power_scale_(0.0f),
       fftw_input_(nullptr),
       fftw_output_(nullptr),
-      fft_plan_(nullptr)
+      fft_plan_(nullptr),
+      batch_input_(nullptr),
+      batch_output_(nullptr),
+      batch_plan_(nullptr)
 {
     if (!isValidFFTSize(fft_size)) {
         std::ostringstream oss;
@@ -32,6 +40,9 @@ FFTProcessor::FFTProcessor(size_t fft_size, WindowFunction window_type)
             << ". Must be power of 2, range [32, 16384]";
         throw std::invalid_argument(oss.str());
     }
+    if (!(kaiser_beta >= 0.0f && kaiser_beta <= MAX_KAISER_BETA)) {
+        throw std::invalid_argument("Kaiser beta must be in [0, MAX_KAISER_BETA]");
+    }
 
     initialize();
 }
@@ -45,23 +56,104 @@ FFTProcessor::~FFTProcessor() {
 // ============================================================================
 
 void FFTProcessor::process(const float* input, float* output) {
+    process(input, output, 0, fft_size_ / 2 + 1);
+}
+
+void FFTProcessor::process(const float* input, float* output, size_t first_bin, size_t end_bin) {
+    validateBinRange(first_bin, end_bin);
+
     // Apply window function
-    for (size_t i = 0; i < fft_size_; ++i) {
-        fftw_input_[i] = input[i] * window_[i];
-    }
+    simd::applyWindow(input, window_.data(), fftw_input_, fft_size_);
 
     // Compute FFT
     fftwf_execute(fft_plan_);
 
     // Compute power spectrum and convert to dB
+    spectrumToDb(fftw_output_, output, first_bin, end_bin);
+}
+
+void FFTProcessor::processSplit(const float* first, size_t first_count,
+                                const float* second, float* output) {
+    if (first_count > fft_size_) {
+        throw std::invalid_argument("Split point must be <= FFT size");
+    }
+
+    // Window each piece straight into the FFT input
+    simd::applyWindow(first, window_.data(), fftw_input_, first_count);
+    if (first_count < fft_size_) {
+        simd::applyWindow(second, window_.data() + first_count,
+                          fftw_input_ + first_count, fft_size_ - first_count);
+    }
+
+    fftwf_execute(fft_plan_);
+    spectrumToDb(fftw_output_, output, 0, fft_size_ / 2 + 1);
+}
+
+void FFTProcessor::processBatch(const float* input, size_t hop, size_t num_frames,
+                                float* output, size_t out_stride) {
+    processBatch(input, hop, num_frames, output, out_stride, 0, fft_size_ / 2 + 1);
+}
+
+void FFTProcessor::processBatch(const float* input, size_t hop, size_t num_frames,
+                                float* output, size_t out_stride,
+                                size_t first_bin, size_t end_bin) {
+    const size_t num_bins = fft_size_ / 2 + 1;
+
+    if (hop == 0) {
+        throw std::invalid_argument("Hop size must be > 0");
+    }
+    if (out_stride < num_bins) {
+        throw std::invalid_argument("Output stride must be >= number of bins");
+    }
+    validateBinRange(first_bin, end_bin);
+
+    prepareBatch();
+
+    size_t frame = 0;
+
+    // Full batches through the many-frame plan
+    while (num_frames - frame >= BATCH_FRAMES) {
+        for (size_t b = 0; b < BATCH_FRAMES; ++b) {
+            simd::applyWindow(input + (frame + b) * hop, window_.data(),
+                              batch_input_ + b * fft_size_, fft_size_);
+        }
+
+        fftwf_execute(batch_plan_);
+
+        for (size_t b = 0; b < BATCH_FRAMES; ++b) {
+            spectrumToDb(batch_output_ + b * num_bins, output + (frame + b) * out_stride,
+                         first_bin, end_bin);
+        }
+        frame += BATCH_FRAMES;
+    }
+
+    // Remainder through the single-frame plan
+    for (; frame < num_frames; ++frame) {
+        process(input + frame * hop, output + frame * out_stride, first_bin, end_bin);
+    }
+}
+
+void FFTProcessor::prepareBatch() {
+    if (!batch_plan_) {
+        initializeBatch();
+    }
+}
+
+void FFTProcessor::spectrumToDb(const fftwf_complex* spectrum, float* output,
+                                size_t first_bin, size_t end_bin) const {
     const size_t num_bins = fft_size_ / 2 + 1;
-    const float scale = 1.0f / (fft_size_ * fft_size_);
+    // Bins nobody reads skip the log10 entirely
+    const float floor_db = 10.0f * std::log10(EPSILON);
+    std::fill(output, output + first_bin, floor_db);
+    std::fill(output + end_bin, output + num_bins, floor_db);
+
+    simd::powerToDb(reinterpret_cast<const float*>(spectrum + first_bin), output + first_bin,
+                    end_bin - first_bin, power_scale_, EPSILON, exact_log10_);
+}
 
-    for (size_t i = 0; i < num_bins; ++i) {
-        float real = fftw_output_[i][0];
-        float imag = fftw_output_[i][1];
-        float power = (real * real + imag * imag) * scale;
-        output[i] = 10.0f * std::log10(power + EPSILON);
+void FFTProcessor::validateBinRange(size_t first_bin, size_t end_bin) const {
+    if (first_bin > end_bin || end_bin > fft_size_ / 2 + 1) {
+        throw std::invalid_argument("Bin range must satisfy first <= end <= fft_size/2 + 1");
     }
 }
 
@@ -77,15 +169,19 @@ void FFTProcessor::setFFTSize(size_t new_size) {
     if (new_size != fft_size_) {
         cleanup();
         fft_size_ = new_size;
-        window_.resize(fft_size_);
         initialize();
     }
 }
 
-void FFTProcessor::setWindowFunction(WindowFunction type) {
-    if (type != window_type_) {
+void FFTProcessor::setWindowFunction(WindowFunction type, float kaiser_beta) {
+    if (!(kaiser_beta >= 0.0f && kaiser_beta <= MAX_KAISER_BETA)) {
+        throw std::invalid_argument("Kaiser beta must be in [0, MAX_KAISER_BETA]");
+    }
+
+    if (type != window_type_ || kaiser_beta != kaiser_beta_) {
         window_type_ = type;
-        computeWindow();
+        kaiser_beta_ = kaiser_beta;
+        loadWindow();
     }
 }
 
@@ -103,25 +199,60 @@ void FFTProcessor::initialize() {
         throw std::runtime_error("Failed to allocate FFTW buffers");
     }
 
-    // Create FFT plan
-    fft_plan_ = fftwf_plan_dft_r2c_1d(
-        fft_size_,
-        fftw_input_,
-        fftw_output_,
-        FFTW_MEASURE
-    );
+    // Create FFT plan (instant when the size is already in wisdom)
+    {
+        std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
+        fft_plan_ = fftwf_plan_dft_r2c_1d(
+            fft_size_,
+            fftw_input_,
+            fftw_output_,
+            FFTW_MEASURE
+        );
+    }
 
     if (!fft_plan_) {
         cleanup();
         throw std::runtime_error("Failed to create FFTW plan");
     }
 
-    // Compute window coefficients
-    computeWindow();
+    // Shared window coefficients
+    loadWindow();
+}
+
+void FFTProcessor::initializeBatch() {
+    const int n = static_cast<int>(fft_size_);
+    const int num_bins = n / 2 + 1;
+
+    batch_input_ = fftwf_alloc_real(BATCH_FRAMES * fft_size_);
+    batch_output_ = fftwf_alloc_complex(BATCH_FRAMES * num_bins);
+
+    if (!batch_input_ || !batch_output_) {
+        cleanupBatch();   // The single-frame path stays usable
+        throw std::runtime_error("Failed to allocate FFTW batch buffers");
+    }
+
+    // Frames are contiguous: frame b starts at b * n (input) and b * num_bins (output)
+    {
+        std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
+        batch_plan_ = fftwf_plan_many_dft_r2c(
+            1, &n, static_cast<int>(BATCH_FRAMES),
+            batch_input_, nullptr, 1, n,
+            batch_output_, nullptr, 1, num_bins,
+            FFTW_MEASURE
+        );
+    }
+
+    if (!batch_plan_) {
+        cleanupBatch();
+        throw std::runtime_error("Failed to create FFTW batch plan");
+    }
 }
 
 void FFTProcessor::cleanup() {
+    cleanupBatch();
+
     if (fft_plan_) {
+        std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
         fftwf_destroy_plan(fft_plan_);
         fft_plan_ = nullptr;
     }
@@ -137,27 +268,32 @@ void FFTProcessor::cleanup() {
     }
 }
 
-void FFTProcessor::computeWindow() {
-    const float N = static_cast<float>(fft_size_ - 1);
-
-    switch (window_type_) {
-        case WindowFunction::Hann:
-            for (size_t i = 0; i < fft_size_; ++i) {
-                window_[i] = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / N));
-            }
-            break;
+void FFTProcessor::cleanupBatch() {
+    if (batch_plan_) {
+        std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
+        fftwf_destroy_plan(batch_plan_);
+        batch_plan_ = nullptr;
+    }
 
-        case WindowFunction::Hamming:
-            for (size_t i = 0; i < fft_size_; ++i) {
-                window_[i] = 0.54f - 0.46f * std::cos(2.0f * M_PI * i / N);
-            }
-            break;
+    if (batch_input_) {
+        fftwf_free(batch_input_);
+        batch_input_ = nullptr;
+    }
 
-        default:
-            throw std::invalid_argument("Unknown window function type");
+    if (batch_output_) {
+        fftwf_free(batch_output_);
+        batch_output_ = nullptr;
     }
 }
 
+void FFTProcessor::loadWindow() {
+    window_ = windowTable(window_type_, fft_size_, kaiser_beta_);
+
+    // Unit coherent gain: the same sine reads the same level in every window
+    const float amplitude = static_cast<float>(fft_size_) * window_.coherent_gain;
+    power_scale_ = 1.0f / (amplitude * amplitude);
+}
+
 bool FFTProcessor::isValidFFTSize(size_t size) {
     // Must be >= 32 and <= 16384
     if (size < 32 || size > 16384) {
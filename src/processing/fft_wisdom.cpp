@@ -0,0 +1,202 @@
+/**
+ * @file fft_wisdom.cpp
+ * @brief Implementation of FFTWisdom
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#include <friture/fft_wisdom.hpp>
+#include <friture/fft_processor.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+
+namespace friture {
+
+// ============================================================================
+// Constructor & Destructor
+// ============================================================================
+
+FFTWisdom::FFTWisdom(std::string cache_path)
+    : cache_path_(std::move(cache_path)),
+      cancel_planning_(false),
+      planning_complete_(false)
+{
+}
+
+FFTWisdom::~FFTWisdom() {
+    stopBackgroundPlanning();
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+bool FFTWisdom::load() {
+    if (cache_path_.empty()) {
+        return false;
+    }
+
+    std::error_code ec;
+    if (!std::filesystem::exists(cache_path_, ec)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    if (!fftwf_import_wisdom_from_filename(cache_path_.c_str())) {
+        std::cerr << "Warning: Ignoring unreadable FFTW wisdom: " << cache_path_ << std::endl;
+        return false;
+    }
+
+    std::cout << "Loaded FFTW wisdom from " << cache_path_ << std::endl;
+    return true;
+}
+
+bool FFTWisdom::save() {
+    if (cache_path_.empty()) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(cache_path_).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+        if (ec) {
+            std::cerr << "Warning: Cannot create wisdom directory " << parent.string()
+                      << ": " << ec.message() << std::endl;
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(plannerMutex());
+    if (!fftwf_export_wisdom_to_filename(cache_path_.c_str())) {
+        std::cerr << "Warning: Failed to save FFTW wisdom to " << cache_path_ << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Planning
+// ============================================================================
+
+void FFTWisdom::startBackgroundPlanning(unsigned flags) {
+    if (planning_thread_.joinable()) {
+        return; // Already running
+    }
+
+    cancel_planning_.store(false, std::memory_order_relaxed);
+    planning_complete_.store(false, std::memory_order_relaxed);
+
+    planning_thread_ = std::thread([this, flags]() {
+        size_t expected = 0;
+        for (size_t n = MIN_FFT_SIZE; n <= MAX_FFT_SIZE; n *= 2) {
+            ++expected;
+        }
+
+        if (planAllSizes(flags, &cancel_planning_) == expected) {
+            planning_complete_.store(true, std::memory_order_release);
+        }
+    });
+}
+
+void FFTWisdom::stopBackgroundPlanning() {
+    if (!planning_thread_.joinable()) {
+        return; // Not running
+    }
+
+    cancel_planning_.store(true, std::memory_order_relaxed);
+    planning_thread_.join();
+}
+
+bool FFTWisdom::warmUp(unsigned flags) {
+    stopBackgroundPlanning();
+
+    std::cout << "Planning FFT sizes " << MIN_FFT_SIZE << "-" << MAX_FFT_SIZE
+              << " (this may take a while)..." << std::endl;
+    planAllSizes(flags);
+    planning_complete_.store(true, std::memory_order_release);
+
+    return save();
+}
+
+size_t FFTWisdom::planAllSizes(unsigned flags, const std::atomic<bool>* cancel) {
+    size_t planned = 0;
+
+    for (size_t n = MIN_FFT_SIZE; n <= MAX_FFT_SIZE; n *= 2) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            break;
+        }
+
+        const int size = static_cast<int>(n);
+        const int num_bins = size / 2 + 1;
+        const int batch = static_cast<int>(FFTProcessor::BATCH_FRAMES);
+
+        // Same shapes and alignment FFTProcessor plans, so its requests hit wisdom
+        float* in = fftwf_alloc_real(n * FFTProcessor::BATCH_FRAMES);
+        fftwf_complex* out = fftwf_alloc_complex(static_cast<size_t>(num_bins) * FFTProcessor::BATCH_FRAMES);
+        if (!in || !out) {
+            fftwf_free(in);
+            fftwf_free(out);
+            break;
+        }
+
+        // The planner lock is taken per plan, so a foreground chain build
+        // waits for at most one of them
+        {
+            std::lock_guard<std::mutex> lock(plannerMutex());
+            fftwf_plan single = fftwf_plan_dft_r2c_1d(size, in, out, flags);
+            if (single) {
+                fftwf_destroy_plan(single);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(plannerMutex());
+            fftwf_plan many = fftwf_plan_many_dft_r2c(1, &size, batch,
+                                                      in, nullptr, 1, size,
+                                                      out, nullptr, 1, num_bins,
+                                                      flags);
+            if (many) {
+                fftwf_destroy_plan(many);
+            }
+        }
+        fftwf_free(in);
+        fftwf_free(out);
+
+        ++planned;
+    }
+
+    return planned;
+}
+
+// ============================================================================
+// Static Helpers
+// ============================================================================
+
+std::string FFTWisdom::defaultCachePath() {
+    const char* file = "fftw3f.wisdom";
+
+#ifdef _WIN32
+    if (const char* local = std::getenv("LOCALAPPDATA")) {
+        return (std::filesystem::path(local) / "friture" / file).string();
+    }
+#else
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        return (std::filesystem::path(xdg) / "friture" / file).string();
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return (std::filesystem::path(home) / ".cache" / "friture" / file).string();
+    }
+#endif
+
+    return std::string();
+}
+
+std::mutex& FFTWisdom::plannerMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace friture
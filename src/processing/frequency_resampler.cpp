@@ -7,6 +7,9 @@
  */
 
 #include <friture/frequency_resampler.hpp>
+#include <friture/simd_kernels.hpp>
+#include <friture/frequency_weighting.hpp>
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <sstream>
@@ -23,7 +26,8 @@ FrequencyResampler::FrequencyResampler(
     float max_freq,
     float sample_rate,
     size_t fft_size,
-    size_t output_height
+    size_t output_height,
+    BinAggregation aggregation
 )
     : scale_(scale),
       min_freq_(min_freq),
@@ -31,7 +35,10 @@ FrequencyResampler::FrequencyResampler(
       sample_rate_(sample_rate),
       fft_size_(fft_size),
       output_height_(output_height),
-      freq_mapping_(output_height)
+      aggregation_(aggregation),
+      freq_mapping_(output_height),
+      power_(fft_size / 2 + 1),
+      weighting_(WeightingType::None)
 {
     validate();
     computeMapping();
@@ -42,9 +49,60 @@ FrequencyResampler::FrequencyResampler(
 // ============================================================================
 
 void FrequencyResampler::resample(const float* input, float* output) const {
+    resampleRows(input, output, 0, output_height_);
+}
+
+void FrequencyResampler::resampleRows(const float* input, float* output,
+                                      size_t first_row, size_t row_count) const {
+    if (first_row > output_height_ || row_count > output_height_ - first_row) {
+        throw std::invalid_argument("Row range exceeds output height");
+    }
+    if (row_count == 0) {
+        return;
+    }
+
+    const size_t end_row = first_row + row_count;
+    switch (aggregation_) {
+        case BinAggregation::MeanPower:
+            resampleMeanPower(input, output, first_row, end_row);
+            break;
+        case BinAggregation::PeakHold:
+            resamplePeakHold(input, output, first_row, end_row);
+            break;
+        case BinAggregation::Interpolate:
+        default:
+            resampleInterpolate(input, output, first_row, end_row);
+            break;
+    }
+}
+
+FrequencyResampler::BinRange FrequencyResampler::getInputRange(size_t first_row,
+                                                              size_t row_count) const {
+    if (row_count == 0 || first_row > output_height_ || row_count > output_height_ - first_row) {
+        throw std::invalid_argument("Row range must be non-empty and within output height");
+    }
+
     const size_t num_bins = fft_size_ / 2 + 1;
+    const Band& low = bands_[first_row];
+    const Band& high = bands_[first_row + row_count - 1];
 
-    for (size_t i = 0; i < output_height_; ++i) {
+    // Wide bands need not contain their row's interpolation taps
+    auto tap = [&](size_t row) {
+        float bin_idx = std::clamp(freq_mapping_[row], 0.0f, static_cast<float>(num_bins - 1));
+        return static_cast<size_t>(bin_idx);
+    };
+    BinRange range;
+    range.first = std::min<size_t>(low.start_bin, tap(first_row));
+    range.end = std::max<size_t>(high.start_bin + high.count,
+                                 std::min(tap(first_row + row_count - 1) + 2, num_bins));
+    return range;
+}
+
+void FrequencyResampler::resampleInterpolate(const float* input, float* output,
+                                             size_t first_row, size_t end_row) const {
+    const size_t num_bins = fft_size_ / 2 + 1;
+
+    for (size_t i = first_row; i < end_row; ++i) {
         float bin_idx = freq_mapping_[i];
 
         // Clamp to valid range
@@ -58,6 +116,70 @@ void FrequencyResampler::resample(const float* input, float* output) const {
         // Linear interpolation
         output[i] = input[bin0] * (1.0f - frac) + input[bin1] * frac;
     }
+
+    if (weighting_db_) {
+        for (size_t i = first_row; i < end_row; ++i) {
+            output[i] += row_offset_db_[i];
+        }
+    }
+}
+
+void FrequencyResampler::resampleMeanPower(const float* input, float* output,
+                                           size_t first_row, size_t end_row) const {
+    // dB → linear power once per bin, over the bins the rows' bands touch
+    const size_t first = bands_[first_row].start_bin;
+    const size_t last = bands_[end_row - 1].start_bin + bands_[end_row - 1].count;
+    simd::dbToPower(input + first, power_.data() + first, last - first);
+
+    // Weighted: wide rows use the gain-scaled weights, interpolated rows
+    // (combined in dB) add their offset
+    const float* weights = weighting_db_ ? weighted_band_weights_.data() : band_weights_.data();
+    for (size_t i = first_row; i < end_row; ++i) {
+        const Band& band = bands_[i];
+        const float* w = weights + band.weight_offset;
+
+        float acc = 0.0f;
+        if (band.interpolated) {
+            const float* x = input + band.start_bin;
+            for (uint32_t k = 0; k < band.count; ++k) {
+                acc += w[k] * x[k];
+            }
+            output[i] = weighting_db_ ? acc + row_offset_db_[i] : acc;
+        } else {
+            const float* p = power_.data() + band.start_bin;
+            for (uint32_t k = 0; k < band.count; ++k) {
+                acc += w[k] * p[k];
+            }
+            output[i] = 10.0f * simd::fastLog10(std::max(acc, 1e-30f));
+        }
+    }
+}
+
+void FrequencyResampler::resamplePeakHold(const float* input, float* output,
+                                          size_t first_row, size_t end_row) const {
+    const float* weights = band_weights_.data();
+    for (size_t i = first_row; i < end_row; ++i) {
+        const Band& band = bands_[i];
+        const float* x = input + band.start_bin;
+
+        if (band.interpolated) {
+            const float* w = weights + band.weight_offset;
+            float acc = 0.0f;
+            for (uint32_t k = 0; k < band.count; ++k) {
+                acc += w[k] * x[k];
+            }
+            output[i] = weighting_db_ ? acc + row_offset_db_[i] : acc;
+        } else if (weighting_db_) {
+            const float* o = weighting_db_->data() + band.start_bin;
+            float peak = x[0] + o[0];
+            for (uint32_t k = 1; k < band.count; ++k) {
+                peak = std::max(peak, x[k] + o[k]);
+            }
+            output[i] = peak;
+        } else {
+            output[i] = *std::max_element(x, x + band.count);
+        }
+    }
 }
 
 // ============================================================================
@@ -175,6 +297,129 @@ void FrequencyResampler::computeMapping() {
         // Store mapping
         freq_mapping_[i] = bin_idx;
     }
+
+    computeBands();
+}
+
+void FrequencyResampler::computeBands() {
+    const size_t num_bins = fft_size_ / 2 + 1;
+    const float max_edge = static_cast<float>(num_bins) - 0.5f;
+
+    bands_.resize(output_height_);
+    band_weights_.clear();
+    band_weights_.reserve(num_bins + 2 * output_height_);
+
+    for (size_t i = 0; i < output_height_; ++i) {
+        const float centre = freq_mapping_[i];
+
+        // Band edges halfway to the neighbouring pixel centres; the outer
+        // rows mirror their inner half-width
+        float lo;
+        float hi;
+        if (output_height_ == 1) {
+            lo = centre - 0.5f;
+            hi = centre + 0.5f;
+        } else if (i == 0) {
+            hi = 0.5f * (centre + freq_mapping_[1]);
+            lo = centre - (hi - centre);
+        } else if (i == output_height_ - 1) {
+            lo = 0.5f * (freq_mapping_[i - 1] + centre);
+            hi = centre + (centre - lo);
+        } else {
+            lo = 0.5f * (freq_mapping_[i - 1] + centre);
+            hi = 0.5f * (centre + freq_mapping_[i + 1]);
+        }
+        lo = std::clamp(lo, -0.5f, max_edge);
+        hi = std::clamp(hi, -0.5f, max_edge);
+
+        Band& band = bands_[i];
+        band.weight_offset = static_cast<uint32_t>(band_weights_.size());
+
+        if (hi - lo <= 1.0f) {
+            // Narrower than a bin: same two taps as resampleInterpolate()
+            float bin_idx = std::clamp(centre, 0.0f, static_cast<float>(num_bins - 1));
+            size_t bin0 = static_cast<size_t>(bin_idx);
+            size_t bin1 = std::min(bin0 + 1, num_bins - 1);
+            float frac = bin_idx - static_cast<float>(bin0);
+
+            band.start_bin = static_cast<uint32_t>(bin0);
+            band.interpolated = true;
+            band_weights_.push_back(1.0f - frac);
+            if (bin1 > bin0) {
+                band_weights_.push_back(frac);
+                band.count = 2;
+            } else {
+                band.count = 1;
+            }
+            continue;
+        }
+
+        // Bins whose [k - 0.5, k + 0.5] interval overlaps [lo, hi]
+        size_t first = static_cast<size_t>(std::floor(lo + 0.5f));
+        size_t last = std::min(static_cast<size_t>(std::floor(hi + 0.5f)), num_bins - 1);
+
+        float total = 0.0f;
+        for (size_t k = first; k <= last; ++k) {
+            float bin_lo = std::max(lo, static_cast<float>(k) - 0.5f);
+            float bin_hi = std::min(hi, static_cast<float>(k) + 0.5f);
+            float overlap = std::max(bin_hi - bin_lo, 0.0f);
+            band_weights_.push_back(overlap);
+            total += overlap;
+        }
+
+        band.start_bin = static_cast<uint32_t>(first);
+        band.count = static_cast<uint32_t>(last - first + 1);
+        band.interpolated = false;
+
+        float* w = band_weights_.data() + band.weight_offset;
+        for (uint32_t k = 0; k < band.count; ++k) {
+            w[k] /= total;
+        }
+    }
+
+    computeWeighting();
+}
+
+void FrequencyResampler::setWeighting(WeightingType type) {
+    if (type == weighting_) {
+        return;
+    }
+    weighting_ = type;
+    weighting_db_ = weightingTable(type, fft_size_, sample_rate_);
+    computeWeighting();
+}
+
+void FrequencyResampler::computeWeighting() {
+    if (!weighting_db_) {
+        weighted_band_weights_.clear();
+        row_offset_db_.clear();
+        return;
+    }
+    const std::vector<float>& offsets = *weighting_db_;
+    const size_t num_bins = fft_size_ / 2 + 1;
+
+    // Offset at each row's interpolation point (dB is interpolated linearly,
+    // so adding it afterwards is exact)
+    row_offset_db_.resize(output_height_);
+    for (size_t i = 0; i < output_height_; ++i) {
+        const float bin_idx = std::clamp(freq_mapping_[i], 0.0f, static_cast<float>(num_bins - 1));
+        const size_t bin0 = static_cast<size_t>(bin_idx);
+        const size_t bin1 = std::min(bin0 + 1, num_bins - 1);
+        const float frac = bin_idx - static_cast<float>(bin0);
+        row_offset_db_[i] = offsets[bin0] * (1.0f - frac) + offsets[bin1] * frac;
+    }
+
+    // Wide rows average power: scale each bin's weight by its linear gain
+    weighted_band_weights_ = band_weights_;
+    for (const Band& band : bands_) {
+        if (band.interpolated) {
+            continue;
+        }
+        float* w = weighted_band_weights_.data() + band.weight_offset;
+        for (uint32_t k = 0; k < band.count; ++k) {
+            w[k] *= std::pow(10.0f, 0.1f * offsets[band.start_bin + k]);
+        }
+    }
 }
 
 } // namespace friture
@@ -0,0 +1,93 @@
+/**
+ * @file frequency_weighting.cpp
+ * @brief Implementation of the frequency weighting curves and table cache
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/frequency_weighting.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+namespace friture {
+
+namespace {
+
+// IEC 61672-1 pole frequencies (Hz)
+constexpr double F1 = 20.598997;
+constexpr double F2 = 107.65265;
+constexpr double F3 = 737.86223;
+constexpr double F4 = 12194.217;
+constexpr double F5 = 158.48932;
+
+// Un-normalized curves in dB
+double curveDb(WeightingType type, double f) {
+    const double f_sq = f * f;
+    const double common = (F4 * F4) / ((f_sq + F1 * F1) * (f_sq + F4 * F4));
+    switch (type) {
+        case WeightingType::A:
+            return 20.0 * std::log10(common * f_sq * f_sq /
+                                     std::sqrt((f_sq + F2 * F2) * (f_sq + F3 * F3)));
+        case WeightingType::B:
+            return 20.0 * std::log10(common * f_sq * f / std::sqrt(f_sq + F5 * F5));
+        case WeightingType::C:
+            return 20.0 * std::log10(common * f_sq);
+        case WeightingType::None:
+        default:
+            return 0.0;
+    }
+}
+
+struct CachedTable {
+    WeightingType type;
+    size_t fft_size;
+    float sample_rate;
+    std::shared_ptr<const std::vector<float>> offsets;
+};
+
+} // namespace
+
+double weightingDb(WeightingType type, double frequency_hz) {
+    if (type == WeightingType::None) {
+        return 0.0;
+    }
+    if (frequency_hz <= 0.0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    return curveDb(type, frequency_hz) - curveDb(type, 1000.0);
+}
+
+std::shared_ptr<const std::vector<float>> weightingTable(WeightingType type, size_t fft_size,
+                                                         float sample_rate) {
+    if (fft_size == 0 || !(sample_rate > 0.0f)) {
+        throw std::invalid_argument("Weighting table needs an FFT size and sample rate");
+    }
+    if (type == WeightingType::None) {
+        return nullptr;
+    }
+
+    static std::mutex mutex;
+    static std::vector<CachedTable> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const CachedTable& entry : cache) {
+        if (entry.type == type && entry.fft_size == fft_size && entry.sample_rate == sample_rate) {
+            return entry.offsets;
+        }
+    }
+
+    auto offsets = std::make_shared<std::vector<float>>(fft_size / 2 + 1);
+    const double bin_hz = static_cast<double>(sample_rate) / static_cast<double>(fft_size);
+    for (size_t k = 0; k < offsets->size(); ++k) {
+        const double db = weightingDb(type, static_cast<double>(k) * bin_hz);
+        (*offsets)[k] = static_cast<float>(std::max(db, static_cast<double>(WEIGHTING_FLOOR_DB)));
+    }
+    cache.push_back(CachedTable{type, fft_size, sample_rate, offsets});
+    return offsets;
+}
+
+} // namespace friture
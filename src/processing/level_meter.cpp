@@ -0,0 +1,157 @@
+/**
+ * @file level_meter.cpp
+ * @brief Implementation of LevelMeter
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#define _USE_MATH_DEFINES  // For M_PI on Windows/MSVC
+#include <friture/level_meter.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace friture {
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+LevelMeter::LevelMeter(float sample_rate, float integration_seconds,
+                       float release_seconds, float clip_level)
+    : sample_rate_(sample_rate),
+      integration_seconds_(integration_seconds),
+      release_seconds_(release_seconds),
+      clip_level_(clip_level),
+      max_backlog_(0),
+      mean_square_(0.0),
+      peak_(0.0f),
+      true_peak_(0.0f),
+      clip_count_(0),
+      samples_metered_(0),
+      history_{},
+      history_pos_(0),
+      cursor_valid_(false),
+      block_(BLOCK_SIZE)
+{
+    if (sample_rate <= 0.0f || integration_seconds <= 0.0f || release_seconds <= 0.0f) {
+        throw std::invalid_argument("Sample rate and time constants must be > 0");
+    }
+
+    max_backlog_ = std::max<size_t>(static_cast<size_t>(sample_rate * 0.5f), BLOCK_SIZE);
+    designInterpolator();
+}
+
+void LevelMeter::designInterpolator() {
+    // Windowed sinc with cutoff at the input Nyquist frequency, centred on a
+    // tap of phase 0 so that phase reproduces the input samples exactly
+    const size_t length = OVERSAMPLING * TAPS_PER_PHASE;
+    const double centre = static_cast<double>(length) / 2.0;
+
+    for (size_t n = 0; n < length; ++n) {
+        const double x = (static_cast<double>(n) - centre) / OVERSAMPLING;
+        const double sinc = (x == 0.0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+        // Blackman window over length + 1 points (the last one is zero)
+        const double t = static_cast<double>(n) / length;
+        const double window = 0.42 - 0.5 * std::cos(2.0 * M_PI * t) + 0.08 * std::cos(4.0 * M_PI * t);
+
+        // Tap k of phase p multiplies input x[i - k]: n = k * OVERSAMPLING + p
+        taps_[n % OVERSAMPLING][n / OVERSAMPLING] = static_cast<float>(sinc * window);
+    }
+
+    for (auto& phase : taps_) {
+        float sum = 0.0f;
+        for (float tap : phase) {
+            sum += tap;
+        }
+        for (float& tap : phase) {
+            tap /= sum;
+        }
+    }
+}
+
+// ============================================================================
+// Metering
+// ============================================================================
+
+size_t LevelMeter::update(const RingBuffer<float>& ring) {
+    const uint64_t total = ring.getTotalWritten();
+    if (!cursor_valid_ || cursor_.position() > total) {
+        cursor_ = ring.makeCursor(0);
+        cursor_valid_ = true;
+    } else if (total - cursor_.position() > max_backlog_) {
+        // Too far behind to catch up cheaply; the old samples are stale anyway
+        cursor_.seek(total - max_backlog_);
+    }
+
+    size_t metered = 0;
+    while (ring.readWindow(cursor_, block_.data(), BLOCK_SIZE, BLOCK_SIZE) != ReadStatus::NotReady) {
+        process(block_.data(), BLOCK_SIZE);
+        metered += BLOCK_SIZE;
+    }
+    return metered;
+}
+
+void LevelMeter::process(const float* samples, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    double sum_squares = 0.0;
+    float block_peak = 0.0f;
+    float block_true_peak = 0.0f;
+
+    for (size_t i = 0; i < count; ++i) {
+        const float x = samples[i];
+        const float magnitude = std::fabs(x);
+
+        sum_squares += static_cast<double>(x) * x;
+        block_peak = std::max(block_peak, magnitude);
+        if (magnitude >= clip_level_) {
+            ++clip_count_;
+        }
+
+        // history_[pos + k] holds x[i - k] for k in [0, TAPS_PER_PHASE)
+        history_pos_ = (history_pos_ + TAPS_PER_PHASE - 1) % TAPS_PER_PHASE;
+        history_[history_pos_] = x;
+        history_[history_pos_ + TAPS_PER_PHASE] = x;
+        const float* window = history_.data() + history_pos_;
+
+        for (const auto& phase : taps_) {
+            float y = 0.0f;
+            for (size_t k = 0; k < TAPS_PER_PHASE; ++k) {
+                y += phase[k] * window[k];
+            }
+            block_true_peak = std::max(block_true_peak, std::fabs(y));
+        }
+    }
+
+    // One-pole smoothing over the whole block
+    const double n = static_cast<double>(count);
+    const double attack = 1.0 - std::exp(-n / (integration_seconds_ * sample_rate_));
+    mean_square_ += (sum_squares / n - mean_square_) * attack;
+
+    const float release = static_cast<float>(std::exp(-n / (release_seconds_ * sample_rate_)));
+    peak_ = std::max(peak_ * release, block_peak);
+    true_peak_ = std::max(true_peak_ * release, std::max(block_true_peak, block_peak));
+
+    samples_metered_ += count;
+}
+
+void LevelMeter::reset() {
+    mean_square_ = 0.0;
+    peak_ = 0.0f;
+    true_peak_ = 0.0f;
+    clip_count_ = 0;
+    samples_metered_ = 0;
+    history_.fill(0.0f);
+    history_pos_ = 0;
+    cursor_valid_ = false;
+}
+
+float LevelMeter::getRms() const {
+    return static_cast<float>(std::sqrt(mean_square_));
+}
+
+} // namespace friture
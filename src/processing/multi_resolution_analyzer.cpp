@@ -0,0 +1,133 @@
+/**
+ * @file multi_resolution_analyzer.cpp
+ * @brief Implementation of MultiResolutionAnalyzer
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/multi_resolution_analyzer.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace friture {
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+MultiResolutionAnalyzer::MultiResolutionAnalyzer(const ChainKey& key,
+                                                 std::shared_ptr<FFTProcessor> base_fft,
+                                                 size_t max_fft_size)
+    : window_size_(key.fft_size)
+{
+    if (!base_fft || base_fft->getFFTSize() != key.fft_size) {
+        throw std::invalid_argument("FFT processor does not match analyzer key");
+    }
+    if (key.height == 0) {
+        throw std::invalid_argument("Analyzer height must be > 0");
+    }
+
+    // Candidate sizes: N0, 4·N0, 16·N0 ... within the limit
+    std::vector<size_t> sizes{key.fft_size};
+    while (sizes.size() < MAX_BANDS && sizes.back() * SIZE_STEP <= max_fft_size) {
+        sizes.push_back(sizes.back() * SIZE_STEP);
+    }
+
+    auto base_resampler = std::make_unique<FrequencyResampler>(
+        key.scale, key.min_freq, key.max_freq, key.sample_rate,
+        key.fft_size, key.height, key.aggregation);
+
+    // Row spacing in base bins decides the smallest FFT that resolves it
+    const std::vector<float>& mapping = base_resampler->getFrequencyMapping();
+    const size_t height = key.height;
+    std::vector<size_t> size_index(height, 0);
+    for (size_t i = 0; i < height; ++i) {
+        float spacing = 1.0f;
+        if (height > 1) {
+            spacing = (i + 1 < height) ? mapping[i + 1] - mapping[i] : mapping[i] - mapping[i - 1];
+        }
+
+        size_t k = 0;
+        float ratio = 1.0f;
+        while (k + 1 < sizes.size() && ratio * spacing < 1.0f) {
+            ++k;
+            ratio *= static_cast<float>(SIZE_STEP);
+        }
+        // Keep bands contiguous: never a larger FFT above a smaller one
+        size_index[i] = (i > 0) ? std::min(k, size_index[i - 1]) : k;
+    }
+
+    for (size_t k = 0; k < sizes.size(); ++k) {
+        auto first = std::find(size_index.begin(), size_index.end(), k);
+        if (first == size_index.end()) {
+            continue;
+        }
+        const size_t first_row = static_cast<size_t>(first - size_index.begin());
+        const size_t row_count = static_cast<size_t>(std::count(first, size_index.end(), k));
+
+        BandState band;
+        band.layout = Band{sizes[k], first_row, row_count, sizes[k] / sizes[0], k};
+        if (k == 0) {
+            band.fft = base_fft;
+            band.resampler = std::move(base_resampler);
+        } else {
+            band.fft = std::make_shared<FFTProcessor>(sizes[k], key.window, key.kaiser_beta);
+            band.resampler = std::make_unique<FrequencyResampler>(
+                key.scale, key.min_freq, key.max_freq, key.sample_rate,
+                sizes[k], key.height, key.aggregation);
+        }
+        band.resampler->setWeighting(key.weighting);
+        band.spectrum.resize(sizes[k] / 2 + 1);
+        window_size_ = std::max(window_size_, sizes[k]);
+        bands_.push_back(std::move(band));
+    }
+
+    output_.resize(height, 0.0f);
+}
+
+// ============================================================================
+// Processing
+// ============================================================================
+
+size_t MultiResolutionAnalyzer::analyze(const float* window) {
+    size_t transformed = 0;
+    for (BandState& band : bands_) {
+        const Band& layout = band.layout;
+        const bool due = column_ == 0 || (column_ + layout.phase) % layout.period == 0;
+        if (!due) {
+            continue;
+        }
+
+        // Centre every frame on the middle of the shared window; only the
+        // bins of the band's own rows are converted to dB
+        const float* frame = window + (window_size_ - layout.fft_size) / 2;
+        const FrequencyResampler::BinRange range =
+            band.resampler->getInputRange(layout.first_row, layout.row_count);
+        band.fft->process(frame, band.spectrum.data(), range.first, range.end);
+        band.updated = true;
+        ++transformed;
+    }
+    ++column_;
+    return transformed;
+}
+
+void MultiResolutionAnalyzer::stitch(float* column_db) {
+    for (BandState& band : bands_) {
+        if (band.updated) {
+            band.resampler->resampleRows(band.spectrum.data(), output_.data(),
+                                         band.layout.first_row, band.layout.row_count);
+            band.updated = false;
+        }
+    }
+    std::copy(output_.begin(), output_.end(), column_db);
+}
+
+void MultiResolutionAnalyzer::reset() {
+    column_ = 0;
+    for (BandState& band : bands_) {
+        band.updated = false;
+    }
+}
+
+} // namespace friture
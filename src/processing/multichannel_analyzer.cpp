@@ -0,0 +1,169 @@
+/**
+ * @file multichannel_analyzer.cpp
+ * @brief Implementation of MultiChannelAnalyzer
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#include <friture/multichannel_analyzer.hpp>
+#include <friture/realtime_check.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace friture {
+
+namespace {
+
+// Level for rows no channel covers (below any display range)
+constexpr float UNCOVERED_DB = -200.0f;
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+MultiChannelAnalyzer::MultiChannelAnalyzer(const ChainKey& key,
+                                           size_t channels,
+                                           ChannelLayout layout,
+                                           size_t display_height,
+                                           size_t threads)
+    : layout_(layout),
+      display_height_(display_height),
+      lane_height_(0)
+{
+    if (channels == 0) {
+        throw std::invalid_argument("Channel count must be > 0");
+    }
+    if (display_height < channels) {
+        throw std::invalid_argument("Display height must be >= channel count");
+    }
+
+    lane_height_ = (layout == ChannelLayout::Stacked) ? display_height / channels : display_height;
+
+    // Every channel gets its own FFT processor: chains sharing one must
+    // not run concurrently
+    ChainKey lane_key = key;
+    lane_key.height = lane_height_;
+    lane_key.multi_resolution = false;  // Lanes read fft_size samples per channel
+    lane_key.zoom = false;
+    chains_.reserve(channels);
+    for (size_t c = 0; c < channels; ++c) {
+        auto fft = std::make_shared<FFTProcessor>(lane_key.fft_size, lane_key.window,
+                                                  lane_key.kaiser_beta);
+        chains_.push_back(std::make_unique<ProcessingChain>(lane_key, std::move(fft)));
+    }
+
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, channels);
+
+    workers_.reserve(threads - 1);
+    for (size_t w = 1; w < threads; ++w) {
+        workers_.emplace_back(&MultiChannelAnalyzer::workerLoop, this, w);
+    }
+}
+
+MultiChannelAnalyzer::~MultiChannelAnalyzer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+// ============================================================================
+// Processing
+// ============================================================================
+
+void MultiChannelAnalyzer::process() {
+    if (workers_.empty()) {
+        processShare(0);
+        return;
+    }
+
+    {
+        // Fork-join hand-off: a short wait for this frame's own work
+        RealtimeExemption exemption;
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+        workers_busy_ = workers_.size();
+    }
+    start_cv_.notify_all();
+
+    // The caller is worker 0
+    processShare(0);
+
+    RealtimeExemption exemption;
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return workers_busy_ == 0; });
+}
+
+void MultiChannelAnalyzer::processShare(size_t worker) {
+    const size_t stride = getThreadCount();
+    for (size_t c = worker; c < chains_.size(); c += stride) {
+        ProcessingChain& chain = *chains_[c];
+        const FrequencyResampler::BinRange range = chain.resampler().getInputRange();
+        chain.fft().process(chain.fft_input.data(), chain.fft_output.data(),
+                            range.first, range.end);
+        chain.resampler().resample(chain.fft_output.data(), chain.resampled.data());
+    }
+}
+
+void MultiChannelAnalyzer::workerLoop(size_t worker) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        {
+            RealtimeScope scope("DSP worker");
+            processShare(worker);
+        }
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last = (--workers_busy_ == 0);
+        }
+        if (last) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void MultiChannelAnalyzer::combine(float* output) const {
+    if (layout_ == ChannelLayout::Overlay) {
+        std::span<const float> first = chains_.front()->resampled;
+        std::copy(first.begin(), first.end(), output);
+        for (size_t c = 1; c < chains_.size(); ++c) {
+            const float* column = chains_[c]->resampled.data();
+            for (size_t row = 0; row < display_height_; ++row) {
+                output[row] = std::max(output[row], column[row]);
+            }
+        }
+        return;
+    }
+
+    // Stacked: lanes from the top down, leftover rows at the bottom
+    const size_t leftover = display_height_ - lane_height_ * chains_.size();
+    std::fill(output, output + leftover, UNCOVERED_DB);
+    for (size_t c = 0; c < chains_.size(); ++c) {
+        const size_t lane_start = display_height_ - (c + 1) * lane_height_;
+        std::span<const float> column = chains_[c]->resampled;
+        std::copy(column.begin(), column.end(), output + lane_start);
+    }
+}
+
+} // namespace friture
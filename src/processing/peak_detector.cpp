@@ -0,0 +1,291 @@
+/**
+ * @file peak_detector.cpp
+ * @brief Implementation of PeakDetector
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/peak_detector.hpp>
+#include <friture/simd_kernels.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace friture {
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+PeakDetector::PeakDetector(size_t fft_size, float sample_rate, size_t hop_size,
+                           const Options& options)
+    : fft_size_(fft_size),
+      sample_rate_(sample_rate),
+      hop_size_(hop_size),
+      options_(options),
+      rise_(0.0f),
+      fall_(0.0f),
+      hold_hops_(1),
+      peak_count_(0),
+      open_tracks_(0),
+      next_track_id_(0),
+      primed_(false),
+      range_first_(0),
+      range_end_(0),
+      events_(std::max<size_t>(options.queue_capacity, 1)),
+      dropped_events_(0)
+{
+    if (fft_size < 4 || sample_rate <= 0.0f || hop_size == 0) {
+        throw std::invalid_argument("FFT size must be >= 4, sample rate and hop size > 0");
+    }
+    if (!(options.release_db > 0.0f && options.release_db <= options.threshold_db)) {
+        throw std::invalid_argument("Release level must be in (0, threshold]");
+    }
+    if (!(options.floor_rise_seconds > 0.0f && options.floor_fall_seconds > 0.0f &&
+          options.track_tolerance_bins > 0.0f)) {
+        throw std::invalid_argument("Floor time constants and track tolerance must be > 0");
+    }
+    if (!(options.hold_seconds >= 0.0f && options.mask_bins >= 0.0f && options.mask_db >= 0.0f)) {
+        throw std::invalid_argument("Hold time and masking must be >= 0");
+    }
+    if (options.max_peaks == 0 || options.max_tracks == 0 || options.queue_capacity == 0) {
+        throw std::invalid_argument("Peak, track and queue capacities must be > 0");
+    }
+
+    // Exponential averages expressed per hop
+    const double hop_seconds = static_cast<double>(hop_size) / sample_rate;
+    rise_ = static_cast<float>(1.0 - std::exp(-hop_seconds / options.floor_rise_seconds));
+    fall_ = static_cast<float>(1.0 - std::exp(-hop_seconds / options.floor_fall_seconds));
+    hold_hops_ = std::max<uint32_t>(
+        1, static_cast<uint32_t>(std::ceil(options.hold_seconds / hop_seconds)));
+
+    const size_t num_bins = fft_size / 2 + 1;
+    floor_.assign(num_bins, 0.0f);
+    excess_.assign(num_bins, 0.0f);
+    peaks_.resize(options.max_peaks);
+    tracks_.resize(options.max_tracks);
+}
+
+// ============================================================================
+// Detection
+// ============================================================================
+
+size_t PeakDetector::process(const float* spectrum_db, size_t first, size_t end, uint64_t position) {
+    end = std::min(end, fft_size_ / 2 + 1);
+    if (first >= end) {
+        return 0;
+    }
+    if (!primed_ || first != range_first_ || end != range_end_) {
+        prime(spectrum_db, first, end);
+    }
+
+    const float max_excess = simd::trackFloor(spectrum_db + first, floor_.data() + first,
+                                              excess_.data() + first, end - first, rise_, fall_);
+    if (max_excess <= options_.threshold_db && open_tracks_ == 0) {
+        return 0;   // Nothing can open a track and nothing to close
+    }
+
+    findPeaks(spectrum_db, first, end, max_excess);
+
+    // Strongest first: they claim tracks before weaker neighbours and mask
+    // the sidelobes around them
+    std::sort(peaks_.begin(), peaks_.begin() + static_cast<std::ptrdiff_t>(peak_count_),
+              [](const Peak& a, const Peak& b) { return a.excess > b.excess; });
+
+    size_t kept = 0;
+    for (size_t p = 0; p < peak_count_; ++p) {
+        const Peak& peak = peaks_[p];
+        bool masked = false;
+        for (size_t q = 0; q < kept && !masked; ++q) {
+            masked = std::fabs(peak.bin - peaks_[q].bin) <= options_.mask_bins &&
+                     peak.level_db < peaks_[q].level_db - options_.mask_db;
+        }
+        if (!masked) {
+            peaks_[kept++] = peak;
+        }
+    }
+
+    for (size_t t = 0; t < open_tracks_; ++t) {
+        tracks_[t].matched = false;
+    }
+
+    size_t raised = 0;
+    const float bin_hz = sample_rate_ / static_cast<float>(fft_size_);
+
+    for (size_t p = 0; p < kept; ++p) {
+        const Peak& peak = peaks_[p];
+
+        // Nearest track not yet continued this hop
+        Track* nearest = nullptr;
+        float nearest_distance = options_.track_tolerance_bins;
+        for (size_t t = 0; t < open_tracks_; ++t) {
+            Track& track = tracks_[t];
+            const float distance = std::fabs(peak.bin - track.bin);
+            if (!track.matched && distance <= nearest_distance) {
+                nearest = &track;
+                nearest_distance = distance;
+            }
+        }
+
+        if (nearest) {
+            nearest->bin = peak.bin;
+            nearest->peak_db = std::max(nearest->peak_db, peak.level_db);
+            nearest->last_seen = position;
+            nearest->missed = 0;
+            nearest->matched = true;
+        } else if (peak.excess > options_.threshold_db && open_tracks_ < tracks_.size()) {
+            tracks_[open_tracks_++] = Track{next_track_id_, peak.bin, peak.level_db, peak.floor_db,
+                                            position, position, 0, true};
+
+            PeakEvent event;
+            event.type = PeakEventType::Onset;
+            event.track = next_track_id_++;
+            event.position = position;
+            event.frequency = peak.bin * bin_hz;
+            event.level_db = peak.level_db;
+            event.floor_db = peak.floor_db;
+            emit(event);
+            ++raised;
+        }
+    }
+
+    // Tracks without a peak for the hold time close
+    for (size_t t = 0; t < open_tracks_;) {
+        Track& track = tracks_[t];
+        if (!track.matched && ++track.missed >= hold_hops_) {
+            closeTrack(t, position);
+            ++raised;
+        } else {
+            ++t;
+        }
+    }
+
+    return raised;
+}
+
+size_t PeakDetector::finish(uint64_t position) {
+    const size_t closed = open_tracks_;
+    while (open_tracks_ > 0) {
+        closeTrack(open_tracks_ - 1, position);
+    }
+    return closed;
+}
+
+void PeakDetector::reset() {
+    open_tracks_ = 0;
+    peak_count_ = 0;
+    primed_ = false;
+}
+
+void PeakDetector::prime(const float* spectrum_db, size_t first, size_t end) {
+    // Median level via the excess buffer as scratch (no allocation)
+    float* scratch = excess_.data() + first;
+    const size_t n = end - first;
+    std::copy(spectrum_db + first, spectrum_db + end, scratch);
+    std::nth_element(scratch, scratch + n / 2, scratch + n);
+    std::fill(floor_.begin() + static_cast<std::ptrdiff_t>(first),
+              floor_.begin() + static_cast<std::ptrdiff_t>(end), scratch[n / 2]);
+
+    range_first_ = first;
+    range_end_ = end;
+    primed_ = true;
+}
+
+void PeakDetector::findPeaks(const float* spectrum_db, size_t first, size_t end, float max_excess) {
+    peak_count_ = 0;
+    if (end - first < 3) {
+        return;
+    }
+    const size_t begin = first + 1;   // Bins with both neighbours in range
+    const size_t last = end - 1;
+    const float threshold = options_.threshold_db;
+
+    const bool full_scan = max_excess > threshold;
+    if (full_scan) {
+        scanPeaks(spectrum_db, begin, last, threshold, INFINITY);
+    }
+
+    // Weaker peaks only around open tracks (a maximum at bin k interpolates
+    // to within half a bin of k)
+    const float reach = options_.track_tolerance_bins + 0.5f;
+    const float upper = full_scan ? threshold : INFINITY;   // Stronger ones are in already
+    for (size_t t = 0; t < open_tracks_; ++t) {
+        const float bin = tracks_[t].bin;
+        const size_t lo = std::max(begin, static_cast<size_t>(std::max(0.0f, std::floor(bin - reach))));
+        const size_t hi = std::min(last, static_cast<size_t>(std::max(0.0f, std::ceil(bin + reach))) + 1);
+        if (lo < hi) {
+            scanPeaks(spectrum_db, lo, hi, options_.release_db, upper);
+        }
+    }
+}
+
+void PeakDetector::scanPeaks(const float* spectrum_db, size_t begin, size_t end,
+                             float min_excess, float max_excess) {
+    const float* excess = excess_.data();
+
+    for (size_t k = begin; k < end; ++k) {
+        const float e = excess[k];
+        if (!(e > min_excess) || e > max_excess) {
+            continue;
+        }
+        const float b = spectrum_db[k];
+        const float a = spectrum_db[k - 1];
+        const float c = spectrum_db[k + 1];
+        if (!(b > a && b >= c)) {
+            continue;
+        }
+
+        // Windows of neighbouring tracks overlap: each maximum once
+        bool seen = false;
+        for (size_t p = 0; p < peak_count_ && !seen; ++p) {
+            seen = peaks_[p].index == k;
+        }
+        if (seen) {
+            continue;
+        }
+
+        // Parabola through the three bins around the maximum
+        const float offset = 0.5f * (a - c) / (a - 2.0f * b + c);
+        const Peak peak{k, static_cast<float>(k) + offset, b - 0.25f * (a - c) * offset, b - e, e};
+
+        if (peak_count_ < peaks_.size()) {
+            peaks_[peak_count_++] = peak;
+        } else {
+            // Full: replace the weakest if this one is stronger
+            auto weakest = std::min_element(peaks_.begin(), peaks_.end(),
+                [](const Peak& x, const Peak& y) { return x.excess < y.excess; });
+            if (weakest->excess < peak.excess) {
+                *weakest = peak;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Events
+// ============================================================================
+
+void PeakDetector::emit(const PeakEvent& event) {
+    if (!events_.tryPush(event)) {
+        dropped_events_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PeakDetector::closeTrack(size_t i, uint64_t position) {
+    const Track& track = tracks_[i];
+
+    PeakEvent event;
+    event.type = PeakEventType::Offset;
+    event.track = track.id;
+    event.position = position;
+    event.duration = track.last_seen - track.onset;
+    event.frequency = track.bin * sample_rate_ / static_cast<float>(fft_size_);
+    event.level_db = track.peak_db;
+    event.floor_db = track.floor_db;
+    emit(event);
+
+    tracks_[i] = tracks_[--open_tracks_];
+}
+
+} // namespace friture
@@ -0,0 +1,201 @@
+/**
+ * @file processing_chain.cpp
+ * @brief Implementation of ProcessingChain and ProcessingChainCache
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#include <friture/processing_chain.hpp>
+#include <friture/multi_resolution_analyzer.hpp>
+#include <friture/sliding_dft.hpp>
+#include <friture/zoom_analyzer.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace friture {
+
+namespace {
+
+size_t hopSizeFor(const ChainKey& key) {
+    SpectrogramSettings settings;
+    settings.fft_size = key.fft_size;
+    settings.overlap_percent = key.overlap_percent;
+    return settings.getSamplesPerColumn();
+}
+
+} // namespace
+
+// ============================================================================
+// ProcessingChain
+// ============================================================================
+
+ProcessingChain::ProcessingChain(const ChainKey& key, std::shared_ptr<FFTProcessor> fft)
+    : key_(key),
+      hop_size_(hopSizeFor(key)),
+      window_size_(key.fft_size),
+      fft_(std::move(fft)),
+      resampler_(key.scale, key.min_freq, key.max_freq, key.sample_rate,
+                 key.fft_size, key.height, key.aggregation)
+{
+    if (!fft_ || fft_->getFFTSize() != key.fft_size) {
+        throw std::invalid_argument("FFT processor does not match chain key");
+    }
+    resampler_.setWeighting(key.weighting);
+
+    if (key.zoom && ZoomAnalyzer::decimationFor(key) >= 2) {
+        zoom_ = std::make_unique<ZoomAnalyzer>(key);
+        window_size_ = zoom_->getWindowSize();
+    } else if (key.multi_resolution) {
+        multi_resolution_ = std::make_unique<MultiResolutionAnalyzer>(key, fft_);
+        window_size_ = multi_resolution_->getWindowSize();
+    } else if (hop_size_ < key.fft_size) {
+        // Tiny hops: update only the displayed bins, if that beats a full FFT
+        std::vector<uint32_t> bins = SlidingDFT::displayedBins(resampler_, key.fft_size / 2 + 1);
+        if (SlidingDFT::supports(key.window) &&
+            SlidingDFT::isCheaper(key.fft_size, hop_size_, bins.size())) {
+            sliding_dft_ = std::make_unique<SlidingDFT>(key.fft_size, key.window, hop_size_, bins);
+        }
+    }
+
+    const size_t num_bins = key.fft_size / 2 + 1;
+    const size_t batch_samples = (BATCH_COLUMNS - 1) * hop_size_ + key.fft_size;
+
+    arena_ = AlignedArena(AlignedArena::bytesFor<float>(window_size_) +
+                          AlignedArena::bytesFor<float>(num_bins) +
+                          AlignedArena::bytesFor<float>(batch_samples) +
+                          AlignedArena::bytesFor<float>(BATCH_COLUMNS * num_bins) +
+                          AlignedArena::bytesFor<float>(key.height));
+    fft_input = arena_.allocate<float>(window_size_);
+    fft_output = arena_.allocate<float>(num_bins);
+    batch_input = arena_.allocate<float>(batch_samples);
+    batch_spectra = arena_.allocate<float>(BATCH_COLUMNS * num_bins);
+    resampled = arena_.allocate<float>(key.height);
+
+    // Plan the batched transform now rather than on the first catch-up burst
+    fft_->prepareBatch();
+}
+
+ProcessingChain::~ProcessingChain() = default;
+
+bool ProcessingChain::analyze(StageProfiler& profiler) {
+    if (zoom_) {
+        // Newest hop through the decimators, then one small complex FFT
+        {
+            ScopedStageTimer timer(profiler, ProfileStage::FFT);
+            zoom_->analyze(fft_input.data());
+        }
+        ScopedStageTimer timer(profiler, ProfileStage::Resample);
+        zoom_->resample(resampled.data());
+        return false;
+    }
+
+    if (multi_resolution_) {
+        // Due bands only, then each band's rows into one column
+        {
+            ScopedStageTimer timer(profiler, ProfileStage::FFT);
+            multi_resolution_->analyze(fft_input.data());
+        }
+        ScopedStageTimer timer(profiler, ProfileStage::Resample);
+        multi_resolution_->stitch(resampled.data());
+        return false;
+    }
+
+    // Small hops: only the displayed bins, incrementally; otherwise dB
+    // conversion only for the bins the resampler reads
+    ScopedStageTimer timer(profiler, ProfileStage::FFT);
+    if (sliding_dft_) {
+        sliding_dft_->process(fft_input.data(), fft_output.data());
+    } else {
+        const FrequencyResampler::BinRange range = resampler_.getInputRange();
+        fft_->process(fft_input.data(), fft_output.data(), range.first, range.end);
+    }
+    return true;
+}
+
+// ============================================================================
+// ProcessingChainCache
+// ============================================================================
+
+ProcessingChainCache::ProcessingChainCache(size_t max_chains)
+    : max_chains_(max_chains)
+{
+    if (max_chains == 0) {
+        throw std::invalid_argument("Chain cache capacity must be > 0");
+    }
+    entries_.reserve(max_chains);
+}
+
+std::shared_ptr<ProcessingChain> ProcessingChainCache::acquire(const ChainKey& key) {
+    for (auto& entry : entries_) {
+        if (entry.key == key) {
+            entry.last_used = ++use_counter_;
+            return entry.chain;
+        }
+    }
+
+    auto chain = build(key);
+    entries_.back().last_used = ++use_counter_;
+    return chain;
+}
+
+bool ProcessingChainCache::prewarm(const ChainKey& key) {
+    if (contains(key)) {
+        return false;
+    }
+
+    try {
+        build(key);
+    } catch (const std::invalid_argument&) {
+        return false; // e.g. range outside Nyquist for this size
+    }
+    return true;
+}
+
+bool ProcessingChainCache::contains(const ChainKey& key) const {
+    return std::any_of(entries_.begin(), entries_.end(),
+                       [&](const Entry& entry) { return entry.key == key; });
+}
+
+void ProcessingChainCache::clear() {
+    entries_.clear();
+}
+
+std::shared_ptr<ProcessingChain> ProcessingChainCache::build(const ChainKey& key) {
+    auto fft = findFFT(key);
+    if (!fft) {
+        fft = std::make_shared<FFTProcessor>(key.fft_size, key.window, key.kaiser_beta);
+    }
+
+    auto chain = std::make_shared<ProcessingChain>(key, std::move(fft));
+
+    if (entries_.size() >= max_chains_) {
+        evictLeastRecentlyUsed();
+    }
+
+    // Prewarmed chains start as least recently used
+    entries_.push_back(Entry{key, chain, 0});
+    return chain;
+}
+
+std::shared_ptr<FFTProcessor> ProcessingChainCache::findFFT(const ChainKey& key) const {
+    for (const auto& entry : entries_) {
+        if (entry.key.fft_size == key.fft_size && entry.key.window == key.window &&
+            entry.key.kaiser_beta == key.kaiser_beta) {
+            return entry.chain->fftShared();
+        }
+    }
+    return nullptr;
+}
+
+void ProcessingChainCache::evictLeastRecentlyUsed() {
+    auto oldest = std::min_element(entries_.begin(), entries_.end(),
+                                   [](const Entry& a, const Entry& b) {
+                                       return a.last_used < b.last_used;
+                                   });
+    if (oldest != entries_.end()) {
+        entries_.erase(oldest);
+    }
+}
+
+} // namespace friture
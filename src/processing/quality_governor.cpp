@@ -0,0 +1,172 @@
+/**
+ * @file quality_governor.cpp
+ * @brief Implementation of QualityGovernor
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/quality_governor.hpp>
+#include <bit>
+#include <stdexcept>
+
+namespace friture {
+
+QualityGovernor::QualityGovernor(const Options& options)
+    : options_(options)
+{
+    if (!(options.frame_budget_us > 0.0) || !(options.analysis_budget > 0.0)) {
+        throw std::invalid_argument("Quality budgets must be > 0");
+    }
+    if (!(options.headroom > 0.0 && options.headroom < 1.0)) {
+        throw std::invalid_argument("Quality headroom must be in (0, 1)");
+    }
+    if (options.raise_after == 0 || options.max_frame_interval == 0) {
+        throw std::invalid_argument("Quality bounds must be > 0");
+    }
+    if (!std::has_single_bit(options.max_height_divisor)) {
+        throw std::invalid_argument("Height divisor bound must be a power of two");
+    }
+}
+
+uint32_t QualityGovernor::renderSteps() const {
+    return (options_.allow_minimal_ui ? 1u : 0u) + options_.max_frame_interval - 1;
+}
+
+uint32_t QualityGovernor::analysisSteps() const {
+    return static_cast<uint32_t>(std::bit_width(options_.max_height_divisor)) - 1;
+}
+
+QualityLevel QualityGovernor::levelFor(uint32_t render_step, uint32_t analysis_step) const {
+    QualityLevel level;
+    uint32_t interval_steps = render_step;
+    if (options_.allow_minimal_ui && render_step > 0) {
+        level.minimal_ui = true;
+        --interval_steps;
+    }
+    level.frame_interval = 1 + interval_steps;
+    level.height_divisor = 1u << analysis_step;
+    return level;
+}
+
+bool QualityGovernor::update(const StageProfileSnapshot& window, double window_seconds) {
+    if (!(window_seconds > 0.0)) {
+        return false;
+    }
+    if (settling_) {
+        // Part of this window ran at the previous level
+        settling_ = false;
+        return false;
+    }
+
+    // Both threads are judged on every window
+    const bool render_changed = judgeRender(window);
+    const bool analysis_changed = judgeAnalysis(window, window_seconds);
+    if (!render_changed && !analysis_changed) {
+        return false;
+    }
+
+    level_ = levelFor(render_step_, analysis_step_);
+    settling_ = true;
+    ++changes_;
+    return true;
+}
+
+bool QualityGovernor::judgeRender(const StageProfileSnapshot& window) {
+    const StageStatsSnapshot& frame = window[ProfileStage::Frame];
+    if (frame.count == 0) {
+        return false;   // Nothing drawn (minimized, or a stall): nothing to judge
+    }
+    const StageStatsSnapshot& present = window[ProfileStage::Present];
+    const uint64_t work_ns = frame.total_ns > present.total_ns ? frame.total_ns - present.total_ns : 0;
+    const double work_us = static_cast<double>(work_ns) / static_cast<double>(frame.count) / 1000.0;
+    render_load_ = work_us / (options_.frame_budget_us * level_.frame_interval);
+
+    if (render_load_ > 1.0) {
+        render_calm_ = 0;
+        if (render_step_ >= renderSteps()) {
+            return false;
+        }
+        if (options_.allow_minimal_ui && render_step_ == 0) {
+            // Remembered so the way back up can account for the text again
+            ui_saving_us_ = window[ProfileStage::UI].meanMicros();
+        }
+        ++render_step_;
+        return true;
+    }
+
+    if (render_step_ == 0) {
+        render_calm_ = 0;
+        return false;
+    }
+    const QualityLevel better = levelFor(render_step_ - 1, analysis_step_);
+    const double better_work_us = work_us + (level_.minimal_ui && !better.minimal_ui ? ui_saving_us_ : 0.0);
+    const double projected = better_work_us / (options_.frame_budget_us * better.frame_interval);
+    if (projected >= options_.headroom) {
+        render_calm_ = 0;
+        return false;
+    }
+    if (++render_calm_ < options_.raise_after) {
+        return false;
+    }
+    render_calm_ = 0;
+    --render_step_;
+    return true;
+}
+
+bool QualityGovernor::judgeAnalysis(const StageProfileSnapshot& window, double window_seconds) {
+    if (window[ProfileStage::Colorize].count == 0) {
+        return false;   // Paused or no input: no columns to judge
+    }
+    uint64_t busy_ns = 0;
+    for (ProfileStage stage : {ProfileStage::Read, ProfileStage::FFT,
+                               ProfileStage::Resample, ProfileStage::Colorize}) {
+        busy_ns += window[stage].total_ns;
+    }
+    const double window_ns = window_seconds * 1e9;
+    analysis_load_ = static_cast<double>(busy_ns) / window_ns / options_.analysis_budget;
+
+    if (analysis_load_ > 1.0) {
+        analysis_calm_ = 0;
+        if (analysis_step_ >= analysisSteps()) {
+            return false;
+        }
+        ++analysis_step_;
+        return true;
+    }
+
+    if (analysis_step_ == 0) {
+        analysis_calm_ = 0;
+        return false;
+    }
+    // Resampling and colorizing scale with the row count (twice as many
+    // rows one step up); reading and the FFT do not
+    const uint64_t per_row_ns = window[ProfileStage::Resample].total_ns +
+                                window[ProfileStage::Colorize].total_ns;
+    const double projected = static_cast<double>(busy_ns + per_row_ns) / window_ns /
+                             options_.analysis_budget;
+    if (projected >= options_.headroom) {
+        analysis_calm_ = 0;
+        return false;
+    }
+    if (++analysis_calm_ < options_.raise_after) {
+        return false;
+    }
+    analysis_calm_ = 0;
+    --analysis_step_;
+    return true;
+}
+
+void QualityGovernor::reset() {
+    level_ = QualityLevel();
+    render_step_ = 0;
+    analysis_step_ = 0;
+    render_calm_ = 0;
+    analysis_calm_ = 0;
+    render_load_ = 0.0;
+    analysis_load_ = 0.0;
+    ui_saving_us_ = 0.0;
+    settling_ = false;
+}
+
+} // namespace friture
@@ -0,0 +1,418 @@
+/**
+ * @file realtime_check.cpp
+ * @brief Implementation of RealtimeCheck and its allocation/lock hooks
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/realtime_check.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef FRITURE_RT_CHECKS
+
+// Sanitizers bring their own malloc and mutex interceptors
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define FRITURE_RT_SANITIZED 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || \
+    __has_feature(memory_sanitizer)
+#define FRITURE_RT_SANITIZED 1
+#endif
+#endif
+
+// glibc: malloc and friends forward to its __libc_* entry points, which
+// also catches allocations from C code (FFTW, the C library). Elsewhere
+// only operator new/delete are replaced.
+#if defined(__GLIBC__) && !defined(FRITURE_RT_SANITIZED)
+#define FRITURE_RT_HOOK_MALLOC 1
+#else
+#define FRITURE_RT_HOOK_NEW 1
+#endif
+
+#if defined(__linux__) && !defined(__SANITIZE_THREAD__)
+#define FRITURE_RT_HOOK_LOCKS 1
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+
+#endif // FRITURE_RT_CHECKS
+
+namespace friture {
+
+const char* toString(RealtimeViolation kind) {
+    switch (kind) {
+        case RealtimeViolation::Allocation:   return "allocation";
+        case RealtimeViolation::Deallocation: return "deallocation";
+        case RealtimeViolation::Lock:         return "lock";
+    }
+    return "unknown";
+}
+
+namespace {
+
+// Fixed storage only: recording runs inside malloc and mutex hooks
+std::atomic<uint64_t> g_counts[REALTIME_VIOLATION_KINDS] = {};
+std::atomic<size_t> g_claimed{0};
+std::atomic<const char*> g_record_scopes[RealtimeCheck::MAX_RECORDS] = {};
+std::atomic<uint8_t> g_record_kinds[RealtimeCheck::MAX_RECORDS] = {};
+std::atomic<bool> g_abort{false};
+
+[[maybe_unused]] const bool g_abort_from_environment = [] {
+    const char* value = std::getenv("FRITURE_RT_ABORT");
+    if (value && *value && *value != '0') {
+        g_abort.store(true, std::memory_order_relaxed);
+    }
+    return true;
+}();
+
+} // namespace
+
+// ============================================================================
+// Counters
+// ============================================================================
+
+uint64_t RealtimeCheck::getViolationCount() {
+    uint64_t total = 0;
+    for (const auto& count : g_counts) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t RealtimeCheck::getViolationCount(RealtimeViolation kind) {
+    return g_counts[static_cast<size_t>(kind)].load(std::memory_order_relaxed);
+}
+
+std::vector<RealtimeViolationRecord> RealtimeCheck::getRecords() {
+    std::vector<RealtimeViolationRecord> records;
+    const size_t claimed = std::min(g_claimed.load(std::memory_order_acquire), MAX_RECORDS);
+    for (size_t i = 0; i < claimed; ++i) {
+        // A claimed slot is published by its scope pointer
+        const char* scope = g_record_scopes[i].load(std::memory_order_acquire);
+        if (scope) {
+            records.push_back({static_cast<RealtimeViolation>(
+                                   g_record_kinds[i].load(std::memory_order_relaxed)), scope});
+        }
+    }
+    return records;
+}
+
+void RealtimeCheck::reset() {
+    for (auto& count : g_counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    for (auto& scope : g_record_scopes) {
+        scope.store(nullptr, std::memory_order_relaxed);
+    }
+    g_claimed.store(0, std::memory_order_release);
+}
+
+void RealtimeCheck::setAbortOnViolation(bool abort) {
+    g_abort.store(abort, std::memory_order_relaxed);
+}
+
+bool RealtimeCheck::getAbortOnViolation() {
+    return g_abort.load(std::memory_order_relaxed);
+}
+
+void RealtimeCheck::report(std::ostream& out) {
+    const uint64_t total = getViolationCount();
+    if (total == 0) {
+        out << "Real-time violations: none" << std::endl;
+        return;
+    }
+
+    out << "Real-time violations: " << total << " (";
+    for (size_t k = 0; k < REALTIME_VIOLATION_KINDS; ++k) {
+        const auto kind = static_cast<RealtimeViolation>(k);
+        out << (k > 0 ? ", " : "") << toString(kind) << " " << getViolationCount(kind);
+    }
+    out << ")" << std::endl;
+
+    const std::vector<RealtimeViolationRecord> records = getRecords();
+    for (const RealtimeViolationRecord& record : records) {
+        out << "  " << toString(record.kind) << " in " << record.scope << std::endl;
+    }
+    if (total > records.size()) {
+        out << "  (" << total - records.size() << " more)" << std::endl;
+    }
+}
+
+#ifdef FRITURE_RT_CHECKS
+
+// ============================================================================
+// Scopes
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Per-thread checker state (constant-initialized: safe to touch
+ *        from malloc before anything else on the thread ran)
+ */
+struct ThreadState {
+    const char* scope;
+    uint32_t depth;
+    uint32_t exempt;
+    bool recording;
+};
+
+thread_local ThreadState t_state = {};
+
+void record(RealtimeViolation kind, const char* scope) noexcept {
+    g_counts[static_cast<size_t>(kind)].fetch_add(1, std::memory_order_relaxed);
+
+    const size_t slot = g_claimed.fetch_add(1, std::memory_order_acq_rel);
+    if (slot < RealtimeCheck::MAX_RECORDS) {
+        g_record_kinds[slot].store(static_cast<uint8_t>(kind), std::memory_order_relaxed);
+        g_record_scopes[slot].store(scope, std::memory_order_release);
+    }
+
+    if (g_abort.load(std::memory_order_relaxed)) {
+        std::fprintf(stderr, "Real-time violation: %s in %s\n", toString(kind), scope);
+        std::fflush(stderr);
+        std::abort();
+    }
+}
+
+/**
+ * @brief Record a violation if this thread is in a scope (and not already
+ *        recording one: the abort message may allocate)
+ */
+[[maybe_unused]] inline void check(RealtimeViolation kind) noexcept {
+    ThreadState& state = t_state;
+    if (state.depth == 0 || state.exempt > 0 || state.recording) {
+        return;
+    }
+    state.recording = true;
+    record(kind, state.scope);
+    state.recording = false;
+}
+
+} // namespace
+
+RealtimeScope::RealtimeScope(const char* name) noexcept
+    : outer_(t_state.scope)
+{
+    t_state.scope = name;
+    ++t_state.depth;
+}
+
+RealtimeScope::~RealtimeScope() {
+    --t_state.depth;
+    t_state.scope = outer_;
+}
+
+RealtimeExemption::RealtimeExemption() noexcept {
+    ++t_state.exempt;
+}
+
+RealtimeExemption::~RealtimeExemption() {
+    --t_state.exempt;
+}
+
+#endif // FRITURE_RT_CHECKS
+
+} // namespace friture
+
+// ============================================================================
+// Hooks
+// ============================================================================
+
+#ifdef FRITURE_RT_HOOK_MALLOC
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) noexcept {
+    friture::check(friture::RealtimeViolation::Allocation);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    friture::check(friture::RealtimeViolation::Allocation);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    friture::check(friture::RealtimeViolation::Allocation);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) noexcept {
+    if (ptr) {
+        friture::check(friture::RealtimeViolation::Deallocation);
+    }
+    __libc_free(ptr);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+    friture::check(friture::RealtimeViolation::Allocation);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    friture::check(friture::RealtimeViolation::Allocation);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size) noexcept {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    friture::check(friture::RealtimeViolation::Allocation);
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *result = ptr;
+    return 0;
+}
+
+} // extern "C"
+
+#endif // FRITURE_RT_HOOK_MALLOC
+
+#ifdef FRITURE_RT_HOOK_NEW
+
+namespace {
+
+void* allocate(std::size_t size) {
+    friture::check(friture::RealtimeViolation::Allocation);
+    while (true) {
+        if (void* ptr = std::malloc(size > 0 ? size : 1)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr) {
+        friture::check(friture::RealtimeViolation::Deallocation);
+    }
+    std::free(ptr);
+}
+
+} // namespace
+
+// Every form is replaced: with a sanitizer, the runtime's own forms would
+// not forward to the replaced ones
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return allocate(size); } catch (...) { return nullptr; }
+}
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+
+#if !defined(_WIN32)
+namespace {
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    friture::check(friture::RealtimeViolation::Allocation);
+    const std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, align, size > 0 ? size : 1) != 0) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+} // namespace
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return allocateAligned(size, alignment); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return allocateAligned(size, alignment); } catch (...) { return nullptr; }
+}
+void operator delete(void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
+#endif
+
+#endif // FRITURE_RT_HOOK_NEW
+
+#ifdef FRITURE_RT_HOOK_LOCKS
+
+namespace {
+
+using MutexLock = int (*)(pthread_mutex_t*);
+using RwLock = int (*)(pthread_rwlock_t*);
+
+// Resolved on first use without a function-local static: its guard could
+// itself take a lock
+template<typename Function>
+Function next(std::atomic<Function>& slot, const char* name) {
+    Function function = slot.load(std::memory_order_acquire);
+    if (!function) {
+        function = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+        slot.store(function, std::memory_order_release);
+    }
+    return function;
+}
+
+std::atomic<MutexLock> g_mutex_lock{nullptr};
+std::atomic<RwLock> g_rwlock_rdlock{nullptr};
+std::atomic<RwLock> g_rwlock_wrlock{nullptr};
+
+// Resolved at startup, so a first lock inside a scope does not count
+// what dlsym does
+[[maybe_unused]] const bool g_locks_resolved =
+    next(g_mutex_lock, "pthread_mutex_lock") && next(g_rwlock_rdlock, "pthread_rwlock_rdlock") &&
+    next(g_rwlock_wrlock, "pthread_rwlock_wrlock");
+
+} // namespace
+
+extern "C" {
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept {
+    friture::check(friture::RealtimeViolation::Lock);
+    return next(g_mutex_lock, "pthread_mutex_lock")(mutex);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept {
+    friture::check(friture::RealtimeViolation::Lock);
+    return next(g_rwlock_rdlock, "pthread_rwlock_rdlock")(lock);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept {
+    friture::check(friture::RealtimeViolation::Lock);
+    return next(g_rwlock_wrlock, "pthread_rwlock_wrlock")(lock);
+}
+
+} // extern "C"
+
+#endif // FRITURE_RT_HOOK_LOCKS
@@ -0,0 +1,233 @@
+/**
+ * @file sample_rate_converter.cpp
+ * @brief Implementation of SampleRateConverter
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/sample_rate_converter.hpp>
+#include <friture/simd_kernels.hpp>
+#include <friture/window_functions.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+namespace friture {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// Prototype at the upsampled rate (L × input), split into phases:
+// bank[φ][taps - 1 - k] = h[φ + k·L], each phase summing to 1
+std::vector<float> designBank(size_t up, size_t down, size_t taps) {
+    const size_t length = up * taps;
+    const double center = static_cast<double>(length) / 2.0;
+    const double cutoff = SampleRateConverter::ROLLOFF * 0.5 / static_cast<double>(std::max(up, down));
+    const double beta = SampleRateConverter::KAISER_BETA;
+    const double norm = besselI0(beta);
+
+    std::vector<double> h(length);
+    for (size_t j = 0; j < length; ++j) {
+        const double x = static_cast<double>(j) - center;
+        const double arg = 2.0 * cutoff * x;
+        const double sinc = (x == 0.0) ? 1.0 : std::sin(PI * arg) / (PI * arg);
+        const double t = x / center;
+        const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - t * t))) / norm;
+        h[j] = sinc * window;
+    }
+
+    std::vector<float> bank(length);
+    for (size_t phase = 0; phase < up; ++phase) {
+        double sum = 0.0;
+        for (size_t k = 0; k < taps; ++k) {
+            sum += h[phase + k * up];
+        }
+        for (size_t k = 0; k < taps; ++k) {
+            bank[phase * taps + (taps - 1 - k)] = static_cast<float>(h[phase + k * up] / sum);
+        }
+    }
+    return bank;
+}
+
+// Banks are kept for the life of the process: a handful of ratios at most
+std::shared_ptr<const std::vector<float>> sharedBank(size_t up, size_t down, size_t taps) {
+    static std::mutex mutex;
+    static std::map<std::tuple<size_t, size_t, size_t>, std::shared_ptr<const std::vector<float>>> banks;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& bank = banks[std::make_tuple(up, down, taps)];
+    if (!bank) {
+        bank = std::make_shared<const std::vector<float>>(designBank(up, down, taps));
+    }
+    return bank;
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+SampleRateConverter::SampleRateConverter(uint32_t input_rate, uint32_t output_rate, size_t taps)
+    : input_rate_(input_rate),
+      output_rate_(output_rate),
+      up_(1),
+      down_(1),
+      taps_(taps)
+{
+    if (input_rate_ == 0 || output_rate_ == 0) {
+        throw std::invalid_argument("Sample rates must be > 0");
+    }
+    if (taps_ < 8 || taps_ % 8 != 0) {
+        throw std::invalid_argument("Taps must be a multiple of 8");
+    }
+
+    const uint32_t g = std::gcd(input_rate_, output_rate_);
+    up_ = output_rate_ / g;
+    down_ = input_rate_ / g;
+    if (up_ > MAX_PHASES) {
+        throw std::invalid_argument("Sample rate ratio needs too many filter phases");
+    }
+
+    if (isPassthrough()) {
+        taps_ = 0;
+        bank_ = std::make_shared<const std::vector<float>>();
+    } else {
+        // Decimation narrows the passband by M/L in input samples
+        if (down_ > up_) {
+            taps_ = (taps_ * down_ + up_ - 1) / up_;
+            taps_ = (taps_ + 7) / 8 * 8;
+        }
+        if (taps_ > MAX_TAPS) {
+            throw std::invalid_argument("Decimation factor too large for the filter length");
+        }
+        bank_ = sharedBank(up_, down_, taps_);
+    }
+
+    reserve(DEFAULT_MAX_BLOCK);
+}
+
+// ============================================================================
+// Position-Addressed Conversion
+// ============================================================================
+
+uint64_t SampleRateConverter::getOutputLength(uint64_t input_length) const {
+    return (input_length * up_ + down_ - 1) / down_;
+}
+
+int64_t SampleRateConverter::getFirstInput(uint64_t output) const {
+    if (isPassthrough()) {
+        return static_cast<int64_t>(output);
+    }
+    const int64_t center = static_cast<int64_t>(output * down_ / up_);
+    return center - static_cast<int64_t>(taps_ / 2) + 1;
+}
+
+size_t SampleRateConverter::getInputSpan(size_t count) const {
+    if (count == 0 || isPassthrough()) {
+        return count;
+    }
+    return ((count - 1) * down_ + up_ - 1) / up_ + taps_;
+}
+
+void SampleRateConverter::convert(const float* input, int64_t input_first,
+                                  uint64_t first_output, size_t count, float* output) const {
+    if (isPassthrough()) {
+        std::memcpy(output, input + (static_cast<int64_t>(first_output) - input_first),
+                    count * sizeof(float));
+        return;
+    }
+
+    const float* bank = bank_->data();
+    const int64_t half = static_cast<int64_t>(taps_ / 2);
+
+    // n·M = q·L + φ, stepped instead of divided
+    uint64_t time = first_output * down_;
+    int64_t q = static_cast<int64_t>(time / up_);
+    size_t phase = static_cast<size_t>(time % up_);
+    const int64_t q_step = static_cast<int64_t>(down_ / up_);
+    const size_t phase_step = down_ % up_;
+
+    for (size_t i = 0; i < count; ++i) {
+        const float* x = input + (q - half + 1 - input_first);
+        output[i] = simd::dotProduct(x, bank + phase * taps_, taps_);
+
+        q += q_step;
+        phase += phase_step;
+        if (phase >= up_) {
+            phase -= up_;
+            ++q;
+        }
+    }
+}
+
+// ============================================================================
+// Streaming Conversion
+// ============================================================================
+
+void SampleRateConverter::reserve(size_t max_block) {
+    history_.assign(taps_ + std::max<size_t>(1, max_block), 0.0f);
+    reset();
+}
+
+size_t SampleRateConverter::getMaxOutput(size_t input_count) const {
+    if (isPassthrough()) {
+        return input_count;
+    }
+    return (input_count * up_ + down_ - 1) / down_ + 1;
+}
+
+void SampleRateConverter::reset() {
+    // Silence before input 0 stands in for the first outputs' left taps
+    next_output_ = 0;
+    history_first_ = getFirstInput(0);
+    history_size_ = static_cast<size_t>(-history_first_);
+    std::fill(history_.begin(), history_.begin() + history_size_, 0.0f);
+}
+
+size_t SampleRateConverter::process(const float* input, size_t count, float* output) {
+    if (isPassthrough()) {
+        std::memcpy(output, input, count * sizeof(float));
+        return count;
+    }
+
+    const int64_t half = static_cast<int64_t>(taps_ / 2);
+    size_t produced = 0;
+    while (count > 0) {
+        const size_t take = std::min(count, history_.size() - history_size_);
+        std::memcpy(history_.data() + history_size_, input, take * sizeof(float));
+        history_size_ += take;
+        input += take;
+        count -= take;
+
+        // Output n is ready once floor(n·M / L) + taps/2 is buffered
+        const int64_t last_center = history_first_ + static_cast<int64_t>(history_size_) - 1 - half;
+        if (last_center >= 0) {
+            const uint64_t end_output = ((static_cast<uint64_t>(last_center) + 1) * up_ - 1) / down_ + 1;
+            if (end_output > next_output_) {
+                const size_t ready = static_cast<size_t>(end_output - next_output_);
+                convert(history_.data(), history_first_, next_output_, ready, output + produced);
+                produced += ready;
+                next_output_ = end_output;
+            }
+        }
+
+        // Keep only what the next output still reads (at most taps - 1)
+        const size_t drop = static_cast<size_t>(
+            std::min<int64_t>(getFirstInput(next_output_) - history_first_,
+                              static_cast<int64_t>(history_size_)));
+        std::memmove(history_.data(), history_.data() + drop, (history_size_ - drop) * sizeof(float));
+        history_size_ -= drop;
+        history_first_ += static_cast<int64_t>(drop);
+    }
+    return produced;
+}
+
+} // namespace friture
@@ -0,0 +1,817 @@
+/**
+ * @file simd_kernels.cpp
+ * @brief Implementation of SIMD kernels with runtime dispatch
+ *
+ * AVX2 code is compiled with function-level target attributes so the rest
+ * of the library keeps the baseline instruction set; it is used only when
+ * the CPU reports AVX2 and FMA. NEON is part of the AArch64 baseline and is
+ * selected at compile time.
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#include <friture/simd_kernels.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #define FRITURE_SIMD_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define FRITURE_TARGET_AVX2
+    #else
+        #define FRITURE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define FRITURE_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace friture {
+namespace simd {
+
+namespace {
+
+// log10(2) and log10(e), split constants for the log approximation
+constexpr float LOG10_2 = 0.30102999566f;
+constexpr float LOG10_E = 0.43429448190f;
+constexpr float SQRT2 = 1.41421356237f;
+
+// dB → log2 of power, exponent clamp and 2^f Taylor coefficients (ln2^k / k!)
+constexpr float DB_TO_LOG2 = 0.33219280949f;
+constexpr float EXP2_MIN = -126.0f;
+constexpr float EXP2_MAX = 127.0f;
+constexpr float EXP2_C1 = 0.69314718056f;
+constexpr float EXP2_C2 = 0.24022650695f;
+constexpr float EXP2_C3 = 0.05550410866f;
+constexpr float EXP2_C4 = 0.00961812911f;
+constexpr float EXP2_C5 = 0.00133335581f;
+constexpr float EXP2_C6 = 0.00015403530f;
+
+// ============================================================================
+// Scalar Kernels
+// ============================================================================
+
+void applyWindowScalar(const float* input, const float* window, float* output, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        output[i] = input[i] * window[i];
+    }
+}
+
+void powerToDbScalar(const float* spectrum, float* output, size_t n,
+                     float scale, float epsilon, bool exact) {
+    for (size_t i = 0; i < n; ++i) {
+        float real = spectrum[2 * i];
+        float imag = spectrum[2 * i + 1];
+        float power = (real * real + imag * imag) * scale + epsilon;
+        output[i] = 10.0f * (exact ? std::log10(power) : fastLog10(power));
+    }
+}
+
+void dbToPowerScalar(const float* db, float* output, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        output[i] = fastDbToPower(db[i]);
+    }
+}
+
+void dbToPaletteScalar(const float* db, size_t n, float min_db, float scale,
+                       const uint32_t* palette, uint32_t* output) {
+    for (size_t i = 0; i < n; ++i) {
+        float x = (db[i] - min_db) * scale;
+        x = x > 0.0f ? x : 0.0f;  // also maps NaN to 0
+        x = x < 255.0f ? x : 255.0f;
+        output[i] = palette[static_cast<uint32_t>(x)];
+    }
+}
+
+float dotProductScalar(const float* a, const float* b, size_t n) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+float trackFloorScalar(const float* db, float* floor, float* excess, size_t n,
+                       float rise, float fall) {
+    float max_excess = std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < n; ++i) {
+        const float d = db[i] - floor[i];
+        excess[i] = d;
+        floor[i] = floor[i] + (d > 0.0f ? rise : fall) * d;
+        max_excess = std::max(max_excess, d);
+    }
+    return max_excess;
+}
+
+void averagePowerScalar(const float* power, float* average, size_t n, float weight) {
+    for (size_t i = 0; i < n; ++i) {
+        average[i] = average[i] + weight * (power[i] - average[i]);
+    }
+}
+
+void holdPowerScalar(const float* power, float* held, size_t n, float decay) {
+    for (size_t i = 0; i < n; ++i) {
+        held[i] = std::max(power[i], held[i] * decay);
+    }
+}
+
+void slidePowerScalar(const float* power, float* oldest, double* sum, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        sum[i] += static_cast<double>(power[i]) - static_cast<double>(oldest[i]);
+        oldest[i] = power[i];
+    }
+}
+
+void linearToDbScalar(const float* power, float* output, size_t n, float scale, float floor) {
+    for (size_t i = 0; i < n; ++i) {
+        output[i] = 10.0f * fastLog10(std::max(power[i] * scale, floor));
+    }
+}
+
+// ============================================================================
+// AVX2 Kernels
+// ============================================================================
+
+#if defined(FRITURE_SIMD_X86)
+
+FRITURE_TARGET_AVX2
+inline __m256 fastLog10Avx2(__m256 x) {
+    const __m256i bits = _mm256_castps_si256(x);
+
+    // x = 2^e × m, m in [1, 2)
+    __m256i exponent = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+    __m256 mantissa = _mm256_castsi256_ps(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+
+    // Fold m into [√½, √2) so the series argument stays small
+    __m256 big = _mm256_cmp_ps(mantissa, _mm256_set1_ps(SQRT2), _CMP_GT_OQ);
+    mantissa = _mm256_blendv_ps(mantissa, _mm256_mul_ps(mantissa, _mm256_set1_ps(0.5f)), big);
+    __m256 e = _mm256_add_ps(_mm256_cvtepi32_ps(exponent),
+                             _mm256_and_ps(big, _mm256_set1_ps(1.0f)));
+
+    // ln(m) = 2 × atanh(t), t = (m - 1) / (m + 1)
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 t = _mm256_div_ps(_mm256_sub_ps(mantissa, one), _mm256_add_ps(mantissa, one));
+    __m256 t2 = _mm256_mul_ps(t, t);
+    __m256 p = _mm256_set1_ps(2.0f / 9.0f);
+    p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(2.0f / 7.0f));
+    p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(2.0f / 5.0f));
+    p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(2.0f / 3.0f));
+    p = _mm256_fmadd_ps(p, t2, _mm256_set1_ps(2.0f));
+    __m256 ln_m = _mm256_mul_ps(p, t);
+
+    return _mm256_fmadd_ps(e, _mm256_set1_ps(LOG10_2), _mm256_mul_ps(ln_m, _mm256_set1_ps(LOG10_E)));
+}
+
+FRITURE_TARGET_AVX2
+void applyWindowAvx2(const float* input, const float* window, float* output, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_loadu_ps(input + i);
+        __m256 w = _mm256_loadu_ps(window + i);
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(x, w));
+    }
+    applyWindowScalar(input + i, window + i, output + i, n - i);
+}
+
+FRITURE_TARGET_AVX2
+void powerToDbAvx2(const float* spectrum, float* output, size_t n,
+                   float scale, float epsilon, bool exact) {
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 veps = _mm256_set1_ps(epsilon);
+    const __m256 ten = _mm256_set1_ps(10.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // 8 complex bins = 16 floats
+        __m256 a = _mm256_loadu_ps(spectrum + 2 * i);
+        __m256 b = _mm256_loadu_ps(spectrum + 2 * i + 8);
+        a = _mm256_mul_ps(a, a);
+        b = _mm256_mul_ps(b, b);
+
+        // hadd yields [a01 a23 b01 b23 | a45 a67 b45 b67]; restore bin order
+        __m256 sum = _mm256_hadd_ps(a, b);
+        sum = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sum), 0xD8));
+
+        __m256 power = _mm256_fmadd_ps(sum, vscale, veps);
+
+        if (exact) {
+            alignas(32) float tmp[8];
+            _mm256_store_ps(tmp, power);
+            for (int k = 0; k < 8; ++k) {
+                output[i + k] = 10.0f * std::log10(tmp[k]);
+            }
+        } else {
+            _mm256_storeu_ps(output + i, _mm256_mul_ps(ten, fastLog10Avx2(power)));
+        }
+    }
+    powerToDbScalar(spectrum + 2 * i, output + i, n - i, scale, epsilon, exact);
+}
+
+FRITURE_TARGET_AVX2
+void dbToPowerAvx2(const float* db, float* output, size_t n) {
+    const __m256 scale = _mm256_set1_ps(DB_TO_LOG2);
+    const __m256 lo = _mm256_set1_ps(EXP2_MIN);
+    const __m256 hi = _mm256_set1_ps(EXP2_MAX);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 y = _mm256_mul_ps(_mm256_loadu_ps(db + i), scale);
+        y = _mm256_min_ps(_mm256_max_ps(y, lo), hi);
+
+        // y = e + f, e integer, f in [-½, ½]
+        __m256 e = _mm256_round_ps(y, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m256 f = _mm256_sub_ps(y, e);
+
+        __m256 p = _mm256_set1_ps(EXP2_C6);
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C5));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C4));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C3));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C2));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(EXP2_C1));
+        p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(1.0f));
+
+        // 2^e straight into the exponent field
+        __m256i bits = _mm256_slli_epi32(
+            _mm256_add_epi32(_mm256_cvtps_epi32(e), _mm256_set1_epi32(127)), 23);
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(p, _mm256_castsi256_ps(bits)));
+    }
+    dbToPowerScalar(db + i, output + i, n - i);
+}
+
+FRITURE_TARGET_AVX2
+void dbToPaletteAvx2(const float* db, size_t n, float min_db, float scale,
+                     const uint32_t* palette, uint32_t* output) {
+    const __m256 vmin = _mm256_set1_ps(min_db);
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 top = _mm256_set1_ps(255.0f);
+    const int* lut = reinterpret_cast<const int*>(palette);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(db + i), vmin), vscale);
+        // max(x, 0) returns 0 for NaN x (second operand wins)
+        x = _mm256_min_ps(_mm256_max_ps(x, zero), top);
+        __m256i idx = _mm256_cvttps_epi32(x);
+        __m256i colors = _mm256_i32gather_epi32(lut, idx, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), colors);
+    }
+    dbToPaletteScalar(db + i, n - i, min_db, scale, palette, output + i);
+}
+
+FRITURE_TARGET_AVX2
+float dotProductAvx2(const float* a, const float* b, size_t n) {
+    // Two accumulators hide the FMA latency
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum) + dotProductScalar(a + i, b + i, n - i);
+}
+
+FRITURE_TARGET_AVX2
+float trackFloorAvx2(const float* db, float* floor, float* excess, size_t n,
+                     float rise, float fall) {
+    // Multiply and add kept separate (no FMA) so every ISA gives the same floor
+    const __m256 vrise = _mm256_set1_ps(rise);
+    const __m256 vfall = _mm256_set1_ps(fall);
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 vmax = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 f = _mm256_loadu_ps(floor + i);
+        const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(db + i), f);
+        const __m256 a = _mm256_blendv_ps(vfall, vrise, _mm256_cmp_ps(d, zero, _CMP_GT_OQ));
+        _mm256_storeu_ps(excess + i, d);
+        _mm256_storeu_ps(floor + i, _mm256_add_ps(f, _mm256_mul_ps(a, d)));
+        vmax = _mm256_max_ps(vmax, d);
+    }
+    __m128 m = _mm_max_ps(_mm256_castps256_ps128(vmax), _mm256_extractf128_ps(vmax, 1));
+    m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+    m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+    return std::max(_mm_cvtss_f32(m),
+                    trackFloorScalar(db + i, floor + i, excess + i, n - i, rise, fall));
+}
+
+FRITURE_TARGET_AVX2
+void averagePowerAvx2(const float* power, float* average, size_t n, float weight) {
+    const __m256 w = _mm256_set1_ps(weight);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 a = _mm256_loadu_ps(average + i);
+        const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(power + i), a);
+        _mm256_storeu_ps(average + i, _mm256_add_ps(a, _mm256_mul_ps(w, d)));
+    }
+    averagePowerScalar(power + i, average + i, n - i, weight);
+}
+
+FRITURE_TARGET_AVX2
+void holdPowerAvx2(const float* power, float* held, size_t n, float decay) {
+    const __m256 k = _mm256_set1_ps(decay);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 h = _mm256_mul_ps(_mm256_loadu_ps(held + i), k);
+        _mm256_storeu_ps(held + i, _mm256_max_ps(_mm256_loadu_ps(power + i), h));
+    }
+    holdPowerScalar(power + i, held + i, n - i, decay);
+}
+
+FRITURE_TARGET_AVX2
+void slidePowerAvx2(const float* power, float* oldest, double* sum, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 p = _mm_loadu_ps(power + i);
+        const __m256d d = _mm256_sub_pd(_mm256_cvtps_pd(p), _mm256_cvtps_pd(_mm_loadu_ps(oldest + i)));
+        _mm256_storeu_pd(sum + i, _mm256_add_pd(_mm256_loadu_pd(sum + i), d));
+        _mm_storeu_ps(oldest + i, p);
+    }
+    slidePowerScalar(power + i, oldest + i, sum + i, n - i);
+}
+
+FRITURE_TARGET_AVX2
+void linearToDbAvx2(const float* power, float* output, size_t n, float scale, float floor) {
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 vfloor = _mm256_set1_ps(floor);
+    const __m256 ten = _mm256_set1_ps(10.0f);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 p = _mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(power + i), vscale), vfloor);
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(ten, fastLog10Avx2(p)));
+    }
+    linearToDbScalar(power + i, output + i, n - i, scale, floor);
+}
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    return fma && osxsave && avx2 && ((_xgetbv(0) & 0x6) == 0x6);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+#endif // FRITURE_SIMD_X86
+
+// ============================================================================
+// NEON Kernels
+// ============================================================================
+
+#if defined(FRITURE_SIMD_NEON)
+
+inline float32x4_t fastLog10Neon(float32x4_t x) {
+    const int32x4_t bits = vreinterpretq_s32_f32(x);
+
+    // x = 2^e × m, m in [1, 2)
+    int32x4_t exponent = vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(127));
+    float32x4_t mantissa = vreinterpretq_f32_s32(vorrq_s32(
+        vandq_s32(bits, vdupq_n_s32(0x007FFFFF)), vdupq_n_s32(0x3F800000)));
+
+    // Fold m into [√½, √2) so the series argument stays small
+    uint32x4_t big = vcgtq_f32(mantissa, vdupq_n_f32(SQRT2));
+    mantissa = vbslq_f32(big, vmulq_n_f32(mantissa, 0.5f), mantissa);
+    float32x4_t e = vaddq_f32(vcvtq_f32_s32(exponent),
+                              vreinterpretq_f32_u32(vandq_u32(big, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+
+    // ln(m) = 2 × atanh(t), t = (m - 1) / (m + 1)
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t t = vdivq_f32(vsubq_f32(mantissa, one), vaddq_f32(mantissa, one));
+    float32x4_t t2 = vmulq_f32(t, t);
+    float32x4_t p = vdupq_n_f32(2.0f / 9.0f);
+    p = vfmaq_f32(vdupq_n_f32(2.0f / 7.0f), p, t2);
+    p = vfmaq_f32(vdupq_n_f32(2.0f / 5.0f), p, t2);
+    p = vfmaq_f32(vdupq_n_f32(2.0f / 3.0f), p, t2);
+    p = vfmaq_f32(vdupq_n_f32(2.0f), p, t2);
+    float32x4_t ln_m = vmulq_f32(p, t);
+
+    return vfmaq_f32(vmulq_n_f32(ln_m, LOG10_E), e, vdupq_n_f32(LOG10_2));
+}
+
+void applyWindowNeon(const float* input, const float* window, float* output, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(output + i, vmulq_f32(vld1q_f32(input + i), vld1q_f32(window + i)));
+    }
+    applyWindowScalar(input + i, window + i, output + i, n - i);
+}
+
+void powerToDbNeon(const float* spectrum, float* output, size_t n,
+                   float scale, float epsilon, bool exact) {
+    const float32x4_t veps = vdupq_n_f32(epsilon);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // De-interleave 4 complex bins into re and im vectors
+        float32x4x2_t bins = vld2q_f32(spectrum + 2 * i);
+        float32x4_t sum = vfmaq_f32(vmulq_f32(bins.val[0], bins.val[0]), bins.val[1], bins.val[1]);
+        float32x4_t power = vfmaq_f32(veps, sum, vdupq_n_f32(scale));
+
+        if (exact) {
+            float tmp[4];
+            vst1q_f32(tmp, power);
+            for (int k = 0; k < 4; ++k) {
+                output[i + k] = 10.0f * std::log10(tmp[k]);
+            }
+        } else {
+            vst1q_f32(output + i, vmulq_n_f32(fastLog10Neon(power), 10.0f));
+        }
+    }
+    powerToDbScalar(spectrum + 2 * i, output + i, n - i, scale, epsilon, exact);
+}
+
+void dbToPowerNeon(const float* db, float* output, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t y = vmulq_n_f32(vld1q_f32(db + i), DB_TO_LOG2);
+        y = vminq_f32(vmaxq_f32(y, vdupq_n_f32(EXP2_MIN)), vdupq_n_f32(EXP2_MAX));
+
+        // y = e + f, e integer, f in [-½, ½]
+        float32x4_t e = vrndnq_f32(y);
+        float32x4_t f = vsubq_f32(y, e);
+
+        float32x4_t p = vdupq_n_f32(EXP2_C6);
+        p = vfmaq_f32(vdupq_n_f32(EXP2_C5), p, f);
+        p = vfmaq_f32(vdupq_n_f32(EXP2_C4), p, f);
+        p = vfmaq_f32(vdupq_n_f32(EXP2_C3), p, f);
+        p = vfmaq_f32(vdupq_n_f32(EXP2_C2), p, f);
+        p = vfmaq_f32(vdupq_n_f32(EXP2_C1), p, f);
+        p = vfmaq_f32(vdupq_n_f32(1.0f), p, f);
+
+        // 2^e straight into the exponent field
+        int32x4_t bits = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(e), vdupq_n_s32(127)), 23);
+        vst1q_f32(output + i, vmulq_f32(p, vreinterpretq_f32_s32(bits)));
+    }
+    dbToPowerScalar(db + i, output + i, n - i);
+}
+
+void dbToPaletteNeon(const float* db, size_t n, float min_db, float scale,
+                     const uint32_t* palette, uint32_t* output) {
+    const float32x4_t vmin = vdupq_n_f32(min_db);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t x = vmulq_n_f32(vsubq_f32(vld1q_f32(db + i), vmin), scale);
+        // vmaxnm returns the number when one operand is NaN
+        x = vminq_f32(vmaxnmq_f32(x, vdupq_n_f32(0.0f)), vdupq_n_f32(255.0f));
+        uint32x4_t idx = vcvtq_u32_f32(x);
+
+        // No gather on NEON: indices are vectorized, lookups per lane
+        output[i] = palette[vgetq_lane_u32(idx, 0)];
+        output[i + 1] = palette[vgetq_lane_u32(idx, 1)];
+        output[i + 2] = palette[vgetq_lane_u32(idx, 2)];
+        output[i + 3] = palette[vgetq_lane_u32(idx, 3)];
+    }
+    dbToPaletteScalar(db + i, n - i, min_db, scale, palette, output + i);
+}
+
+float dotProductNeon(const float* a, const float* b, size_t n) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    return vaddvq_f32(vaddq_f32(acc0, acc1)) + dotProductScalar(a + i, b + i, n - i);
+}
+
+float trackFloorNeon(const float* db, float* floor, float* excess, size_t n,
+                     float rise, float fall) {
+    const float32x4_t vrise = vdupq_n_f32(rise);
+    const float32x4_t vfall = vdupq_n_f32(fall);
+    float32x4_t vmax = vdupq_n_f32(std::numeric_limits<float>::lowest());
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t f = vld1q_f32(floor + i);
+        const float32x4_t d = vsubq_f32(vld1q_f32(db + i), f);
+        const float32x4_t a = vbslq_f32(vcgtq_f32(d, vdupq_n_f32(0.0f)), vrise, vfall);
+        vst1q_f32(excess + i, d);
+        vst1q_f32(floor + i, vaddq_f32(f, vmulq_f32(a, d)));
+        vmax = vmaxq_f32(vmax, d);
+    }
+    return std::max(vmaxvq_f32(vmax),
+                    trackFloorScalar(db + i, floor + i, excess + i, n - i, rise, fall));
+}
+
+void averagePowerNeon(const float* power, float* average, size_t n, float weight) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t a = vld1q_f32(average + i);
+        const float32x4_t d = vsubq_f32(vld1q_f32(power + i), a);
+        vst1q_f32(average + i, vaddq_f32(a, vmulq_n_f32(d, weight)));
+    }
+    averagePowerScalar(power + i, average + i, n - i, weight);
+}
+
+void holdPowerNeon(const float* power, float* held, size_t n, float decay) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t h = vmulq_n_f32(vld1q_f32(held + i), decay);
+        vst1q_f32(held + i, vmaxq_f32(vld1q_f32(power + i), h));
+    }
+    holdPowerScalar(power + i, held + i, n - i, decay);
+}
+
+void slidePowerNeon(const float* power, float* oldest, double* sum, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t p = vld1q_f32(power + i);
+        const float32x4_t o = vld1q_f32(oldest + i);
+        const float64x2_t lo = vsubq_f64(vcvt_f64_f32(vget_low_f32(p)), vcvt_f64_f32(vget_low_f32(o)));
+        const float64x2_t hi = vsubq_f64(vcvt_high_f64_f32(p), vcvt_high_f64_f32(o));
+        vst1q_f64(sum + i, vaddq_f64(vld1q_f64(sum + i), lo));
+        vst1q_f64(sum + i + 2, vaddq_f64(vld1q_f64(sum + i + 2), hi));
+        vst1q_f32(oldest + i, p);
+    }
+    slidePowerScalar(power + i, oldest + i, sum + i, n - i);
+}
+
+void linearToDbNeon(const float* power, float* output, size_t n, float scale, float floor) {
+    const float32x4_t vfloor = vdupq_n_f32(floor);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t p = vmaxq_f32(vmulq_n_f32(vld1q_f32(power + i), scale), vfloor);
+        vst1q_f32(output + i, vmulq_n_f32(fastLog10Neon(p), 10.0f));
+    }
+    linearToDbScalar(power + i, output + i, n - i, scale, floor);
+}
+
+#endif // FRITURE_SIMD_NEON
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+Isa detectIsa() {
+#if defined(FRITURE_SIMD_X86)
+    if (cpuHasAvx2()) {
+        return Isa::AVX2;
+    }
+#elif defined(FRITURE_SIMD_NEON)
+    return Isa::NEON;
+#endif
+    return Isa::Scalar;
+}
+
+} // namespace
+
+Isa activeIsa() {
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+const char* toString(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "Scalar";
+        case Isa::AVX2:   return "AVX2";
+        case Isa::NEON:   return "NEON";
+        default:          return "Unknown";
+    }
+}
+
+float fastLog10(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+
+    // x = 2^e × m, m in [1, 2)
+    int exponent = static_cast<int>(bits >> 23) - 127;
+    uint32_t mantissa_bits = (bits & 0x007FFFFFu) | 0x3F800000u;
+    float mantissa;
+    std::memcpy(&mantissa, &mantissa_bits, sizeof(mantissa));
+
+    // Fold m into [√½, √2) so the series argument stays small
+    if (mantissa > SQRT2) {
+        mantissa *= 0.5f;
+        exponent += 1;
+    }
+
+    // ln(m) = 2 × atanh(t), t = (m - 1) / (m + 1)
+    float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+    float t2 = t * t;
+    float p = 2.0f / 9.0f;
+    p = p * t2 + 2.0f / 7.0f;
+    p = p * t2 + 2.0f / 5.0f;
+    p = p * t2 + 2.0f / 3.0f;
+    p = p * t2 + 2.0f;
+    float ln_m = p * t;
+
+    return static_cast<float>(exponent) * LOG10_2 + ln_m * LOG10_E;
+}
+
+float fastDbToPower(float db) {
+    float y = std::clamp(db * DB_TO_LOG2, EXP2_MIN, EXP2_MAX);
+
+    // y = e + f, e integer, f in [-½, ½]
+    float e = std::nearbyint(y);
+    float f = y - e;
+
+    float p = EXP2_C6;
+    p = p * f + EXP2_C5;
+    p = p * f + EXP2_C4;
+    p = p * f + EXP2_C3;
+    p = p * f + EXP2_C2;
+    p = p * f + EXP2_C1;
+    p = p * f + 1.0f;
+
+    // 2^e straight into the exponent field
+    uint32_t bits = static_cast<uint32_t>(static_cast<int>(e) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+void applyWindow(const float* input, const float* window, float* output, size_t n) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            applyWindowAvx2(input, window, output, n);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            applyWindowNeon(input, window, output, n);
+            return;
+#endif
+        default:
+            applyWindowScalar(input, window, output, n);
+            return;
+    }
+}
+
+void powerToDb(const float* spectrum, float* output, size_t n,
+               float scale, float epsilon, bool exact) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            powerToDbAvx2(spectrum, output, n, scale, epsilon, exact);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            powerToDbNeon(spectrum, output, n, scale, epsilon, exact);
+            return;
+#endif
+        default:
+            powerToDbScalar(spectrum, output, n, scale, epsilon, exact);
+            return;
+    }
+}
+
+void dbToPower(const float* db, float* output, size_t n) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            dbToPowerAvx2(db, output, n);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            dbToPowerNeon(db, output, n);
+            return;
+#endif
+        default:
+            dbToPowerScalar(db, output, n);
+            return;
+    }
+}
+
+void dbToPalette(const float* db, size_t n, float min_db, float scale,
+                 const uint32_t* palette, uint32_t* output) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            dbToPaletteAvx2(db, n, min_db, scale, palette, output);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            dbToPaletteNeon(db, n, min_db, scale, palette, output);
+            return;
+#endif
+        default:
+            dbToPaletteScalar(db, n, min_db, scale, palette, output);
+            return;
+    }
+}
+
+float dotProduct(const float* a, const float* b, size_t n) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            return dotProductAvx2(a, b, n);
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            return dotProductNeon(a, b, n);
+#endif
+        default:
+            return dotProductScalar(a, b, n);
+    }
+}
+
+float trackFloor(const float* db, float* floor, float* excess, size_t n,
+                 float rise, float fall) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            return trackFloorAvx2(db, floor, excess, n, rise, fall);
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            return trackFloorNeon(db, floor, excess, n, rise, fall);
+#endif
+        default:
+            return trackFloorScalar(db, floor, excess, n, rise, fall);
+    }
+}
+
+void averagePower(const float* power, float* average, size_t n, float weight) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            averagePowerAvx2(power, average, n, weight);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            averagePowerNeon(power, average, n, weight);
+            return;
+#endif
+        default:
+            averagePowerScalar(power, average, n, weight);
+            return;
+    }
+}
+
+void holdPower(const float* power, float* held, size_t n, float decay) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            holdPowerAvx2(power, held, n, decay);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            holdPowerNeon(power, held, n, decay);
+            return;
+#endif
+        default:
+            holdPowerScalar(power, held, n, decay);
+            return;
+    }
+}
+
+void slidePower(const float* power, float* oldest, double* sum, size_t n) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            slidePowerAvx2(power, oldest, sum, n);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            slidePowerNeon(power, oldest, sum, n);
+            return;
+#endif
+        default:
+            slidePowerScalar(power, oldest, sum, n);
+            return;
+    }
+}
+
+void linearToDb(const float* power, float* output, size_t n, float scale, float floor) {
+    switch (activeIsa()) {
+#if defined(FRITURE_SIMD_X86)
+        case Isa::AVX2:
+            linearToDbAvx2(power, output, n, scale, floor);
+            return;
+#elif defined(FRITURE_SIMD_NEON)
+        case Isa::NEON:
+            linearToDbNeon(power, output, n, scale, floor);
+            return;
+#endif
+        default:
+            linearToDbScalar(power, output, n, scale, floor);
+            return;
+    }
+}
+
+} // namespace simd
+} // namespace friture
@@ -0,0 +1,202 @@
+/**
+ * @file sliding_dft.cpp
+ * @brief Implementation of SlidingDFT
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/sliding_dft.hpp>
+#include <friture/window_functions.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace friture {
+
+namespace {
+
+constexpr float EPSILON = 1e-30f;  // Same floor as FFTProcessor
+constexpr double PI = 3.14159265358979323846;
+
+} // namespace
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+SlidingDFT::SlidingDFT(size_t fft_size, WindowFunction window, size_t hop,
+                       const std::vector<uint32_t>& displayed_bins)
+    : fft_size_(fft_size),
+      hop_(hop),
+      reseed_columns_(0),
+      window_a_(0.5),
+      window_c_(0.25),
+      power_scale_(0.0),
+      displayed_bins_(displayed_bins)
+{
+    if (fft_size_ < 32 || fft_size_ > 16384 || (fft_size_ & (fft_size_ - 1)) != 0) {
+        throw std::invalid_argument("Sliding DFT size must be a power of 2 in [32, 16384]");
+    }
+    if (hop_ == 0 || hop_ > fft_size_) {
+        throw std::invalid_argument("Sliding DFT hop must be in [1, fft_size]");
+    }
+
+    if (!supports(window)) {
+        throw std::invalid_argument("Sliding DFT supports only the Hann and Hamming windows");
+    }
+    if (window == WindowFunction::Hamming) {
+        window_a_ = 0.54;
+        window_c_ = 0.23;
+    }
+
+    // Same coherent gain correction as FFTProcessor (the table is shared)
+    const double amplitude = static_cast<double>(fft_size_) *
+                             static_cast<double>(windowTable(window, fft_size_).coherent_gain);
+    power_scale_ = 1.0 / (amplitude * amplitude);
+
+    const size_t num_bins = fft_size_ / 2 + 1;
+    std::sort(displayed_bins_.begin(), displayed_bins_.end());
+    displayed_bins_.erase(std::unique(displayed_bins_.begin(), displayed_bins_.end()),
+                          displayed_bins_.end());
+    if (!displayed_bins_.empty() && displayed_bins_.back() >= num_bins) {
+        throw std::invalid_argument("Displayed bin exceeds spectrum size");
+    }
+
+    // Y(k - δ), Y(k), Y(k + δ) per displayed bin; δ = N / (N - 1)
+    const double n = static_cast<double>(fft_size_);
+    const double delta = n / (n - 1.0);
+    for (uint32_t bin : displayed_bins_) {
+        for (double f : {bin - delta, static_cast<double>(bin), bin + delta}) {
+            rotate_re_.push_back(std::cos(2.0 * PI * f / n));
+            rotate_im_.push_back(std::sin(2.0 * PI * f / n));
+            // e^{-j2πf} = e^{-j2π(f - k)}: exactly 1 for the centre sum
+            const double fraction = f - std::round(f);
+            enter_re_.push_back(std::cos(2.0 * PI * fraction));
+            enter_im_.push_back(-std::sin(2.0 * PI * fraction));
+        }
+    }
+    sum_re_.assign(rotate_re_.size(), 0.0);
+    sum_im_.assign(rotate_re_.size(), 0.0);
+
+    previous_.assign(fft_size_, 0.0f);
+    reseed_columns_ = std::max<size_t>(1, RESEED_FRAMES * fft_size_ / hop_);
+}
+
+// ============================================================================
+// Bin Selection
+// ============================================================================
+
+std::vector<uint32_t> SlidingDFT::displayedBins(const FrequencyResampler& resampler, size_t num_bins) {
+    std::vector<uint32_t> bins;
+    if (resampler.getAggregation() == BinAggregation::Interpolate) {
+        // Same two taps as FrequencyResampler::resampleInterpolate()
+        for (float mapped : resampler.getFrequencyMapping()) {
+            float bin_idx = std::clamp(mapped, 0.0f, static_cast<float>(num_bins - 1));
+            auto bin0 = static_cast<uint32_t>(bin_idx);
+            bins.push_back(bin0);
+            bins.push_back(std::min<uint32_t>(bin0 + 1, static_cast<uint32_t>(num_bins - 1)));
+        }
+    } else {
+        for (const auto& band : resampler.getBands()) {
+            for (uint32_t k = 0; k < band.count; ++k) {
+                bins.push_back(band.start_bin + k);
+            }
+        }
+    }
+
+    std::sort(bins.begin(), bins.end());
+    bins.erase(std::unique(bins.begin(), bins.end()), bins.end());
+    return bins;
+}
+
+bool SlidingDFT::isCheaper(size_t fft_size, size_t hop, size_t displayed_bins) {
+    const double n = static_cast<double>(fft_size);
+    const double sums = static_cast<double>(SUMS_PER_BIN * displayed_bins);
+    const double sliding = 10.0 * static_cast<double>(hop) * sums + 2.0 * n;
+    const double fft = 2.5 * n * std::log2(n) + n;
+    return sliding < fft;
+}
+
+// ============================================================================
+// Processing
+// ============================================================================
+
+void SlidingDFT::process(const float* frame, float* output) {
+    // Continuous with the previous frame: its last N - hop samples start this one
+    const bool continuous = primed_ && columns_since_seed_ + 1 < reseed_columns_ &&
+                            std::equal(frame, frame + (fft_size_ - hop_), previous_.begin() + hop_);
+    if (continuous) {
+        slide(frame);
+        ++columns_since_seed_;
+    } else {
+        reseed(frame);
+    }
+    std::copy(frame, frame + fft_size_, previous_.begin());
+    primed_ = true;
+
+    const size_t num_bins = fft_size_ / 2 + 1;
+    std::fill(output, output + num_bins, 10.0f * std::log10(EPSILON));
+
+    for (size_t i = 0; i < displayed_bins_.size(); ++i) {
+        const size_t s = SUMS_PER_BIN * i;
+        const double re = window_a_ * sum_re_[s + 1] - window_c_ * (sum_re_[s] + sum_re_[s + 2]);
+        const double im = window_a_ * sum_im_[s + 1] - window_c_ * (sum_im_[s] + sum_im_[s + 2]);
+        const double power = (re * re + im * im) * power_scale_;
+        output[displayed_bins_[i]] = 10.0f * std::log10(static_cast<float>(power) + EPSILON);
+    }
+}
+
+void SlidingDFT::reset() {
+    primed_ = false;
+}
+
+void SlidingDFT::reseed(const float* frame) {
+    // Y(f) = Σ x[n]·e^{-j2πfn/N}, phasor advanced by conj(rotate) per sample
+    for (size_t s = 0; s < sum_re_.size(); ++s) {
+        const double step_re = rotate_re_[s];
+        const double step_im = -rotate_im_[s];
+        double phase_re = 1.0;
+        double phase_im = 0.0;
+        double re = 0.0;
+        double im = 0.0;
+        for (size_t n = 0; n < fft_size_; ++n) {
+            const double x = frame[n];
+            re += x * phase_re;
+            im += x * phase_im;
+            const double next_re = phase_re * step_re - phase_im * step_im;
+            phase_im = phase_re * step_im + phase_im * step_re;
+            phase_re = next_re;
+        }
+        sum_re_[s] = re;
+        sum_im_[s] = im;
+    }
+    columns_since_seed_ = 0;
+    ++reseeds_;
+}
+
+void SlidingDFT::slide(const float* frame) {
+    // Leaving: previous_[0, hop); entering: the newest hop of this frame
+    const float* entering = frame + (fft_size_ - hop_);
+
+    // Written out to avoid std::complex's NaN checks
+    for (size_t s = 0; s < sum_re_.size(); ++s) {
+        double re = sum_re_[s];
+        double im = sum_im_[s];
+        const double w_re = rotate_re_[s];
+        const double w_im = rotate_im_[s];
+        const double v_re = enter_re_[s];
+        const double v_im = enter_im_[s];
+        for (size_t n = 0; n < hop_; ++n) {
+            const double x_new = entering[n];
+            const double a_re = re - previous_[n] + v_re * x_new;
+            const double a_im = im + v_im * x_new;
+            re = a_re * w_re - a_im * w_im;
+            im = a_re * w_im + a_im * w_re;
+        }
+        sum_re_[s] = re;
+        sum_im_[s] = im;
+    }
+}
+
+} // namespace friture
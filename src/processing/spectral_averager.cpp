@@ -0,0 +1,131 @@
+/**
+ * @file spectral_averager.cpp
+ * @brief Implementation of SpectralAverager
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/spectral_averager.hpp>
+#include <friture/simd_kernels.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace friture {
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+SpectralAverager::SpectralAverager(size_t size, float sample_rate, size_t hop_size,
+                                   const Options& options)
+    : size_(size),
+      sample_rate_(sample_rate),
+      hop_size_(hop_size),
+      options_(options),
+      weight_(1.0f),
+      decay_(0.0f),
+      ring_slot_(0),
+      count_(0),
+      pending_(0)
+{
+    if (size == 0 || sample_rate <= 0.0f || hop_size == 0) {
+        throw std::invalid_argument("Size, sample rate and hop size must be > 0");
+    }
+    if (!(options.time_seconds > 0.0f) || options.frames == 0 || options.decimation == 0) {
+        throw std::invalid_argument("Averaging time, frames and decimation must be > 0");
+    }
+
+    // Per-input coefficients of the time constant
+    const double hop_seconds = static_cast<double>(hop_size) / sample_rate;
+    weight_ = static_cast<float>(1.0 - std::exp(-hop_seconds / options.time_seconds));
+    decay_ = static_cast<float>(std::exp(-hop_seconds / options.time_seconds));
+
+    power_.assign(size, 0.0f);
+    state_.assign(size, 0.0f);
+    if (options.mode == AveragingMode::Linear) {
+        ring_.assign(options.frames * size, 0.0f);
+        sum_.assign(size, 0.0);
+    }
+}
+
+// ============================================================================
+// Averaging
+// ============================================================================
+
+bool SpectralAverager::process(const float* spectrum_db, float* output_db) {
+    float* power = power_.data();
+    float* state = state_.data();
+    simd::dbToPower(spectrum_db, power, size_);
+
+    switch (options_.mode) {
+        case AveragingMode::Exponential:
+            // The first input seeds the average
+            if (count_ == 0) {
+                std::copy(power, power + size_, state);
+                count_ = 1;
+            } else {
+                simd::averagePower(power, state, size_, weight_);
+            }
+            break;
+
+        case AveragingMode::PeakHold:
+            simd::holdPower(power, state, size_, count_ == 0 ? 0.0f : decay_);
+            count_ = 1;
+            break;
+
+        case AveragingMode::Linear: {
+            // The slot of the oldest input is zero until the ring has filled
+            const size_t frames = options_.frames;
+            simd::slidePower(power, ring_.data() + ring_slot_ * size_, sum_.data(), size_);
+            count_ = std::min(count_ + 1, frames);
+            if (++ring_slot_ == frames) {
+                ring_slot_ = 0;
+                // Exact sum once per lap, so rounding of the running sum
+                // does not build up
+                std::fill(sum_.begin(), sum_.end(), 0.0);
+                for (size_t f = 0; f < frames; ++f) {
+                    const float* frame = ring_.data() + f * size_;
+                    for (size_t i = 0; i < size_; ++i) {
+                        sum_[i] += frame[i];
+                    }
+                }
+            }
+            break;
+        }
+
+        default:
+            // Running mean of the inputs since the last output
+            if (pending_ == 0) {
+                std::copy(power, power + size_, state);
+            } else {
+                simd::averagePower(power, state, size_, 1.0f / static_cast<float>(pending_ + 1));
+            }
+            break;
+    }
+
+    if (++pending_ < options_.decimation) {
+        return false;
+    }
+    pending_ = 0;
+    if (options_.mode == AveragingMode::Linear) {
+        const double scale = 1.0 / static_cast<double>(count_);
+        for (size_t i = 0; i < size_; ++i) {
+            state[i] = static_cast<float>(sum_[i] * scale);
+        }
+    }
+    simd::linearToDb(state, output_db, size_, 1.0f, POWER_FLOOR);
+    return true;
+}
+
+void SpectralAverager::reset() {
+    std::fill(state_.begin(), state_.end(), 0.0f);
+    std::fill(ring_.begin(), ring_.end(), 0.0f);
+    std::fill(sum_.begin(), sum_.end(), 0.0);
+    ring_slot_ = 0;
+    count_ = 0;
+    pending_ = 0;
+}
+
+} // namespace friture
@@ -0,0 +1,102 @@
+/**
+ * @file stage_profiler.cpp
+ * @brief Implementation of StageProfiler snapshots and trace output
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/stage_profiler.hpp>
+#include <cstdio>
+
+namespace friture {
+
+namespace {
+
+constexpr int ANALYSIS_TID = 1;
+constexpr int RENDER_TID = 2;
+
+} // namespace
+
+StageProfiler::StageProfiler()
+    : trace_capacity_(0),
+      epoch_ns_(now())
+{
+}
+
+StageProfiler::~StageProfiler() = default;
+
+StageProfileSnapshot StageProfiler::getSnapshot() const {
+    StageProfileSnapshot snapshot;
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const Stage& s = stages_[i];
+        StageStatsSnapshot& out = snapshot.stages[i];
+        out.count = s.count.load(std::memory_order_relaxed);
+        out.total_ns = s.total_ns.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            out.histogram[b] = s.histogram[b].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+void StageProfiler::enableTrace(size_t events_per_stage) {
+    for (Stage& s : stages_) {
+        s.events = events_per_stage > 0 ? std::make_unique<TraceEvent[]>(events_per_stage) : nullptr;
+        s.event_count.store(0, std::memory_order_relaxed);
+    }
+    trace_capacity_ = events_per_stage;
+}
+
+size_t StageProfiler::getTraceEventCount() const {
+    size_t total = 0;
+    for (const Stage& s : stages_) {
+        total += s.event_count.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+bool StageProfiler::writeTrace(const std::string& path) {
+    if (!isTracing()) {
+        error_ = "Tracing is not enabled";
+        return false;
+    }
+
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        error_ = "Failed to open " + path + " for writing";
+        return false;
+    }
+
+    // Thread names first so viewers label the two lanes
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                       "\"args\":{\"name\":\"analysis\"}},\n", ANALYSIS_TID);
+    std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                       "\"args\":{\"name\":\"render\"}}", RENDER_TID);
+
+    // Complete ("X") events in µs; only the published prefix of each log is read
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const Stage& s = stages_[i];
+        const ProfileStage stage = static_cast<ProfileStage>(i);
+        const int tid = isAnalysisStage(stage) ? ANALYSIS_TID : RENDER_TID;
+        const size_t count = s.event_count.load(std::memory_order_acquire);
+        for (size_t e = 0; e < count; ++e) {
+            const TraceEvent& event = s.events[e];
+            const uint64_t start = event.start_ns > epoch_ns_ ? event.start_ns - epoch_ns_ : 0;
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                               "\"ts\":%.3f,\"dur\":%.3f}",
+                         toString(stage), tid, start / 1000.0, event.duration_ns / 1000.0);
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+
+    bool ok = !std::ferror(file);
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        error_ = "Failed to write " + path;
+    }
+    return ok;
+}
+
+} // namespace friture
@@ -0,0 +1,171 @@
+/**
+ * @file task_pool.cpp
+ * @brief Implementation of TaskPool
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/task_pool.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace friture {
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+TaskPool::TaskPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    queues_.reserve(threads);
+    for (size_t w = 0; w < threads; ++w) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    workers_.reserve(threads - 1);
+    for (size_t w = 1; w < threads; ++w) {
+        workers_.emplace_back(&TaskPool::workerLoop, this, w);
+    }
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+// ============================================================================
+// Processing
+// ============================================================================
+
+void TaskPool::parallelFor(size_t count, size_t grain, const RangeTask& task) {
+    if (grain == 0) {
+        throw std::invalid_argument("Chunk size must be > 0");
+    }
+    if (count == 0) {
+        return;
+    }
+
+    const size_t chunks = (count + grain - 1) / grain;
+    if (workers_.empty() || chunks == 1) {
+        task(0, 0, count);
+        return;
+    }
+
+    // Contiguous runs of chunks per worker; stealing evens out the rest
+    const size_t threads = queues_.size();
+    for (size_t w = 0; w < threads; ++w) {
+        const size_t first = chunks * w / threads;
+        const size_t last = chunks * (w + 1) / threads;
+        std::lock_guard<std::mutex> lock(queues_[w]->mutex);
+        for (size_t c = first; c < last; ++c) {
+            queues_[w]->chunks.push_back({c * grain, std::min(count, (c + 1) * grain)});
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        failed_.store(false, std::memory_order_relaxed);
+        failure_ = nullptr;
+        ++generation_;
+        workers_busy_ = workers_.size();
+    }
+    start_cv_.notify_all();
+
+    // The caller is worker 0
+    runChunks(0);
+
+    std::exception_ptr failure;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return workers_busy_ == 0; });
+        task_ = nullptr;
+        failure = failure_;
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void TaskPool::runChunks(size_t worker) {
+    Chunk chunk;
+    while (popOwn(worker, chunk) || steal(worker, chunk)) {
+        if (failed_.load(std::memory_order_relaxed)) {
+            continue;  // Drain without running
+        }
+        try {
+            (*task_)(worker, chunk.begin, chunk.end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!failure_) {
+                failure_ = std::current_exception();
+            }
+            failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool TaskPool::popOwn(size_t worker, Chunk& chunk) {
+    Queue& queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.chunks.empty()) {
+        return false;
+    }
+    chunk = queue.chunks.front();
+    queue.chunks.pop_front();
+    return true;
+}
+
+bool TaskPool::steal(size_t worker, Chunk& chunk) {
+    // Chunks are only added before a run starts, so once every deque has
+    // been seen empty there is nothing left to do
+    const size_t threads = queues_.size();
+    for (size_t i = 1; i < threads; ++i) {
+        Queue& victim = *queues_[(worker + i) % threads];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskPool::workerLoop(size_t worker) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        runChunks(worker);
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last = (--workers_busy_ == 0);
+        }
+        if (last) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+} // namespace friture
@@ -0,0 +1,134 @@
+/**
+ * @file window_functions.cpp
+ * @brief Implementation of the shared window table cache
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#define _USE_MATH_DEFINES  // For M_PI on Windows/MSVC
+#include <friture/window_functions.hpp>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace friture {
+
+namespace {
+
+struct CachedWindow {
+    WindowFunction type;
+    size_t size;
+    float kaiser_beta;
+    WindowTable table;
+};
+
+// Σ (-1)^k a_k cos(2πkn/(N-1)); kn is reduced first, so every cosine
+// argument is in [0, 2π) (StaticSpectrumPipeline evaluates the same sums)
+void cosineSum(const double* a, size_t terms, float* window, size_t size) {
+    const size_t n1 = size - 1;
+    for (size_t i = 0; i < size; ++i) {
+        double value = 0.0;
+        double sign = 1.0;
+        for (size_t k = 0; k < terms; ++k) {
+            value += sign * a[k] * std::cos(2.0 * M_PI * static_cast<double>((k * i) % n1) /
+                                            static_cast<double>(n1));
+            sign = -sign;
+        }
+        window[i] = static_cast<float>(value);
+    }
+}
+
+void computeWindow(WindowFunction type, float kaiser_beta, float* window, size_t size) {
+    // Hann and Hamming keep FFTProcessor's original expressions bit for bit
+    const float N = static_cast<float>(size - 1);
+
+    switch (type) {
+        case WindowFunction::Hann:
+            for (size_t i = 0; i < size; ++i) {
+                window[i] = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / N));
+            }
+            break;
+
+        case WindowFunction::Hamming:
+            for (size_t i = 0; i < size; ++i) {
+                window[i] = 0.54f - 0.46f * std::cos(2.0f * M_PI * i / N);
+            }
+            break;
+
+        case WindowFunction::BlackmanHarris:
+            cosineSum(BLACKMAN_HARRIS_COEFFICIENTS, 4, window, size);
+            break;
+
+        case WindowFunction::FlatTop:
+            cosineSum(FLAT_TOP_COEFFICIENTS, 5, window, size);
+            break;
+
+        case WindowFunction::Kaiser: {
+            const double beta = kaiser_beta;
+            const double norm = 1.0 / besselI0(beta);
+            const double n1 = static_cast<double>(size - 1);
+            for (size_t i = 0; i < size; ++i) {
+                const double r = 2.0 * static_cast<double>(i) / n1 - 1.0;
+                window[i] = static_cast<float>(besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) * norm);
+            }
+            break;
+        }
+
+        default:
+            throw std::invalid_argument("Unknown window function type");
+    }
+}
+
+} // namespace
+
+double besselI0(double x) {
+    const double q = 0.25 * x * x;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 500 && term > 1e-17 * sum; ++k) {
+        term *= q / (static_cast<double>(k) * static_cast<double>(k));
+        sum += term;
+    }
+    return sum;
+}
+
+WindowTable windowTable(WindowFunction type, size_t size, float kaiser_beta) {
+    if (size < 2) {
+        throw std::invalid_argument("Window size must be >= 2");
+    }
+    if (!(kaiser_beta >= 0.0f && kaiser_beta <= MAX_KAISER_BETA)) {
+        throw std::invalid_argument("Kaiser beta must be in [0, MAX_KAISER_BETA]");
+    }
+    if (type != WindowFunction::Kaiser) {
+        kaiser_beta = 0.0f;   // One table per size, whatever β the caller carries
+    }
+
+    static std::mutex mutex;
+    static std::vector<CachedWindow> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const CachedWindow& entry : cache) {
+        if (entry.type == type && entry.size == size && entry.kaiser_beta == kaiser_beta) {
+            return entry.table;
+        }
+    }
+
+    auto coefficients = std::make_shared<float[]>(size);
+    computeWindow(type, kaiser_beta, coefficients.get(), size);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < size; ++i) {
+        sum += coefficients[i];
+    }
+
+    WindowTable table;
+    table.coefficients = std::move(coefficients);
+    table.coherent_gain = static_cast<float>(sum / static_cast<double>(size));
+    cache.push_back(CachedWindow{type, size, kaiser_beta, table});
+    return table;
+}
+
+} // namespace friture
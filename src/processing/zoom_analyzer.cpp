@@ -0,0 +1,328 @@
+/**
+ * @file zoom_analyzer.cpp
+ * @brief Implementation of ZoomAnalyzer
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/zoom_analyzer.hpp>
+#include <friture/fft_wisdom.hpp>
+#include <friture/simd_kernels.hpp>
+#include <friture/window_functions.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace friture {
+
+namespace {
+
+constexpr float EPSILON = 1e-30f;  // Same floor as FFTProcessor
+constexpr double PI = 3.14159265358979323846;
+constexpr double KAISER_BETA = 8.0;
+
+constexpr size_t EVEN_TAPS = ZoomAnalyzer::HALF_BAND_TAPS / 2 + 1;   // Nonzero off-centre taps
+constexpr size_t CENTER_OFFSET = ZoomAnalyzer::HALF_BAND_TAPS / 4;    // Odd-phase index of the centre
+
+// Off-centre half-band taps h[2i - L/2], i = 0..L/2; the centre tap is 1/2
+std::vector<float> designHalfBand() {
+    const int half = static_cast<int>(ZoomAnalyzer::HALF_BAND_TAPS / 2);
+    const double norm = besselI0(KAISER_BETA);
+
+    std::vector<double> h(EVEN_TAPS);
+    double sum = 0.0;
+    for (size_t i = 0; i < EVEN_TAPS; ++i) {
+        const double t = 2.0 * static_cast<double>(i) - half;
+        const double r = t / (half + 1);
+        const double window = besselI0(KAISER_BETA * std::sqrt(1.0 - r * r)) / norm;
+        h[i] = std::sin(PI * t / 2.0) / (PI * t) * window;
+        sum += h[i];
+    }
+
+    // Unity DC gain: off-centre taps sum to 1/2
+    std::vector<float> taps(EVEN_TAPS);
+    for (size_t i = 0; i < EVEN_TAPS; ++i) {
+        taps[i] = static_cast<float>(h[i] * 0.5 / sum);
+    }
+    return taps;
+}
+
+// Lowest zoom bin m on the D·N-point grid, band centre at m + N/2 (negative
+// near 0 Hz: those bins hold the mirror image and are never shown)
+int64_t firstBinFor(const ChainKey& key, size_t decimation) {
+    const double spacing = static_cast<double>(key.sample_rate) / static_cast<double>(decimation * key.fft_size);
+    const double centre = 0.5 * (static_cast<double>(key.min_freq) + key.max_freq);
+    return std::llround(centre / spacing) - static_cast<int64_t>(key.fft_size / 2);
+}
+
+size_t hopSizeFor(const ChainKey& key) {
+    SpectrogramSettings settings;
+    settings.fft_size = key.fft_size;
+    settings.overlap_percent = key.overlap_percent;
+    return settings.getSamplesPerColumn();
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+ZoomAnalyzer::ZoomAnalyzer(const ChainKey& key)
+    : fft_size_(key.fft_size),
+      hop_size_(hopSizeFor(key)),
+      decimation_(decimationFor(key)),
+      window_size_(key.fft_size),
+      first_bin_(0),
+      center_freq_(0.0),
+      bin_spacing_(0.0),
+      taps_(designHalfBand())
+{
+    if (fft_size_ < 32 || fft_size_ > 16384 || (fft_size_ & (fft_size_ - 1)) != 0) {
+        throw std::invalid_argument("Zoom FFT size must be a power of 2 in [32, 16384]");
+    }
+    if (decimation_ < 2) {
+        throw std::invalid_argument("Frequency range too wide to zoom");
+    }
+
+    const double rate = key.sample_rate;
+    const size_t span = decimation_ * fft_size_;
+    bin_spacing_ = rate / static_cast<double>(span);
+    first_bin_ = firstBinFor(key, decimation_);
+    center_freq_ = static_cast<double>(first_bin_ + static_cast<int64_t>(fft_size_ / 2)) * bin_spacing_;
+
+    // Resampler for the virtual D·N-point spectrum (validates range and height)
+    resampler_ = std::make_unique<FrequencyResampler>(
+        key.scale, key.min_freq, key.max_freq, key.sample_rate,
+        span, key.height, key.aggregation);
+    resampler_->setWeighting(key.weighting);
+    spectrum_.assign(span / 2 + 1, 10.0f * std::log10(EPSILON));
+
+    // n outputs of a stage need 2(n - 1) + HALF_BAND_TAPS inputs
+    size_t stages = 0;
+    for (size_t d = decimation_; d > 1; d /= 2) {
+        window_size_ = 2 * (window_size_ - 1) + HALF_BAND_TAPS;
+        ++stages;
+    }
+
+    const size_t capacity = EVEN_TAPS + CHUNK / 2 + 1;
+    stages_.resize(stages);
+    for (Stage& stage : stages_) {
+        stage.even_re.resize(capacity);
+        stage.even_im.resize(capacity);
+        stage.odd_re.resize(capacity);
+        stage.odd_im.resize(capacity);
+    }
+
+    const double step = -2.0 * PI * center_freq_ / rate;
+    step_re_ = std::cos(step);
+    step_im_ = std::sin(step);
+
+    mix_re_.resize(CHUNK);
+    mix_im_.resize(CHUNK);
+    zoom_db_.resize(fft_size_);
+    ring_re_.assign(fft_size_, 0.0f);
+    ring_im_.assign(fft_size_, 0.0f);
+    previous_hop_.assign(hop_size_, 0.0f);
+
+    // Same shared window and level correction as FFTProcessor
+    window_ = windowTable(key.window, fft_size_, key.kaiser_beta);
+    const float amplitude = static_cast<float>(fft_size_) * window_.coherent_gain;
+    power_scale_ = 1.0f / (amplitude * amplitude);
+
+    fft_in_ = fftwf_alloc_complex(fft_size_);
+    fft_out_ = fftwf_alloc_complex(fft_size_);
+    if (fft_in_ && fft_out_) {
+        std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
+        plan_ = fftwf_plan_dft_1d(static_cast<int>(fft_size_), fft_in_, fft_out_,
+                                  FFTW_FORWARD, FFTW_MEASURE);
+    }
+    if (!plan_) {
+        fftwf_free(fft_in_);
+        fftwf_free(fft_out_);
+        throw std::runtime_error("Failed to create zoom FFT plan");
+    }
+}
+
+ZoomAnalyzer::~ZoomAnalyzer() {
+    {
+        std::lock_guard<std::mutex> lock(FFTWisdom::plannerMutex());
+        fftwf_destroy_plan(plan_);
+    }
+    fftwf_free(fft_in_);
+    fftwf_free(fft_out_);
+}
+
+size_t ZoomAnalyzer::decimationFor(const ChainKey& key) {
+    if (key.fft_size == 0 || key.sample_rate <= 0.0f || key.max_freq <= key.min_freq) {
+        return 1;
+    }
+
+    size_t decimation = 1;
+    while (decimation * 2 <= MAX_DECIMATION && decimation * 2 * key.fft_size <= MAX_SPAN) {
+        decimation *= 2;
+    }
+
+    const double rate = key.sample_rate;
+    for (; decimation >= 2; decimation /= 2) {
+        const double spacing = rate / static_cast<double>(decimation * key.fft_size);
+        const int64_t centre_bin = firstBinFor(key, decimation) + static_cast<int64_t>(key.fft_size / 2);
+        const double fc = static_cast<double>(centre_bin) * spacing;
+        const double reach = PASSBAND * rate / static_cast<double>(decimation);
+        if (key.min_freq >= fc - reach && key.max_freq <= fc + reach) {
+            return decimation;
+        }
+    }
+    return 1;
+}
+
+// ============================================================================
+// Processing
+// ============================================================================
+
+void ZoomAnalyzer::analyze(const float* window) {
+    // Continuous with the previous window: its newest hop precedes this one's
+    const float* newest = window + (window_size_ - hop_size_);
+    const bool continuous = primed_ &&
+                            std::equal(newest - hop_size_, newest, previous_hop_.begin());
+    if (continuous) {
+        push(newest, hop_size_);
+    } else {
+        restart();
+        push(window, window_size_);
+        ++reseeds_;
+    }
+    std::copy(newest, newest + hop_size_, previous_hop_.begin());
+    primed_ = true;
+
+    transform();
+}
+
+void ZoomAnalyzer::resample(float* column_db) const {
+    resampler_->resample(spectrum_.data(), column_db);
+}
+
+void ZoomAnalyzer::reset() {
+    primed_ = false;
+}
+
+void ZoomAnalyzer::restart() {
+    for (Stage& stage : stages_) {
+        stage.even_size = 0;
+        stage.odd_size = 0;
+        stage.next_odd = false;
+    }
+    phasor_re_ = 1.0;
+    phasor_im_ = 0.0;
+    std::fill(ring_re_.begin(), ring_re_.end(), 0.0f);
+    std::fill(ring_im_.begin(), ring_im_.end(), 0.0f);
+    ring_pos_ = 0;
+}
+
+void ZoomAnalyzer::push(const float* input, size_t count) {
+    while (count > 0) {
+        const size_t n = std::min(count, CHUNK);
+
+        // Mix down: x·e^{-j2π·fc·t}, phasor advanced per sample
+        double p_re = phasor_re_;
+        double p_im = phasor_im_;
+        for (size_t i = 0; i < n; ++i) {
+            mix_re_[i] = static_cast<float>(input[i] * p_re);
+            mix_im_[i] = static_cast<float>(input[i] * p_im);
+            const double next_re = p_re * step_re_ - p_im * step_im_;
+            p_im = p_re * step_im_ + p_im * step_re_;
+            p_re = next_re;
+        }
+        const double magnitude = std::sqrt(p_re * p_re + p_im * p_im);
+        phasor_re_ = p_re / magnitude;
+        phasor_im_ = p_im / magnitude;
+
+        // Each stage reads its input into its own history first, so the
+        // outputs can overwrite the chunk in place
+        size_t produced = n;
+        for (Stage& stage : stages_) {
+            produced = pushStage(stage, mix_re_.data(), mix_im_.data(), produced,
+                                 mix_re_.data(), mix_im_.data());
+        }
+
+        for (size_t i = 0; i < produced; ++i) {
+            ring_re_[ring_pos_] = mix_re_[i];
+            ring_im_[ring_pos_] = mix_im_[i];
+            ring_pos_ = (ring_pos_ + 1 == fft_size_) ? 0 : ring_pos_ + 1;
+        }
+
+        input += n;
+        count -= n;
+    }
+}
+
+size_t ZoomAnalyzer::pushStage(Stage& stage, const float* in_re, const float* in_im, size_t count,
+                               float* out_re, float* out_im) {
+    for (size_t i = 0; i < count; ++i) {
+        if (stage.next_odd) {
+            stage.odd_re[stage.odd_size] = in_re[i];
+            stage.odd_im[stage.odd_size] = in_im[i];
+            ++stage.odd_size;
+        } else {
+            stage.even_re[stage.even_size] = in_re[i];
+            stage.even_im[stage.even_size] = in_im[i];
+            ++stage.even_size;
+        }
+        stage.next_odd = !stage.next_odd;
+    }
+
+    // Output j: even [j, j + EVEN_TAPS) and the centre, odd j + CENTER_OFFSET
+    const size_t by_even = (stage.even_size >= EVEN_TAPS) ? stage.even_size - EVEN_TAPS + 1 : 0;
+    const size_t by_odd = (stage.odd_size > CENTER_OFFSET) ? stage.odd_size - CENTER_OFFSET : 0;
+    const size_t ready = std::min(by_even, by_odd);
+
+    const float* taps = taps_.data();
+    for (size_t j = 0; j < ready; ++j) {
+        out_re[j] = simd::dotProduct(stage.even_re.data() + j, taps, EVEN_TAPS) +
+                    0.5f * stage.odd_re[j + CENTER_OFFSET];
+        out_im[j] = simd::dotProduct(stage.even_im.data() + j, taps, EVEN_TAPS) +
+                    0.5f * stage.odd_im[j + CENTER_OFFSET];
+    }
+
+    // Keep what the next output reads
+    auto drop = [ready](std::vector<float>& samples, size_t size) {
+        std::memmove(samples.data(), samples.data() + ready, (size - ready) * sizeof(float));
+    };
+    drop(stage.even_re, stage.even_size);
+    drop(stage.even_im, stage.even_size);
+    drop(stage.odd_re, stage.odd_size);
+    drop(stage.odd_im, stage.odd_size);
+    stage.even_size -= ready;
+    stage.odd_size -= ready;
+    return ready;
+}
+
+void ZoomAnalyzer::transform() {
+    // Oldest decimated sample first
+    const float* window = window_.data();
+    for (size_t k = 0; k < fft_size_; ++k) {
+        const size_t index = (ring_pos_ + k) % fft_size_;
+        fft_in_[k][0] = ring_re_[index] * window[k];
+        fft_in_[k][1] = ring_im_[index] * window[k];
+    }
+    fftwf_execute(plan_);
+
+    // Lowest frequency first: negative offsets from fc, then the rest
+    const size_t half = fft_size_ / 2;
+    simd::powerToDb(reinterpret_cast<const float*>(fft_out_ + half), zoom_db_.data(),
+                    half, power_scale_, EPSILON, false);
+    simd::powerToDb(reinterpret_cast<const float*>(fft_out_), zoom_db_.data() + half,
+                    half, power_scale_, EPSILON, false);
+
+    // Zoom bin k is virtual bin m + k; only 0..D·N/2 exist
+    const int64_t bins = static_cast<int64_t>(spectrum_.size());
+    const int64_t first = std::max<int64_t>(first_bin_, 0);
+    const int64_t end = std::min<int64_t>(first_bin_ + static_cast<int64_t>(fft_size_), bins);
+    std::copy(zoom_db_.begin() + (first - first_bin_), zoom_db_.begin() + (end - first_bin_),
+              spectrum_.begin() + first);
+}
+
+} // namespace friture
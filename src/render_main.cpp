@@ -0,0 +1,407 @@
+/**
+ * @file render_main.cpp
+ * @brief Headless batch renderer: WAV files in, spectrogram BMPs out
+ *
+ * Runs the spectrogram pipeline over whole recordings without SDL or
+ * real-time pacing. Each file is split into time segments rendered on
+ * several threads; --jobs renders several files at once. Each job holds
+ * one open file and one image, and jobs are limited so the images of the
+ * longest input fit --memory, so memory does not grow with the number or
+ * length of the inputs. --summary writes per-file spectrum statistics as CSV.
+ *
+ * Usage:
+ *   ./friture-render [options] input.wav [more.wav ...]
+ *   ./friture-render [options] --input-list files.txt
+ *
+ * Each input.wav is written to input.bmp (or into --output-dir).
+ */
+
+#include <friture/offline_renderer.hpp>
+#include <friture/fft_wisdom.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t DEFAULT_MEMORY_MB = 4096;
+
+void printUsage(const char* program_name) {
+    std::cout << "Friture C++ - Offline Spectrogram Renderer" << std::endl;
+    std::cout << "\nUsage:" << std::endl;
+    std::cout << "  " << program_name << " [options] input.wav [more.wav ...]" << std::endl;
+    std::cout << "\nEach input.wav is rendered to input.bmp." << std::endl;
+    std::cout << "\nOptions:" << std::endl;
+    std::cout << "  --output-dir DIR  Write images into DIR instead of next to the input" << std::endl;
+    std::cout << "  --input-list FILE Also render the files listed in FILE, one per line" << std::endl;
+    std::cout << "                    (- reads the list from stdin)" << std::endl;
+    std::cout << "  --summary FILE    Write per-file octave band levels and spectral peaks" << std::endl;
+    std::cout << "                    to FILE as CSV" << std::endl;
+    std::cout << "  --peaks N         Peaks per file in the summary (default 5)" << std::endl;
+    std::cout << "  --jobs N          Files rendered concurrently (default: one per core for" << std::endl;
+    std::cout << "                    many files, otherwise one per file)" << std::endl;
+    std::cout << "                    limited so the images fit --memory" << std::endl;
+    std::cout << "  --memory MB       Image memory shared by the jobs (default "
+              << DEFAULT_MEMORY_MB << ")" << std::endl;
+    std::cout << "  --threads N       Worker threads per file (default: cores / jobs)" << std::endl;
+    std::cout << "  --fft-size N      FFT size, power of 2 in [32, 16384] (default 4096)" << std::endl;
+    std::cout << "  --overlap PCT     Frame overlap in percent, [0, 99.9] (default 75)" << std::endl;
+    std::cout << "  --height N        Image height in pixels (default 512)" << std::endl;
+    std::cout << "  --max-width N     Widen the hop so the image is at most N columns" << std::endl;
+    std::cout << "                    (default " << friture::OfflineRenderOptions::DEFAULT_MAX_WIDTH
+              << ", 0 = one column per hop)" << std::endl;
+    std::cout << "  --scale NAME      linear, log, mel, erb or octave (default mel)" << std::endl;
+    std::cout << "  --min-freq HZ     Lowest displayed frequency (default 20)" << std::endl;
+    std::cout << "  --max-freq HZ     Highest displayed frequency (default: Nyquist)" << std::endl;
+    std::cout << "  --min-db DB       Level mapped to the first palette color (default -140)" << std::endl;
+    std::cout << "  --max-db DB       Level mapped to the last palette color (default 0)" << std::endl;
+    std::cout << "  --grayscale       Grayscale palette instead of CMRMAP" << std::endl;
+    std::cout << "  --window NAME     hann, hamming, blackman-harris, flat-top or kaiser[:BETA]" << std::endl;
+    std::cout << "                    (default hann; Kaiser beta default 8.6)" << std::endl;
+    std::cout << "  --weighting W     Frequency weighting: a, b, c or none (default none)" << std::endl;
+    std::cout << std::endl;
+}
+
+bool parseScale(const std::string& name, friture::FrequencyScale& scale) {
+    using friture::FrequencyScale;
+    if (name == "linear") { scale = FrequencyScale::Linear; }
+    else if (name == "log") { scale = FrequencyScale::Logarithmic; }
+    else if (name == "mel") { scale = FrequencyScale::Mel; }
+    else if (name == "erb") { scale = FrequencyScale::ERB; }
+    else if (name == "octave") { scale = FrequencyScale::Octave; }
+    else { return false; }
+    return true;
+}
+
+// NAME or kaiser:BETA
+bool parseWindow(const std::string& text, friture::WindowFunction& window, float& kaiser_beta) {
+    using friture::WindowFunction;
+    const size_t colon = text.find(':');
+    const std::string name = text.substr(0, colon);
+    if (name == "hann") { window = WindowFunction::Hann; }
+    else if (name == "hamming") { window = WindowFunction::Hamming; }
+    else if (name == "blackman-harris") { window = WindowFunction::BlackmanHarris; }
+    else if (name == "flat-top") { window = WindowFunction::FlatTop; }
+    else if (name == "kaiser") { window = WindowFunction::Kaiser; }
+    else { return false; }
+    if (colon != std::string::npos) {
+        if (window != WindowFunction::Kaiser) {
+            return false;
+        }
+        kaiser_beta = std::strtof(text.c_str() + colon + 1, nullptr);
+    }
+    return true;
+}
+
+bool parseWeighting(const std::string& name, friture::WeightingType& weighting) {
+    using friture::WeightingType;
+    if (name == "none") { weighting = WeightingType::None; }
+    else if (name == "a" || name == "A") { weighting = WeightingType::A; }
+    else if (name == "b" || name == "B") { weighting = WeightingType::B; }
+    else if (name == "c" || name == "C") { weighting = WeightingType::C; }
+    else { return false; }
+    return true;
+}
+
+// Paths one per line; blank lines are skipped
+bool readInputList(const std::string& path, std::vector<std::string>& inputs) {
+    std::ifstream file;
+    if (path != "-") {
+        file.open(path);
+        if (!file) {
+            return false;
+        }
+    }
+    std::istream& in = (path == "-") ? std::cin : file;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            inputs.push_back(line);
+        }
+    }
+    return true;
+}
+
+// RFC 4180 quoting for paths with commas, quotes or line breaks
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void writeSummaryHeader(std::ostream& out, size_t peaks) {
+    out << "file,columns,mean_db,max_db";
+    float center = friture::OfflineRenderSummary::FIRST_BAND_CENTER;
+    for (size_t k = 0; k < friture::OfflineRenderSummary::MAX_BANDS; ++k, center *= 2.0f) {
+        out << ",band_" << center << "_db";
+    }
+    for (size_t p = 1; p <= peaks; ++p) {
+        out << ",peak" << p << "_hz,peak" << p << "_db";
+    }
+    out << "\n";
+}
+
+// Bands above Nyquist and missing peaks are left empty
+void writeSummaryRow(std::ostream& out, const std::string& input, uint64_t columns,
+                     const friture::OfflineRenderSummary& summary, size_t peaks) {
+    out << csvField(input) << "," << columns << std::fixed << std::setprecision(2)
+        << "," << summary.mean_db << "," << summary.max_db;
+    for (size_t k = 0; k < friture::OfflineRenderSummary::MAX_BANDS; ++k) {
+        out << ",";
+        if (k < summary.band_db.size()) {
+            out << summary.band_db[k];
+        }
+    }
+    for (size_t p = 0; p < peaks; ++p) {
+        out << ",";
+        if (p < summary.peaks.size()) {
+            out << summary.peaks[p].frequency << "," << summary.peaks[p].level_db;
+        } else {
+            out << ",";
+        }
+    }
+    out << std::defaultfloat << "\n";
+}
+
+std::string outputPathFor(const std::string& input, const std::string& output_dir) {
+    std::filesystem::path path(input);
+    path.replace_extension(".bmp");
+    if (!output_dir.empty()) {
+        path = std::filesystem::path(output_dir) / path.filename();
+    }
+    return path.string();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        friture::OfflineRenderOptions options;
+        std::string output_dir;
+        std::string summary_path;
+        size_t jobs = 0;
+        uint64_t memory_mb = DEFAULT_MEMORY_MB;
+        bool threads_given = false;
+        std::vector<std::string> inputs;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool has_value = (i + 1 < argc);
+            if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "--output-dir" && has_value) {
+                output_dir = argv[++i];
+            } else if (arg == "--input-list" && has_value) {
+                if (!readInputList(argv[++i], inputs)) {
+                    std::cerr << "Cannot read input list: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--summary" && has_value) {
+                summary_path = argv[++i];
+            } else if (arg == "--peaks" && has_value) {
+                options.summary_peaks = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--jobs" && has_value) {
+                jobs = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--memory" && has_value) {
+                memory_mb = std::max<uint64_t>(1, std::strtoull(argv[++i], nullptr, 10));
+            } else if (arg == "--threads" && has_value) {
+                options.threads = std::strtoul(argv[++i], nullptr, 10);
+                threads_given = true;
+            } else if (arg == "--fft-size" && has_value) {
+                options.fft_size = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--overlap" && has_value) {
+                options.overlap_percent = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--height" && has_value) {
+                options.height = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--max-width" && has_value) {
+                options.max_width = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--scale" && has_value) {
+                if (!parseScale(argv[++i], options.scale)) {
+                    std::cerr << "Unknown frequency scale: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--min-freq" && has_value) {
+                options.min_freq = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--max-freq" && has_value) {
+                options.max_freq = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--min-db" && has_value) {
+                options.min_db = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--max-db" && has_value) {
+                options.max_db = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--grayscale") {
+                options.theme = friture::ColorTheme::Grayscale;
+            } else if (arg == "--window" && has_value) {
+                if (!parseWindow(argv[++i], options.window, options.kaiser_beta)) {
+                    std::cerr << "Unknown window: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--weighting" && has_value) {
+                if (!parseWeighting(argv[++i], options.weighting)) {
+                    std::cerr << "Unknown weighting: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (!arg.empty() && arg[0] == '-') {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            } else {
+                inputs.push_back(arg);
+            }
+        }
+
+        if (inputs.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!output_dir.empty()) {
+            std::filesystem::create_directories(output_dir);
+        }
+
+        // Validates the options once before any worker starts. A WAV file
+        // has at least one byte per frame, so the longest file bounds the
+        // image any job will hold
+        uint64_t longest = 0;
+        for (const std::string& input : inputs) {
+            std::error_code error;
+            const uintmax_t bytes = std::filesystem::file_size(input, error);
+            if (!error) {
+                longest = std::max<uint64_t>(longest, bytes);
+            }
+        }
+        const uint64_t image_bytes = friture::OfflineRenderer(options).imageBytesFor(longest);
+
+        // Whole files in parallel scale best (no per-file synchronization);
+        // a few long files are split over the cores instead. Each job holds
+        // one open file and one image, so the jobs are limited to the images
+        // that fit the memory budget
+        const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        if (jobs == 0) {
+            jobs = cores;
+        }
+        jobs = std::min(jobs, inputs.size());
+        if (image_bytes > 0) {
+            const uint64_t fit = std::max<uint64_t>(1, memory_mb * 1024 * 1024 / image_bytes);
+            if (fit < jobs) {
+                std::cout << "Rendering " << fit << " files at a time: up to "
+                          << (image_bytes + 1024 * 1024 - 1) / (1024 * 1024)
+                          << " MB per image, --memory " << memory_mb << " MB" << std::endl;
+                jobs = static_cast<size_t>(fit);
+            }
+        }
+        if (!threads_given) {
+            options.threads = std::max<size_t>(1, cores / jobs);
+        }
+
+        std::ofstream summary_file;
+        if (!summary_path.empty()) {
+            summary_file.open(summary_path);
+            if (!summary_file) {
+                std::cerr << "Cannot write summary: " << summary_path << std::endl;
+                return 1;
+            }
+            writeSummaryHeader(summary_file, options.summary_peaks);
+        }
+        const bool summarize = summary_file.is_open();
+
+        // Reuse plans measured by earlier runs (or --fftw-warmup of the viewer)
+        friture::FFTWisdom wisdom(friture::FFTWisdom::defaultCachePath());
+        wisdom.load();
+
+        std::atomic<size_t> next_input{0};
+        std::atomic<uint64_t> total_columns{0};
+        std::atomic<size_t> failures{0};
+        std::mutex output_mutex;
+
+        auto runJob = [&]() {
+            friture::OfflineRenderer renderer(options);
+            for (size_t index = next_input.fetch_add(1); index < inputs.size();
+                 index = next_input.fetch_add(1)) {
+                const std::string& input = inputs[index];
+                std::string output = outputPathFor(input, output_dir);
+
+                friture::OfflineRenderStats stats;
+                friture::OfflineRenderSummary summary;
+                bool ok = renderer.renderFile(input.c_str(), output.c_str(), &stats,
+                                              summarize ? &summary : nullptr);
+
+                std::lock_guard<std::mutex> lock(output_mutex);
+                if (ok) {
+                    total_columns.fetch_add(stats.columns);
+                    if (summarize) {
+                        writeSummaryRow(summary_file, input, stats.columns, summary,
+                                        options.summary_peaks);
+                    }
+                    std::cout << input << " -> " << output << ": " << stats.columns
+                              << " columns in " << std::fixed << std::setprecision(3)
+                              << stats.seconds << " s (" << std::setprecision(0)
+                              << stats.getColumnsPerSecond() << " columns/s, "
+                              << stats.threads << " threads)" << std::endl;
+                } else {
+                    failures.fetch_add(1);
+                    std::cerr << input << ": " << renderer.getError() << std::endl;
+                }
+            }
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (size_t j = 1; j < jobs; ++j) {
+            workers.emplace_back(runJob);
+        }
+        runJob();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "\nRendered " << (inputs.size() - failures.load()) << "/" << inputs.size()
+                  << " files, " << total_columns.load() << " columns in "
+                  << std::fixed << std::setprecision(3) << seconds << " s ("
+                  << std::setprecision(0)
+                  << (seconds > 0.0 ? total_columns.load() / seconds : 0.0)
+                  << " columns/s)" << std::endl;
+
+        if (summarize) {
+            summary_file.flush();
+            if (!summary_file) {
+                std::cerr << "Failed to write summary: " << summary_path << std::endl;
+                failures.fetch_add(1);
+            }
+        }
+
+        // Keep any newly measured plans for the next run
+        wisdom.save();
+        return failures.load() == 0 ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\nFATAL ERROR: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nFATAL ERROR: Unknown exception" << std::endl;
+        return 2;
+    }
+}
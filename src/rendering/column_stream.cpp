@@ -0,0 +1,657 @@
+/**
+ * @file column_stream.cpp
+ * @brief Implementation of the column stream encoder, decoder, sender and receiver
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/column_stream.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace friture {
+
+namespace {
+
+constexpr char PACKET_MAGIC[4] = {'F', 'R', 'S', 'C'};
+constexpr uint8_t PACKET_VERSION = 1;
+
+// Largest UDP payload a receiver has to accept
+constexpr size_t MAX_RECEIVE = 65536;
+
+// Little-endian field access
+
+void putU16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putF32(std::vector<uint8_t>& out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(out, bits);
+}
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readU64(const uint8_t* p) {
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+float readF32(const uint8_t* p) {
+    uint32_t bits = readU32(p);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// LEB128 varints
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool readVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        const uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sent value q of a level, and the level it decodes back to (middle of its step);
+// same quantization as the recorder
+
+uint16_t quantize(uint16_t level, uint32_t level_bits) {
+    return static_cast<uint16_t>(level >> (16 - level_bits));
+}
+
+uint16_t dequantize(uint16_t q, uint32_t level_bits) {
+    const uint32_t shift = 16 - level_bits;
+    const uint32_t half_step = shift > 0 ? 1u << (shift - 1) : 0;
+    return static_cast<uint16_t>((static_cast<uint32_t>(q) << shift) | half_step);
+}
+
+bool isMulticast(const in_addr& address) {
+    return (ntohl(address.s_addr) & 0xF0000000u) == 0xE0000000u;
+}
+
+bool parseAddress(const std::string& text, in_addr& address) {
+    return inet_pton(AF_INET, text.c_str(), &address) == 1;
+}
+
+std::string socketError(const std::string& what) {
+#ifdef _WIN32
+    return what + " failed (WSA error " + std::to_string(WSAGetLastError()) + ")";
+#else
+    return what + " failed: " + std::strerror(errno);
+#endif
+}
+
+bool wouldBlock() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+// Creates a non-blocking UDP socket; -1 on failure
+intptr_t openUdpSocket(std::string& error) {
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        error = "WSAStartup failed";
+        return -1;
+    }
+    SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET) {
+        error = socketError("socket()");
+        WSACleanup();
+        return -1;
+    }
+    u_long non_blocking = 1;
+    ioctlsocket(s, FIONBIO, &non_blocking);
+    return static_cast<intptr_t>(s);
+#else
+    int s = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s < 0) {
+        error = socketError("socket()");
+        return -1;
+    }
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+    return s;
+#endif
+}
+
+void closeUdpSocket(intptr_t s) {
+#ifdef _WIN32
+    closesocket(static_cast<SOCKET>(s));
+    WSACleanup();
+#else
+    ::close(static_cast<int>(s));
+#endif
+}
+
+} // namespace
+
+// ============================================================================
+// ColumnStreamEncoder
+// ============================================================================
+
+ColumnStreamEncoder::ColumnStreamEncoder(uint32_t keyframe_interval, uint32_t level_bits)
+    : keyframe_interval_(keyframe_interval)
+    , level_bits_(level_bits)
+{
+    if (keyframe_interval == 0) {
+        throw std::invalid_argument("Keyframe interval must be > 0");
+    }
+    if (level_bits < 8 || level_bits > 16) {
+        throw std::invalid_argument("Stream level_bits must be 8 to 16");
+    }
+}
+
+void ColumnStreamEncoder::setFormat(const RecordingHeader& header) {
+    if (header.height == 0 || header.height > 0xFFFF) {
+        throw std::invalid_argument("Stream height must be 1 to 65535");
+    }
+    format_ = header;
+    format_.level_bits = level_bits_;
+    format_.columns_per_chunk = 0;
+    format_.start_time_ms = 0;
+    ++generation_;
+
+    // Worst case every row is a full-range delta: (bits + 2) significant bits per varint
+    const size_t token_bytes = (level_bits_ + 2 + 6) / 7;
+    const size_t max_rows = (MAX_DATAGRAM - HEADER_BYTES - FORMAT_BYTES) / token_bytes;
+    const size_t slices = (header.height + max_rows - 1) / max_rows;
+    rows_per_packet_ = (header.height + slices - 1) / slices;
+
+    previous_.assign(header.height, 0);
+    next_keyframe_ = sequence_;
+}
+
+const std::vector<std::vector<uint8_t>>& ColumnStreamEncoder::encode(const uint16_t* levels,
+                                                                     int64_t timestamp_ms) {
+    if (!hasFormat()) {
+        throw std::logic_error("ColumnStreamEncoder::encode() before setFormat()");
+    }
+
+    const bool keyframe = sequence_ == next_keyframe_;
+    if (keyframe) {
+        std::fill(previous_.begin(), previous_.end(), uint16_t{0});
+        next_keyframe_ = sequence_ + keyframe_interval_;
+    }
+    const uint8_t flags = keyframe ? (FLAG_KEYFRAME | FLAG_FORMAT) : 0;
+
+    const size_t height = format_.height;
+    const size_t slices = (height + rows_per_packet_ - 1) / rows_per_packet_;
+    datagrams_.resize(slices);
+
+    for (size_t slice = 0; slice < slices; ++slice) {
+        const size_t first_row = slice * rows_per_packet_;
+        const size_t row_count = std::min(rows_per_packet_, height - first_row);
+        std::vector<uint8_t>& out = datagrams_[slice];
+        // resize + memcpy: inserting the array trips -Wstringop-overflow at -O2
+        out.resize(sizeof(PACKET_MAGIC));
+        std::memcpy(out.data(), PACKET_MAGIC, sizeof(PACKET_MAGIC));
+        out.push_back(PACKET_VERSION);
+        out.push_back(flags);
+        out.push_back(generation_);
+        out.push_back(static_cast<uint8_t>(level_bits_));
+        putU32(out, static_cast<uint32_t>(sequence_));
+        putU64(out, static_cast<uint64_t>(timestamp_ms));
+        putU16(out, static_cast<uint16_t>(first_row));
+        putU16(out, static_cast<uint16_t>(row_count));
+
+        if (flags & FLAG_FORMAT) {
+            putU32(out, format_.fft_size);
+            putU32(out, format_.hop_size);
+            putF32(out, format_.sample_rate);
+            putF32(out, format_.min_freq);
+            putF32(out, format_.max_freq);
+            putU32(out, format_.height);
+            putU32(out, static_cast<uint32_t>(format_.scale));
+            putU32(out, 0);
+        }
+
+        // Deltas against the previous column; unchanged values become zero runs
+        uint64_t zero_run = 0;
+        for (size_t i = first_row; i < first_row + row_count; ++i) {
+            const uint16_t q = quantize(levels[i], level_bits_);
+            const int32_t delta = static_cast<int32_t>(q) - static_cast<int32_t>(previous_[i]);
+            previous_[i] = q;
+            if (delta == 0) {
+                ++zero_run;
+                continue;
+            }
+            if (zero_run > 0) {
+                putVarint(out, (zero_run << 1) | 1);
+                zero_run = 0;
+            }
+            const uint64_t zigzag = delta < 0 ? (static_cast<uint64_t>(-delta) << 1) - 1
+                                              : static_cast<uint64_t>(delta) << 1;
+            putVarint(out, zigzag << 1);
+        }
+        if (zero_run > 0) {
+            putVarint(out, (zero_run << 1) | 1);
+        }
+    }
+
+    ++sequence_;
+    return datagrams_;
+}
+
+// ============================================================================
+// ColumnStreamDecoder
+// ============================================================================
+
+void ColumnStreamDecoder::reset(const RecordingHeader& format, uint8_t generation) {
+    format_ = format;
+    generation_ = generation;
+    rows_.assign(format.height, 0);
+    row_sequence_.assign(format.height, 0);
+    column_.assign(format.height, 0);
+    current_rows_ = 0;
+    have_completed_ = false;
+}
+
+bool ColumnStreamDecoder::feed(const uint8_t* data, size_t size) {
+    constexpr size_t HEADER_BYTES = ColumnStreamEncoder::HEADER_BYTES;
+    constexpr size_t FORMAT_BYTES = ColumnStreamEncoder::FORMAT_BYTES;
+
+    if (size < HEADER_BYTES || std::memcmp(data, PACKET_MAGIC, sizeof(PACKET_MAGIC)) != 0 ||
+        data[4] != PACKET_VERSION) {
+        ++rejected_;
+        return false;
+    }
+    const uint8_t flags = data[5];
+    const uint8_t generation = data[6];
+    const uint32_t level_bits = data[7];
+    const uint32_t sequence = readU32(data + 8);
+    const int64_t timestamp_ms = static_cast<int64_t>(readU64(data + 12));
+    const size_t first_row = readU16(data + 20);
+    const size_t row_count = readU16(data + 22);
+    const bool keyframe = (flags & ColumnStreamEncoder::FLAG_KEYFRAME) != 0;
+    const uint8_t* p = data + HEADER_BYTES;
+    const uint8_t* end = data + size;
+
+    if (level_bits < 8 || level_bits > 16) {
+        ++rejected_;
+        return false;
+    }
+
+    if (flags & ColumnStreamEncoder::FLAG_FORMAT) {
+        if (size < HEADER_BYTES + FORMAT_BYTES) {
+            ++rejected_;
+            return false;
+        }
+        RecordingHeader format;
+        format.fft_size = readU32(p);
+        format.hop_size = readU32(p + 4);
+        format.sample_rate = readF32(p + 8);
+        format.min_freq = readF32(p + 12);
+        format.max_freq = readF32(p + 16);
+        format.height = readU32(p + 20);
+        const uint32_t scale = readU32(p + 24);
+        format.level_bits = level_bits;
+        format.columns_per_chunk = 0;
+        p += FORMAT_BYTES;
+
+        if (format.height == 0 || format.height > 0xFFFF ||
+            scale > static_cast<uint32_t>(FrequencyScale::Octave)) {
+            ++rejected_;
+            return false;
+        }
+        format.scale = static_cast<FrequencyScale>(scale);
+        if (!hasFormat() || generation != generation_ || !format.sameFormat(format_)) {
+            reset(format, generation);
+        }
+    }
+
+    // Deltas need the format they were coded in
+    if (!hasFormat() || generation != generation_ || level_bits != format_.level_bits ||
+        row_count == 0 || first_row + row_count > format_.height) {
+        ++rejected_;
+        return false;
+    }
+
+    // Slices of an older column arrive too late to be shown
+    if ((have_completed_ && static_cast<int32_t>(sequence - completed_sequence_) <= 0) ||
+        (current_rows_ > 0 && static_cast<int32_t>(sequence - current_sequence_) < 0)) {
+        ++rejected_;
+        return false;
+    }
+    if (sequence != current_sequence_) {
+        current_sequence_ = sequence;
+        current_rows_ = 0;
+    }
+
+    // Duplicate slice
+    if (row_sequence_[first_row] == sequence + 1) {
+        return false;
+    }
+    // A delta slice needs every row from the previous column
+    if (!keyframe) {
+        for (size_t i = first_row; i < first_row + row_count; ++i) {
+            if (row_sequence_[i] != sequence) {
+                ++rejected_;
+                return false;
+            }
+        }
+    }
+
+    // Decode in place only after the whole slice checks out
+    decoded_.resize(row_count);
+    const uint32_t max_q = (1u << level_bits) - 1;
+    size_t n = 0;
+    while (n < row_count) {
+        uint64_t token;
+        if (!readVarint(p, end, token)) {
+            break;
+        }
+        if (token & 1) {
+            const uint64_t run = token >> 1;
+            if (run == 0 || run > row_count - n) {
+                break;
+            }
+            for (uint64_t r = 0; r < run; ++r, ++n) {
+                decoded_[n] = keyframe ? 0 : rows_[first_row + n];
+            }
+        } else {
+            const uint64_t zigzag = token >> 1;
+            const int64_t delta = (zigzag & 1) ? -static_cast<int64_t>((zigzag + 1) >> 1)
+                                               : static_cast<int64_t>(zigzag >> 1);
+            const int64_t q = (keyframe ? 0 : rows_[first_row + n]) + delta;
+            if (q < 0 || q > static_cast<int64_t>(max_q)) {
+                break;
+            }
+            decoded_[n++] = static_cast<uint16_t>(q);
+        }
+    }
+    if (n != row_count || p != end) {
+        ++rejected_;
+        return false;
+    }
+
+    std::copy(decoded_.begin(), decoded_.end(), rows_.begin() + static_cast<std::ptrdiff_t>(first_row));
+    std::fill_n(row_sequence_.begin() + static_cast<std::ptrdiff_t>(first_row), row_count, sequence + 1);
+    current_rows_ += row_count;
+    if (current_rows_ < format_.height) {
+        return false;
+    }
+
+    for (size_t i = 0; i < column_.size(); ++i) {
+        column_[i] = dequantize(rows_[i], format_.level_bits);
+    }
+    if (have_completed_) {
+        lost_columns_ += sequence - completed_sequence_ - 1;
+    }
+    have_completed_ = true;
+    completed_sequence_ = sequence;
+    timestamp_ms_ = timestamp_ms;
+    current_rows_ = 0;
+    ++columns_;
+    return true;
+}
+
+// ============================================================================
+// ColumnStreamSender
+// ============================================================================
+
+ColumnStreamSender::ColumnStreamSender(const Options& options)
+    : options_(options)
+    , encoder_(options.keyframe_interval, options.level_bits)
+{
+    if (!(options.max_columns_per_second > 0.0f)) {
+        throw std::invalid_argument("Stream column rate must be > 0");
+    }
+}
+
+ColumnStreamSender::~ColumnStreamSender() {
+    close();
+}
+
+bool ColumnStreamSender::open(const std::string& address, uint16_t port) {
+    close();
+
+    sockaddr_in destination{};
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(port);
+    if (!parseAddress(address, destination.sin_addr)) {
+        error_ = "Invalid IPv4 address: " + address;
+        return false;
+    }
+
+    socket_ = openUdpSocket(error_);
+    if (socket_ < 0) {
+        return false;
+    }
+    if (isMulticast(destination.sin_addr)) {
+#ifdef _WIN32
+        DWORD ttl = static_cast<DWORD>(options_.multicast_ttl);
+        setsockopt(static_cast<SOCKET>(socket_), IPPROTO_IP, IP_MULTICAST_TTL,
+                   reinterpret_cast<const char*>(&ttl), sizeof(ttl));
+#else
+        unsigned char ttl = static_cast<unsigned char>(options_.multicast_ttl);
+        setsockopt(static_cast<int>(socket_), IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+#endif
+    }
+
+    static_assert(sizeof(destination_) >= sizeof(sockaddr_in));
+    std::memcpy(destination_, &destination, sizeof(destination));
+    bytes_sent_ = 0;
+    dropped_packets_ = 0;
+    error_.clear();
+    return true;
+}
+
+void ColumnStreamSender::close() {
+    if (socket_ >= 0) {
+        closeUdpSocket(socket_);
+        socket_ = -1;
+    }
+}
+
+bool ColumnStreamSender::setFormat(const RecordingHeader& header) {
+    if (header.height == 0 || header.height > 0xFFFF) {
+        error_ = "Stream height must be 1 to 65535";
+        return false;
+    }
+    if (header.hop_size == 0 || !(header.sample_rate > 0.0f)) {
+        error_ = "Stream needs a hop size and sample rate";
+        return false;
+    }
+
+    const double column_rate = header.sample_rate / static_cast<double>(header.hop_size);
+    decimation_ = static_cast<uint32_t>(
+        std::max(1.0, std::ceil(column_rate / options_.max_columns_per_second - 1e-9)));
+
+    RecordingHeader sent = header;
+    sent.hop_size = header.hop_size * decimation_;
+    encoder_.setFormat(sent);
+
+    pending_.assign(header.height, 0);
+    pending_count_ = 0;
+    return true;
+}
+
+bool ColumnStreamSender::push(const uint16_t* levels, size_t height) {
+    if (!isOpen() || !encoder_.hasFormat() || height != encoder_.getFormat().height) {
+        return false;
+    }
+
+    // Peak of the combined columns, so short events stay visible
+    for (size_t i = 0; i < height; ++i) {
+        pending_[i] = std::max(pending_[i], levels[i]);
+    }
+    if (++pending_count_ < decimation_) {
+        return false;
+    }
+
+    const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const auto& datagrams = encoder_.encode(pending_.data(), now_ms);
+    std::fill(pending_.begin(), pending_.end(), uint16_t{0});
+    pending_count_ = 0;
+
+    for (const auto& datagram : datagrams) {
+#ifdef _WIN32
+        const int sent = sendto(static_cast<SOCKET>(socket_),
+                                reinterpret_cast<const char*>(datagram.data()),
+                                static_cast<int>(datagram.size()), 0,
+                                reinterpret_cast<const sockaddr*>(destination_), sizeof(sockaddr_in));
+#else
+        const ssize_t sent = sendto(static_cast<int>(socket_), datagram.data(), datagram.size(), 0,
+                                    reinterpret_cast<const sockaddr*>(destination_), sizeof(sockaddr_in));
+#endif
+        if (sent == static_cast<std::remove_cv_t<decltype(sent)>>(datagram.size())) {
+            bytes_sent_ += datagram.size();
+        } else {
+            ++dropped_packets_;
+            if (!wouldBlock()) {
+                error_ = socketError("sendto()");
+            }
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// ColumnStreamReceiver
+// ============================================================================
+
+ColumnStreamReceiver::~ColumnStreamReceiver() {
+    close();
+}
+
+bool ColumnStreamReceiver::open(const std::string& address, uint16_t port) {
+    close();
+
+    in_addr group{};
+    if (!parseAddress(address, group)) {
+        error_ = "Invalid IPv4 address: " + address;
+        return false;
+    }
+    const bool multicast = isMulticast(group);
+
+    socket_ = openUdpSocket(error_);
+    if (socket_ < 0) {
+        return false;
+    }
+
+    // Several viewers on one host share a multicast port
+    int reuse = 1;
+#ifdef _WIN32
+    const SOCKET s = static_cast<SOCKET>(socket_);
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+#else
+    const int s = static_cast<int>(socket_);
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = multicast ? htonl(INADDR_ANY) : group.s_addr;
+    if (bind(s, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) {
+        error_ = socketError("bind()");
+        close();
+        return false;
+    }
+
+    if (multicast) {
+        ip_mreq membership{};
+        membership.imr_multiaddr = group;
+        membership.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (setsockopt(s, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                       reinterpret_cast<const char*>(&membership), sizeof(membership)) != 0) {
+            error_ = socketError("Joining " + address);
+            close();
+            return false;
+        }
+    }
+
+    buffer_.resize(MAX_RECEIVE);
+    decoder_ = ColumnStreamDecoder();
+    bytes_received_ = 0;
+    error_.clear();
+    return true;
+}
+
+void ColumnStreamReceiver::close() {
+    if (socket_ >= 0) {
+        closeUdpSocket(socket_);
+        socket_ = -1;
+    }
+}
+
+bool ColumnStreamReceiver::poll() {
+    while (isOpen()) {
+#ifdef _WIN32
+        const int received = recv(static_cast<SOCKET>(socket_),
+                                  reinterpret_cast<char*>(buffer_.data()),
+                                  static_cast<int>(buffer_.size()), 0);
+#else
+        const ssize_t received = recv(static_cast<int>(socket_), buffer_.data(), buffer_.size(), 0);
+#endif
+        if (received < 0) {
+            if (!wouldBlock()) {
+                error_ = socketError("recv()");
+            }
+            return false;
+        }
+        bytes_received_ += static_cast<uint64_t>(received);
+        if (decoder_.feed(buffer_.data(), static_cast<size_t>(received))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace friture
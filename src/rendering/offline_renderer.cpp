@@ -0,0 +1,383 @@
+/**
+ * @file offline_renderer.cpp
+ * @brief Implementation of OfflineRenderer
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/offline_renderer.hpp>
+#include <friture/frequency_resampler.hpp>
+#include <friture/settings.hpp>
+#include <friture/simd_kernels.hpp>
+#include <friture/task_pool.hpp>
+#include <friture/audio/wav_reader.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace friture {
+
+namespace {
+
+// Summary levels below this power are reported as -300 dB
+constexpr double SUMMARY_POWER_FLOOR = 1e-30;
+
+float powerToDb(double power) {
+    return static_cast<float>(10.0 * std::log10(std::max(power, SUMMARY_POWER_FLOOR)));
+}
+
+/**
+ * @brief Read samples, padding whatever the source does not produce with silence
+ */
+void readPadded(const OfflineRenderer::Source& source, uint64_t position,
+                float* output, size_t count) {
+    size_t got = std::min(source(position, output, count), count);
+    std::fill(output + got, output + count, 0.0f);
+}
+
+} // namespace
+
+/**
+ * @brief Per-worker stages, built on the worker's first chunk
+ */
+struct OfflineRenderer::WorkerStages {
+    FFTProcessor fft;
+    FrequencyResampler resampler;
+    FrequencyResampler::BinRange range;
+    std::vector<float> input;
+    std::vector<float> spectra;
+    std::vector<float> resampled;
+
+    // Summary accumulators (this worker's columns of the current render)
+    std::vector<float> power;        ///< One column in linear power
+    std::vector<double> power_sum;   ///< Per-bin power summed over columns
+    float max_db;                    ///< Highest bin level seen
+
+    WorkerStages(const OfflineRenderOptions& options, float sample_rate, float max_freq)
+        : fft(options.fft_size, options.window, options.kaiser_beta),
+          resampler(options.scale, options.min_freq, max_freq, sample_rate,
+                    options.fft_size, options.height, options.aggregation),
+          range(resampler.getInputRange()),
+          input(BATCH_COLUMNS * options.fft_size),
+          spectra(BATCH_COLUMNS * (options.fft_size / 2 + 1)),
+          resampled(options.height),
+          power(options.fft_size / 2 + 1),
+          power_sum(options.fft_size / 2 + 1, 0.0),
+          max_db(-std::numeric_limits<float>::infinity()) {
+        resampler.setWeighting(options.weighting);
+    }
+
+    void resetSummary() {
+        std::fill(power_sum.begin(), power_sum.end(), 0.0);
+        max_db = -std::numeric_limits<float>::infinity();
+    }
+};
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+OfflineRenderer::OfflineRenderer(const OfflineRenderOptions& options)
+    : options_(options),
+      color_transform_(options.theme),
+      stages_sample_rate_(0.0f),
+      stages_max_freq_(0.0f)
+{
+    const size_t n = options.fft_size;
+    if (n < 32 || n > 16384 || (n & (n - 1)) != 0) {
+        throw std::invalid_argument("FFT size must be a power of 2 in [32, 16384]");
+    }
+    if (options.height == 0) {
+        throw std::invalid_argument("Image height must be > 0");
+    }
+    if (!(options.overlap_percent >= 0.0f &&
+          options.overlap_percent <= SpectrogramSettings::MAX_OVERLAP_PERCENT)) {
+        throw std::invalid_argument("Overlap must be in [0, 99.9] percent");
+    }
+    if (options.min_db >= options.max_db) {
+        throw std::invalid_argument("min_db must be < max_db");
+    }
+    if (!(options.kaiser_beta >= 0.0f && options.kaiser_beta <= MAX_KAISER_BETA)) {
+        throw std::invalid_argument("Kaiser beta must be in [0, MAX_KAISER_BETA]");
+    }
+}
+
+OfflineRenderer::~OfflineRenderer() = default;
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+size_t OfflineRenderer::hopSizeFor(uint64_t length) const {
+    SpectrogramSettings settings;
+    settings.fft_size = options_.fft_size;
+    settings.overlap_percent = options_.overlap_percent;
+    size_t hop = settings.getSamplesPerColumn();
+
+    if (options_.max_width == 0 || length < options_.fft_size) {
+        return hop;
+    }
+
+    // Smallest hop with span / hop + 1 <= max_width
+    const uint64_t span = length - options_.fft_size;
+    if (span / hop + 1 > options_.max_width) {
+        hop = static_cast<size_t>(span / options_.max_width + 1);
+    }
+    return hop;
+}
+
+uint64_t OfflineRenderer::imageBytesFor(uint64_t length) const {
+    if (length < options_.fft_size) {
+        return 0;
+    }
+    const uint64_t columns = (length - options_.fft_size) / hopSizeFor(length) + 1;
+    return columns * options_.height * sizeof(uint32_t);
+}
+
+std::unique_ptr<SpectrogramImage> OfflineRenderer::render(const Source& source, uint64_t length,
+                                                          float sample_rate,
+                                                          OfflineRenderStats* stats,
+                                                          OfflineRenderSummary* summary) {
+    std::vector<uint32_t> colors;
+    const uint64_t columns = renderColumns(source, length, sample_rate, colors, stats, summary);
+
+    // One column per frame: the whole file is the visible window
+    const size_t height = options_.height;
+    auto image = std::make_unique<SpectrogramImage>(static_cast<size_t>(columns), height);
+    for (uint64_t c = 0; c < columns; ++c) {
+        image->addColumn(colors.data() + c * height, height);
+    }
+    return image;
+}
+
+uint64_t OfflineRenderer::renderColumns(const Source& source, uint64_t length, float sample_rate,
+                                        std::vector<uint32_t>& colors,
+                                        OfflineRenderStats* stats,
+                                        OfflineRenderSummary* summary) {
+    const size_t fft_size = options_.fft_size;
+    const size_t height = options_.height;
+    if (length < fft_size) {
+        throw std::invalid_argument("Input is shorter than one FFT frame");
+    }
+    if (sample_rate <= 0.0f) {
+        throw std::invalid_argument("Sample rate must be > 0");
+    }
+
+    const size_t hop = hopSizeFor(length);
+    const uint64_t columns = (length - fft_size) / hop + 1;
+
+    const float max_freq = options_.max_freq > 0.0f ? options_.max_freq : sample_rate / 2.0f;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Pool and stages outlive the render; stages follow the source's rate
+    if (!pool_) {
+        pool_ = std::make_unique<TaskPool>(options_.threads);
+        stages_.resize(pool_->getThreadCount());
+    }
+    if (sample_rate != stages_sample_rate_ || max_freq != stages_max_freq_) {
+        for (auto& stage : stages_) {
+            stage.reset();
+        }
+        stages_sample_rate_ = sample_rate;
+        stages_max_freq_ = max_freq;
+    }
+    if (summary) {
+        for (auto& stage : stages_) {
+            if (stage) {
+                stage->resetSummary();
+            }
+        }
+    }
+
+    // Batches are stolen between workers and rendered straight into their
+    // slice of one column-major color matrix; an invalid frequency range
+    // throws from the first worker's stages and is rethrown here
+    colors.assign(static_cast<size_t>(columns) * height, 0);
+    pool_->parallelFor(static_cast<size_t>(columns), BATCH_COLUMNS,
+                       [&](size_t worker, size_t begin, size_t end) {
+        if (!stages_[worker]) {
+            stages_[worker] = std::make_unique<WorkerStages>(options_, sample_rate, max_freq);
+        }
+        renderSegment(*stages_[worker], source, hop, begin, end - begin,
+                      colors.data() + begin * height, summary != nullptr);
+    });
+
+    if (summary) {
+        summarize(columns, sample_rate, *summary);
+    }
+
+    if (stats) {
+        // A file shorter than the pool has batches keeps the rest idle
+        const uint64_t batches = (columns + BATCH_COLUMNS - 1) / BATCH_COLUMNS;
+        stats->columns = columns;
+        stats->hop_size = hop;
+        stats->threads = static_cast<size_t>(std::min<uint64_t>(pool_->getThreadCount(), batches));
+        stats->seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+    return columns;
+}
+
+void OfflineRenderer::renderSegment(WorkerStages& stages, const Source& source,
+                                    size_t hop, uint64_t first, uint64_t count,
+                                    uint32_t* colors, bool summarize) const {
+    const size_t fft_size = options_.fft_size;
+    const size_t height = options_.height;
+    const size_t num_bins = fft_size / 2 + 1;
+    FFTProcessor& fft = stages.fft;
+    FrequencyResampler& resampler = stages.resampler;
+    const FrequencyResampler::BinRange range = stages.range;
+    std::vector<float>& input = stages.input;
+    std::vector<float>& spectra = stages.spectra;
+    std::vector<float>& resampled = stages.resampled;
+
+    // Overlapping frames are read as one span; with a hop wider than the
+    // frame, frames are packed back to back so gaps are never decoded
+    // (input holds BATCH_COLUMNS frames either way)
+    const bool overlapping = hop <= fft_size;
+    const size_t stride = overlapping ? hop : fft_size;
+
+    for (uint64_t done = 0; done < count; ) {
+        const size_t frames = static_cast<size_t>(std::min<uint64_t>(BATCH_COLUMNS, count - done));
+        const uint64_t position = (first + done) * hop;
+
+        // Every frame ends inside the source (columns were counted that way)
+        if (overlapping) {
+            readPadded(source, position, input.data(), (frames - 1) * hop + fft_size);
+        } else {
+            for (size_t f = 0; f < frames; ++f) {
+                readPadded(source, position + f * hop, input.data() + f * fft_size, fft_size);
+            }
+        }
+
+        // The summary covers every bin, the image only the displayed ones
+        fft.processBatch(input.data(), stride, frames, spectra.data(), num_bins,
+                         summarize ? 0 : range.first, summarize ? num_bins : range.end);
+
+        for (size_t f = 0; f < frames; ++f) {
+            const float* spectrum = spectra.data() + f * num_bins;
+            if (summarize) {
+                simd::dbToPower(spectrum, stages.power.data(), num_bins);
+                for (size_t b = 0; b < num_bins; ++b) {
+                    stages.power_sum[b] += stages.power[b];
+                    stages.max_db = std::max(stages.max_db, spectrum[b]);
+                }
+            }
+            resampler.resample(spectrum, resampled.data());
+            color_transform_.transformColumnDb(resampled.data(), height,
+                                               options_.min_db, options_.max_db,
+                                               colors + (done + f) * height);
+        }
+        done += frames;
+    }
+}
+
+void OfflineRenderer::summarize(uint64_t columns, float sample_rate,
+                                OfflineRenderSummary& summary) const {
+    const size_t num_bins = options_.fft_size / 2 + 1;
+    const double bin_hz = static_cast<double>(sample_rate) / static_cast<double>(options_.fft_size);
+    const double nyquist = sample_rate / 2.0;
+
+    // Mean power per bin over all workers' columns
+    std::vector<double> mean(num_bins, 0.0);
+    summary.max_db = -std::numeric_limits<float>::infinity();
+    for (const auto& stage : stages_) {
+        if (!stage) {
+            continue;
+        }
+        for (size_t b = 0; b < num_bins; ++b) {
+            mean[b] += stage->power_sum[b];
+        }
+        summary.max_db = std::max(summary.max_db, stage->max_db);
+    }
+    double total = 0.0;
+    for (double& power : mean) {
+        power /= static_cast<double>(columns);
+        total += power;
+    }
+    summary.mean_db = powerToDb(total);
+
+    // Octave bands [fc / √2, fc × √2), the last one cut at Nyquist
+    summary.band_centers.clear();
+    summary.band_db.clear();
+    for (size_t k = 0; k < OfflineRenderSummary::MAX_BANDS; ++k) {
+        const double center = OfflineRenderSummary::FIRST_BAND_CENTER * std::ldexp(1.0, static_cast<int>(k));
+        const double low = center / std::sqrt(2.0);
+        if (low >= nyquist) {
+            break;
+        }
+        const size_t first = static_cast<size_t>(std::ceil(low / bin_hz));
+        const size_t end = std::min(num_bins, static_cast<size_t>(std::ceil(center * std::sqrt(2.0) / bin_hz)));
+        double band = 0.0;
+        for (size_t b = first; b < end; ++b) {
+            band += mean[b];
+        }
+        summary.band_centers.push_back(static_cast<float>(center));
+        summary.band_db.push_back(powerToDb(band));
+    }
+
+    // Strongest local maxima, refined by a parabola through the dB levels
+    std::vector<float> level(num_bins);
+    for (size_t b = 0; b < num_bins; ++b) {
+        level[b] = powerToDb(mean[b]);
+    }
+    std::vector<size_t> maxima;
+    for (size_t b = 1; b + 1 < num_bins; ++b) {
+        if (level[b] > level[b - 1] && level[b] >= level[b + 1]) {
+            maxima.push_back(b);
+        }
+    }
+    const size_t count = std::min(options_.summary_peaks, maxima.size());
+    std::partial_sort(maxima.begin(), maxima.begin() + count, maxima.end(),
+                      [&level](size_t a, size_t b) { return level[a] > level[b]; });
+    summary.peaks.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const size_t b = maxima[i];
+        const float left = level[b - 1];
+        const float center = level[b];
+        const float right = level[b + 1];
+        const float curvature = left - 2.0f * center + right;
+        const float delta = curvature < 0.0f ? 0.5f * (left - right) / curvature : 0.0f;
+        OfflineSpectrumPeak peak;
+        peak.frequency = static_cast<float>((static_cast<double>(b) + delta) * bin_hz);
+        peak.level_db = center - 0.25f * (left - right) * delta;
+        summary.peaks.push_back(peak);
+    }
+}
+
+bool OfflineRenderer::renderFile(const char* input_path, const char* output_path,
+                                 OfflineRenderStats* stats, OfflineRenderSummary* summary) {
+    WavReader reader;
+    if (!reader.open(input_path)) {
+        error_ = reader.getError();
+        return false;
+    }
+
+    // Written straight from the color matrix: one copy of the image per file
+    std::vector<uint32_t> colors;
+    uint64_t columns = 0;
+    try {
+        const WavReader& source = reader;
+        columns = renderColumns([&source](uint64_t position, float* output, size_t count) {
+            return source.readMono(position, output, count);
+        }, reader.getFrameCount(), reader.getSampleRate(), colors, stats, summary);
+    } catch (const std::exception& e) {
+        error_ = e.what();
+        return false;
+    }
+
+    if (!SpectrogramImage::saveColumnsToBMP(output_path, colors.data(),
+                                            static_cast<size_t>(columns), options_.height)) {
+        error_ = std::string("Failed to write ") + output_path;
+        return false;
+    }
+    return true;
+}
+
+} // namespace friture
@@ -0,0 +1,194 @@
+/**
+ * @file replay_harness.cpp
+ * @brief Implementation of ReplayHarness
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/replay_harness.hpp>
+#include <friture/peak_detector.hpp>
+#include <friture/processing_chain.hpp>
+#include <friture/ringbuffer.hpp>
+#include <friture/spectral_averager.hpp>
+#include <friture/audio/wav_reader.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace friture {
+
+namespace {
+
+constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+} // namespace
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+ReplayHarness::ReplayHarness(const ReplayOptions& options)
+    : options_(options)
+{
+    if (options.height == 0) {
+        throw std::invalid_argument("Column height must be > 0");
+    }
+    if (options.block_frames == 0) {
+        throw std::invalid_argument("Block size must be > 0");
+    }
+}
+
+ReplayHarness::~ReplayHarness() = default;
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+uint64_t ReplayHarness::hashColumn(uint64_t hash, const float* column_db, size_t rows) {
+    // Little-endian bytes of each bit pattern, whatever the host order
+    for (size_t r = 0; r < rows; ++r) {
+        uint32_t bits;
+        std::memcpy(&bits, &column_db[r], sizeof(bits));
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash = (hash ^ ((bits >> shift) & 0xffu)) * FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+ReplayStats ReplayHarness::replay(const Source& source, uint64_t length, float sample_rate,
+                                  const ColumnCallback& on_column) {
+    SpectrogramSettings settings = options_.settings;
+    if (!settings.setSampleRate(sample_rate) || !settings.isValid()) {
+        throw std::invalid_argument("Analysis settings are invalid at the input sample rate");
+    }
+
+    // A fresh chain per replay: sliding and zoom state starts from silence
+    const ChainKey key = ChainKey::fromSettings(settings, options_.height);
+    ProcessingChain chain(key, std::make_shared<FFTProcessor>(key.fft_size, key.window, key.kaiser_beta));
+    const size_t window = chain.getWindowSize();
+    const size_t hop = chain.getHopSize();
+    const size_t rows = chain.resampled.size();
+    const size_t block_frames = options_.block_frames;
+
+    std::unique_ptr<SpectralAverager> averager;
+    if (settings.averaging != AveragingMode::None || settings.column_decimation > 1) {
+        SpectralAverager::Options averaging;
+        averaging.mode = settings.averaging;
+        averaging.time_seconds = settings.averaging_time;
+        averaging.frames = settings.averaging_frames;
+        averaging.decimation = settings.column_decimation;
+        averager = std::make_unique<SpectralAverager>(rows, sample_rate, hop, averaging);
+    }
+    std::unique_ptr<PeakDetector> detector;
+    if (options_.peak_detection) {
+        detector = std::make_unique<PeakDetector>(key.fft_size, sample_rate, hop);
+    }
+
+    // Every complete window is read right after the block that completed
+    // it, so the ring never holds more than one window and one block
+    RingBuffer<float> ring(window + hop + block_frames);
+    RingBuffer<float>::Cursor cursor;
+    std::vector<float> block(block_frames);
+    std::vector<float> averaged(rows);
+    StageProfiler profiler;
+
+    ReplayStats stats;
+    stats.rows = rows;
+    stats.hop_size = hop;
+    stats.sample_rate = sample_rate;
+    stats.hash = HASH_SEED;
+    auto count_event = [&stats](const PeakEvent&) { ++stats.peak_events; };
+
+    // Wall time includes fetching the blocks from the source, as the
+    // stage timings do not
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t position = 0; position < length; ) {
+        // One virtual audio callback
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(block_frames, length - position));
+        const size_t got = std::min(source(position, block.data(), count), count);
+        std::fill(block.data() + got, block.data() + count, 0.0f);
+        ring.write(block.data(), count);
+        position += count;
+
+        for (;;) {
+            const uint64_t read_start = StageProfiler::now();
+            if (ring.readWindow(cursor, chain.fft_input.data(), window, hop) == ReadStatus::NotReady) {
+                break;
+            }
+            profiler.record(ProfileStage::Read, read_start, StageProfiler::now() - read_start);
+            const uint64_t window_end = cursor.position() - hop + window;
+            ++stats.hops;
+
+            if (chain.analyze(profiler)) {
+                if (detector) {
+                    const FrequencyResampler::BinRange range = chain.resampler().getInputRange();
+                    detector->process(chain.fft_output.data(), range.first, range.end, window_end);
+                    detector->drainEvents(count_event);
+                }
+                ScopedStageTimer timer(profiler, ProfileStage::Resample);
+                chain.resampler().resample(chain.fft_output.data(), chain.resampled.data());
+            }
+
+            const float* column = chain.resampled.data();
+            if (averager) {
+                ScopedStageTimer timer(profiler, ProfileStage::Resample);
+                if (!averager->process(column, averaged.data())) {
+                    continue;   // Folded into a later column
+                }
+                column = averaged.data();
+            }
+
+            stats.hash = hashColumn(stats.hash, column, rows);
+            ++stats.columns;
+            if (on_column) {
+                on_column(window_end, column, rows);
+            }
+        }
+    }
+    if (detector) {
+        detector->finish(length);
+        detector->drainEvents(count_event);
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.audio_seconds = static_cast<double>(length) / sample_rate;
+    stats.stages = profiler.getSnapshot();
+    return stats;
+}
+
+ReplayStats ReplayHarness::replay(const float* samples, size_t count, float sample_rate,
+                                  const ColumnCallback& on_column) {
+    return replay([samples, count](uint64_t position, float* output, size_t frames) {
+        frames = static_cast<size_t>(std::min<uint64_t>(frames, count - position));
+        std::copy(samples + position, samples + position + frames, output);
+        return frames;
+    }, count, sample_rate, on_column);
+}
+
+bool ReplayHarness::replayFile(const char* path, ReplayStats& stats, const ColumnCallback& on_column) {
+    WavReader reader;
+    if (!reader.open(path)) {
+        error_ = reader.getError();
+        return false;
+    }
+
+    try {
+        // Decoded pages behind the virtual clock are handed back
+        stats = replay([&reader](uint64_t position, float* output, size_t count) {
+            size_t frames = reader.readMono(position, output, count);
+            reader.releaseBefore(position + frames);
+            return frames;
+        }, reader.getFrameCount(), reader.getSampleRate(), on_column);
+    } catch (const std::exception& e) {
+        error_ = e.what();
+        return false;
+    }
+    return true;
+}
+
+} // namespace friture
@@ -0,0 +1,47 @@
+/**
+ * @file row_resampler.cpp
+ * @brief Implementation of RowResampler
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/row_resampler.hpp>
+#include <stdexcept>
+
+namespace friture {
+
+RowResampler::RowResampler(size_t input_rows, size_t output_rows)
+    : input_rows_(input_rows),
+      pooling_(input_rows > output_rows)
+{
+    if (input_rows == 0 || output_rows == 0) {
+        throw std::invalid_argument("Row counts must be > 0");
+    }
+
+    taps_.resize(output_rows);
+    nearest_.resize(output_rows);
+    const double scale = static_cast<double>(input_rows) / static_cast<double>(output_rows);
+
+    for (size_t r = 0; r < output_rows; ++r) {
+        const double centre = (static_cast<double>(r) + 0.5) * scale - 0.5;
+        nearest_[r] = static_cast<size_t>(
+            std::clamp(centre + 0.5, 0.0, static_cast<double>(input_rows - 1)));
+
+        Tap& tap = taps_[r];
+        if (pooling_) {
+            // Every input row whose span overlaps the output row's span
+            tap.first = r * input_rows / output_rows;
+            tap.last = std::max(((r + 1) * input_rows + output_rows - 1) / output_rows,
+                                tap.first + 1);
+            tap.weight = 0.0f;
+        } else {
+            const double position = std::clamp(centre, 0.0, static_cast<double>(input_rows - 1));
+            tap.first = static_cast<size_t>(position);
+            tap.last = std::min(tap.first + 1, input_rows - 1);
+            tap.weight = static_cast<float>(position - static_cast<double>(tap.first));
+        }
+    }
+}
+
+} // namespace friture
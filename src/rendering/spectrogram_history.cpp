@@ -0,0 +1,328 @@
+/**
+ * @file spectrogram_history.cpp
+ * @brief Implementation of SpectrogramHistory
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/spectrogram_history.hpp>
+#include <friture/row_resampler.hpp>
+#include <friture/task_pool.hpp>
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace friture {
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+SpectrogramHistory::SpectrogramHistory(const SpectrogramHistoryConfig& config)
+    : height_(config.height),
+      capacity_(0),
+      memory_bytes_(config.memory_bytes),
+      precision_(config.precision),
+      level_for_log2_{},
+      total_columns_(0)
+{
+    if (height_ == 0) {
+        throw std::invalid_argument("History height must be > 0");
+    }
+    const std::vector<size_t>& factors = config.factors;
+    if (factors.empty() || factors.size() > MAX_LEVELS || factors[0] != 1) {
+        throw std::invalid_argument("History needs 1 to 8 levels, the first with factor 1");
+    }
+    for (size_t k = 1; k < factors.size(); ++k) {
+        if (!std::has_single_bit(factors[k]) || factors[k] <= factors[k - 1]) {
+            throw std::invalid_argument("History level factors must be increasing powers of 2");
+        }
+    }
+
+    // Every level gets the same number of columns
+    const size_t bytes_per_value = (precision_ == HistoryPrecision::Level8) ? 1 : 2;
+    capacity_ = config.memory_bytes / (factors.size() * height_ * bytes_per_value);
+    if (capacity_ < factors.back()) {
+        // Smaller rings would leave gaps between what the levels hold
+        throw std::invalid_argument("History memory budget too small for the coarsest level");
+    }
+
+    levels_.resize(factors.size());
+    for (size_t k = 0; k < factors.size(); ++k) {
+        Level& level = levels_[k];
+        level.factor = factors[k];
+        if (precision_ == HistoryPrecision::Level8) {
+            level.data8.assign(capacity_ * height_, 0);
+        } else {
+            level.data16.assign(capacity_ * height_, 0);
+        }
+        if (k > 0) {
+            level.pool.assign(height_, 0);
+        }
+    }
+
+    // Coarsest level whose factor is at most 2^e
+    for (size_t e = 0; e < level_for_log2_.size(); ++e) {
+        size_t level = 0;
+        for (size_t k = 0; k < levels_.size(); ++k) {
+            if (static_cast<size_t>(std::countr_zero(levels_[k].factor)) <= e) {
+                level = k;
+            }
+        }
+        level_for_log2_[e] = static_cast<uint8_t>(level);
+    }
+
+    encoded_.resize(height_);
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+void SpectrogramHistory::append(const float* column_db, size_t column_height) {
+    if (column_height != height_) {
+        return;
+    }
+    SpectrogramImage::encodeLevels(column_db, height_, encoded_.data());
+    appendLevels(encoded_.data(), height_);
+}
+
+void SpectrogramHistory::appendLevels(const uint16_t* levels, size_t column_height) {
+    if (column_height != height_) {
+        return;
+    }
+    store(0, levels);
+    ++total_columns_;
+}
+
+void SpectrogramHistory::store(size_t k, const uint16_t* levels) {
+    Level& level = levels_[k];
+    const size_t offset = static_cast<size_t>(level.count % capacity_) * height_;
+    if (precision_ == HistoryPrecision::Level8) {
+        for (size_t i = 0; i < height_; ++i) {
+            level.data8[offset + i] = static_cast<uint8_t>(levels[i] >> 8);
+        }
+    } else {
+        std::copy(levels, levels + height_, level.data16.begin() + offset);
+    }
+    ++level.count;
+
+    if (k + 1 == levels_.size()) {
+        return;
+    }
+
+    // Max-pool into the next level; a full pool cascades further
+    Level& next = levels_[k + 1];
+    if (next.pooled == 0) {
+        std::copy(levels, levels + height_, next.pool.begin());
+    } else {
+        for (size_t i = 0; i < height_; ++i) {
+            next.pool[i] = std::max(next.pool[i], levels[i]);
+        }
+    }
+    if (++next.pooled == next.factor / level.factor) {
+        next.pooled = 0;
+        store(k + 1, next.pool.data());
+    }
+}
+
+void SpectrogramHistory::clear() {
+    for (Level& level : levels_) {
+        level.count = 0;
+        level.pooled = 0;
+        level.first = 0;
+    }
+    total_columns_ = 0;
+}
+
+void SpectrogramHistory::resize(size_t new_height, TaskPool* pool) {
+    if (new_height == 0) {
+        throw std::invalid_argument("History height must be > 0");
+    }
+    if (new_height == height_) {
+        return;
+    }
+    const size_t bytes_per_value = (precision_ == HistoryPrecision::Level8) ? 1 : 2;
+    const size_t capacity = memory_bytes_ / (levels_.size() * new_height * bytes_per_value);
+    if (capacity < levels_.back().factor) {
+        throw std::invalid_argument("History memory budget too small for the coarsest level");
+    }
+
+    const RowResampler rows(height_, new_height);
+    const size_t old_height = height_;
+    const size_t old_capacity = capacity_;
+
+    for (Level& old : levels_) {
+        Level level;
+        level.factor = old.factor;
+        level.count = old.count;
+        level.pooled = old.pooled;
+
+        // Newest stored columns that fit; they keep their ring positions modulo
+        // the new capacity, so store() continues where it left off
+        const uint64_t oldest = old.count > old_capacity ? old.count - old_capacity : 0;
+        const uint64_t kept = std::min<uint64_t>(old.count - std::max(oldest, old.first), capacity);
+        level.first = old.count - kept;
+
+        if (precision_ == HistoryPrecision::Level8) {
+            level.data8.assign(capacity * new_height, 0);
+        } else {
+            level.data16.assign(capacity * new_height, 0);
+        }
+        if (!old.pool.empty()) {
+            level.pool.resize(new_height);
+            rows.resampleColumn(old.pool.data(), level.pool.data());
+        }
+
+        auto task = [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const uint64_t j = level.first + i;
+                const size_t src = static_cast<size_t>(j % old_capacity) * old_height;
+                const size_t dst = static_cast<size_t>(j % capacity) * new_height;
+                if (precision_ == HistoryPrecision::Level8) {
+                    rows.resampleColumn(old.data8.data() + src, level.data8.data() + dst);
+                } else {
+                    rows.resampleColumn(old.data16.data() + src, level.data16.data() + dst);
+                }
+            }
+        };
+        if (pool) {
+            pool->parallelFor(static_cast<size_t>(kept), 256, task);
+        } else {
+            task(0, 0, static_cast<size_t>(kept));
+        }
+
+        old = std::move(level);
+    }
+
+    height_ = new_height;
+    capacity_ = capacity;
+    encoded_.assign(new_height, 0);
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+uint64_t SpectrogramHistory::storedOldest(const Level& level) const {
+    const uint64_t oldest = level.count > capacity_ ? level.count - capacity_ : 0;
+    return std::max(oldest, level.first);
+}
+
+uint64_t SpectrogramHistory::getLevelOldest(size_t level) const {
+    const Level& l = levels_[level];
+    return storedOldest(l) * l.factor;
+}
+
+size_t SpectrogramHistory::selectLevel(uint64_t first_column, double columns_per_pixel) const {
+    size_t e = 0;
+    if (columns_per_pixel >= 2.0) {
+        const uint64_t whole = columns_per_pixel >= 1.8e19
+                                   ? UINT64_MAX : static_cast<uint64_t>(columns_per_pixel);
+        e = static_cast<size_t>(std::bit_width(whole)) - 1;
+    }
+    size_t level = level_for_log2_[e];
+
+    // Zoomed far into the past: only coarser levels still reach back there
+    while (level + 1 < levels_.size() && first_column < getLevelOldest(level)) {
+        ++level;
+    }
+    return level;
+}
+
+bool SpectrogramHistory::poolRange(size_t k, uint64_t first, uint64_t last, uint16_t* out) const {
+    const Level& level = levels_[k];
+    const uint64_t oldest = storedOldest(level);
+    if (first < oldest || last > level.count || first >= last) {
+        return false;
+    }
+
+    for (uint64_t j = first; j < last; ++j) {
+        const size_t offset = static_cast<size_t>(j % capacity_) * height_;
+        if (precision_ == HistoryPrecision::Level8) {
+            for (size_t i = 0; i < height_; ++i) {
+                // Middle of the 256-level step
+                const uint16_t value = static_cast<uint16_t>((level.data8[offset + i] << 8) | 0x80);
+                out[i] = std::max(out[i], value);
+            }
+        } else {
+            for (size_t i = 0; i < height_; ++i) {
+                out[i] = std::max(out[i], level.data16[offset + i]);
+            }
+        }
+    }
+    return true;
+}
+
+void SpectrogramHistory::sampleRange(size_t preferred, uint64_t first, uint64_t last,
+                                     uint16_t* out) const {
+    first = std::max(first, getOldestColumn());
+    last = std::min(last, total_columns_);
+
+    // Walk the range left to right, each piece from the preferred level if
+    // it holds it, else the nearest finer (newer) or coarser (older) one
+    uint64_t position = first;
+    while (position < last) {
+        bool found = false;
+        for (size_t step = 0; step < 2 * levels_.size() && !found; ++step) {
+            size_t k;
+            if (step <= preferred) {
+                k = preferred - step;
+            } else {
+                k = step;
+                if (k >= levels_.size()) {
+                    break;
+                }
+            }
+
+            const Level& level = levels_[k];
+            const uint64_t end = level.count * level.factor;
+            if (position < getLevelOldest(k) || position >= end) {
+                continue;
+            }
+            const uint64_t piece_end = std::min(last, end);
+            poolRange(k, position / level.factor,
+                      (piece_end + level.factor - 1) / level.factor, out);
+            position = piece_end;
+            found = true;
+        }
+        if (!found) {
+            break;  // Not reachable while capacity >= the largest factor
+        }
+    }
+}
+
+size_t SpectrogramHistory::render(uint64_t first_column, uint64_t column_count, size_t width,
+                                  uint16_t* levels) const {
+    if (column_count == 0 || width == 0) {
+        return 0;
+    }
+
+    const double columns_per_pixel = static_cast<double>(column_count) / width;
+    const size_t level = selectLevel(first_column, columns_per_pixel);
+
+    for (size_t x = 0; x < width; ++x) {
+        uint64_t first = first_column + column_count * x / width;
+        uint64_t last = first_column + column_count * (x + 1) / width;
+        if (last == first) {
+            last = first + 1;  // Zoomed in past full resolution: repeat columns
+        }
+
+        uint16_t* out = levels + x * height_;
+        std::fill(out, out + height_, uint16_t{0});
+        sampleRange(level, first, last, out);
+    }
+    return level;
+}
+
+size_t SpectrogramHistory::getMemoryUsage() const {
+    size_t bytes = encoded_.size() * sizeof(uint16_t);
+    for (const Level& level : levels_) {
+        bytes += level.data16.size() * sizeof(uint16_t) + level.data8.size()
+                 + level.pool.size() * sizeof(uint16_t);
+    }
+    return bytes;
+}
+
+} // namespace friture
@@ -4,37 +4,204 @@
  */
 
 #include <friture/spectrogram_image.hpp>
+#include <friture/row_resampler.hpp>
+#include <friture/task_pool.hpp>
 #include <stdexcept>
 #include <fstream>
 
 namespace friture {
 
-SpectrogramImage::SpectrogramImage(size_t width, size_t height)
-    : width_(width),
+namespace {
+
+/**
+ * @brief Write the 54-byte BMP file and info headers of a 32-bit image
+ */
+void writeBMPHeader(std::ofstream& file, size_t width, size_t height) {
+    // BMP format parameters
+    const uint32_t file_header_size = 14;
+    const uint32_t info_header_size = 40;
+    const uint32_t header_size = file_header_size + info_header_size;
+    const uint32_t row_size = static_cast<uint32_t>(width) * 4; // RGBA: 4 bytes per pixel
+    const uint32_t pixel_data_size = row_size * static_cast<uint32_t>(height);
+    const uint32_t file_size = header_size + pixel_data_size;
+    const uint32_t w = static_cast<uint32_t>(width);
+    const uint32_t h = static_cast<uint32_t>(height);
+
+    // BMP File Header (14 bytes)
+    uint8_t file_header[14] = {
+        'B', 'M',                              // Signature
+        static_cast<uint8_t>(file_size),       // File size (little-endian)
+        static_cast<uint8_t>(file_size >> 8),
+        static_cast<uint8_t>(file_size >> 16),
+        static_cast<uint8_t>(file_size >> 24),
+        0, 0, 0, 0,                            // Reserved
+        static_cast<uint8_t>(header_size),     // Pixel data offset
+        static_cast<uint8_t>(header_size >> 8),
+        static_cast<uint8_t>(header_size >> 16),
+        static_cast<uint8_t>(header_size >> 24)
+    };
+    file.write(reinterpret_cast<const char*>(file_header), file_header_size);
+
+    // BMP Info Header (40 bytes)
+    uint8_t info_header[40] = {
+        40, 0, 0, 0,                                    // Header size
+        static_cast<uint8_t>(w),                        // Width (little-endian)
+        static_cast<uint8_t>(w >> 8),
+        static_cast<uint8_t>(w >> 16),
+        static_cast<uint8_t>(w >> 24),
+        static_cast<uint8_t>(h),                        // Height (little-endian)
+        static_cast<uint8_t>(h >> 8),
+        static_cast<uint8_t>(h >> 16),
+        static_cast<uint8_t>(h >> 24),
+        1, 0,                                           // Planes
+        32, 0,                                          // Bits per pixel (32-bit RGBA)
+        0, 0, 0, 0,                                     // Compression (none)
+        static_cast<uint8_t>(pixel_data_size),         // Image size
+        static_cast<uint8_t>(pixel_data_size >> 8),
+        static_cast<uint8_t>(pixel_data_size >> 16),
+        static_cast<uint8_t>(pixel_data_size >> 24),
+        0, 0, 0, 0,                                     // X pixels per meter
+        0, 0, 0, 0,                                     // Y pixels per meter
+        0, 0, 0, 0,                                     // Colors in palette
+        0, 0, 0, 0                                      // Important colors
+    };
+    file.write(reinterpret_cast<const char*>(info_header), info_header_size);
+}
+
+} // namespace
+
+SpectrogramImage::SpectrogramImage(size_t width, size_t height, ImageLayout layout,
+                                   ImagePlane plane)
+    : layout_(layout),
+      plane_(plane),
+      width_(width),
       height_(height),
       write_offset_(0),
       read_offset_(0),
       columns_written_(0),
-      pixels_(2 * width * height, 0x00000000) {
+      clean_columns_(0),
+      all_dirty_(true),
+      texture_origin_(0) {
 
     if (width == 0 || height == 0) {
         throw std::invalid_argument("Width and height must be > 0");
     }
+
+    allocatePlane();
 }
 
 void SpectrogramImage::addColumn(const uint32_t* column_data, size_t column_height) {
     if (column_height != height_) {
         throw std::invalid_argument("Column height must match image height");
     }
+    if (plane_ != ImagePlane::Colors) {
+        throw std::invalid_argument("Image does not store colors only");
+    }
+
+    writeColumn(pixels_, column_data);
+    advanceColumn();
+}
+
+void SpectrogramImage::addColumn(const uint32_t* column_data, const uint16_t* levels,
+                                 size_t column_height) {
+    if (column_height != height_) {
+        throw std::invalid_argument("Column height must match image height");
+    }
+    if (plane_ != ImagePlane::ColorsAndLevels) {
+        throw std::invalid_argument("Image does not store colors and levels");
+    }
+
+    writeColumn(pixels_, column_data);
+    writeColumn(levels_, levels);
+    advanceColumn();
+}
+
+void SpectrogramImage::addColumnLevels(const uint16_t* levels, size_t column_height) {
+    if (column_height != height_) {
+        throw std::invalid_argument("Column height must match image height");
+    }
+    if (plane_ != ImagePlane::Levels) {
+        throw std::invalid_argument("Image does not store levels only");
+    }
 
-    // Calculate destination offset in pixel buffer
-    // Layout: pixels are stored column-major within the ring buffer
-    // Each column occupies 'height_' consecutive pixels
-    size_t dest_offset = write_offset_ * height_;
+    writeColumn(levels_, levels);
+    advanceColumn();
+}
 
-    // Copy column data into buffer
-    std::memcpy(pixels_.data() + dest_offset, column_data, height_ * sizeof(uint32_t));
+void SpectrogramImage::recolor(const std::array<uint32_t, 256>& palette, float min_db, float max_db) {
+    if (plane_ != ImagePlane::ColorsAndLevels) {
+        throw std::invalid_argument("Image does not store colors and levels");
+    }
+    if (!(min_db < max_db)) {
+        throw std::invalid_argument("min_db must be < max_db");
+    }
+
+    // index = (levelToDb(level) - min_db) × 255 / (max_db - min_db),
+    // folded into one multiply-add on the level
+    const float scale = 255.0f / (max_db - min_db);
+    const float slope = (LEVEL_MAX_DB - LEVEL_MIN_DB) / 65535.0f * scale;
+    const float offset = (LEVEL_MIN_DB - min_db) * scale;
+
+    // Indices for a block first (branch-free, vectorizes), then the
+    // palette gather, so the lookup doesn't block the arithmetic
+    constexpr size_t BLOCK = 256;
+    uint8_t indices[BLOCK];
 
+    const size_t total = levels_.size();
+    const uint16_t* src = levels_.data();
+    uint32_t* dst = pixels_.data();
+    for (size_t begin = 0; begin < total; begin += BLOCK) {
+        const size_t count = std::min(BLOCK, total - begin);
+        for (size_t i = 0; i < count; ++i) {
+            float x = static_cast<float>(src[begin + i]) * slope + offset;
+            x = x > 0.0f ? x : 0.0f;
+            x = x < 255.0f ? x : 255.0f;
+            indices[i] = static_cast<uint8_t>(x);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            dst[begin + i] = palette[indices[i]];
+        }
+    }
+
+    all_dirty_ = true;
+}
+
+void SpectrogramImage::encodeLevels(const float* db, size_t count, uint16_t* levels) {
+    constexpr float scale = 65535.0f / (LEVEL_MAX_DB - LEVEL_MIN_DB);
+    constexpr float offset = -LEVEL_MIN_DB * scale + 0.5f;  // +0.5 rounds on truncation
+
+    for (size_t i = 0; i < count; ++i) {
+        float x = db[i] * scale + offset;
+        // Written so NaN fails the first comparison and becomes 0
+        x = x > 0.0f ? x : 0.0f;
+        x = x < 65535.0f ? x : 65535.0f;
+        levels[i] = static_cast<uint16_t>(x);
+    }
+}
+
+template <typename T>
+void SpectrogramImage::writeColumn(std::vector<T>& plane, const T* column) {
+    // Write the column and its mirror in the other half, so the newest
+    // 'width' columns are contiguous from read_offset_ without wrapping
+    const size_t mirror = write_offset_ < width_ ? write_offset_ + width_ : write_offset_ - width_;
+
+    if (layout_ == ImageLayout::ColumnMajor) {
+        // Each column occupies 'height_' consecutive pixels
+        std::memcpy(plane.data() + write_offset_ * height_, column, height_ * sizeof(T));
+        std::memcpy(plane.data() + mirror * height_, column, height_ * sizeof(T));
+    } else {
+        // One pixel per row, rows are 2 × width apart
+        const size_t pitch = 2 * width_;
+        T* dest = plane.data() + write_offset_;
+        T* dest_mirror = plane.data() + mirror;
+        for (size_t row = 0; row < height_; ++row) {
+            dest[row * pitch] = column[row];
+            dest_mirror[row * pitch] = column[row];
+        }
+    }
+}
+
+void SpectrogramImage::advanceColumn() {
     // Increment total columns written
     columns_written_++;
 
@@ -45,31 +212,79 @@ void SpectrogramImage::addColumn(const uint32_t* column_data, size_t column_heig
     updateReadOffset();
 }
 
+void SpectrogramImage::allocatePlane() {
+    pixels_.clear();
+    levels_.clear();
+
+    if (plane_ != ImagePlane::Levels) {
+        pixels_.resize(2 * width_ * height_, 0x00000000);
+    }
+    if (plane_ != ImagePlane::Colors) {
+        levels_.resize(2 * width_ * height_, 0);
+    }
+}
+
 void SpectrogramImage::updateReadOffset() {
-    // The read offset should trail the write offset by 'width_' columns
-    // This ensures we always display the most recent 'width_' columns
+    // The read offset trails the write offset by 'width_' columns so we
+    // always display the most recent data. Every column also exists
+    // 'width_' columns away, so the window can always start in the first
+    // half and [read_offset_, read_offset_ + width_) never wraps.
 
     // During initial fill (less than 'width_' columns written), read from start
     if (columns_written_ <= width_) {
         read_offset_ = 0;
     } else {
-        // After initial fill, read_offset trails write_offset by 'width_' in circular buffer
-        // write_offset points to where we'll write NEXT
-        // We want to read from (write_offset - width), wrapping correctly
-        if (write_offset_ >= width_) {
-            read_offset_ = write_offset_ - width_;
-        } else {
-            // write_offset has wrapped, so read_offset should be in second half
-            read_offset_ = write_offset_ + width_;
-        }
+        read_offset_ = static_cast<size_t>((columns_written_ - width_) % width_);
+    }
+}
+
+bool SpectrogramImage::needsFullUpload() const {
+    return all_dirty_ || columns_written_ - clean_columns_ >= width_;
+}
+
+size_t SpectrogramImage::getDirtySpans(ColumnSpan spans[2]) const {
+    if (needsFullUpload()) {
+        // Contiguous view of the whole window; the texture is re-based so
+        // the oldest column lands in texture column 0 (see clearDirty())
+        spans[0] = ColumnSpan{read_offset_, 0, width_};
+        return 1;
+    }
+
+    size_t num_spans = 0;
+    uint64_t begin = clean_columns_;
+    while (begin < columns_written_) {
+        // Thanks to the mirror, a run starting in the first half can extend
+        // up to 'width_' columns without wrapping; only the texture ring
+        // can wrap, which happens at most once within one window
+        const size_t image_column = static_cast<size_t>(begin % width_);
+        const size_t texture_column = (image_column + width_ - texture_origin_) % width_;
+        const size_t count = static_cast<size_t>(
+            std::min<uint64_t>(columns_written_ - begin, width_ - texture_column));
+
+        spans[num_spans++] = ColumnSpan{image_column, texture_column, count};
+        begin += count;
+    }
+
+    return num_spans;
+}
+
+void SpectrogramImage::clearDirty() {
+    if (needsFullUpload()) {
+        texture_origin_ = read_offset_;
     }
+    clean_columns_ = columns_written_;
+    all_dirty_ = false;
 }
 
 void SpectrogramImage::clear() {
     std::fill(pixels_.begin(), pixels_.end(), 0x00000000);
+    std::fill(levels_.begin(), levels_.end(), 0);
     write_offset_ = 0;
     read_offset_ = 0;
     columns_written_ = 0;
+    clean_columns_ = 0;
+    all_dirty_ = true;
+    texture_origin_ = 0;
 }
 
 void SpectrogramImage::resize(size_t new_width, size_t new_height) {
@@ -82,80 +297,145 @@ void SpectrogramImage::resize(size_t new_width, size_t new_height) {
     write_offset_ = 0;
     read_offset_ = 0;
     columns_written_ = 0;
+    clean_columns_ = 0;
+    all_dirty_ = true;
+    texture_origin_ = 0;
 
     // Reallocate buffer
-    pixels_.clear();
-    pixels_.resize(2 * width_ * height_, 0x00000000);
+    allocatePlane();
+}
+
+void SpectrogramImage::resample(size_t new_width, size_t new_height, TaskPool* pool) {
+    if (new_width == 0 || new_height == 0) {
+        throw std::invalid_argument("Width and height must be > 0");
+    }
+
+    // Newest 'kept' columns end at the newest one; the mirror keeps the
+    // run [first, first + kept) contiguous in the old buffer
+    const size_t visible = static_cast<size_t>(std::min<uint64_t>(columns_written_, width_));
+    const size_t kept = std::min(visible, new_width);
+    const size_t end = columns_written_ <= width_ ? visible : read_offset_ + width_;
+    const size_t first = end - kept;
+
+    const RowResampler rows(height_, new_height);
+    std::vector<uint32_t> pixels(plane_ != ImagePlane::Levels ? 2 * new_width * new_height : 0, 0);
+    std::vector<uint16_t> levels(plane_ != ImagePlane::Colors ? 2 * new_width * new_height : 0, 0);
+
+    if (layout_ == ImageLayout::RowMajor) {
+        // Row by row: each output row blends (or pools) whole input rows
+        const size_t pitch = 2 * width_;
+        const size_t new_pitch = 2 * new_width;
+        auto task = [&](size_t, size_t begin, size_t end_row) {
+            if (!levels.empty()) {
+                rows.resampleRows(levels_.data() + first, pitch, levels.data(), new_pitch,
+                                  kept, begin, end_row);
+            }
+            for (size_t r = begin; r < end_row; ++r) {
+                if (!pixels.empty()) {
+                    const uint32_t* src = pixels_.data() + rows.nearestRow(r) * pitch + first;
+                    std::copy(src, src + kept, pixels.data() + r * new_pitch);
+                    std::copy(src, src + kept, pixels.data() + r * new_pitch + new_width);
+                }
+                if (!levels.empty()) {
+                    uint16_t* row = levels.data() + r * new_pitch;
+                    std::copy(row, row + kept, row + new_width);
+                }
+            }
+        };
+        if (pool) {
+            pool->parallelFor(new_height, 16, task);
+        } else {
+            task(0, 0, new_height);
+        }
+    } else {
+        // Column by column: each column is contiguous
+        auto task = [&](size_t, size_t begin, size_t end_column) {
+            for (size_t c = begin; c < end_column; ++c) {
+                const size_t src = (first + c) * height_;
+                const size_t dst = c * new_height;
+                const size_t mirror = (c + new_width) * new_height;
+                if (!levels.empty()) {
+                    rows.resampleColumn(levels_.data() + src, levels.data() + dst);
+                    std::copy(levels.data() + dst, levels.data() + dst + new_height,
+                              levels.data() + mirror);
+                }
+                if (!pixels.empty()) {
+                    for (size_t r = 0; r < new_height; ++r) {
+                        pixels[dst + r] = pixels_[src + rows.nearestRow(r)];
+                    }
+                    std::copy(pixels.data() + dst, pixels.data() + dst + new_height,
+                              pixels.data() + mirror);
+                }
+            }
+        };
+        if (pool) {
+            pool->parallelFor(kept, 64, task);
+        } else {
+            task(0, 0, kept);
+        }
+    }
+
+    pixels_ = std::move(pixels);
+    levels_ = std::move(levels);
+    width_ = new_width;
+    height_ = new_height;
+    write_offset_ = kept;
+    columns_written_ = kept;
+    clean_columns_ = 0;
+    all_dirty_ = true;
+    texture_origin_ = 0;
+    updateReadOffset();
 }
 
 bool SpectrogramImage::saveToBMP(const char* filename) const {
-    // BMP format parameters
-    const uint32_t file_header_size = 14;
-    const uint32_t info_header_size = 40;
-    const uint32_t header_size = file_header_size + info_header_size;
-    const uint32_t row_size = width_ * 4; // RGBA: 4 bytes per pixel
-    const uint32_t pixel_data_size = row_size * height_;
-    const uint32_t file_size = header_size + pixel_data_size;
+    if (plane_ == ImagePlane::Levels) {
+        return false;
+    }
 
     std::ofstream file(filename, std::ios::binary);
     if (!file) {
         return false;
     }
-
-    // BMP File Header (14 bytes)
-    uint8_t file_header[14] = {
-        'B', 'M',                              // Signature
-        static_cast<uint8_t>(file_size),       // File size (little-endian)
-        static_cast<uint8_t>(file_size >> 8),
-        static_cast<uint8_t>(file_size >> 16),
-        static_cast<uint8_t>(file_size >> 24),
-        0, 0, 0, 0,                            // Reserved
-        static_cast<uint8_t>(header_size),     // Pixel data offset
-        static_cast<uint8_t>(header_size >> 8),
-        static_cast<uint8_t>(header_size >> 16),
-        static_cast<uint8_t>(header_size >> 24)
-    };
-    file.write(reinterpret_cast<const char*>(file_header), file_header_size);
-
-    // BMP Info Header (40 bytes)
-    uint8_t info_header[40] = {
-        40, 0, 0, 0,                                    // Header size
-        static_cast<uint8_t>(width_),                   // Width (little-endian)
-        static_cast<uint8_t>(width_ >> 8),
-        static_cast<uint8_t>(width_ >> 16),
-        static_cast<uint8_t>(width_ >> 24),
-        static_cast<uint8_t>(height_),                  // Height (little-endian)
-        static_cast<uint8_t>(height_ >> 8),
-        static_cast<uint8_t>(height_ >> 16),
-        static_cast<uint8_t>(height_ >> 24),
-        1, 0,                                           // Planes
-        32, 0,                                          // Bits per pixel (32-bit RGBA)
-        0, 0, 0, 0,                                     // Compression (none)
-        static_cast<uint8_t>(pixel_data_size),         // Image size
-        static_cast<uint8_t>(pixel_data_size >> 8),
-        static_cast<uint8_t>(pixel_data_size >> 16),
-        static_cast<uint8_t>(pixel_data_size >> 24),
-        0, 0, 0, 0,                                     // X pixels per meter
-        0, 0, 0, 0,                                     // Y pixels per meter
-        0, 0, 0, 0,                                     // Colors in palette
-        0, 0, 0, 0                                      // Important colors
-    };
-    file.write(reinterpret_cast<const char*>(info_header), info_header_size);
+    writeBMPHeader(file, width_, height_);
 
     // Write pixel data (BMP stores bottom-to-top, left-to-right)
-    // We need to handle the ring buffer wrap-around and flip vertically
+    // The visible window never wraps; we only need to flip vertically
     std::vector<uint32_t> row_buffer(width_);
 
     for (int y = static_cast<int>(height_) - 1; y >= 0; --y) {
-        // Extract one row across all visible columns, handling wrap-around
+        // Extract one row across all visible columns (contiguous view)
         for (size_t x = 0; x < width_; ++x) {
-            size_t column_idx = (read_offset_ + x) % (2 * width_);
-            size_t pixel_idx = column_idx * height_ + y;
-            row_buffer[x] = pixels_[pixel_idx];
+            row_buffer[x] = pixels_[getPixelIndex(read_offset_ + x, y)];
         }
 
         // Write row to file
-        file.write(reinterpret_cast<const char*>(row_buffer.data()), row_size);
+        file.write(reinterpret_cast<const char*>(row_buffer.data()), width_ * 4);
+    }
+
+    file.close();
+    return file.good();
+}
+
+bool SpectrogramImage::saveColumnsToBMP(const char* filename, const uint32_t* columns,
+                                        size_t width, size_t height) {
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    writeBMPHeader(file, width, height);
+
+    // Same row order as saveToBMP(); each row gathers one pixel per column
+    std::vector<uint32_t> row_buffer(width);
+    for (size_t y = height; y-- > 0; ) {
+        const uint32_t* pixel = columns + y;
+        for (size_t x = 0; x < width; ++x, pixel += height) {
+            row_buffer[x] = *pixel;
+        }
+        file.write(reinterpret_cast<const char*>(row_buffer.data()), width * 4);
     }
 
     file.close();
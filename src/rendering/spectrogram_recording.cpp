@@ -0,0 +1,782 @@
+/**
+ * @file spectrogram_recording.cpp
+ * @brief Implementation of SpectrogramRecorder and SpectrogramRecordingReader
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/spectrogram_recording.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace friture {
+
+namespace {
+
+constexpr char FILE_MAGIC[8] = {'F', 'R', 'S', 'P', 'C', 'R', 'E', 'C'};
+constexpr char CHUNK_MAGIC[4] = {'C', 'H', 'N', 'K'};
+constexpr char INDEX_MAGIC[4] = {'I', 'N', 'D', 'X'};
+constexpr char TRAILER_MAGIC[4] = {'F', 'E', 'N', 'D'};
+constexpr uint32_t FORMAT_VERSION = 1;
+
+constexpr size_t HEADER_BYTES = 64;
+constexpr size_t CHUNK_HEADER_BYTES = 24;
+constexpr size_t INDEX_HEADER_BYTES = 16;
+constexpr size_t INDEX_ENTRY_BYTES = 24;
+constexpr size_t TRAILER_BYTES = 16;
+
+// Writer wakes this often to drain the queue (push() never signals)
+constexpr auto WRITER_POLL_INTERVAL = std::chrono::milliseconds(50);
+
+// Little-endian field access
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putU64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putF32(std::vector<uint8_t>& out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(out, bits);
+}
+
+void putBytes(std::vector<uint8_t>& out, const char* bytes, size_t count) {
+    // resize + memcpy: GCC's -Warray-bounds / -Wstringop-overflow misfire
+    // on inserting a fixed-size array once this is inlined at -O2
+    const size_t offset = out.size();
+    out.resize(offset + count);
+    std::memcpy(out.data() + offset, bytes, count);
+}
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readU64(const uint8_t* p) {
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+float readF32(const uint8_t* p) {
+    uint32_t bits = readU32(p);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// LEB128 varints
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool readVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        const uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Stored value q of a level, and the level it decodes back to (middle of its step)
+
+uint16_t quantize(uint16_t level, uint32_t level_bits) {
+    return static_cast<uint16_t>(level >> (16 - level_bits));
+}
+
+uint16_t dequantize(uint16_t q, uint32_t level_bits) {
+    const uint32_t shift = 16 - level_bits;
+    const uint32_t half_step = shift > 0 ? 1u << (shift - 1) : 0;
+    return static_cast<uint16_t>((static_cast<uint32_t>(q) << shift) | half_step);
+}
+
+bool validHeader(const RecordingHeader& header, std::string& error) {
+    if (header.height == 0) {
+        error = "Recording height must be > 0";
+    } else if (header.level_bits < 8 || header.level_bits > 16) {
+        error = "Recording level_bits must be 8 to 16";
+    } else if (header.columns_per_chunk == 0) {
+        error = "Recording columns_per_chunk must be > 0";
+    } else if (header.hop_size == 0 || !(header.sample_rate > 0.0f)) {
+        error = "Recording needs a hop size and sample rate";
+    } else {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+bool RecordingHeader::sameFormat(const RecordingHeader& other) const {
+    return fft_size == other.fft_size && hop_size == other.hop_size &&
+           sample_rate == other.sample_rate && scale == other.scale &&
+           min_freq == other.min_freq && max_freq == other.max_freq &&
+           height == other.height && level_bits == other.level_bits;
+}
+
+// ============================================================================
+// SpectrogramRecorder
+// ============================================================================
+
+SpectrogramRecorder::SpectrogramRecorder(size_t queue_columns)
+    : queue_columns_(queue_columns),
+      file_(nullptr),
+      stop_requested_(false),
+      pushed_columns_(0),
+      dropped_columns_(0),
+      bytes_written_(0),
+      write_failed_(false),
+      chunk_first_(0),
+      chunk_columns_(0),
+      zero_run_(0),
+      file_offset_(0)
+{
+    if (queue_columns_ == 0) {
+        throw std::invalid_argument("Recorder queue must hold at least one column");
+    }
+}
+
+SpectrogramRecorder::~SpectrogramRecorder() {
+    stop();
+}
+
+bool SpectrogramRecorder::start(const std::string& path, const RecordingHeader& header) {
+    stop();
+    error_.clear();
+
+    if (!validHeader(header, error_)) {
+        return false;
+    }
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        error_ = "Failed to open " + path + " for writing";
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, FILE_BUFFER_BYTES);
+
+    header_ = header;
+    if (header_.start_time_ms == 0) {
+        header_.start_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    path_ = path;
+
+    // Writer state (the thread is not running yet)
+    const size_t height = header_.height;
+    queue_ = std::make_unique<SpscQueue<QueuedColumn>>(
+        queue_columns_, QueuedColumn{0, std::vector<uint16_t>(height)});
+    previous_.assign(height, 0);
+    summary_.assign(height, 0);
+    payload_.clear();
+    index_.clear();
+    chunk_first_ = 0;
+    chunk_columns_ = 0;
+    zero_run_ = 0;
+    file_offset_ = 0;
+    pushed_columns_ = 0;
+    dropped_columns_.store(0, std::memory_order_relaxed);
+    bytes_written_.store(0, std::memory_order_relaxed);
+    write_failed_.store(false, std::memory_order_relaxed);
+    stop_requested_.store(false, std::memory_order_relaxed);
+
+    buffer_.clear();
+    putBytes(buffer_, FILE_MAGIC, sizeof(FILE_MAGIC));
+    putU32(buffer_, FORMAT_VERSION);
+    putU32(buffer_, static_cast<uint32_t>(HEADER_BYTES));
+    putU32(buffer_, header_.fft_size);
+    putU32(buffer_, header_.hop_size);
+    putF32(buffer_, header_.sample_rate);
+    putU32(buffer_, static_cast<uint32_t>(header_.scale));
+    putF32(buffer_, header_.min_freq);
+    putF32(buffer_, header_.max_freq);
+    putU32(buffer_, header_.height);
+    putU32(buffer_, header_.level_bits);
+    putU32(buffer_, header_.columns_per_chunk);
+    putU64(buffer_, static_cast<uint64_t>(header_.start_time_ms));
+    buffer_.resize(HEADER_BYTES, 0);
+    writeBytes(buffer_);
+    if (write_failed_.load(std::memory_order_relaxed)) {
+        std::fclose(file_);
+        file_ = nullptr;
+        error_ = "Failed to write " + path;
+        return false;
+    }
+
+    writer_ = std::thread(&SpectrogramRecorder::writerLoop, this);
+    return true;
+}
+
+bool SpectrogramRecorder::push(const uint16_t* levels, size_t height) {
+    if (!isRecording() || height != header_.height) {
+        return false;
+    }
+
+    const uint64_t column = pushed_columns_++;
+    const bool queued = queue_->pushWith([&](QueuedColumn& slot) {
+        slot.column = column;
+        std::copy(levels, levels + height, slot.levels.begin());
+    });
+    if (!queued) {
+        dropped_columns_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return queued;
+}
+
+bool SpectrogramRecorder::stop() {
+    if (!writer_.joinable()) {
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_requested_.store(true, std::memory_order_release);
+    }
+    wake_cv_.notify_one();
+    writer_.join();
+
+    bool ok = !write_failed_.load(std::memory_order_relaxed);
+    ok = (std::fclose(file_) == 0) && ok;
+    file_ = nullptr;
+    queue_.reset();
+    if (!ok) {
+        error_ = "Failed to write " + path_;
+    }
+    return ok;
+}
+
+void SpectrogramRecorder::writerLoop() {
+    while (true) {
+        // Checked before draining: once stop is requested nothing more is pushed
+        const bool stopping = stop_requested_.load(std::memory_order_acquire);
+        while (queue_->popWith([this](const QueuedColumn& column) { addColumn(column); })) {
+        }
+        if (stopping) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait_for(lock, WRITER_POLL_INTERVAL, [this] {
+            return stop_requested_.load(std::memory_order_acquire);
+        });
+    }
+
+    flushChunk();
+    writeIndex();
+}
+
+void SpectrogramRecorder::addColumn(const QueuedColumn& column) {
+    // A dropped column ends the chunk: chunks hold consecutive columns only
+    if (chunk_columns_ > 0 && (chunk_columns_ == header_.columns_per_chunk ||
+                               column.column != chunk_first_ + chunk_columns_)) {
+        flushChunk();
+    }
+    if (chunk_columns_ == 0) {
+        chunk_first_ = column.column;
+        std::fill(previous_.begin(), previous_.end(), uint16_t{0});
+        std::fill(summary_.begin(), summary_.end(), uint16_t{0});
+    }
+
+    // Deltas against the previous column; unchanged values become zero runs
+    for (size_t i = 0; i < previous_.size(); ++i) {
+        const uint16_t q = quantize(column.levels[i], header_.level_bits);
+        const int32_t delta = static_cast<int32_t>(q) - static_cast<int32_t>(previous_[i]);
+        previous_[i] = q;
+        summary_[i] = std::max(summary_[i], q);
+        if (delta == 0) {
+            ++zero_run_;
+            continue;
+        }
+        if (zero_run_ > 0) {
+            putVarint(payload_, (zero_run_ << 1) | 1);
+            zero_run_ = 0;
+        }
+        const uint64_t zigzag = delta < 0 ? (static_cast<uint64_t>(-delta) << 1) - 1
+                                          : static_cast<uint64_t>(delta) << 1;
+        putVarint(payload_, zigzag << 1);
+    }
+    ++chunk_columns_;
+}
+
+void SpectrogramRecorder::flushChunk() {
+    if (chunk_columns_ == 0) {
+        return;
+    }
+    if (zero_run_ > 0) {
+        putVarint(payload_, (zero_run_ << 1) | 1);
+        zero_run_ = 0;
+    }
+
+    buffer_.clear();
+    putBytes(buffer_, CHUNK_MAGIC, sizeof(CHUNK_MAGIC));
+    putU32(buffer_, chunk_columns_);
+    putU64(buffer_, chunk_first_);
+    putU32(buffer_, static_cast<uint32_t>(payload_.size()));
+    putU32(buffer_, 0);
+    for (uint16_t q : summary_) {
+        const uint16_t level = dequantize(q, header_.level_bits);
+        buffer_.push_back(static_cast<uint8_t>(level));
+        buffer_.push_back(static_cast<uint8_t>(level >> 8));
+    }
+    buffer_.insert(buffer_.end(), payload_.begin(), payload_.end());
+
+    index_.push_back({chunk_first_, file_offset_, chunk_columns_});
+    writeBytes(buffer_);
+
+    // Whole chunks reach the file promptly; a crash loses at most one chunk
+    if (file_ && std::fflush(file_) != 0) {
+        write_failed_.store(true, std::memory_order_relaxed);
+    }
+
+    payload_.clear();
+    chunk_columns_ = 0;
+}
+
+void SpectrogramRecorder::writeIndex() {
+    const uint64_t index_offset = file_offset_;
+
+    buffer_.clear();
+    putBytes(buffer_, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    putU32(buffer_, 0);
+    putU64(buffer_, index_.size());
+    for (const IndexEntry& entry : index_) {
+        putU64(buffer_, entry.first_column);
+        putU64(buffer_, entry.offset);
+        putU32(buffer_, entry.column_count);
+        putU32(buffer_, 0);
+    }
+    putU64(buffer_, index_offset);
+    putBytes(buffer_, TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+    putU32(buffer_, FORMAT_VERSION);
+    writeBytes(buffer_);
+}
+
+void SpectrogramRecorder::writeBytes(const std::vector<uint8_t>& bytes) {
+    if (write_failed_.load(std::memory_order_relaxed)) {
+        return;  // Keep the file a valid prefix
+    }
+    if (std::fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size()) {
+        write_failed_.store(true, std::memory_order_relaxed);
+        return;
+    }
+    file_offset_ += bytes.size();
+    bytes_written_.store(file_offset_, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// SpectrogramRecordingReader
+// ============================================================================
+
+SpectrogramRecordingReader::SpectrogramRecordingReader()
+    : data_(nullptr),
+      size_(0),
+#ifdef _WIN32
+      file_handle_(nullptr),
+      mapping_handle_(nullptr),
+#endif
+      header_(),
+      has_index_(false),
+      decoded_chunk_(SIZE_MAX)
+{
+}
+
+SpectrogramRecordingReader::~SpectrogramRecordingReader() {
+    close();
+}
+
+bool SpectrogramRecordingReader::open(const char* filename) {
+    close();
+    error_.clear();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        setError(std::string("Failed to open file: ") + filename);
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        setError(std::string("Empty or unreadable file: ") + filename);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        setError(std::string("Failed to map file: ") + filename);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        setError(std::string("Failed to map file: ") + filename);
+        return false;
+    }
+
+    file_handle_ = file;
+    mapping_handle_ = mapping;
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        setError(std::string("Failed to open file: ") + filename);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        setError(std::string("Empty or unreadable file: ") + filename);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapped == MAP_FAILED) {
+        setError(std::string("Failed to map file: ") + filename);
+        return false;
+    }
+
+    // Time-range reads jump around; read-ahead would fetch unused chunks
+    madvise(mapped, static_cast<size_t>(st.st_size), MADV_RANDOM);
+
+    data_ = static_cast<const uint8_t*>(mapped);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    if (!parse()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SpectrogramRecordingReader::close() {
+    if (data_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mapping_handle_));
+        CloseHandle(static_cast<HANDLE>(file_handle_));
+        mapping_handle_ = nullptr;
+        file_handle_ = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    header_ = RecordingHeader();
+    chunks_.clear();
+    has_index_ = false;
+    decoded_.clear();
+    decoded_chunk_ = SIZE_MAX;
+}
+
+bool SpectrogramRecordingReader::parse() {
+    if (size_ < HEADER_BYTES || std::memcmp(data_, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        setError("Not a spectrogram recording");
+        return false;
+    }
+    if (readU32(data_ + 8) != FORMAT_VERSION || readU32(data_ + 12) != HEADER_BYTES) {
+        setError("Unsupported recording version");
+        return false;
+    }
+
+    header_.fft_size = readU32(data_ + 16);
+    header_.hop_size = readU32(data_ + 20);
+    header_.sample_rate = readF32(data_ + 24);
+    const uint32_t scale = readU32(data_ + 28);
+    header_.min_freq = readF32(data_ + 32);
+    header_.max_freq = readF32(data_ + 36);
+    header_.height = readU32(data_ + 40);
+    header_.level_bits = readU32(data_ + 44);
+    header_.columns_per_chunk = readU32(data_ + 48);
+    header_.start_time_ms = static_cast<int64_t>(readU64(data_ + 52));
+
+    if (scale > static_cast<uint32_t>(FrequencyScale::Octave)) {
+        setError("Invalid frequency scale in recording");
+        return false;
+    }
+    header_.scale = static_cast<FrequencyScale>(scale);
+    if (!validHeader(header_, error_)) {
+        return false;
+    }
+
+    has_index_ = readIndex();
+    if (!has_index_) {
+        scanChunks();
+    }
+    return true;
+}
+
+bool SpectrogramRecordingReader::chunkAt(uint64_t offset, Chunk& chunk) const {
+    const uint64_t summary_bytes = uint64_t{header_.height} * 2;
+    if (offset > size_ || size_ - offset < CHUNK_HEADER_BYTES + summary_bytes) {
+        return false;
+    }
+    const uint8_t* p = data_ + offset;
+    if (std::memcmp(p, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0) {
+        return false;
+    }
+    chunk.column_count = readU32(p + 4);
+    chunk.first_column = readU64(p + 8);
+    chunk.payload_bytes = readU32(p + 16);
+    if (chunk.column_count == 0 ||
+        size_ - offset - CHUNK_HEADER_BYTES - summary_bytes < chunk.payload_bytes) {
+        return false;
+    }
+    chunk.summary = p + CHUNK_HEADER_BYTES;
+    chunk.payload = chunk.summary + summary_bytes;
+    return true;
+}
+
+bool SpectrogramRecordingReader::readIndex() {
+    if (size_ < HEADER_BYTES + INDEX_HEADER_BYTES + TRAILER_BYTES) {
+        return false;
+    }
+    const uint8_t* trailer = data_ + size_ - TRAILER_BYTES;
+    if (std::memcmp(trailer + 8, TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) != 0) {
+        return false;
+    }
+    const uint64_t index_offset = readU64(trailer);
+    if (index_offset < HEADER_BYTES || index_offset > size_ - TRAILER_BYTES - INDEX_HEADER_BYTES) {
+        return false;
+    }
+    const uint8_t* index = data_ + index_offset;
+    if (std::memcmp(index, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0) {
+        return false;
+    }
+    const uint64_t entries = readU64(index + 8);
+    const uint64_t available = size_ - TRAILER_BYTES - index_offset - INDEX_HEADER_BYTES;
+    if (entries != available / INDEX_ENTRY_BYTES || available % INDEX_ENTRY_BYTES != 0) {
+        return false;
+    }
+
+    std::vector<Chunk> chunks;
+    chunks.reserve(entries);
+    for (uint64_t e = 0; e < entries; ++e) {
+        const uint8_t* entry = index + INDEX_HEADER_BYTES + e * INDEX_ENTRY_BYTES;
+        Chunk chunk;
+        if (!chunkAt(readU64(entry + 8), chunk) || chunk.first_column != readU64(entry) ||
+            (!chunks.empty() && chunk.first_column < chunks.back().first_column +
+                                                         chunks.back().column_count)) {
+            return false;
+        }
+        chunks.push_back(chunk);
+    }
+    chunks_ = std::move(chunks);
+    return true;
+}
+
+void SpectrogramRecordingReader::scanChunks() {
+    chunks_.clear();
+    uint64_t offset = HEADER_BYTES;
+    Chunk chunk;
+    while (chunkAt(offset, chunk)) {
+        if (!chunks_.empty() &&
+            chunk.first_column < chunks_.back().first_column + chunks_.back().column_count) {
+            break;
+        }
+        chunks_.push_back(chunk);
+        offset += CHUNK_HEADER_BYTES + uint64_t{header_.height} * 2 + chunk.payload_bytes;
+    }
+}
+
+uint64_t SpectrogramRecordingReader::getColumnCount() const {
+    return chunks_.empty() ? 0 : chunks_.back().first_column + chunks_.back().column_count;
+}
+
+uint64_t SpectrogramRecordingReader::columnAtTime(double seconds) const {
+    const double seconds_per_column = header_.getSecondsPerColumn();
+    if (!(seconds > 0.0) || seconds_per_column <= 0.0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(seconds / seconds_per_column);
+}
+
+size_t SpectrogramRecordingReader::firstChunkAfter(uint64_t column) const {
+    // Chunks are sorted and disjoint, so their ends are sorted too
+    auto it = std::upper_bound(chunks_.begin(), chunks_.end(), column,
+                               [](uint64_t c, const Chunk& chunk) {
+                                   return c < chunk.first_column + chunk.column_count;
+                               });
+    return static_cast<size_t>(it - chunks_.begin());
+}
+
+bool SpectrogramRecordingReader::decodeChunk(size_t index) {
+    if (decoded_chunk_ == index) {
+        return true;
+    }
+
+    const Chunk& chunk = chunks_[index];
+    const size_t height = header_.height;
+    const size_t total = static_cast<size_t>(chunk.column_count) * height;
+    decoded_.resize(total);
+
+    const uint8_t* p = chunk.payload;
+    const uint8_t* end = chunk.payload + chunk.payload_bytes;
+    const uint32_t max_q = (1u << header_.level_bits) - 1;
+    size_t n = 0;
+    while (n < total) {
+        uint64_t token;
+        if (!readVarint(p, end, token)) {
+            break;
+        }
+        if (token & 1) {
+            // Run of values equal to the previous column
+            const uint64_t run = token >> 1;
+            if (run == 0 || run > total - n) {
+                break;
+            }
+            for (uint64_t r = 0; r < run; ++r, ++n) {
+                decoded_[n] = n >= height ? decoded_[n - height] : 0;
+            }
+        } else {
+            const uint64_t zigzag = token >> 1;
+            const int64_t delta = (zigzag & 1) ? -static_cast<int64_t>((zigzag + 1) >> 1)
+                                               : static_cast<int64_t>(zigzag >> 1);
+            const int64_t q = (n >= height ? decoded_[n - height] : 0) + delta;
+            if (q < 0 || q > static_cast<int64_t>(max_q)) {
+                break;
+            }
+            decoded_[n++] = static_cast<uint16_t>(q);
+        }
+    }
+
+    if (n != total || p != end) {
+        decoded_chunk_ = SIZE_MAX;
+        setError("Corrupt chunk at column " + std::to_string(chunk.first_column));
+        return false;
+    }
+    for (uint16_t& value : decoded_) {
+        value = dequantize(value, header_.level_bits);
+    }
+    decoded_chunk_ = index;
+    return true;
+}
+
+size_t SpectrogramRecordingReader::readColumns(uint64_t first_column, size_t count,
+                                               uint16_t* levels) {
+    const size_t height = header_.height;
+    std::fill(levels, levels + count * height, uint16_t{0});
+    if (!isOpen() || count == 0) {
+        return 0;
+    }
+
+    const uint64_t last_column = first_column + count;
+    size_t present = 0;
+    for (size_t c = firstChunkAfter(first_column);
+         c < chunks_.size() && chunks_[c].first_column < last_column; ++c) {
+        if (!decodeChunk(c)) {
+            continue;  // Left silent
+        }
+        const Chunk& chunk = chunks_[c];
+        const uint64_t from = std::max(first_column, chunk.first_column);
+        const uint64_t to = std::min(last_column, chunk.first_column + chunk.column_count);
+        std::copy(decoded_.begin() + (from - chunk.first_column) * height,
+                  decoded_.begin() + (to - chunk.first_column) * height,
+                  levels + (from - first_column) * height);
+        present += static_cast<size_t>(to - from);
+    }
+    return present;
+}
+
+void SpectrogramRecordingReader::readOverview(uint64_t first_column, uint64_t column_count,
+                                              size_t width, uint16_t* levels) {
+    const size_t height = header_.height;
+    std::fill(levels, levels + width * height, uint16_t{0});
+    if (!isOpen() || column_count == 0 || width == 0) {
+        return;
+    }
+
+    // Zoomed in: one decoded column per output column or more
+    if (column_count <= width) {
+        std::vector<uint16_t> columns(static_cast<size_t>(column_count) * height);
+        readColumns(first_column, static_cast<size_t>(column_count), columns.data());
+        for (size_t x = 0; x < width; ++x) {
+            const size_t source = static_cast<size_t>(column_count * x / width);
+            std::copy_n(columns.begin() + source * height, height, levels + x * height);
+        }
+        return;
+    }
+
+    auto pixelOf = [&](uint64_t column) {
+        return static_cast<size_t>((column - first_column) * width / column_count);
+    };
+    const bool use_summaries = column_count >= uint64_t{header_.columns_per_chunk} * width;
+    const uint64_t last_column = first_column + column_count;
+
+    for (size_t c = firstChunkAfter(first_column);
+         c < chunks_.size() && chunks_[c].first_column < last_column; ++c) {
+        const Chunk& chunk = chunks_[c];
+        const uint64_t from = std::max(first_column, chunk.first_column);
+        const uint64_t to = std::min(last_column, chunk.first_column + chunk.column_count);
+
+        if (use_summaries) {
+            for (size_t x = pixelOf(from); x <= pixelOf(to - 1); ++x) {
+                uint16_t* out = levels + x * height;
+                for (size_t i = 0; i < height; ++i) {
+                    out[i] = std::max(out[i], readU16(chunk.summary + 2 * i));
+                }
+            }
+            continue;
+        }
+
+        if (!decodeChunk(c)) {
+            continue;
+        }
+        for (uint64_t column = from; column < to; ++column) {
+            const uint16_t* in = decoded_.data() + (column - chunk.first_column) * height;
+            uint16_t* out = levels + pixelOf(column) * height;
+            for (size_t i = 0; i < height; ++i) {
+                out[i] = std::max(out[i], in[i]);
+            }
+        }
+    }
+}
+
+void SpectrogramRecordingReader::setError(const std::string& message) {
+    error_ = message;
+}
+
+} // namespace friture
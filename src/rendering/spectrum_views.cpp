@@ -0,0 +1,204 @@
+/**
+ * @file spectrum_views.cpp
+ * @brief Implementation of SpectrumViews
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/spectrum_views.hpp>
+#include <friture/spectrogram_image.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace friture {
+
+namespace {
+
+// Band power of nothing (keeps log10 finite)
+constexpr float MIN_POWER = 1e-20f;
+
+} // namespace
+
+// ============================================================================
+// PeakTrack
+// ============================================================================
+
+void SpectrumViews::PeakTrack::assign(size_t count) {
+    values.assign(count, LEVEL_MIN_DB);
+    peaks.assign(count, LEVEL_MIN_DB);
+    ages.assign(count, 0.0f);
+}
+
+void SpectrumViews::PeakTrack::hold(size_t i, float value) {
+    if (value >= peaks[i]) {
+        peaks[i] = value;
+        ages[i] = 0.0f;
+    }
+}
+
+void SpectrumViews::PeakTrack::decay(float seconds, float hold_seconds, float decay_db_per_second) {
+    for (size_t i = 0; i < peaks.size(); ++i) {
+        const float before = ages[i];
+        ages[i] += seconds;
+        // Only the part of this step past the hold time decays
+        const float falling = ages[i] - std::max(before, hold_seconds);
+        if (falling > 0.0f) {
+            peaks[i] = std::max(peaks[i] - decay_db_per_second * falling, values[i]);
+        }
+    }
+}
+
+// ============================================================================
+// SpectrumViews
+// ============================================================================
+
+SpectrumViews::SpectrumViews(const Options& options)
+    : options_(options)
+{
+    if (options.hold_seconds < 0.0f || options.decay_db_per_second < 0.0f) {
+        throw std::invalid_argument("Peak hold and decay must be >= 0");
+    }
+    if (options.bands_per_octave < 1 || options.bands_per_octave > 24) {
+        throw std::invalid_argument("Bands per octave must be 1 to 24");
+    }
+}
+
+void SpectrumViews::configure(const std::vector<float>& row_frequencies, float bin_hz) {
+    if (row_frequencies.empty() || !(bin_hz > 0.0f)) {
+        throw std::invalid_argument("SpectrumViews needs rows and a bin width");
+    }
+    for (size_t i = 1; i < row_frequencies.size(); ++i) {
+        if (!(row_frequencies[i] > row_frequencies[i - 1])) {
+            throw std::invalid_argument("Row frequencies must be ascending");
+        }
+    }
+
+    row_frequencies_ = row_frequencies;
+    const size_t height = row_frequencies_.size();
+    latest_.assign(height, 0);
+    pooled_.assign(height, 0);
+    row_power_.resize(height);
+    pending_ = 0;
+
+    computeBands(bin_hz);
+    spectrum_.assign(height);
+    band_levels_.assign(bands_.size());
+}
+
+void SpectrumViews::computeBands(float bin_hz) {
+    const size_t height = row_frequencies_.size();
+
+    // Row r covers [edges[r], edges[r + 1]]: midpoints between row centers,
+    // the outer rows extended symmetrically
+    std::vector<float> edges(height + 1);
+    for (size_t r = 1; r < height; ++r) {
+        edges[r] = 0.5f * (row_frequencies_[r - 1] + row_frequencies_[r]);
+    }
+    if (height > 1) {
+        edges[0] = std::max(0.0f, 2.0f * row_frequencies_[0] - edges[1]);
+        edges[height] = 2.0f * row_frequencies_[height - 1] - edges[height - 1];
+    } else {
+        edges[0] = std::max(0.0f, row_frequencies_[0] - 0.5f * bin_hz);
+        edges[1] = row_frequencies_[0] + 0.5f * bin_hz;
+    }
+
+    // Base-2 nominal centers 1000 Hz * 2^(k/N) inside the row range
+    const double n = options_.bands_per_octave;
+    const double half_band = std::exp2(0.5 / n);
+    const float low = row_frequencies_.front();
+    const float high = row_frequencies_.back();
+    bands_.clear();
+    if (low > 0.0f) {
+        const int first_k = static_cast<int>(std::ceil(n * std::log2(low / 1000.0)));
+        for (int k = first_k;; ++k) {
+            const double center = 1000.0 * std::exp2(k / n);
+            if (center > high) {
+                break;
+            }
+            bands_.push_back({static_cast<float>(center), static_cast<float>(center / half_band),
+                              static_cast<float>(center * half_band)});
+        }
+    }
+
+    // Power weight of each row: its overlap with the band, in FFT bins
+    band_offsets_.assign(1, 0);
+    band_weights_.clear();
+    size_t first_row = 0;
+    for (const OctaveBand& band : bands_) {
+        while (first_row < height && edges[first_row + 1] <= band.low_hz) {
+            ++first_row;
+        }
+        for (size_t r = first_row; r < height && edges[r] < band.high_hz; ++r) {
+            const float overlap = std::min(edges[r + 1], band.high_hz) - std::max(edges[r], band.low_hz);
+            if (overlap > 0.0f) {
+                band_weights_.push_back({static_cast<uint32_t>(r), overlap / bin_hz});
+            }
+        }
+        band_offsets_.push_back(static_cast<uint32_t>(band_weights_.size()));
+    }
+}
+
+void SpectrumViews::addColumn(const uint16_t* levels, size_t height) {
+    if (height != latest_.size()) {
+        return;
+    }
+    std::copy(levels, levels + height, latest_.begin());
+    for (size_t r = 0; r < height; ++r) {
+        pooled_[r] = std::max(pooled_[r], levels[r]);
+    }
+    ++pending_;
+}
+
+void SpectrumViews::update(float seconds) {
+    if (!isConfigured()) {
+        return;
+    }
+    const size_t height = latest_.size();
+
+    auto band_power = [&](size_t b) {
+        float power = 0.0f;
+        for (uint32_t i = band_offsets_[b]; i < band_offsets_[b + 1]; ++i) {
+            power += band_weights_[i].bins * row_power_[band_weights_[i].row];
+        }
+        return 10.0f * std::log10(std::max(power, MIN_POWER));
+    };
+
+    if (pending_ > 0) {
+        // Latest column: the instantaneous views
+        for (size_t r = 0; r < height; ++r) {
+            spectrum_.values[r] = levelToDb(latest_[r]);
+            row_power_[r] = std::pow(10.0f, 0.1f * spectrum_.values[r]);
+        }
+        for (size_t b = 0; b < bands_.size(); ++b) {
+            band_levels_.values[b] = band_power(b);
+        }
+
+        // Every column since the last frame: the peaks
+        for (size_t r = 0; r < height; ++r) {
+            const float db = levelToDb(pooled_[r]);
+            spectrum_.hold(r, db);
+            row_power_[r] = std::pow(10.0f, 0.1f * db);
+        }
+        for (size_t b = 0; b < bands_.size(); ++b) {
+            band_levels_.hold(b, band_power(b));
+        }
+
+        std::fill(pooled_.begin(), pooled_.end(), uint16_t{0});
+        pending_ = 0;
+    }
+
+    spectrum_.decay(seconds, options_.hold_seconds, options_.decay_db_per_second);
+    band_levels_.decay(seconds, options_.hold_seconds, options_.decay_db_per_second);
+}
+
+void SpectrumViews::reset() {
+    std::fill(latest_.begin(), latest_.end(), uint16_t{0});
+    std::fill(pooled_.begin(), pooled_.end(), uint16_t{0});
+    pending_ = 0;
+    spectrum_.assign(latest_.size());
+    band_levels_.assign(bands_.size());
+}
+
+} // namespace friture
@@ -0,0 +1,392 @@
+/**
+ * @file replay_main.cpp
+ * @brief Deterministic replay: one WAV through the live analysis path
+ *
+ * Feeds a recording through the per-hop analysis exactly as live input
+ * would reach it (fixed-size blocks into the ring buffer, one column per
+ * hop) on a virtual sample clock, then prints a hash of the dB column
+ * stream, the throughput and the per-stage timings. --columns dumps the
+ * columns and --json the statistics, so two builds can be compared with
+ * scripts/replay_compare.py.
+ *
+ * Usage:
+ *   ./friture-replay [options] input.wav
+ *
+ * Column file (--columns), little-endian:
+ *   "FRREPLAY", uint32 version (1), uint32 rows, then per column
+ *   uint64 window end (samples) + rows × float32 dB
+ */
+
+#include <friture/replay_harness.hpp>
+#include <friture/fft_wisdom.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+constexpr char COLUMN_MAGIC[8] = {'F', 'R', 'R', 'E', 'P', 'L', 'A', 'Y'};
+constexpr uint32_t COLUMN_VERSION = 1;
+
+void printUsage(const char* program_name) {
+    std::cout << "Friture C++ - Deterministic Replay" << std::endl;
+    std::cout << "\nUsage:" << std::endl;
+    std::cout << "  " << program_name << " [options] input.wav" << std::endl;
+    std::cout << "\nRuns the file through the live analysis path on a virtual sample clock" << std::endl;
+    std::cout << "and prints a hash of the dB columns, throughput and stage timings." << std::endl;
+    std::cout << "\nOptions:" << std::endl;
+    std::cout << "  --columns FILE    Write every dB column to FILE (float32, see replay_main.cpp)" << std::endl;
+    std::cout << "  --json FILE       Write hash, throughput and stage timings to FILE as JSON" << std::endl;
+    std::cout << "  --repeat N        Replay N times; timings of the fastest run, and exit" << std::endl;
+    std::cout << "                    status 1 if any run's hash differs (default 1)" << std::endl;
+    std::cout << "  --block N         Samples per virtual audio callback (default 512)" << std::endl;
+    std::cout << "  --wisdom FILE     FFTW wisdom to plan from (default: the per-user cache);" << std::endl;
+    std::cout << "                    give both builds of a comparison the same file" << std::endl;
+    std::cout << "  --fft-size N      FFT size, power of 2 in [32, 16384] (default 4096)" << std::endl;
+    std::cout << "  --overlap PCT     Frame overlap in percent, [0, 99.9] (default 75)" << std::endl;
+    std::cout << "  --height N        Rows per column (default 512)" << std::endl;
+    std::cout << "  --scale NAME      linear, log, mel, erb or octave (default mel)" << std::endl;
+    std::cout << "  --range LO:HI     Frequency range in Hz (default 20:Nyquist)" << std::endl;
+    std::cout << "  --multi-resolution  Larger FFTs for the low rows (log and octave scales)" << std::endl;
+    std::cout << "  --zoom            Zoom FFT into a narrow --range" << std::endl;
+    std::cout << "  --window NAME     hann, hamming, blackman-harris, flat-top or kaiser[:BETA]" << std::endl;
+    std::cout << "  --weighting W     Frequency weighting: a, b, c or none (default none)" << std::endl;
+    std::cout << "  --average M       exp[:SECONDS], linear[:N], peak[:SECONDS] or none" << std::endl;
+    std::cout << "  --decimate K      One column per K hops, [1, 64] (default 1)" << std::endl;
+    std::cout << "  --peaks           Run the peak detector on every spectrum" << std::endl;
+    std::cout << std::endl;
+}
+
+bool parseScale(const std::string& name, friture::FrequencyScale& scale) {
+    using friture::FrequencyScale;
+    if (name == "linear") { scale = FrequencyScale::Linear; }
+    else if (name == "log") { scale = FrequencyScale::Logarithmic; }
+    else if (name == "mel") { scale = FrequencyScale::Mel; }
+    else if (name == "erb") { scale = FrequencyScale::ERB; }
+    else if (name == "octave") { scale = FrequencyScale::Octave; }
+    else { return false; }
+    return true;
+}
+
+// NAME or kaiser:BETA
+bool parseWindow(const std::string& text, friture::WindowFunction& window, float& kaiser_beta) {
+    using friture::WindowFunction;
+    const size_t colon = text.find(':');
+    const std::string name = text.substr(0, colon);
+    if (name == "hann") { window = WindowFunction::Hann; }
+    else if (name == "hamming") { window = WindowFunction::Hamming; }
+    else if (name == "blackman-harris") { window = WindowFunction::BlackmanHarris; }
+    else if (name == "flat-top") { window = WindowFunction::FlatTop; }
+    else if (name == "kaiser") { window = WindowFunction::Kaiser; }
+    else { return false; }
+    if (colon != std::string::npos) {
+        if (window != WindowFunction::Kaiser) {
+            return false;
+        }
+        kaiser_beta = std::strtof(text.c_str() + colon + 1, nullptr);
+    }
+    return true;
+}
+
+bool parseWeighting(const std::string& name, friture::WeightingType& weighting) {
+    using friture::WeightingType;
+    if (name == "none") { weighting = WeightingType::None; }
+    else if (name == "a" || name == "A") { weighting = WeightingType::A; }
+    else if (name == "b" || name == "B") { weighting = WeightingType::B; }
+    else if (name == "c" || name == "C") { weighting = WeightingType::C; }
+    else { return false; }
+    return true;
+}
+
+// MODE or MODE:VALUE (seconds for exp and peak, spectra for linear)
+bool parseAveraging(const std::string& text, friture::AveragingMode& mode,
+                    float& time_seconds, size_t& frames) {
+    using friture::AveragingMode;
+    const size_t colon = text.find(':');
+    const std::string name = text.substr(0, colon);
+    if (name == "none") { mode = AveragingMode::None; }
+    else if (name == "exp") { mode = AveragingMode::Exponential; }
+    else if (name == "linear") { mode = AveragingMode::Linear; }
+    else if (name == "peak") { mode = AveragingMode::PeakHold; }
+    else { return false; }
+    if (colon != std::string::npos) {
+        const char* value = text.c_str() + colon + 1;
+        if (mode == AveragingMode::Linear) {
+            frames = std::strtoul(value, nullptr, 10);
+        } else if (mode != AveragingMode::None) {
+            time_seconds = std::strtof(value, nullptr);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+void writeLE(std::ostream& out, T value) {
+    using Bits = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
+    static_assert(sizeof(T) == sizeof(Bits));
+    unsigned char bytes[sizeof(T)];
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<unsigned char>(bits >> (8 * i));
+    }
+    out.write(reinterpret_cast<const char*>(bytes), sizeof(T));
+}
+
+std::string hashString(uint64_t hash) {
+    std::ostringstream text;
+    text << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return text.str();
+}
+
+// Paths go into JSON strings as given; only quotes and backslashes need escaping
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void printStages(std::ostream& out, const friture::ReplayStats& stats) {
+    using friture::ProfileStage;
+    out << std::fixed << std::setprecision(2);
+    for (ProfileStage stage : {ProfileStage::Read, ProfileStage::FFT, ProfileStage::Resample}) {
+        const friture::StageStatsSnapshot& s = stats.stages[stage];
+        out << "  " << std::left << std::setw(9) << friture::toString(stage) << std::right
+            << " mean " << std::setw(8) << s.meanMicros() << " us  p50 " << std::setw(8)
+            << s.percentileMicros(0.5) << " us  p99 " << std::setw(8) << s.percentileMicros(0.99)
+            << " us  (" << s.count << " scopes)" << std::endl;
+    }
+    out << std::defaultfloat;
+}
+
+void writeJson(std::ostream& out, const std::string& input, const std::string& columns_path,
+               const friture::ReplayStats& stats, size_t runs) {
+    using friture::ProfileStage;
+    out << std::setprecision(9);
+    out << "{\n";
+    out << "  \"input\": " << jsonString(input) << ",\n";
+    out << "  \"columns_file\": " << (columns_path.empty() ? "null" : jsonString(columns_path)) << ",\n";
+    out << "  \"hash\": \"" << hashString(stats.hash) << "\",\n";
+    out << "  \"sample_rate\": " << stats.sample_rate << ",\n";
+    out << "  \"hop_size\": " << stats.hop_size << ",\n";
+    out << "  \"rows\": " << stats.rows << ",\n";
+    out << "  \"hops\": " << stats.hops << ",\n";
+    out << "  \"columns\": " << stats.columns << ",\n";
+    out << "  \"peak_events\": " << stats.peak_events << ",\n";
+    out << "  \"runs\": " << runs << ",\n";
+    out << "  \"audio_seconds\": " << stats.audio_seconds << ",\n";
+    out << "  \"seconds\": " << stats.seconds << ",\n";
+    out << "  \"columns_per_second\": " << stats.getColumnsPerSecond() << ",\n";
+    out << "  \"realtime_factor\": " << stats.getRealtimeFactor() << ",\n";
+    out << "  \"stages\": {";
+    const char* separator = "\n";
+    for (ProfileStage stage : {ProfileStage::Read, ProfileStage::FFT, ProfileStage::Resample}) {
+        const friture::StageStatsSnapshot& s = stats.stages[stage];
+        out << separator << "    \"" << friture::toString(stage) << "\": {\"count\": " << s.count
+            << ", \"total_ns\": " << s.total_ns << ", \"mean_us\": " << s.meanMicros()
+            << ", \"p50_us\": " << s.percentileMicros(0.5)
+            << ", \"p99_us\": " << s.percentileMicros(0.99)
+            << ", \"max_us\": " << s.maxMicros() << "}";
+        separator = ",\n";
+    }
+    out << "\n  }\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        friture::ReplayOptions options;
+        friture::SpectrogramSettings& settings = options.settings;
+        settings.max_freq = std::numeric_limits<float>::max();   // Clamped to Nyquist
+        std::string input;
+        std::string columns_path;
+        std::string json_path;
+        std::string wisdom_path = friture::FFTWisdom::defaultCachePath();
+        size_t repeat = 1;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool has_value = (i + 1 < argc);
+            if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "--columns" && has_value) {
+                columns_path = argv[++i];
+            } else if (arg == "--json" && has_value) {
+                json_path = argv[++i];
+            } else if (arg == "--repeat" && has_value) {
+                repeat = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--block" && has_value) {
+                options.block_frames = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--wisdom" && has_value) {
+                wisdom_path = argv[++i];
+            } else if (arg == "--fft-size" && has_value) {
+                settings.fft_size = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--overlap" && has_value) {
+                settings.overlap_percent = std::strtof(argv[++i], nullptr);
+            } else if (arg == "--height" && has_value) {
+                options.height = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--scale" && has_value) {
+                if (!parseScale(argv[++i], settings.freq_scale)) {
+                    std::cerr << "Unknown frequency scale: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--range" && has_value) {
+                char* end = nullptr;
+                settings.min_freq = std::strtof(argv[++i], &end);
+                if (*end == ':') {
+                    settings.max_freq = std::strtof(end + 1, nullptr);
+                }
+            } else if (arg == "--multi-resolution") {
+                settings.multi_resolution = true;
+            } else if (arg == "--zoom") {
+                settings.zoom = true;
+            } else if (arg == "--window" && has_value) {
+                if (!parseWindow(argv[++i], settings.window_type, settings.kaiser_beta)) {
+                    std::cerr << "Unknown window: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--weighting" && has_value) {
+                if (!parseWeighting(argv[++i], settings.weighting)) {
+                    std::cerr << "Unknown weighting: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--average" && has_value) {
+                if (!parseAveraging(argv[++i], settings.averaging, settings.averaging_time,
+                                    settings.averaging_frames)) {
+                    std::cerr << "Unknown averaging: " << argv[i] << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--decimate" && has_value) {
+                settings.column_decimation = std::strtoul(argv[++i], nullptr, 10);
+            } else if (arg == "--peaks") {
+                options.peak_detection = true;
+            } else if (!arg.empty() && arg[0] == '-') {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            } else if (input.empty()) {
+                input = arg;
+            } else {
+                std::cerr << "Only one input file can be replayed" << std::endl;
+                return 1;
+            }
+        }
+
+        if (input.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        // The same plans for every run (and, with --wisdom, for both builds)
+        friture::FFTWisdom wisdom(wisdom_path);
+        wisdom.load();
+
+        friture::ReplayHarness harness(options);
+
+        std::ofstream columns_file;
+        if (!columns_path.empty()) {
+            columns_file.open(columns_path, std::ios::binary);
+            if (!columns_file) {
+                std::cerr << "Cannot write columns: " << columns_path << std::endl;
+                return 1;
+            }
+        }
+
+        friture::ReplayStats best;
+        uint64_t first_hash = 0;
+        bool mismatch = false;
+        for (size_t run = 0; run < repeat; ++run) {
+            friture::ReplayStats stats;
+            bool header_written = false;
+            friture::ReplayHarness::ColumnCallback on_column;
+            if (run == 0 && columns_file.is_open()) {
+                on_column = [&](uint64_t window_end, const float* column_db, size_t rows) {
+                    if (!header_written) {
+                        columns_file.write(COLUMN_MAGIC, sizeof(COLUMN_MAGIC));
+                        writeLE<uint32_t>(columns_file, COLUMN_VERSION);
+                        writeLE<uint32_t>(columns_file, static_cast<uint32_t>(rows));
+                        header_written = true;
+                    }
+                    writeLE<uint64_t>(columns_file, window_end);
+                    for (size_t r = 0; r < rows; ++r) {
+                        writeLE<float>(columns_file, column_db[r]);
+                    }
+                };
+            }
+
+            if (!harness.replayFile(input.c_str(), stats, on_column)) {
+                std::cerr << input << ": " << harness.getError() << std::endl;
+                return 1;
+            }
+
+            if (run == 0) {
+                first_hash = stats.hash;
+                best = stats;
+            } else {
+                mismatch = mismatch || stats.hash != first_hash;
+                if (stats.seconds < best.seconds) {
+                    best = stats;
+                }
+            }
+        }
+
+        if (columns_file.is_open()) {
+            columns_file.flush();
+            if (!columns_file) {
+                std::cerr << "Failed to write columns: " << columns_path << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << input << ": " << best.columns << " columns x " << best.rows << " rows, hop "
+                  << best.hop_size << " at " << best.sample_rate << " Hz" << std::endl;
+        std::cout << "Hash: " << hashString(first_hash) << std::endl;
+        if (options.peak_detection) {
+            std::cout << "Peak events: " << best.peak_events << std::endl;
+        }
+        std::cout << std::fixed << std::setprecision(3) << "Time: " << best.seconds << " s for "
+                  << best.audio_seconds << " s of audio (" << std::setprecision(0)
+                  << best.getColumnsPerSecond() << " columns/s, " << std::setprecision(1)
+                  << best.getRealtimeFactor() << "x real time"
+                  << (repeat > 1 ? ", fastest of " + std::to_string(repeat) + " runs" : "") << ")"
+                  << std::defaultfloat << std::endl;
+        printStages(std::cout, best);
+
+        if (!json_path.empty()) {
+            std::ofstream json_file(json_path);
+            writeJson(json_file, input, columns_path, best, repeat);
+            if (!json_file) {
+                std::cerr << "Failed to write JSON: " << json_path << std::endl;
+                return 1;
+            }
+        }
+
+        if (mismatch) {
+            std::cerr << "Hash differs between runs: the analysis is not deterministic" << std::endl;
+        }
+        return mismatch ? 1 : 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\nFATAL ERROR: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nFATAL ERROR: Unknown exception" << std::endl;
+        return 2;
+    }
+}
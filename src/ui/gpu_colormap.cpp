@@ -0,0 +1,518 @@
+/**
+ * @file gpu_colormap.cpp
+ * @brief Implementation of GpuColormap
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-14
+ */
+
+#include <friture/ui/gpu_colormap.hpp>
+#include <cstring>
+
+#if defined(_WIN32)
+#define FRITURE_GLAPI __stdcall
+#else
+#define FRITURE_GLAPI
+#endif
+
+namespace friture {
+
+namespace {
+
+// The handful of OpenGL 2.1 types and constants used here, so no GL
+// headers or libraries are needed at build time
+using GLenum = unsigned int;
+using GLuint = unsigned int;
+using GLint = int;
+using GLsizei = int;
+using GLfloat = float;
+using GLchar = char;
+using GLboolean = unsigned char;
+
+constexpr GLenum GL_TRIANGLE_STRIP = 0x0005;
+constexpr GLenum GL_TEXTURE_1D = 0x0DE0;
+constexpr GLenum GL_TEXTURE_2D = 0x0DE1;
+constexpr GLenum GL_VIEWPORT = 0x0BA2;
+constexpr GLenum GL_BLEND = 0x0BE2;
+constexpr GLenum GL_SCISSOR_TEST = 0x0C11;
+constexpr GLenum GL_UNPACK_ROW_LENGTH = 0x0CF2;
+constexpr GLenum GL_UNPACK_ALIGNMENT = 0x0CF5;
+constexpr GLenum GL_UNSIGNED_BYTE = 0x1401;
+constexpr GLenum GL_UNSIGNED_SHORT = 0x1403;
+constexpr GLenum GL_RGBA = 0x1908;
+constexpr GLenum GL_LUMINANCE = 0x1909;
+constexpr GLenum GL_NEAREST = 0x2600;
+constexpr GLenum GL_TEXTURE_MAG_FILTER = 0x2800;
+constexpr GLenum GL_TEXTURE_MIN_FILTER = 0x2801;
+constexpr GLenum GL_TEXTURE_WRAP_S = 0x2802;
+constexpr GLenum GL_TEXTURE_WRAP_T = 0x2803;
+constexpr GLenum GL_REPEAT = 0x2901;
+constexpr GLenum GL_LUMINANCE16 = 0x8042;
+constexpr GLenum GL_RGBA8 = 0x8058;
+constexpr GLenum GL_TEXTURE_BINDING_1D = 0x8068;
+constexpr GLenum GL_TEXTURE_BINDING_2D = 0x8069;
+constexpr GLenum GL_CLAMP_TO_EDGE = 0x812F;
+constexpr GLenum GL_TEXTURE0 = 0x84C0;
+constexpr GLenum GL_TEXTURE1 = 0x84C1;
+constexpr GLenum GL_ACTIVE_TEXTURE = 0x84E0;
+constexpr GLenum GL_FRAGMENT_SHADER = 0x8B30;
+constexpr GLenum GL_VERTEX_SHADER = 0x8B31;
+constexpr GLenum GL_COMPILE_STATUS = 0x8B81;
+constexpr GLenum GL_LINK_STATUS = 0x8B82;
+constexpr GLenum GL_CURRENT_PROGRAM = 0x8B8D;
+constexpr GLenum GL_NO_ERROR = 0;
+
+// SDL's "opengl" renderer creates a 2.1 compatibility context, so the
+// shaders use GLSL 1.20 and the built-in vertex attributes
+const char* VERTEX_SHADER = R"(
+#version 120
+varying vec2 uv;
+void main() {
+    uv = gl_MultiTexCoord0.xy;
+    gl_Position = gl_Vertex;
+}
+)";
+
+// Same mapping as ColorTransform::transformColumnDb():
+// index = trunc(clamp((db - min_db) / (max_db - min_db)) * 255)
+const char* FRAGMENT_SHADER = R"(
+#version 120
+uniform sampler2D levels;
+uniform sampler1D palette;
+uniform float seam;
+uniform vec2 level_map;
+varying vec2 uv;
+void main() {
+    float level = texture2D(levels, vec2(fract(uv.x + seam), uv.y)).r;
+    float t = clamp(level * level_map.x + level_map.y, 0.0, 1.0);
+    gl_FragColor = texture1D(palette, (floor(t * 255.0) + 0.5) / 256.0);
+}
+)";
+
+template <typename F>
+bool loadFunction(F& function, const char* name) {
+    function = reinterpret_cast<F>(SDL_GL_GetProcAddress(name));
+    return function != nullptr;
+}
+
+} // namespace
+
+struct GpuColormap::GL {
+    GLenum (FRITURE_GLAPI *GetError)();
+    void (FRITURE_GLAPI *GetIntegerv)(GLenum, GLint*);
+    GLboolean (FRITURE_GLAPI *IsEnabled)(GLenum);
+    void (FRITURE_GLAPI *Enable)(GLenum);
+    void (FRITURE_GLAPI *Disable)(GLenum);
+    void (FRITURE_GLAPI *Viewport)(GLint, GLint, GLsizei, GLsizei);
+    void (FRITURE_GLAPI *PixelStorei)(GLenum, GLint);
+    void (FRITURE_GLAPI *GenTextures)(GLsizei, GLuint*);
+    void (FRITURE_GLAPI *DeleteTextures)(GLsizei, const GLuint*);
+    void (FRITURE_GLAPI *BindTexture)(GLenum, GLuint);
+    void (FRITURE_GLAPI *ActiveTexture)(GLenum);
+    void (FRITURE_GLAPI *TexParameteri)(GLenum, GLenum, GLint);
+    void (FRITURE_GLAPI *TexImage1D)(GLenum, GLint, GLint, GLsizei, GLint, GLenum, GLenum, const void*);
+    void (FRITURE_GLAPI *TexImage2D)(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*);
+    void (FRITURE_GLAPI *TexSubImage1D)(GLenum, GLint, GLint, GLsizei, GLenum, GLenum, const void*);
+    void (FRITURE_GLAPI *TexSubImage2D)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*);
+    void (FRITURE_GLAPI *Begin)(GLenum);
+    void (FRITURE_GLAPI *End)();
+    void (FRITURE_GLAPI *TexCoord2f)(GLfloat, GLfloat);
+    void (FRITURE_GLAPI *Vertex2f)(GLfloat, GLfloat);
+    GLuint (FRITURE_GLAPI *CreateShader)(GLenum);
+    void (FRITURE_GLAPI *ShaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*);
+    void (FRITURE_GLAPI *CompileShader)(GLuint);
+    void (FRITURE_GLAPI *GetShaderiv)(GLuint, GLenum, GLint*);
+    void (FRITURE_GLAPI *GetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+    void (FRITURE_GLAPI *DeleteShader)(GLuint);
+    GLuint (FRITURE_GLAPI *CreateProgram)();
+    void (FRITURE_GLAPI *AttachShader)(GLuint, GLuint);
+    void (FRITURE_GLAPI *LinkProgram)(GLuint);
+    void (FRITURE_GLAPI *GetProgramiv)(GLuint, GLenum, GLint*);
+    void (FRITURE_GLAPI *GetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+    void (FRITURE_GLAPI *DeleteProgram)(GLuint);
+    void (FRITURE_GLAPI *UseProgram)(GLuint);
+    GLint (FRITURE_GLAPI *GetUniformLocation)(GLuint, const GLchar*);
+    void (FRITURE_GLAPI *Uniform1i)(GLint, GLint);
+    void (FRITURE_GLAPI *Uniform1f)(GLint, GLfloat);
+    void (FRITURE_GLAPI *Uniform2f)(GLint, GLfloat, GLfloat);
+};
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+GpuColormap::GpuColormap(SDL_Renderer* renderer, size_t width, size_t height)
+    : renderer_(renderer),
+      width_(width),
+      height_(height),
+      gl_(std::make_unique<GL>())
+{
+    SDL_RendererInfo info;
+    if (!renderer_ || SDL_GetRendererInfo(renderer_, &info) != 0 ||
+        std::strcmp(info.name, "opengl") != 0) {
+        setError("Renderer is not using the OpenGL driver");
+        return;
+    }
+
+    // SDL makes the renderer's context current when it creates it
+    if (!SDL_GL_GetCurrentContext()) {
+        setError("No current OpenGL context");
+        return;
+    }
+
+    if (!loadFunctions()) {
+        return;
+    }
+
+    // Discard errors left behind by earlier SDL calls
+    while (gl_->GetError() != GL_NO_ERROR) {
+    }
+
+    if (!buildProgram()) {
+        return;
+    }
+
+    createTextures();
+    if (gl_->GetError() != GL_NO_ERROR) {
+        setError("Cannot create 16-bit level texture");
+        return;
+    }
+
+    initialized_ = true;
+}
+
+GpuColormap::~GpuColormap() {
+    // Only objects created after the functions loaded can exist
+    if (level_texture_) {
+        gl_->DeleteTextures(1, &level_texture_);
+    }
+    if (palette_texture_) {
+        gl_->DeleteTextures(1, &palette_texture_);
+    }
+    if (program_) {
+        gl_->DeleteProgram(program_);
+    }
+}
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+bool GpuColormap::loadFunctions() {
+    GL& gl = *gl_;
+    bool ok = loadFunction(gl.GetError, "glGetError") &&
+              loadFunction(gl.GetIntegerv, "glGetIntegerv") &&
+              loadFunction(gl.IsEnabled, "glIsEnabled") &&
+              loadFunction(gl.Enable, "glEnable") &&
+              loadFunction(gl.Disable, "glDisable") &&
+              loadFunction(gl.Viewport, "glViewport") &&
+              loadFunction(gl.PixelStorei, "glPixelStorei") &&
+              loadFunction(gl.GenTextures, "glGenTextures") &&
+              loadFunction(gl.DeleteTextures, "glDeleteTextures") &&
+              loadFunction(gl.BindTexture, "glBindTexture") &&
+              loadFunction(gl.ActiveTexture, "glActiveTexture") &&
+              loadFunction(gl.TexParameteri, "glTexParameteri") &&
+              loadFunction(gl.TexImage1D, "glTexImage1D") &&
+              loadFunction(gl.TexImage2D, "glTexImage2D") &&
+              loadFunction(gl.TexSubImage1D, "glTexSubImage1D") &&
+              loadFunction(gl.TexSubImage2D, "glTexSubImage2D") &&
+              loadFunction(gl.Begin, "glBegin") &&
+              loadFunction(gl.End, "glEnd") &&
+              loadFunction(gl.TexCoord2f, "glTexCoord2f") &&
+              loadFunction(gl.Vertex2f, "glVertex2f") &&
+              loadFunction(gl.CreateShader, "glCreateShader") &&
+              loadFunction(gl.ShaderSource, "glShaderSource") &&
+              loadFunction(gl.CompileShader, "glCompileShader") &&
+              loadFunction(gl.GetShaderiv, "glGetShaderiv") &&
+              loadFunction(gl.GetShaderInfoLog, "glGetShaderInfoLog") &&
+              loadFunction(gl.DeleteShader, "glDeleteShader") &&
+              loadFunction(gl.CreateProgram, "glCreateProgram") &&
+              loadFunction(gl.AttachShader, "glAttachShader") &&
+              loadFunction(gl.LinkProgram, "glLinkProgram") &&
+              loadFunction(gl.GetProgramiv, "glGetProgramiv") &&
+              loadFunction(gl.GetProgramInfoLog, "glGetProgramInfoLog") &&
+              loadFunction(gl.DeleteProgram, "glDeleteProgram") &&
+              loadFunction(gl.UseProgram, "glUseProgram") &&
+              loadFunction(gl.GetUniformLocation, "glGetUniformLocation") &&
+              loadFunction(gl.Uniform1i, "glUniform1i") &&
+              loadFunction(gl.Uniform1f, "glUniform1f") &&
+              loadFunction(gl.Uniform2f, "glUniform2f");
+
+    if (!ok) {
+        setError("OpenGL 2.1 functions unavailable");
+    }
+    return ok;
+}
+
+bool GpuColormap::buildProgram() {
+    GL& gl = *gl_;
+
+    auto compile = [&](GLenum type, const char* source) -> GLuint {
+        GLuint shader = gl.CreateShader(type);
+        gl.ShaderSource(shader, 1, &source, nullptr);
+        gl.CompileShader(shader);
+
+        GLint status = 0;
+        gl.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+        if (!status) {
+            char log[512] = {};
+            gl.GetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            setError(std::string("Shader compilation failed: ") + log);
+            gl.DeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    };
+
+    GLuint vertex = compile(GL_VERTEX_SHADER, VERTEX_SHADER);
+    GLuint fragment = vertex ? compile(GL_FRAGMENT_SHADER, FRAGMENT_SHADER) : 0;
+    if (!fragment) {
+        if (vertex) {
+            gl.DeleteShader(vertex);
+        }
+        return false;
+    }
+
+    program_ = gl.CreateProgram();
+    gl.AttachShader(program_, vertex);
+    gl.AttachShader(program_, fragment);
+    gl.LinkProgram(program_);
+
+    // The program keeps the compiled code
+    gl.DeleteShader(vertex);
+    gl.DeleteShader(fragment);
+
+    GLint status = 0;
+    gl.GetProgramiv(program_, GL_LINK_STATUS, &status);
+    if (!status) {
+        char log[512] = {};
+        gl.GetProgramInfoLog(program_, sizeof(log), nullptr, log);
+        setError(std::string("Shader link failed: ") + log);
+        return false;
+    }
+
+    seam_location_ = gl.GetUniformLocation(program_, "seam");
+    level_map_location_ = gl.GetUniformLocation(program_, "level_map");
+
+    // Sampler units never change: levels on unit 0, palette on unit 1
+    GLint previous_program = 0;
+    gl.GetIntegerv(GL_CURRENT_PROGRAM, &previous_program);
+    gl.UseProgram(program_);
+    gl.Uniform1i(gl.GetUniformLocation(program_, "levels"), 0);
+    gl.Uniform1i(gl.GetUniformLocation(program_, "palette"), 1);
+    gl.UseProgram(static_cast<GLuint>(previous_program));
+
+    return true;
+}
+
+void GpuColormap::createTextures() {
+    GL& gl = *gl_;
+
+    GLint previous_unit = 0;
+    GLint previous_2d = 0;
+    GLint previous_1d = 0;
+    gl.GetIntegerv(GL_ACTIVE_TEXTURE, &previous_unit);
+    gl.ActiveTexture(GL_TEXTURE0);
+    gl.GetIntegerv(GL_TEXTURE_BINDING_2D, &previous_2d);
+    gl.GetIntegerv(GL_TEXTURE_BINDING_1D, &previous_1d);
+
+    // Level ring: nearest sampling so every screen column is one analysis
+    // column; S repeats so the seam offset can wrap in the shader
+    gl.GenTextures(1, &level_texture_);
+    gl.BindTexture(GL_TEXTURE_2D, level_texture_);
+    gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    gl.TexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE16,
+                  static_cast<GLsizei>(width_), static_cast<GLsizei>(height_), 0,
+                  GL_LUMINANCE, GL_UNSIGNED_SHORT, nullptr);
+
+    gl.GenTextures(1, &palette_texture_);
+    gl.BindTexture(GL_TEXTURE_1D, palette_texture_);
+    gl.TexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    gl.TexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    gl.TexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl.TexImage1D(GL_TEXTURE_1D, 0, GL_RGBA8, 256, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    gl.BindTexture(GL_TEXTURE_1D, static_cast<GLuint>(previous_1d));
+    gl.BindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previous_2d));
+    gl.ActiveTexture(static_cast<GLenum>(previous_unit));
+}
+
+void GpuColormap::resize(size_t width, size_t height) {
+    width_ = width;
+    height_ = height;
+    if (!initialized_) {
+        return;
+    }
+
+    GL& gl = *gl_;
+    GLint previous_unit = 0;
+    GLint previous_2d = 0;
+    gl.GetIntegerv(GL_ACTIVE_TEXTURE, &previous_unit);
+    gl.ActiveTexture(GL_TEXTURE0);
+    gl.GetIntegerv(GL_TEXTURE_BINDING_2D, &previous_2d);
+
+    gl.BindTexture(GL_TEXTURE_2D, level_texture_);
+    gl.TexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE16,
+                  static_cast<GLsizei>(width_), static_cast<GLsizei>(height_), 0,
+                  GL_LUMINANCE, GL_UNSIGNED_SHORT, nullptr);
+
+    gl.BindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previous_2d));
+    gl.ActiveTexture(static_cast<GLenum>(previous_unit));
+}
+
+void GpuColormap::setError(const std::string& message) {
+    error_ = message;
+}
+
+// ============================================================================
+// Upload
+// ============================================================================
+
+void GpuColormap::setPalette(const std::array<uint32_t, 256>& palette) {
+    if (!initialized_) {
+        return;
+    }
+    GL& gl = *gl_;
+
+    GLint previous_unit = 0;
+    GLint previous_1d = 0;
+    GLint previous_row_length = 0;
+    gl.GetIntegerv(GL_ACTIVE_TEXTURE, &previous_unit);
+    gl.ActiveTexture(GL_TEXTURE0);
+    gl.GetIntegerv(GL_TEXTURE_BINDING_1D, &previous_1d);
+    gl.GetIntegerv(GL_UNPACK_ROW_LENGTH, &previous_row_length);
+
+    // 0xAABBGGRR little-endian is R, G, B, A in memory
+    gl.PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    gl.BindTexture(GL_TEXTURE_1D, palette_texture_);
+    gl.TexSubImage1D(GL_TEXTURE_1D, 0, 0, 256, GL_RGBA, GL_UNSIGNED_BYTE, palette.data());
+
+    gl.PixelStorei(GL_UNPACK_ROW_LENGTH, previous_row_length);
+    gl.BindTexture(GL_TEXTURE_1D, static_cast<GLuint>(previous_1d));
+    gl.ActiveTexture(static_cast<GLenum>(previous_unit));
+}
+
+void GpuColormap::upload(const SpectrogramImage& image) {
+    if (!initialized_ || image.getPlane() != ImagePlane::Levels ||
+        image.getWidth() != width_ || image.getHeight() != height_) {
+        return;
+    }
+
+    ColumnSpan spans[2];
+    const size_t num_spans = image.getDirtySpans(spans);
+    if (num_spans == 0) {
+        return;
+    }
+
+    GL& gl = *gl_;
+
+    GLint previous_unit = 0;
+    GLint previous_2d = 0;
+    GLint previous_row_length = 0;
+    GLint previous_alignment = 0;
+    gl.GetIntegerv(GL_ACTIVE_TEXTURE, &previous_unit);
+    gl.ActiveTexture(GL_TEXTURE0);
+    gl.GetIntegerv(GL_TEXTURE_BINDING_2D, &previous_2d);
+    gl.GetIntegerv(GL_UNPACK_ROW_LENGTH, &previous_row_length);
+    gl.GetIntegerv(GL_UNPACK_ALIGNMENT, &previous_alignment);
+
+    // Image rows are getRowPitch() levels apart, so a run of columns is a
+    // sub-rectangle GL can read in place
+    gl.PixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(image.getRowPitch()));
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    gl.BindTexture(GL_TEXTURE_2D, level_texture_);
+
+    const uint16_t* levels = image.getLevelData();
+    for (size_t i = 0; i < num_spans; ++i) {
+        gl.TexSubImage2D(GL_TEXTURE_2D, 0,
+                         static_cast<GLint>(spans[i].texture_column), 0,
+                         static_cast<GLsizei>(spans[i].count), static_cast<GLsizei>(height_),
+                         GL_LUMINANCE, GL_UNSIGNED_SHORT,
+                         levels + spans[i].image_column);
+    }
+
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, previous_alignment);
+    gl.PixelStorei(GL_UNPACK_ROW_LENGTH, previous_row_length);
+    gl.BindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previous_2d));
+    gl.ActiveTexture(static_cast<GLenum>(previous_unit));
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void GpuColormap::draw(const SDL_Rect& dst, size_t seam, float min_db, float max_db) {
+    if (!initialized_ || max_db <= min_db) {
+        return;
+    }
+
+    // Execute everything SDL queued so far, so the spectrogram lands
+    // between the clear and the UI overlay
+    SDL_RenderFlush(renderer_);
+
+    int output_width = 0;
+    int output_height = 0;
+    SDL_GetRendererOutputSize(renderer_, &output_width, &output_height);
+
+    GL& gl = *gl_;
+
+    GLint previous_program = 0;
+    GLint previous_unit = 0;
+    GLint previous_2d = 0;
+    GLint previous_1d = 0;
+    GLint previous_viewport[4] = {};
+    gl.GetIntegerv(GL_CURRENT_PROGRAM, &previous_program);
+    gl.GetIntegerv(GL_ACTIVE_TEXTURE, &previous_unit);
+    gl.GetIntegerv(GL_VIEWPORT, previous_viewport);
+    const bool blend = gl.IsEnabled(GL_BLEND);
+    const bool scissor = gl.IsEnabled(GL_SCISSOR_TEST);
+
+    gl.ActiveTexture(GL_TEXTURE1);
+    gl.GetIntegerv(GL_TEXTURE_BINDING_1D, &previous_1d);
+    gl.BindTexture(GL_TEXTURE_1D, palette_texture_);
+    gl.ActiveTexture(GL_TEXTURE0);
+    gl.GetIntegerv(GL_TEXTURE_BINDING_2D, &previous_2d);
+    gl.BindTexture(GL_TEXTURE_2D, level_texture_);
+
+    // Level l/65535 is LEVEL_MIN_DB + l/65535 * (LEVEL_MAX_DB - LEVEL_MIN_DB);
+    // fold that and the display range into one multiply-add
+    const float range = max_db - min_db;
+    const float level_scale = (LEVEL_MAX_DB - LEVEL_MIN_DB) / range;
+    const float level_offset = (LEVEL_MIN_DB - min_db) / range;
+
+    gl.UseProgram(program_);
+    gl.Uniform1f(seam_location_, static_cast<float>(seam) / static_cast<float>(width_));
+    gl.Uniform2f(level_map_location_, level_scale, level_offset);
+
+    // GL's window origin is bottom-left; draw a full-viewport quad
+    gl.Disable(GL_BLEND);
+    gl.Disable(GL_SCISSOR_TEST);
+    gl.Viewport(dst.x, output_height - (dst.y + dst.h), dst.w, dst.h);
+
+    gl.Begin(GL_TRIANGLE_STRIP);
+    gl.TexCoord2f(0.0f, 0.0f); gl.Vertex2f(-1.0f,  1.0f);
+    gl.TexCoord2f(1.0f, 0.0f); gl.Vertex2f( 1.0f,  1.0f);
+    gl.TexCoord2f(0.0f, 1.0f); gl.Vertex2f(-1.0f, -1.0f);
+    gl.TexCoord2f(1.0f, 1.0f); gl.Vertex2f( 1.0f, -1.0f);
+    gl.End();
+
+    // Restore exactly what SDL's state cache believes is current
+    gl.Viewport(previous_viewport[0], previous_viewport[1],
+                previous_viewport[2], previous_viewport[3]);
+    if (scissor) {
+        gl.Enable(GL_SCISSOR_TEST);
+    }
+    if (blend) {
+        gl.Enable(GL_BLEND);
+    }
+    gl.UseProgram(static_cast<GLuint>(previous_program));
+    gl.BindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previous_2d));
+    gl.ActiveTexture(GL_TEXTURE1);
+    gl.BindTexture(GL_TEXTURE_1D, static_cast<GLuint>(previous_1d));
+    gl.ActiveTexture(static_cast<GLenum>(previous_unit));
+}
+
+} // namespace friture
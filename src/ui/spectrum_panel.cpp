@@ -0,0 +1,179 @@
+/**
+ * @file spectrum_panel.cpp
+ * @brief Implementation of SpectrumPanel
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/ui/spectrum_panel.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "SpectrumPanel needs SDL 2.0.18 or newer (SDL_RenderGeometry)"
+#endif
+
+namespace friture {
+
+namespace {
+
+constexpr SDL_Color BACKGROUND = {0, 0, 0, 190};
+constexpr SDL_Color GRID = {255, 255, 255, 40};
+constexpr SDL_Color CURVE = {90, 220, 255, 255};
+constexpr SDL_Color PEAK = {255, 200, 60, 200};
+constexpr SDL_Color BAR = {70, 170, 230, 230};
+constexpr SDL_Color BAR_PEAK = {255, 255, 255, 230};
+
+constexpr float CURVE_WIDTH = 1.5f;
+constexpr float PEAK_WIDTH = 1.0f;
+constexpr float BAR_GAP = 2.0f;
+constexpr float PEAK_TICK = 2.0f;
+
+// Screen y of a level, clamped to the area
+float levelY(const SDL_Rect& area, float db, float min_db, float max_db) {
+    const float t = std::clamp((db - min_db) / (max_db - min_db), 0.0f, 1.0f);
+    return static_cast<float>(area.y + area.h) - t * static_cast<float>(area.h);
+}
+
+} // namespace
+
+SpectrumPanel::SpectrumPanel(SDL_Renderer* renderer)
+    : renderer_(renderer)
+{
+}
+
+// ============================================================================
+// Geometry
+// ============================================================================
+
+void SpectrumPanel::beginPanel(const SDL_Rect& area, float min_db, float max_db) {
+    vertices_.clear();
+    indices_.clear();
+
+    const float x0 = static_cast<float>(area.x);
+    const float x1 = static_cast<float>(area.x + area.w);
+    addRect(x0, static_cast<float>(area.y), x1, static_cast<float>(area.y + area.h), BACKGROUND);
+
+    // Horizontal lines on multiples of GRID_DB
+    for (float db = std::ceil(min_db / GRID_DB) * GRID_DB; db <= max_db; db += GRID_DB) {
+        const float y = levelY(area, db, min_db, max_db);
+        addRect(x0, y, x1, y + 1.0f, GRID);
+    }
+}
+
+void SpectrumPanel::addRect(float x0, float y0, float x1, float y1, SDL_Color color) {
+    const int base = static_cast<int>(vertices_.size());
+    vertices_.push_back({{x0, y0}, color, {0.0f, 0.0f}});
+    vertices_.push_back({{x1, y0}, color, {0.0f, 0.0f}});
+    vertices_.push_back({{x1, y1}, color, {0.0f, 0.0f}});
+    vertices_.push_back({{x0, y1}, color, {0.0f, 0.0f}});
+    for (int i : {0, 1, 2, 0, 2, 3}) {
+        indices_.push_back(base + i);
+    }
+}
+
+void SpectrumPanel::addPolyline(float width, SDL_Color color) {
+    // One quad per segment, offset along its normal; joins are not mitred,
+    // which is invisible at these widths
+    const float half = 0.5f * width;
+    for (size_t i = 1; i < points_.size(); ++i) {
+        const SDL_FPoint a = points_[i - 1];
+        const SDL_FPoint b = points_[i];
+        const float dx = b.x - a.x;
+        const float dy = b.y - a.y;
+        const float length = std::sqrt(dx * dx + dy * dy);
+        if (length <= 0.0f) {
+            continue;
+        }
+        const float nx = -dy / length * half;
+        const float ny = dx / length * half;
+
+        const int base = static_cast<int>(vertices_.size());
+        vertices_.push_back({{a.x + nx, a.y + ny}, color, {0.0f, 0.0f}});
+        vertices_.push_back({{b.x + nx, b.y + ny}, color, {0.0f, 0.0f}});
+        vertices_.push_back({{b.x - nx, b.y - ny}, color, {0.0f, 0.0f}});
+        vertices_.push_back({{a.x - nx, a.y - ny}, color, {0.0f, 0.0f}});
+        for (int k : {0, 1, 2, 0, 2, 3}) {
+            indices_.push_back(base + k);
+        }
+    }
+}
+
+bool SpectrumPanel::submit() {
+    last_triangles_ = indices_.size() / 3;
+
+    SDL_BlendMode previous = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(renderer_, &previous);
+    SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+    const int result = SDL_RenderGeometry(renderer_, nullptr,
+                                          vertices_.data(), static_cast<int>(vertices_.size()),
+                                          indices_.data(), static_cast<int>(indices_.size()));
+    SDL_SetRenderDrawBlendMode(renderer_, previous);
+    return result == 0;
+}
+
+void SpectrumPanel::buildCurve(const SDL_Rect& area, const std::vector<float>& db,
+                               float min_db, float max_db) {
+    points_.clear();
+    const size_t rows = db.size();
+    const size_t count = std::min(rows, static_cast<size_t>(area.w));
+    const float step = static_cast<float>(area.w) / static_cast<float>(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        // Loudest row of the pixel column, so narrow peaks survive
+        const size_t first = i * rows / count;
+        const size_t end = (i + 1) * rows / count;
+        const float value = *std::max_element(db.begin() + static_cast<std::ptrdiff_t>(first),
+                                              db.begin() + static_cast<std::ptrdiff_t>(end));
+        points_.push_back({static_cast<float>(area.x) + (static_cast<float>(i) + 0.5f) * step,
+                           levelY(area, value, min_db, max_db)});
+    }
+}
+
+// ============================================================================
+// Panels
+// ============================================================================
+
+bool SpectrumPanel::drawSpectrum(const SDL_Rect& area, const SpectrumViews& views,
+                                 float min_db, float max_db) {
+    if (views.getHeight() == 0 || area.w < 2 || area.h < 2 || !(max_db > min_db)) {
+        return false;
+    }
+    beginPanel(area, min_db, max_db);
+
+    buildCurve(area, views.getSpectrumPeaks(), min_db, max_db);
+    addPolyline(PEAK_WIDTH, PEAK);
+    buildCurve(area, views.getSpectrum(), min_db, max_db);
+    addPolyline(CURVE_WIDTH, CURVE);
+
+    return submit();
+}
+
+bool SpectrumPanel::drawBands(const SDL_Rect& area, const SpectrumViews& views,
+                              float min_db, float max_db) {
+    const size_t count = views.getBands().size();
+    if (count == 0 || area.w < 2 || area.h < 2 || !(max_db > min_db)) {
+        return false;
+    }
+    beginPanel(area, min_db, max_db);
+
+    const std::vector<float>& levels = views.getBandLevels();
+    const std::vector<float>& peaks = views.getBandPeaks();
+    const float pitch = static_cast<float>(area.w) / static_cast<float>(count);
+    const float gap = pitch > 2.0f * BAR_GAP ? BAR_GAP : 0.0f;
+    const float bottom = static_cast<float>(area.y + area.h);
+
+    for (size_t b = 0; b < count; ++b) {
+        const float x0 = static_cast<float>(area.x) + static_cast<float>(b) * pitch + 0.5f * gap;
+        const float x1 = x0 + pitch - gap;
+        addRect(x0, levelY(area, levels[b], min_db, max_db), x1, bottom, BAR);
+
+        const float peak_y = levelY(area, peaks[b], min_db, max_db);
+        addRect(x0, peak_y, x1, std::min(peak_y + PEAK_TICK, bottom), BAR_PEAK);
+    }
+
+    return submit();
+}
+
+} // namespace friture
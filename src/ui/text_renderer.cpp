@@ -4,9 +4,14 @@
  */
 
 #include <friture/ui/text_renderer.hpp>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "TextRenderer needs SDL 2.0.18 or newer (SDL_RenderGeometry)"
+#endif
+
 namespace friture {
 
 // ============================================================================
@@ -15,6 +20,9 @@ namespace friture {
 
 TextRenderer::TextRenderer(SDL_Renderer* renderer)
     : renderer_(renderer),
+      atlas_texture_(nullptr),
+      atlas_used_height_(0),
+      batch_(renderer),
       initialized_(false)
 {
     if (!renderer_) {
@@ -33,10 +41,20 @@ TextRenderer::TextRenderer(SDL_Renderer* renderer)
         return;
     }
 
+    if (!createAtlasTexture()) {
+        return;
+    }
+
     initialized_ = true;
 }
 
 TextRenderer::~TextRenderer() {
+    // The atlas texture belongs to renderer_, which outlives us
+    if (atlas_texture_) {
+        SDL_DestroyTexture(atlas_texture_);
+    }
+    atlases_.clear();
+
     // Free all cached fonts
     for (auto& pair : fonts_) {
         if (pair.second) {
@@ -110,72 +128,243 @@ TTF_Font* TextRenderer::loadFont(int font_size) {
 }
 
 // ============================================================================
-// Text Rendering
+// Glyph Atlas
 // ============================================================================
 
-SDL_Surface* TextRenderer::renderTextToSurface(const std::string& text,
-                                              TTF_Font* font,
-                                              SDL_Color color) {
-    if (!font || text.empty()) {
+bool TextRenderer::createAtlasTexture() {
+    atlas_texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                       ATLAS_WIDTH, ATLAS_HEIGHT);
+    if (!atlas_texture_) {
+        setError(std::string("Glyph atlas creation failed: ") + SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas_texture_, SDL_BLENDMODE_BLEND);
+
+    // Plain UiBatch shapes sample the middle of this cell, so filtering
+    // never reaches the transparent texels around it
+    std::array<Uint32, WHITE_CELL * WHITE_CELL> white;
+    white.fill(0xFFFFFFFFu);
+    const SDL_Rect cell = {0, 0, WHITE_CELL, WHITE_CELL};
+    if (SDL_UpdateTexture(atlas_texture_, &cell, white.data(), WHITE_CELL * 4) < 0) {
+        setError(std::string("Glyph atlas upload failed: ") + SDL_GetError());
+        return false;
+    }
+    atlas_used_height_ = WHITE_CELL + 1;
+    return true;
+}
+
+TextRenderer::GlyphAtlas* TextRenderer::getAtlas(int font_size) {
+    auto it = atlases_.find(font_size);
+    if (it != atlases_.end()) {
+        return &it->second;
+    }
+
+    TTF_Font* font = loadFont(font_size);
+    if (!font) {
         return nullptr;
     }
 
-    // Render text to surface (blended for better quality)
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), color);
-    if (!surface) {
-        setError(std::string("Text rendering failed: ") + TTF_GetError());
+    GlyphAtlas atlas;
+    if (!buildAtlas(font, atlas)) {
         return nullptr;
     }
+    return &atlases_.emplace(font_size, std::move(atlas)).first->second;
+}
+
+bool TextRenderer::buildAtlas(TTF_Font* font, GlyphAtlas& atlas) {
+    const SDL_Color white = {255, 255, 255, 255};
+    atlas.line_height = TTF_FontHeight(font);
+
+    // Rasterize every glyph once and pack the cells into rows
+    std::array<SDL_Surface*, GLYPH_COUNT> cells{};
+    int pen_x = 0;
+    int pen_y = 0;
+    int row_height = atlas.line_height;
+    for (int i = 0; i < GLYPH_COUNT; ++i) {
+        const Uint16 ch = static_cast<Uint16>(FIRST_GLYPH + i);
+        Glyph& glyph = atlas.glyphs[i];
+        int min_x, max_x, min_y, max_y;
+        if (TTF_GlyphMetrics(font, ch, &min_x, &max_x, &min_y, &max_y, &glyph.advance) < 0) {
+            glyph.advance = 0;
+        }
+        glyph.src = {0, 0, 0, 0};
+
+        if (ch == ' ') {
+            continue;  // Advance only
+        }
+        cells[i] = TTF_RenderGlyph_Blended(font, ch, white);
+        if (!cells[i]) {
+            continue;  // Not in the font; drawn as nothing
+        }
+
+        if (pen_x + cells[i]->w > ATLAS_WIDTH) {
+            pen_x = 0;
+            pen_y += row_height + 1;
+            row_height = atlas.line_height;
+        }
+        row_height = std::max(row_height, cells[i]->h);
+        glyph.src = {pen_x, pen_y, cells[i]->w, cells[i]->h};
+        pen_x += cells[i]->w + 1;  // 1 px gutter
+    }
 
-    return surface;
+    // The rows of this size go below those of the sizes built before
+    const SDL_Rect region = {0, atlas_used_height_, ATLAS_WIDTH, pen_y + row_height};
+    const bool fits = region.y + region.h <= ATLAS_HEIGHT;
+    SDL_Surface* sheet = fits ? SDL_CreateRGBSurfaceWithFormat(0, region.w, region.h, 32,
+                                                               SDL_PIXELFORMAT_RGBA32)
+                              : nullptr;
+    bool ok = sheet != nullptr;
+    if (ok) {
+        SDL_FillRect(sheet, nullptr, 0);  // Transparent
+        for (int i = 0; i < GLYPH_COUNT; ++i) {
+            if (cells[i]) {
+                // Copy coverage as-is instead of blending onto the empty sheet
+                SDL_SetSurfaceBlendMode(cells[i], SDL_BLENDMODE_NONE);
+                SDL_Rect dst = atlas.glyphs[i].src;
+                SDL_BlitSurface(cells[i], nullptr, sheet, &dst);
+            }
+        }
+        ok = SDL_UpdateTexture(atlas_texture_, &region, sheet->pixels, sheet->pitch) == 0;
+    }
+
+    for (SDL_Surface* cell : cells) {
+        if (cell) {
+            SDL_FreeSurface(cell);
+        }
+    }
+    if (sheet) {
+        SDL_FreeSurface(sheet);
+    }
+
+    if (!fits) {
+        setError("Glyph atlas full");
+        return false;
+    }
+    if (!ok) {
+        setError(std::string("Glyph atlas upload failed: ") + SDL_GetError());
+        return false;
+    }
+    for (Glyph& glyph : atlas.glyphs) {
+        glyph.src.y += region.y;
+    }
+    atlas_used_height_ += region.h + 1;
+    return true;
 }
 
-bool TextRenderer::renderText(const std::string& text, int x, int y,
-                              SDL_Color color, int font_size) {
+size_t TextRenderer::getCachedLabelCount() const {
+    size_t count = 0;
+    for (const auto& pair : atlases_) {
+        count += pair.second.labels.size();
+    }
+    return count;
+}
+
+// ============================================================================
+// Text Rendering
+// ============================================================================
+
+const TextRenderer::LabelLayout* TextRenderer::getLabel(const std::string& text, int font_size,
+                                                        const GlyphAtlas** atlas_out) {
     if (!initialized_ || text.empty()) {
-        return false;
+        return nullptr;
     }
 
-    TTF_Font* font = loadFont(font_size);
-    if (!font) {
-        return false;
+    GlyphAtlas* atlas = getAtlas(font_size);
+    if (!atlas) {
+        return nullptr;
     }
+    *atlas_out = atlas;
 
-    SDL_Surface* surface = renderTextToSurface(text, font, color);
-    if (!surface) {
-        return false;
+    auto it = atlas->labels.find(text);
+    if (it != atlas->labels.end()) {
+        return &it->second;
     }
 
-    // Create texture from surface
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
-    if (!texture) {
-        SDL_FreeSurface(surface);
-        setError(std::string("Texture creation failed: ") + SDL_GetError());
-        return false;
+    // Changing labels (FPS, levels) keep adding entries; start over rather
+    // than track recency, the static ones are re-laid out on next use
+    if (atlas->labels.size() >= MAX_CACHED_LABELS) {
+        atlas->labels.clear();
+    }
+
+    LabelLayout layout;
+    layout.height = atlas->line_height;
+    layout.glyphs.reserve(text.size());
+    int pen_x = 0;
+    for (char c : text) {
+        int index = static_cast<unsigned char>(c) - FIRST_GLYPH;
+        if (index < 0 || index >= GLYPH_COUNT) {
+            index = '?' - FIRST_GLYPH;
+        }
+        const Glyph& glyph = atlas->glyphs[index];
+        if (glyph.src.w > 0) {
+            layout.glyphs.push_back({pen_x, glyph.src});
+            layout.width = std::max(layout.width, pen_x + glyph.src.w);
+        }
+        pen_x += glyph.advance;
     }
+    layout.width = std::max(layout.width, pen_x);
 
-    // Render texture
-    SDL_Rect dst_rect = {x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer_, texture, nullptr, &dst_rect);
+    return &atlas->labels.emplace(text, std::move(layout)).first->second;
+}
+
+void TextRenderer::appendQuads(UiBatch& batch, const LabelLayout& label,
+                               int x, int y, SDL_Color color) const {
+    const float inv_w = 1.0f / ATLAS_WIDTH;
+    const float inv_h = 1.0f / ATLAS_HEIGHT;
+
+    for (const PlacedGlyph& glyph : label.glyphs) {
+        const float x0 = static_cast<float>(x + glyph.x);
+        const float y0 = static_cast<float>(y);
+        const float x1 = x0 + glyph.src.w;
+        const float y1 = y0 + glyph.src.h;
+        const float u0 = glyph.src.x * inv_w;
+        const float v0 = glyph.src.y * inv_h;
+        const float u1 = (glyph.src.x + glyph.src.w) * inv_w;
+        const float v1 = (glyph.src.y + glyph.src.h) * inv_h;
+        batch.addTexturedQuad(x0, y0, x1, y1, u0, v0, u1, v1, color);
+    }
+}
 
-    // Cleanup
-    SDL_DestroyTexture(texture);
-    SDL_FreeSurface(surface);
+bool TextRenderer::drawLabel(const LabelLayout& label, int x, int y,
+                             SDL_Color color, const SDL_Color* shadow_color, int shadow_offset) {
+    if (label.glyphs.empty()) {
+        return true;  // Only spaces
+    }
+
+    beginBatch(batch_);
+    if (shadow_color) {
+        appendQuads(batch_, label, x + shadow_offset, y + shadow_offset, *shadow_color);
+    }
+    appendQuads(batch_, label, x, y, color);
 
+    if (!batch_.flush()) {
+        setError(std::string("Text drawing failed: ") + SDL_GetError());
+        return false;
+    }
     return true;
 }
 
+bool TextRenderer::renderText(const std::string& text, int x, int y,
+                              SDL_Color color, int font_size) {
+    const GlyphAtlas* atlas = nullptr;
+    const LabelLayout* label = getLabel(text, font_size, &atlas);
+    if (!label) {
+        return false;
+    }
+    return drawLabel(*label, x, y, color, nullptr, 0);
+}
+
 bool TextRenderer::renderTextWithShadow(const std::string& text, int x, int y,
                                        SDL_Color color, SDL_Color shadow_color,
                                        int font_size, int shadow_offset) {
-    // Render shadow first (offset)
-    if (!renderText(text, x + shadow_offset, y + shadow_offset,
-                   shadow_color, font_size)) {
+    const GlyphAtlas* atlas = nullptr;
+    const LabelLayout* label = getLabel(text, font_size, &atlas);
+    if (!label) {
         return false;
     }
 
-    // Render main text on top
-    return renderText(text, x, y, color, font_size);
+    // Shadow quads first, main text on top, in the same batch
+    return drawLabel(*label, x, y, color, &shadow_color, shadow_offset);
 }
 
 bool TextRenderer::renderTextRightAlign(const std::string& text, int x, int y,
@@ -201,25 +390,73 @@ bool TextRenderer::renderTextCentered(const std::string& text, int x, int y,
 }
 
 // ============================================================================
-// Utility Methods
+// Batched Text
 // ============================================================================
 
-bool TextRenderer::getTextSize(const std::string& text, int font_size,
-                               int& width, int& height) {
-    if (!initialized_ || text.empty()) {
+void TextRenderer::beginBatch(UiBatch& batch) const {
+    // Middle of the white cell
+    const SDL_FPoint white = {0.5f * WHITE_CELL / ATLAS_WIDTH, 0.5f * WHITE_CELL / ATLAS_HEIGHT};
+    batch.begin(atlas_texture_, white);
+}
+
+bool TextRenderer::checkBatch(const UiBatch& batch) {
+    if (!initialized_ || batch.getTexture() != atlas_texture_) {
+        setError("Batch is not bound to the glyph atlas (use beginBatch)");
         return false;
     }
+    return true;
+}
 
-    TTF_Font* font = loadFont(font_size);
-    if (!font) {
+bool TextRenderer::queueText(UiBatch& batch, const std::string& text, int x, int y,
+                             SDL_Color color, int font_size) {
+    const GlyphAtlas* atlas = nullptr;
+    const LabelLayout* label = getLabel(text, font_size, &atlas);
+    if (!label || !checkBatch(batch)) {
+        return false;
+    }
+    appendQuads(batch, *label, x, y, color);
+    return true;
+}
+
+bool TextRenderer::queueTextWithShadow(UiBatch& batch, const std::string& text, int x, int y,
+                                       SDL_Color color, SDL_Color shadow_color,
+                                       int font_size, int shadow_offset) {
+    const GlyphAtlas* atlas = nullptr;
+    const LabelLayout* label = getLabel(text, font_size, &atlas);
+    if (!label || !checkBatch(batch)) {
+        return false;
+    }
+    appendQuads(batch, *label, x + shadow_offset, y + shadow_offset, shadow_color);
+    appendQuads(batch, *label, x, y, color);
+    return true;
+}
+
+bool TextRenderer::queueTextCentered(UiBatch& batch, const std::string& text, int x, int y,
+                                     SDL_Color color, int font_size) {
+    const GlyphAtlas* atlas = nullptr;
+    const LabelLayout* label = getLabel(text, font_size, &atlas);
+    if (!label || !checkBatch(batch)) {
         return false;
     }
+    appendQuads(batch, *label, x - label->width / 2, y, color);
+    return true;
+}
 
-    if (TTF_SizeText(font, text.c_str(), &width, &height) < 0) {
-        setError(std::string("Failed to get text size: ") + TTF_GetError());
+// ============================================================================
+// Utility Methods
+// ============================================================================
+
+bool TextRenderer::getTextSize(const std::string& text, int font_size,
+                               int& width, int& height) {
+    // Measured from the same layout that is drawn, so alignment matches
+    const GlyphAtlas* atlas = nullptr;
+    const LabelLayout* label = getLabel(text, font_size, &atlas);
+    if (!label) {
         return false;
     }
 
+    width = label->width;
+    height = label->height;
     return true;
 }
 
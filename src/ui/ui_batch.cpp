@@ -0,0 +1,136 @@
+/**
+ * @file ui_batch.cpp
+ * @brief Implementation of UiBatch
+ *
+ * @author Friture C++ Port
+ * @date 2026-10-15
+ */
+
+#include <friture/ui/ui_batch.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "UiBatch needs SDL 2.0.18 or newer (SDL_RenderGeometry)"
+#endif
+
+namespace friture {
+
+UiBatch::UiBatch(SDL_Renderer* renderer)
+    : renderer_(renderer)
+{
+}
+
+void UiBatch::begin(SDL_Texture* texture, SDL_FPoint white_uv) {
+    texture_ = texture;
+    white_uv_ = texture ? white_uv : SDL_FPoint{0.0f, 0.0f};
+    vertices_.clear();
+    indices_.clear();
+}
+
+// ============================================================================
+// Shapes
+// ============================================================================
+
+void UiBatch::closeQuad() {
+    const int base = static_cast<int>(vertices_.size()) - 4;
+    for (int i : {0, 1, 2, 0, 2, 3}) {
+        indices_.push_back(base + i);
+    }
+}
+
+void UiBatch::addQuad(float x0, float y0, float x1, float y1, SDL_Color color) {
+    vertices_.push_back({{x0, y0}, color, white_uv_});
+    vertices_.push_back({{x1, y0}, color, white_uv_});
+    vertices_.push_back({{x1, y1}, color, white_uv_});
+    vertices_.push_back({{x0, y1}, color, white_uv_});
+    closeQuad();
+}
+
+void UiBatch::fillRect(const SDL_Rect& rect, SDL_Color color) {
+    if (rect.w <= 0 || rect.h <= 0) {
+        return;
+    }
+    addQuad(static_cast<float>(rect.x), static_cast<float>(rect.y),
+            static_cast<float>(rect.x + rect.w), static_cast<float>(rect.y + rect.h), color);
+}
+
+void UiBatch::drawRect(const SDL_Rect& rect, SDL_Color color) {
+    if (rect.w <= 0 || rect.h <= 0) {
+        return;
+    }
+    // Top and bottom rows span the width, the sides fill in between
+    fillRect({rect.x, rect.y, rect.w, 1}, color);
+    if (rect.h > 1) {
+        fillRect({rect.x, rect.y + rect.h - 1, rect.w, 1}, color);
+    }
+    if (rect.h > 2) {
+        fillRect({rect.x, rect.y + 1, 1, rect.h - 2}, color);
+        if (rect.w > 1) {
+            fillRect({rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2}, color);
+        }
+    }
+}
+
+void UiBatch::drawLine(int x0, int y0, int x1, int y1, SDL_Color color) {
+    if (x0 == x1 || y0 == y1) {
+        fillRect({std::min(x0, x1), std::min(y0, y1),
+                  std::abs(x1 - x0) + 1, std::abs(y1 - y0) + 1}, color);
+        return;
+    }
+
+    // Between the pixel centers, offset half a pixel along the normal
+    const float ax = static_cast<float>(x0) + 0.5f;
+    const float ay = static_cast<float>(y0) + 0.5f;
+    const float bx = static_cast<float>(x1) + 0.5f;
+    const float by = static_cast<float>(y1) + 0.5f;
+    const float length = std::hypot(bx - ax, by - ay);
+    const float nx = -(by - ay) / length * 0.5f;
+    const float ny = (bx - ax) / length * 0.5f;
+    vertices_.push_back({{ax + nx, ay + ny}, color, white_uv_});
+    vertices_.push_back({{bx + nx, by + ny}, color, white_uv_});
+    vertices_.push_back({{bx - nx, by - ny}, color, white_uv_});
+    vertices_.push_back({{ax - nx, ay - ny}, color, white_uv_});
+    closeQuad();
+}
+
+void UiBatch::addTexturedQuad(float x0, float y0, float x1, float y1,
+                              float u0, float v0, float u1, float v1, SDL_Color color) {
+    vertices_.push_back({{x0, y0}, color, {u0, v0}});
+    vertices_.push_back({{x1, y0}, color, {u1, v0}});
+    vertices_.push_back({{x1, y1}, color, {u1, v1}});
+    vertices_.push_back({{x0, y1}, color, {u0, v1}});
+    closeQuad();
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+bool UiBatch::flush() {
+    last_quads_ = getQuadCount();
+    if (indices_.empty()) {
+        return true;
+    }
+
+    // A texture brings its own blend mode; untextured geometry uses the
+    // renderer's draw blend mode
+    SDL_BlendMode previous = SDL_BLENDMODE_NONE;
+    if (!texture_) {
+        SDL_GetRenderDrawBlendMode(renderer_, &previous);
+        SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+    }
+    const int result = SDL_RenderGeometry(renderer_, texture_,
+                                          vertices_.data(), static_cast<int>(vertices_.size()),
+                                          indices_.data(), static_cast<int>(indices_.size()));
+    if (!texture_) {
+        SDL_SetRenderDrawBlendMode(renderer_, previous);
+    }
+    ++draw_calls_;
+
+    vertices_.clear();
+    indices_.clear();
+    return result == 0;
+}
+
+} // namespace friture
@@ -0,0 +1,124 @@
+/**
+ * @file aligned_arena_test.cpp
+ * @brief Unit tests for AlignedArena
+ *
+ * Tests cover:
+ * - Slice alignment, sizing and zero fill
+ * - Exhaustion throws instead of growing
+ * - reset() re-slicing the same block
+ * - Move semantics
+ */
+
+#include <gtest/gtest.h>
+#include <friture/aligned_arena.hpp>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+using namespace friture;
+
+namespace {
+
+bool aligned(const void* pointer) {
+    return reinterpret_cast<uintptr_t>(pointer) % AlignedArena::ALIGNMENT == 0;
+}
+
+} // namespace
+
+// ============================================================================
+// Allocation Tests
+// ============================================================================
+
+TEST(AlignedArenaTest, SizesRoundUpToAlignment) {
+    EXPECT_EQ(AlignedArena::alignUp(0), 0u);
+    EXPECT_EQ(AlignedArena::alignUp(1), 64u);
+    EXPECT_EQ(AlignedArena::alignUp(64), 64u);
+    EXPECT_EQ(AlignedArena::bytesFor<float>(17), 128u);
+    EXPECT_EQ(AlignedArena::bytesFor<double>(8), 64u);
+
+    AlignedArena arena(100);
+    EXPECT_EQ(arena.capacity(), 128u);
+    EXPECT_EQ(arena.used(), 0u);
+}
+
+TEST(AlignedArenaTest, SlicesAreAlignedAndZeroed) {
+    AlignedArena arena(AlignedArena::bytesFor<float>(3) + AlignedArena::bytesFor<double>(5) +
+                       AlignedArena::bytesFor<std::complex<float>>(7));
+
+    std::span<float> a = arena.allocate<float>(3);
+    std::span<double> b = arena.allocate<double>(5);
+    std::span<std::complex<float>> c = arena.allocate<std::complex<float>>(7);
+
+    ASSERT_EQ(a.size(), 3u);
+    ASSERT_EQ(b.size(), 5u);
+    ASSERT_EQ(c.size(), 7u);
+    EXPECT_TRUE(aligned(a.data()));
+    EXPECT_TRUE(aligned(b.data()));
+    EXPECT_TRUE(aligned(c.data()));
+    EXPECT_EQ(arena.used(), arena.capacity());
+
+    // Disjoint and inside the block
+    EXPECT_GE(reinterpret_cast<const std::byte*>(b.data()),
+              reinterpret_cast<const std::byte*>(a.data() + a.size()));
+    EXPECT_TRUE(arena.owns(c.data() + c.size() - 1));
+
+    for (float v : a) EXPECT_EQ(v, 0.0f);
+    for (double v : b) EXPECT_EQ(v, 0.0);
+    for (const auto& v : c) EXPECT_EQ(v, std::complex<float>(0.0f, 0.0f));
+}
+
+TEST(AlignedArenaTest, EmptySliceCostsNothing) {
+    AlignedArena arena(64);
+    EXPECT_TRUE(arena.allocate<float>(0).empty());
+    EXPECT_EQ(arena.used(), 0u);
+
+    AlignedArena none;
+    EXPECT_EQ(none.capacity(), 0u);
+    EXPECT_TRUE(none.allocate<float>(0).empty());
+    EXPECT_FALSE(none.owns(&none));
+}
+
+TEST(AlignedArenaTest, ExhaustionThrows) {
+    AlignedArena arena(AlignedArena::bytesFor<float>(16));
+    arena.allocate<float>(10);
+    EXPECT_THROW(arena.allocate<float>(1), std::length_error);
+
+    AlignedArena none;
+    EXPECT_THROW(none.allocate<float>(1), std::length_error);
+}
+
+// ============================================================================
+// Re-slicing Tests
+// ============================================================================
+
+TEST(AlignedArenaTest, ResetReslicesSameBlock) {
+    AlignedArena arena(256);
+    std::span<float> first = arena.allocate<float>(64);
+    first[5] = 1.0f;
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+
+    // A different layout in the same memory, zeroed again
+    std::span<double> second = arena.allocate<double>(32);
+    EXPECT_EQ(static_cast<void*>(second.data()), static_cast<void*>(first.data()));
+    EXPECT_EQ(second[2], 0.0);
+    EXPECT_EQ(arena.capacity(), 256u);
+}
+
+TEST(AlignedArenaTest, MoveTransfersBlock) {
+    AlignedArena source(128);
+    std::span<float> slice = source.allocate<float>(4);
+
+    AlignedArena moved(std::move(source));
+    EXPECT_EQ(moved.capacity(), 128u);
+    EXPECT_EQ(moved.used(), 64u);
+    EXPECT_TRUE(moved.owns(slice.data()));
+    EXPECT_EQ(source.capacity(), 0u);
+
+    AlignedArena assigned(64);
+    assigned = std::move(moved);
+    EXPECT_TRUE(assigned.owns(slice.data()));
+    EXPECT_EQ(moved.capacity(), 0u);
+}
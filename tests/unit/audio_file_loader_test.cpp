@@ -68,11 +68,16 @@ public:
 
     static bool writePCM16Stereo(const char* filename, const std::vector<float>& samples,
                                  uint32_t sample_rate) {
+        return writePCM16Interleaved(filename, samples, 2, sample_rate);
+    }
+
+    static bool writePCM16Interleaved(const char* filename, const std::vector<float>& samples,
+                                      uint16_t num_channels, uint32_t sample_rate) {
         FILE* fp = fopen(filename, "wb");
         if (!fp) return false;
 
-        uint32_t num_frames = static_cast<uint32_t>(samples.size() / 2);
-        uint32_t data_size = num_frames * 2 * 2; // 2 channels * 2 bytes
+        uint32_t num_frames = static_cast<uint32_t>(samples.size() / num_channels);
+        uint32_t data_size = num_frames * num_channels * 2; // 2 bytes per sample
         uint32_t file_size = 36 + data_size;
 
         // RIFF header
@@ -85,7 +90,6 @@ public:
         uint32_t fmt_size = 16;
         fwrite(&fmt_size, 4, 1, fp);
         uint16_t audio_format = 1; // PCM
-        uint16_t num_channels = 2; // Stereo
         uint16_t bits_per_sample = 16;
         uint32_t byte_rate = sample_rate * num_channels * bits_per_sample / 8;
         uint16_t block_align = num_channels * bits_per_sample / 8;
@@ -101,7 +105,7 @@ public:
         fwrite("data", 1, 4, fp);
         fwrite(&data_size, 4, 1, fp);
 
-        // Write audio data (interleaved L, R)
+        // Write audio data (interleaved frames)
         for (float sample : samples) {
             int16_t pcm_sample = static_cast<int16_t>(sample * 32767.0f);
             fwrite(&pcm_sample, 2, 1, fp);
@@ -218,6 +222,7 @@ protected:
         // Clean up test files
         remove("/tmp/test_pcm16_mono.wav");
         remove("/tmp/test_pcm16_stereo.wav");
+        remove("/tmp/test_pcm16_quad.wav");
         remove("/tmp/test_pcm24_mono.wav");
         remove("/tmp/test_float32_mono.wav");
         remove("/tmp/test_invalid.wav");
@@ -297,6 +302,54 @@ TEST_F(AudioFileLoaderTest, LoadPCM16Stereo) {
     }
 }
 
+TEST_F(AudioFileLoaderTest, LoadChannelsKeepsEveryChannel) {
+    // Four channels: the sine scaled by 1, -1, 0.5 and 0
+    const float gains[4] = {1.0f, -1.0f, 0.5f, 0.0f};
+    std::vector<float> quad_data;
+    for (float sample : sine_wave_) {
+        for (float gain : gains) {
+            quad_data.push_back(sample * gain);
+        }
+    }
+    ASSERT_TRUE(WavWriter::writePCM16Interleaved("/tmp/test_pcm16_quad.wav", quad_data, 4, 48000));
+
+    AudioFileLoader loader;
+    std::vector<std::vector<float>> channels;
+    float sample_rate;
+
+    ASSERT_TRUE(loader.loadChannels("/tmp/test_pcm16_quad.wav", channels, sample_rate));
+    EXPECT_FLOAT_EQ(sample_rate, 48000.0f);
+    EXPECT_EQ(loader.getInfo().channels, 4);
+    ASSERT_EQ(channels.size(), 4u);
+
+    for (size_t c = 0; c < 4; ++c) {
+        ASSERT_EQ(channels[c].size(), sine_wave_.size());
+        for (size_t i = 0; i < sine_wave_.size(); i += 97) {
+            EXPECT_NEAR(channels[c][i], sine_wave_[i] * gains[c], 0.001f)
+                << "channel " << c << " index " << i;
+        }
+    }
+}
+
+TEST_F(AudioFileLoaderTest, LoadDownmixesMultichannel) {
+    // Average of (s, s, s, -s) is s / 2
+    std::vector<float> quad_data;
+    for (float sample : sine_wave_) {
+        quad_data.insert(quad_data.end(), {sample, sample, sample, -sample});
+    }
+    ASSERT_TRUE(WavWriter::writePCM16Interleaved("/tmp/test_pcm16_quad.wav", quad_data, 4, 48000));
+
+    AudioFileLoader loader;
+    std::vector<float> samples;
+    float sample_rate;
+
+    ASSERT_TRUE(loader.load("/tmp/test_pcm16_quad.wav", samples, sample_rate));
+    ASSERT_EQ(samples.size(), sine_wave_.size());
+    for (size_t i = 0; i < samples.size(); i += 97) {
+        EXPECT_NEAR(samples[i], sine_wave_[i] * 0.5f, 0.001f);
+    }
+}
+
 TEST_F(AudioFileLoaderTest, LoadFloat32Mono) {
     // Create test file
     ASSERT_TRUE(WavWriter::writeFloat32Mono("/tmp/test_float32_mono.wav", sine_wave_, 48000));
@@ -0,0 +1,137 @@
+/**
+ * @file callback_stats_test.cpp
+ * @brief Unit tests for CallbackStats
+ *
+ * Tests cover:
+ * - Counter accumulation and reset
+ * - Log2 histogram bucketing and percentile estimates
+ * - Snapshots taken while a writer thread records
+ */
+
+#include <gtest/gtest.h>
+#include <friture/audio/callback_stats.hpp>
+#include <atomic>
+#include <thread>
+
+using namespace friture;
+
+// ============================================================================
+// Counter Tests
+// ============================================================================
+
+TEST(CallbackStatsTest, InitiallyZero) {
+    CallbackStats stats;
+    auto snapshot = stats.getSnapshot();
+    EXPECT_EQ(snapshot.callbacks, 0u);
+    EXPECT_EQ(snapshot.overflows, 0u);
+    EXPECT_EQ(snapshot.max_duration_ns, 0u);
+    EXPECT_DOUBLE_EQ(snapshot.percentileMicros(0.99), 0.0);
+}
+
+TEST(CallbackStatsTest, AccumulatesCounters) {
+    CallbackStats stats;
+    const uint64_t period_ns = 10000000;   // 512 frames at 48 kHz ~ 10.7 ms
+
+    stats.record(3000, 512, false, period_ns);
+    stats.record(5000, 512, true, period_ns);
+    stats.record(12000000, 512, false, period_ns);   // Longer than the period
+
+    auto snapshot = stats.getSnapshot();
+    EXPECT_EQ(snapshot.callbacks, 3u);
+    EXPECT_EQ(snapshot.frames, 1536u);
+    EXPECT_EQ(snapshot.overflows, 1u);
+    EXPECT_EQ(snapshot.late_callbacks, 1u);
+    EXPECT_EQ(snapshot.max_duration_ns, 12000000u);
+    EXPECT_EQ(stats.getOverflowCount(), 1u);
+}
+
+TEST(CallbackStatsTest, ResetClearsEverything) {
+    CallbackStats stats;
+    stats.record(50000, 64, true, 0);
+    stats.reset();
+
+    auto snapshot = stats.getSnapshot();
+    EXPECT_EQ(snapshot.callbacks, 0u);
+    EXPECT_EQ(snapshot.frames, 0u);
+    EXPECT_EQ(snapshot.overflows, 0u);
+    for (uint64_t bucket : snapshot.histogram) {
+        EXPECT_EQ(bucket, 0u);
+    }
+}
+
+// ============================================================================
+// Histogram Tests
+// ============================================================================
+
+TEST(CallbackStatsTest, BucketsAreLog2Micros) {
+    EXPECT_EQ(CallbackStats::bucketFor(0), 0u);
+    EXPECT_EQ(CallbackStats::bucketFor(1999), 0u);      // < 2 us
+    EXPECT_EQ(CallbackStats::bucketFor(2000), 1u);      // [2, 4) us
+    EXPECT_EQ(CallbackStats::bucketFor(3999), 1u);
+    EXPECT_EQ(CallbackStats::bucketFor(4000), 2u);
+    EXPECT_EQ(CallbackStats::bucketFor(1024000), 10u);  // [1024, 2048) us
+    EXPECT_EQ(CallbackStats::bucketFor(10000000000ull), CallbackStats::HISTOGRAM_BUCKETS - 1);
+}
+
+TEST(CallbackStatsTest, PercentileFromHistogram) {
+    CallbackStats stats;
+    for (int i = 0; i < 99; ++i) {
+        stats.record(3000, 64, false, 0);     // Bucket 1: [2, 4) us
+    }
+    stats.record(100000, 64, false, 0);       // Bucket 6: [64, 128) us
+
+    auto snapshot = stats.getSnapshot();
+    EXPECT_EQ(snapshot.histogram[1], 99u);
+    EXPECT_EQ(snapshot.histogram[6], 1u);
+    EXPECT_DOUBLE_EQ(snapshot.percentileMicros(0.5), 4.0);
+    EXPECT_DOUBLE_EQ(snapshot.percentileMicros(0.99), 4.0);
+    EXPECT_DOUBLE_EQ(snapshot.percentileMicros(1.0), 128.0);
+}
+
+// ============================================================================
+// Concurrency Tests
+// ============================================================================
+
+TEST(CallbackStatsTest, SnapshotsWhileRecording) {
+    CallbackStats stats;
+    const uint64_t total = 100000;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&]() {
+        for (uint64_t i = 0; i < total; ++i) {
+            stats.record(1000 + (i % 64) * 1000, 64, (i % 1000) == 0, 0);
+        }
+        done = true;
+    });
+
+    // Counters only grow while the writer runs
+    uint64_t last_callbacks = 0;
+    bool monotonic = true;
+    while (!done) {
+        auto snapshot = stats.getSnapshot();
+        monotonic = monotonic && snapshot.callbacks >= last_callbacks;
+        last_callbacks = snapshot.callbacks;
+    }
+    writer.join();
+
+    auto snapshot = stats.getSnapshot();
+    EXPECT_TRUE(monotonic);
+    EXPECT_EQ(snapshot.callbacks, total);
+    EXPECT_EQ(snapshot.frames, total * 64);
+    EXPECT_EQ(snapshot.overflows, total / 1000);
+
+    uint64_t histogram_total = 0;
+    for (uint64_t bucket : snapshot.histogram) {
+        histogram_total += bucket;
+    }
+    EXPECT_EQ(histogram_total, total);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -9,6 +9,7 @@
  * - Monotonic luminance
  * - Edge cases (NaN, Inf, out-of-range)
  * - Batch transformation
+ * - Fused dB → color transformation
  * - Theme switching
  * - Performance benchmarks
  */
@@ -21,6 +22,7 @@
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <algorithm>
 
 using namespace friture;
 
@@ -447,6 +449,105 @@ TEST_F(ColorTransformTest, SetTheme_Idempotent) {
         << "Setting same theme should not change colors";
 }
 
+// ============================================================================
+// Fused dB Transformation Tests
+// ============================================================================
+
+namespace {
+
+// Two-pass reference: normalize + clamp, then transformColumn()
+std::vector<uint32_t> twoPass(const ColorTransform& transformer, const std::vector<float>& db,
+                              float min_db, float max_db) {
+    std::vector<float> normalized(db.size());
+    for (size_t i = 0; i < db.size(); ++i) {
+        normalized[i] = std::clamp((db[i] - min_db) / (max_db - min_db), 0.0f, 1.0f);
+    }
+    std::vector<uint32_t> colors(db.size());
+    transformer.transformColumn(normalized.data(), normalized.size(), colors.data());
+    return colors;
+}
+
+} // namespace
+
+TEST_F(ColorTransformTest, TransformColumnDbMatchesTwoPass) {
+    ColorTransform transformer(ColorTheme::Grayscale);
+
+    // Odd size exercises the vector tail
+    const size_t height = 1083;
+    std::vector<float> db(height);
+    for (size_t i = 0; i < height; ++i) {
+        db[i] = -160.0f + 180.0f * static_cast<float>(i) / static_cast<float>(height - 1);
+    }
+
+    std::vector<uint32_t> fused(height);
+    transformer.transformColumnDb(db.data(), height, -140.0f, 0.0f, fused.data());
+    std::vector<uint32_t> expected = twoPass(transformer, db, -140.0f, 0.0f);
+
+    // Grayscale: red channel is the palette index; allow one entry at boundaries
+    for (size_t i = 0; i < height; ++i) {
+        int diff = static_cast<int>(fused[i] & 0xFF) - static_cast<int>(expected[i] & 0xFF);
+        EXPECT_LE(std::abs(diff), 1) << "row " << i << " (" << db[i] << " dB)";
+    }
+}
+
+TEST_F(ColorTransformTest, TransformColumnDbClampsAndHandlesNaN) {
+    ColorTransform transformer(ColorTheme::CMRMAP);
+    std::vector<float> db = {-1000.0f, -140.0f, -70.0f, 0.0f, 50.0f,
+                             std::numeric_limits<float>::quiet_NaN(),
+                             -std::numeric_limits<float>::infinity(),
+                             std::numeric_limits<float>::infinity(), -35.0f};
+    std::vector<uint32_t> colors(db.size());
+    transformer.transformColumnDb(db.data(), db.size(), -140.0f, 0.0f, colors.data());
+
+    EXPECT_EQ(colors[0], transformer.valueToColor(0.0f));
+    EXPECT_EQ(colors[1], transformer.valueToColor(0.0f));
+    EXPECT_EQ(colors[2], transformer.valueToColor(0.5f));
+    EXPECT_EQ(colors[3], transformer.valueToColor(1.0f));
+    EXPECT_EQ(colors[4], transformer.valueToColor(1.0f));
+    EXPECT_EQ(colors[5], transformer.valueToColor(0.0f));
+    EXPECT_EQ(colors[6], transformer.valueToColor(0.0f));
+    EXPECT_EQ(colors[7], transformer.valueToColor(1.0f));
+}
+
+TEST_F(ColorTransformTest, Performance_FusedVsTwoPass) {
+    ColorTransform transformer(ColorTheme::CMRMAP);
+
+    const size_t height = 1080;
+    const int iterations = 10000;
+    const float min_db = -140.0f;
+    const float max_db = 0.0f;
+
+    std::vector<float> db(height);
+    for (size_t i = 0; i < height; ++i) {
+        db[i] = -150.0f + 160.0f * static_cast<float>(i) / static_cast<float>(height - 1);
+    }
+    std::vector<float> normalized(height);
+    std::vector<uint32_t> output(height);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        for (size_t i = 0; i < height; ++i) {
+            normalized[i] = std::clamp((db[i] - min_db) / (max_db - min_db), 0.0f, 1.0f);
+        }
+        transformer.transformColumn(normalized.data(), height, output.data());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    float two_pass_us = std::chrono::duration<float, std::micro>(end - start).count() / iterations;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        transformer.transformColumnDb(db.data(), height, min_db, max_db, output.data());
+    }
+    end = std::chrono::high_resolution_clock::now();
+    float fused_us = std::chrono::duration<float, std::micro>(end - start).count() / iterations;
+
+    std::cout << "\n=== Performance: dB Column -> Colors (1080 pixels) ===\n";
+    std::cout << "Two-pass: " << std::fixed << std::setprecision(3) << two_pass_us << " μs\n";
+    std::cout << "Fused:    " << std::fixed << std::setprecision(3) << fused_us << " μs\n";
+
+    EXPECT_LT(fused_us, two_pass_us);
+}
+
 // ============================================================================
 // Performance Benchmarks
 // ============================================================================
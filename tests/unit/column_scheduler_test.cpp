@@ -0,0 +1,124 @@
+/**
+ * @file column_scheduler_test.cpp
+ * @brief Unit tests for ColumnScheduler
+ *
+ * Tests cover:
+ * - Due-column computation on the sample clock
+ * - Catch-up batches after stalls
+ * - Batch cap and dropped-column accounting
+ * - Time axis correctness for small hops
+ */
+
+#include <gtest/gtest.h>
+#include <friture/column_scheduler.hpp>
+#include <friture/settings.hpp>
+
+using namespace friture;
+
+// ============================================================================
+// Basic Scheduling Tests
+// ============================================================================
+
+TEST(ColumnSchedulerTest, InvalidHopSize) {
+    EXPECT_THROW(ColumnScheduler(0), std::invalid_argument);
+}
+
+TEST(ColumnSchedulerTest, NothingDueBeforeFirstHop) {
+    ColumnScheduler scheduler(1024);
+
+    ColumnBatch batch = scheduler.schedule(1023);
+    EXPECT_EQ(batch.count, 0);
+    EXPECT_EQ(batch.dropped, 0);
+    EXPECT_EQ(scheduler.samplesUntilNextColumn(1023), 1);
+}
+
+TEST(ColumnSchedulerTest, OneColumnPerHop) {
+    ColumnScheduler scheduler(1024);
+
+    EXPECT_EQ(scheduler.schedule(1024).count, 1);
+    EXPECT_EQ(scheduler.schedule(1500).count, 0);
+    EXPECT_EQ(scheduler.schedule(2048).count, 1);
+    EXPECT_EQ(scheduler.getColumnsScheduled(), 2);
+}
+
+TEST(ColumnSchedulerTest, CatchUpBatch) {
+    ColumnScheduler scheduler(64);
+
+    // A 16.7 ms frame at 48 kHz is ~800 samples → 12 hops of 64 samples
+    ColumnBatch batch = scheduler.schedule(800);
+    EXPECT_EQ(batch.count, 12);
+    EXPECT_EQ(batch.dropped, 0);
+
+    // The remainder carries over to the next frame
+    batch = scheduler.schedule(1600);
+    EXPECT_EQ(batch.count, 13);
+    EXPECT_EQ(scheduler.getColumnsScheduled(), 25);
+}
+
+TEST(ColumnSchedulerTest, ClockGoingBackwardsSchedulesNothing) {
+    ColumnScheduler scheduler(100);
+
+    EXPECT_EQ(scheduler.schedule(1000).count, 10);
+    EXPECT_EQ(scheduler.schedule(500).count, 0);
+    EXPECT_EQ(scheduler.schedule(1100).count, 1);
+}
+
+// ============================================================================
+// Batch Cap Tests
+// ============================================================================
+
+TEST(ColumnSchedulerTest, CapDropsOldestColumns) {
+    ColumnScheduler scheduler(10, 5);
+
+    ColumnBatch batch = scheduler.schedule(1000);  // 100 columns due
+    EXPECT_EQ(batch.count, 5);
+    EXPECT_EQ(batch.dropped, 95);
+    EXPECT_EQ(scheduler.getColumnsDropped(), 95);
+
+    // After the stall the scheduler is back in real time
+    batch = scheduler.schedule(1010);
+    EXPECT_EQ(batch.count, 1);
+    EXPECT_EQ(batch.dropped, 0);
+}
+
+TEST(ColumnSchedulerTest, ResetClearsState) {
+    ColumnScheduler scheduler(10, 5);
+    scheduler.schedule(1000);
+
+    scheduler.reset();
+    EXPECT_EQ(scheduler.getColumnsScheduled(), 0);
+    EXPECT_EQ(scheduler.getColumnsDropped(), 0);
+    EXPECT_EQ(scheduler.schedule(10).count, 1);
+}
+
+// ============================================================================
+// Time Axis Tests
+// ============================================================================
+
+TEST(ColumnSchedulerTest, TimeAxisMatchesSettings) {
+    SpectrogramSettings settings;
+    settings.setFFTSize(256);
+    const size_t hop = settings.getSamplesPerColumn();
+    ColumnScheduler scheduler(hop);
+
+    // Simulate 10 seconds of 60 FPS frames
+    const uint64_t samples_per_frame = static_cast<uint64_t>(settings.sample_rate / 60.0f);
+    uint64_t clock = 0;
+    uint64_t total = 0;
+    for (int frame = 0; frame < 600; ++frame) {
+        clock += samples_per_frame;
+        total += scheduler.schedule(clock).count;
+    }
+
+    // Every hop is accounted for: columns × hop ≈ elapsed samples
+    EXPECT_EQ(total, clock / hop);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,347 @@
+/**
+ * @file column_stream_test.cpp
+ * @brief Unit tests for the column stream
+ *
+ * Tests cover:
+ * - Encoder/decoder round trip within one quantization step
+ * - Datagram size limits and bandwidth of steady and noisy columns
+ * - Joining mid-stream and recovering from loss at the next keyframe
+ * - Malformed, stale and duplicate datagrams
+ * - Sender column-rate cap (peak of combined columns) over UDP loopback
+ */
+
+#include <gtest/gtest.h>
+#include <friture/column_stream.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+RecordingHeader testFormat(uint32_t height) {
+    RecordingHeader header;
+    header.fft_size = 4096;
+    header.hop_size = 480;
+    header.sample_rate = 48000.0f;
+    header.scale = FrequencyScale::Logarithmic;
+    header.min_freq = 20.0f;
+    header.max_freq = 20000.0f;
+    header.height = height;
+    return header;
+}
+
+// Smooth spectrum with a drifting peak and some noise
+std::vector<uint16_t> testColumn(size_t height, size_t column, std::mt19937& rng) {
+    std::normal_distribution<float> noise(0.0f, 400.0f);
+    std::vector<uint16_t> levels(height);
+    const float peak = static_cast<float>((column * 3) % height);
+    for (size_t i = 0; i < height; ++i) {
+        const float distance = std::abs(static_cast<float>(i) - peak);
+        const float level = 20000.0f + 40000.0f / (1.0f + distance * 0.1f) + noise(rng);
+        levels[i] = static_cast<uint16_t>(std::clamp(level, 0.0f, 65535.0f));
+    }
+    return levels;
+}
+
+// Feeds every datagram; returns whether the column completed
+bool deliver(ColumnStreamDecoder& decoder, const std::vector<std::vector<uint8_t>>& datagrams) {
+    bool complete = false;
+    for (const auto& datagram : datagrams) {
+        complete = decoder.feed(datagram.data(), datagram.size());
+    }
+    return complete;
+}
+
+void expectWithinStep(const std::vector<uint16_t>& actual, const std::vector<uint16_t>& expected,
+                      uint32_t level_bits) {
+    const int half_step = level_bits < 16 ? 1 << (15 - level_bits) : 0;
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_LE(std::abs(static_cast<int>(actual[i]) - static_cast<int>(expected[i])), half_step)
+            << "row " << i;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Codec Tests
+// ============================================================================
+
+TEST(ColumnStreamTest, RoundTripWithinQuantizationStep) {
+    for (uint32_t bits : {8u, 12u, 16u}) {
+        ColumnStreamEncoder encoder(10, bits);
+        encoder.setFormat(testFormat(432));
+        ColumnStreamDecoder decoder;
+        std::mt19937 rng(bits);
+
+        for (size_t column = 0; column < 25; ++column) {
+            std::vector<uint16_t> levels = testColumn(432, column, rng);
+            ASSERT_TRUE(deliver(decoder, encoder.encode(levels.data(), 1000 + column)));
+            expectWithinStep(decoder.getColumn(), levels, bits);
+            EXPECT_EQ(decoder.getTimestamp(), static_cast<int64_t>(1000 + column));
+            EXPECT_EQ(decoder.getSequence(), column);
+        }
+        EXPECT_EQ(decoder.getColumnCount(), 25u);
+        EXPECT_EQ(decoder.getLostColumns(), 0u);
+        EXPECT_EQ(decoder.getRejectedPackets(), 0u);
+    }
+}
+
+TEST(ColumnStreamTest, FormatTravelsWithKeyframes) {
+    ColumnStreamEncoder encoder;
+    RecordingHeader format = testFormat(300);
+    format.scale = FrequencyScale::Mel;
+    encoder.setFormat(format);
+
+    std::vector<uint16_t> levels(300, 30000);
+    ColumnStreamDecoder decoder;
+    ASSERT_TRUE(deliver(decoder, encoder.encode(levels.data(), 0)));
+    ASSERT_TRUE(decoder.hasFormat());
+    EXPECT_TRUE(decoder.getFormat().sameFormat(encoder.getFormat()));
+    EXPECT_EQ(decoder.getFormat().scale, FrequencyScale::Mel);
+    EXPECT_EQ(decoder.getFormat().level_bits, 8u);
+    EXPECT_EQ(decoder.getGeneration(), 1);
+
+    // A new format resets the decoder at the next (forced) keyframe
+    format.height = 200;
+    encoder.setFormat(format);
+    std::vector<uint16_t> shorter(200, 40000);
+    ASSERT_TRUE(deliver(decoder, encoder.encode(shorter.data(), 1)));
+    EXPECT_EQ(decoder.getFormat().height, 200u);
+    EXPECT_EQ(decoder.getColumn().size(), 200u);
+}
+
+TEST(ColumnStreamTest, TallColumnsSplitUnderDatagramLimit) {
+    ColumnStreamEncoder encoder(50, 16);
+    encoder.setFormat(testFormat(2000));
+    ASSERT_LT(encoder.getRowsPerPacket(), 2000u);
+
+    // Worst case: every row jumps across the full range
+    ColumnStreamDecoder decoder;
+    std::vector<uint16_t> levels(2000);
+    for (size_t column = 0; column < 3; ++column) {
+        for (size_t i = 0; i < levels.size(); ++i) {
+            levels[i] = ((i + column) & 1) ? 65535 : 0;
+        }
+        const auto& datagrams = encoder.encode(levels.data(), 0);
+        EXPECT_GT(datagrams.size(), 1u);
+        for (const auto& datagram : datagrams) {
+            EXPECT_LE(datagram.size(), ColumnStreamEncoder::MAX_DATAGRAM);
+        }
+        ASSERT_TRUE(deliver(decoder, datagrams));
+        expectWithinStep(decoder.getColumn(), levels, 16);
+    }
+}
+
+TEST(ColumnStreamTest, BandwidthOfDisplayColumns) {
+    ColumnStreamEncoder encoder;
+    encoder.setFormat(testFormat(432));
+    std::mt19937 rng(3);
+
+    // 50 columns/s of a noisy display
+    size_t noisy_bytes = 0;
+    for (size_t column = 0; column < 50; ++column) {
+        std::vector<uint16_t> levels = testColumn(432, column, rng);
+        for (const auto& datagram : encoder.encode(levels.data(), 0)) {
+            noisy_bytes += datagram.size();
+        }
+    }
+    const double noisy_kbit = noisy_bytes * 8 / 1000.0;
+    EXPECT_LT(noisy_kbit, 400.0);
+
+    // Steady input: nearly all zero runs
+    std::vector<uint16_t> steady(432, 25000);
+    size_t steady_bytes = 0;
+    for (size_t column = 0; column < 50; ++column) {
+        for (const auto& datagram : encoder.encode(steady.data(), 0)) {
+            steady_bytes += datagram.size();
+        }
+    }
+    EXPECT_LT(steady_bytes * 5, noisy_bytes);
+}
+
+// ============================================================================
+// Loss Tests
+// ============================================================================
+
+TEST(ColumnStreamTest, JoinsAtNextKeyframe) {
+    ColumnStreamEncoder encoder(5);
+    encoder.setFormat(testFormat(256));
+    std::mt19937 rng(5);
+
+    for (size_t column = 0; column < 2; ++column) {
+        std::vector<uint16_t> levels = testColumn(256, column, rng);
+        encoder.encode(levels.data(), 0);
+    }
+
+    // Deltas without a keyframe are unusable
+    ColumnStreamDecoder decoder;
+    for (size_t column = 2; column < 5; ++column) {
+        std::vector<uint16_t> levels = testColumn(256, column, rng);
+        EXPECT_FALSE(deliver(decoder, encoder.encode(levels.data(), 0)));
+    }
+    EXPECT_FALSE(decoder.hasFormat());
+
+    std::vector<uint16_t> levels = testColumn(256, 5, rng);
+    ASSERT_TRUE(deliver(decoder, encoder.encode(levels.data(), 0)));
+    expectWithinStep(decoder.getColumn(), levels, 8);
+    EXPECT_EQ(decoder.getSequence(), 5u);
+}
+
+TEST(ColumnStreamTest, RecoversFromLossAtKeyframe) {
+    ColumnStreamEncoder encoder(5, 8);
+    encoder.setFormat(testFormat(1500));
+    ColumnStreamDecoder decoder;
+    std::mt19937 rng(7);
+
+    std::vector<uint16_t> levels = testColumn(1500, 0, rng);
+    ASSERT_TRUE(deliver(decoder, encoder.encode(levels.data(), 0)));
+
+    // Lose the first slice of column 1: columns 1-4 cannot complete
+    levels = testColumn(1500, 1, rng);
+    const auto& datagrams = encoder.encode(levels.data(), 0);
+    ASSERT_GT(datagrams.size(), 1u);
+    for (size_t i = 1; i < datagrams.size(); ++i) {
+        EXPECT_FALSE(decoder.feed(datagrams[i].data(), datagrams[i].size()));
+    }
+    for (size_t column = 2; column < 5; ++column) {
+        levels = testColumn(1500, column, rng);
+        EXPECT_FALSE(deliver(decoder, encoder.encode(levels.data(), 0)));
+    }
+
+    levels = testColumn(1500, 5, rng);
+    ASSERT_TRUE(deliver(decoder, encoder.encode(levels.data(), 0)));
+    expectWithinStep(decoder.getColumn(), levels, 8);
+    EXPECT_EQ(decoder.getLostColumns(), 4u);
+
+    // Deltas apply again after the keyframe
+    levels = testColumn(1500, 6, rng);
+    ASSERT_TRUE(deliver(decoder, encoder.encode(levels.data(), 0)));
+    expectWithinStep(decoder.getColumn(), levels, 8);
+}
+
+TEST(ColumnStreamTest, RejectsMalformedAndStaleDatagrams) {
+    ColumnStreamEncoder encoder;
+    encoder.setFormat(testFormat(64));
+    ColumnStreamDecoder decoder;
+    std::vector<uint16_t> levels(64, 12345);
+
+    const std::vector<uint8_t> keyframe = encoder.encode(levels.data(), 0)[0];
+    ASSERT_TRUE(decoder.feed(keyframe.data(), keyframe.size()));
+
+    // Same column again: stale
+    EXPECT_FALSE(decoder.feed(keyframe.data(), keyframe.size()));
+
+    levels[10] = 50000;
+    std::vector<uint8_t> delta = encoder.encode(levels.data(), 0)[0];
+    const uint64_t rejected = decoder.getRejectedPackets();
+
+    std::vector<uint8_t> bad_magic = delta;
+    bad_magic[0] = 'X';
+    EXPECT_FALSE(decoder.feed(bad_magic.data(), bad_magic.size()));
+
+    std::vector<uint8_t> truncated(delta.begin(), delta.end() - 1);
+    EXPECT_FALSE(decoder.feed(truncated.data(), truncated.size()));
+
+    std::vector<uint8_t> trailing = delta;
+    trailing.push_back(0);
+    EXPECT_FALSE(decoder.feed(trailing.data(), trailing.size()));
+
+    std::vector<uint8_t> out_of_range = delta;
+    out_of_range[22] = 65;  // row_count > height
+    EXPECT_FALSE(decoder.feed(out_of_range.data(), out_of_range.size()));
+
+    EXPECT_FALSE(decoder.feed(delta.data(), 10));
+    EXPECT_EQ(decoder.getRejectedPackets(), rejected + 5);
+
+    // The intact datagram still applies
+    ASSERT_TRUE(decoder.feed(delta.data(), delta.size()));
+    expectWithinStep(decoder.getColumn(), levels, 8);
+}
+
+TEST(ColumnStreamTest, InvalidParametersThrow) {
+    EXPECT_THROW(ColumnStreamEncoder(0, 8), std::invalid_argument);
+    EXPECT_THROW(ColumnStreamEncoder(10, 7), std::invalid_argument);
+    EXPECT_THROW(ColumnStreamEncoder(10, 17), std::invalid_argument);
+
+    ColumnStreamEncoder encoder;
+    std::vector<uint16_t> levels(4);
+    EXPECT_THROW(encoder.encode(levels.data(), 0), std::logic_error);
+    EXPECT_THROW(encoder.setFormat(testFormat(0)), std::invalid_argument);
+
+    ColumnStreamSender::Options options;
+    options.max_columns_per_second = 0.0f;
+    EXPECT_THROW(ColumnStreamSender{options}, std::invalid_argument);
+
+    ColumnStreamSender sender;
+    EXPECT_FALSE(sender.open("not-an-address", 7082));
+    EXPECT_FALSE(sender.getError().empty());
+}
+
+// ============================================================================
+// Transport Tests
+// ============================================================================
+
+TEST(ColumnStreamTest, LoopbackSenderToReceiver) {
+    ColumnStreamReceiver receiver;
+    uint16_t port = 0;
+    for (uint16_t candidate = 47082; candidate < 47182; ++candidate) {
+        if (receiver.open("127.0.0.1", candidate)) {
+            port = candidate;
+            break;
+        }
+    }
+    if (port == 0) {
+        GTEST_SKIP() << "No UDP port available: " << receiver.getError();
+    }
+
+    // 100 columns/s capped to 25: every 4 columns combine into one
+    ColumnStreamSender::Options options;
+    options.max_columns_per_second = 25.0f;
+    options.level_bits = 12;
+    ColumnStreamSender sender(options);
+    ASSERT_TRUE(sender.open("127.0.0.1", port)) << sender.getError();
+    ASSERT_TRUE(sender.setFormat(testFormat(432)));
+    EXPECT_EQ(sender.getDecimation(), 4u);
+    EXPECT_EQ(sender.getFormat().hop_size, 480u * 4);
+
+    std::vector<uint16_t> expected(432);
+    std::vector<uint16_t> received;
+    size_t sent = 0;
+    for (size_t column = 0; column < 8; ++column) {
+        std::vector<uint16_t> levels(432, 10000);
+        levels[column * 10] = 60000;    // Short event in one column
+        for (size_t i = 0; i < levels.size(); ++i) {
+            expected[i] = std::max(expected[i], levels[i]);
+        }
+        if (!sender.push(levels.data(), levels.size())) {
+            continue;
+        }
+        ++sent;
+
+        // Loopback delivers promptly but not synchronously
+        bool complete = false;
+        for (int attempt = 0; attempt < 200 && !complete; ++attempt) {
+            complete = receiver.poll();
+            if (!complete) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        ASSERT_TRUE(complete) << "column " << column;
+        expectWithinStep(receiver.decoder().getColumn(), expected, 12);
+        std::fill(expected.begin(), expected.end(), uint16_t{0});
+    }
+
+    EXPECT_EQ(sent, 2u);
+    EXPECT_EQ(sender.getColumnsSent(), 2u);
+    EXPECT_EQ(receiver.decoder().getFormat().hop_size, 480u * 4);
+    EXPECT_EQ(sender.getBytesSent(), receiver.getBytesReceived());
+    EXPECT_EQ(sender.getDroppedPackets(), 0u);
+    EXPECT_FALSE(sender.push(expected.data(), 100));   // Wrong height
+}
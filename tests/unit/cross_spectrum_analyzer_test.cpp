@@ -0,0 +1,334 @@
+/**
+ * @file cross_spectrum_analyzer_test.cpp
+ * @brief Unit tests for CrossSpectrumAnalyzer
+ *
+ * Tests cover:
+ * - Parameter validation
+ * - Identical channels: 0 dB, 0°, coherence 1
+ * - Gain and delay: H1 magnitude and phase
+ * - Channel separation of the packed FFT
+ * - Coherence of unrelated noise; Linear and Exponential averaging
+ * - Display rows and the dB mapping of the phase and coherence views
+ * - Throughput at 96 kHz with FFT 8192
+ */
+
+#include <gtest/gtest.h>
+#include <friture/cross_spectrum_analyzer.hpp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+ChainKey linearKey(size_t fft_size, float sample_rate = 48000.0f) {
+    ChainKey key;
+    key.fft_size = fft_size;
+    key.scale = FrequencyScale::Linear;
+    key.min_freq = 100.0f;
+    key.max_freq = sample_rate / 2.0f;
+    key.sample_rate = sample_rate;
+    key.height = 128;
+    return key;
+}
+
+// Sine of amplitude a at bin k of an N-point FFT, starting at sample offset
+void binTone(std::span<float> output, size_t fft_size, double bin, double amplitude, double offset = 0.0) {
+    for (size_t i = 0; i < output.size(); ++i) {
+        output[i] = static_cast<float>(amplitude * std::sin(2.0 * PI * bin * (static_cast<double>(i) - offset) /
+                                                            static_cast<double>(fft_size)));
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Configuration Tests
+// ============================================================================
+
+TEST(CrossSpectrumAnalyzerTest, RejectsInvalidParameters) {
+    ChainKey key = linearKey(1000);
+    EXPECT_THROW(CrossSpectrumAnalyzer{key}, std::invalid_argument);
+
+    key = linearKey(1024);
+    key.height = 0;
+    EXPECT_THROW(CrossSpectrumAnalyzer{key}, std::invalid_argument);
+
+    CrossSpectrumAnalyzer::Options options;
+    options.averaging = AveragingMode::Linear;
+    options.frames = 0;
+    EXPECT_THROW(CrossSpectrumAnalyzer(linearKey(1024), options), std::invalid_argument);
+
+    options.averaging = AveragingMode::Exponential;
+    options.time_seconds = 0.0f;
+    EXPECT_THROW(CrossSpectrumAnalyzer(linearKey(1024), options), std::invalid_argument);
+
+    CrossSpectrumAnalyzer analyzer(linearKey(1024));
+    EXPECT_EQ(analyzer.getNumBins(), 513u);
+    EXPECT_EQ(analyzer.getHopSize(), 256u);
+    EXPECT_EQ(analyzer.reference_input.size(), 1024u);
+    EXPECT_EQ(analyzer.measured_input.size(), 1024u);
+    std::vector<float> column(128);
+    EXPECT_THROW(analyzer.resample(TransferView::Off, column.data()), std::invalid_argument);
+}
+
+// ============================================================================
+// Transfer Function Tests
+// ============================================================================
+
+TEST(CrossSpectrumAnalyzerTest, IdenticalChannelsAreUnity) {
+    CrossSpectrumAnalyzer analyzer(linearKey(1024));
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    for (int hop = 0; hop < 8; ++hop) {
+        for (size_t i = 0; i < 1024; ++i) {
+            analyzer.reference_input[i] = noise(rng);
+        }
+        std::copy(analyzer.reference_input.begin(), analyzer.reference_input.end(),
+                  analyzer.measured_input.begin());
+        analyzer.process();
+    }
+    EXPECT_EQ(analyzer.getAveragedFrames(), 8u);
+
+    const FrequencyResampler::BinRange range = analyzer.getInputRange();
+    std::vector<float> magnitude(analyzer.getNumBins());
+    std::vector<float> phase(analyzer.getNumBins());
+    std::vector<float> coherence(analyzer.getNumBins());
+    analyzer.getSpectrum(TransferView::Magnitude, magnitude.data());
+    analyzer.getSpectrum(TransferView::Phase, phase.data());
+    analyzer.getSpectrum(TransferView::Coherence, coherence.data());
+    for (size_t k = range.first; k < range.end - 1; ++k) {
+        EXPECT_NEAR(magnitude[k], 0.0f, 0.01f) << "bin " << k;
+        EXPECT_NEAR(phase[k], 0.0f, 0.1f) << "bin " << k;
+        EXPECT_NEAR(coherence[k], 1.0f, 1e-4f) << "bin " << k;
+    }
+}
+
+TEST(CrossSpectrumAnalyzerTest, GainAndDelay) {
+    // y = 0.5 · x delayed by 3 samples: -6.02 dB, phase -360° · k · 3 / N
+    const size_t n = 1024;
+    const double bin = 40.0;
+    CrossSpectrumAnalyzer analyzer(linearKey(n));
+    binTone(analyzer.reference_input, n, bin, 0.8);
+    binTone(analyzer.measured_input, n, bin, 0.4, 3.0);
+    analyzer.process();
+
+    std::vector<float> magnitude(analyzer.getNumBins());
+    std::vector<float> phase(analyzer.getNumBins());
+    analyzer.getSpectrum(TransferView::Magnitude, magnitude.data());
+    analyzer.getSpectrum(TransferView::Phase, phase.data());
+
+    const size_t k = static_cast<size_t>(bin);
+    EXPECT_NEAR(magnitude[k], 20.0f * std::log10(0.5f), 0.05f);
+    EXPECT_NEAR(phase[k], -360.0 * bin * 3.0 / n, 0.5);
+
+    // Swapping the channels inverts the transfer function
+    binTone(analyzer.reference_input, n, bin, 0.4, 3.0);
+    binTone(analyzer.measured_input, n, bin, 0.8);
+    analyzer.reset();
+    analyzer.process();
+    analyzer.getSpectrum(TransferView::Magnitude, magnitude.data());
+    analyzer.getSpectrum(TransferView::Phase, phase.data());
+    EXPECT_NEAR(magnitude[k], 20.0f * std::log10(2.0f), 0.05f);
+    EXPECT_NEAR(phase[k], 360.0 * bin * 3.0 / n, 0.5);
+}
+
+TEST(CrossSpectrumAnalyzerTest, PackedChannelsStaySeparate) {
+    // Reference tone at bin 40, measured tone at bin 200: neither leaks into
+    // the other's bin through the shared transform
+    const size_t n = 1024;
+    ChainKey key = linearKey(n);
+    key.window = WindowFunction::BlackmanHarris;
+    CrossSpectrumAnalyzer analyzer(key);
+    binTone(analyzer.reference_input, n, 40.0, 0.5);
+    binTone(analyzer.measured_input, n, 200.0, 0.5);
+    analyzer.process();
+
+    std::vector<float> magnitude(analyzer.getNumBins());
+    analyzer.getSpectrum(TransferView::Magnitude, magnitude.data());
+    EXPECT_LT(magnitude[40], -80.0f);
+
+    // Measured only: no reference power, the floor
+    std::fill(analyzer.reference_input.begin(), analyzer.reference_input.end(), 0.0f);
+    analyzer.reset();
+    analyzer.process();
+    analyzer.getSpectrum(TransferView::Magnitude, magnitude.data());
+    EXPECT_FLOAT_EQ(magnitude[200], -200.0f);
+}
+
+// ============================================================================
+// Averaging Tests
+// ============================================================================
+
+TEST(CrossSpectrumAnalyzerTest, NoiseHasLowCoherence) {
+    const size_t n = 512;
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    auto fill = [&](CrossSpectrumAnalyzer& analyzer) {
+        for (size_t i = 0; i < n; ++i) {
+            analyzer.reference_input[i] = noise(rng);
+            analyzer.measured_input[i] = noise(rng);
+        }
+    };
+    auto meanCoherence = [&](const CrossSpectrumAnalyzer& analyzer) {
+        const FrequencyResampler::BinRange range = analyzer.getInputRange();
+        std::vector<float> coherence(analyzer.getNumBins());
+        analyzer.getSpectrum(TransferView::Coherence, coherence.data());
+        double sum = 0.0;
+        for (size_t k = range.first; k < range.end; ++k) {
+            sum += coherence[k];
+        }
+        return sum / static_cast<double>(range.end - range.first);
+    };
+
+    // One hop: coherence is 1 by definition
+    CrossSpectrumAnalyzer::Options options;
+    options.averaging = AveragingMode::None;
+    CrossSpectrumAnalyzer single(linearKey(n), options);
+    fill(single);
+    single.process();
+    EXPECT_NEAR(meanCoherence(single), 1.0, 1e-4);
+
+    // Mean of the last 32 hops: expected coherence of unrelated noise ~1/32
+    options.averaging = AveragingMode::Linear;
+    options.frames = 32;
+    CrossSpectrumAnalyzer linear(linearKey(n), options);
+    for (int hop = 0; hop < 100; ++hop) {
+        fill(linear);
+        linear.process();
+    }
+    EXPECT_EQ(linear.getAveragedFrames(), 32u);
+    EXPECT_LT(meanCoherence(linear), 0.1);
+
+    // Exponential over ~1 s of 128-sample hops
+    options.averaging = AveragingMode::Exponential;
+    options.time_seconds = 1.0f;
+    CrossSpectrumAnalyzer exponential(linearKey(n), options);
+    for (int hop = 0; hop < 1500; ++hop) {
+        fill(exponential);
+        exponential.process();
+    }
+    EXPECT_LT(meanCoherence(exponential), 0.1);
+}
+
+TEST(CrossSpectrumAnalyzerTest, LinearAverageForgetsOldHops) {
+    // 4-hop mean: after 4 hops of a new gain only the new gain remains
+    const size_t n = 512;
+    CrossSpectrumAnalyzer::Options options;
+    options.averaging = AveragingMode::Linear;
+    options.frames = 4;
+    CrossSpectrumAnalyzer analyzer(linearKey(n), options);
+    std::vector<float> magnitude(analyzer.getNumBins());
+
+    for (int hop = 0; hop < 6; ++hop) {
+        binTone(analyzer.reference_input, n, 30.0, 0.5);
+        binTone(analyzer.measured_input, n, 30.0, 0.5);
+        analyzer.process();
+    }
+    for (int hop = 0; hop < 4; ++hop) {
+        binTone(analyzer.reference_input, n, 30.0, 0.5);
+        binTone(analyzer.measured_input, n, 30.0, 0.25);
+        analyzer.process();
+        analyzer.getSpectrum(TransferView::Magnitude, magnitude.data());
+        if (hop < 3) {
+            EXPECT_GT(magnitude[30], -6.0f);
+        }
+    }
+    EXPECT_NEAR(magnitude[30], 20.0f * std::log10(0.5f), 0.01f);
+}
+
+// ============================================================================
+// Display Tests
+// ============================================================================
+
+TEST(CrossSpectrumAnalyzerTest, ResamplesViewsToRows) {
+    const size_t n = 1024;
+    ChainKey key = linearKey(n);
+    key.min_freq = 20.0f;
+    CrossSpectrumAnalyzer analyzer(key);
+    std::mt19937 rng(3);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    for (int hop = 0; hop < 4; ++hop) {
+        for (size_t i = 0; i < n; ++i) {
+            analyzer.reference_input[i] = noise(rng);
+        }
+        // Measured is the reference inverted: ±180° everywhere
+        for (size_t i = 0; i < n; ++i) {
+            analyzer.measured_input[i] = -analyzer.reference_input[i];
+        }
+        analyzer.process();
+    }
+
+    std::vector<float> column(key.height);
+    analyzer.resample(TransferView::Magnitude, column.data());
+    for (float value : column) {
+        EXPECT_NEAR(value, 0.0f, 0.01f);
+    }
+    // Rows between bins at +180° and -180° do not average to 0°
+    analyzer.resample(TransferView::Phase, column.data());
+    for (float value : column) {
+        EXPECT_NEAR(std::abs(value), 180.0f, 0.1f);
+    }
+    analyzer.resample(TransferView::Coherence, column.data());
+    for (float value : column) {
+        EXPECT_NEAR(value, 1.0f, 1e-3f);
+    }
+
+    // 0..1 and -180..180 onto the display range
+    std::vector<float> levels = {0.0f, 0.5f, 1.0f, 2.0f};
+    CrossSpectrumAnalyzer::toDisplayLevels(TransferView::Coherence, levels.data(), levels.size(), -100.0f, 0.0f);
+    EXPECT_FLOAT_EQ(levels[0], -100.0f);
+    EXPECT_FLOAT_EQ(levels[1], -50.0f);
+    EXPECT_FLOAT_EQ(levels[2], 0.0f);
+    EXPECT_FLOAT_EQ(levels[3], 0.0f);
+
+    levels = {-180.0f, 0.0f, 90.0f};
+    CrossSpectrumAnalyzer::toDisplayLevels(TransferView::Phase, levels.data(), levels.size(), -120.0f, 0.0f);
+    EXPECT_FLOAT_EQ(levels[0], -120.0f);
+    EXPECT_FLOAT_EQ(levels[1], -60.0f);
+    EXPECT_FLOAT_EQ(levels[2], -30.0f);
+
+    levels = {-20.0f};
+    CrossSpectrumAnalyzer::toDisplayLevels(TransferView::Magnitude, levels.data(), levels.size(), -120.0f, 0.0f);
+    EXPECT_FLOAT_EQ(levels[0], -20.0f);
+}
+
+// ============================================================================
+// Performance Tests
+// ============================================================================
+
+TEST(CrossSpectrumAnalyzerTest, PerformanceRealtimeFactor) {
+    // 96 kHz, FFT 8192, 75% overlap: 46.9 hops per second of audio
+    ChainKey key = linearKey(8192, 96000.0f);
+    key.min_freq = 20.0f;
+    key.height = 600;
+    CrossSpectrumAnalyzer analyzer(key);
+    std::mt19937 rng(5);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+    for (size_t i = 0; i < key.fft_size; ++i) {
+        analyzer.reference_input[i] = noise(rng);
+        analyzer.measured_input[i] = noise(rng);
+    }
+
+    const size_t hops = 5 * 96000 / analyzer.getHopSize();
+    std::vector<float> column(key.height);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t h = 0; h < hops; ++h) {
+        analyzer.process();
+        analyzer.resample(TransferView::Coherence, column.data());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // Far faster than real time even unoptimized
+    EXPECT_LT(ms, 5000.0);
+
+    std::cout << "\n=== Cross spectrum, 96 kHz, FFT 8192 ===\n";
+    std::cout << "5 s of audio: " << ms << " ms (" << 5000.0 / ms << "x real time)\n";
+}
@@ -6,6 +6,7 @@
  * - Window functions (Hann, Hamming)
  * - FFT processing accuracy
  * - Dynamic reconfiguration
+ * - Bin-range (pruned) output
  * - Performance benchmarks
  */
 
@@ -116,8 +117,8 @@ TEST_F(FFTProcessorTest, SineWave1kHz) {
     EXPECT_NEAR(peak_freq, 1000.0f, 50.0f);
 
     // Peak should be strong
-    // Note: Hann window has coherent gain of 0.5 (-6 dB loss)
-    // For unit amplitude sine, expect peak around -6 to -8 dB
+    // Note: the window's coherent gain is divided out, so a unit amplitude
+    // sine reads -6 dB on a bin and down to ~-7.5 dB between bins
     EXPECT_GT(spectrum[peak_bin], -15.0f);
 }
 
@@ -140,7 +141,7 @@ TEST_F(FFTProcessorTest, MultipleFrequencies) {
     size_t bin880 = static_cast<size_t>(880.0f * 4096 / SAMPLE_RATE);
 
     // Both frequencies should have peaks
-    // Note: Each component is 0.5 amplitude (-6 dB) + Hann window loss (-6 dB) = -12 dB typical
+    // Note: Each component is 0.5 amplitude (-6 dB) + one-sided spectrum (-6 dB) = -12 dB typical
     EXPECT_GT(spectrum[bin440], -22.0f);
     EXPECT_GT(spectrum[bin880], -22.0f);
 }
@@ -174,6 +175,179 @@ TEST_F(FFTProcessorTest, ChangeWindowFunction) {
     EXPECT_NO_THROW(processor.process(signal.data(), output.data()));
 }
 
+// ============================================================================
+// Batch Processing Tests
+// ============================================================================
+
+TEST_F(FFTProcessorTest, BatchMatchesSingleFrame) {
+    const size_t fft_size = 1024;
+    const size_t hop = 256;
+    const size_t num_frames = FFTProcessor::BATCH_FRAMES * 2 + 5;  // Full batches + remainder
+    FFTProcessor processor(fft_size, WindowFunction::Hann);
+    const size_t bins = processor.getNumBins();
+
+    auto signal = generateSine((num_frames - 1) * hop + fft_size, 1500.0f);
+
+    std::vector<float> batch(num_frames * bins);
+    processor.processBatch(signal.data(), hop, num_frames, batch.data(), bins);
+
+    std::vector<float> single(bins);
+    for (size_t f = 0; f < num_frames; ++f) {
+        processor.process(signal.data() + f * hop, single.data());
+        for (size_t k = 0; k < bins; ++k) {
+            ASSERT_NEAR(batch[f * bins + k], single[k], 1e-3f)
+                << "frame " << f << ", bin " << k;
+        }
+    }
+}
+
+TEST_F(FFTProcessorTest, BatchOutputStride) {
+    FFTProcessor processor(256, WindowFunction::Hamming);
+    const size_t bins = processor.getNumBins();
+    const size_t stride = bins + 7;
+    const size_t num_frames = 20;
+
+    auto signal = generateSine(19 * 64 + 256, 3000.0f);
+    std::vector<float> batch(num_frames * stride, 123.0f);
+    processor.processBatch(signal.data(), 64, num_frames, batch.data(), stride);
+
+    // Padding between rows is untouched
+    for (size_t f = 0; f < num_frames; ++f) {
+        for (size_t k = bins; k < stride; ++k) {
+            EXPECT_EQ(batch[f * stride + k], 123.0f);
+        }
+    }
+
+    std::vector<float> single(bins);
+    processor.process(signal.data() + 19 * 64, single.data());
+    EXPECT_NEAR(batch[19 * stride + 10], single[10], 1e-3f);
+}
+
+TEST_F(FFTProcessorTest, BatchInvalidArguments) {
+    FFTProcessor processor(256, WindowFunction::Hann);
+    std::vector<float> signal(1024, 0.0f);
+    std::vector<float> output(4 * 129);
+
+    EXPECT_THROW(processor.processBatch(signal.data(), 0, 4, output.data(), 129),
+                 std::invalid_argument);
+    EXPECT_THROW(processor.processBatch(signal.data(), 64, 4, output.data(), 128),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(processor.processBatch(signal.data(), 64, 0, output.data(), 129));
+}
+
+TEST_F(FFTProcessorTest, BatchAfterFFTSizeChange) {
+    FFTProcessor processor(256, WindowFunction::Hann);
+    std::vector<float> signal(8192, 0.5f);
+    std::vector<float> output(FFTProcessor::BATCH_FRAMES * 1025);
+
+    processor.processBatch(signal.data(), 128, FFTProcessor::BATCH_FRAMES, output.data(), 129);
+
+    // Batch plan must be rebuilt for the new size
+    processor.setFFTSize(2048);
+    processor.processBatch(signal.data(), 128, FFTProcessor::BATCH_FRAMES, output.data(), 1025);
+
+    std::vector<float> single(1025);
+    processor.process(signal.data(), single.data());
+    EXPECT_NEAR(output[0], single[0], 1e-3f);
+}
+
+// ============================================================================
+// Split Frame Tests
+// ============================================================================
+
+TEST_F(FFTProcessorTest, SplitMatchesContiguous) {
+    FFTProcessor processor(1024, WindowFunction::Hann);
+    const size_t bins = processor.getNumBins();
+    auto signal = generateSine(1024, 2500.0f);
+
+    std::vector<float> expected(bins);
+    processor.process(signal.data(), expected.data());
+
+    // Frame wrapped in ring memory: tail of the frame stored before its head
+    for (size_t split : {size_t(0), size_t(1), size_t(300), size_t(1023), size_t(1024)}) {
+        std::vector<float> ring(1024);
+        std::copy(signal.begin() + split, signal.end(), ring.begin());
+        std::copy(signal.begin(), signal.begin() + split, ring.begin() + (1024 - split));
+
+        std::vector<float> output(bins);
+        processor.processSplit(ring.data() + (1024 - split), split, ring.data(), output.data());
+        for (size_t k = 0; k < bins; ++k) {
+            ASSERT_FLOAT_EQ(output[k], expected[k]) << "split " << split << ", bin " << k;
+        }
+    }
+}
+
+TEST_F(FFTProcessorTest, SplitInvalidCount) {
+    FFTProcessor processor(256, WindowFunction::Hann);
+    std::vector<float> signal(256, 0.0f);
+    std::vector<float> output(129);
+
+    EXPECT_THROW(processor.processSplit(signal.data(), 257, nullptr, output.data()),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(processor.processSplit(signal.data(), 256, nullptr, output.data()));
+}
+
+// ============================================================================
+// Bin Range Tests
+// ============================================================================
+
+TEST_F(FFTProcessorTest, BinRangeMatchesFullSpectrum) {
+    FFTProcessor processor(1024, WindowFunction::Hann);
+    const size_t bins = processor.getNumBins();
+    auto signal = generateSine(1024, 700.0f);
+
+    std::vector<float> full(bins);
+    processor.process(signal.data(), full.data());
+
+    std::vector<float> ranged(bins, 123.0f);
+    processor.process(signal.data(), ranged.data(), 10, 50);
+    const float floor_db = 10.0f * std::log10(1e-30f);
+    for (size_t k = 0; k < bins; ++k) {
+        if (k >= 10 && k < 50) {
+            ASSERT_FLOAT_EQ(ranged[k], full[k]) << "bin " << k;
+        } else {
+            ASSERT_FLOAT_EQ(ranged[k], floor_db) << "bin " << k;
+        }
+    }
+
+    // Empty and full ranges
+    EXPECT_NO_THROW(processor.process(signal.data(), ranged.data(), 20, 20));
+    processor.process(signal.data(), ranged.data(), 0, bins);
+    EXPECT_EQ(ranged, full);
+}
+
+TEST_F(FFTProcessorTest, BinRangeBatch) {
+    const size_t hop = 128;
+    const size_t num_frames = FFTProcessor::BATCH_FRAMES + 3;  // Batch + remainder
+    FFTProcessor processor(512, WindowFunction::Hamming);
+    const size_t bins = processor.getNumBins();
+    auto signal = generateSine((num_frames - 1) * hop + 512, 2000.0f);
+
+    std::vector<float> full(num_frames * bins);
+    std::vector<float> ranged(num_frames * bins);
+    processor.processBatch(signal.data(), hop, num_frames, full.data(), bins);
+    processor.processBatch(signal.data(), hop, num_frames, ranged.data(), bins, 5, 100);
+    for (size_t f = 0; f < num_frames; ++f) {
+        for (size_t k = 5; k < 100; ++k) {
+            ASSERT_FLOAT_EQ(ranged[f * bins + k], full[f * bins + k])
+                << "frame " << f << ", bin " << k;
+        }
+        EXPECT_LT(ranged[f * bins + 4], -250.0f);
+        EXPECT_LT(ranged[f * bins + 100], -250.0f);
+    }
+}
+
+TEST_F(FFTProcessorTest, BinRangeInvalid) {
+    FFTProcessor processor(256, WindowFunction::Hann);
+    std::vector<float> signal(512, 0.0f);
+    std::vector<float> output(4 * 129);
+
+    EXPECT_THROW(processor.process(signal.data(), output.data(), 10, 5), std::invalid_argument);
+    EXPECT_THROW(processor.process(signal.data(), output.data(), 0, 130), std::invalid_argument);
+    EXPECT_THROW(processor.processBatch(signal.data(), 64, 4, output.data(), 129, 0, 130),
+                 std::invalid_argument);
+}
+
 // ============================================================================
 // Performance Tests
 // ============================================================================
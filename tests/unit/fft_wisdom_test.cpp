@@ -0,0 +1,136 @@
+/**
+ * @file fft_wisdom_test.cpp
+ * @brief Unit tests for FFTWisdom
+ *
+ * Tests cover:
+ * - Save/load round trip through a cache file
+ * - Per-user default cache path
+ * - Synchronous and background planning of all sizes
+ * - FFTProcessor construction concurrent with background planning
+ */
+
+#include <gtest/gtest.h>
+#include <friture/fft_wisdom.hpp>
+#include <friture/fft_processor.hpp>
+#include <filesystem>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace friture;
+
+// ============================================================================
+// Test Fixtures
+// ============================================================================
+
+class FFTWisdomTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_dir_ = std::filesystem::temp_directory_path() / "friture_wisdom_test";
+        std::filesystem::remove_all(temp_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(temp_dir_);
+    }
+
+    std::filesystem::path temp_dir_;
+};
+
+// ============================================================================
+// Persistence Tests
+// ============================================================================
+
+TEST_F(FFTWisdomTest, LoadMissingFile) {
+    FFTWisdom wisdom((temp_dir_ / "missing.wisdom").string());
+    EXPECT_FALSE(wisdom.load());
+}
+
+TEST_F(FFTWisdomTest, SaveCreatesDirectoriesAndLoads) {
+    std::string path = (temp_dir_ / "nested" / "dir" / "fftw3f.wisdom").string();
+    FFTWisdom wisdom(path);
+
+    // Create at least one plan so there is wisdom to export
+    FFTProcessor processor(1024, WindowFunction::Hann);
+
+    EXPECT_TRUE(wisdom.save());
+    EXPECT_TRUE(std::filesystem::exists(path));
+
+    FFTWisdom reloaded(path);
+    EXPECT_TRUE(reloaded.load());
+}
+
+TEST_F(FFTWisdomTest, EmptyPathIsInMemoryOnly) {
+    FFTWisdom wisdom("");
+    EXPECT_FALSE(wisdom.load());
+    EXPECT_FALSE(wisdom.save());
+}
+
+#ifndef _WIN32
+TEST_F(FFTWisdomTest, DefaultCachePathUsesXdgCacheHome) {
+    const char* old = std::getenv("XDG_CACHE_HOME");
+    std::string saved = old ? old : "";
+
+    setenv("XDG_CACHE_HOME", "/tmp/xdg_cache", 1);
+    EXPECT_EQ(FFTWisdom::defaultCachePath(), "/tmp/xdg_cache/friture/fftw3f.wisdom");
+
+    if (old) {
+        setenv("XDG_CACHE_HOME", saved.c_str(), 1);
+    } else {
+        unsetenv("XDG_CACHE_HOME");
+    }
+}
+#endif
+
+// ============================================================================
+// Planning Tests
+// ============================================================================
+
+TEST_F(FFTWisdomTest, PlanAllSizes) {
+    // 32, 64, ..., 16384
+    EXPECT_EQ(FFTWisdom::planAllSizes(FFTW_ESTIMATE), 10u);
+}
+
+TEST_F(FFTWisdomTest, PlanAllSizesCancelled) {
+    std::atomic<bool> cancel(true);
+    EXPECT_EQ(FFTWisdom::planAllSizes(FFTW_ESTIMATE, &cancel), 0u);
+}
+
+TEST_F(FFTWisdomTest, BackgroundPlanningWithConcurrentProcessors) {
+    FFTWisdom wisdom("");
+    wisdom.startBackgroundPlanning(FFTW_ESTIMATE);
+
+    // Constructing processors while the background planner runs must be safe
+    std::vector<float> signal(2048, 0.25f);
+    std::vector<float> output(1025);
+    for (int i = 0; i < 20; ++i) {
+        FFTProcessor processor(2048, WindowFunction::Hann);
+        processor.process(signal.data(), output.data());
+    }
+
+    for (int i = 0; i < 500 && !wisdom.isPlanningComplete(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    wisdom.stopBackgroundPlanning();
+
+    EXPECT_TRUE(wisdom.isPlanningComplete());
+}
+
+TEST_F(FFTWisdomTest, WarmUpSaves) {
+    std::string path = (temp_dir_ / "warm.wisdom").string();
+    FFTWisdom wisdom(path);
+
+    EXPECT_TRUE(wisdom.warmUp(FFTW_ESTIMATE));
+    EXPECT_TRUE(wisdom.isPlanningComplete());
+    EXPECT_TRUE(std::filesystem::exists(path));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,220 @@
+/**
+ * @file file_streamer_test.cpp
+ * @brief Unit tests for FileStreamer
+ *
+ * Tests cover:
+ * - Construction and parameter validation
+ * - Sources many times longer than the ring read back exactly
+ * - Back-pressure keeps the producer within one buffer of the reader
+ * - Rewind, restart with a new source, end of source
+ * - Short sources padded with silence
+ * - Catch-up backlogs larger than the read-ahead, read in chunks
+ */
+
+#include <gtest/gtest.h>
+#include <friture/audio/file_streamer.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+/**
+ * @brief Sample value that encodes its own position
+ */
+float sampleAt(uint64_t position) {
+    return static_cast<float>(position % 100003);
+}
+
+FileStreamer::Source countingSource(std::atomic<uint64_t>* max_requested = nullptr) {
+    return [max_requested](uint64_t position, float* output, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            output[i] = sampleAt(position + i);
+        }
+        if (max_requested) {
+            uint64_t end = position + count;
+            uint64_t seen = max_requested->load();
+            while (end > seen && !max_requested->compare_exchange_weak(seen, end)) {
+            }
+        }
+        return count;
+    };
+}
+
+} // namespace
+
+// ============================================================================
+// Construction Tests
+// ============================================================================
+
+TEST(FileStreamerTest, RejectsInvalidParameters) {
+    EXPECT_THROW(FileStreamer(1024, 0), std::invalid_argument);
+    EXPECT_THROW(FileStreamer(1000, 512), std::invalid_argument);
+    EXPECT_NO_THROW(FileStreamer(1024, 512));
+
+    FileStreamer streamer(4096, 1024);
+    EXPECT_EQ(streamer.getCapacity(), 4096u);
+    EXPECT_EQ(streamer.getBlockSize(), 1024u);
+    EXPECT_EQ(streamer.getMaxRead(), 3072u);
+}
+
+TEST(FileStreamerTest, NoSourceReadsFail) {
+    FileStreamer streamer(4096, 1024);
+    float out[16];
+    EXPECT_FALSE(streamer.read(0, out, 16));
+    EXPECT_EQ(streamer.getLength(), 0u);
+}
+
+// ============================================================================
+// Streaming Tests
+// ============================================================================
+
+TEST(FileStreamerTest, StreamsSourcesMuchLongerThanTheRing) {
+    // 50 ring capacities of overlapping windows; a whole-file ring of this
+    // size would have wrapped onto its own beginning
+    constexpr size_t capacity = 8192;
+    constexpr uint64_t length = 50 * capacity;
+    constexpr size_t window = 2048;
+    constexpr size_t hop = 512;
+
+    FileStreamer streamer(capacity, 1024);
+    streamer.start(countingSource(), length);
+
+    std::vector<float> out(window);
+    uint64_t position = 0;
+    for (; position + window <= length; position += hop) {
+        ASSERT_TRUE(streamer.read(position, out.data(), window));
+        for (size_t i = 0; i < window; i += 97) {
+            ASSERT_EQ(out[i], sampleAt(position + i)) << "position " << position << " + " << i;
+        }
+        ASSERT_EQ(out[window - 1], sampleAt(position + window - 1));
+    }
+
+    EXPECT_FALSE(streamer.read(position, out.data(), window));
+    EXPECT_EQ(streamer.getBufferedEnd(), length);
+}
+
+TEST(FileStreamerTest, BackPressureBoundsReadAhead) {
+    constexpr size_t capacity = 8192;
+    std::atomic<uint64_t> max_requested{0};
+
+    FileStreamer streamer(capacity, 1024);
+    streamer.start(countingSource(&max_requested), 1000000);
+
+    float out[256];
+    for (uint64_t position : {0u, 3000u, 20000u}) {
+        ASSERT_TRUE(streamer.read(position, out, 256));
+
+        // Give the producer time to run as far ahead as it is allowed to
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_LE(max_requested.load(), position + capacity);
+        EXPECT_GT(max_requested.load(), position + capacity - 1024);
+    }
+}
+
+TEST(FileStreamerTest, RewindRestartsProduction) {
+    FileStreamer streamer(4096, 512);
+    streamer.start(countingSource(), 100000);
+
+    float out[1024];
+    ASSERT_TRUE(streamer.read(50000, out, 1024));
+    EXPECT_EQ(out[0], sampleAt(50000));
+
+    ASSERT_TRUE(streamer.read(0, out, 1024));
+    for (size_t i = 0; i < 1024; ++i) {
+        ASSERT_EQ(out[i], sampleAt(i));
+    }
+
+    ASSERT_TRUE(streamer.read(10, out, 1024));
+    EXPECT_EQ(out[0], sampleAt(10));
+}
+
+TEST(FileStreamerTest, StartReplacesSource) {
+    FileStreamer streamer(4096, 512);
+    streamer.start(countingSource(), 100000);
+
+    float out[64];
+    ASSERT_TRUE(streamer.read(0, out, 64));
+    ASSERT_TRUE(streamer.read(1000, out, 64));
+
+    streamer.start([](uint64_t, float* output, size_t count) {
+        std::fill(output, output + count, -1.0f);
+        return count;
+    }, 2000);
+
+    EXPECT_EQ(streamer.getLength(), 2000u);
+    ASSERT_TRUE(streamer.read(0, out, 64));
+    EXPECT_EQ(out[0], -1.0f);
+    EXPECT_EQ(out[63], -1.0f);
+    EXPECT_FALSE(streamer.read(1990, out, 64));
+
+    streamer.stop();
+    EXPECT_FALSE(streamer.read(0, out, 64));
+}
+
+TEST(FileStreamerTest, ShortSourcePaddedWithSilence) {
+    FileStreamer streamer(4096, 512);
+    streamer.start([](uint64_t position, float* output, size_t count) {
+        // Produces only the first 100 samples it is asked for
+        size_t n = position < 100 ? std::min<size_t>(count, 100 - position) : 0;
+        std::fill(output, output + n, 1.0f);
+        return n;
+    }, 1000);
+
+    float out[200];
+    ASSERT_TRUE(streamer.read(0, out, 200));
+    EXPECT_EQ(out[99], 1.0f);
+    EXPECT_EQ(out[100], 0.0f);
+    EXPECT_EQ(out[199], 0.0f);
+}
+
+TEST(FileStreamerTest, OversizedReadThrows) {
+    FileStreamer streamer(4096, 1024);
+    streamer.start(countingSource(), 100000);
+
+    std::vector<float> out(4096);
+    EXPECT_THROW(streamer.read(0, out.data(), 4096), std::invalid_argument);
+    EXPECT_TRUE(streamer.read(0, out.data(), streamer.getMaxRead()));
+}
+
+TEST(FileStreamerTest, BacklogLargerThanReadAheadIsReadInChunks) {
+    // A catch-up backlog of 200 windows (a stalled analysis thread) spans
+    // far more than the ring: one read of it throws, chunks of
+    // getMaxWindows() each read back every window exactly
+    constexpr size_t window = 1024;
+    constexpr size_t hop = 256;
+    constexpr size_t backlog = 200;
+    FileStreamer streamer(8192, 1024);
+    streamer.start(countingSource(), 1000000);
+
+    const size_t max_windows = streamer.getMaxWindows(window, hop);
+    ASSERT_GT(max_windows, 0u);
+    ASSERT_LT(max_windows, backlog);
+    EXPECT_LE((max_windows - 1) * hop + window, streamer.getMaxRead());
+    EXPECT_GT(max_windows * hop + window, streamer.getMaxRead());
+
+    std::vector<float> out((backlog - 1) * hop + window);
+    EXPECT_THROW(streamer.read(0, out.data(), out.size()), std::invalid_argument);
+
+    uint64_t position = 0;
+    size_t remaining = backlog;
+    while (remaining > 0) {
+        const size_t columns = std::min(remaining, max_windows);
+        const size_t span = (columns - 1) * hop + window;
+        ASSERT_TRUE(streamer.read(position, out.data(), span));
+        for (size_t i = 0; i < span; ++i) {
+            ASSERT_EQ(out[i], sampleAt(position + i)) << "sample " << position + i;
+        }
+        position += columns * hop;
+        remaining -= columns;
+    }
+    EXPECT_EQ(position, backlog * hop);
+
+    EXPECT_EQ(streamer.getMaxWindows(streamer.getMaxRead() + 1, hop), 0u);
+    EXPECT_EQ(streamer.getMaxWindows(streamer.getMaxRead(), hop), 1u);
+}
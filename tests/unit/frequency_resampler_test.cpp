@@ -7,6 +7,8 @@
  * - Frequency mapping accuracy
  * - Interpolation quality
  * - Dynamic reconfiguration
+ * - Band aggregation (mean power / peak hold)
+ * - Row-range resampling and input bin ranges
  * - Performance benchmarks
  * - Edge cases
  * - Headless mapping visualization
@@ -19,6 +21,7 @@
 #include <chrono>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 using namespace friture;
 
@@ -531,6 +534,221 @@ TEST_F(FrequencyResamplerTest, SmallOutputHeight) {
     EXPECT_NO_THROW(resampler.resample(input.data(), output.data()));
 }
 
+// ============================================================================
+// Band Aggregation Tests
+// ============================================================================
+
+TEST_F(FrequencyResamplerTest, BandsContiguousAndNormalized) {
+    // 16384-point FFT on 700 linear rows: ~11.7 bins per row
+    const size_t fft_size = 16384;
+    FrequencyResampler resampler(FrequencyScale::Linear, MIN_FREQ, MAX_FREQ,
+                                 SAMPLE_RATE, fft_size, 700, BinAggregation::MeanPower);
+
+    const auto& bands = resampler.getBands();
+    const auto& weights = resampler.getBandWeights();
+    ASSERT_EQ(bands.size(), 700u);
+
+    for (size_t i = 0; i < bands.size(); ++i) {
+        const auto& band = bands[i];
+        EXPECT_FALSE(band.interpolated);
+        float sum = 0.0f;
+        for (uint32_t k = 0; k < band.count; ++k) {
+            sum += weights[band.weight_offset + k];
+        }
+        EXPECT_NEAR(sum, 1.0f, 1e-5f);
+
+        // Top row is cut in half at Nyquist
+        if (i + 1 < bands.size()) {
+            EXPECT_GE(band.count, 11u);
+            EXPECT_LE(band.count, 14u);
+        }
+    }
+
+    // Bands are contiguous: each row starts where the previous one ended
+    for (size_t i = 1; i < bands.size(); ++i) {
+        uint32_t prev_end = bands[i - 1].start_bin + bands[i - 1].count;
+        EXPECT_GE(prev_end, bands[i].start_bin);
+        EXPECT_LE(prev_end, bands[i].start_bin + 1);
+    }
+}
+
+TEST_F(FrequencyResamplerTest, NarrowBandsMatchInterpolation) {
+    // 4096-point FFT on 1080 Mel rows: low rows are narrower than one bin
+    FrequencyResampler interp(FrequencyScale::Mel, MIN_FREQ, MAX_FREQ,
+                              SAMPLE_RATE, FFT_SIZE, OUTPUT_HEIGHT);
+    FrequencyResampler mean(FrequencyScale::Mel, MIN_FREQ, MAX_FREQ,
+                            SAMPLE_RATE, FFT_SIZE, OUTPUT_HEIGHT, BinAggregation::MeanPower);
+
+    std::vector<float> input(FFT_SIZE / 2 + 1);
+    for (size_t k = 0; k < input.size(); ++k) {
+        input[k] = -100.0f + 80.0f * std::sin(0.37f * static_cast<float>(k));
+    }
+
+    std::vector<float> expected(OUTPUT_HEIGHT);
+    std::vector<float> actual(OUTPUT_HEIGHT);
+    interp.resample(input.data(), expected.data());
+    mean.resample(input.data(), actual.data());
+
+    size_t narrow = 0;
+    for (size_t i = 0; i < OUTPUT_HEIGHT; ++i) {
+        if (mean.getBands()[i].interpolated) {
+            EXPECT_NEAR(actual[i], expected[i], 1e-3f) << "row " << i;
+            ++narrow;
+        }
+    }
+    EXPECT_GT(narrow, 100u);
+    EXPECT_LT(narrow, OUTPUT_HEIGHT);
+}
+
+TEST_F(FrequencyResamplerTest, FlatSpectrumAllAggregations) {
+    const size_t fft_size = 16384;
+    std::vector<float> input(fft_size / 2 + 1, -42.0f);
+    std::vector<float> output(500);
+
+    for (auto mode : {BinAggregation::Interpolate, BinAggregation::MeanPower,
+                      BinAggregation::PeakHold}) {
+        FrequencyResampler resampler(FrequencyScale::Linear, MIN_FREQ, MAX_FREQ,
+                                     SAMPLE_RATE, fft_size, 500, mode);
+        resampler.resample(input.data(), output.data());
+        for (float value : output) {
+            EXPECT_NEAR(value, -42.0f, 1e-3f) << toString(mode);
+        }
+    }
+}
+
+TEST_F(FrequencyResamplerTest, NarrowToneNeverSkipped) {
+    // A single-bin tone anywhere in the range must show up in its row
+    const size_t fft_size = 16384;
+    const size_t height = 700;
+    FrequencyResampler interp(FrequencyScale::Linear, MIN_FREQ, MAX_FREQ,
+                              SAMPLE_RATE, fft_size, height);
+    FrequencyResampler peak(FrequencyScale::Linear, MIN_FREQ, MAX_FREQ,
+                            SAMPLE_RATE, fft_size, height, BinAggregation::PeakHold);
+    FrequencyResampler mean(FrequencyScale::Linear, MIN_FREQ, MAX_FREQ,
+                            SAMPLE_RATE, fft_size, height, BinAggregation::MeanPower);
+
+    std::vector<float> output(height);
+    size_t interp_missed = 0;
+
+    for (size_t bin = 100; bin < 8000; bin += 37) {
+        std::vector<float> input(fft_size / 2 + 1, -120.0f);
+        input[bin] = 0.0f;
+
+        peak.resample(input.data(), output.data());
+        EXPECT_FLOAT_EQ(*std::max_element(output.begin(), output.end()), 0.0f) << "bin " << bin;
+
+        // Mean of ~12 bins with one at 0 dB: about -10.7 dB, never lost
+        mean.resample(input.data(), output.data());
+        EXPECT_GT(*std::max_element(output.begin(), output.end()), -16.0f) << "bin " << bin;
+
+        interp.resample(input.data(), output.data());
+        if (*std::max_element(output.begin(), output.end()) < -100.0f) {
+            ++interp_missed;
+        }
+    }
+
+    // Interpolation skips most single-bin tones at this resolution
+    EXPECT_GT(interp_missed, 100u);
+}
+
+TEST_F(FrequencyResamplerTest, ResampleRowsMatchesResample) {
+    const size_t height = 300;
+    std::vector<float> input(FFT_SIZE / 2 + 1);
+    for (size_t k = 0; k < input.size(); ++k) {
+        input[k] = -100.0f + 60.0f * std::sin(0.05f * static_cast<float>(k));
+    }
+
+    for (auto mode : {BinAggregation::Interpolate, BinAggregation::MeanPower,
+                      BinAggregation::PeakHold}) {
+        FrequencyResampler resampler(FrequencyScale::Logarithmic, MIN_FREQ, MAX_FREQ,
+                                     SAMPLE_RATE, FFT_SIZE, height, mode);
+        std::vector<float> expected(height);
+        resampler.resample(input.data(), expected.data());
+
+        // Only the requested rows are written
+        std::vector<float> rows(height, 1.0f);
+        resampler.resampleRows(input.data(), rows.data(), 40, 100);
+        for (size_t i = 0; i < height; ++i) {
+            if (i >= 40 && i < 140) {
+                EXPECT_FLOAT_EQ(rows[i], expected[i]) << toString(mode) << " row " << i;
+            } else {
+                EXPECT_EQ(rows[i], 1.0f) << toString(mode) << " row " << i;
+            }
+        }
+    }
+
+    FrequencyResampler resampler(FrequencyScale::Mel, MIN_FREQ, MAX_FREQ,
+                                 SAMPLE_RATE, FFT_SIZE, height);
+    std::vector<float> output(height);
+    EXPECT_THROW(resampler.resampleRows(input.data(), output.data(), 200, 101),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(resampler.resampleRows(input.data(), output.data(), height, 0));
+}
+
+TEST_F(FrequencyResamplerTest, InputRangeCoversEveryRead) {
+    // Zoomed to 20-2000 Hz: only a small slice of the spectrum is read
+    const size_t height = 300;
+    const size_t num_bins = FFT_SIZE / 2 + 1;
+    std::vector<float> input(num_bins);
+    for (size_t k = 0; k < num_bins; ++k) {
+        input[k] = -100.0f + 60.0f * std::sin(0.05f * static_cast<float>(k));
+    }
+
+    for (auto scale : {FrequencyScale::Linear, FrequencyScale::Logarithmic, FrequencyScale::Mel}) {
+        for (auto mode : {BinAggregation::Interpolate, BinAggregation::MeanPower,
+                          BinAggregation::PeakHold}) {
+            FrequencyResampler resampler(scale, 20.0f, 2000.0f, SAMPLE_RATE,
+                                         FFT_SIZE, height, mode);
+            auto range = resampler.getInputRange();
+            ASSERT_LT(range.first, range.end);
+            ASSERT_LE(range.end, num_bins);
+            EXPECT_LT(range.end - range.first, num_bins / 10);
+
+            // Poison everything outside the range: no row may change
+            std::vector<float> pruned(num_bins, std::nanf(""));
+            std::copy(input.begin() + range.first, input.begin() + range.end,
+                      pruned.begin() + range.first);
+            std::vector<float> expected(height);
+            std::vector<float> actual(height);
+            resampler.resample(input.data(), expected.data());
+            resampler.resample(pruned.data(), actual.data());
+            for (size_t i = 0; i < height; ++i) {
+                ASSERT_FLOAT_EQ(actual[i], expected[i]) << toString(mode) << " row " << i;
+            }
+
+            // Row sub-ranges
+            auto rows = resampler.getInputRange(100, 50);
+            EXPECT_GE(rows.first, range.first);
+            EXPECT_LE(rows.end, range.end);
+            std::vector<float> row_input(num_bins, std::nanf(""));
+            std::copy(input.begin() + rows.first, input.begin() + rows.end,
+                      row_input.begin() + rows.first);
+            resampler.resampleRows(row_input.data(), actual.data(), 100, 50);
+            for (size_t i = 100; i < 150; ++i) {
+                ASSERT_FLOAT_EQ(actual[i], expected[i]) << toString(mode) << " row " << i;
+            }
+        }
+    }
+
+    FrequencyResampler resampler(FrequencyScale::Mel, MIN_FREQ, MAX_FREQ,
+                                 SAMPLE_RATE, FFT_SIZE, height);
+    EXPECT_THROW(resampler.getInputRange(0, 0), std::invalid_argument);
+    EXPECT_THROW(resampler.getInputRange(200, 101), std::invalid_argument);
+}
+
+TEST_F(FrequencyResamplerTest, SetAggregation) {
+    FrequencyResampler resampler(FrequencyScale::Mel, MIN_FREQ, MAX_FREQ,
+                                 SAMPLE_RATE, FFT_SIZE, OUTPUT_HEIGHT);
+    EXPECT_EQ(resampler.getAggregation(), BinAggregation::Interpolate);
+
+    resampler.setAggregation(BinAggregation::PeakHold);
+    EXPECT_EQ(resampler.getAggregation(), BinAggregation::PeakHold);
+
+    // Matrix follows reconfiguration
+    resampler.setOutputHeight(200);
+    EXPECT_EQ(resampler.getBands().size(), 200u);
+}
+
 // ============================================================================
 // Performance Benchmarks
 // ============================================================================
@@ -618,6 +836,36 @@ TEST_F(FrequencyResamplerTest, PerformanceAllScales) {
     std::cout << "\n";
 }
 
+TEST_F(FrequencyResamplerTest, PerformanceAggregation16384) {
+    const size_t fft_size = 16384;
+    const int iterations = 2000;
+    std::vector<float> input(fft_size / 2 + 1);
+    for (size_t k = 0; k < input.size(); ++k) {
+        input[k] = -60.0f + 20.0f * std::sin(0.01f * static_cast<float>(k));
+    }
+    std::vector<float> output(OUTPUT_HEIGHT);
+
+    std::cout << "\n=== Aggregation Performance (16384 FFT -> 1080 px, Linear) ===\n";
+    for (auto mode : {BinAggregation::Interpolate, BinAggregation::MeanPower,
+                      BinAggregation::PeakHold}) {
+        FrequencyResampler resampler(FrequencyScale::Linear, MIN_FREQ, MAX_FREQ,
+                                     SAMPLE_RATE, fft_size, OUTPUT_HEIGHT, mode);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            resampler.resample(input.data(), output.data());
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        float avg_us = std::chrono::duration<float, std::micro>(end - start).count() / iterations;
+        std::cout << std::setw(15) << toString(mode)
+                  << std::setw(15) << std::fixed << std::setprecision(3) << avg_us << " us\n";
+
+        // Linear in bins: well under the 85 ms hop of a 16384-point FFT
+        EXPECT_LT(avg_us, 100.0f) << toString(mode);
+    }
+}
+
 // ============================================================================
 // Mapping Visualization (Headless)
 // ============================================================================
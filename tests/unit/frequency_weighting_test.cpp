@@ -0,0 +1,158 @@
+/**
+ * @file frequency_weighting_test.cpp
+ * @brief Unit tests for the A/B/C frequency weighting
+ *
+ * Tests cover:
+ * - Curve values against the IEC 61672-1 tables
+ * - Per-bin tables: DC floor, sharing through the cache, invalid layouts
+ * - FrequencyResampler in all aggregation modes matching a pre-weighted input
+ * - Weighting kept across reconfiguration, and carried by ChainKey
+ */
+
+#include <gtest/gtest.h>
+#include <friture/frequency_weighting.hpp>
+#include <friture/frequency_resampler.hpp>
+#include <friture/processing_chain.hpp>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+using namespace friture;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr size_t FFT_SIZE = 4096;
+constexpr size_t NUM_BINS = FFT_SIZE / 2 + 1;
+
+// Smooth spectrum with some structure, in dB
+std::vector<float> makeSpectrum() {
+    std::vector<float> spectrum(NUM_BINS);
+    for (size_t k = 0; k < NUM_BINS; ++k) {
+        spectrum[k] = -60.0f + 20.0f * std::sin(0.013f * static_cast<float>(k)) -
+                      0.01f * static_cast<float>(k);
+    }
+    return spectrum;
+}
+
+// Weighted resampler output vs. a flat resampler fed the weighted spectrum
+void expectMatchesPreWeighted(FrequencyScale scale, BinAggregation aggregation, WeightingType type) {
+    FrequencyResampler weighted(scale, 20.0f, 20000.0f, SAMPLE_RATE, FFT_SIZE, 300, aggregation);
+    FrequencyResampler flat(scale, 20.0f, 20000.0f, SAMPLE_RATE, FFT_SIZE, 300, aggregation);
+    weighted.setWeighting(type);
+
+    const std::vector<float> spectrum = makeSpectrum();
+    const auto table = weightingTable(type, FFT_SIZE, SAMPLE_RATE);
+    std::vector<float> pre_weighted(NUM_BINS);
+    for (size_t k = 0; k < NUM_BINS; ++k) {
+        pre_weighted[k] = spectrum[k] + (*table)[k];
+    }
+
+    std::vector<float> actual(300), expected(300);
+    weighted.resample(spectrum.data(), actual.data());
+    flat.resample(pre_weighted.data(), expected.data());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        ASSERT_NEAR(actual[i], expected[i], 1e-3f)
+            << toString(aggregation) << " row " << i;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Curve Tests
+// ============================================================================
+
+TEST(FrequencyWeightingTest, CurvesMatchStandardTables) {
+    // IEC 61672-1 table 3 (values rounded to 0.1 dB, at the exact
+    // frequencies 10^(n/10) behind the nominal ones)
+    EXPECT_NEAR(weightingDb(WeightingType::A, 1000.0), 0.0, 1e-9);
+    EXPECT_NEAR(weightingDb(WeightingType::A, 100.0), -19.1, 0.1);
+    EXPECT_NEAR(weightingDb(WeightingType::A, 31.623), -39.4, 0.1);
+    EXPECT_NEAR(weightingDb(WeightingType::A, 10000.0), -2.5, 0.1);
+    EXPECT_NEAR(weightingDb(WeightingType::B, 100.0), -5.6, 0.1);
+    EXPECT_NEAR(weightingDb(WeightingType::C, 100.0), -0.3, 0.1);
+    EXPECT_NEAR(weightingDb(WeightingType::C, 1000.0), 0.0, 1e-9);
+    EXPECT_NEAR(weightingDb(WeightingType::C, 10000.0), -4.4, 0.1);
+    EXPECT_EQ(weightingDb(WeightingType::None, 50.0), 0.0);
+}
+
+TEST(FrequencyWeightingTest, TableClampsDcAndIsShared) {
+    const auto table = weightingTable(WeightingType::A, FFT_SIZE, SAMPLE_RATE);
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->size(), NUM_BINS);
+    EXPECT_EQ((*table)[0], WEIGHTING_FLOOR_DB);
+
+    // Bin at 1 kHz (48000 / 4096 * 85.33): close to 0 dB
+    EXPECT_NEAR((*table)[85], weightingDb(WeightingType::A, 85.0 * SAMPLE_RATE / FFT_SIZE), 1e-4);
+
+    EXPECT_EQ(weightingTable(WeightingType::A, FFT_SIZE, SAMPLE_RATE), table);
+    EXPECT_NE(weightingTable(WeightingType::C, FFT_SIZE, SAMPLE_RATE), table);
+    EXPECT_NE(weightingTable(WeightingType::A, FFT_SIZE * 2, SAMPLE_RATE), table);
+}
+
+TEST(FrequencyWeightingTest, NoneHasNoTable) {
+    EXPECT_EQ(weightingTable(WeightingType::None, FFT_SIZE, SAMPLE_RATE), nullptr);
+    EXPECT_THROW(weightingTable(WeightingType::A, 0, SAMPLE_RATE), std::invalid_argument);
+    EXPECT_THROW(weightingTable(WeightingType::A, FFT_SIZE, 0.0f), std::invalid_argument);
+}
+
+// ============================================================================
+// Resampler Tests
+// ============================================================================
+
+TEST(FrequencyWeightingTest, ResamplerMatchesPreWeightedInput) {
+    for (BinAggregation aggregation : {BinAggregation::Interpolate, BinAggregation::MeanPower,
+                                       BinAggregation::PeakHold}) {
+        // Log: interpolated low rows and wide high rows in one column
+        expectMatchesPreWeighted(FrequencyScale::Logarithmic, aggregation, WeightingType::A);
+        expectMatchesPreWeighted(FrequencyScale::Linear, aggregation, WeightingType::C);
+    }
+    expectMatchesPreWeighted(FrequencyScale::Mel, BinAggregation::MeanPower, WeightingType::B);
+}
+
+TEST(FrequencyWeightingTest, WeightingSurvivesReconfiguration) {
+    FrequencyResampler resampler(FrequencyScale::Mel, 20.0f, 20000.0f, SAMPLE_RATE, FFT_SIZE, 200,
+                                 BinAggregation::MeanPower);
+    resampler.setWeighting(WeightingType::A);
+    resampler.setScale(FrequencyScale::Logarithmic);
+    resampler.setOutputHeight(300);
+    EXPECT_EQ(resampler.getWeighting(), WeightingType::A);
+
+    FrequencyResampler fresh(FrequencyScale::Logarithmic, 20.0f, 20000.0f, SAMPLE_RATE, FFT_SIZE, 300,
+                             BinAggregation::MeanPower);
+    fresh.setWeighting(WeightingType::A);
+
+    const std::vector<float> spectrum = makeSpectrum();
+    std::vector<float> a(300), b(300);
+    resampler.resample(spectrum.data(), a.data());
+    fresh.resample(spectrum.data(), b.data());
+    EXPECT_EQ(a, b);
+
+    // Back to flat
+    FrequencyResampler flat(FrequencyScale::Logarithmic, 20.0f, 20000.0f, SAMPLE_RATE, FFT_SIZE, 300,
+                            BinAggregation::MeanPower);
+    resampler.setWeighting(WeightingType::None);
+    resampler.resample(spectrum.data(), a.data());
+    flat.resample(spectrum.data(), b.data());
+    EXPECT_EQ(a, b);
+}
+
+TEST(FrequencyWeightingTest, ChainKeyCarriesWeighting) {
+    SpectrogramSettings settings;
+    settings.weighting = WeightingType::C;
+    const ChainKey key = ChainKey::fromSettings(settings, 200);
+    EXPECT_EQ(key.weighting, WeightingType::C);
+
+    ChainKey flat = key;
+    flat.weighting = WeightingType::None;
+    EXPECT_FALSE(flat == key);
+
+    // Both chains share one FFT but weight their own rows
+    ProcessingChainCache cache;
+    auto weighted_chain = cache.acquire(key);
+    auto flat_chain = cache.acquire(flat);
+    EXPECT_EQ(&weighted_chain->fft(), &flat_chain->fft());
+    EXPECT_EQ(weighted_chain->resampler().getWeighting(), WeightingType::C);
+    EXPECT_EQ(flat_chain->resampler().getWeighting(), WeightingType::None);
+}
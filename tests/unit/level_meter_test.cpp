@@ -0,0 +1,165 @@
+/**
+ * @file level_meter_test.cpp
+ * @brief Unit tests for LevelMeter
+ *
+ * Tests cover:
+ * - RMS averaging and peak release
+ * - True-peak detection of inter-sample overs
+ * - Clip counting
+ * - Following a RingBuffer from a private cursor
+ */
+
+#define _USE_MATH_DEFINES  // For M_PI on Windows/MSVC
+#include <gtest/gtest.h>
+#include <friture/level_meter.hpp>
+#include <friture/ringbuffer.hpp>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+
+using namespace friture;
+
+namespace {
+
+std::vector<float> makeSine(float frequency, float sample_rate, size_t count,
+                            float amplitude = 1.0f, float phase = 0.0f) {
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = amplitude * std::sin(2.0f * static_cast<float>(M_PI) * frequency * i / sample_rate + phase);
+    }
+    return samples;
+}
+
+} // namespace
+
+// ============================================================================
+// Construction Tests
+// ============================================================================
+
+TEST(LevelMeterTest, InvalidArguments) {
+    EXPECT_THROW(LevelMeter(0.0f), std::invalid_argument);
+    EXPECT_THROW(LevelMeter(48000.0f, 0.0f), std::invalid_argument);
+    EXPECT_THROW(LevelMeter(48000.0f, 0.3f, -1.0f), std::invalid_argument);
+}
+
+TEST(LevelMeterTest, InitiallySilent) {
+    LevelMeter meter(48000.0f);
+    EXPECT_FLOAT_EQ(meter.getRms(), 0.0f);
+    EXPECT_FLOAT_EQ(meter.getPeak(), 0.0f);
+    EXPECT_FLOAT_EQ(meter.getTruePeak(), 0.0f);
+    EXPECT_EQ(meter.getClipCount(), 0u);
+}
+
+// ============================================================================
+// Measurement Tests
+// ============================================================================
+
+TEST(LevelMeterTest, SineRmsConverges) {
+    LevelMeter meter(48000.0f, 0.1f);
+    auto sine = makeSine(1000.0f, 48000.0f, 48000, 0.5f);
+
+    for (size_t i = 0; i < sine.size(); i += 480) {
+        meter.process(sine.data() + i, 480);
+    }
+
+    EXPECT_NEAR(meter.getRms(), 0.5f / std::sqrt(2.0f), 0.005f);
+    EXPECT_NEAR(meter.getPeak(), 0.5f, 0.001f);
+    EXPECT_EQ(meter.getSamplesMetered(), 48000u);
+}
+
+TEST(LevelMeterTest, PeakReleases) {
+    LevelMeter meter(48000.0f, 0.3f, 0.1f);
+    std::vector<float> impulse(64, 0.0f);
+    impulse[0] = 0.8f;
+    meter.process(impulse.data(), impulse.size());
+    EXPECT_FLOAT_EQ(meter.getPeak(), 0.8f);
+
+    // One second of silence is ten release time constants
+    std::vector<float> silence(48000, 0.0f);
+    meter.process(silence.data(), silence.size());
+    EXPECT_LT(meter.getPeak(), 0.8f * 1e-3f);
+}
+
+TEST(LevelMeterTest, TruePeakFindsInterSampleOver) {
+    // fs/4 at 45 degrees: every sample is +-0.707 but the waveform peaks at 1.0
+    LevelMeter meter(48000.0f);
+    auto sine = makeSine(12000.0f, 48000.0f, 4800, 1.0f, static_cast<float>(M_PI) / 4.0f);
+    meter.process(sine.data(), sine.size());
+
+    EXPECT_NEAR(meter.getPeak(), 0.7071f, 0.001f);
+    EXPECT_GT(meter.getTruePeak(), 0.95f);
+    EXPECT_LT(meter.getTruePeak(), 1.05f);
+}
+
+TEST(LevelMeterTest, TruePeakMatchesSamplePeakAtLowFrequency) {
+    LevelMeter meter(48000.0f);
+    auto sine = makeSine(100.0f, 48000.0f, 4800, 0.5f);
+    meter.process(sine.data(), sine.size());
+
+    EXPECT_NEAR(meter.getTruePeak(), meter.getPeak(), 0.01f);
+}
+
+TEST(LevelMeterTest, CountsClippedSamples) {
+    LevelMeter meter(48000.0f);
+    std::vector<float> samples = {0.5f, 1.0f, -1.0f, 0.99f, -1.2f, 0.0f};
+    meter.process(samples.data(), samples.size());
+    EXPECT_EQ(meter.getClipCount(), 3u);
+
+    meter.reset();
+    EXPECT_EQ(meter.getClipCount(), 0u);
+    EXPECT_FLOAT_EQ(meter.getRms(), 0.0f);
+}
+
+// ============================================================================
+// Ring Buffer Tests
+// ============================================================================
+
+TEST(LevelMeterTest, UpdateStartsAtNewestSample) {
+    RingBuffer<float> ring(48000);
+    std::vector<float> loud(4096, 1.0f);
+    ring.write(loud.data(), loud.size());
+
+    LevelMeter meter(48000.0f);
+    EXPECT_EQ(meter.update(ring), 0u);   // History before the first update is ignored
+    EXPECT_EQ(meter.getClipCount(), 0u);
+
+    std::vector<float> quiet(256, 0.25f);
+    ring.write(quiet.data(), quiet.size());
+    EXPECT_EQ(meter.update(ring), 256u);
+    EXPECT_NEAR(meter.getPeak(), 0.25f, 1e-6f);
+}
+
+TEST(LevelMeterTest, UpdateKeepsPartialBlockForLater) {
+    RingBuffer<float> ring(4096);
+    LevelMeter meter(48000.0f);
+    meter.update(ring);
+
+    std::vector<float> samples(100, 0.1f);
+    ring.write(samples.data(), samples.size());
+    EXPECT_EQ(meter.update(ring), LevelMeter::BLOCK_SIZE);
+
+    ring.write(samples.data(), 28);   // 36 + 28 = one more block
+    EXPECT_EQ(meter.update(ring), LevelMeter::BLOCK_SIZE);
+    EXPECT_EQ(meter.getSamplesMetered(), 2 * LevelMeter::BLOCK_SIZE);
+}
+
+TEST(LevelMeterTest, UpdateCapsBacklog) {
+    const float sample_rate = 8000.0f;
+    RingBuffer<float> ring(16384);
+    LevelMeter meter(sample_rate);
+    meter.update(ring);
+
+    // Two seconds arrive between updates; only the last half second is metered
+    std::vector<float> samples(16000, 0.1f);
+    ring.write(samples.data(), samples.size());
+    EXPECT_EQ(meter.update(ring), 4000u / LevelMeter::BLOCK_SIZE * LevelMeter::BLOCK_SIZE);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
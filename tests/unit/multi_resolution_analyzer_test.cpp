@@ -0,0 +1,205 @@
+/**
+ * @file multi_resolution_analyzer_test.cpp
+ * @brief Unit tests for MultiResolutionAnalyzer
+ *
+ * Tests cover:
+ * - Band layout: contiguous row ranges, largest FFT at the bottom
+ * - Crossover where base bins get narrower than the rows
+ * - Staggered schedule of the larger FFTs
+ * - Top rows identical to the single-FFT chain
+ * - Two close low tones resolved that the base FFT merges
+ */
+
+#include <gtest/gtest.h>
+#include <friture/multi_resolution_analyzer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 8000.0f;
+constexpr size_t BASE_FFT = 256;
+constexpr size_t MAX_FFT = 4096;
+constexpr size_t HEIGHT = 200;
+
+ChainKey logKey(size_t fft_size = BASE_FFT) {
+    ChainKey key;
+    key.fft_size = fft_size;
+    key.scale = FrequencyScale::Logarithmic;
+    key.min_freq = 40.0f;
+    key.max_freq = 4000.0f;
+    key.sample_rate = SAMPLE_RATE;
+    key.height = HEIGHT;
+    key.multi_resolution = true;
+    return key;
+}
+
+std::shared_ptr<FFTProcessor> baseFFT(size_t fft_size = BASE_FFT) {
+    return std::make_shared<FFTProcessor>(fft_size, WindowFunction::Hann);
+}
+
+std::vector<float> tones(size_t count, std::initializer_list<float> freqs) {
+    std::vector<float> samples(count, 0.0f);
+    for (float freq : freqs) {
+        for (size_t i = 0; i < count; ++i) {
+            samples[i] += std::sin(2.0f * 3.14159265f * freq * static_cast<float>(i) / SAMPLE_RATE);
+        }
+    }
+    return samples;
+}
+
+// Row whose centre frequency is closest to freq
+size_t rowFor(const ChainKey& key, float freq) {
+    FrequencyResampler resampler(key.scale, key.min_freq, key.max_freq, key.sample_rate,
+                                 key.fft_size, key.height);
+    const std::vector<float>& mapping = resampler.getFrequencyMapping();
+    const float bin = freq * static_cast<float>(key.fft_size) / key.sample_rate;
+    size_t best = 0;
+    for (size_t i = 1; i < mapping.size(); ++i) {
+        if (std::abs(mapping[i] - bin) < std::abs(mapping[best] - bin)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+// ============================================================================
+// Layout Tests
+// ============================================================================
+
+TEST(MultiResolutionAnalyzerTest, RejectsMismatchedFFT) {
+    EXPECT_THROW(MultiResolutionAnalyzer(logKey(), baseFFT(512), MAX_FFT), std::invalid_argument);
+    EXPECT_THROW(MultiResolutionAnalyzer(logKey(), nullptr, MAX_FFT), std::invalid_argument);
+}
+
+TEST(MultiResolutionAnalyzerTest, BandsCoverAllRowsLargestAtBottom) {
+    MultiResolutionAnalyzer analyzer(logKey(), baseFFT(), MAX_FFT);
+
+    ASSERT_EQ(analyzer.getBandCount(), 3u);
+    EXPECT_EQ(analyzer.getWindowSize(), MAX_FFT);
+
+    size_t next_row = HEIGHT;
+    for (size_t k = 0; k < analyzer.getBandCount(); ++k) {
+        const auto& band = analyzer.getBand(k);
+        EXPECT_EQ(band.fft_size, BASE_FFT << (2 * k));
+        EXPECT_EQ(band.period, size_t{1} << (2 * k));
+        EXPECT_GT(band.row_count, 0u);
+        // Smaller FFTs sit directly above larger ones
+        EXPECT_EQ(band.first_row + band.row_count, next_row);
+        next_row = band.first_row;
+    }
+    EXPECT_EQ(next_row, 0u);
+}
+
+TEST(MultiResolutionAnalyzerTest, CrossoverWhereRowsNarrowerThanBins) {
+    ChainKey key = logKey();
+    MultiResolutionAnalyzer analyzer(key, baseFFT(), MAX_FFT);
+    FrequencyResampler base(key.scale, key.min_freq, key.max_freq, key.sample_rate,
+                            key.fft_size, key.height);
+    const std::vector<float>& mapping = base.getFrequencyMapping();
+
+    // Base band rows are at least one base bin apart, the row below is not
+    const size_t crossover = analyzer.getBand(0).first_row;
+    ASSERT_GT(crossover, 0u);
+    EXPECT_GE(mapping[crossover + 1] - mapping[crossover], 1.0f);
+    EXPECT_LT(mapping[crossover] - mapping[crossover - 1], 1.0f);
+}
+
+TEST(MultiResolutionAnalyzerTest, LimitedByMaxFFTSize) {
+    MultiResolutionAnalyzer analyzer(logKey(), baseFFT(), 1024);
+    EXPECT_EQ(analyzer.getBandCount(), 2u);
+    EXPECT_EQ(analyzer.getWindowSize(), 1024u);
+
+    MultiResolutionAnalyzer single(logKey(), baseFFT(), BASE_FFT);
+    EXPECT_EQ(single.getBandCount(), 1u);
+    EXPECT_EQ(single.getBand(0).row_count, HEIGHT);
+}
+
+// ============================================================================
+// Scheduling Tests
+// ============================================================================
+
+TEST(MultiResolutionAnalyzerTest, LargeFFTsStaggered) {
+    MultiResolutionAnalyzer analyzer(logKey(), baseFFT(), MAX_FFT);
+    std::vector<float> window(analyzer.getWindowSize(), 0.0f);
+    std::vector<float> column(HEIGHT);
+
+    // First column fills every band
+    EXPECT_EQ(analyzer.analyze(window.data()), 3u);
+    analyzer.stitch(column.data());
+
+    size_t transforms = 0;
+    for (size_t c = 1; c <= 64; ++c) {
+        size_t count = analyzer.analyze(window.data());
+        analyzer.stitch(column.data());
+        EXPECT_LE(count, 2u) << "column " << c;   // Base plus at most one large FFT
+        transforms += count;
+    }
+    // 64 base + 16 of the 4× band + 4 of the 16× band
+    EXPECT_EQ(transforms, 64u + 16u + 4u);
+
+    analyzer.reset();
+    EXPECT_EQ(analyzer.analyze(window.data()), 3u);
+}
+
+// ============================================================================
+// Output Tests
+// ============================================================================
+
+TEST(MultiResolutionAnalyzerTest, TopRowsMatchSingleFFT) {
+    ChainKey key = logKey();
+    MultiResolutionAnalyzer analyzer(key, baseFFT(), MAX_FFT);
+    std::vector<float> window = tones(analyzer.getWindowSize(), {1000.0f, 2500.0f});
+    std::vector<float> column(HEIGHT);
+    analyzer.analyze(window.data());
+    analyzer.stitch(column.data());
+
+    // Same centred frame through a plain FFT + resampler
+    FFTProcessor fft(BASE_FFT, WindowFunction::Hann);
+    FrequencyResampler resampler(key.scale, key.min_freq, key.max_freq, key.sample_rate,
+                                 key.fft_size, key.height, key.aggregation);
+    std::vector<float> spectrum(fft.getNumBins());
+    std::vector<float> expected(HEIGHT);
+    fft.process(window.data() + (MAX_FFT - BASE_FFT) / 2, spectrum.data());
+    resampler.resample(spectrum.data(), expected.data());
+
+    const auto& top = analyzer.getBand(0);
+    for (size_t i = top.first_row; i < HEIGHT; ++i) {
+        EXPECT_FLOAT_EQ(column[i], expected[i]) << "row " << i;
+    }
+}
+
+TEST(MultiResolutionAnalyzerTest, ResolvesCloseLowTones) {
+    // 100 and 130 Hz: one bin apart at 256 points, 16 bins at 4096
+    ChainKey key = logKey();
+    MultiResolutionAnalyzer analyzer(key, baseFFT(), MAX_FFT);
+    std::vector<float> window = tones(analyzer.getWindowSize(), {100.0f, 130.0f});
+    std::vector<float> column(HEIGHT);
+    analyzer.analyze(window.data());
+    analyzer.stitch(column.data());
+
+    FFTProcessor fft(BASE_FFT, WindowFunction::Hann);
+    FrequencyResampler resampler(key.scale, key.min_freq, key.max_freq, key.sample_rate,
+                                 key.fft_size, key.height, key.aggregation);
+    std::vector<float> spectrum(fft.getNumBins());
+    std::vector<float> single(HEIGHT);
+    fft.process(window.data() + (MAX_FFT - BASE_FFT) / 2, spectrum.data());
+    resampler.resample(spectrum.data(), single.data());
+
+    const size_t low = rowFor(key, 100.0f);
+    const size_t mid = rowFor(key, 114.0f);
+    const size_t high = rowFor(key, 130.0f);
+    ASSERT_LT(high, analyzer.getBand(0).first_row);
+
+    auto dip = [&](const std::vector<float>& c) {
+        return std::min(c[low], c[high]) - c[mid];
+    };
+    EXPECT_GT(dip(column), 10.0f);
+    EXPECT_LT(dip(single), 3.0f);
+}
@@ -0,0 +1,221 @@
+/**
+ * @file multichannel_analyzer_test.cpp
+ * @brief Unit tests for MultiChannelAnalyzer
+ *
+ * Tests cover:
+ * - Construction and parameter validation
+ * - Per-channel results match a single ProcessingChain
+ * - Stacked and overlay column layouts
+ * - Repeated fork-join rounds
+ * - Throughput scaling with thread count
+ */
+
+#define _USE_MATH_DEFINES  // For M_PI on Windows/MSVC
+#include <gtest/gtest.h>
+#include <friture/multichannel_analyzer.hpp>
+#include <span>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <stdexcept>
+
+using namespace friture;
+
+namespace {
+
+ChainKey makeKey(size_t fft_size = 1024) {
+    ChainKey key;
+    key.fft_size = fft_size;
+    key.scale = FrequencyScale::Linear;
+    key.min_freq = 20.0f;
+    key.max_freq = 24000.0f;
+    key.sample_rate = 48000.0f;
+    return key;
+}
+
+void fillSine(std::span<float> buffer, float frequency, float sample_rate) {
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = std::sin(2.0f * static_cast<float>(M_PI) * frequency * i / sample_rate);
+    }
+}
+
+// Row with the largest value in [begin, end)
+size_t loudestRow(std::span<const float> column, size_t begin, size_t end) {
+    size_t best = begin;
+    for (size_t row = begin; row < end; ++row) {
+        if (column[row] > column[best]) {
+            best = row;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+// ============================================================================
+// Construction Tests
+// ============================================================================
+
+TEST(MultiChannelAnalyzerTest, Construction) {
+    MultiChannelAnalyzer analyzer(makeKey(), 4, ChannelLayout::Stacked, 402, 2);
+    EXPECT_EQ(analyzer.getChannelCount(), 4u);
+    EXPECT_EQ(analyzer.getThreadCount(), 2u);
+    EXPECT_EQ(analyzer.getLaneHeight(), 100u);
+    EXPECT_EQ(analyzer.chain(3).resampled.size(), 100u);
+    EXPECT_EQ(analyzer.getHopSize(), analyzer.chain(0).getHopSize());
+}
+
+TEST(MultiChannelAnalyzerTest, ThreadsCappedAtChannels) {
+    MultiChannelAnalyzer analyzer(makeKey(), 2, ChannelLayout::Overlay, 64, 16);
+    EXPECT_EQ(analyzer.getThreadCount(), 2u);
+    EXPECT_EQ(analyzer.getLaneHeight(), 64u);
+}
+
+TEST(MultiChannelAnalyzerTest, InvalidParameters) {
+    EXPECT_THROW(MultiChannelAnalyzer(makeKey(), 0, ChannelLayout::Stacked, 100),
+                 std::invalid_argument);
+    EXPECT_THROW(MultiChannelAnalyzer(makeKey(), 8, ChannelLayout::Stacked, 4),
+                 std::invalid_argument);
+}
+
+// ============================================================================
+// Processing Tests
+// ============================================================================
+
+TEST(MultiChannelAnalyzerTest, MatchesSingleChain) {
+    const size_t channels = 3;
+    ChainKey key = makeKey();
+    MultiChannelAnalyzer analyzer(key, channels, ChannelLayout::Overlay, 128, 3);
+
+    key.height = 128;
+    ProcessingChain reference(key, std::make_shared<FFTProcessor>(key.fft_size, key.window));
+
+    for (size_t c = 0; c < channels; ++c) {
+        fillSine(analyzer.chain(c).fft_input, 1000.0f * (c + 1), 48000.0f);
+    }
+    analyzer.process();
+
+    for (size_t c = 0; c < channels; ++c) {
+        fillSine(reference.fft_input, 1000.0f * (c + 1), 48000.0f);
+        reference.fft().process(reference.fft_input.data(), reference.fft_output.data());
+        reference.resampler().resample(reference.fft_output.data(), reference.resampled.data());
+
+        for (size_t row = 0; row < 128; ++row) {
+            ASSERT_FLOAT_EQ(analyzer.chain(c).resampled[row], reference.resampled[row])
+                << "channel " << c << " row " << row;
+        }
+    }
+}
+
+TEST(MultiChannelAnalyzerTest, StackedLanesTopDown) {
+    const size_t channels = 4;
+    const size_t height = 203;   // 3 leftover rows at the bottom
+    MultiChannelAnalyzer analyzer(makeKey(), channels, ChannelLayout::Stacked, height, 2);
+    const size_t lane = analyzer.getLaneHeight();
+
+    // Same tone everywhere, so each lane peaks at the same relative row
+    for (size_t c = 0; c < channels; ++c) {
+        fillSine(analyzer.chain(c).fft_input, 6000.0f, 48000.0f);
+    }
+    analyzer.process();
+
+    std::vector<float> column(height);
+    analyzer.combine(column.data());
+
+    const size_t leftover = height - channels * lane;
+    for (size_t row = 0; row < leftover; ++row) {
+        EXPECT_FLOAT_EQ(column[row], -200.0f);
+    }
+
+    const size_t peak = loudestRow(analyzer.chain(0).resampled, 0, lane);
+    for (size_t c = 0; c < channels; ++c) {
+        size_t lane_start = height - (c + 1) * lane;
+        EXPECT_EQ(loudestRow(column, lane_start, lane_start + lane), lane_start + peak)
+            << "channel " << c;
+        EXPECT_FLOAT_EQ(column[lane_start], analyzer.chain(c).resampled[0]);
+    }
+}
+
+TEST(MultiChannelAnalyzerTest, OverlayTakesLoudestChannel) {
+    MultiChannelAnalyzer analyzer(makeKey(), 2, ChannelLayout::Overlay, 96, 2);
+    fillSine(analyzer.chain(0).fft_input, 2000.0f, 48000.0f);
+    fillSine(analyzer.chain(1).fft_input, 12000.0f, 48000.0f);
+    analyzer.process();
+
+    std::vector<float> column(96);
+    analyzer.combine(column.data());
+
+    for (size_t row = 0; row < 96; ++row) {
+        EXPECT_FLOAT_EQ(column[row], std::max(analyzer.chain(0).resampled[row],
+                                              analyzer.chain(1).resampled[row]));
+    }
+    // Both tones are visible
+    EXPECT_NEAR(column[loudestRow(analyzer.chain(0).resampled, 0, 96)],
+                analyzer.chain(0).resampled[loudestRow(analyzer.chain(0).resampled, 0, 96)], 1e-6f);
+    EXPECT_NEAR(column[loudestRow(analyzer.chain(1).resampled, 0, 96)],
+                analyzer.chain(1).resampled[loudestRow(analyzer.chain(1).resampled, 0, 96)], 1e-6f);
+}
+
+TEST(MultiChannelAnalyzerTest, RepeatedRounds) {
+    // Many fork-join rounds; every channel is processed every round
+    MultiChannelAnalyzer analyzer(makeKey(256), 8, ChannelLayout::Stacked, 64, 4);
+    for (int round = 0; round < 500; ++round) {
+        for (size_t c = 0; c < 8; ++c) {
+            std::fill(analyzer.chain(c).fft_input.begin(), analyzer.chain(c).fft_input.end(),
+                      (round % 2 == 0) ? 0.0f : 0.5f);
+        }
+        analyzer.process();
+        for (size_t c = 0; c < 8; ++c) {
+            // DC row is loud on odd rounds, silent on even ones
+            bool loud = analyzer.chain(c).resampled[0] > -100.0f;
+            ASSERT_EQ(loud, round % 2 == 1) << "round " << round << " channel " << c;
+        }
+    }
+}
+
+// ============================================================================
+// Performance Tests
+// ============================================================================
+
+TEST(MultiChannelAnalyzerTest, PerformanceScalesWithThreads) {
+    const size_t channels = 8;
+    const int rounds = 200;
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+
+    auto run = [&](size_t threads) {
+        MultiChannelAnalyzer analyzer(makeKey(8192), channels, ChannelLayout::Stacked, 432, threads);
+        for (size_t c = 0; c < channels; ++c) {
+            fillSine(analyzer.chain(c).fft_input, 440.0f * (c + 1), 48000.0f);
+        }
+        analyzer.process();  // Warm-up
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < rounds; ++i) {
+            analyzer.process();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / rounds;
+    };
+
+    double serial_us = run(1);
+    double parallel_us = run(0);
+
+    std::cout << channels << " channels x 8192-point FFT: 1 thread " << serial_us
+              << " us, " << std::min<size_t>(cores, channels) << " threads " << parallel_us
+              << " us (" << serial_us / parallel_us << "x)" << std::endl;
+
+    if (cores >= 4) {
+        EXPECT_LT(parallel_us, serial_us * 0.75);
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,332 @@
+/**
+ * @file offline_renderer_test.cpp
+ * @brief Unit tests for OfflineRenderer
+ *
+ * Tests cover:
+ * - Option validation
+ * - Hop selection with and without a width limit
+ * - Multi-threaded rendering produces the same image as one thread
+ * - Tone lands in the expected rows
+ * - Reused pool and stages give the same images as fresh renderers
+ * - Spectrum summary: peaks and octave band levels
+ * - WAV file → BMP file round trip
+ * - The direct BMP of renderFile() matches SpectrogramImage::saveToBMP()
+ */
+
+#include <gtest/gtest.h>
+#include <friture/offline_renderer.hpp>
+#include <friture/audio/wav_reader.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+
+std::vector<float> sine(float frequency, size_t count) {
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * frequency * i / SAMPLE_RATE);
+    }
+    return samples;
+}
+
+OfflineRenderer::Source vectorSource(const std::vector<float>& samples) {
+    return [&samples](uint64_t position, float* output, size_t count) {
+        size_t n = position < samples.size()
+                       ? std::min<size_t>(count, samples.size() - position) : 0;
+        std::copy(samples.begin() + position, samples.begin() + position + n, output);
+        return n;
+    };
+}
+
+OfflineRenderOptions smallOptions() {
+    OfflineRenderOptions options;
+    options.fft_size = 256;
+    options.height = 64;
+    options.scale = FrequencyScale::Linear;
+    options.min_freq = 100.0f;
+    options.threads = 1;
+    return options;
+}
+
+/**
+ * @brief Write a mono 16-bit PCM WAV file
+ */
+void writeWav(const std::string& path, const std::vector<float>& samples) {
+    auto u32 = [](std::ofstream& f, uint32_t v) { f.write(reinterpret_cast<const char*>(&v), 4); };
+    auto u16 = [](std::ofstream& f, uint16_t v) { f.write(reinterpret_cast<const char*>(&v), 2); };
+
+    std::ofstream f(path, std::ios::binary);
+    uint32_t data_bytes = static_cast<uint32_t>(samples.size() * 2);
+    f.write("RIFF", 4);
+    u32(f, 36 + data_bytes);
+    f.write("WAVEfmt ", 8);
+    u32(f, 16);
+    u16(f, 1);                                  // PCM
+    u16(f, 1);                                  // Mono
+    u32(f, static_cast<uint32_t>(SAMPLE_RATE));
+    u32(f, static_cast<uint32_t>(SAMPLE_RATE) * 2);
+    u16(f, 2);
+    u16(f, 16);
+    f.write("data", 4);
+    u32(f, data_bytes);
+    for (float s : samples) {
+        u16(f, static_cast<uint16_t>(static_cast<int16_t>(s * 32767.0f)));
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Configuration Tests
+// ============================================================================
+
+TEST(OfflineRendererTest, RejectsInvalidOptions) {
+    OfflineRenderOptions options = smallOptions();
+    options.fft_size = 1000;
+    EXPECT_THROW(OfflineRenderer{options}, std::invalid_argument);
+
+    options = smallOptions();
+    options.height = 0;
+    EXPECT_THROW(OfflineRenderer{options}, std::invalid_argument);
+
+    options = smallOptions();
+    options.min_db = 0.0f;
+    options.max_db = -10.0f;
+    EXPECT_THROW(OfflineRenderer{options}, std::invalid_argument);
+
+    options = smallOptions();
+    options.overlap_percent = 100.0f;
+    EXPECT_THROW(OfflineRenderer{options}, std::invalid_argument);
+
+    EXPECT_NO_THROW(OfflineRenderer{smallOptions()});
+}
+
+TEST(OfflineRendererTest, HopSizeRespectsMaxWidth) {
+    OfflineRenderOptions options = smallOptions();
+    OfflineRenderer unlimited(options);
+    EXPECT_EQ(unlimited.hopSizeFor(100000), 64u);  // 75% overlap
+
+    options.max_width = 100;
+    OfflineRenderer limited(options);
+    size_t hop = limited.hopSizeFor(100000);
+    EXPECT_LE((100000 - 256) / hop + 1, 100u);
+    EXPECT_GT((100000 - 256) / (hop - 1) + 1, 100u);  // Smallest hop that fits
+
+    // Short inputs keep the default hop
+    EXPECT_EQ(limited.hopSizeFor(2000), 64u);
+
+    options.max_width = 0;
+    options.overlap_percent = 93.75f;
+    EXPECT_EQ(OfflineRenderer(options).hopSizeFor(100000), 16u);
+}
+
+TEST(OfflineRendererTest, InputShorterThanFrameThrows) {
+    OfflineRenderer renderer(smallOptions());
+    std::vector<float> samples(100, 0.0f);
+    EXPECT_THROW(renderer.render(vectorSource(samples), samples.size(), SAMPLE_RATE),
+                 std::invalid_argument);
+}
+
+// ============================================================================
+// Rendering Tests
+// ============================================================================
+
+TEST(OfflineRendererTest, OneColumnPerFrame) {
+    OfflineRenderer renderer(smallOptions());
+    std::vector<float> samples = sine(1000.0f, 48000);
+
+    OfflineRenderStats stats;
+    auto image = renderer.render(vectorSource(samples), samples.size(), SAMPLE_RATE, &stats);
+
+    const uint64_t expected = (48000 - 256) / 64 + 1;
+    EXPECT_EQ(stats.columns, expected);
+    EXPECT_EQ(stats.hop_size, 64u);
+    EXPECT_EQ(image->getWidth(), expected);
+    EXPECT_EQ(image->getHeight(), 64u);
+    EXPECT_EQ(image->getReadOffset(), 0u);
+    EXPECT_GT(stats.getColumnsPerSecond(), 0.0);
+}
+
+TEST(OfflineRendererTest, SegmentThreadsMatchSingleThread) {
+    std::vector<float> samples = sine(3000.0f, 40000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        // Changing content so misplaced segments would show
+        samples[i] *= static_cast<float>(i) / samples.size();
+    }
+
+    OfflineRenderOptions options = smallOptions();
+    auto single = OfflineRenderer(options).render(vectorSource(samples), samples.size(), SAMPLE_RATE);
+
+    options.threads = 4;
+    OfflineRenderStats stats;
+    auto threaded = OfflineRenderer(options).render(vectorSource(samples), samples.size(),
+                                                    SAMPLE_RATE, &stats);
+    EXPECT_EQ(stats.threads, 4u);
+
+    ASSERT_EQ(single->getWidth(), threaded->getWidth());
+    const uint32_t* a = single->getVisibleData();
+    const uint32_t* b = threaded->getVisibleData();
+    for (size_t i = 0; i < single->getWidth() * single->getHeight(); ++i) {
+        ASSERT_EQ(a[i], b[i]) << "pixel " << i;
+    }
+}
+
+TEST(OfflineRendererTest, WideHopSkipsGapsAndKeepsTone) {
+    OfflineRenderOptions options = smallOptions();
+    options.max_width = 20;
+    options.threads = 2;
+    OfflineRenderer renderer(options);
+
+    std::vector<float> samples = sine(12000.0f, 96000);
+    OfflineRenderStats stats;
+    auto image = renderer.render(vectorSource(samples), samples.size(), SAMPLE_RATE, &stats);
+    EXPECT_LE(image->getWidth(), 20u);
+    EXPECT_GT(stats.hop_size, options.fft_size);
+
+    // Every column is brightest near the 12 kHz row of the linear scale
+    const float row_hz = (SAMPLE_RATE / 2.0f - options.min_freq) / (options.height - 1);
+    const size_t tone_row = static_cast<size_t>((12000.0f - options.min_freq) / row_hz + 0.5f);
+    for (size_t c = 0; c < image->getWidth(); ++c) {
+        const uint32_t* column = image->getVisibleData() + c * image->getHeight();
+        size_t brightest = 0;
+        for (size_t r = 1; r < image->getHeight(); ++r) {
+            if (ColorTransform::getLuminance(column[r]) > ColorTransform::getLuminance(column[brightest])) {
+                brightest = r;
+            }
+        }
+        EXPECT_NEAR(static_cast<double>(brightest), static_cast<double>(tone_row), 2.0) << "column " << c;
+    }
+}
+
+TEST(OfflineRendererTest, ReusedRendererMatchesFreshOnes) {
+    std::vector<float> samples = sine(2000.0f, 30000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] *= static_cast<float>(i) / samples.size();
+    }
+
+    // Stages are rebuilt when the rate changes and kept when it returns
+    OfflineRenderOptions options = smallOptions();
+    options.threads = 3;
+    OfflineRenderer reused(options);
+    for (float rate : {SAMPLE_RATE, SAMPLE_RATE / 2.0f, SAMPLE_RATE}) {
+        auto expected = OfflineRenderer(options).render(vectorSource(samples), samples.size(), rate);
+        auto image = reused.render(vectorSource(samples), samples.size(), rate);
+        ASSERT_EQ(image->getWidth(), expected->getWidth());
+        const uint32_t* a = expected->getVisibleData();
+        const uint32_t* b = image->getVisibleData();
+        for (size_t i = 0; i < image->getWidth() * image->getHeight(); ++i) {
+            ASSERT_EQ(a[i], b[i]) << "rate " << rate << " pixel " << i;
+        }
+    }
+}
+
+TEST(OfflineRendererTest, SummaryFindsPeaksAndBandLevels) {
+    std::vector<float> samples = sine(1000.0f, 48000);
+    const std::vector<float> weak = sine(3000.0f, 48000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] += 0.1f * weak[i];   // 20 dB below the 1 kHz tone
+    }
+
+    OfflineRenderOptions options = smallOptions();
+    options.fft_size = 1024;
+    options.threads = 2;
+    OfflineRenderer renderer(options);
+    OfflineRenderSummary summary;
+    renderer.render(vectorSource(samples), samples.size(), SAMPLE_RATE, nullptr, &summary);
+
+    // Strongest peaks first, interpolated to within a fraction of a bin (46.9 Hz)
+    ASSERT_GE(summary.peaks.size(), 2u);
+    EXPECT_NEAR(summary.peaks[0].frequency, 1000.0f, 5.0f);
+    EXPECT_NEAR(summary.peaks[1].frequency, 3000.0f, 5.0f);
+    EXPECT_NEAR(summary.peaks[0].level_db - summary.peaks[1].level_db, 20.0f, 1.0f);
+    // Interpolation recovers the level between bins (Hann scalloping <= 1.42 dB)
+    EXPECT_LE(summary.max_db, summary.peaks[0].level_db + 0.01f);
+    EXPECT_GE(summary.max_db, summary.peaks[0].level_db - 1.5f);
+
+    // All ten octave bands fit below 24 kHz; the 1 kHz one holds the tone
+    ASSERT_EQ(summary.band_centers.size(), OfflineRenderSummary::MAX_BANDS);
+    ASSERT_EQ(summary.band_db.size(), OfflineRenderSummary::MAX_BANDS);
+    EXPECT_FLOAT_EQ(summary.band_centers[5], 1000.0f);
+    for (size_t k = 0; k < summary.band_db.size(); ++k) {
+        if (k != 5) {
+            EXPECT_LT(summary.band_db[k], summary.band_db[5]) << "band " << k;
+        }
+    }
+    EXPECT_NEAR(summary.band_db[5], summary.mean_db, 0.1f);
+    EXPECT_NEAR(summary.band_db[7] - summary.band_db[5], -20.0f, 1.0f);   // 3 kHz in the 4 kHz band
+
+    // The summary covers the whole spectrum, not just the displayed rows
+    options.min_freq = 2000.0f;
+    options.max_freq = 4000.0f;
+    OfflineRenderer narrow(options);
+    OfflineRenderSummary narrow_summary;
+    narrow.render(vectorSource(samples), samples.size(), SAMPLE_RATE, nullptr, &narrow_summary);
+    ASSERT_FALSE(narrow_summary.peaks.empty());
+    EXPECT_NEAR(narrow_summary.peaks[0].frequency, 1000.0f, 5.0f);
+}
+
+TEST(OfflineRendererTest, RenderFileWritesBitmap) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string wav = (dir / "offline_renderer_test.wav").string();
+    std::string bmp = (dir / "offline_renderer_test.bmp").string();
+    writeWav(wav, sine(1000.0f, 24000));
+
+    OfflineRenderer renderer(smallOptions());
+    OfflineRenderStats stats;
+    ASSERT_TRUE(renderer.renderFile(wav.c_str(), bmp.c_str(), &stats)) << renderer.getError();
+
+    const uint64_t expected_bytes = 54 + stats.columns * 64 * 4;
+    EXPECT_EQ(std::filesystem::file_size(bmp), expected_bytes);
+
+    EXPECT_FALSE(renderer.renderFile((dir / "does_not_exist.wav").string().c_str(), bmp.c_str()));
+    EXPECT_FALSE(renderer.getError().empty());
+
+    std::remove(wav.c_str());
+    std::remove(bmp.c_str());
+}
+
+TEST(OfflineRendererTest, RenderFileMatchesImageBitmap) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string wav = (dir / "offline_renderer_match.wav").string();
+    std::string direct = (dir / "offline_renderer_direct.bmp").string();
+    std::string through_image = (dir / "offline_renderer_image.bmp").string();
+    std::vector<float> samples = sine(5000.0f, 24000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        // Changing content so transposed columns would show
+        samples[i] *= static_cast<float>(i) / samples.size();
+    }
+    writeWav(wav, samples);
+
+    OfflineRenderer renderer(smallOptions());
+    ASSERT_TRUE(renderer.renderFile(wav.c_str(), direct.c_str())) << renderer.getError();
+
+    // The same samples renderFile() decoded, through a SpectrogramImage
+    WavReader reader;
+    ASSERT_TRUE(reader.open(wav.c_str()));
+    auto image = renderer.render([&reader](uint64_t position, float* output, size_t count) {
+        return reader.readMono(position, output, count);
+    }, reader.getFrameCount(), reader.getSampleRate());
+    ASSERT_TRUE(image->saveToBMP(through_image.c_str()));
+
+    auto readAll = [](const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+    };
+    EXPECT_EQ(readAll(direct), readAll(through_image));
+    EXPECT_EQ(renderer.imageBytesFor(samples.size()), image->getWidth() * image->getHeight() * 4);
+
+    std::remove(wav.c_str());
+    std::remove(direct.c_str());
+    std::remove(through_image.c_str());
+}
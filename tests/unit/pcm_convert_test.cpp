@@ -0,0 +1,198 @@
+/**
+ * @file pcm_convert_test.cpp
+ * @brief Unit tests for PCM sample decoding
+ *
+ * Tests cover:
+ * - Every encoding against a byte-wise reference decoder
+ * - Tails and unaligned sources (vector loops stop at any length/offset)
+ * - Full-scale and sign boundary values
+ * - Fused mono downmix for stereo and wider layouts
+ */
+
+#include <gtest/gtest.h>
+#include <friture/audio/pcm_convert.hpp>
+#include <friture/simd_kernels.hpp>
+#include <vector>
+#include <cstring>
+#include <random>
+#include <iostream>
+
+using namespace friture;
+using pcm::SampleFormat;
+
+namespace {
+
+const SampleFormat ALL_FORMATS[] = {
+    SampleFormat::Int16, SampleFormat::Int24, SampleFormat::Int32, SampleFormat::Float32
+};
+
+/**
+ * @brief Straightforward reference decoder for one sample
+ */
+float referenceSample(SampleFormat format, const uint8_t* p) {
+    switch (format) {
+        case SampleFormat::Int16: {
+            int32_t v = p[0] | (p[1] << 8);
+            if (v & 0x8000) v -= 0x10000;
+            return v / 32768.0f;
+        }
+        case SampleFormat::Int24: {
+            int32_t v = p[0] | (p[1] << 8) | (p[2] << 16);
+            if (v & 0x800000) v -= 0x1000000;
+            return v / 8388608.0f;
+        }
+        case SampleFormat::Int32: {
+            int64_t v = static_cast<int64_t>(p[0]) | (static_cast<int64_t>(p[1]) << 8) |
+                        (static_cast<int64_t>(p[2]) << 16) | (static_cast<int64_t>(p[3]) << 24);
+            if (v & 0x80000000LL) v -= 0x100000000LL;
+            return static_cast<float>(v) / 2147483648.0f;
+        }
+        case SampleFormat::Float32: {
+            float v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+    }
+    return 0.0f;
+}
+
+/**
+ * @brief Random encoded bytes; float samples are kept finite
+ */
+std::vector<uint8_t> randomBytes(SampleFormat format, size_t samples, uint32_t seed) {
+    std::mt19937 rng(seed);
+    const size_t bytes = pcm::bytesPerSample(format);
+    std::vector<uint8_t> data(samples * bytes);
+
+    if (format == SampleFormat::Float32) {
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        for (size_t i = 0; i < samples; ++i) {
+            float v = dist(rng);
+            std::memcpy(data.data() + i * 4, &v, 4);
+        }
+    } else {
+        for (auto& b : data) {
+            b = static_cast<uint8_t>(rng());
+        }
+    }
+    return data;
+}
+
+} // namespace
+
+// ============================================================================
+// Conversion Tests
+// ============================================================================
+
+TEST(PcmConvertTest, BytesPerSample) {
+    EXPECT_EQ(pcm::bytesPerSample(SampleFormat::Int16), 2u);
+    EXPECT_EQ(pcm::bytesPerSample(SampleFormat::Int24), 3u);
+    EXPECT_EQ(pcm::bytesPerSample(SampleFormat::Int32), 4u);
+    EXPECT_EQ(pcm::bytesPerSample(SampleFormat::Float32), 4u);
+}
+
+TEST(PcmConvertTest, MatchesReferenceAtEveryLengthAndOffset) {
+    std::cout << "PCM converters use: " << simd::toString(simd::activeIsa()) << std::endl;
+
+    for (SampleFormat format : ALL_FORMATS) {
+        const size_t bytes = pcm::bytesPerSample(format);
+        // Extra leading bytes let the source start at any alignment
+        std::vector<uint8_t> data = randomBytes(format, 80, 7);
+        data.insert(data.begin(), 3, 0xA5);
+
+        for (size_t offset = 0; offset < 4; ++offset) {
+            for (size_t count = 0; count <= 77; ++count) {
+                const uint8_t* src = data.data() + offset;
+                std::vector<float> out(count + 1, -99.0f);
+                pcm::toFloat(format, src, out.data(), count);
+
+                for (size_t i = 0; i < count; ++i) {
+                    ASSERT_EQ(out[i], referenceSample(format, src + i * bytes))
+                        << "format " << static_cast<int>(format) << " offset " << offset
+                        << " count " << count << " sample " << i;
+                }
+                ASSERT_EQ(out[count], -99.0f) << "wrote past the end";
+            }
+        }
+    }
+}
+
+TEST(PcmConvertTest, FullScaleAndSignBoundaries) {
+    const uint8_t int16_bytes[] = {0xFF, 0x7F, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0x00};
+    float out16[4];
+    pcm::int16ToFloat(int16_bytes, out16, 4);
+    EXPECT_FLOAT_EQ(out16[0], 32767.0f / 32768.0f);
+    EXPECT_FLOAT_EQ(out16[1], -1.0f);
+    EXPECT_FLOAT_EQ(out16[2], -1.0f / 32768.0f);
+    EXPECT_FLOAT_EQ(out16[3], 1.0f / 32768.0f);
+
+    // Repeat the 24-bit pattern past one vector so the shuffle path sees it
+    const uint8_t pattern[] = {0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x00};
+    std::vector<uint8_t> int24_bytes;
+    for (int r = 0; r < 8; ++r) {
+        int24_bytes.insert(int24_bytes.end(), pattern, pattern + sizeof(pattern));
+    }
+    std::vector<float> out24(32);
+    pcm::int24ToFloat(int24_bytes.data(), out24.data(), 32);
+    for (size_t i = 0; i < 32; i += 4) {
+        EXPECT_FLOAT_EQ(out24[i], 8388607.0f / 8388608.0f);
+        EXPECT_FLOAT_EQ(out24[i + 1], -1.0f);
+        EXPECT_FLOAT_EQ(out24[i + 2], -1.0f / 8388608.0f);
+        EXPECT_FLOAT_EQ(out24[i + 3], 1.0f / 8388608.0f);
+    }
+
+    const uint8_t int32_bytes[] = {0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x40};
+    float out32[2];
+    pcm::int32ToFloat(int32_bytes, out32, 2);
+    EXPECT_FLOAT_EQ(out32[0], -1.0f);
+    EXPECT_FLOAT_EQ(out32[1], 0.5f);
+}
+
+// ============================================================================
+// Fused Downmix Tests
+// ============================================================================
+
+TEST(PcmConvertTest, MonoDownmixMatchesSeparatePasses) {
+    for (SampleFormat format : ALL_FORMATS) {
+        const size_t bytes = pcm::bytesPerSample(format);
+
+        for (size_t channels : {1u, 2u, 3u, 6u}) {
+            for (size_t frames : {0u, 1u, 7u, 8u, 9u, 31u, 1000u}) {
+                std::vector<uint8_t> data = randomBytes(format, frames * channels, 11);
+                std::vector<float> mono(frames + 1, -99.0f);
+                pcm::toFloatMono(format, data.data(), mono.data(), frames, channels);
+
+                for (size_t i = 0; i < frames; ++i) {
+                    float sum = 0.0f;
+                    for (size_t c = 0; c < channels; ++c) {
+                        sum += referenceSample(format, data.data() + (i * channels + c) * bytes);
+                    }
+                    ASSERT_EQ(mono[i], sum * (1.0f / channels))
+                        << "format " << static_cast<int>(format) << " channels " << channels
+                        << " frames " << frames << " frame " << i;
+                }
+                ASSERT_EQ(mono[frames], -99.0f) << "wrote past the end";
+            }
+        }
+    }
+}
+
+TEST(PcmConvertTest, WideLayoutsSpanSeveralScratchChunks) {
+    // 32 channels × 500 frames is several 4096-sample chunks
+    constexpr size_t channels = 32;
+    constexpr size_t frames = 500;
+    std::vector<int16_t> samples(frames * channels);
+    for (size_t i = 0; i < frames; ++i) {
+        for (size_t c = 0; c < channels; ++c) {
+            samples[i * channels + c] = static_cast<int16_t>(c == 5 ? i * 32 : 0);
+        }
+    }
+
+    std::vector<float> mono(frames);
+    pcm::toFloatMono(SampleFormat::Int16, reinterpret_cast<const uint8_t*>(samples.data()),
+                     mono.data(), frames, channels);
+
+    for (size_t i = 0; i < frames; ++i) {
+        ASSERT_FLOAT_EQ(mono[i], (i * 32 / 32768.0f) / channels) << "frame " << i;
+    }
+}
@@ -0,0 +1,325 @@
+/**
+ * @file peak_detector_test.cpp
+ * @brief Unit tests for PeakDetector
+ *
+ * Tests cover:
+ * - Argument validation
+ * - No events on noise, onset/offset of a tone with interpolated frequency
+ * - Hysteresis, hold time, sidelobe masking, median priming
+ * - Queue overflow, finish(), bin ranges of a real FFT
+ * - Cost per hop against the FFT at 4096 points
+ */
+
+#define _USE_MATH_DEFINES  // For M_PI on Windows/MSVC
+#include <gtest/gtest.h>
+#include <friture/peak_detector.hpp>
+#include <friture/fft_processor.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr size_t FFT_SIZE = 4096;
+constexpr size_t NUM_BINS = FFT_SIZE / 2 + 1;
+constexpr size_t HOP = 1024;
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr float BIN_HZ = SAMPLE_RATE / FFT_SIZE;
+constexpr float NOISE_DB = -80.0f;
+
+// dB spectra of white noise (exponentially distributed bin power) around
+// NOISE_DB, with optional tones drawn as parabolas over five bins
+class Spectra {
+public:
+    explicit Spectra(unsigned seed = 1) : rng_(seed), power_(1.0f), db_(NUM_BINS) {}
+
+    const float* noise() {
+        for (float& value : db_) {
+            value = NOISE_DB + 10.0f * std::log10(power_(rng_) + 1e-12f);
+        }
+        return db_.data();
+    }
+
+    // Peak at fractional bin 'bin' with level 'level_db' (6 dB per bin² fall-off)
+    const float* tone(float bin, float level_db) {
+        const size_t centre = static_cast<size_t>(std::lround(bin));
+        for (size_t k = centre - 2; k <= centre + 2; ++k) {
+            const float offset = static_cast<float>(k) - bin;
+            db_[k] = std::max(db_[k], level_db - 6.0f * offset * offset);
+        }
+        return db_.data();
+    }
+
+    float* data() { return db_.data(); }
+
+private:
+    std::mt19937 rng_;
+    std::exponential_distribution<float> power_;
+    std::vector<float> db_;
+};
+
+std::vector<PeakEvent> drain(PeakDetector& detector) {
+    std::vector<PeakEvent> events;
+    detector.drainEvents([&](const PeakEvent& event) { events.push_back(event); });
+    return events;
+}
+
+} // namespace
+
+// ============================================================================
+// Construction Tests
+// ============================================================================
+
+TEST(PeakDetectorTest, InvalidArgumentsThrow) {
+    EXPECT_THROW(PeakDetector(2, SAMPLE_RATE, HOP), std::invalid_argument);
+    EXPECT_THROW(PeakDetector(FFT_SIZE, 0.0f, HOP), std::invalid_argument);
+    EXPECT_THROW(PeakDetector(FFT_SIZE, SAMPLE_RATE, 0), std::invalid_argument);
+
+    PeakDetector::Options options;
+    options.release_db = options.threshold_db + 1.0f;
+    EXPECT_THROW(PeakDetector(FFT_SIZE, SAMPLE_RATE, HOP, options), std::invalid_argument);
+
+    options = {};
+    options.floor_rise_seconds = 0.0f;
+    EXPECT_THROW(PeakDetector(FFT_SIZE, SAMPLE_RATE, HOP, options), std::invalid_argument);
+
+    options = {};
+    options.mask_db = -1.0f;
+    EXPECT_THROW(PeakDetector(FFT_SIZE, SAMPLE_RATE, HOP, options), std::invalid_argument);
+
+    options = {};
+    options.max_tracks = 0;
+    EXPECT_THROW(PeakDetector(FFT_SIZE, SAMPLE_RATE, HOP, options), std::invalid_argument);
+}
+
+// ============================================================================
+// Detection Tests
+// ============================================================================
+
+TEST(PeakDetectorTest, NoiseRaisesNoEvents) {
+    PeakDetector detector(FFT_SIZE, SAMPLE_RATE, HOP);
+    Spectra spectra;
+
+    size_t raised = 0;
+    for (uint64_t hop = 0; hop < 2000; ++hop) {
+        raised += detector.process(spectra.noise(), 1, NUM_BINS, hop * HOP);
+    }
+    EXPECT_EQ(raised, 0u);
+    EXPECT_EQ(detector.getOpenTracks(), 0u);
+    EXPECT_TRUE(drain(detector).empty());
+
+    // The floor settles a few dB below the noise power
+    EXPECT_NEAR(detector.getFloor(500), NOISE_DB - 4.0f, 3.0f);
+}
+
+TEST(PeakDetectorTest, ToneOnsetAndOffset) {
+    PeakDetector detector(FFT_SIZE, SAMPLE_RATE, HOP);
+    Spectra spectra;
+    uint64_t hop = 0;
+
+    for (; hop < 50; ++hop) {
+        detector.process(spectra.noise(), 1, NUM_BINS, hop * HOP);
+    }
+    const uint64_t onset = hop;
+    for (; hop < 150; ++hop) {
+        spectra.noise();
+        detector.process(spectra.tone(200.3f, NOISE_DB + 40.0f), 1, NUM_BINS, hop * HOP);
+    }
+    EXPECT_EQ(detector.getOpenTracks(), 1u);
+    for (; hop < 160; ++hop) {
+        detector.process(spectra.noise(), 1, NUM_BINS, hop * HOP);
+    }
+
+    const std::vector<PeakEvent> events = drain(detector);
+    ASSERT_EQ(events.size(), 2u);
+
+    const PeakEvent& on = events[0];
+    EXPECT_EQ(on.type, PeakEventType::Onset);
+    EXPECT_EQ(on.position, onset * HOP);
+    EXPECT_NEAR(on.frequency, 200.3f * BIN_HZ, 0.01f * BIN_HZ);
+    EXPECT_NEAR(on.level_db, NOISE_DB + 40.0f, 0.01f);
+    EXPECT_NEAR(on.floor_db, NOISE_DB - 4.0f, 4.0f);
+    EXPECT_EQ(on.duration, 0u);
+
+    // 50 ms hold at 21.3 ms per hop: closes on the third hop without the tone
+    const PeakEvent& off = events[1];
+    EXPECT_EQ(off.type, PeakEventType::Offset);
+    EXPECT_EQ(off.track, on.track);
+    EXPECT_EQ(off.position, (150 + 2) * HOP);
+    EXPECT_EQ(off.duration, 99 * HOP);
+    EXPECT_NEAR(off.frequency, on.frequency, 0.01f);
+    EXPECT_NEAR(off.level_db, NOISE_DB + 40.0f, 0.01f);
+}
+
+TEST(PeakDetectorTest, HysteresisKeepsTrackOpen) {
+    PeakDetector detector(FFT_SIZE, SAMPLE_RATE, HOP);
+    Spectra spectra;
+
+    // Below the onset threshold: never opens
+    for (uint64_t hop = 0; hop < 100; ++hop) {
+        spectra.noise();
+        detector.process(spectra.tone(300.0f, NOISE_DB + 12.0f), 1, NUM_BINS, hop * HOP);
+    }
+    EXPECT_TRUE(drain(detector).empty());
+
+    // Above it once, then wavering between release and threshold: one
+    // onset and no offset
+    for (uint64_t hop = 100; hop < 300; ++hop) {
+        spectra.noise();
+        const float level = (hop == 100 || hop % 7 == 0) ? 30.0f : 14.0f;
+        detector.process(spectra.tone(700.0f, NOISE_DB + level), 1, NUM_BINS, hop * HOP);
+    }
+    std::vector<PeakEvent> events = drain(detector);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, PeakEventType::Onset);
+    EXPECT_NEAR(events[0].frequency, 700.0f * BIN_HZ, 0.01f * BIN_HZ);
+
+    // A single missing hop is bridged by the hold time
+    detector.process(spectra.noise(), 1, NUM_BINS, 300 * HOP);
+    spectra.noise();
+    detector.process(spectra.tone(700.0f, NOISE_DB + 30.0f), 1, NUM_BINS, 301 * HOP);
+    EXPECT_TRUE(drain(detector).empty());
+    EXPECT_EQ(detector.getOpenTracks(), 1u);
+}
+
+TEST(PeakDetectorTest, SidelobesAreMasked) {
+    PeakDetector detector(FFT_SIZE, SAMPLE_RATE, HOP);
+    Spectra spectra;
+
+    for (uint64_t hop = 0; hop < 20; ++hop) {
+        spectra.noise();
+        spectra.tone(400.0f, NOISE_DB + 60.0f);
+        spectra.tone(395.0f, NOISE_DB + 29.0f);    // Sidelobes 31 dB down
+        spectra.tone(405.0f, NOISE_DB + 29.0f);
+        spectra.tone(450.0f, NOISE_DB + 30.0f);    // Separate tone
+        detector.process(spectra.data(), 1, NUM_BINS, hop * HOP);
+    }
+
+    const std::vector<PeakEvent> events = drain(detector);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_NEAR(events[0].frequency, 400.0f * BIN_HZ, 0.01f * BIN_HZ);
+    EXPECT_NEAR(events[1].frequency, 450.0f * BIN_HZ, 0.01f * BIN_HZ);
+}
+
+TEST(PeakDetectorTest, ToneFromFirstHopIsDetected) {
+    // The floor starts at the median level, not at the tone
+    PeakDetector detector(FFT_SIZE, SAMPLE_RATE, HOP);
+    Spectra spectra;
+    spectra.noise();
+    detector.process(spectra.tone(123.0f, NOISE_DB + 30.0f), 1, NUM_BINS, 0);
+
+    const std::vector<PeakEvent> events = drain(detector);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].position, 0u);
+
+    // reset() forgets the track without an offset
+    detector.reset();
+    EXPECT_EQ(detector.getOpenTracks(), 0u);
+    EXPECT_TRUE(drain(detector).empty());
+}
+
+// ============================================================================
+// Event Tests
+// ============================================================================
+
+TEST(PeakDetectorTest, FullQueueCountsDroppedEvents) {
+    PeakDetector::Options options;
+    options.queue_capacity = 2;
+    PeakDetector detector(FFT_SIZE, SAMPLE_RATE, HOP, options);
+    Spectra spectra;
+
+    spectra.noise();
+    for (float bin : {100.0f, 200.0f, 300.0f, 400.0f, 500.0f}) {
+        spectra.tone(bin, NOISE_DB + 40.0f);
+    }
+    EXPECT_EQ(detector.process(spectra.data(), 1, NUM_BINS, 0), 5u);
+    EXPECT_EQ(detector.getOpenTracks(), 5u);
+    EXPECT_EQ(detector.getDroppedEvents(), 3u);
+    EXPECT_EQ(drain(detector).size(), 2u);
+
+    // finish() closes every track at the given position
+    EXPECT_EQ(detector.finish(4 * HOP), 5u);
+    EXPECT_EQ(detector.getOpenTracks(), 0u);
+    const std::vector<PeakEvent> offsets = drain(detector);
+    ASSERT_EQ(offsets.size(), 2u);
+    for (const PeakEvent& event : offsets) {
+        EXPECT_EQ(event.type, PeakEventType::Offset);
+        EXPECT_EQ(event.position, 4 * HOP);
+        EXPECT_EQ(event.duration, 0u);
+    }
+    EXPECT_EQ(detector.getDroppedEvents(), 6u);
+}
+
+TEST(PeakDetectorTest, FollowsFFTBinRange) {
+    // 1 kHz sine in noise through a real FFT, only the bins 10..200 analyzed
+    constexpr size_t SIZE = 1024;
+    FFTProcessor fft(SIZE, WindowFunction::Hann);
+    PeakDetector detector(SIZE, SAMPLE_RATE, SIZE / 2);
+    std::vector<float> signal(SIZE);
+    std::vector<float> spectrum(SIZE / 2 + 1, 0.0f);
+    std::mt19937 rng(3);
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+
+    for (uint64_t hop = 0; hop < 8; ++hop) {
+        for (size_t i = 0; i < SIZE; ++i) {
+            const double t = static_cast<double>(hop * SIZE / 2 + i) / SAMPLE_RATE;
+            signal[i] = 0.5f * static_cast<float>(std::sin(2.0 * M_PI * 1000.0 * t)) + noise(rng);
+        }
+        fft.process(signal.data(), spectrum.data(), 10, 200);
+        detector.process(spectrum.data(), 10, 200, hop * SIZE / 2 + SIZE);
+    }
+
+    const std::vector<PeakEvent> events = drain(detector);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].position, SIZE);
+    EXPECT_NEAR(events[0].frequency, 1000.0f, 0.1f * SAMPLE_RATE / SIZE);
+}
+
+// ============================================================================
+// Performance Tests
+// ============================================================================
+
+TEST(PeakDetectorTest, CostBelowTenthOfFFT) {
+    FFTProcessor fft(FFT_SIZE, WindowFunction::Hann);
+    PeakDetector detector(FFT_SIZE, SAMPLE_RATE, HOP);
+    Spectra spectra;
+    std::vector<float> signal(FFT_SIZE);
+    std::vector<float> spectrum(NUM_BINS);
+    std::mt19937 rng(5);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    for (float& sample : signal) {
+        sample = noise(rng);
+    }
+
+    // Noise with a few tones, as a busy real signal
+    spectra.noise();
+    for (float bin : {150.0f, 700.0f, 1500.0f}) {
+        spectra.tone(bin, NOISE_DB + 40.0f);
+    }
+
+    const int iterations = 100;
+    using clock = std::chrono::steady_clock;
+
+    auto start = clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fft.process(signal.data(), spectrum.data());
+    }
+    const double fft_us = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+    start = clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        detector.process(spectra.data(), 1, NUM_BINS, static_cast<uint64_t>(i) * HOP);
+    }
+    const double detector_us = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+    std::cout << "\nFFT 4096: " << fft_us / iterations << " μs, peak detection: "
+              << detector_us / iterations << " μs per hop\n";
+    EXPECT_LT(detector_us, 0.1 * fft_us);
+    EXPECT_EQ(detector.getOpenTracks(), 3u);
+}
@@ -0,0 +1,246 @@
+/**
+ * @file processing_chain_test.cpp
+ * @brief Unit tests for ProcessingChain and ProcessingChainCache
+ *
+ * Tests cover:
+ * - Chain construction and buffer sizing
+ * - Buffers carved aligned from the chain's single arena
+ * - Multi-resolution chains (log scales only, larger input window)
+ * - Sliding DFT chosen only for tiny hops
+ * - Results identical to standalone FFTProcessor + FrequencyResampler
+ * - Cache hits, FFT sharing between chains, LRU eviction
+ * - Chains outliving eviction while in use
+ */
+
+#include <gtest/gtest.h>
+#include <friture/processing_chain.hpp>
+#include <friture/multi_resolution_analyzer.hpp>
+#include <friture/sliding_dft.hpp>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+using namespace friture;
+
+// ============================================================================
+// Test Helpers
+// ============================================================================
+
+namespace {
+
+ChainKey makeKey(size_t fft_size, FrequencyScale scale, size_t height = 200) {
+    SpectrogramSettings settings;
+    settings.fft_size = fft_size;
+    settings.freq_scale = scale;
+    return ChainKey::fromSettings(settings, height);
+}
+
+} // namespace
+
+// ============================================================================
+// ProcessingChain Tests
+// ============================================================================
+
+TEST(ProcessingChainTest, BuffersSizedForKey) {
+    ChainKey key = makeKey(1024, FrequencyScale::Mel, 300);
+    ProcessingChain chain(key, std::make_shared<FFTProcessor>(1024, WindowFunction::Hann));
+
+    EXPECT_EQ(chain.getHopSize(), 256u);
+    EXPECT_EQ(chain.fft_input.size(), 1024u);
+    EXPECT_EQ(chain.fft_output.size(), 513u);
+    EXPECT_EQ(chain.batch_input.size(), (ProcessingChain::BATCH_COLUMNS - 1) * 256 + 1024);
+    EXPECT_EQ(chain.batch_spectra.size(), ProcessingChain::BATCH_COLUMNS * 513);
+    EXPECT_EQ(chain.resampled.size(), 300u);
+}
+
+TEST(ProcessingChainTest, BuffersShareOneAlignedArena) {
+    ChainKey key = makeKey(1024, FrequencyScale::Mel, 300);
+    ProcessingChain chain(key, std::make_shared<FFTProcessor>(1024, WindowFunction::Hann));
+
+    const std::span<float> buffers[] = {chain.fft_input, chain.fft_output, chain.batch_input,
+                                        chain.batch_spectra, chain.resampled};
+    for (const std::span<float>& buffer : buffers) {
+        EXPECT_TRUE(chain.arena().owns(buffer.data()));
+        EXPECT_TRUE(chain.arena().owns(buffer.data() + buffer.size() - 1));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) % AlignedArena::ALIGNMENT, 0u);
+    }
+    // Sized exactly for the layout
+    EXPECT_EQ(chain.arena().used(), chain.arena().capacity());
+}
+
+TEST(ProcessingChainTest, MismatchedFFTThrows) {
+    ChainKey key = makeKey(1024, FrequencyScale::Linear);
+    EXPECT_THROW(ProcessingChain(key, std::make_shared<FFTProcessor>(2048, WindowFunction::Hann)),
+                 std::invalid_argument);
+    EXPECT_THROW(ProcessingChain(key, nullptr), std::invalid_argument);
+}
+
+TEST(ProcessingChainTest, MatchesStandaloneComponents) {
+    ChainKey key = makeKey(2048, FrequencyScale::Logarithmic, 256);
+    ProcessingChain chain(key, std::make_shared<FFTProcessor>(2048, WindowFunction::Hann));
+
+    FFTProcessor fft(2048, WindowFunction::Hann);
+    FrequencyResampler resampler(key.scale, key.min_freq, key.max_freq,
+                                 key.sample_rate, key.fft_size, key.height, key.aggregation);
+
+    for (size_t i = 0; i < chain.fft_input.size(); ++i) {
+        chain.fft_input[i] = std::sin(2.0f * 3.14159265f * 440.0f * i / 48000.0f);
+    }
+
+    std::vector<float> spectrum(fft.getNumBins());
+    std::vector<float> expected(key.height);
+    fft.process(chain.fft_input.data(), spectrum.data());
+    resampler.resample(spectrum.data(), expected.data());
+
+    chain.fft().process(chain.fft_input.data(), chain.fft_output.data());
+    chain.resampler().resample(chain.fft_output.data(), chain.resampled.data());
+
+    for (size_t i = 0; i < key.height; ++i) {
+        EXPECT_FLOAT_EQ(chain.resampled[i], expected[i]);
+    }
+}
+
+TEST(ProcessingChainTest, MultiResolutionOnlyForLogScales) {
+    SpectrogramSettings settings;
+    settings.fft_size = 1024;
+    settings.multi_resolution = true;
+
+    settings.freq_scale = FrequencyScale::Mel;
+    EXPECT_FALSE(ChainKey::fromSettings(settings, 200).multi_resolution);
+    settings.freq_scale = FrequencyScale::Octave;
+    EXPECT_TRUE(ChainKey::fromSettings(settings, 200).multi_resolution);
+
+    // Input window grows to the largest band; the hop stays the base FFT's
+    ChainKey key = ChainKey::fromSettings(settings, 200);
+    ProcessingChain chain(key, std::make_shared<FFTProcessor>(1024, WindowFunction::Hann));
+    ASSERT_NE(chain.multiResolution(), nullptr);
+    EXPECT_EQ(chain.getHopSize(), 256u);
+    EXPECT_EQ(chain.getWindowSize(), chain.multiResolution()->getWindowSize());
+    EXPECT_GT(chain.getWindowSize(), 1024u);
+    EXPECT_EQ(chain.fft_input.size(), chain.getWindowSize());
+
+    ProcessingChain plain(makeKey(1024, FrequencyScale::Octave),
+                          std::make_shared<FFTProcessor>(1024, WindowFunction::Hann));
+    EXPECT_EQ(plain.multiResolution(), nullptr);
+    EXPECT_EQ(plain.getWindowSize(), 1024u);
+}
+
+TEST(ProcessingChainTest, SlidingDFTOnlyForTinyHops) {
+    SpectrogramSettings settings;
+    settings.fft_size = 1024;
+    settings.freq_scale = FrequencyScale::Logarithmic;
+    settings.bin_aggregation = BinAggregation::Interpolate;
+
+    ProcessingChain standard(ChainKey::fromSettings(settings, 100),
+                             std::make_shared<FFTProcessor>(1024, WindowFunction::Hann));
+    EXPECT_EQ(standard.slidingDFT(), nullptr);
+
+    settings.overlap_percent = 99.8f;   // 2-sample hop
+    ProcessingChain sliding(ChainKey::fromSettings(settings, 100),
+                            std::make_shared<FFTProcessor>(1024, WindowFunction::Hann));
+    EXPECT_EQ(sliding.getHopSize(), 2u);
+    ASSERT_NE(sliding.slidingDFT(), nullptr);
+    EXPECT_EQ(sliding.slidingDFT()->getHopSize(), 2u);
+    EXPECT_EQ(sliding.getWindowSize(), 1024u);
+}
+
+// ============================================================================
+// ProcessingChainCache Tests
+// ============================================================================
+
+TEST(ProcessingChainCacheTest, ZeroCapacityThrows) {
+    EXPECT_THROW(ProcessingChainCache(0), std::invalid_argument);
+}
+
+TEST(ProcessingChainCacheTest, AcquireReturnsCachedChain) {
+    ProcessingChainCache cache(4);
+    ChainKey key = makeKey(1024, FrequencyScale::Mel);
+
+    auto first = cache.acquire(key);
+    auto second = cache.acquire(key);
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_TRUE(cache.contains(key));
+}
+
+TEST(ProcessingChainCacheTest, ScalesShareFFTProcessor) {
+    ProcessingChainCache cache(4);
+
+    auto mel = cache.acquire(makeKey(1024, FrequencyScale::Mel));
+    auto linear = cache.acquire(makeKey(1024, FrequencyScale::Linear));
+    auto larger = cache.acquire(makeKey(2048, FrequencyScale::Mel));
+
+    EXPECT_NE(mel.get(), linear.get());
+    EXPECT_EQ(&mel->fft(), &linear->fft());
+    EXPECT_NE(&mel->fft(), &larger->fft());
+}
+
+TEST(ProcessingChainCacheTest, PrewarmBuildsOnce) {
+    ProcessingChainCache cache(4);
+    ChainKey key = makeKey(512, FrequencyScale::ERB);
+
+    EXPECT_TRUE(cache.prewarm(key));
+    EXPECT_FALSE(cache.prewarm(key));
+    EXPECT_EQ(cache.size(), 1u);
+
+    // Invalid key (min >= max) is rejected without throwing
+    ChainKey bad = key;
+    bad.min_freq = 5000.0f;
+    bad.max_freq = 1000.0f;
+    EXPECT_FALSE(cache.prewarm(bad));
+    EXPECT_THROW(cache.acquire(bad), std::invalid_argument);
+}
+
+TEST(ProcessingChainCacheTest, EvictsLeastRecentlyUsed) {
+    ProcessingChainCache cache(2);
+    ChainKey a = makeKey(256, FrequencyScale::Linear);
+    ChainKey b = makeKey(512, FrequencyScale::Linear);
+    ChainKey c = makeKey(1024, FrequencyScale::Linear);
+
+    cache.acquire(a);
+    cache.acquire(b);
+    cache.acquire(a);   // a is now most recently used
+    cache.acquire(c);   // evicts b
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_TRUE(cache.contains(a));
+    EXPECT_FALSE(cache.contains(b));
+    EXPECT_TRUE(cache.contains(c));
+}
+
+TEST(ProcessingChainCacheTest, ChainInUseOutlivesEviction) {
+    ProcessingChainCache cache(1);
+    auto in_use = cache.acquire(makeKey(1024, FrequencyScale::Mel));
+    float* buffer = in_use->fft_input.data();
+
+    cache.acquire(makeKey(2048, FrequencyScale::Mel));
+    cache.clear();
+
+    // Still valid and unchanged for the thread holding it
+    EXPECT_EQ(in_use->fft_input.data(), buffer);
+    std::fill(in_use->fft_input.begin(), in_use->fft_input.end(), 0.5f);
+    in_use->fft().process(in_use->fft_input.data(), in_use->fft_output.data());
+}
+
+TEST(ProcessingChainCacheTest, BatchPlanReadyAfterBuild) {
+    ProcessingChainCache cache(2);
+    auto chain = cache.acquire(makeKey(256, FrequencyScale::Mel));
+
+    // processBatch on a prebuilt chain uses only preallocated buffers
+    const float* before = chain->batch_spectra.data();
+    std::fill(chain->batch_input.begin(), chain->batch_input.end(), 0.1f);
+    chain->fft().processBatch(chain->batch_input.data(), chain->getHopSize(),
+                              ProcessingChain::BATCH_COLUMNS,
+                              chain->batch_spectra.data(), chain->fft().getNumBins());
+    EXPECT_EQ(chain->batch_spectra.data(), before);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,258 @@
+/**
+ * @file quality_governor_test.cpp
+ * @brief Unit tests for QualityGovernor
+ *
+ * Tests cover:
+ * - Render steps: minimal UI first, then lower redraw rates, within bounds
+ * - Analysis steps: coarser resampling up to the divisor bound
+ * - Hysteresis: settling window, raise_after and projected headroom
+ * - Windows without frames or columns, reset, invalid options
+ */
+
+#include <gtest/gtest.h>
+#include <friture/quality_governor.hpp>
+#include <stdexcept>
+
+using namespace friture;
+
+namespace {
+
+// One second window: frames drawn with the given work (Present excluded),
+// columns analyzed with the given busy fraction split evenly over stages
+StageProfileSnapshot makeWindow(uint64_t frames, double work_us, double ui_us,
+                                uint64_t columns, double analysis_busy) {
+    StageProfileSnapshot window;
+    auto set = [&](ProfileStage stage, uint64_t count, double total_us) {
+        StageStatsSnapshot& stats = window.stages[static_cast<size_t>(stage)];
+        stats.count = count;
+        stats.total_ns = static_cast<uint64_t>(total_us * 1000.0);
+    };
+
+    const double present_us = 2000.0;
+    set(ProfileStage::Frame, frames, frames * (work_us + present_us));
+    set(ProfileStage::Present, frames, frames * present_us);
+    set(ProfileStage::UI, frames, frames * ui_us);
+
+    const double busy_us = analysis_busy * 1e6;
+    for (ProfileStage stage : {ProfileStage::Read, ProfileStage::FFT,
+                               ProfileStage::Resample, ProfileStage::Colorize}) {
+        set(stage, columns, busy_us / 4.0);
+    }
+    return window;
+}
+
+StageProfileSnapshot renderWindow(double work_us, double ui_us = 1000.0) {
+    return makeWindow(60, work_us, ui_us, 100, 0.1);
+}
+
+StageProfileSnapshot analysisWindow(double busy) {
+    return makeWindow(60, 2000.0, 500.0, 100, busy);
+}
+
+// Feed the same window until the level changes (at most limit windows)
+int windowsUntilChange(QualityGovernor& governor, const StageProfileSnapshot& window, int limit = 10) {
+    for (int i = 1; i <= limit; ++i) {
+        if (governor.update(window, 1.0)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+// ============================================================================
+// Render Tests
+// ============================================================================
+
+TEST(QualityGovernorTest, StartsAtFullQuality) {
+    QualityGovernor governor;
+    EXPECT_EQ(governor.getLevel(), QualityLevel());
+    EXPECT_FALSE(governor.isDegraded());
+
+    // Comfortably inside budget: nothing to do
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FALSE(governor.update(renderWindow(5000.0), 1.0));
+    }
+    EXPECT_NEAR(governor.getRenderLoad(), 5000.0 / 16667.0, 1e-3);
+}
+
+TEST(QualityGovernorTest, RenderStepsDownWithinBounds) {
+    QualityGovernor::Options options;
+    options.max_frame_interval = 3;
+    QualityGovernor governor(options);
+
+    // 40 ms of work per frame never fits; Present time is not counted
+    const StageProfileSnapshot heavy = renderWindow(40000.0);
+    ASSERT_TRUE(governor.update(heavy, 1.0));
+    EXPECT_TRUE(governor.getLevel().minimal_ui);
+    EXPECT_EQ(governor.getLevel().frame_interval, 1u);
+
+    // The window after a change is skipped
+    EXPECT_FALSE(governor.update(heavy, 1.0));
+    ASSERT_TRUE(governor.update(heavy, 1.0));
+    EXPECT_EQ(governor.getLevel().frame_interval, 2u);
+
+    EXPECT_FALSE(governor.update(heavy, 1.0));
+    ASSERT_TRUE(governor.update(heavy, 1.0));
+    EXPECT_EQ(governor.getLevel().frame_interval, 3u);
+
+    // Bound reached
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FALSE(governor.update(heavy, 1.0));
+    }
+    EXPECT_EQ(governor.getLevel().frame_interval, 3u);
+    EXPECT_EQ(governor.getLevel().height_divisor, 1u);   // Analysis was fine
+    EXPECT_EQ(governor.getChangeCount(), 3u);
+}
+
+TEST(QualityGovernorTest, MinimalUiCanBeDisallowed) {
+    QualityGovernor::Options options;
+    options.allow_minimal_ui = false;
+    QualityGovernor governor(options);
+
+    ASSERT_TRUE(governor.update(renderWindow(20000.0), 1.0));
+    EXPECT_FALSE(governor.getLevel().minimal_ui);
+    EXPECT_EQ(governor.getLevel().frame_interval, 2u);
+}
+
+TEST(QualityGovernorTest, RenderRaisesAfterCalmWindows) {
+    QualityGovernor::Options options;
+    options.allow_minimal_ui = false;
+    options.raise_after = 3;
+    options.headroom = 0.7;
+    QualityGovernor governor(options);
+
+    ASSERT_TRUE(governor.update(renderWindow(20000.0), 1.0));
+    ASSERT_EQ(governor.getLevel().frame_interval, 2u);
+
+    // 14 ms fits the doubled budget but would be 84% of a single one
+    EXPECT_EQ(windowsUntilChange(governor, renderWindow(14000.0)), -1);
+
+    // 10 ms would be 60%: settle, then three calm windows
+    EXPECT_EQ(windowsUntilChange(governor, renderWindow(10000.0)), 3);
+    EXPECT_EQ(governor.getLevel().frame_interval, 1u);
+    EXPECT_FALSE(governor.isDegraded());
+}
+
+TEST(QualityGovernorTest, RaiseCountsTextBackIn) {
+    QualityGovernor governor;
+
+    // 18 ms with 6 ms of text: over budget, so the text goes
+    ASSERT_TRUE(governor.update(renderWindow(18000.0, 6000.0), 1.0));
+    ASSERT_TRUE(governor.getLevel().minimal_ui);
+    EXPECT_FALSE(governor.update(renderWindow(9000.0, 200.0), 1.0));   // Settling
+
+    // 9 ms without text would be 15 ms with it: not enough headroom
+    EXPECT_EQ(windowsUntilChange(governor, renderWindow(9000.0, 200.0)), -1);
+
+    // 5 ms + 6 ms is 66% of the budget
+    EXPECT_EQ(windowsUntilChange(governor, renderWindow(5000.0, 200.0)), 3);
+    EXPECT_FALSE(governor.getLevel().minimal_ui);
+}
+
+TEST(QualityGovernorTest, SpikeResetsCalmCount) {
+    QualityGovernor::Options options;
+    options.allow_minimal_ui = false;
+    QualityGovernor governor(options);
+    ASSERT_TRUE(governor.update(renderWindow(20000.0), 1.0));
+    EXPECT_FALSE(governor.update(renderWindow(5000.0), 1.0));   // Settling
+
+    EXPECT_FALSE(governor.update(renderWindow(5000.0), 1.0));
+    EXPECT_FALSE(governor.update(renderWindow(5000.0), 1.0));
+    EXPECT_FALSE(governor.update(renderWindow(14000.0), 1.0));   // No headroom
+    EXPECT_FALSE(governor.update(renderWindow(5000.0), 1.0));
+    EXPECT_FALSE(governor.update(renderWindow(5000.0), 1.0));
+    EXPECT_TRUE(governor.update(renderWindow(5000.0), 1.0));
+}
+
+// ============================================================================
+// Analysis Tests
+// ============================================================================
+
+TEST(QualityGovernorTest, AnalysisCoarsensToBound) {
+    QualityGovernor::Options options;
+    options.max_height_divisor = 4;
+    options.analysis_budget = 0.7;
+    QualityGovernor governor(options);
+
+    ASSERT_TRUE(governor.update(analysisWindow(0.9), 1.0));
+    EXPECT_EQ(governor.getLevel().height_divisor, 2u);
+    EXPECT_FALSE(governor.getLevel().minimal_ui);   // Render was fine
+    EXPECT_NEAR(governor.getAnalysisLoad(), 0.9 / 0.7, 1e-6);
+
+    EXPECT_FALSE(governor.update(analysisWindow(0.9), 1.0));
+    ASSERT_TRUE(governor.update(analysisWindow(0.9), 1.0));
+    EXPECT_EQ(governor.getLevel().height_divisor, 4u);
+    EXPECT_EQ(windowsUntilChange(governor, analysisWindow(0.9)), -1);
+}
+
+TEST(QualityGovernorTest, AnalysisRaiseProjectsRowCost) {
+    QualityGovernor::Options options;
+    options.analysis_budget = 0.5;
+    options.headroom = 0.7;
+    QualityGovernor governor(options);
+    ASSERT_TRUE(governor.update(analysisWindow(0.6), 1.0));
+    ASSERT_EQ(governor.getLevel().height_divisor, 2u);
+
+    // Busy 0.3, half of it per row: 0.45 at full height is 90% of budget
+    EXPECT_EQ(windowsUntilChange(governor, analysisWindow(0.3)), -1);
+
+    // Busy 0.2 projects to 0.3, 60% of budget
+    EXPECT_EQ(windowsUntilChange(governor, analysisWindow(0.2)), 3);
+    EXPECT_EQ(governor.getLevel().height_divisor, 1u);
+}
+
+TEST(QualityGovernorTest, DivisorBoundOfOneNeverCoarsens) {
+    QualityGovernor::Options options;
+    options.max_height_divisor = 1;
+    QualityGovernor governor(options);
+    EXPECT_EQ(windowsUntilChange(governor, analysisWindow(0.95)), -1);
+    EXPECT_EQ(governor.getLevel().height_divisor, 1u);
+}
+
+// ============================================================================
+// Edge Cases
+// ============================================================================
+
+TEST(QualityGovernorTest, EmptyWindowsAreNotJudged) {
+    QualityGovernor governor;
+    ASSERT_TRUE(governor.update(renderWindow(40000.0), 1.0));
+    ASSERT_TRUE(governor.isDegraded());
+
+    // Nothing drawn and nothing analyzed (minimized, paused): no raise
+    EXPECT_EQ(windowsUntilChange(governor, StageProfileSnapshot()), -1);
+    EXPECT_FALSE(governor.update(renderWindow(40000.0), 0.0));
+    EXPECT_TRUE(governor.getLevel().minimal_ui);
+}
+
+TEST(QualityGovernorTest, ResetRestoresFullQuality) {
+    QualityGovernor governor;
+    ASSERT_TRUE(governor.update(makeWindow(60, 40000.0, 1000.0, 100, 0.95), 1.0));
+    EXPECT_TRUE(governor.getLevel().minimal_ui);
+    EXPECT_EQ(governor.getLevel().height_divisor, 2u);
+
+    governor.reset();
+    EXPECT_EQ(governor.getLevel(), QualityLevel());
+    EXPECT_FALSE(governor.isDegraded());
+    // No settling window pending after a reset
+    EXPECT_TRUE(governor.update(renderWindow(40000.0), 1.0));
+}
+
+TEST(QualityGovernorTest, InvalidOptionsThrow) {
+    QualityGovernor::Options options;
+    options.frame_budget_us = 0.0;
+    EXPECT_THROW(QualityGovernor{options}, std::invalid_argument);
+
+    options = QualityGovernor::Options();
+    options.headroom = 1.0;
+    EXPECT_THROW(QualityGovernor{options}, std::invalid_argument);
+
+    options = QualityGovernor::Options();
+    options.max_frame_interval = 0;
+    EXPECT_THROW(QualityGovernor{options}, std::invalid_argument);
+
+    options = QualityGovernor::Options();
+    options.max_height_divisor = 3;
+    EXPECT_THROW(QualityGovernor{options}, std::invalid_argument);
+}
@@ -0,0 +1,334 @@
+/**
+ * @file realtime_check_test.cpp
+ * @brief Unit tests for RealtimeCheck, RealtimeScope and RealtimeExemption
+ *
+ * Tests cover:
+ * - Allocations and blocking locks inside a scope are counted with its name
+ * - Nothing is counted outside scopes, inside exemptions or for try-locks
+ * - Test mode: the live pipeline (callback-style ring writes with sample
+ *   rate conversion; FFT, sliding DFT, zoom, multi-resolution and
+ *   multichannel analysis, peak detection, averaging, level metering) runs
+ *   for FRITURE_RT_CHECK_SECONDS (default 2) without a violation
+ *
+ * Everything is skipped unless built with -DFRITURE_RT_CHECKS=ON.
+ */
+
+#include <gtest/gtest.h>
+#include <friture/realtime_check.hpp>
+#include <friture/level_meter.hpp>
+#include <friture/multichannel_analyzer.hpp>
+#include <friture/multi_resolution_analyzer.hpp>
+#include <friture/peak_detector.hpp>
+#include <friture/processing_chain.hpp>
+#include <friture/ringbuffer.hpp>
+#include <friture/sample_rate_converter.hpp>
+#include <friture/sliding_dft.hpp>
+#include <friture/spectral_averager.hpp>
+#include <friture/zoom_analyzer.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr uint32_t DEVICE_RATE = 44100;
+constexpr uint32_t ANALYSIS_RATE = 48000;
+constexpr size_t CALLBACK_FRAMES = 441;   // 10 ms at the device rate
+constexpr size_t CHANNELS = 2;
+
+// Keeps test allocations from being optimized away
+std::vector<float>* g_sink = nullptr;
+
+class RealtimeCheckTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!RealtimeCheck::isEnabled()) {
+            GTEST_SKIP() << "Built without FRITURE_RT_CHECKS";
+        }
+        RealtimeCheck::setAbortOnViolation(false);
+        RealtimeCheck::reset();
+    }
+
+    void TearDown() override {
+        RealtimeCheck::reset();
+    }
+};
+
+double checkSeconds() {
+    const char* value = std::getenv("FRITURE_RT_CHECK_SECONDS");
+    return value ? std::atof(value) : 2.0;
+}
+
+/**
+ * @brief One single-channel chain following the lead ring
+ */
+struct Analysis {
+    std::unique_ptr<ProcessingChain> chain;
+    RingBuffer<float>::Cursor cursor;
+    uint64_t columns = 0;
+};
+
+Analysis makeAnalysis(const SpectrogramSettings& settings) {
+    const ChainKey key = ChainKey::fromSettings(settings, 300);
+    return {std::make_unique<ProcessingChain>(
+                key, std::make_shared<FFTProcessor>(key.fft_size, key.window, key.kaiser_beta)),
+            RingBuffer<float>::Cursor()};
+}
+
+// Same dispatch as FritureApp::processAudioFrame
+void analyzeColumn(ProcessingChain& chain) {
+    if (ZoomAnalyzer* zoom = chain.zoom()) {
+        zoom->analyze(chain.fft_input.data());
+        zoom->resample(chain.resampled.data());
+        return;
+    }
+    if (MultiResolutionAnalyzer* multi = chain.multiResolution()) {
+        multi->analyze(chain.fft_input.data());
+        multi->stitch(chain.resampled.data());
+        return;
+    }
+    if (SlidingDFT* sliding = chain.slidingDFT()) {
+        sliding->process(chain.fft_input.data(), chain.fft_output.data());
+    } else {
+        const FrequencyResampler::BinRange range = chain.resampler().getInputRange();
+        chain.fft().process(chain.fft_input.data(), chain.fft_output.data(),
+                            range.first, range.end);
+    }
+    chain.resampler().resample(chain.fft_output.data(), chain.resampled.data());
+}
+
+} // namespace
+
+// ============================================================================
+// Detection Tests
+// ============================================================================
+
+TEST_F(RealtimeCheckTest, CountsAllocationInScope) {
+    {
+        RealtimeScope scope("test scope");
+        g_sink = new std::vector<float>(1000);
+    }
+    delete g_sink;
+    g_sink = nullptr;
+
+    EXPECT_GE(RealtimeCheck::getViolationCount(RealtimeViolation::Allocation), 1u);
+    EXPECT_EQ(RealtimeCheck::getViolationCount(RealtimeViolation::Deallocation), 0u);
+    const std::vector<RealtimeViolationRecord> records = RealtimeCheck::getRecords();
+    ASSERT_FALSE(records.empty());
+    EXPECT_EQ(records.front().kind, RealtimeViolation::Allocation);
+    EXPECT_EQ(std::string(records.front().scope), "test scope");
+}
+
+TEST_F(RealtimeCheckTest, CountsDeallocationInInnermostScope) {
+    g_sink = new std::vector<float>(1000);
+    {
+        RealtimeScope outer("outer");
+        {
+            RealtimeScope inner("inner");
+            delete g_sink;
+            g_sink = nullptr;
+        }
+    }
+
+    EXPECT_EQ(RealtimeCheck::getViolationCount(RealtimeViolation::Allocation), 0u);
+    EXPECT_GE(RealtimeCheck::getViolationCount(RealtimeViolation::Deallocation), 1u);
+    const std::vector<RealtimeViolationRecord> records = RealtimeCheck::getRecords();
+    ASSERT_FALSE(records.empty());
+    EXPECT_EQ(std::string(records.front().scope), "inner");
+}
+
+#ifdef __linux__
+TEST_F(RealtimeCheckTest, CountsBlockingLockButNotTryLock) {
+    std::mutex mutex;
+    {
+        RealtimeScope scope("test scope");
+        if (mutex.try_lock()) {
+            mutex.unlock();
+        }
+        EXPECT_EQ(RealtimeCheck::getViolationCount(), 0u);
+
+        std::lock_guard<std::mutex> lock(mutex);
+    }
+    EXPECT_EQ(RealtimeCheck::getViolationCount(RealtimeViolation::Lock), 1u);
+}
+#endif
+
+TEST_F(RealtimeCheckTest, IgnoresUnscopedAndExemptCode) {
+    g_sink = new std::vector<float>(1000);
+    delete g_sink;
+    {
+        RealtimeScope scope("test scope");
+        RealtimeExemption exemption;
+        g_sink = new std::vector<float>(1000);
+        delete g_sink;
+    }
+    g_sink = nullptr;
+    EXPECT_EQ(RealtimeCheck::getViolationCount(), 0u);
+
+    RealtimeCheck::reset();
+    EXPECT_TRUE(RealtimeCheck::getRecords().empty());
+}
+
+// ============================================================================
+// Test Mode
+// ============================================================================
+
+TEST_F(RealtimeCheckTest, PipelineRunsWithoutViolations) {
+    const double seconds = checkSeconds();
+
+    // Everything is allocated up front, as the engine and the app do
+    std::vector<std::unique_ptr<RingBuffer<float>>> rings;
+    std::vector<std::unique_ptr<SampleRateConverter>> converters;
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        rings.push_back(std::make_unique<RingBuffer<float>>(ANALYSIS_RATE * 4));
+        converters.push_back(std::make_unique<SampleRateConverter>(DEVICE_RATE, ANALYSIS_RATE));
+        converters.back()->reserve(CALLBACK_FRAMES);
+    }
+    RingBuffer<float>& lead = *rings.back();
+
+    SpectrogramSettings settings;
+    settings.fft_size = 2048;
+    std::vector<Analysis> analyses;
+    analyses.push_back(makeAnalysis(settings));   // FFT + resampler
+
+    SpectrogramSettings sliding = settings;
+    sliding.fft_size = 1024;
+    sliding.freq_scale = FrequencyScale::Logarithmic;
+    sliding.bin_aggregation = BinAggregation::Interpolate;
+    sliding.overlap_percent = 99.8f;   // 2-sample hop
+    analyses.push_back(makeAnalysis(sliding));
+
+    SpectrogramSettings zoom = settings;
+    zoom.min_freq = 1000.0f;
+    zoom.max_freq = 4000.0f;
+    zoom.zoom = true;
+    analyses.push_back(makeAnalysis(zoom));
+
+    SpectrogramSettings multi = settings;
+    multi.fft_size = 1024;
+    multi.freq_scale = FrequencyScale::Logarithmic;
+    multi.multi_resolution = true;
+    analyses.push_back(makeAnalysis(multi));
+
+    ASSERT_NE(analyses[1].chain->slidingDFT(), nullptr);
+    ASSERT_NE(analyses[2].chain->zoom(), nullptr);
+    ASSERT_NE(analyses[3].chain->multiResolution(), nullptr);
+    for (Analysis& analysis : analyses) {
+        analysis.cursor = lead.makeCursor(analysis.chain->getWindowSize());
+    }
+
+    ProcessingChain& main = *analyses.front().chain;
+    PeakDetector peaks(main.getKey().fft_size, static_cast<float>(ANALYSIS_RATE), main.getHopSize());
+    SpectralAverager::Options average;
+    average.mode = AveragingMode::Exponential;
+    SpectralAverager averager(main.resampled.size(), static_cast<float>(ANALYSIS_RATE),
+                              main.getHopSize(), average);
+    std::vector<float> averaged(main.resampled.size());
+    uint64_t peak_events = 0;
+
+    MultiChannelAnalyzer multichannel(main.getKey(), CHANNELS, ChannelLayout::Stacked, 400);
+    std::vector<float> multichannel_column(multichannel.getDisplayHeight());
+    RingBuffer<float>::Cursor multichannel_cursor = lead.makeCursor(main.getKey().fft_size);
+    uint64_t multichannel_columns = 0;
+
+    LevelMeter meter(static_cast<float>(ANALYSIS_RATE));
+    RingBuffer<float>::Cursor meter_cursor = lead.makeCursor();
+    std::vector<float> meter_block(1024);
+
+    std::atomic<bool> producing{true};
+
+    // "Audio callback": one block every 10 ms, converted and de-interleaved
+    std::thread producer([&] {
+        std::vector<float> input(CALLBACK_FRAMES);
+        std::vector<float> converted(converters.front()->getMaxOutput(CALLBACK_FRAMES));
+        const auto start = std::chrono::steady_clock::now();
+        uint64_t frame = 0;
+        for (size_t block = 0; ; ++block) {
+            const auto due = start + std::chrono::microseconds(block * 10000);
+            if (due - start >= std::chrono::duration<double>(seconds)) {
+                break;
+            }
+            std::this_thread::sleep_until(due);
+
+            RealtimeScope scope("audio callback");
+            for (size_t c = 0; c < CHANNELS; ++c) {
+                for (size_t i = 0; i < CALLBACK_FRAMES; ++i) {
+                    const double t = static_cast<double>(frame + i) / DEVICE_RATE;
+                    input[i] = static_cast<float>(0.5 * std::sin(2.0 * 3.14159265358979 * (1000.0 + 500.0 * c) * t));
+                }
+                const size_t produced = converters[c]->process(input.data(), CALLBACK_FRAMES,
+                                                               converted.data());
+                rings[c]->write(converted.data(), produced);
+            }
+            frame += CALLBACK_FRAMES;
+        }
+        producing.store(false, std::memory_order_release);
+    });
+
+    // "Analysis thread": every complete hop of every analysis, exactly once
+    auto analyzeAvailable = [&] {
+        RealtimeScope scope("analysis");
+        for (Analysis& analysis : analyses) {
+            ProcessingChain& chain = *analysis.chain;
+            while (lead.readWindow(analysis.cursor, chain.fft_input.data(),
+                                   chain.getWindowSize(), chain.getHopSize()) != ReadStatus::NotReady) {
+                analyzeColumn(chain);
+                ++analysis.columns;
+                if (&chain == &main) {
+                    const FrequencyResampler::BinRange range = chain.resampler().getInputRange();
+                    peaks.process(chain.fft_output.data(), range.first, range.end,
+                                  analysis.cursor.position());
+                    peaks.drainEvents([&](const PeakEvent&) { ++peak_events; });
+                    averager.process(chain.resampled.data(), averaged.data());
+                }
+            }
+        }
+
+        const size_t fft_size = main.getKey().fft_size;
+        while (lead.readWindow(multichannel_cursor, multichannel.chain(CHANNELS - 1).fft_input.data(),
+                               fft_size, multichannel.getHopSize()) != ReadStatus::NotReady) {
+            RingBuffer<float>::Cursor cursor(multichannel_cursor.position() - multichannel.getHopSize());
+            rings[0]->readWindow(cursor, multichannel.chain(0).fft_input.data(),
+                                 fft_size, multichannel.getHopSize());
+            multichannel.process();
+            multichannel.combine(multichannel_column.data());
+            ++multichannel_columns;
+        }
+
+        while (lead.readWindow(meter_cursor, meter_block.data(), meter_block.size(),
+                               meter_block.size()) != ReadStatus::NotReady) {
+            meter.process(meter_block.data(), meter_block.size());
+        }
+    };
+    std::thread consumer([&] {
+        while (producing.load(std::memory_order_acquire)) {
+            analyzeAvailable();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    for (const Analysis& analysis : analyses) {
+        EXPECT_GT(analysis.columns, 0u);
+    }
+    EXPECT_GT(multichannel_columns, 0u);
+    std::cout << "Real-time check over " << seconds << " s: " << analyses.front().columns
+              << " columns, " << multichannel_columns << " multichannel columns, "
+              << peak_events << " peak events" << std::endl;
+
+    if (RealtimeCheck::getViolationCount() > 0) {
+        RealtimeCheck::report(std::cout);
+    }
+    EXPECT_EQ(RealtimeCheck::getViolationCount(), 0u);
+}
@@ -0,0 +1,279 @@
+/**
+ * @file replay_harness_test.cpp
+ * @brief Unit tests for ReplayHarness
+ *
+ * Tests cover:
+ * - Option and settings validation
+ * - Same input, same hash; different input, different hash
+ * - Columns match a chain driven window by window
+ * - Block size (virtual callback size) does not change the output
+ * - Zoom and sliding chains replay deterministically
+ * - Decimation and peak detection
+ * - WAV file replay
+ */
+
+#include <gtest/gtest.h>
+#include <friture/replay_harness.hpp>
+#include <friture/processing_chain.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+
+std::vector<float> sine(float frequency, size_t count) {
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * frequency * i / SAMPLE_RATE);
+    }
+    return samples;
+}
+
+ReplayOptions smallOptions() {
+    ReplayOptions options;
+    options.settings.fft_size = 256;
+    options.settings.freq_scale = FrequencyScale::Linear;
+    options.settings.min_freq = 100.0f;
+    options.height = 64;
+    options.block_frames = 100;
+    return options;
+}
+
+/**
+ * @brief Replay and keep every column
+ */
+ReplayStats replayColumns(ReplayHarness& harness, const std::vector<float>& samples,
+                          std::vector<float>& columns, std::vector<uint64_t>* window_ends = nullptr) {
+    columns.clear();
+    return harness.replay(samples.data(), samples.size(), SAMPLE_RATE,
+                          [&](uint64_t window_end, const float* column_db, size_t rows) {
+        columns.insert(columns.end(), column_db, column_db + rows);
+        if (window_ends) {
+            window_ends->push_back(window_end);
+        }
+    });
+}
+
+/**
+ * @brief Write a mono 16-bit PCM WAV file
+ */
+void writeWav(const std::string& path, const std::vector<float>& samples) {
+    auto u32 = [](std::ofstream& f, uint32_t v) { f.write(reinterpret_cast<const char*>(&v), 4); };
+    auto u16 = [](std::ofstream& f, uint16_t v) { f.write(reinterpret_cast<const char*>(&v), 2); };
+
+    std::ofstream f(path, std::ios::binary);
+    uint32_t data_bytes = static_cast<uint32_t>(samples.size() * 2);
+    f.write("RIFF", 4);
+    u32(f, 36 + data_bytes);
+    f.write("WAVEfmt ", 8);
+    u32(f, 16);
+    u16(f, 1);                                  // PCM
+    u16(f, 1);                                  // Mono
+    u32(f, static_cast<uint32_t>(SAMPLE_RATE));
+    u32(f, static_cast<uint32_t>(SAMPLE_RATE) * 2);
+    u16(f, 2);
+    u16(f, 16);
+    f.write("data", 4);
+    u32(f, data_bytes);
+    for (float s : samples) {
+        u16(f, static_cast<uint16_t>(static_cast<int16_t>(s * 32767.0f)));
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Configuration Tests
+// ============================================================================
+
+TEST(ReplayHarnessTest, RejectsInvalidOptions) {
+    ReplayOptions options = smallOptions();
+    options.height = 0;
+    EXPECT_THROW(ReplayHarness{options}, std::invalid_argument);
+
+    options = smallOptions();
+    options.block_frames = 0;
+    EXPECT_THROW(ReplayHarness{options}, std::invalid_argument);
+
+    // Range above Nyquist is clamped, a range below min_freq is not
+    options = smallOptions();
+    options.settings.min_freq = 5000.0f;
+    options.settings.max_freq = 24000.0f;
+    ReplayHarness harness(options);
+    std::vector<float> samples(4096, 0.0f);
+    EXPECT_THROW(harness.replay(samples.data(), samples.size(), 8000.0f), std::invalid_argument);
+    EXPECT_NO_THROW(harness.replay(samples.data(), samples.size(), SAMPLE_RATE));
+}
+
+// ============================================================================
+// Determinism Tests
+// ============================================================================
+
+TEST(ReplayHarnessTest, SameInputGivesSameHash) {
+    ReplayHarness harness(smallOptions());
+    std::vector<float> first_columns;
+    std::vector<float> second_columns;
+    const std::vector<float> samples = sine(1000.0f, 12000);
+
+    ReplayStats first = replayColumns(harness, samples, first_columns);
+    ReplayStats second = replayColumns(harness, samples, second_columns);
+
+    EXPECT_GT(first.columns, 0u);
+    EXPECT_EQ(first.columns, second.columns);
+    EXPECT_EQ(first.hash, second.hash);
+    EXPECT_EQ(first_columns, second_columns);
+
+    // The hash covers exactly the emitted columns
+    uint64_t hash = ReplayHarness::HASH_SEED;
+    for (uint64_t c = 0; c < first.columns; ++c) {
+        hash = ReplayHarness::hashColumn(hash, first_columns.data() + c * first.rows, first.rows);
+    }
+    EXPECT_EQ(hash, first.hash);
+
+    ReplayStats other = harness.replay(sine(1001.0f, 12000).data(), 12000, SAMPLE_RATE);
+    EXPECT_EQ(other.columns, first.columns);
+    EXPECT_NE(other.hash, first.hash);
+}
+
+TEST(ReplayHarnessTest, ColumnsMatchChainDrivenDirectly) {
+    const ReplayOptions options = smallOptions();
+    ReplayHarness harness(options);
+    const std::vector<float> samples = sine(3000.0f, 10000);
+
+    std::vector<float> columns;
+    std::vector<uint64_t> window_ends;
+    ReplayStats stats = replayColumns(harness, samples, columns, &window_ends);
+
+    SpectrogramSettings settings = options.settings;
+    settings.setSampleRate(SAMPLE_RATE);
+    const ChainKey key = ChainKey::fromSettings(settings, options.height);
+    ProcessingChain chain(key, std::make_shared<FFTProcessor>(key.fft_size, key.window, key.kaiser_beta));
+    StageProfiler profiler;
+
+    const size_t window = chain.getWindowSize();
+    const size_t hop = chain.getHopSize();
+    ASSERT_EQ(stats.hop_size, hop);
+    ASSERT_EQ(stats.columns, (samples.size() - window) / hop + 1);
+    ASSERT_EQ(stats.hops, stats.columns);
+
+    for (uint64_t c = 0; c < stats.columns; ++c) {
+        std::copy(samples.begin() + c * hop, samples.begin() + c * hop + window, chain.fft_input.begin());
+        ASSERT_TRUE(chain.analyze(profiler));
+        chain.resampler().resample(chain.fft_output.data(), chain.resampled.data());
+
+        EXPECT_EQ(window_ends[c], c * hop + window);
+        EXPECT_EQ(std::memcmp(chain.resampled.data(), columns.data() + c * stats.rows,
+                              stats.rows * sizeof(float)), 0) << "column " << c;
+    }
+
+    // Every window was read and transformed once
+    EXPECT_EQ(stats.stages[ProfileStage::Read].count, stats.hops);
+    EXPECT_EQ(stats.stages[ProfileStage::FFT].count, stats.hops);
+}
+
+TEST(ReplayHarnessTest, BlockSizeDoesNotChangeOutput) {
+    const std::vector<float> samples = sine(2000.0f, 9000);
+    ReplayOptions options = smallOptions();
+
+    options.block_frames = 17;
+    ReplayStats small_blocks = ReplayHarness(options).replay(samples.data(), samples.size(), SAMPLE_RATE);
+    options.block_frames = 4096;
+    ReplayStats large_blocks = ReplayHarness(options).replay(samples.data(), samples.size(), SAMPLE_RATE);
+
+    EXPECT_EQ(small_blocks.columns, large_blocks.columns);
+    EXPECT_EQ(small_blocks.hash, large_blocks.hash);
+    EXPECT_DOUBLE_EQ(small_blocks.audio_seconds, 9000.0 / SAMPLE_RATE);
+}
+
+TEST(ReplayHarnessTest, ZoomAndSlidingChainsAreDeterministic) {
+    const std::vector<float> samples = sine(1500.0f, 24000);
+
+    ReplayOptions zoom = smallOptions();
+    zoom.settings.zoom = true;
+    zoom.settings.min_freq = 1000.0f;
+    zoom.settings.max_freq = 2000.0f;
+
+    ReplayOptions sliding = smallOptions();
+    sliding.settings.overlap_percent = 99.0f;
+
+    for (const ReplayOptions& options : {zoom, sliding}) {
+        ReplayHarness harness(options);
+        std::vector<float> first_columns;
+        std::vector<float> second_columns;
+        ReplayStats first = replayColumns(harness, samples, first_columns);
+        ReplayStats second = replayColumns(harness, samples, second_columns);
+        EXPECT_GT(first.columns, 0u);
+        EXPECT_EQ(first.hash, second.hash);
+        EXPECT_EQ(first_columns, second_columns);
+    }
+}
+
+// ============================================================================
+// Averaging and Peak Tests
+// ============================================================================
+
+TEST(ReplayHarnessTest, DecimationEmitsEveryKthHop) {
+    ReplayOptions options = smallOptions();
+    options.settings.column_decimation = 4;
+    ReplayHarness harness(options);
+    const std::vector<float> samples = sine(1000.0f, 20000);
+
+    ReplayStats stats = harness.replay(samples.data(), samples.size(), SAMPLE_RATE);
+    EXPECT_EQ(stats.columns, stats.hops / 4);
+}
+
+TEST(ReplayHarnessTest, PeakDetectionCountsToneEvents) {
+    ReplayOptions options = smallOptions();
+    options.peak_detection = true;
+    ReplayHarness harness(options);
+
+    // Silence, then a tone until the end: one onset, one offset at the end
+    std::vector<float> samples(24000, 0.0f);
+    const std::vector<float> tone = sine(2000.0f, 12000);
+    std::copy(tone.begin(), tone.end(), samples.begin() + 12000);
+
+    ReplayStats stats = harness.replay(samples.data(), samples.size(), SAMPLE_RATE);
+    EXPECT_GE(stats.peak_events, 2u);
+    EXPECT_EQ(stats.peak_events % 2, 0u);
+
+    options.peak_detection = false;
+    EXPECT_EQ(ReplayHarness(options).replay(samples.data(), samples.size(), SAMPLE_RATE).peak_events, 0u);
+}
+
+// ============================================================================
+// File Tests
+// ============================================================================
+
+TEST(ReplayHarnessTest, ReplaysWavFile) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string wav = (dir / "replay_harness_test.wav").string();
+    const std::vector<float> samples = sine(1000.0f, 12000);
+    writeWav(wav, samples);
+
+    ReplayHarness harness(smallOptions());
+    ReplayStats file_stats;
+    ASSERT_TRUE(harness.replayFile(wav.c_str(), file_stats)) << harness.getError();
+    EXPECT_EQ(file_stats.sample_rate, SAMPLE_RATE);
+    EXPECT_EQ(file_stats.columns, harness.replay(samples.data(), samples.size(), SAMPLE_RATE).columns);
+
+    // Same file, same hash
+    ReplayStats again;
+    ASSERT_TRUE(harness.replayFile(wav.c_str(), again));
+    EXPECT_EQ(again.hash, file_stats.hash);
+
+    EXPECT_FALSE(harness.replayFile((dir / "does_not_exist.wav").string().c_str(), again));
+    EXPECT_FALSE(harness.getError().empty());
+
+    std::remove(wav.c_str());
+}
@@ -214,6 +214,147 @@ TEST(RingBufferTest, ReadMoreThanCapacity) {
     }
 }
 
+// ============================================================================
+// Cursor Tests
+// ============================================================================
+
+TEST(RingBufferTest, TotalWrittenIsMonotonic) {
+    RingBuffer<float> buffer(100);
+    std::vector<float> data(30, 1.0f);
+
+    for (int i = 0; i < 10; ++i) {
+        buffer.write(data.data(), data.size());
+    }
+
+    EXPECT_EQ(buffer.getTotalWritten(), 300u);
+    EXPECT_EQ(buffer.getWritePosition(), 0u);  // 300 % 100
+}
+
+TEST(RingBufferTest, WriteStridedDeinterleaves) {
+    RingBuffer<float> left(10);
+    RingBuffer<float> right(10);
+    std::vector<float> interleaved;
+    for (int i = 0; i < 8; ++i) {
+        interleaved.push_back(static_cast<float>(i));         // Left
+        interleaved.push_back(static_cast<float>(100 + i));   // Right
+    }
+
+    // Twice, so the second write wraps
+    for (int pass = 0; pass < 2; ++pass) {
+        left.writeStrided(interleaved.data(), 8, 2);
+        right.writeStrided(interleaved.data() + 1, 8, 2);
+    }
+    EXPECT_EQ(left.getTotalWritten(), 16u);
+
+    std::vector<float> out(8);
+    auto cursor = left.makeCursor(8);
+    ASSERT_EQ(left.readWindow(cursor, out.data(), 8, 8), ReadStatus::Ok);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_FLOAT_EQ(out[i], static_cast<float>(i));
+    }
+
+    cursor = right.makeCursor(8);
+    ASSERT_EQ(right.readWindow(cursor, out.data(), 8, 8), ReadStatus::Ok);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_FLOAT_EQ(out[i], static_cast<float>(100 + i));
+    }
+}
+
+TEST(RingBufferTest, CursorVisitsEveryHopOnce) {
+    RingBuffer<float> buffer(1000);
+    auto cursor = buffer.makeCursor();
+
+    const size_t window = 64;
+    const size_t hop = 16;
+    std::vector<float> output(window);
+
+    // Write a ramp in odd-sized chunks, draining after each chunk
+    std::vector<float> chunk(37);
+    uint64_t next_sample = 0;
+    uint64_t expected_start = 0;
+    for (int round = 0; round < 100; ++round) {
+        for (auto& value : chunk) {
+            value = static_cast<float>(next_sample++);
+        }
+        buffer.write(chunk.data(), chunk.size());
+
+        ReadStatus status;
+        while ((status = buffer.readWindow(cursor, output.data(), window, hop)) != ReadStatus::NotReady) {
+            ASSERT_EQ(status, ReadStatus::Ok);
+            EXPECT_FLOAT_EQ(output[0], static_cast<float>(expected_start));
+            EXPECT_FLOAT_EQ(output[window - 1], static_cast<float>(expected_start + window - 1));
+            expected_start += hop;
+        }
+    }
+
+    // Every hop whose window is complete was read exactly once
+    EXPECT_EQ(expected_start, (next_sample - window) / hop * hop + hop);
+    EXPECT_EQ(cursor.getOverrunCount(), 0u);
+}
+
+TEST(RingBufferTest, CursorNotReadyBeforeFullWindow) {
+    RingBuffer<float> buffer(100);
+    auto cursor = buffer.makeCursor();
+    std::vector<float> data(50, 1.0f);
+    std::vector<float> output(64);
+
+    buffer.write(data.data(), data.size());
+    EXPECT_EQ(buffer.available(cursor, 64, 16), 0u);
+    EXPECT_EQ(buffer.readWindow(cursor, output.data(), 64, 16), ReadStatus::NotReady);
+    EXPECT_EQ(cursor.position(), 0u);
+
+    buffer.write(data.data(), data.size());
+    EXPECT_EQ(buffer.available(cursor, 64, 16), 3u);  // starts 0, 16, 32
+    EXPECT_EQ(buffer.readWindow(cursor, output.data(), 64, 16), ReadStatus::Ok);
+    EXPECT_EQ(cursor.position(), 16u);
+}
+
+TEST(RingBufferTest, CursorReportsOverrun) {
+    RingBuffer<float> buffer(100);
+    auto cursor = buffer.makeCursor();
+
+    // Write 1000 ramp samples without reading: the cursor is lapped
+    std::vector<float> data(1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<float>(i);
+    }
+    for (size_t i = 0; i < data.size(); i += 50) {
+        buffer.write(data.data() + i, 50);
+    }
+
+    std::vector<float> output(32);
+    EXPECT_EQ(buffer.readWindow(cursor, output.data(), 32, 8), ReadStatus::Overrun);
+    EXPECT_EQ(cursor.getOverrunCount(), 1u);
+
+    // Skip is a whole number of hops, landing on the newest complete window
+    EXPECT_EQ(cursor.getSamplesLost() % 8, 0u);
+    uint64_t start = cursor.getSamplesLost();
+    EXPECT_EQ(start, 968u);
+    EXPECT_FLOAT_EQ(output[0], static_cast<float>(start));
+    EXPECT_FLOAT_EQ(output[31], static_cast<float>(start + 31));
+
+    // Following reads are clean again
+    buffer.write(data.data(), 8);
+    EXPECT_EQ(buffer.readWindow(cursor, output.data(), 32, 8), ReadStatus::Ok);
+}
+
+TEST(RingBufferTest, MakeCursorWithHistory) {
+    RingBuffer<float> buffer(100);
+    std::vector<float> data(250, 1.0f);
+    buffer.write(data.data(), 50);
+    buffer.write(data.data(), 50);
+    buffer.write(data.data(), 50);
+
+    EXPECT_EQ(buffer.makeCursor().position(), 150u);
+    EXPECT_EQ(buffer.makeCursor(64).position(), 86u);
+    EXPECT_EQ(buffer.makeCursor(1000).position(), 50u);  // Clamped to capacity
+
+    auto cursor = buffer.makeCursor(64);
+    cursor.seek(140);
+    EXPECT_EQ(cursor.position(), 140u);
+    EXPECT_EQ(cursor.getOverrunCount(), 0u);
+}
+
 // ============================================================================
 // Thread Safety Tests
 // ============================================================================
@@ -317,6 +458,50 @@ TEST(RingBufferTest, MultipleReaders) {
     EXPECT_EQ(success_count.load(), 40);  // 4 threads × 10 reads
 }
 
+TEST(RingBufferTest, CursorConcurrentLossless) {
+    // Buffer holds the whole stream, so the writer can never lap the
+    // reader: it must see every hop, in order, with no overrun
+    RingBuffer<float> buffer(1 << 18);
+    const size_t total_samples = 200000;
+    const size_t window = 256;
+    const size_t hop = 64;
+    auto cursor = buffer.makeCursor();
+
+    std::thread writer([&]() {
+        std::vector<float> chunk(128);
+        for (size_t written = 0; written < total_samples; written += chunk.size()) {
+            for (size_t i = 0; i < chunk.size(); ++i) {
+                chunk[i] = static_cast<float>((written + i) % 4096);
+            }
+            buffer.write(chunk.data(), chunk.size());
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+        }
+    });
+
+    std::vector<float> output(window);
+    uint64_t expected_start = 0;
+    bool ordered = true;
+    const uint64_t last_start = (total_samples - window) / hop * hop;
+
+    while (expected_start <= last_start) {
+        ReadStatus status = buffer.readWindow(cursor, output.data(), window, hop);
+        if (status == ReadStatus::NotReady) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (status != ReadStatus::Ok ||
+            output[0] != static_cast<float>(expected_start % 4096)) {
+            ordered = false;
+        }
+        expected_start += hop;
+    }
+
+    writer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(cursor.getOverrunCount(), 0u);
+}
+
 // ============================================================================
 // Performance Tests
 // ============================================================================
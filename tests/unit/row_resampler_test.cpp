@@ -0,0 +1,91 @@
+/**
+ * @file row_resampler_test.cpp
+ * @brief Unit tests for RowResampler
+ *
+ * Tests cover:
+ * - Identity at equal row counts
+ * - Linear interpolation when growing, max-pooling when shrinking
+ * - Row-major blocks matching column-by-column results
+ * - Nearest rows for colors, invalid sizes
+ */
+
+#include <gtest/gtest.h>
+#include <friture/row_resampler.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+TEST(RowResamplerTest, SameSizeIsIdentity) {
+    RowResampler rows(5, 5);
+    const std::vector<uint16_t> input = {7, 65535, 0, 300, 12};
+    std::vector<uint16_t> output(5);
+    rows.resampleColumn(input.data(), output.data());
+    EXPECT_EQ(output, input);
+}
+
+TEST(RowResamplerTest, GrowingInterpolates) {
+    // Output centres at input positions -0.25, 0.25, 0.75, 1.25 (edges clamp)
+    RowResampler rows(2, 4);
+    const std::vector<uint16_t> input = {1000, 2000};
+    std::vector<uint16_t> output(4);
+    rows.resampleColumn(input.data(), output.data());
+    EXPECT_EQ(output, (std::vector<uint16_t>{1000, 1250, 1750, 2000}));
+
+    EXPECT_EQ(rows.nearestRow(0), 0u);
+    EXPECT_EQ(rows.nearestRow(1), 0u);
+    EXPECT_EQ(rows.nearestRow(2), 1u);
+    EXPECT_EQ(rows.nearestRow(3), 1u);
+}
+
+TEST(RowResamplerTest, ShrinkingKeepsPeaks) {
+    // A one-row peak must survive 3:1 and 3:2 reduction
+    RowResampler third(6, 2);
+    const std::vector<uint16_t> input = {10, 20, 900, 30, 40, 50};
+    std::vector<uint16_t> output(2);
+    third.resampleColumn(input.data(), output.data());
+    EXPECT_EQ(output, (std::vector<uint16_t>{900, 50}));
+
+    RowResampler uneven(3, 2);
+    const std::vector<uint8_t> bytes = {5, 200, 7};
+    std::vector<uint8_t> pooled(2);
+    uneven.resampleColumn(bytes.data(), pooled.data());
+    EXPECT_EQ(pooled, (std::vector<uint8_t>{200, 200}));
+}
+
+TEST(RowResamplerTest, RowsMatchColumns) {
+    constexpr size_t COLUMNS = 37;
+    for (auto [in_rows, out_rows] : {std::pair<size_t, size_t>{48, 100}, {100, 48}, {64, 64}}) {
+        // Row-major input with a pitch wider than the columns processed
+        const size_t in_pitch = COLUMNS + 5;
+        const size_t out_pitch = COLUMNS + 3;
+        std::vector<uint16_t> input(in_rows * in_pitch);
+        for (size_t i = 0; i < input.size(); ++i) {
+            input[i] = static_cast<uint16_t>((i * 7919u) % 65536u);
+        }
+
+        RowResampler rows(in_rows, out_rows);
+        std::vector<uint16_t> block(out_rows * out_pitch, 0);
+        rows.resampleRows(input.data(), in_pitch, block.data(), out_pitch, COLUMNS, 0, out_rows / 2);
+        rows.resampleRows(input.data(), in_pitch, block.data(), out_pitch, COLUMNS,
+                          out_rows / 2, out_rows);
+
+        std::vector<uint16_t> column(in_rows), resampled(out_rows);
+        for (size_t c = 0; c < COLUMNS; ++c) {
+            for (size_t r = 0; r < in_rows; ++r) {
+                column[r] = input[r * in_pitch + c];
+            }
+            rows.resampleColumn(column.data(), resampled.data());
+            for (size_t r = 0; r < out_rows; ++r) {
+                ASSERT_EQ(block[r * out_pitch + c], resampled[r])
+                    << in_rows << " -> " << out_rows << " column " << c << " row " << r;
+            }
+        }
+    }
+}
+
+TEST(RowResamplerTest, InvalidSizesThrow) {
+    EXPECT_THROW(RowResampler(0, 4), std::invalid_argument);
+    EXPECT_THROW(RowResampler(4, 0), std::invalid_argument);
+}
@@ -0,0 +1,245 @@
+/**
+ * @file sample_rate_converter_test.cpp
+ * @brief Unit tests for SampleRateConverter
+ *
+ * Tests cover:
+ * - Parameter validation and ratio reduction
+ * - Shared filter banks per ratio
+ * - Tone amplitude, frequency and alignment after conversion
+ * - Alias rejection when decimating
+ * - Streaming output identical to position-addressed output
+ * - Conversion throughput
+ */
+
+#include <gtest/gtest.h>
+#include <friture/sample_rate_converter.hpp>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+std::vector<float> tone(double frequency, double rate, size_t count) {
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<float>(0.5 * std::sin(2.0 * PI * frequency * i / rate));
+    }
+    return samples;
+}
+
+// Whole-signal conversion through the position-addressed interface
+std::vector<float> convertAll(const SampleRateConverter& src, const std::vector<float>& input) {
+    const size_t count = static_cast<size_t>(src.getOutputLength(input.size()));
+    const int64_t first = src.getFirstInput(0);
+    std::vector<float> padded(src.getInputSpan(count), 0.0f);
+    for (size_t i = 0; i < padded.size(); ++i) {
+        int64_t index = first + static_cast<int64_t>(i);
+        if (index >= 0 && index < static_cast<int64_t>(input.size())) {
+            padded[i] = input[static_cast<size_t>(index)];
+        }
+    }
+    std::vector<float> output(count);
+    src.convert(padded.data(), first, 0, count, output.data());
+    return output;
+}
+
+} // namespace
+
+// ============================================================================
+// Construction Tests
+// ============================================================================
+
+TEST(SampleRateConverterTest, RejectsInvalidParameters) {
+    EXPECT_THROW(SampleRateConverter(0, 48000), std::invalid_argument);
+    EXPECT_THROW(SampleRateConverter(48000, 0), std::invalid_argument);
+    EXPECT_THROW(SampleRateConverter(44100, 48000, 12), std::invalid_argument);
+    EXPECT_THROW(SampleRateConverter(44100, 48000, 0), std::invalid_argument);
+    // 4099 is prime: 4099 phases
+    EXPECT_THROW(SampleRateConverter(1000, 4099), std::invalid_argument);
+    // 64 taps × 32 decimation exceeds MAX_TAPS
+    EXPECT_THROW(SampleRateConverter(192000, 6000), std::invalid_argument);
+}
+
+TEST(SampleRateConverterTest, ReducesRatio) {
+    SampleRateConverter up(44100, 48000);
+    EXPECT_EQ(up.getPhaseCount(), 160u);
+    EXPECT_EQ(up.getDecimation(), 147u);
+    EXPECT_EQ(up.getTapCount(), SampleRateConverter::DEFAULT_TAPS);
+    EXPECT_FALSE(up.isPassthrough());
+
+    // Decimation scales the taps by M / L
+    SampleRateConverter down(96000, 24000);
+    EXPECT_EQ(down.getPhaseCount(), 1u);
+    EXPECT_EQ(down.getDecimation(), 4u);
+    EXPECT_EQ(down.getTapCount(), 4 * SampleRateConverter::DEFAULT_TAPS);
+
+    SampleRateConverter same(48000, 48000);
+    EXPECT_TRUE(same.isPassthrough());
+    EXPECT_EQ(same.getLatency(), 0u);
+}
+
+TEST(SampleRateConverterTest, SharesFilterBankPerRatio) {
+    SampleRateConverter a(44100, 48000);
+    SampleRateConverter b(88200, 96000);   // Same reduced ratio
+    SampleRateConverter c(48000, 44100);
+    EXPECT_EQ(a.getFilterBank(), b.getFilterBank());
+    EXPECT_NE(a.getFilterBank(), c.getFilterBank());
+}
+
+TEST(SampleRateConverterTest, OutputLength) {
+    SampleRateConverter up(44100, 48000);
+    EXPECT_EQ(up.getOutputLength(44100), 48000u);
+    EXPECT_EQ(up.getOutputLength(1), 2u);   // Outputs at input times 0 and 147/160
+    EXPECT_EQ(up.getOutputLength(0), 0u);
+
+    SampleRateConverter down(96000, 24000);
+    EXPECT_EQ(down.getOutputLength(96000), 24000u);
+    EXPECT_EQ(down.getOutputLength(5), 2u);
+}
+
+// ============================================================================
+// Accuracy Tests
+// ============================================================================
+
+TEST(SampleRateConverterTest, PreservesToneAndAlignment) {
+    // Tones inside every passband (24 kHz output: flat to ~9.8 kHz), both directions
+    for (auto rates : {std::pair<uint32_t, uint32_t>{44100, 48000},
+                       std::pair<uint32_t, uint32_t>{48000, 44100},
+                       std::pair<uint32_t, uint32_t>{96000, 24000}}) {
+        for (double frequency : {1000.0, 9000.0}) {
+            SampleRateConverter src(rates.first, rates.second);
+            std::vector<float> output = convertAll(src, tone(frequency, rates.first, rates.first / 2));
+            std::vector<float> expected = tone(frequency, rates.second, output.size());
+
+            // Away from the silent lead-in and tail
+            double max_error = 0.0;
+            for (size_t i = src.getTapCount(); i + src.getTapCount() < output.size(); ++i) {
+                max_error = std::max(max_error, std::fabs(static_cast<double>(output[i]) - expected[i]));
+            }
+            EXPECT_LT(max_error, 1e-3) << rates.first << " -> " << rates.second
+                                       << " Hz, tone " << frequency << " Hz";
+        }
+    }
+}
+
+TEST(SampleRateConverterTest, DecimationRejectsAliases) {
+    // 20 kHz folds to 4 kHz at 24 kHz unless filtered out
+    SampleRateConverter src(96000, 24000);
+    std::vector<float> output = convertAll(src, tone(20000.0, 96000, 48000));
+
+    double energy = 0.0;
+    size_t count = 0;
+    for (size_t i = src.getTapCount(); i + src.getTapCount() < output.size(); ++i) {
+        energy += static_cast<double>(output[i]) * output[i];
+        ++count;
+    }
+    double rms = std::sqrt(energy / count);
+    // Input RMS is 0.5 / √2: at least 70 dB down
+    EXPECT_LT(20.0 * std::log10(rms / (0.5 / std::sqrt(2.0))), -70.0);
+}
+
+TEST(SampleRateConverterTest, PassthroughCopies) {
+    SampleRateConverter src(48000, 48000);
+    std::vector<float> input = tone(440.0, 48000, 1000);
+    EXPECT_EQ(convertAll(src, input), input);
+
+    std::vector<float> output(src.getMaxOutput(100));
+    EXPECT_EQ(src.process(input.data(), 100, output.data()), 100u);
+    EXPECT_EQ(output[57], input[57]);
+}
+
+// ============================================================================
+// Streaming Tests
+// ============================================================================
+
+TEST(SampleRateConverterTest, StreamingMatchesConvert) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<size_t> block(1, 700);
+
+    for (auto rates : {std::pair<uint32_t, uint32_t>{44100, 48000},
+                       std::pair<uint32_t, uint32_t>{48000, 44100},
+                       std::pair<uint32_t, uint32_t>{96000, 24000}}) {
+        SampleRateConverter src(rates.first, rates.second);
+        src.reserve(256);   // Blocks above this are split internally
+
+        std::vector<float> input = tone(1234.5, rates.first, 20000);
+        std::vector<float> reference = convertAll(src, input);
+
+        std::vector<float> streamed;
+        for (size_t pos = 0; pos < input.size();) {
+            size_t n = std::min(block(rng), input.size() - pos);
+            std::vector<float> out(src.getMaxOutput(n));
+            size_t produced = src.process(input.data() + pos, n, out.data());
+            ASSERT_LE(produced, out.size());
+            streamed.insert(streamed.end(), out.begin(), out.begin() + produced);
+            pos += n;
+        }
+
+        // Held back: the outputs whose right taps are still to come
+        ASSERT_LE(streamed.size(), reference.size());
+        EXPECT_GE(streamed.size() + src.getLatency() * src.getPhaseCount() / src.getDecimation() + 1,
+                  reference.size());
+        for (size_t i = 0; i < streamed.size(); ++i) {
+            ASSERT_FLOAT_EQ(streamed[i], reference[i]) << rates.first << " -> " << rates.second
+                                                       << " output " << i;
+        }
+
+        // Reset restarts at output 0
+        src.reset();
+        std::vector<float> out(src.getMaxOutput(input.size()));
+        size_t produced = src.process(input.data(), input.size(), out.data());
+        ASSERT_GT(produced, 0u);
+        EXPECT_FLOAT_EQ(out[0], reference[0]);
+    }
+}
+
+TEST(SampleRateConverterTest, ConvertAnyOutputRange) {
+    // Seeking: a slice computed on its own equals the same slice of the whole
+    SampleRateConverter src(44100, 48000);
+    std::vector<float> input = tone(3000.0, 44100, 10000);
+    std::vector<float> whole = convertAll(src, input);
+
+    const uint64_t first = 5003;
+    const size_t count = 777;
+    const int64_t input_first = src.getFirstInput(first);
+    std::vector<float> span(input.begin() + input_first,
+                            input.begin() + input_first + static_cast<int64_t>(src.getInputSpan(count)));
+    std::vector<float> slice(count);
+    src.convert(span.data(), input_first, first, count, slice.data());
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(slice[i], whole[first + i]) << "output " << first + i;
+    }
+}
+
+// ============================================================================
+// Performance Tests
+// ============================================================================
+
+TEST(SampleRateConverterTest, PerformanceRealtimeFactor) {
+    // 10 s of 44.1 kHz audio to 48 kHz, streamed in device-sized blocks
+    SampleRateConverter src(44100, 48000);
+    std::vector<float> input = tone(1000.0, 44100, 441000);
+    std::vector<float> output(src.getMaxOutput(512));
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t total = 0;
+    for (size_t pos = 0; pos + 512 <= input.size(); pos += 512) {
+        total += src.process(input.data() + pos, 512, output.data());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    EXPECT_GT(total, 470000u);
+    // Far faster than real time even unoptimized
+    EXPECT_LT(ms, 1000.0);
+
+    std::cout << "\n=== 10 s 44.1 -> 48 kHz (" << src.getTapCount() << " taps) ===\n";
+    std::cout << "Time: " << ms << " ms (" << 10000.0 / ms << "x real time)\n";
+}
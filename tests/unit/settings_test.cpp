@@ -13,6 +13,7 @@
 #include <gtest/gtest.h>
 #include <friture/settings.hpp>
 #include <friture/types.hpp>
+#include <cmath>
 
 using namespace friture;
 
@@ -262,6 +263,31 @@ TEST(SpectrogramSettingsTest, GetSamplesPerColumn) {
     EXPECT_EQ(settings.getSamplesPerColumn(), 2048);
 }
 
+TEST(SpectrogramSettingsTest, OverlapSetsHop) {
+    SpectrogramSettings settings;
+    EXPECT_FLOAT_EQ(settings.overlap_percent, 75.0f);
+
+    EXPECT_TRUE(settings.setOverlap(93.75f));
+    EXPECT_EQ(settings.getSamplesPerColumn(), 256u);
+
+    EXPECT_TRUE(settings.setOverlap(0.0f));
+    EXPECT_EQ(settings.getSamplesPerColumn(), 4096u);
+
+    // Never below one sample
+    settings.setFFTSize(32);
+    EXPECT_TRUE(settings.setOverlap(SpectrogramSettings::MAX_OVERLAP_PERCENT));
+    EXPECT_EQ(settings.getSamplesPerColumn(), 1u);
+    EXPECT_TRUE(settings.isValid());
+
+    EXPECT_FALSE(settings.setOverlap(-1.0f));
+    EXPECT_FALSE(settings.setOverlap(100.0f));
+    EXPECT_FALSE(settings.setOverlap(std::nanf("")));
+    EXPECT_FLOAT_EQ(settings.overlap_percent, SpectrogramSettings::MAX_OVERLAP_PERCENT);
+
+    settings.overlap_percent = 100.0f;
+    EXPECT_FALSE(settings.isValid());
+}
+
 TEST(SpectrogramSettingsTest, GetTimePerColumn) {
     SpectrogramSettings settings;
 
@@ -331,6 +357,31 @@ TEST(SpectrogramSettingsTest, ValidationDetectsInvalidTimeRange) {
     EXPECT_FALSE(settings.isValid());
 }
 
+TEST(SpectrogramSettingsTest, SetAveragingAndDecimation) {
+    SpectrogramSettings settings;
+
+    EXPECT_TRUE(settings.setAveraging(AveragingMode::Linear, 0.5f, 16));
+    EXPECT_EQ(settings.averaging, AveragingMode::Linear);
+    EXPECT_FLOAT_EQ(settings.averaging_time, 0.5f);
+    EXPECT_EQ(settings.averaging_frames, 16u);
+
+    EXPECT_FALSE(settings.setAveraging(AveragingMode::Exponential, 0.0f, 8));
+    EXPECT_FALSE(settings.setAveraging(AveragingMode::Exponential, 1.0f, 0));
+    EXPECT_FALSE(settings.setAveraging(AveragingMode::Exponential, 1.0f,
+                                       SpectrogramSettings::MAX_AVERAGING_FRAMES + 1));
+    EXPECT_EQ(settings.averaging, AveragingMode::Linear);
+
+    EXPECT_TRUE(settings.setColumnDecimation(4));
+    EXPECT_EQ(settings.column_decimation, 4u);
+    EXPECT_FALSE(settings.setColumnDecimation(0));
+    EXPECT_FALSE(settings.setColumnDecimation(SpectrogramSettings::MAX_COLUMN_DECIMATION + 1));
+    EXPECT_EQ(settings.column_decimation, 4u);
+    EXPECT_TRUE(settings.isValid());
+
+    settings.averaging_time = -1.0f;
+    EXPECT_FALSE(settings.isValid());
+}
+
 // ============================================================================
 // Type toString Tests
 // ============================================================================
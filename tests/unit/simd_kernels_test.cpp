@@ -0,0 +1,283 @@
+/**
+ * @file simd_kernels_test.cpp
+ * @brief Unit tests for SIMD spectrum kernels
+ *
+ * Tests cover:
+ * - Fast log10 error bound over the full dynamic range
+ * - Window multiply and power-to-dB against scalar references
+ * - Tail handling for sizes that are not a multiple of the vector width
+ * - FFTProcessor fast vs exact dB conversion
+ * - dB to linear power conversion accuracy
+ * - Dot product against a double-precision reference
+ * - Noise floor tracking against the scalar formula
+ * - Power averages and linear power to dB conversion
+ */
+
+#include <gtest/gtest.h>
+#include <friture/simd_kernels.hpp>
+#include <friture/fft_processor.hpp>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <iostream>
+
+using namespace friture;
+
+// ============================================================================
+// Fast log10 Tests
+// ============================================================================
+
+TEST(SimdKernelsTest, ReportsIsa) {
+    std::cout << "Active SIMD kernels: " << simd::toString(simd::activeIsa()) << std::endl;
+    EXPECT_STRNE(simd::toString(simd::activeIsa()), "Unknown");
+}
+
+TEST(SimdKernelsTest, FastLog10ErrorBound) {
+    // Sweep 1e-30 .. 1e6 (the dB range FFTProcessor can produce)
+    float max_error_db = 0.0f;
+    for (float exp10 = -30.0f; exp10 <= 6.0f; exp10 += 0.001f) {
+        float x = std::pow(10.0f, exp10);
+        float error_db = 10.0f * std::fabs(simd::fastLog10(x) - std::log10(x));
+        max_error_db = std::max(max_error_db, error_db);
+    }
+
+    std::cout << "fastLog10 max error: " << max_error_db << " dB" << std::endl;
+    EXPECT_LT(max_error_db, simd::FAST_LOG10_MAX_ERROR_DB);
+}
+
+TEST(SimdKernelsTest, FastLog10PowersOfTwo) {
+    for (int e = -100; e <= 100; ++e) {
+        float x = std::ldexp(1.0f, e);
+        EXPECT_NEAR(simd::fastLog10(x), e * 0.30102999566f, 1e-4f);
+    }
+}
+
+// ============================================================================
+// Kernel Tests
+// ============================================================================
+
+TEST(SimdKernelsTest, ApplyWindowMatchesScalar) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    for (size_t n : {1u, 7u, 8u, 9u, 31u, 1024u, 1029u}) {
+        std::vector<float> input(n), window(n), output(n);
+        for (size_t i = 0; i < n; ++i) {
+            input[i] = dist(rng);
+            window[i] = dist(rng);
+        }
+
+        simd::applyWindow(input.data(), window.data(), output.data(), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_FLOAT_EQ(output[i], input[i] * window[i]) << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+TEST(SimdKernelsTest, PowerToDbMatchesReference) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+    const float scale = 1.0f / (1024.0f * 1024.0f);
+    const float epsilon = 1e-30f;
+
+    for (size_t n : {1u, 5u, 8u, 17u, 513u, 2049u}) {
+        std::vector<float> spectrum(2 * n);
+        for (auto& v : spectrum) {
+            v = dist(rng);
+        }
+        spectrum[0] = 0.0f;  // Silent bin exercises the epsilon floor
+        spectrum[1] = 0.0f;
+
+        std::vector<float> fast(n), exact(n);
+        simd::powerToDb(spectrum.data(), fast.data(), n, scale, epsilon, false);
+        simd::powerToDb(spectrum.data(), exact.data(), n, scale, epsilon, true);
+
+        for (size_t i = 0; i < n; ++i) {
+            float re = spectrum[2 * i];
+            float im = spectrum[2 * i + 1];
+            float reference = 10.0f * std::log10((re * re + im * im) * scale + epsilon);
+
+            ASSERT_NEAR(exact[i], reference, 1e-4f) << "n=" << n << " i=" << i;
+            ASSERT_NEAR(fast[i], reference, simd::FAST_LOG10_MAX_ERROR_DB) << "n=" << n << " i=" << i;
+        }
+        EXPECT_NEAR(exact[0], -300.0f, 1e-3f);
+    }
+}
+
+// ============================================================================
+// FFTProcessor Integration
+// ============================================================================
+
+TEST(SimdKernelsTest, FFTProcessorFastMatchesExact) {
+    FFTProcessor processor(4096, WindowFunction::Hann);
+    EXPECT_FALSE(processor.isExactLog10());
+
+    std::vector<float> signal(4096);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.5f * std::sin(2.0f * 3.14159265f * 1000.0f * i / 48000.0f) +
+                    0.01f * std::sin(2.0f * 3.14159265f * 7000.0f * i / 48000.0f);
+    }
+
+    std::vector<float> fast(processor.getNumBins()), exact(processor.getNumBins());
+    processor.process(signal.data(), fast.data());
+
+    processor.setExactLog10(true);
+    EXPECT_TRUE(processor.isExactLog10());
+    processor.process(signal.data(), exact.data());
+
+    for (size_t i = 0; i < fast.size(); ++i) {
+        ASSERT_NEAR(fast[i], exact[i], simd::FAST_LOG10_MAX_ERROR_DB) << "bin " << i;
+    }
+}
+
+// ============================================================================
+// dB to Power Tests
+// ============================================================================
+
+TEST(SimdKernelsTest, FastDbToPowerErrorBound) {
+    float max_rel = 0.0f;
+    for (float db = -370.0f; db <= 370.0f; db += 0.01f) {
+        double exact = std::pow(10.0, db / 10.0);
+        double rel = std::fabs(simd::fastDbToPower(db) - exact) / exact;
+        max_rel = std::max(max_rel, static_cast<float>(rel));
+    }
+
+    std::cout << "fastDbToPower max relative error: " << max_rel << std::endl;
+    EXPECT_LT(max_rel, simd::FAST_DB_TO_POWER_MAX_REL_ERROR);
+}
+
+TEST(SimdKernelsTest, DbToPowerMatchesScalar) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-300.0f, 60.0f);
+
+    for (size_t n : {1u, 3u, 4u, 8u, 13u, 1025u}) {
+        std::vector<float> db(n), output(n);
+        for (auto& v : db) v = dist(rng);
+
+        simd::dbToPower(db.data(), output.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            float expected = simd::fastDbToPower(db[i]);
+            ASSERT_NEAR(output[i], expected, std::fabs(expected) * 1e-6f) << "n=" << n << " i=" << i;
+        }
+    }
+
+    // In place, and out-of-range input clamps instead of overflowing
+    std::vector<float> extreme = {-1000.0f, 0.0f, 1000.0f};
+    simd::dbToPower(extreme.data(), extreme.data(), extreme.size());
+    EXPECT_GT(extreme[0], 0.0f);
+    EXPECT_NEAR(extreme[1], 1.0f, 1e-6f);
+    EXPECT_TRUE(std::isfinite(extreme[2]));
+}
+
+TEST(SimdKernelsTest, DotProductMatchesReference) {
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    for (size_t n : {0u, 1u, 7u, 8u, 15u, 16u, 64u, 257u}) {
+        std::vector<float> a(n), b(n);
+        double expected = 0.0;
+        double magnitude = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = dist(rng);
+            b[i] = dist(rng);
+            expected += static_cast<double>(a[i]) * b[i];
+            magnitude += std::fabs(static_cast<double>(a[i]) * b[i]);
+        }
+        // Summation order differs per ISA: bound by the absolute sum
+        EXPECT_NEAR(simd::dotProduct(a.data(), b.data(), n), expected, 1e-6 * (magnitude + 1.0))
+            << "n=" << n;
+    }
+}
+
+TEST(SimdKernelsTest, TrackFloorMatchesScalar) {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> dist(-120.0f, 0.0f);
+    const float rise = 0.01f;
+    const float fall = 0.2f;
+
+    for (size_t n : {1u, 3u, 4u, 8u, 13u, 2049u}) {
+        std::vector<float> db(n), floor(n), excess(n);
+        for (size_t i = 0; i < n; ++i) {
+            db[i] = dist(rng);
+            floor[i] = dist(rng);
+        }
+        const std::vector<float> before = floor;
+
+        const float max_excess = simd::trackFloor(db.data(), floor.data(), excess.data(), n, rise, fall);
+        float expected_max = std::numeric_limits<float>::lowest();
+        for (size_t i = 0; i < n; ++i) {
+            const float d = db[i] - before[i];
+            const float expected = before[i] + (d > 0.0f ? rise : fall) * d;
+            ASSERT_EQ(excess[i], d) << "n=" << n << " i=" << i;
+            ASSERT_FLOAT_EQ(floor[i], expected) << "n=" << n << " i=" << i;
+            expected_max = std::max(expected_max, d);
+        }
+        EXPECT_EQ(max_excess, expected_max) << "n=" << n;
+    }
+
+    float none = 0.0f;
+    EXPECT_EQ(simd::trackFloor(&none, &none, &none, 0, rise, fall), std::numeric_limits<float>::lowest());
+}
+
+TEST(SimdKernelsTest, PowerAveragesMatchScalar) {
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    const float weight = 0.125f;
+    const float decay = 0.9f;
+
+    for (size_t n : {1u, 3u, 4u, 8u, 13u, 600u}) {
+        std::vector<float> power(n), average(n), held(n), oldest(n);
+        std::vector<double> sum(n);
+        for (size_t i = 0; i < n; ++i) {
+            power[i] = dist(rng);
+            average[i] = dist(rng);
+            held[i] = dist(rng);
+            oldest[i] = dist(rng);
+            sum[i] = oldest[i] + dist(rng);
+        }
+        const std::vector<float> average0 = average, held0 = held, oldest0 = oldest;
+        const std::vector<double> sum0 = sum;
+
+        simd::averagePower(power.data(), average.data(), n, weight);
+        simd::holdPower(power.data(), held.data(), n, decay);
+        simd::slidePower(power.data(), oldest.data(), sum.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_FLOAT_EQ(average[i], average0[i] + weight * (power[i] - average0[i])) << "n=" << n;
+            ASSERT_FLOAT_EQ(held[i], std::max(power[i], held0[i] * decay)) << "n=" << n;
+            ASSERT_EQ(sum[i], sum0[i] + (static_cast<double>(power[i]) - oldest0[i])) << "n=" << n;
+            ASSERT_EQ(oldest[i], power[i]) << "n=" << n;
+        }
+    }
+}
+
+TEST(SimdKernelsTest, LinearToDbAccuracy) {
+    std::mt19937 rng(29);
+    std::uniform_real_distribution<float> exponent(-20.0f, 3.0f);
+    const float floor = 1e-30f;
+
+    for (size_t n : {1u, 7u, 8u, 600u}) {
+        std::vector<float> power(n), db(n);
+        for (size_t i = 0; i < n; ++i) {
+            power[i] = std::pow(10.0f, exponent(rng));
+        }
+        power[0] = -1e-12f;   // Rounding of a running sum below zero
+
+        simd::linearToDb(power.data(), db.data(), n, 0.25f, floor);
+        EXPECT_NEAR(db[0], 10.0f * std::log10(floor), simd::FAST_LOG10_MAX_ERROR_DB);
+        for (size_t i = 1; i < n; ++i) {
+            ASSERT_NEAR(db[i], 10.0f * std::log10(power[i] * 0.25f), simd::FAST_LOG10_MAX_ERROR_DB)
+                << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file sliding_dft_test.cpp
+ * @brief Unit tests for SlidingDFT
+ *
+ * Tests cover:
+ * - Parameter validation
+ * - Displayed bin selection per aggregation mode
+ * - Same dB spectrum as FFTProcessor (Hann and Hamming) over many hops
+ * - Reseeding after gaps and periodically
+ * - Cost model
+ */
+
+#include <gtest/gtest.h>
+#include <friture/sliding_dft.hpp>
+#include <friture/fft_processor.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr size_t FFT_SIZE = 256;
+constexpr size_t NUM_BINS = FFT_SIZE / 2 + 1;
+constexpr float SAMPLE_RATE = 8000.0f;
+
+// Two tones plus a little noise, long enough for many hops
+std::vector<float> testSignal(size_t count) {
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        float t = static_cast<float>(i) / SAMPLE_RATE;
+        samples[i] = 0.5f * std::sin(2.0f * 3.14159265f * 440.0f * t) +
+                     0.2f * std::sin(2.0f * 3.14159265f * 1234.5f * t) + noise(rng);
+    }
+    return samples;
+}
+
+std::vector<uint32_t> allBins() {
+    std::vector<uint32_t> bins(NUM_BINS);
+    for (size_t k = 0; k < NUM_BINS; ++k) {
+        bins[k] = static_cast<uint32_t>(k);
+    }
+    return bins;
+}
+
+void expectMatchesFFT(WindowFunction window, size_t hop) {
+    SlidingDFT sliding(FFT_SIZE, window, hop, allBins());
+
+    FFTProcessor reference(FFT_SIZE, window);
+    reference.setExactLog10(true);
+
+    std::vector<float> signal = testSignal(FFT_SIZE + 300 * hop);
+    std::vector<float> actual(NUM_BINS);
+    std::vector<float> expected(NUM_BINS);
+    for (size_t c = 0; c <= 300; ++c) {
+        const float* frame = signal.data() + c * hop;
+        sliding.process(frame, actual.data());
+        if (c % 50 != 0) {
+            continue;
+        }
+        reference.process(frame, expected.data());
+        for (size_t k = 0; k < NUM_BINS; ++k) {
+            EXPECT_NEAR(actual[k], expected[k], 0.02f) << "column " << c << " bin " << k;
+        }
+    }
+    EXPECT_EQ(sliding.getReseedCount(), 1u);
+}
+
+} // namespace
+
+// ============================================================================
+// Construction Tests
+// ============================================================================
+
+TEST(SlidingDFTTest, RejectsInvalidParameters) {
+    const WindowFunction hann = WindowFunction::Hann;
+    EXPECT_THROW(SlidingDFT(1000, hann, 4, allBins()), std::invalid_argument);
+    EXPECT_THROW(SlidingDFT(FFT_SIZE, hann, 0, allBins()), std::invalid_argument);
+    EXPECT_THROW(SlidingDFT(FFT_SIZE, hann, FFT_SIZE + 1, allBins()), std::invalid_argument);
+    EXPECT_THROW(SlidingDFT(FFT_SIZE, hann, 4, {static_cast<uint32_t>(NUM_BINS)}),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(SlidingDFT(FFT_SIZE, hann, FFT_SIZE, allBins()));
+
+    // Duplicates collapse
+    SlidingDFT sliding(FFT_SIZE, hann, 4, {10, 3, 10, 128});
+    EXPECT_EQ(sliding.getDisplayedBinCount(), 3u);
+}
+
+TEST(SlidingDFTTest, DisplayedBinsFollowAggregation) {
+    // Wide rows: interpolation reads two taps, mean power every bin of the band
+    FrequencyResampler interp(FrequencyScale::Linear, 100.0f, 4000.0f, SAMPLE_RATE,
+                              FFT_SIZE, 16, BinAggregation::Interpolate);
+    FrequencyResampler mean(FrequencyScale::Linear, 100.0f, 4000.0f, SAMPLE_RATE,
+                            FFT_SIZE, 16, BinAggregation::MeanPower);
+
+    std::vector<uint32_t> interp_bins = SlidingDFT::displayedBins(interp, NUM_BINS);
+    std::vector<uint32_t> mean_bins = SlidingDFT::displayedBins(mean, NUM_BINS);
+    EXPECT_LE(interp_bins.size(), 32u);
+    EXPECT_GT(mean_bins.size(), 100u);
+    EXPECT_TRUE(std::is_sorted(mean_bins.begin(), mean_bins.end()));
+    EXPECT_TRUE(std::adjacent_find(mean_bins.begin(), mean_bins.end()) == mean_bins.end());
+    EXPECT_LT(mean_bins.back(), NUM_BINS);
+}
+
+// ============================================================================
+// Accuracy Tests
+// ============================================================================
+
+TEST(SlidingDFTTest, MatchesFFTProcessorHann) {
+    expectMatchesFFT(WindowFunction::Hann, 3);
+}
+
+TEST(SlidingDFTTest, MatchesFFTProcessorHamming) {
+    expectMatchesFFT(WindowFunction::Hamming, 8);
+}
+
+TEST(SlidingDFTTest, UndisplayedBinsAtFloor) {
+    SlidingDFT sliding(FFT_SIZE, WindowFunction::Hann, 2, {14});
+
+    std::vector<float> signal = testSignal(FFT_SIZE);
+    std::vector<float> output(NUM_BINS, 0.0f);
+    sliding.process(signal.data(), output.data());
+
+    EXPECT_GT(output[14], -60.0f);    // 440 Hz is bin 14.08
+    EXPECT_FLOAT_EQ(output[40], -300.0f);
+}
+
+// ============================================================================
+// Reseed Tests
+// ============================================================================
+
+TEST(SlidingDFTTest, GapReseeds) {
+    const size_t hop = 4;
+    SlidingDFT sliding(FFT_SIZE, WindowFunction::Hann, hop, allBins());
+    FFTProcessor reference(FFT_SIZE, WindowFunction::Hann);
+    reference.setExactLog10(true);
+
+    std::vector<float> signal = testSignal(FFT_SIZE + 40 * hop);
+    std::vector<float> actual(NUM_BINS);
+    std::vector<float> expected(NUM_BINS);
+
+    sliding.process(signal.data(), actual.data());
+    sliding.process(signal.data() + hop, actual.data());
+    EXPECT_EQ(sliding.getReseedCount(), 1u);
+
+    // Skip ahead (dropped columns): detected from the frame contents
+    sliding.process(signal.data() + 10 * hop, actual.data());
+    EXPECT_EQ(sliding.getReseedCount(), 2u);
+    reference.process(signal.data() + 10 * hop, expected.data());
+    for (size_t k = 0; k < NUM_BINS; ++k) {
+        EXPECT_NEAR(actual[k], expected[k], 0.02f) << "bin " << k;
+    }
+
+    sliding.reset();
+    sliding.process(signal.data() + 11 * hop, actual.data());
+    EXPECT_EQ(sliding.getReseedCount(), 3u);
+}
+
+TEST(SlidingDFTTest, PeriodicReseed) {
+    // Every RESEED_FRAMES frame lengths of input
+    const size_t fft_size = 32;
+    const size_t hop = 2;
+    const size_t interval = SlidingDFT::RESEED_FRAMES * fft_size / hop;
+    SlidingDFT sliding(fft_size, WindowFunction::Hann, hop, {3, 4, 5});
+
+    std::vector<float> signal = testSignal(fft_size + (interval + 10) * hop);
+    std::vector<float> output(fft_size / 2 + 1);
+    for (size_t c = 0; c <= interval; ++c) {
+        sliding.process(signal.data() + c * hop, output.data());
+    }
+    EXPECT_EQ(sliding.getReseedCount(), 2u);
+}
+
+// ============================================================================
+// Cost Model Tests
+// ============================================================================
+
+TEST(SlidingDFTTest, CheaperOnlyForSmallHops) {
+    // 4096-point FFT, a few hundred displayed bins
+    EXPECT_TRUE(SlidingDFT::isCheaper(4096, 8, 300));
+    EXPECT_FALSE(SlidingDFT::isCheaper(4096, 64, 300));
+    EXPECT_FALSE(SlidingDFT::isCheaper(4096, 1024, 300));
+    // Every bin: only single-sample hops pay off
+    EXPECT_TRUE(SlidingDFT::isCheaper(4096, 1, 2049));
+    EXPECT_FALSE(SlidingDFT::isCheaper(4096, 4, 2049));
+}
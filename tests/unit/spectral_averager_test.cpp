@@ -0,0 +1,185 @@
+/**
+ * @file spectral_averager_test.cpp
+ * @brief Unit tests for SpectralAverager
+ *
+ * Tests cover:
+ * - Invalid arguments
+ * - Pass-through and decimation (mean power of each column's inputs)
+ * - Exponential step response against the time constant
+ * - Linear N-frame mean in power, across ring laps
+ * - Peak-hold decay rate
+ * - Reset
+ */
+
+#include <gtest/gtest.h>
+#include <friture/spectral_averager.hpp>
+#include <friture/simd_kernels.hpp>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr size_t HOP = 480;              // 10 ms per input
+constexpr float TOLERANCE_DB = 1e-3f;    // dB <-> power round trip
+
+SpectralAverager::Options makeOptions(AveragingMode mode, float time, size_t frames,
+                                      size_t decimation) {
+    SpectralAverager::Options options;
+    options.mode = mode;
+    options.time_seconds = time;
+    options.frames = frames;
+    options.decimation = decimation;
+    return options;
+}
+
+float toDb(double power) {
+    return static_cast<float>(10.0 * std::log10(power));
+}
+
+} // namespace
+
+TEST(SpectralAveragerTest, InvalidArgumentsThrow) {
+    EXPECT_THROW(SpectralAverager(0, SAMPLE_RATE, HOP), std::invalid_argument);
+    EXPECT_THROW(SpectralAverager(8, 0.0f, HOP), std::invalid_argument);
+    EXPECT_THROW(SpectralAverager(8, SAMPLE_RATE, 0), std::invalid_argument);
+    EXPECT_THROW(SpectralAverager(8, SAMPLE_RATE, HOP, makeOptions(AveragingMode::Exponential, 0.0f, 8, 1)),
+                 std::invalid_argument);
+    EXPECT_THROW(SpectralAverager(8, SAMPLE_RATE, HOP, makeOptions(AveragingMode::Linear, 1.0f, 0, 1)),
+                 std::invalid_argument);
+    EXPECT_THROW(SpectralAverager(8, SAMPLE_RATE, HOP, makeOptions(AveragingMode::None, 1.0f, 8, 0)),
+                 std::invalid_argument);
+}
+
+TEST(SpectralAveragerTest, NoneWithoutDecimationPassesThrough) {
+    constexpr size_t SIZE = 37;
+    SpectralAverager averager(SIZE, SAMPLE_RATE, HOP, makeOptions(AveragingMode::None, 1.0f, 8, 1));
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> dist(-140.0f, 20.0f);
+    std::vector<float> input(SIZE), output(SIZE);
+    for (int hop = 0; hop < 3; ++hop) {
+        for (float& v : input) {
+            v = dist(rng);
+        }
+        ASSERT_TRUE(averager.process(input.data(), output.data()));
+        for (size_t i = 0; i < SIZE; ++i) {
+            ASSERT_NEAR(output[i], input[i], TOLERANCE_DB);
+        }
+    }
+}
+
+TEST(SpectralAveragerTest, DecimationAveragesEachColumnsInputs) {
+    SpectralAverager averager(1, SAMPLE_RATE, HOP, makeOptions(AveragingMode::None, 1.0f, 8, 3));
+
+    // Columns of (0, 10, -100) and (-10, -10, -10) dB
+    const float levels[] = {0.0f, 10.0f, -100.0f, -10.0f, -10.0f, -10.0f};
+    float output = 0.0f;
+    int outputs = 0;
+    for (size_t hop = 0; hop < 6; ++hop) {
+        const bool due = averager.process(&levels[hop], &output);
+        EXPECT_EQ(due, hop % 3 == 2) << "hop " << hop;
+        if (due) {
+            ++outputs;
+            const float expected = hop == 2 ? toDb((1.0 + 10.0 + 1e-10) / 3.0) : -10.0f;
+            EXPECT_NEAR(output, expected, TOLERANCE_DB) << "hop " << hop;
+        }
+    }
+    EXPECT_EQ(outputs, 2);
+}
+
+TEST(SpectralAveragerTest, ExponentialFollowsTimeConstant) {
+    constexpr float TAU = 0.5f;
+    SpectralAverager averager(4, SAMPLE_RATE, HOP, makeOptions(AveragingMode::Exponential, TAU, 8, 1));
+
+    // Seeded at -60 dB, then a step to 0 dB for one time constant
+    std::vector<float> quiet(4, -60.0f), loud(4, 0.0f), output(4);
+    ASSERT_TRUE(averager.process(quiet.data(), output.data()));
+    EXPECT_NEAR(output[0], -60.0f, TOLERANCE_DB);
+
+    const size_t hops = static_cast<size_t>(TAU * SAMPLE_RATE / HOP);   // 50
+    for (size_t h = 0; h < hops; ++h) {
+        averager.process(loud.data(), output.data());
+    }
+    const double remaining = std::exp(-1.0);
+    EXPECT_NEAR(output[3], toDb(1.0 - remaining + remaining * 1e-6), 0.01f);
+}
+
+TEST(SpectralAveragerTest, LinearIsPowerMeanOfLastFrames) {
+    constexpr size_t SIZE = 19;
+    constexpr size_t FRAMES = 5;
+    SpectralAverager averager(SIZE, SAMPLE_RATE, HOP, makeOptions(AveragingMode::Linear, 1.0f, FRAMES, 1));
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-90.0f, 10.0f);
+    std::vector<std::vector<float>> history;
+    std::vector<float> output(SIZE);
+
+    // Filling, then many laps of the ring
+    for (size_t hop = 0; hop < 12 * FRAMES + 3; ++hop) {
+        std::vector<float> input(SIZE);
+        for (float& v : input) {
+            v = dist(rng);
+        }
+        history.push_back(input);
+        ASSERT_TRUE(averager.process(input.data(), output.data()));
+
+        const size_t count = std::min(history.size(), FRAMES);
+        for (size_t i = 0; i < SIZE; ++i) {
+            double sum = 0.0;
+            for (size_t f = history.size() - count; f < history.size(); ++f) {
+                sum += std::pow(10.0, history[f][i] / 10.0);
+            }
+            ASSERT_NEAR(output[i], toDb(sum / static_cast<double>(count)), 0.01f)
+                << "hop " << hop << " value " << i;
+        }
+    }
+
+    // Averages power, not dB: 0 and -100 dB alternating give -3 dB
+    SpectralAverager pair(1, SAMPLE_RATE, HOP, makeOptions(AveragingMode::Linear, 1.0f, 2, 2));
+    const float levels[] = {0.0f, -100.0f};
+    float mean = 0.0f;
+    pair.process(&levels[0], &mean);
+    ASSERT_TRUE(pair.process(&levels[1], &mean));
+    EXPECT_NEAR(mean, toDb(0.5), 0.01f);
+}
+
+TEST(SpectralAveragerTest, PeakHoldDecaysAtTimeConstantRate) {
+    constexpr float TAU = 0.25f;
+    SpectralAverager averager(1, SAMPLE_RATE, HOP, makeOptions(AveragingMode::PeakHold, TAU, 8, 1));
+
+    const float peak = -20.0f;
+    const float quiet = -120.0f;
+    float output = 0.0f;
+    ASSERT_TRUE(averager.process(&peak, &output));
+    EXPECT_NEAR(output, peak, TOLERANCE_DB);
+
+    // 0.1 s after the peak: 4.34 dB / τ per second
+    for (int h = 0; h < 10; ++h) {
+        averager.process(&quiet, &output);
+    }
+    EXPECT_NEAR(output, peak - 10.0f * std::log10(std::exp(1.0f)) * 0.1f / TAU, 0.01f);
+
+    // A louder input takes over at once
+    const float louder = -5.0f;
+    averager.process(&louder, &output);
+    EXPECT_NEAR(output, louder, TOLERANCE_DB);
+}
+
+TEST(SpectralAveragerTest, ResetStartsNewAverage) {
+    SpectralAverager averager(2, SAMPLE_RATE, HOP, makeOptions(AveragingMode::Linear, 1.0f, 4, 2));
+
+    std::vector<float> loud(2, 0.0f), quiet(2, -40.0f), output(2);
+    averager.process(loud.data(), output.data());
+    averager.reset();
+
+    // The pending input and the loud frame are gone
+    EXPECT_FALSE(averager.process(quiet.data(), output.data()));
+    ASSERT_TRUE(averager.process(quiet.data(), output.data()));
+    EXPECT_NEAR(output[0], -40.0f, TOLERANCE_DB);
+    EXPECT_NEAR(output[1], -40.0f, TOLERANCE_DB);
+}
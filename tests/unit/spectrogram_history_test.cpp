@@ -0,0 +1,376 @@
+/**
+ * @file spectrogram_history_test.cpp
+ * @brief Unit tests for SpectrogramHistory
+ *
+ * Tests cover:
+ * - Configuration validation and memory budget
+ * - Max-pooling cascade between levels
+ * - O(1) level selection by zoom and age
+ * - Rendering windows: full resolution, zoomed out, past the level 0 ring,
+ *   newest columns not yet pooled
+ * - 8-bit precision
+ * - Resizing rows: time kept, budget kept, parallel rescale
+ */
+
+#include <gtest/gtest.h>
+#include <friture/spectrogram_history.hpp>
+#include <friture/task_pool.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr size_t HEIGHT = 4;
+
+// 4 levels × 4 rows × 2 bytes × 32 columns
+SpectrogramHistoryConfig smallConfig() {
+    SpectrogramHistoryConfig config;
+    config.height = HEIGHT;
+    config.factors = {1, 2, 4, 16};
+    config.memory_bytes = 4 * HEIGHT * 2 * 32;
+    return config;
+}
+
+// Column t has level t in every row (easy to check pooling)
+void appendRamp(SpectrogramHistory& history, uint64_t count) {
+    for (uint64_t t = 0; t < count; ++t) {
+        uint16_t level = static_cast<uint16_t>(history.getColumnCount() + 1);
+        std::vector<uint16_t> column(HEIGHT, level);
+        history.appendLevels(column.data(), HEIGHT);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Configuration Tests
+// ============================================================================
+
+TEST(SpectrogramHistoryTest, RejectsInvalidConfig) {
+    SpectrogramHistoryConfig config = smallConfig();
+    config.height = 0;
+    EXPECT_THROW(SpectrogramHistory{config}, std::invalid_argument);
+
+    config = smallConfig();
+    config.factors = {2, 4};
+    EXPECT_THROW(SpectrogramHistory{config}, std::invalid_argument);
+
+    config = smallConfig();
+    config.factors = {1, 3};
+    EXPECT_THROW(SpectrogramHistory{config}, std::invalid_argument);
+
+    config = smallConfig();
+    config.factors = {1, 4, 2};
+    EXPECT_THROW(SpectrogramHistory{config}, std::invalid_argument);
+
+    config = smallConfig();
+    config.memory_bytes = 4 * HEIGHT * 2 * 8;   // 8 columns < coarsest factor 16
+    EXPECT_THROW(SpectrogramHistory{config}, std::invalid_argument);
+
+    EXPECT_NO_THROW(SpectrogramHistory{smallConfig()});
+}
+
+TEST(SpectrogramHistoryTest, MemoryStaysWithinBudget) {
+    SpectrogramHistoryConfig config;
+    config.height = 512;
+    config.memory_bytes = size_t{16} << 20;
+    SpectrogramHistory history(config);
+
+    EXPECT_EQ(history.getLevelCount(), 4u);
+    EXPECT_EQ(history.getLevelCapacity(), (size_t{16} << 20) / (4 * 512 * 2));
+    EXPECT_LE(history.getMemoryUsage(), config.memory_bytes + 8 * 512 * sizeof(uint16_t));
+
+    // Appending never allocates more
+    std::vector<float> column(512, -60.0f);
+    size_t before = history.getMemoryUsage();
+    for (int i = 0; i < 20000; ++i) {
+        history.append(column.data(), 512);
+    }
+    EXPECT_EQ(history.getMemoryUsage(), before);
+
+    // Half the bytes per sample, twice the columns
+    config.precision = HistoryPrecision::Level8;
+    SpectrogramHistory compact(config);
+    EXPECT_EQ(compact.getLevelCapacity(), 2 * history.getLevelCapacity());
+}
+
+// ============================================================================
+// Pooling Tests
+// ============================================================================
+
+TEST(SpectrogramHistoryTest, LevelsMaxPool) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 16);
+
+    // Ramp: pooled columns are the newest (largest) of their pool
+    std::vector<uint16_t> out(HEIGHT);
+    history.render(0, 16, 1, out.data());   // 16 columns per pixel: level 3
+    EXPECT_EQ(out[0], 16u);
+
+    std::vector<uint16_t> halves(2 * HEIGHT);
+    EXPECT_EQ(history.render(0, 16, 2, halves.data()), 2u);   // 8 per pixel: level 2 (4×)
+    EXPECT_EQ(halves[0], 8u);
+    EXPECT_EQ(halves[HEIGHT], 16u);
+
+    // A single loud column survives every zoom level
+    SpectrogramHistory spiky(smallConfig());
+    std::vector<uint16_t> quiet(HEIGHT, 100);
+    std::vector<uint16_t> loud(HEIGHT, 60000);
+    for (int t = 0; t < 64; ++t) {
+        spiky.appendLevels(t == 37 ? loud.data() : quiet.data(), HEIGHT);
+    }
+    std::vector<uint16_t> overview(4 * HEIGHT);
+    EXPECT_EQ(spiky.render(0, 64, 4, overview.data()), 3u);
+    EXPECT_EQ(overview[0], 100u);
+    EXPECT_EQ(overview[2 * HEIGHT], 60000u);   // Columns 32..47
+    EXPECT_EQ(overview[3 * HEIGHT], 100u);
+}
+
+TEST(SpectrogramHistoryTest, AppendDbQuantizes) {
+    SpectrogramHistory history(smallConfig());
+    std::vector<float> column = {-120.0f, -60.0f, -6.0f, 0.0f};
+    history.append(column.data(), HEIGHT);
+    EXPECT_EQ(history.getColumnCount(), 1u);
+
+    std::vector<uint16_t> out(HEIGHT);
+    history.render(0, 1, 1, out.data());
+    for (size_t i = 0; i < HEIGHT; ++i) {
+        EXPECT_NEAR(levelToDb(out[i]), column[i], 0.01f);
+    }
+
+    // Wrong height is ignored
+    history.append(column.data(), HEIGHT - 1);
+    EXPECT_EQ(history.getColumnCount(), 1u);
+}
+
+// ============================================================================
+// Level Selection Tests
+// ============================================================================
+
+TEST(SpectrogramHistoryTest, SelectLevelByZoom) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 16);
+
+    EXPECT_EQ(history.selectLevel(0, 0.25), 0u);
+    EXPECT_EQ(history.selectLevel(0, 1.0), 0u);
+    EXPECT_EQ(history.selectLevel(0, 1.9), 0u);
+    EXPECT_EQ(history.selectLevel(0, 2.0), 1u);
+    EXPECT_EQ(history.selectLevel(0, 3.5), 1u);
+    EXPECT_EQ(history.selectLevel(0, 4.0), 2u);
+    EXPECT_EQ(history.selectLevel(0, 15.9), 2u);
+    EXPECT_EQ(history.selectLevel(0, 16.0), 3u);
+    EXPECT_EQ(history.selectLevel(0, 1e12), 3u);
+}
+
+TEST(SpectrogramHistoryTest, SelectLevelByAge) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 200);   // Level 0 keeps 168..199, level 1 136..199, level 2 72..199
+
+    EXPECT_EQ(history.getLevelOldest(0), 168u);
+    EXPECT_EQ(history.getLevelOldest(1), 136u);
+    EXPECT_EQ(history.getLevelOldest(2), 72u);
+    EXPECT_EQ(history.getOldestColumn(), 0u);   // Level 3: 32 × 16 columns
+
+    EXPECT_EQ(history.selectLevel(180, 1.0), 0u);
+    EXPECT_EQ(history.selectLevel(150, 1.0), 1u);
+    EXPECT_EQ(history.selectLevel(100, 1.0), 2u);
+    EXPECT_EQ(history.selectLevel(10, 1.0), 3u);
+}
+
+// ============================================================================
+// Rendering Tests
+// ============================================================================
+
+TEST(SpectrogramHistoryTest, RenderFullResolution) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 20);
+
+    std::vector<uint16_t> out(10 * HEIGHT);
+    EXPECT_EQ(history.render(5, 10, 10, out.data()), 0u);
+    for (size_t x = 0; x < 10; ++x) {
+        for (size_t r = 0; r < HEIGHT; ++r) {
+            EXPECT_EQ(out[x * HEIGHT + r], 6 + x);
+        }
+    }
+
+    // Zoomed in: each column drawn twice
+    std::vector<uint16_t> zoomed(4 * HEIGHT);
+    history.render(10, 2, 4, zoomed.data());
+    EXPECT_EQ(zoomed[0], 11u);
+    EXPECT_EQ(zoomed[HEIGHT], 11u);
+    EXPECT_EQ(zoomed[2 * HEIGHT], 12u);
+    EXPECT_EQ(zoomed[3 * HEIGHT], 12u);
+}
+
+TEST(SpectrogramHistoryTest, RenderBeyondRetainedHistoryIsSilent) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 10);
+
+    // Window extends past the newest column
+    std::vector<uint16_t> out(4 * HEIGHT);
+    history.render(8, 4, 4, out.data());
+    EXPECT_EQ(out[0], 9u);
+    EXPECT_EQ(out[HEIGHT], 10u);
+    EXPECT_EQ(out[2 * HEIGHT], 0u);
+    EXPECT_EQ(out[3 * HEIGHT], 0u);
+
+    // Older than the coarsest ring (32 × 16 columns)
+    appendRamp(history, 1000);
+    std::vector<uint16_t> old(HEIGHT);
+    history.render(0, 4, 1, old.data());
+    EXPECT_EQ(old[0], 0u);
+}
+
+TEST(SpectrogramHistoryTest, RenderOldHistoryFromCoarseLevel) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 400);   // Level 0 only keeps the last 32
+
+    // Columns 64..79 at full zoom come from the 16× level: one pooled value
+    std::vector<uint16_t> out(16 * HEIGHT);
+    EXPECT_EQ(history.render(64, 16, 16, out.data()), 3u);
+    for (size_t x = 0; x < 16; ++x) {
+        EXPECT_EQ(out[x * HEIGHT], 80u);
+    }
+}
+
+TEST(SpectrogramHistoryTest, NewestColumnsFilledFromFinerLevels) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 70);   // Level 3 has pooled 64 columns; 64..69 are still pooling
+
+    // One pixel over the last 16 columns: level 3 only holds up to 63
+    std::vector<uint16_t> out(HEIGHT);
+    history.render(54, 16, 1, out.data());
+    EXPECT_EQ(out[0], 70u);
+}
+
+TEST(SpectrogramHistoryTest, Level8Precision) {
+    SpectrogramHistoryConfig config = smallConfig();
+    config.precision = HistoryPrecision::Level8;
+    SpectrogramHistory history(config);
+
+    std::vector<float> column = {-150.0f, -80.5f, -20.25f, 3.0f};
+    for (int i = 0; i < 40; ++i) {
+        history.append(column.data(), HEIGHT);
+    }
+
+    const float step_db = (LEVEL_MAX_DB - LEVEL_MIN_DB) / 256.0f;
+    std::vector<uint16_t> out(2 * HEIGHT);
+    history.render(0, 40, 2, out.data());   // Pooled levels
+    for (size_t x = 0; x < 2; ++x) {
+        for (size_t i = 0; i < HEIGHT; ++i) {
+            EXPECT_NEAR(levelToDb(out[x * HEIGHT + i]), column[i], step_db / 2.0f + 0.01f);
+        }
+    }
+}
+
+TEST(SpectrogramHistoryTest, ClearRestartsTime) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 50);
+    history.clear();
+    EXPECT_EQ(history.getColumnCount(), 0u);
+
+    appendRamp(history, 3);
+    std::vector<uint16_t> out(4 * HEIGHT);
+    history.render(0, 4, 4, out.data());
+    EXPECT_EQ(out[0], 1u);
+    EXPECT_EQ(out[2 * HEIGHT], 3u);
+    EXPECT_EQ(out[3 * HEIGHT], 0u);   // Old data past the new end is not shown
+}
+
+// ============================================================================
+// Resize Tests
+// ============================================================================
+
+TEST(SpectrogramHistoryTest, ResizeKeepsTimeWithinBudget) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 20);
+
+    // Twice the rows in the same memory: each level keeps 16 columns
+    history.resize(2 * HEIGHT);
+    EXPECT_EQ(history.getHeight(), 2 * HEIGHT);
+    EXPECT_EQ(history.getLevelCapacity(), 16u);
+    EXPECT_EQ(history.getColumnCount(), 20u);
+    EXPECT_EQ(history.getLevelOldest(0), 4u);
+    // Levels within the budget, plus pools and scratch of the new height
+    EXPECT_LE(history.getMemoryUsage(), smallConfig().memory_bytes + 4 * 2 * HEIGHT * sizeof(uint16_t));
+
+    std::vector<uint16_t> out(2 * 2 * HEIGHT);
+    history.render(18, 2, 2, out.data());
+    EXPECT_EQ(out[0], 19u);
+    EXPECT_EQ(out[2 * HEIGHT - 1], 19u);
+    EXPECT_EQ(out[2 * HEIGHT], 20u);
+
+    // Appending continues at the new height, pools included
+    std::vector<uint16_t> column(2 * HEIGHT, 21);
+    history.appendLevels(column.data(), 2 * HEIGHT);
+    history.render(0, 32, 2, out.data());
+    EXPECT_EQ(out[2 * HEIGHT], 21u);
+
+    // Back down: the 16 kept columns still fit
+    history.resize(HEIGHT);
+    EXPECT_EQ(history.getLevelOldest(0), 5u);
+    history.render(20, 1, 1, out.data());
+    EXPECT_EQ(out[0], 21u);
+}
+
+TEST(SpectrogramHistoryTest, ResizeRescalesRows) {
+    SpectrogramHistoryConfig config = smallConfig();
+    config.height = 2;
+    SpectrogramHistory history(config);
+    const uint16_t column[2] = {1000, 2000};
+    history.appendLevels(column, 2);
+
+    // Interpolated up, max-pooled back down
+    history.resize(4);
+    std::vector<uint16_t> out(4);
+    history.render(0, 1, 1, out.data());
+    EXPECT_EQ(out, (std::vector<uint16_t>{1000, 1250, 1750, 2000}));
+
+    history.resize(2);
+    history.render(0, 1, 1, out.data());
+    EXPECT_EQ(out[0], 1250u);
+    EXPECT_EQ(out[1], 2000u);
+}
+
+TEST(SpectrogramHistoryTest, ResizeRejectsTooSmallBudget) {
+    SpectrogramHistory history(smallConfig());
+    appendRamp(history, 5);
+
+    // 1 KB over 4 levels at 9 rows leaves 14 columns, fewer than 16
+    EXPECT_THROW(history.resize(9), std::invalid_argument);
+    EXPECT_THROW(history.resize(0), std::invalid_argument);
+    EXPECT_EQ(history.getHeight(), HEIGHT);
+    EXPECT_EQ(history.getColumnCount(), 5u);
+}
+
+TEST(SpectrogramHistoryTest, ResizeParallelMatchesSerial) {
+    for (HistoryPrecision precision : {HistoryPrecision::Level16, HistoryPrecision::Level8}) {
+        SpectrogramHistoryConfig config;
+        config.height = 50;
+        config.memory_bytes = size_t{1} << 20;
+        config.precision = precision;
+        SpectrogramHistory serial(config);
+        SpectrogramHistory parallel(config);
+
+        std::vector<uint16_t> column(50);
+        for (size_t c = 0; c < 5000; ++c) {
+            for (size_t r = 0; r < 50; ++r) {
+                column[r] = static_cast<uint16_t>((c * 131 + r * 977) % 65536);
+            }
+            serial.appendLevels(column.data(), 50);
+            parallel.appendLevels(column.data(), 50);
+        }
+
+        TaskPool pool(4);
+        serial.resize(77);
+        parallel.resize(77, &pool);
+
+        std::vector<uint16_t> a(300 * 77), b(300 * 77);
+        serial.render(0, 5000, 300, a.data());
+        parallel.render(0, 5000, 300, b.data());
+        EXPECT_EQ(a, b);
+    }
+}
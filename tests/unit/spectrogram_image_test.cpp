@@ -4,11 +4,17 @@
  */
 
 #include <friture/spectrogram_image.hpp>
+#include <friture/task_pool.hpp>
 #include <gtest/gtest.h>
 #include <vector>
+#include <array>
 #include <cstdint>
 #include <fstream>
 #include <chrono>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
 
 using namespace friture;
 
@@ -167,17 +173,16 @@ TEST(SpectrogramImageTest, WrapAroundAt2xWidth) {
 
     // After 10 columns with width=5:
     // - write_offset wraps to 0
-    // - read_offset should show the 5 most recent columns (5-9), so read_offset = 5
+    // - columns 5-9 are at positions 5-9 and mirrored at 0-4, so read_offset = 0
     EXPECT_EQ(image.getWriteOffset(), 0u); // Wrapped around
-    EXPECT_EQ(image.getReadOffset(), 5u);  // Showing columns 5-9
+    EXPECT_EQ(image.getReadOffset(), 0u);  // Showing columns 5-9 (mirrors)
 
-    // Add one more (11th column) at position 0
+    // Add one more (11th column) at position 0 (mirror at 5)
     // - write_offset advances to 1
-    // - read_offset should show columns 6-10, which are at positions 6-9,0
-    // - So read_offset = 6
+    // - columns 6-10 are contiguous at positions 1-5
     image.addColumn(column.data(), 3);
     EXPECT_EQ(image.getWriteOffset(), 1u);
-    EXPECT_EQ(image.getReadOffset(), 6u);
+    EXPECT_EQ(image.getReadOffset(), 1u);
 }
 
 TEST(SpectrogramImageTest, ContinuousWrapping) {
@@ -197,12 +202,17 @@ TEST(SpectrogramImageTest, ContinuousWrapping) {
     // - write_offset = 20 % 6 = 2
     // - We're showing columns 17-19 (the 3 most recent)
     // - These are at buffer positions (17%6=5), (18%6=0), (19%6=1)
-    // - So read_offset should trail write_offset by width:
-    //   read_offset = (2 + 6 - 3) % 6 = 5
+    //   and mirrored at 2, 3, 4
+    // - So the contiguous window starts at read_offset = 17 % 3 = 2
     EXPECT_EQ(image.getWriteOffset(), 2u);
+    EXPECT_EQ(image.getReadOffset(), 2u);
 
-    // Since write_offset (2) < width (3), we use: read_offset = write_offset + width = 2 + 3 = 5
-    EXPECT_EQ(image.getReadOffset(), 5u);
+    // Visible window holds columns 17, 18, 19 in order without wrapping
+    const uint32_t* visible = image.getVisibleData();
+    for (size_t x = 0; x < 3; ++x) {
+        EXPECT_EQ(visible[x * 2], 17u + x);
+        EXPECT_EQ(visible[x * 2 + 1], 117u + x);
+    }
 }
 
 // ============================================================================
@@ -442,6 +452,547 @@ TEST(SpectrogramImageTest, WideShortImage) {
     EXPECT_EQ(image.getWriteOffset(), 10u);
 }
 
+// ============================================================================
+// Row-Major Layout and Dirty Column Tests
+// ============================================================================
+
+namespace {
+
+// Paint a texture ring (width × height, row-major) the way renderFrame does
+void uploadDirty(SpectrogramImage& image, std::vector<uint32_t>& texture) {
+    const size_t width = image.getWidth();
+    const size_t pitch = image.getRowPitch();
+    ColumnSpan spans[2];
+    size_t n = image.getDirtySpans(spans);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t row = 0; row < image.getHeight(); ++row) {
+            for (size_t c = 0; c < spans[i].count; ++c) {
+                texture[row * width + spans[i].texture_column + c] =
+                    image.getPixelData()[row * pitch + spans[i].image_column + c];
+            }
+        }
+    }
+    image.clearDirty();
+}
+
+} // namespace
+
+TEST(SpectrogramImageTest, RowMajorLayout) {
+    SpectrogramImage image(4, 3, ImageLayout::RowMajor);
+    EXPECT_EQ(image.getLayout(), ImageLayout::RowMajor);
+    EXPECT_EQ(image.getRowPitch(), 8u);
+
+    std::vector<uint32_t> column = {10, 11, 12};
+    image.addColumn(column.data(), 3);
+    column = {20, 21, 22};
+    image.addColumn(column.data(), 3);
+
+    const uint32_t* pixels = image.getPixelData();
+    EXPECT_EQ(pixels[0 * 8 + 0], 10u);
+    EXPECT_EQ(pixels[1 * 8 + 0], 11u);
+    EXPECT_EQ(pixels[2 * 8 + 1], 22u);
+    EXPECT_EQ(pixels[image.getPixelIndex(1, 1)], 21u);
+}
+
+TEST(SpectrogramImageTest, DirtySpansInitialAndIncremental) {
+    SpectrogramImage image(5, 2, ImageLayout::RowMajor);
+    ColumnSpan spans[2];
+
+    // Fresh image: whole window needs one upload
+    ASSERT_EQ(image.getDirtySpans(spans), 1u);
+    EXPECT_EQ(spans[0].texture_column, 0u);
+    EXPECT_EQ(spans[0].count, 5u);
+    image.clearDirty();
+    EXPECT_EQ(image.getDirtySpans(spans), 0u);
+
+    std::vector<uint32_t> column(2, 1);
+    image.addColumn(column.data(), 2);
+    image.addColumn(column.data(), 2);
+
+    ASSERT_EQ(image.getDirtySpans(spans), 1u);
+    EXPECT_EQ(spans[0].image_column, 0u);
+    EXPECT_EQ(spans[0].texture_column, 0u);
+    EXPECT_EQ(spans[0].count, 2u);
+}
+
+TEST(SpectrogramImageTest, IsDirtyTracksNewColumns) {
+    SpectrogramImage image(5, 2, ImageLayout::RowMajor);
+    EXPECT_TRUE(image.isDirty());
+    image.clearDirty();
+    EXPECT_FALSE(image.isDirty());
+
+    std::vector<uint32_t> column(2, 1);
+    image.addColumn(column.data(), 2);
+    EXPECT_TRUE(image.isDirty());
+    image.clearDirty();
+    EXPECT_FALSE(image.isDirty());
+
+    // A screenful behind, and clear(), are dirty as well
+    for (int i = 0; i < 7; ++i) {
+        image.addColumn(column.data(), 2);
+    }
+    EXPECT_TRUE(image.isDirty());
+    image.clearDirty();
+    image.clear();
+    EXPECT_TRUE(image.isDirty());
+}
+
+TEST(SpectrogramImageTest, DirtySpansSplitAtSeam) {
+    SpectrogramImage image(5, 2, ImageLayout::RowMajor);
+    std::vector<uint32_t> column(2, 1);
+    ColumnSpan spans[2];
+
+    for (int i = 0; i < 4; ++i) {
+        image.addColumn(column.data(), 2);
+    }
+    image.clearDirty();
+
+    // Columns 4, 5, 6: texture ring wraps after column 4
+    for (int i = 0; i < 3; ++i) {
+        image.addColumn(column.data(), 2);
+    }
+    ASSERT_EQ(image.getDirtySpans(spans), 2u);
+    EXPECT_EQ(spans[0].image_column, 4u);
+    EXPECT_EQ(spans[0].texture_column, 4u);
+    EXPECT_EQ(spans[0].count, 1u);
+    EXPECT_EQ(spans[1].image_column, 0u);  // mirror of column 5
+    EXPECT_EQ(spans[1].texture_column, 0u);
+    EXPECT_EQ(spans[1].count, 2u);
+    EXPECT_EQ(image.getTextureSeam(), 2u);
+}
+
+TEST(SpectrogramImageTest, DirtySpansCappedAtWidth) {
+    SpectrogramImage image(5, 2, ImageLayout::RowMajor);
+    std::vector<uint32_t> column(2, 1);
+    ColumnSpan spans[2];
+    image.clearDirty();
+
+    for (int i = 0; i < 23; ++i) {
+        image.addColumn(column.data(), 2);
+    }
+
+    size_t n = image.getDirtySpans(spans);
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        total += spans[i].count;
+    }
+    EXPECT_EQ(total, 5u);
+}
+
+TEST(SpectrogramImageTest, TextureRingMatchesVisibleWindow) {
+    const size_t width = 7;
+    const size_t height = 3;
+    SpectrogramImage image(width, height, ImageLayout::RowMajor);
+    std::vector<uint32_t> texture(width * height, 0xDEADBEEF);
+    std::vector<uint32_t> column(height);
+
+    // Upload after an irregular number of columns each "frame"
+    uint32_t next = 1;
+    for (int frame = 0; frame < 40; ++frame) {
+        for (int k = 0; k < frame % 4; ++k) {
+            for (size_t row = 0; row < height; ++row) {
+                column[row] = next * 10 + static_cast<uint32_t>(row);
+            }
+            image.addColumn(column.data(), height);
+            ++next;
+        }
+        uploadDirty(image, texture);
+
+        // Reading the ring from the seam must give the newest columns in order
+        const uint64_t written = image.getColumnsWritten();
+        const size_t seam = image.getTextureSeam();
+        for (size_t x = 0; x < width; ++x) {
+            uint64_t col = (written >= width ? written - width : 0) + x;
+            for (size_t row = 0; row < height; ++row) {
+                uint32_t expected = col < written ? static_cast<uint32_t>((col + 1) * 10 + row) : 0u;
+                EXPECT_EQ(texture[row * width + (seam + x) % width], expected);
+            }
+        }
+    }
+}
+
+TEST(SpectrogramImageTest, RowMajorVisibleViewIsContiguous) {
+    const size_t width = 4;
+    SpectrogramImage image(width, 2, ImageLayout::RowMajor);
+    std::vector<uint32_t> column(2);
+
+    for (uint32_t n = 0; n < 27; ++n) {
+        column[0] = n;
+        column[1] = n + 1000;
+        image.addColumn(column.data(), 2);
+
+        if (n + 1 >= width) {
+            // Newest 'width' columns, oldest first, straight from the view
+            const uint32_t* visible = image.getVisibleData();
+            for (size_t x = 0; x < width; ++x) {
+                uint32_t expected = n + 1 - static_cast<uint32_t>(width) + static_cast<uint32_t>(x);
+                EXPECT_EQ(visible[x], expected);
+                EXPECT_EQ(visible[image.getRowPitch() + x], expected + 1000);
+            }
+        }
+    }
+}
+
+TEST(SpectrogramImageTest, FullUploadRebasesTexture) {
+    SpectrogramImage image(5, 2, ImageLayout::RowMajor);
+    std::vector<uint32_t> column(2, 1);
+    ColumnSpan spans[2];
+    image.clearDirty();
+
+    // A screenful behind: one span, the whole contiguous view
+    for (int i = 0; i < 13; ++i) {
+        image.addColumn(column.data(), 2);
+    }
+    ASSERT_EQ(image.getDirtySpans(spans), 1u);
+    EXPECT_EQ(spans[0].image_column, image.getReadOffset());
+    EXPECT_EQ(spans[0].texture_column, 0u);
+    EXPECT_EQ(spans[0].count, 5u);
+
+    image.clearDirty();
+    EXPECT_EQ(image.getTextureSeam(), 0u);
+
+    // Next column replaces the oldest, which now sits in texture column 0
+    image.addColumn(column.data(), 2);
+    ASSERT_EQ(image.getDirtySpans(spans), 1u);
+    EXPECT_EQ(spans[0].texture_column, 0u);
+    EXPECT_EQ(spans[0].count, 1u);
+    image.clearDirty();
+    EXPECT_EQ(image.getTextureSeam(), 1u);
+}
+
+TEST(SpectrogramImageTest, ClearMarksWindowDirty) {
+    SpectrogramImage image(5, 2, ImageLayout::RowMajor);
+    std::vector<uint32_t> column(2, 1);
+    for (int i = 0; i < 8; ++i) {
+        image.addColumn(column.data(), 2);
+    }
+    image.clearDirty();
+    image.clear();
+
+    ColumnSpan spans[2];
+    ASSERT_EQ(image.getDirtySpans(spans), 1u);
+    EXPECT_EQ(spans[0].count, 5u);
+    EXPECT_EQ(image.getTextureSeam(), 0u);
+}
+
+// ============================================================================
+// Level Plane Tests
+// ============================================================================
+
+TEST(SpectrogramImageTest, EncodeLevelsRoundTrip) {
+    const float step = (LEVEL_MAX_DB - LEVEL_MIN_DB) / 65535.0f;
+    std::vector<float> db = {-120.0f, -60.25f, -3.0f, 0.0f, 12.5f};
+    std::vector<uint16_t> levels(db.size());
+    SpectrogramImage::encodeLevels(db.data(), db.size(), levels.data());
+
+    for (size_t i = 0; i < db.size(); ++i) {
+        EXPECT_NEAR(levelToDb(levels[i]), db[i], step * 0.5f + 1e-4f) << "dB " << db[i];
+    }
+}
+
+TEST(SpectrogramImageTest, EncodeLevelsClampsAndHandlesNaN) {
+    std::vector<float> db = {-1000.0f, 1000.0f, std::nanf(""), LEVEL_MIN_DB, LEVEL_MAX_DB};
+    std::vector<uint16_t> levels(db.size());
+    SpectrogramImage::encodeLevels(db.data(), db.size(), levels.data());
+
+    EXPECT_EQ(levels[0], 0u);
+    EXPECT_EQ(levels[1], 65535u);
+    EXPECT_EQ(levels[2], 0u);
+    EXPECT_EQ(levels[3], 0u);
+    EXPECT_EQ(levels[4], 65535u);
+}
+
+TEST(SpectrogramImageTest, LevelPlaneStoresLevels) {
+    SpectrogramImage image(4, 3, ImageLayout::RowMajor, ImagePlane::Levels);
+    EXPECT_EQ(image.getPlane(), ImagePlane::Levels);
+    EXPECT_EQ(image.getTotalPixels(), 2u * 4u * 3u);
+    EXPECT_EQ(image.getMemoryUsage(), 2u * 4u * 3u * sizeof(uint16_t));
+
+    std::vector<uint16_t> column = {100, 200, 300};
+    image.addColumnLevels(column.data(), 3);
+
+    // Written at column 0 and its mirror at column 4 (rows 8 apart)
+    const uint16_t* levels = image.getLevelData();
+    for (size_t row = 0; row < 3; ++row) {
+        EXPECT_EQ(levels[image.getPixelIndex(0, row)], column[row]);
+        EXPECT_EQ(levels[image.getPixelIndex(4, row)], column[row]);
+    }
+    EXPECT_EQ(image.getColumnsWritten(), 1u);
+}
+
+TEST(SpectrogramImageTest, PlaneMismatchThrows) {
+    std::vector<uint32_t> colors(3, 0xFFFFFFFF);
+    std::vector<uint16_t> levels(3, 1);
+
+    SpectrogramImage color_image(4, 3);
+    EXPECT_THROW(color_image.addColumnLevels(levels.data(), 3), std::invalid_argument);
+
+    SpectrogramImage level_image(4, 3, ImageLayout::RowMajor, ImagePlane::Levels);
+    EXPECT_THROW(level_image.addColumn(colors.data(), 3), std::invalid_argument);
+    EXPECT_THROW(level_image.addColumnLevels(levels.data(), 2), std::invalid_argument);
+    EXPECT_FALSE(level_image.saveToBMP("levels.bmp"));
+}
+
+TEST(SpectrogramImageTest, LevelPlaneDirtySpansMatchColors) {
+    SpectrogramImage colors(6, 2, ImageLayout::RowMajor);
+    SpectrogramImage levels(6, 2, ImageLayout::RowMajor, ImagePlane::Levels);
+    std::vector<uint32_t> color_column(2, 7);
+    std::vector<uint16_t> level_column(2, 7);
+
+    for (int i = 0; i < 9; ++i) {
+        colors.addColumn(color_column.data(), 2);
+        levels.addColumnLevels(level_column.data(), 2);
+        if (i % 4 == 0) {
+            colors.clearDirty();
+            levels.clearDirty();
+        }
+    }
+
+    ColumnSpan a[2];
+    ColumnSpan b[2];
+    size_t n = colors.getDirtySpans(a);
+    ASSERT_EQ(levels.getDirtySpans(b), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(a[i].image_column, b[i].image_column);
+        EXPECT_EQ(a[i].texture_column, b[i].texture_column);
+        EXPECT_EQ(a[i].count, b[i].count);
+    }
+    EXPECT_EQ(colors.getTextureSeam(), levels.getTextureSeam());
+}
+
+TEST(SpectrogramImageTest, LevelPlaneResizeAndClear) {
+    SpectrogramImage image(4, 3, ImageLayout::ColumnMajor, ImagePlane::Levels);
+    std::vector<uint16_t> column(3, 42);
+    image.addColumnLevels(column.data(), 3);
+
+    image.clear();
+    EXPECT_EQ(image.getLevelData()[0], 0u);
+
+    image.resize(8, 5);
+    EXPECT_EQ(image.getPlane(), ImagePlane::Levels);
+    EXPECT_EQ(image.getMemoryUsage(), 2u * 8u * 5u * sizeof(uint16_t));
+}
+
+// ============================================================================
+// Colors And Levels Tests
+// ============================================================================
+
+namespace {
+
+// Identity palette: each color is its own index
+std::array<uint32_t, 256> indexPalette() {
+    std::array<uint32_t, 256> palette;
+    for (uint32_t i = 0; i < 256; ++i) {
+        palette[i] = i;
+    }
+    return palette;
+}
+
+} // namespace
+
+TEST(SpectrogramImageTest, ColorsAndLevelsStoresBoth) {
+    SpectrogramImage image(4, 3, ImageLayout::RowMajor, ImagePlane::ColorsAndLevels);
+    EXPECT_EQ(image.getMemoryUsage(), 2u * 4u * 3u * (sizeof(uint32_t) + sizeof(uint16_t)));
+
+    std::vector<uint32_t> colors = {0xFF0000FF, 0xFF00FF00, 0xFFFF0000};
+    std::vector<uint16_t> levels = {100, 200, 300};
+    image.addColumn(colors.data(), levels.data(), 3);
+
+    for (size_t column : {size_t(0), size_t(4)}) {
+        for (size_t row = 0; row < 3; ++row) {
+            EXPECT_EQ(image.getPixelData()[image.getPixelIndex(column, row)], colors[row]);
+            EXPECT_EQ(image.getLevelData()[image.getPixelIndex(column, row)], levels[row]);
+        }
+    }
+    EXPECT_EQ(image.getColumnsWritten(), 1u);
+    EXPECT_EQ(image.getWriteOffset(), 1u);
+
+    // Single-plane writes would leave the other plane stale
+    EXPECT_THROW(image.addColumn(colors.data(), 3), std::invalid_argument);
+    EXPECT_THROW(image.addColumnLevels(levels.data(), 3), std::invalid_argument);
+    EXPECT_THROW(image.addColumn(colors.data(), levels.data(), 2), std::invalid_argument);
+
+    SpectrogramImage color_image(4, 3);
+    EXPECT_THROW(color_image.addColumn(colors.data(), levels.data(), 3), std::invalid_argument);
+}
+
+TEST(SpectrogramImageTest, RecolorMatchesDbMapping) {
+    const size_t width = 5;
+    const size_t height = 64;
+    SpectrogramImage image(width, height, ImageLayout::RowMajor, ImagePlane::ColorsAndLevels);
+
+    // Sweep -160..+20 dB over the rows, shifted per column; wrap once
+    std::vector<float> db(height);
+    std::vector<uint16_t> levels(height);
+    std::vector<uint32_t> colors(height, 0xDEADBEEF);
+    for (size_t c = 0; c < 2 * width + 2; ++c) {
+        for (size_t r = 0; r < height; ++r) {
+            db[r] = -160.0f + 180.0f * static_cast<float>(r) / (height - 1) + static_cast<float>(c);
+        }
+        SpectrogramImage::encodeLevels(db.data(), height, levels.data());
+        image.addColumn(colors.data(), levels.data(), height);
+    }
+
+    const float min_db = -120.0f;
+    const float max_db = -30.0f;
+    image.recolor(indexPalette(), min_db, max_db);
+
+    // Same as ColorTransform::transformColumnDb() on the decoded level,
+    // give or take rounding at an index boundary
+    for (size_t i = 0; i < image.getTotalPixels(); ++i) {
+        float x = (levelToDb(image.getLevelData()[i]) - min_db) * 255.0f / (max_db - min_db);
+        int expected = static_cast<int>(std::clamp(x, 0.0f, 255.0f));
+        int actual = static_cast<int>(image.getPixelData()[i]);
+        ASSERT_LE(std::abs(actual - expected), 1) << "pixel " << i;
+    }
+
+    // Ends of the range saturate
+    EXPECT_EQ(image.getPixelData()[image.getPixelIndex(image.getReadOffset(), 0)], 0u);
+    EXPECT_EQ(image.getPixelData()[image.getPixelIndex(image.getReadOffset(), height - 1)], 255u);
+}
+
+TEST(SpectrogramImageTest, RecolorMarksWindowDirty) {
+    SpectrogramImage image(8, 2, ImageLayout::RowMajor, ImagePlane::ColorsAndLevels);
+    std::vector<uint32_t> colors(2, 1);
+    std::vector<uint16_t> levels(2, 40000);
+    for (int i = 0; i < 11; ++i) {
+        image.addColumn(colors.data(), levels.data(), 2);
+    }
+    image.clearDirty();
+
+    ColumnSpan spans[2];
+    EXPECT_EQ(image.getDirtySpans(spans), 0u);
+
+    image.recolor(indexPalette(), -100.0f, 0.0f);
+    ASSERT_EQ(image.getDirtySpans(spans), 1u);
+    EXPECT_EQ(spans[0].image_column, image.getReadOffset());
+    EXPECT_EQ(spans[0].count, 8u);
+    EXPECT_EQ(image.getColumnsWritten(), 11u);   // Recolor adds no columns
+}
+
+TEST(SpectrogramImageTest, RecolorRejectsInvalid) {
+    SpectrogramImage image(4, 3, ImageLayout::RowMajor, ImagePlane::ColorsAndLevels);
+    EXPECT_THROW(image.recolor(indexPalette(), -50.0f, -50.0f), std::invalid_argument);
+    EXPECT_THROW(image.recolor(indexPalette(), 0.0f, -50.0f), std::invalid_argument);
+    EXPECT_NO_THROW(image.recolor(indexPalette(), -50.0f, 0.0f));
+
+    SpectrogramImage colors(4, 3);
+    EXPECT_THROW(colors.recolor(indexPalette(), -50.0f, 0.0f), std::invalid_argument);
+    SpectrogramImage levels(4, 3, ImageLayout::RowMajor, ImagePlane::Levels);
+    EXPECT_THROW(levels.recolor(indexPalette(), -50.0f, 0.0f), std::invalid_argument);
+}
+
+// ============================================================================
+// Resample Tests
+// ============================================================================
+
+namespace {
+
+// Column c: levels {c·10 + 1000, c·10 + 2000}, colors {c, c + 100}
+void addLevelColumns(SpectrogramImage& image, size_t first, size_t count) {
+    for (size_t c = first; c < first + count; ++c) {
+        const uint16_t levels[2] = {static_cast<uint16_t>(c * 10 + 1000),
+                                    static_cast<uint16_t>(c * 10 + 2000)};
+        const uint32_t colors[2] = {static_cast<uint32_t>(c), static_cast<uint32_t>(c + 100)};
+        image.addColumn(colors, levels, 2);
+    }
+}
+
+uint16_t visibleLevel(const SpectrogramImage& image, size_t x, size_t row) {
+    return image.getLevelData()[image.getPixelIndex(image.getReadOffset() + x, row)];
+}
+
+} // namespace
+
+TEST(SpectrogramImageTest, ResampleKeepsNewestColumns) {
+    for (ImageLayout layout : {ImageLayout::RowMajor, ImageLayout::ColumnMajor}) {
+        SpectrogramImage image(4, 2, layout, ImagePlane::ColorsAndLevels);
+        addLevelColumns(image, 0, 6);
+        image.clearDirty();
+
+        // Narrower: the newest three columns, at the left
+        image.resample(3, 2);
+        EXPECT_EQ(image.getWidth(), 3u);
+        EXPECT_EQ(image.getColumnsWritten(), 3u);
+        EXPECT_TRUE(image.isDirty());
+        for (size_t x = 0; x < 3; ++x) {
+            EXPECT_EQ(visibleLevel(image, x, 0), 1030 + x * 10);
+            EXPECT_EQ(visibleLevel(image, x, 1), 2030 + x * 10);
+        }
+
+        // Wider: the three columns stay, new ones follow them
+        image.resample(8, 2);
+        addLevelColumns(image, 6, 7);
+        EXPECT_EQ(image.getColumnsWritten(), 10u);
+        for (size_t x = 0; x < 8; ++x) {
+            EXPECT_EQ(visibleLevel(image, x, 0), 1050 + x * 10) << x;
+        }
+        const uint32_t* pixels = image.getPixelData();
+        EXPECT_EQ(pixels[image.getPixelIndex(image.getReadOffset() + 7, 1)], 112u);
+    }
+}
+
+TEST(SpectrogramImageTest, ResampleRescalesRows) {
+    for (ImageLayout layout : {ImageLayout::RowMajor, ImageLayout::ColumnMajor}) {
+        SpectrogramImage image(3, 2, layout, ImagePlane::ColorsAndLevels);
+        addLevelColumns(image, 0, 2);
+
+        // Levels interpolate, colors take the nearest row
+        image.resample(3, 4);
+        EXPECT_EQ(image.getHeight(), 4u);
+        const uint16_t expected[4] = {1000, 1250, 1750, 2000};
+        const uint32_t colors[4] = {0, 0, 100, 100};
+        for (size_t r = 0; r < 4; ++r) {
+            EXPECT_EQ(visibleLevel(image, 0, r), expected[r]) << r;
+            EXPECT_EQ(image.getPixelData()[image.getPixelIndex(0, r)], colors[r]) << r;
+        }
+
+        // Mirrors are written too, and new columns follow the kept ones
+        const uint16_t* levels = image.getLevelData();
+        for (size_t c = 0; c < 2; ++c) {
+            for (size_t r = 0; r < 4; ++r) {
+                EXPECT_EQ(levels[image.getPixelIndex(c + 3, r)], levels[image.getPixelIndex(c, r)]);
+            }
+        }
+        std::vector<uint16_t> silence(4, 0);
+        std::vector<uint32_t> black(4, 0);
+        image.addColumn(black.data(), silence.data(), 4);
+        image.addColumn(black.data(), silence.data(), 4);
+        EXPECT_EQ(visibleLevel(image, 0, 1), 1260u);   // Column 1, row 1
+        EXPECT_EQ(visibleLevel(image, 1, 1), 0u);
+    }
+}
+
+TEST(SpectrogramImageTest, ResampleParallelMatchesSerial) {
+    TaskPool pool(4);
+    for (ImageLayout layout : {ImageLayout::RowMajor, ImageLayout::ColumnMajor}) {
+        SpectrogramImage serial(64, 50, layout, ImagePlane::Levels);
+        SpectrogramImage parallel(64, 50, layout, ImagePlane::Levels);
+        std::vector<uint16_t> column(50);
+        for (size_t c = 0; c < 90; ++c) {
+            for (size_t r = 0; r < 50; ++r) {
+                column[r] = static_cast<uint16_t>((c * 131 + r * 977) % 65536);
+            }
+            serial.addColumnLevels(column.data(), 50);
+            parallel.addColumnLevels(column.data(), 50);
+        }
+
+        for (auto [width, height] : {std::pair<size_t, size_t>{100, 173}, {40, 21}}) {
+            serial.resample(width, height);
+            parallel.resample(width, height, &pool);
+            ASSERT_EQ(std::memcmp(serial.getLevelData(), parallel.getLevelData(),
+                                  2 * width * height * sizeof(uint16_t)), 0);
+        }
+    }
+}
+
+TEST(SpectrogramImageTest, ResampleRejectsZero) {
+    SpectrogramImage image(4, 2);
+    EXPECT_THROW(image.resample(0, 2), std::invalid_argument);
+    EXPECT_THROW(image.resample(4, 0), std::invalid_argument);
+    EXPECT_EQ(image.getWidth(), 4u);
+}
+
 // ============================================================================
 // Performance Hint Tests
 // ============================================================================
@@ -470,6 +1021,92 @@ TEST(SpectrogramImageTest, ManyColumnAdditions) {
     std::cout << "Average time per column: " << avg_time_us << " μs\n";
 }
 
+TEST(SpectrogramImageTest, PerformanceVisibleViewVsTranspose) {
+    const size_t width = 1920;
+    const size_t height = 1080;
+    const int iterations = 20;
+
+    SpectrogramImage column_major(width, height);
+    SpectrogramImage row_major(width, height, ImageLayout::RowMajor);
+    std::vector<uint32_t> column(height);
+    for (size_t i = 0; i < width + 123; ++i) {
+        std::fill(column.begin(), column.end(), static_cast<uint32_t>(i));
+        column_major.addColumn(column.data(), height);
+        row_major.addColumn(column.data(), height);
+    }
+
+    std::vector<uint32_t> texture(width * height);
+
+    // Previous path: per-pixel transpose of the column-major buffer
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        const uint32_t* src = column_major.getVisibleData();
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                texture[y * width + x] = src[x * height + y];
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double transpose_ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+    uint32_t transpose_check = texture[width - 1];
+
+    // Contiguous view: one pitched row copy per row, as SDL_UpdateTexture does
+    start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        const uint32_t* src = row_major.getVisibleData();
+        const size_t pitch = row_major.getRowPitch();
+        for (size_t y = 0; y < height; ++y) {
+            std::memcpy(texture.data() + y * width, src + y * pitch, width * sizeof(uint32_t));
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double view_ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+
+    // Both paths see the same newest column at the right edge
+    EXPECT_EQ(texture[width - 1], transpose_check);
+    EXPECT_LT(view_ms, transpose_ms);
+
+    std::cout << "\n=== Full-frame upload (1920x1080) ===\n";
+    std::cout << "Transpose (column-major): " << transpose_ms << " ms\n";
+    std::cout << "Contiguous view (row-major): " << view_ms << " ms\n";
+    std::cout << "Speedup: " << transpose_ms / view_ms << "x\n";
+}
+
+TEST(SpectrogramImageTest, PerformanceRecolorFullScreen) {
+    const size_t width = 1920;
+    const size_t height = 1080;
+    const int iterations = 10;
+
+    SpectrogramImage image(width, height, ImageLayout::RowMajor, ImagePlane::ColorsAndLevels);
+    std::vector<uint32_t> colors(height);
+    std::vector<uint16_t> levels(height);
+    for (size_t i = 0; i < width + 77; ++i) {
+        for (size_t r = 0; r < height; ++r) {
+            levels[r] = static_cast<uint16_t>((i * 131 + r * 977) & 0xFFFF);
+        }
+        image.addColumn(colors.data(), levels.data(), height);
+    }
+
+    std::array<uint32_t, 256> palette;
+    for (uint32_t i = 0; i < 256; ++i) {
+        palette[i] = 0xFF000000 | (i * 0x010101);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        image.recolor(palette, -140.0f - it, 0.0f);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double recolor_ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+
+    // Whole history (both halves of the ring) well within a frame or two
+    EXPECT_LT(recolor_ms, 200.0);
+
+    std::cout << "\n=== Recolor (2 x 1920x1080 levels) ===\n";
+    std::cout << "Recolor: " << recolor_ms << " ms\n";
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -0,0 +1,345 @@
+/**
+ * @file spectrogram_recording_test.cpp
+ * @brief Unit tests for SpectrogramRecorder and SpectrogramRecordingReader
+ *
+ * Tests cover:
+ * - Header validation and round trip of header fields
+ * - Column round trip at reduced and full level precision
+ * - Range reads across chunk boundaries and past the end
+ * - Compression of stationary input
+ * - Recovery of files without an index (crash / still recording)
+ * - Overviews from chunk summaries and from decoded columns
+ * - Dropped columns leave gaps without shifting time
+ */
+
+#include <gtest/gtest.h>
+#include <friture/spectrogram_recording.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr uint32_t HEIGHT = 16;
+
+RecordingHeader testHeader() {
+    RecordingHeader header;
+    header.fft_size = 4096;
+    header.hop_size = 1024;
+    header.sample_rate = 48000.0f;
+    header.scale = FrequencyScale::Mel;
+    header.min_freq = 20.0f;
+    header.max_freq = 20000.0f;
+    header.height = HEIGHT;
+    header.columns_per_chunk = 64;
+    return header;
+}
+
+std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Deterministic, non-stationary levels: column t, row r
+uint16_t testLevel(uint64_t t, size_t r) {
+    return static_cast<uint16_t>((t * 977 + r * 4513 + (t * r) % 1031) * 37);
+}
+
+void recordColumns(SpectrogramRecorder& recorder, uint64_t count) {
+    std::vector<uint16_t> column(HEIGHT);
+    for (uint64_t t = 0; t < count; ++t) {
+        for (size_t r = 0; r < HEIGHT; ++r) {
+            column[r] = testLevel(t, r);
+        }
+        ASSERT_TRUE(recorder.push(column.data(), HEIGHT));
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Header Tests
+// ============================================================================
+
+TEST(SpectrogramRecordingTest, RejectsInvalidHeader) {
+    EXPECT_THROW(SpectrogramRecorder(0), std::invalid_argument);
+
+    SpectrogramRecorder recorder;
+    auto path = tempPath("recording_invalid.frspec");
+
+    RecordingHeader header = testHeader();
+    header.height = 0;
+    EXPECT_FALSE(recorder.start(path, header));
+    EXPECT_FALSE(recorder.getError().empty());
+
+    header = testHeader();
+    header.level_bits = 4;
+    EXPECT_FALSE(recorder.start(path, header));
+
+    header = testHeader();
+    header.hop_size = 0;
+    EXPECT_FALSE(recorder.start(path, header));
+    EXPECT_FALSE(recorder.isRecording());
+
+    // Not recording: columns are refused
+    std::vector<uint16_t> column(HEIGHT, 1000);
+    EXPECT_FALSE(recorder.push(column.data(), HEIGHT));
+}
+
+TEST(SpectrogramRecordingTest, ReaderRejectsOtherFiles) {
+    auto path = tempPath("recording_not.frspec");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "RIFF this is not a spectrogram recording at all, just some bytes"
+             << std::string(64, 'x');
+    }
+
+    SpectrogramRecordingReader reader;
+    EXPECT_FALSE(reader.open(path.c_str()));
+    EXPECT_FALSE(reader.getError().empty());
+    EXPECT_FALSE(reader.isOpen());
+    EXPECT_FALSE(reader.open(tempPath("recording_missing.frspec").c_str()));
+    std::remove(path.c_str());
+}
+
+TEST(SpectrogramRecordingTest, HeaderRoundTrip) {
+    auto path = tempPath("recording_header.frspec");
+    {
+        SpectrogramRecorder recorder;
+        ASSERT_TRUE(recorder.start(path, testHeader())) << recorder.getError();
+        EXPECT_NE(recorder.getHeader().start_time_ms, 0);   // Filled in
+        recordColumns(recorder, 10);
+        EXPECT_TRUE(recorder.stop()) << recorder.getError();
+    }
+
+    SpectrogramRecordingReader reader;
+    ASSERT_TRUE(reader.open(path.c_str())) << reader.getError();
+    const RecordingHeader& header = reader.getHeader();
+    EXPECT_TRUE(header.sameFormat(testHeader()));
+    EXPECT_EQ(header.columns_per_chunk, 64u);
+    EXPECT_GT(header.start_time_ms, 0);
+    EXPECT_TRUE(reader.hasIndex());
+
+    // 1024 / 48000 s per column
+    EXPECT_EQ(reader.columnAtTime(0.0), 0u);
+    EXPECT_EQ(reader.columnAtTime(60.0), 2812u);
+    std::remove(path.c_str());
+}
+
+// ============================================================================
+// Round Trip Tests
+// ============================================================================
+
+TEST(SpectrogramRecordingTest, ColumnsRoundTripWithinStep) {
+    auto path = tempPath("recording_roundtrip.frspec");
+    SpectrogramRecorder recorder;
+    ASSERT_TRUE(recorder.start(path, testHeader()));
+    recordColumns(recorder, 1000);
+    ASSERT_TRUE(recorder.stop());
+    EXPECT_EQ(recorder.getColumnCount(), 1000u);
+    EXPECT_EQ(recorder.getDroppedColumns(), 0u);
+    EXPECT_EQ(recorder.getBytesWritten(), std::filesystem::file_size(path));
+
+    SpectrogramRecordingReader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+    EXPECT_EQ(reader.getColumnCount(), 1000u);
+    EXPECT_EQ(reader.getChunkCount(), 16u);   // 15 full chunks of 64 + 40
+
+    std::vector<uint16_t> levels(1000 * HEIGHT);
+    EXPECT_EQ(reader.readColumns(0, 1000, levels.data()), 1000u);
+    for (uint64_t t = 0; t < 1000; ++t) {
+        for (size_t r = 0; r < HEIGHT; ++r) {
+            // 12 bits: steps of 16 levels, decoded to the middle of the step
+            ASSERT_NEAR(levels[t * HEIGHT + r], testLevel(t, r), 8) << "t=" << t << " r=" << r;
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(SpectrogramRecordingTest, FullPrecisionIsExact) {
+    auto path = tempPath("recording_exact.frspec");
+    RecordingHeader header = testHeader();
+    header.level_bits = 16;
+
+    SpectrogramRecorder recorder;
+    ASSERT_TRUE(recorder.start(path, header));
+    recordColumns(recorder, 200);
+    ASSERT_TRUE(recorder.stop());
+
+    SpectrogramRecordingReader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+    std::vector<uint16_t> levels(200 * HEIGHT);
+    reader.readColumns(0, 200, levels.data());
+    for (uint64_t t = 0; t < 200; ++t) {
+        for (size_t r = 0; r < HEIGHT; ++r) {
+            ASSERT_EQ(levels[t * HEIGHT + r], testLevel(t, r));
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(SpectrogramRecordingTest, RangeReadsAcrossChunks) {
+    auto path = tempPath("recording_range.frspec");
+    RecordingHeader header = testHeader();
+    header.level_bits = 16;
+    SpectrogramRecorder recorder;
+    ASSERT_TRUE(recorder.start(path, header));
+    recordColumns(recorder, 300);
+    ASSERT_TRUE(recorder.stop());
+
+    SpectrogramRecordingReader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+
+    // Columns 60..69 span chunks 0 and 1
+    std::vector<uint16_t> levels(10 * HEIGHT);
+    EXPECT_EQ(reader.readColumns(60, 10, levels.data()), 10u);
+    for (uint64_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(levels[i * HEIGHT + 3], testLevel(60 + i, 3));
+    }
+
+    // Past the end: only the recorded part, the rest silent
+    EXPECT_EQ(reader.readColumns(295, 10, levels.data()), 5u);
+    EXPECT_EQ(levels[4 * HEIGHT], testLevel(299, 0));
+    EXPECT_EQ(levels[5 * HEIGHT], 0u);
+    EXPECT_EQ(reader.readColumns(1000, 10, levels.data()), 0u);
+    std::remove(path.c_str());
+}
+
+TEST(SpectrogramRecordingTest, StationaryInputCompresses) {
+    auto path = tempPath("recording_stationary.frspec");
+    SpectrogramRecorder recorder;
+    RecordingHeader header = testHeader();
+    header.height = 512;
+    header.columns_per_chunk = 256;
+    ASSERT_TRUE(recorder.start(path, header));
+
+    // A steady tone: every column the same
+    std::vector<uint16_t> column(512, 1000);
+    column[100] = 50000;
+    for (int t = 0; t < 3000; ++t) {   // Fits the queue
+        ASSERT_TRUE(recorder.push(column.data(), 512));
+    }
+    ASSERT_TRUE(recorder.stop());
+
+    const uint64_t raw_bytes = 3000ull * 512 * 2;
+    EXPECT_LT(std::filesystem::file_size(path), raw_bytes / 50);
+
+    SpectrogramRecordingReader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+    std::vector<uint16_t> levels(512);
+    reader.readColumns(2345, 1, levels.data());
+    EXPECT_NEAR(levels[100], 50000, 8);
+    EXPECT_NEAR(levels[0], 1000, 8);
+    std::remove(path.c_str());
+}
+
+// ============================================================================
+// Recovery Tests
+// ============================================================================
+
+TEST(SpectrogramRecordingTest, OpensFileWithoutIndex) {
+    auto path = tempPath("recording_truncated.frspec");
+    SpectrogramRecorder recorder;
+    ASSERT_TRUE(recorder.start(path, testHeader()));
+    recordColumns(recorder, 640);   // Exactly 10 chunks
+    ASSERT_TRUE(recorder.stop());
+
+    // Drop the trailer, the index and part of the last chunk
+    const auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 16 - 16 - 10 * 24 - 20);
+
+    SpectrogramRecordingReader reader;
+    ASSERT_TRUE(reader.open(path.c_str())) << reader.getError();
+    EXPECT_FALSE(reader.hasIndex());
+    EXPECT_EQ(reader.getChunkCount(), 9u);
+    EXPECT_EQ(reader.getColumnCount(), 576u);
+
+    std::vector<uint16_t> levels(HEIGHT);
+    EXPECT_EQ(reader.readColumns(575, 1, levels.data()), 1u);
+    EXPECT_NEAR(levels[5], testLevel(575, 5), 8);
+    std::remove(path.c_str());
+}
+
+// ============================================================================
+// Overview Tests
+// ============================================================================
+
+TEST(SpectrogramRecordingTest, OverviewKeepsPeaks) {
+    auto path = tempPath("recording_overview.frspec");
+    SpectrogramRecorder recorder;
+    ASSERT_TRUE(recorder.start(path, testHeader()));
+
+    std::vector<uint16_t> quiet(HEIGHT, 100);
+    std::vector<uint16_t> loud(HEIGHT, 60000);
+    for (int t = 0; t < 2048; ++t) {
+        ASSERT_TRUE(recorder.push(t == 1500 ? loud.data() : quiet.data(), HEIGHT));
+    }
+    ASSERT_TRUE(recorder.stop());
+
+    SpectrogramRecordingReader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+
+    // 512 columns per pixel: from chunk summaries
+    std::vector<uint16_t> coarse(4 * HEIGHT);
+    reader.readOverview(0, 2048, 4, coarse.data());
+    EXPECT_NEAR(coarse[0], 100, 8);
+    EXPECT_NEAR(coarse[HEIGHT], 100, 8);
+    EXPECT_NEAR(coarse[2 * HEIGHT], 60000, 8);   // Columns 1024..1535
+    EXPECT_NEAR(coarse[2 * HEIGHT + 1], 60000, 8);
+    EXPECT_NEAR(coarse[3 * HEIGHT], 100, 8);
+
+    // 16 columns per pixel: decoded
+    std::vector<uint16_t> fine(64 * HEIGHT);
+    reader.readOverview(1024, 1024, 64, fine.data());
+    EXPECT_NEAR(fine[29 * HEIGHT], 60000, 8);     // 1500 = 1024 + 29 × 16 + 12
+    EXPECT_NEAR(fine[30 * HEIGHT], 100, 8);
+
+    // Zoomed in past one column per pixel
+    std::vector<uint16_t> zoomed(4 * HEIGHT);
+    reader.readOverview(1499, 2, 4, zoomed.data());
+    EXPECT_NEAR(zoomed[HEIGHT], 100, 8);
+    EXPECT_NEAR(zoomed[2 * HEIGHT], 60000, 8);
+    std::remove(path.c_str());
+}
+
+// ============================================================================
+// Drop Tests
+// ============================================================================
+
+TEST(SpectrogramRecordingTest, DroppedColumnsLeaveGaps) {
+    auto path = tempPath("recording_drops.frspec");
+    RecordingHeader header = testHeader();
+    header.level_bits = 16;
+    SpectrogramRecorder recorder(4);   // Tiny queue: the writer cannot keep up
+    ASSERT_TRUE(recorder.start(path, header));
+
+    std::vector<uint16_t> column(HEIGHT);
+    for (uint64_t t = 0; t < 2000; ++t) {
+        for (size_t r = 0; r < HEIGHT; ++r) {
+            column[r] = testLevel(t, r) | 1;   // Never silent
+        }
+        recorder.push(column.data(), HEIGHT);
+    }
+    ASSERT_TRUE(recorder.stop());
+    EXPECT_EQ(recorder.getColumnCount(), 2000u);
+    EXPECT_GT(recorder.getDroppedColumns(), 0u);
+
+    SpectrogramRecordingReader reader;
+    ASSERT_TRUE(reader.open(path.c_str()));
+    std::vector<uint16_t> levels(2000 * HEIGHT);
+    const size_t present = reader.readColumns(0, 2000, levels.data());
+    EXPECT_EQ(present + recorder.getDroppedColumns(), 2000u);
+
+    // Every kept column is at its original time
+    for (uint64_t t = 0; t < 2000; ++t) {
+        const uint16_t value = levels[t * HEIGHT + 7];
+        if (value != 0) {
+            ASSERT_EQ(value, testLevel(t, 7) | 1) << "t=" << t;
+        }
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,200 @@
+/**
+ * @file spectrum_views_test.cpp
+ * @brief Unit tests for SpectrumViews
+ *
+ * Tests cover:
+ * - Latest column in dB and band selection from the row layout
+ * - Band power as the sum over the band's bins
+ * - Peak hold over every column between frames, hold time and decay
+ * - Invalid layouts
+ */
+
+#include <gtest/gtest.h>
+#include <friture/spectrum_views.hpp>
+#include <friture/spectrogram_image.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+// Rows every bin_hz from bin_hz up to max_hz (a linear-scale layout)
+std::vector<float> linearRows(float bin_hz, float max_hz) {
+    std::vector<float> rows;
+    for (float f = bin_hz; f <= max_hz; f += bin_hz) {
+        rows.push_back(f);
+    }
+    return rows;
+}
+
+std::vector<uint16_t> flatColumn(size_t height, float db) {
+    std::vector<uint16_t> levels(height);
+    SpectrogramImage::encodeLevels(std::vector<float>(height, db).data(), height, levels.data());
+    return levels;
+}
+
+} // namespace
+
+// ============================================================================
+// Layout Tests
+// ============================================================================
+
+TEST(SpectrumViewsTest, ThirdOctaveBandsInsideRowRange) {
+    SpectrumViews views;
+    views.configure(linearRows(10.0f, 20000.0f), 10.0f);
+
+    const std::vector<OctaveBand>& bands = views.getBands();
+    ASSERT_FALSE(bands.empty());
+    EXPECT_GE(bands.front().center_hz, 10.0f);
+    EXPECT_LE(bands.back().center_hz, 20000.0f);
+
+    // Base-2 centers around 1 kHz, 1/3 octave apart
+    bool has_1k = false;
+    for (size_t b = 0; b < bands.size(); ++b) {
+        has_1k |= std::abs(bands[b].center_hz - 1000.0f) < 1e-3f;
+        EXPECT_NEAR(bands[b].high_hz / bands[b].low_hz, std::exp2(1.0f / 3.0f), 1e-4f);
+        if (b > 0) {
+            EXPECT_NEAR(bands[b].low_hz, bands[b - 1].high_hz, 1e-2f);
+        }
+    }
+    EXPECT_TRUE(has_1k);
+    EXPECT_EQ(bands.size(), 32u);   // 12.5 Hz to 16 kHz (nominal)
+}
+
+TEST(SpectrumViewsTest, OctaveBandsOption) {
+    SpectrumViews::Options options;
+    options.bands_per_octave = 1;
+    SpectrumViews views(options);
+    views.configure(linearRows(10.0f, 20000.0f), 10.0f);
+
+    ASSERT_EQ(views.getBands().size(), 11u);   // 15.6 Hz to 16 kHz
+    EXPECT_NEAR(views.getBands().back().center_hz, 16000.0f, 1.0f);
+}
+
+// ============================================================================
+// Level Tests
+// ============================================================================
+
+TEST(SpectrumViewsTest, SpectrumIsLatestColumn) {
+    SpectrumViews views;
+    const std::vector<float> rows = linearRows(10.0f, 5000.0f);
+    views.configure(rows, 10.0f);
+
+    std::vector<uint16_t> first = flatColumn(rows.size(), -80.0f);
+    std::vector<uint16_t> second = flatColumn(rows.size(), -40.0f);
+    views.addColumn(second.data(), rows.size());
+    views.addColumn(first.data(), rows.size());
+    views.update(0.016f);
+
+    for (size_t r = 0; r < rows.size(); ++r) {
+        ASSERT_NEAR(views.getSpectrum()[r], -80.0f, 0.01f);
+        ASSERT_NEAR(views.getSpectrumPeaks()[r], -40.0f, 0.01f);
+    }
+}
+
+TEST(SpectrumViewsTest, BandPowerSumsBins) {
+    // One row per bin: a band's power is the sum of its bins
+    SpectrumViews views;
+    const std::vector<float> rows = linearRows(1.0f, 4000.0f);
+    views.configure(rows, 1.0f);
+
+    std::vector<uint16_t> column = flatColumn(rows.size(), -60.0f);
+    views.addColumn(column.data(), rows.size());
+    views.update(0.016f);
+
+    const std::vector<OctaveBand>& bands = views.getBands();
+    for (size_t b = 0; b < bands.size(); ++b) {
+        if (bands[b].low_hz < rows.front() || bands[b].high_hz > rows.back()) {
+            continue;   // Partial band at the range edge
+        }
+        const float expected = -60.0f + 10.0f * std::log10(bands[b].high_hz - bands[b].low_hz);
+        EXPECT_NEAR(views.getBandLevels()[b], expected, 0.05f) << bands[b].center_hz << " Hz";
+    }
+}
+
+TEST(SpectrumViewsTest, ToneLandsInItsBand) {
+    SpectrumViews views;
+    const std::vector<float> rows = linearRows(5.0f, 8000.0f);
+    views.configure(rows, 5.0f);
+
+    std::vector<float> db(rows.size(), -150.0f);
+    db[199] = -20.0f;   // 1000 Hz
+    std::vector<uint16_t> column(rows.size());
+    SpectrogramImage::encodeLevels(db.data(), rows.size(), column.data());
+    views.addColumn(column.data(), rows.size());
+    views.update(0.016f);
+
+    const std::vector<OctaveBand>& bands = views.getBands();
+    size_t loudest = 0;
+    for (size_t b = 1; b < bands.size(); ++b) {
+        if (views.getBandLevels()[b] > views.getBandLevels()[loudest]) {
+            loudest = b;
+        }
+    }
+    EXPECT_NEAR(bands[loudest].center_hz, 1000.0f, 1e-3f);
+    // Rows are one bin wide: the band holds exactly the tone's power
+    EXPECT_NEAR(views.getBandLevels()[loudest], -20.0f, 0.05f);
+}
+
+// ============================================================================
+// Peak Hold Tests
+// ============================================================================
+
+TEST(SpectrumViewsTest, PeaksHoldThenDecay) {
+    SpectrumViews::Options options;
+    options.hold_seconds = 0.5f;
+    options.decay_db_per_second = 20.0f;
+    SpectrumViews views(options);
+    const std::vector<float> rows = linearRows(10.0f, 2000.0f);
+    views.configure(rows, 10.0f);
+
+    std::vector<uint16_t> loud = flatColumn(rows.size(), -30.0f);
+    std::vector<uint16_t> quiet = flatColumn(rows.size(), -90.0f);
+    views.addColumn(loud.data(), rows.size());
+    views.update(0.0f);
+    const float band_peak = views.getBandPeaks()[3];
+
+    // Held for 0.5 s
+    views.addColumn(quiet.data(), rows.size());
+    views.update(0.4f);
+    EXPECT_NEAR(views.getSpectrumPeaks()[0], -30.0f, 0.01f);
+    EXPECT_NEAR(views.getBandPeaks()[3], band_peak, 0.01f);
+
+    // 0.1 s into the hold window, then 0.3 s of decay
+    views.update(0.4f);
+    EXPECT_NEAR(views.getSpectrumPeaks()[0], -30.0f - 20.0f * 0.3f, 0.01f);
+
+    // Never below the current spectrum
+    views.update(10.0f);
+    EXPECT_NEAR(views.getSpectrumPeaks()[0], -90.0f, 0.01f);
+    EXPECT_NEAR(views.getSpectrum()[0], -90.0f, 0.01f);
+
+    views.reset();
+    EXPECT_EQ(views.getSpectrumPeaks()[0], LEVEL_MIN_DB);
+}
+
+TEST(SpectrumViewsTest, WrongHeightIgnored) {
+    SpectrumViews views;
+    views.configure(linearRows(10.0f, 1000.0f), 10.0f);
+    std::vector<uint16_t> column = flatColumn(50, 0.0f);
+    views.addColumn(column.data(), column.size());
+    views.update(0.016f);
+    EXPECT_EQ(views.getSpectrum()[0], LEVEL_MIN_DB);
+}
+
+TEST(SpectrumViewsTest, InvalidLayoutThrows) {
+    SpectrumViews views;
+    EXPECT_FALSE(views.isConfigured());
+    EXPECT_THROW(views.configure({}, 10.0f), std::invalid_argument);
+    EXPECT_THROW(views.configure({100.0f, 200.0f}, 0.0f), std::invalid_argument);
+    EXPECT_THROW(views.configure({200.0f, 100.0f}, 10.0f), std::invalid_argument);
+
+    SpectrumViews::Options options;
+    options.bands_per_octave = 0;
+    EXPECT_THROW(SpectrumViews{options}, std::invalid_argument);
+    options.bands_per_octave = 3;
+    options.hold_seconds = -1.0f;
+    EXPECT_THROW(SpectrumViews{options}, std::invalid_argument);
+}
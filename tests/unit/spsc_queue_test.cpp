@@ -0,0 +1,135 @@
+/**
+ * @file spsc_queue_test.cpp
+ * @brief Unit tests for SpscQueue
+ *
+ * Tests cover:
+ * - Basic push/pop and FIFO ordering
+ * - Full/empty behavior and wrap-around
+ * - In-place fill/consume of pre-allocated slots
+ * - Producer/consumer threads (lossless ordered hand-off)
+ */
+
+#include <gtest/gtest.h>
+#include <friture/spsc_queue.hpp>
+#include <vector>
+#include <thread>
+#include <cstdint>
+
+using namespace friture;
+
+// ============================================================================
+// Basic Operations Tests
+// ============================================================================
+
+TEST(SpscQueueTest, Construction) {
+    SpscQueue<int> queue(8);
+    EXPECT_EQ(queue.capacity(), 8);
+    EXPECT_EQ(queue.size(), 0);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, PushPopOrder) {
+    SpscQueue<int> queue(4);
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_TRUE(queue.tryPush(3));
+    EXPECT_EQ(queue.size(), 3);
+
+    int value = 0;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(SpscQueueTest, FullQueueRejectsPush) {
+    SpscQueue<int> queue(2);
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+
+    bool called = false;
+    EXPECT_FALSE(queue.pushWith([&](int&) { called = true; }));
+    EXPECT_FALSE(called);
+}
+
+TEST(SpscQueueTest, WrapAround) {
+    SpscQueue<int> queue(3);
+
+    int value = 0;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.tryPush(i));
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, InPlaceSlotsKeepCapacity) {
+    SpscQueue<std::vector<uint32_t>> queue(4, std::vector<uint32_t>(16));
+
+    for (int round = 0; round < 10; ++round) {
+        EXPECT_TRUE(queue.pushWith([&](std::vector<uint32_t>& slot) {
+            ASSERT_EQ(slot.size(), 16u);
+            for (size_t i = 0; i < slot.size(); ++i) {
+                slot[i] = static_cast<uint32_t>(round * 100 + i);
+            }
+        }));
+
+        EXPECT_TRUE(queue.popWith([&](const std::vector<uint32_t>& slot) {
+            ASSERT_EQ(slot.size(), 16u);
+            EXPECT_EQ(slot[0], static_cast<uint32_t>(round * 100));
+            EXPECT_EQ(slot[15], static_cast<uint32_t>(round * 100 + 15));
+        }));
+    }
+}
+
+// ============================================================================
+// Thread Safety Tests
+// ============================================================================
+
+TEST(SpscQueueTest, ProducerConsumerOrdered) {
+    SpscQueue<uint64_t> queue(64);
+    const uint64_t count = 200000;
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < count; ++i) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    bool in_order = true;
+    while (expected < count) {
+        uint64_t value = 0;
+        if (queue.tryPop(value)) {
+            if (value != expected) {
+                in_order = false;
+            }
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(queue.empty());
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
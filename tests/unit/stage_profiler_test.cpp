@@ -0,0 +1,219 @@
+/**
+ * @file stage_profiler_test.cpp
+ * @brief Unit tests for StageProfiler
+ *
+ * Tests cover:
+ * - Log-linear bucketing and percentile estimates
+ * - Batched records and windowed snapshots
+ * - Scoped timers
+ * - Snapshots taken while writer threads record
+ * - Chrome trace output and event log capacity
+ */
+
+#include <gtest/gtest.h>
+#include <friture/stage_profiler.hpp>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace friture;
+
+// ============================================================================
+// Histogram Tests
+// ============================================================================
+
+TEST(StageProfilerTest, InitiallyEmpty) {
+    StageProfiler profiler;
+    auto snapshot = profiler.getSnapshot();
+    for (const auto& stage : snapshot.stages) {
+        EXPECT_EQ(stage.count, 0u);
+        EXPECT_DOUBLE_EQ(stage.percentileMicros(0.99), 0.0);
+        EXPECT_DOUBLE_EQ(stage.maxMicros(), 0.0);
+    }
+    EXPECT_FALSE(profiler.isTracing());
+}
+
+TEST(StageProfilerTest, BucketsAreContiguousAndBounded) {
+    using S = StageStatsSnapshot;
+    // Every bucket's lower edge maps back to that bucket, and the edges grow
+    for (size_t b = 0; b < S::HISTOGRAM_BUCKETS; ++b) {
+        EXPECT_EQ(S::bucketFor(S::bucketLowerNs(b)), b) << "bucket " << b;
+        EXPECT_EQ(S::bucketFor(S::bucketLowerNs(b + 1) - 1), b) << "bucket " << b;
+    }
+
+    // Sub-bucket width is at most 1/8 of the value
+    for (uint64_t ns : {100ull, 12345ull, 1000000ull, 987654321ull}) {
+        size_t b = S::bucketFor(ns);
+        uint64_t width = S::bucketLowerNs(b + 1) - S::bucketLowerNs(b);
+        EXPECT_LE(width * 8, ns);
+    }
+
+    // Huge durations saturate
+    EXPECT_EQ(S::bucketFor(UINT64_MAX), S::HISTOGRAM_BUCKETS - 1);
+}
+
+TEST(StageProfilerTest, PercentilesWithinBucketResolution) {
+    StageProfiler profiler;
+    // 90 fast FFTs at 20 µs, 10 slow ones at 2 ms
+    for (int i = 0; i < 90; ++i) {
+        profiler.record(ProfileStage::FFT, 0, 20000);
+    }
+    for (int i = 0; i < 10; ++i) {
+        profiler.record(ProfileStage::FFT, 0, 2000000);
+    }
+
+    auto fft = profiler.getSnapshot()[ProfileStage::FFT];
+    EXPECT_EQ(fft.count, 100u);
+    EXPECT_NEAR(fft.meanMicros(), 218.0, 0.01);
+    EXPECT_GE(fft.percentileMicros(0.50), 20.0);
+    EXPECT_LE(fft.percentileMicros(0.50), 20.0 * 1.125);
+    EXPECT_GE(fft.percentileMicros(0.99), 2000.0);
+    EXPECT_LE(fft.percentileMicros(0.99), 2000.0 * 1.125);
+    EXPECT_DOUBLE_EQ(fft.maxMicros(), fft.percentileMicros(0.99));
+
+    // Other stages untouched
+    EXPECT_EQ(profiler.getSnapshot()[ProfileStage::Resample].count, 0u);
+}
+
+TEST(StageProfilerTest, BatchCountsEachColumn) {
+    StageProfiler profiler;
+    profiler.record(ProfileStage::FFT, 0, 320000, 32);   // 32 columns, 10 µs each
+
+    auto fft = profiler.getSnapshot()[ProfileStage::FFT];
+    EXPECT_EQ(fft.count, 32u);
+    EXPECT_EQ(fft.total_ns, 320000u);
+    EXPECT_EQ(fft.histogram[StageStatsSnapshot::bucketFor(10000)], 32u);
+}
+
+TEST(StageProfilerTest, SinceGivesWindow) {
+    StageProfiler profiler;
+    for (int i = 0; i < 50; ++i) {
+        profiler.record(ProfileStage::Upload, 0, 5000000);   // Slow startup frames
+    }
+    auto baseline = profiler.getSnapshot();
+
+    for (int i = 0; i < 20; ++i) {
+        profiler.record(ProfileStage::Upload, 0, 100000);
+    }
+    auto window = profiler.getSnapshot().since(baseline);
+
+    EXPECT_EQ(window[ProfileStage::Upload].count, 20u);
+    EXPECT_LE(window[ProfileStage::Upload].maxMicros(), 100.0 * 1.125);
+    EXPECT_EQ(window[ProfileStage::Frame].count, 0u);
+}
+
+TEST(StageProfilerTest, ScopedTimerRecordsElapsed) {
+    StageProfiler profiler;
+    {
+        ScopedStageTimer timer(profiler, ProfileStage::Present);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    {
+        ScopedStageTimer timer(profiler, ProfileStage::Read, 4);
+        timer.setColumns(8);
+    }
+
+    auto snapshot = profiler.getSnapshot();
+    EXPECT_EQ(snapshot[ProfileStage::Present].count, 1u);
+    EXPECT_GE(snapshot[ProfileStage::Present].total_ns, 2000000u);
+    EXPECT_EQ(snapshot[ProfileStage::Read].count, 8u);
+}
+
+TEST(StageProfilerTest, StageNamesAndThreads) {
+    EXPECT_STREQ(toString(ProfileStage::FFT), "FFT");
+    EXPECT_STREQ(toString(ProfileStage::Present), "Present");
+    EXPECT_TRUE(isAnalysisStage(ProfileStage::Colorize));
+    EXPECT_FALSE(isAnalysisStage(ProfileStage::Drain));
+}
+
+// ============================================================================
+// Concurrency Tests
+// ============================================================================
+
+TEST(StageProfilerTest, SnapshotsWhileRecording) {
+    StageProfiler profiler;
+    profiler.enableTrace(1000);
+    constexpr uint64_t RECORDS = 200000;
+    std::atomic<bool> done{false};
+
+    // One writer per thread's stages, as in the application
+    std::thread analysis([&]() {
+        for (uint64_t i = 0; i < RECORDS; ++i) {
+            profiler.record(ProfileStage::FFT, i, 1000 + i % 5000);
+        }
+    });
+    std::thread render([&]() {
+        for (uint64_t i = 0; i < RECORDS; ++i) {
+            profiler.record(ProfileStage::Frame, i, 2000 + i % 7000);
+        }
+        done = true;
+    });
+
+    // Counts never go backwards while the writers run
+    uint64_t last_fft = 0;
+    while (!done) {
+        auto snapshot = profiler.getSnapshot();
+        EXPECT_GE(snapshot[ProfileStage::FFT].count, last_fft);
+        last_fft = snapshot[ProfileStage::FFT].count;
+        EXPECT_LE(profiler.getTraceEventCount(), 2000u);
+    }
+    analysis.join();
+    render.join();
+
+    auto snapshot = profiler.getSnapshot();
+    EXPECT_EQ(snapshot[ProfileStage::FFT].count, RECORDS);
+    EXPECT_EQ(snapshot[ProfileStage::Frame].count, RECORDS);
+    uint64_t bucket_total = 0;
+    for (uint64_t bucket : snapshot[ProfileStage::Frame].histogram) {
+        bucket_total += bucket;
+    }
+    EXPECT_EQ(bucket_total, RECORDS);
+
+    // Event logs stop at their capacity; histograms keep counting
+    EXPECT_EQ(profiler.getTraceEventCount(), 2000u);
+}
+
+// ============================================================================
+// Trace Tests
+// ============================================================================
+
+TEST(StageProfilerTest, WriteTraceRequiresTracing) {
+    StageProfiler profiler;
+    auto path = (std::filesystem::temp_directory_path() / "stage_profiler_off.json").string();
+    EXPECT_FALSE(profiler.writeTrace(path));
+    EXPECT_FALSE(profiler.getError().empty());
+}
+
+TEST(StageProfilerTest, WritesChromeTraceEvents) {
+    StageProfiler profiler;
+    profiler.enableTrace(16);
+    EXPECT_TRUE(profiler.isTracing());
+
+    uint64_t t0 = StageProfiler::now();
+    profiler.record(ProfileStage::FFT, t0 + 1000, 250000, 16);
+    profiler.record(ProfileStage::Upload, t0 + 2000, 1500);
+    EXPECT_EQ(profiler.getTraceEventCount(), 2u);
+
+    auto path = (std::filesystem::temp_directory_path() / "stage_profiler_test.json").string();
+    ASSERT_TRUE(profiler.writeTrace(path)) << profiler.getError();
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string json = contents.str();
+
+    EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"analysis\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"render\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"FFT\",\"ph\":\"X\",\"pid\":1,\"tid\":1"), std::string::npos);
+    EXPECT_NE(json.find("\"dur\":250.000"), std::string::npos);   // One event per batch
+    EXPECT_NE(json.find("\"name\":\"Upload\",\"ph\":\"X\",\"pid\":1,\"tid\":2"), std::string::npos);
+    EXPECT_EQ(json.find("Resample"), std::string::npos);
+    EXPECT_EQ(json.back(), '\n');
+
+    std::remove(path.c_str());
+}
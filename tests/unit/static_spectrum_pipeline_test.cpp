@@ -0,0 +1,201 @@
+/**
+ * @file static_spectrum_pipeline_test.cpp
+ * @brief Unit tests for StaticSpectrumPipeline
+ *
+ * Tests cover:
+ * - Compile-time window, mapping and aggregation tables against the
+ *   runtime FFTProcessor / FrequencyResampler tables
+ * - Columns against FFTProcessor::process() + FrequencyResampler::resample()
+ *   for every aggregation mode
+ */
+
+#include <gtest/gtest.h>
+#include <friture/static_spectrum_pipeline.hpp>
+#include <friture/fft_processor.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr StaticPipelineConfig EMBEDDED{
+    4096, WindowFunction::Hann, FrequencyScale::Logarithmic, 20.0f, 20000.0f, 48000.0f, 512,
+    BinAggregation::MeanPower};
+constexpr StaticPipelineConfig LINEAR_PEAK{
+    1024, WindowFunction::Hamming, FrequencyScale::Linear, 100.0f, 12000.0f, 48000.0f, 300,
+    BinAggregation::PeakHold};
+constexpr StaticPipelineConfig MEL_INTERPOLATE{
+    2048, WindowFunction::Hann, FrequencyScale::Mel, 50.0f, 16000.0f, 44100.0f, 700,
+    BinAggregation::Interpolate};
+constexpr StaticPipelineConfig FLAT_TOP_PEAK{
+    1024, WindowFunction::FlatTop, FrequencyScale::Linear, 100.0f, 12000.0f, 48000.0f, 300,
+    BinAggregation::PeakHold};
+constexpr StaticPipelineConfig BLACKMAN_HARRIS_LOG{
+    2048, WindowFunction::BlackmanHarris, FrequencyScale::Logarithmic, 20.0f, 20000.0f, 48000.0f, 400,
+    BinAggregation::MeanPower};
+
+using EmbeddedPipeline = StaticSpectrumPipeline<EMBEDDED>;
+using LinearPeakPipeline = StaticSpectrumPipeline<LINEAR_PEAK>;
+using MelInterpolatePipeline = StaticSpectrumPipeline<MEL_INTERPOLATE>;
+using FlatTopPeakPipeline = StaticSpectrumPipeline<FLAT_TOP_PEAK>;
+using BlackmanHarrisLogPipeline = StaticSpectrumPipeline<BLACKMAN_HARRIS_LOG>;
+
+// Everything is known to the compiler
+static_assert(EmbeddedPipeline::WINDOW[0] == 0.0f);
+static_assert(EmbeddedPipeline::BANDS.weight_count > 0);
+static_assert(EmbeddedPipeline::FIRST_BIN < EmbeddedPipeline::END_BIN);
+static_assert(EmbeddedPipeline::END_BIN <= EmbeddedPipeline::NUM_BINS);
+
+FrequencyResampler dynamicResampler(const StaticPipelineConfig& config) {
+    return FrequencyResampler(config.scale, config.min_freq, config.max_freq, config.sample_rate,
+                              config.fft_size, config.height, config.aggregation);
+}
+
+std::vector<float> testSignal(size_t count, float sample_rate, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float t = static_cast<float>(i) / sample_rate;
+        samples[i] = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * 440.0f * t) +
+                     0.1f * std::sin(2.0f * static_cast<float>(M_PI) * 3150.0f * t) + noise(rng);
+    }
+    return samples;
+}
+
+// Dynamic path: FFTProcessor + FrequencyResampler
+template<typename Pipeline>
+void expectMatchesDynamicPath(const StaticPipelineConfig& config, float tolerance_db) {
+    auto pipeline = std::make_unique<Pipeline>();
+    FFTProcessor fft(config.fft_size, config.window);
+    FrequencyResampler resampler = dynamicResampler(config);
+
+    std::vector<float> spectrum(config.fft_size / 2 + 1);
+    std::vector<float> expected(config.height);
+    std::vector<float> actual(config.height);
+
+    for (unsigned frame = 0; frame < 3; ++frame) {
+        std::vector<float> samples = testSignal(config.fft_size, config.sample_rate, frame);
+        fft.process(samples.data(), spectrum.data());
+        resampler.resample(spectrum.data(), expected.data());
+        pipeline->process(samples.data(), actual.data());
+
+        for (size_t row = 0; row < config.height; ++row) {
+            if (tolerance_db == 0.0f) {
+                ASSERT_EQ(actual[row], expected[row]) << "frame " << frame << " row " << row;
+            } else {
+                ASSERT_NEAR(actual[row], expected[row], tolerance_db) << "frame " << frame << " row " << row;
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Table Tests
+// ============================================================================
+
+TEST(StaticSpectrumPipelineTest, WindowMatchesComputeWindow) {
+    // Same expressions as windowTable()
+    const float n = static_cast<float>(EmbeddedPipeline::FFT_SIZE - 1);
+    for (size_t i = 0; i < EmbeddedPipeline::FFT_SIZE; ++i) {
+        const float hann = 0.5f * (1.0f - std::cos(2.0f * M_PI * i / n));
+        ASSERT_EQ(EmbeddedPipeline::WINDOW[i], hann) << "Hann " << i;
+    }
+
+    const float m = static_cast<float>(LinearPeakPipeline::FFT_SIZE - 1);
+    for (size_t i = 0; i < LinearPeakPipeline::FFT_SIZE; ++i) {
+        const float hamming = 0.54f - 0.46f * std::cos(2.0f * M_PI * i / m);
+        ASSERT_EQ(LinearPeakPipeline::WINDOW[i], hamming) << "Hamming " << i;
+    }
+}
+
+TEST(StaticSpectrumPipelineTest, CosineSumWindowsMatchWindowTable) {
+    const WindowTable flat_top = windowTable(WindowFunction::FlatTop, FlatTopPeakPipeline::FFT_SIZE);
+    for (size_t i = 0; i < FlatTopPeakPipeline::FFT_SIZE; ++i) {
+        ASSERT_EQ(FlatTopPeakPipeline::WINDOW[i], flat_top.data()[i]) << "Flat-top " << i;
+    }
+
+    const WindowTable blackman_harris =
+        windowTable(WindowFunction::BlackmanHarris, BlackmanHarrisLogPipeline::FFT_SIZE);
+    for (size_t i = 0; i < BlackmanHarrisLogPipeline::FFT_SIZE; ++i) {
+        ASSERT_EQ(BlackmanHarrisLogPipeline::WINDOW[i], blackman_harris.data()[i]) << "Blackman-Harris " << i;
+    }
+}
+
+TEST(StaticSpectrumPipelineTest, LinearTablesIdenticalToResampler) {
+    FrequencyResampler resampler = dynamicResampler(LINEAR_PEAK);
+    const std::vector<float>& mapping = resampler.getFrequencyMapping();
+    const auto& bands = resampler.getBands();
+    const std::vector<float>& weights = resampler.getBandWeights();
+
+    ASSERT_EQ(LinearPeakPipeline::BANDS.weight_count, weights.size());
+    for (size_t row = 0; row < LINEAR_PEAK.height; ++row) {
+        ASSERT_EQ(LinearPeakPipeline::MAPPING[row], mapping[row]);
+        const auto& band = LinearPeakPipeline::BANDS.bands[row];
+        ASSERT_EQ(band.start_bin, bands[row].start_bin);
+        ASSERT_EQ(band.count, bands[row].count);
+        ASSERT_EQ(band.weight_offset, bands[row].weight_offset);
+        ASSERT_EQ(band.interpolated, bands[row].interpolated);
+    }
+    for (size_t k = 0; k < weights.size(); ++k) {
+        ASSERT_EQ(LinearPeakPipeline::BANDS.weights[k], weights[k]);
+    }
+
+    EXPECT_EQ(LinearPeakPipeline::FIRST_BIN, resampler.getInputRange().first);
+    EXPECT_EQ(LinearPeakPipeline::END_BIN, resampler.getInputRange().end);
+}
+
+TEST(StaticSpectrumPipelineTest, LogMappingMatchesResampler) {
+    FrequencyResampler resampler = dynamicResampler(EMBEDDED);
+    const std::vector<float>& mapping = resampler.getFrequencyMapping();
+
+    // libm in float vs static_math in double: last-bit differences only
+    for (size_t row = 0; row < EMBEDDED.height; ++row) {
+        ASSERT_NEAR(EmbeddedPipeline::MAPPING[row], mapping[row], 2e-6f * mapping[row]) << row;
+    }
+    EXPECT_EQ(EmbeddedPipeline::FIRST_BIN, resampler.getInputRange().first);
+    EXPECT_EQ(EmbeddedPipeline::END_BIN, resampler.getInputRange().end);
+}
+
+// ============================================================================
+// Output Tests
+// ============================================================================
+
+TEST(StaticSpectrumPipelineTest, LinearPeakHoldIdenticalToDynamicPath) {
+    expectMatchesDynamicPath<LinearPeakPipeline>(LINEAR_PEAK, 0.0f);
+}
+
+TEST(StaticSpectrumPipelineTest, LogMeanPowerMatchesDynamicPath) {
+    expectMatchesDynamicPath<EmbeddedPipeline>(EMBEDDED, 1e-3f);
+}
+
+TEST(StaticSpectrumPipelineTest, MelInterpolateMatchesDynamicPath) {
+    expectMatchesDynamicPath<MelInterpolatePipeline>(MEL_INTERPOLATE, 1e-3f);
+}
+
+TEST(StaticSpectrumPipelineTest, FlatTopPeakHoldIdenticalToDynamicPath) {
+    // Same coherent gain correction, so still bit-identical
+    expectMatchesDynamicPath<FlatTopPeakPipeline>(FLAT_TOP_PEAK, 0.0f);
+}
+
+TEST(StaticSpectrumPipelineTest, BlackmanHarrisLogMatchesDynamicPath) {
+    expectMatchesDynamicPath<BlackmanHarrisLogPipeline>(BLACKMAN_HARRIS_LOG, 1e-3f);
+}
+
+TEST(StaticSpectrumPipelineTest, SpectrumFloorOutsideInputRange) {
+    auto pipeline = std::make_unique<LinearPeakPipeline>();
+    std::vector<float> samples = testSignal(LINEAR_PEAK.fft_size, LINEAR_PEAK.sample_rate, 7);
+    std::vector<float> column(LINEAR_PEAK.height);
+    pipeline->process(samples.data(), column.data());
+
+    auto spectrum = pipeline->spectrum();
+    ASSERT_GT(LinearPeakPipeline::FIRST_BIN, 0u);
+    EXPECT_FLOAT_EQ(spectrum[0], -300.0f);
+    EXPECT_FLOAT_EQ(spectrum[LinearPeakPipeline::NUM_BINS - 1], -300.0f);
+    EXPECT_GT(spectrum[LinearPeakPipeline::FIRST_BIN + 5], -200.0f);
+}
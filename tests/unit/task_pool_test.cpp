@@ -0,0 +1,134 @@
+/**
+ * @file task_pool_test.cpp
+ * @brief Unit tests for TaskPool
+ *
+ * Tests cover:
+ * - Every index runs exactly once, in chunks of the requested size
+ * - Per-worker exclusivity of the worker index
+ * - Inline execution with one thread
+ * - Work stealing around a slow chunk
+ * - Exception propagation and reuse after a failure
+ */
+
+#include <gtest/gtest.h>
+#include <friture/task_pool.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace friture;
+
+// ============================================================================
+// Coverage Tests
+// ============================================================================
+
+TEST(TaskPoolTest, EveryIndexOnce) {
+    TaskPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4u);
+
+    for (size_t count : {size_t(1), size_t(31), size_t(32), size_t(1000)}) {
+        std::vector<std::atomic<int>> hits(count);
+        std::atomic<size_t> oversized{0};
+        pool.parallelFor(count, 32, [&](size_t, size_t begin, size_t end) {
+            if (end - begin > 32) {
+                ++oversized;
+            }
+            for (size_t i = begin; i < end; ++i) {
+                hits[i].fetch_add(1);
+            }
+        });
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(hits[i].load(), 1) << "count " << count << " index " << i;
+        }
+        EXPECT_EQ(oversized.load(), 0u);
+    }
+
+    EXPECT_NO_THROW(pool.parallelFor(0, 8, [](size_t, size_t, size_t) { FAIL(); }));
+    EXPECT_THROW(pool.parallelFor(10, 0, [](size_t, size_t, size_t) {}), std::invalid_argument);
+}
+
+TEST(TaskPoolTest, WorkerIndexIsExclusive) {
+    TaskPool pool(4);
+    std::vector<std::atomic<int>> active(pool.getThreadCount());
+    std::atomic<bool> overlap{false};
+
+    for (int round = 0; round < 20; ++round) {
+        pool.parallelFor(256, 4, [&](size_t worker, size_t, size_t) {
+            ASSERT_LT(worker, pool.getThreadCount());
+            if (active[worker].fetch_add(1) != 0) {
+                overlap = true;
+            }
+            std::this_thread::yield();
+            active[worker].fetch_sub(1);
+        });
+    }
+    EXPECT_FALSE(overlap.load());
+}
+
+TEST(TaskPoolTest, SingleThreadRunsInline) {
+    TaskPool pool(1);
+    EXPECT_EQ(pool.getThreadCount(), 1u);
+
+    const auto caller = std::this_thread::get_id();
+    size_t calls = 0;
+    pool.parallelFor(100, 10, [&](size_t worker, size_t begin, size_t end) {
+        EXPECT_EQ(worker, 0u);
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        EXPECT_EQ(begin, 0u);
+        EXPECT_EQ(end, 100u);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 1u);
+}
+
+// ============================================================================
+// Stealing Tests
+// ============================================================================
+
+TEST(TaskPoolTest, IdleWorkersStealFromSlowOne) {
+    TaskPool pool(4);
+
+    // Worker 0 starts with chunks [0, 16); the first one stalls it, so
+    // the others must take over the rest of its run
+    std::vector<std::atomic<size_t>> ran_on(64);
+    pool.parallelFor(64, 1, [&](size_t worker, size_t begin, size_t) {
+        if (begin == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        ran_on[begin] = worker;
+    });
+
+    size_t moved = 0;
+    for (size_t i = 1; i < 16; ++i) {
+        if (ran_on[i].load() != 0) {
+            ++moved;
+        }
+    }
+    EXPECT_GT(moved, 0u);
+    EXPECT_GT(pool.getStealCount(), 0u);
+}
+
+// ============================================================================
+// Failure Tests
+// ============================================================================
+
+TEST(TaskPoolTest, ExceptionPropagatesAndPoolStaysUsable) {
+    TaskPool pool(3);
+
+    std::atomic<size_t> ran{0};
+    EXPECT_THROW(pool.parallelFor(100, 1, [&](size_t, size_t begin, size_t) {
+        ++ran;
+        if (begin == 7) {
+            throw std::runtime_error("chunk failed");
+        }
+    }), std::runtime_error);
+    EXPECT_LE(ran.load(), 100u);
+
+    std::atomic<size_t> total{0};
+    pool.parallelFor(100, 10, [&](size_t, size_t begin, size_t end) {
+        total += end - begin;
+    });
+    EXPECT_EQ(total.load(), 100u);
+}
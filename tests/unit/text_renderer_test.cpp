@@ -10,6 +10,7 @@
 #include <gtest/gtest.h>
 #include <friture/ui/text_renderer.hpp>
 #include <SDL2/SDL.h>
+#include <string>
 
 using namespace friture;
 
@@ -273,6 +274,125 @@ TEST_F(TextRendererTest, FontCaching_DifferentSizes) {
     SUCCEED();
 }
 
+// ============================================================================
+// Glyph Atlas Tests
+// ============================================================================
+
+TEST_F(TextRendererTest, GlyphAtlas_OnePerFontSize) {
+    TextRenderer text(renderer_);
+
+    if (!text.isValid()) {
+        GTEST_SKIP() << "TextRenderer not initialized";
+    }
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color black = {0, 0, 0, 255};
+    EXPECT_EQ(text.getAtlasCount(), 0u);
+
+    // Every call at one size shares the atlas, whatever the text or color
+    text.renderText("FPS: 60", 10, 10, white, 16);
+    text.renderTextWithShadow("FFT: 4096", 10, 30, white, black, 16, 1);
+    text.renderTextCentered("Centered", 400, 300, {255, 0, 0, 255}, 16);
+    EXPECT_EQ(text.getAtlasCount(), 1u);
+
+    text.renderText("1.0k", 5, 100, white, 12);
+    EXPECT_EQ(text.getAtlasCount(), 2u);
+}
+
+TEST_F(TextRendererTest, LabelCache_ReusesLayouts) {
+    TextRenderer text(renderer_);
+
+    if (!text.isValid()) {
+        GTEST_SKIP() << "TextRenderer not initialized";
+    }
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color black = {0, 0, 0, 255};
+
+    // Static labels drawn every frame are laid out once
+    for (int frame = 0; frame < 10; ++frame) {
+        text.renderTextWithShadow("Scale: Mel", 250, 10, white, black, 16, 1);
+        text.renderText("Press H to close", 10, 10, white, 14);
+    }
+    EXPECT_EQ(text.getCachedLabelCount(), 2u);
+
+    // Changing labels are bounded
+    for (int i = 0; i < static_cast<int>(TextRenderer::MAX_CACHED_LABELS) + 10; ++i) {
+        text.renderText("FPS: " + std::to_string(i), 10, 10, white, 16);
+    }
+    EXPECT_LE(text.getCachedLabelCount(), TextRenderer::MAX_CACHED_LABELS + 1);
+}
+
+TEST_F(TextRendererTest, GlyphAtlas_MeasuresLikeDrawn) {
+    TextRenderer text(renderer_);
+
+    if (!text.isValid()) {
+        GTEST_SKIP() << "TextRenderer not initialized";
+    }
+
+    int w1, h1, w2, h2, w3, h3;
+    ASSERT_TRUE(text.getTextSize("100", 12, w1, h1));
+    ASSERT_TRUE(text.getTextSize("100 Hz", 12, w2, h2));
+    ASSERT_TRUE(text.getTextSize("   ", 12, w3, h3));
+
+    EXPECT_GT(w2, w1);
+    EXPECT_EQ(h1, h2);
+    EXPECT_GT(w3, 0);   // Spaces advance without drawing
+
+    // Characters outside the atlas are drawn as '?', not dropped
+    int wq, hq, wu, hu;
+    ASSERT_TRUE(text.getTextSize("?", 12, wq, hq));
+    ASSERT_TRUE(text.getTextSize("\xb5", 12, wu, hu));
+    EXPECT_EQ(wq, wu);
+    EXPECT_TRUE(text.renderText("   ", 0, 0, {255, 255, 255, 255}, 12));
+}
+
+// ============================================================================
+// Batched Text Tests
+// ============================================================================
+
+TEST_F(TextRendererTest, Batch_TextAndShapesInOneCall) {
+    TextRenderer text(renderer_);
+
+    if (!text.isValid()) {
+        GTEST_SKIP() << "TextRenderer not initialized";
+    }
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color black = {0, 0, 0, 200};
+
+    // Two font sizes share the atlas texture, and plain shapes use its
+    // white cell, so a frame of overlay is one call
+    UiBatch batch(renderer_);
+    text.beginBatch(batch);
+    EXPECT_EQ(batch.getTexture(), text.getAtlasTexture());
+    batch.fillRect({0, 570, 800, 30}, black);
+    EXPECT_TRUE(text.queueTextWithShadow(batch, "FPS: 60", 10, 575, white, black, 16, 1));
+    EXPECT_TRUE(text.queueText(batch, "1.0k", 5, 100, white, 12));
+    EXPECT_TRUE(text.queueTextCentered(batch, "Help", 400, 200, white, 20));
+    batch.drawRect({200, 150, 400, 300}, white);
+
+    // "FPS:60" and its shadow, "1.0k", "Help"; the spaces draw nothing
+    EXPECT_EQ(batch.getQuadCount(), 1u + 2u * 6u + 4u + 4u + 4u);
+    EXPECT_TRUE(batch.flush());
+    EXPECT_EQ(batch.getDrawCallCount(), 1u);
+    EXPECT_EQ(text.getAtlasCount(), 3u);
+}
+
+TEST_F(TextRendererTest, Batch_RequiresAtlasTexture) {
+    TextRenderer text(renderer_);
+
+    if (!text.isValid()) {
+        GTEST_SKIP() << "TextRenderer not initialized";
+    }
+
+    UiBatch batch(renderer_);
+    batch.begin();
+    EXPECT_FALSE(text.queueText(batch, "FPS: 60", 10, 10, {255, 255, 255, 255}, 16));
+    EXPECT_EQ(batch.getQuadCount(), 0u);
+    EXPECT_FALSE(text.getError().empty());
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -0,0 +1,250 @@
+/**
+ * @file trigger_capture_test.cpp
+ * @brief Unit tests for TriggerCapture
+ *
+ * Tests cover:
+ * - Invalid arguments
+ * - Pre- and post-trigger audio written as float WAV (read back by WavReader)
+ * - Multichannel interleaving
+ * - Retriggers extending a running capture
+ * - Pre-trigger audio older than the ring, and stop with partial post-trigger audio
+ * - File numbering that never overwrites earlier captures
+ */
+
+#include <gtest/gtest.h>
+#include <friture/audio/trigger_capture.hpp>
+#include <friture/audio/wav_reader.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 8000;
+constexpr size_t RING_SECONDS = 6;
+
+// Capture waits are bounded; the writer polls every 50 ms
+constexpr auto WAIT_LIMIT = std::chrono::seconds(10);
+
+class TriggerCaptureTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() / "friture_trigger_capture_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+        ring_ = std::make_unique<RingBuffer<float>>(SAMPLE_RATE * RING_SECONDS);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    TriggerCapture::Options makeOptions(float pre, float post) const {
+        TriggerCapture::Options options;
+        options.pre_trigger_seconds = pre;
+        options.post_trigger_seconds = post;
+        options.chunk_seconds = 0.1f;
+        options.directory = dir_.string();
+        return options;
+    }
+
+    // Sample n of the stream is n (and -n in the second channel)
+    static void writeRamp(RingBuffer<float>& ring, uint64_t& written, size_t count, float sign = 1.0f) {
+        std::vector<float> block(count);
+        for (size_t i = 0; i < count; ++i) {
+            block[i] = sign * static_cast<float>(written + i);
+        }
+        ring.write(block.data(), count);
+        written += count;
+    }
+
+    static bool waitFor(const TriggerCapture& capture, uint64_t files) {
+        const auto deadline = std::chrono::steady_clock::now() + WAIT_LIMIT;
+        while (capture.getCapturesWritten() < files) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+    std::vector<float> readCapture(const std::string& path, size_t& channels) const {
+        WavReader reader;
+        EXPECT_TRUE(reader.open(path.c_str())) << reader.getError();
+        EXPECT_EQ(reader.getSampleRate(), static_cast<float>(SAMPLE_RATE));
+        channels = reader.getChannelCount();
+        std::vector<float> samples(reader.getFrameCount() * channels);
+        reader.readInterleaved(0, samples.data(), reader.getFrameCount());
+        return samples;
+    }
+
+    std::filesystem::path dir_;
+    std::unique_ptr<RingBuffer<float>> ring_;
+};
+
+} // namespace
+
+TEST_F(TriggerCaptureTest, InvalidArgumentsThrow) {
+    const RingBuffer<float>* ring = ring_.get();
+    EXPECT_THROW(TriggerCapture({}, SAMPLE_RATE), std::invalid_argument);
+    EXPECT_THROW(TriggerCapture({nullptr}, SAMPLE_RATE), std::invalid_argument);
+    EXPECT_THROW(TriggerCapture({ring}, 0), std::invalid_argument);
+    EXPECT_THROW(TriggerCapture({ring}, SAMPLE_RATE, makeOptions(-1.0f, 1.0f)), std::invalid_argument);
+    EXPECT_THROW(TriggerCapture({ring}, SAMPLE_RATE, makeOptions(1.0f, -1.0f)), std::invalid_argument);
+
+    auto options = makeOptions(1.0f, 1.0f);
+    options.chunk_seconds = 0.0f;
+    EXPECT_THROW(TriggerCapture({ring}, SAMPLE_RATE, options), std::invalid_argument);
+    options = makeOptions(1.0f, 1.0f);
+    options.max_seconds = 1.5f;
+    EXPECT_THROW(TriggerCapture({ring}, SAMPLE_RATE, options), std::invalid_argument);
+
+    // The ring holds 6 s: pre-trigger time plus one chunk must fit
+    EXPECT_THROW(TriggerCapture({ring}, SAMPLE_RATE, makeOptions(6.0f, 1.0f)), std::invalid_argument);
+    EXPECT_NO_THROW(TriggerCapture({ring}, SAMPLE_RATE, makeOptions(5.5f, 1.0f)));
+}
+
+TEST_F(TriggerCaptureTest, WritesPreAndPostTriggerAudio) {
+    uint64_t written = 0;
+    writeRamp(*ring_, written, 3 * SAMPLE_RATE);
+
+    TriggerCapture capture({ring_.get()}, SAMPLE_RATE, makeOptions(1.0f, 0.5f));
+    capture.trigger(2 * SAMPLE_RATE);
+
+    // The post-trigger audio arrives later, in callback-sized blocks
+    for (int block = 0; block < 20; ++block) {
+        writeRamp(*ring_, written, 512);
+    }
+    ASSERT_TRUE(waitFor(capture, 1));
+    EXPECT_EQ(capture.getLastPath(), (dir_ / "capture-0001.wav").string());
+    EXPECT_EQ(capture.getSamplesLost(), 0u);
+    EXPECT_TRUE(capture.getError().empty());
+
+    size_t channels = 0;
+    const std::vector<float> samples = readCapture(capture.getLastPath(), channels);
+    ASSERT_EQ(channels, 1u);
+    ASSERT_EQ(samples.size(), 12000u);   // 1 s before, 0.5 s after
+    for (size_t i = 0; i < samples.size(); ++i) {
+        ASSERT_EQ(samples[i], static_cast<float>(8000 + i)) << "frame " << i;
+    }
+}
+
+TEST_F(TriggerCaptureTest, InterleavesChannels) {
+    RingBuffer<float> second(SAMPLE_RATE * RING_SECONDS);
+    uint64_t written = 0;
+    uint64_t written_second = 0;
+    // Channels are published in order, the last one decides what is complete
+    writeRamp(second, written_second, 2 * SAMPLE_RATE, -1.0f);
+    writeRamp(*ring_, written, 2 * SAMPLE_RATE);
+
+    TriggerCapture capture({&second, ring_.get()}, SAMPLE_RATE, makeOptions(0.5f, 0.25f));
+    capture.trigger(SAMPLE_RATE);
+    ASSERT_TRUE(waitFor(capture, 1));
+
+    size_t channels = 0;
+    const std::vector<float> samples = readCapture(capture.getLastPath(), channels);
+    ASSERT_EQ(channels, 2u);
+    ASSERT_EQ(samples.size(), 2u * 6000u);
+    for (size_t i = 0; i < 6000; ++i) {
+        ASSERT_EQ(samples[2 * i], -static_cast<float>(4000 + i)) << "frame " << i;
+        ASSERT_EQ(samples[2 * i + 1], static_cast<float>(4000 + i)) << "frame " << i;
+    }
+}
+
+TEST_F(TriggerCaptureTest, RetriggerExtendsCapture) {
+    uint64_t written = 0;
+    writeRamp(*ring_, written, 2 * SAMPLE_RATE);
+
+    TriggerCapture capture({ring_.get()}, SAMPLE_RATE, makeOptions(0.5f, 0.5f));
+    capture.trigger(2 * SAMPLE_RATE);
+
+    // Post-trigger audio is missing, so the capture stays open
+    const auto deadline = std::chrono::steady_clock::now() + WAIT_LIMIT;
+    while (!capture.isCapturing()) {
+        ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    capture.trigger(2 * SAMPLE_RATE + 3000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    writeRamp(*ring_, written, 2 * SAMPLE_RATE);
+    ASSERT_TRUE(waitFor(capture, 1));
+
+    size_t channels = 0;
+    const std::vector<float> samples = readCapture(capture.getLastPath(), channels);
+    ASSERT_EQ(samples.size(), 4000u + 3000u + 4000u);
+    EXPECT_EQ(samples.front(), 12000.0f);
+    EXPECT_EQ(samples.back(), 22999.0f);
+    EXPECT_EQ(capture.getCapturesWritten(), 1u);
+}
+
+TEST_F(TriggerCaptureTest, StartsAtOldestSampleStillInRing) {
+    uint64_t written = 0;
+    writeRamp(*ring_, written, 10 * SAMPLE_RATE);
+
+    // 3 s before a trigger 5 s ago: the ring (6 s, less one chunk of
+    // headroom) only reaches back to 10 - 5.9 s
+    TriggerCapture capture({ring_.get()}, SAMPLE_RATE, makeOptions(3.0f, 0.5f));
+    capture.trigger(5 * SAMPLE_RATE);
+    ASSERT_TRUE(waitFor(capture, 1));
+
+    size_t channels = 0;
+    const std::vector<float> samples = readCapture(capture.getLastPath(), channels);
+    ASSERT_FALSE(samples.empty());
+    const float first = samples.front();
+    EXPECT_GE(first, 32800.0f);
+    EXPECT_LT(first, 40000.0f);
+    EXPECT_EQ(samples.back(), 43999.0f);
+    for (size_t i = 1; i < samples.size(); ++i) {
+        ASSERT_EQ(samples[i], first + static_cast<float>(i)) << "frame " << i;
+    }
+}
+
+TEST_F(TriggerCaptureTest, StopFinishesWithAvailableAudio) {
+    uint64_t written = 0;
+    writeRamp(*ring_, written, 2 * SAMPLE_RATE + 1000);
+
+    TriggerCapture capture({ring_.get()}, SAMPLE_RATE, makeOptions(1.0f, 2.0f));
+    capture.trigger(2 * SAMPLE_RATE);
+    capture.stop();
+    capture.stop();
+
+    ASSERT_EQ(capture.getCapturesWritten(), 1u);
+    EXPECT_FALSE(capture.isCapturing());
+    size_t channels = 0;
+    const std::vector<float> samples = readCapture(capture.getLastPath(), channels);
+    ASSERT_EQ(samples.size(), 9000u);
+    EXPECT_EQ(samples.front(), 8000.0f);
+    EXPECT_EQ(samples.back(), 16999.0f);
+}
+
+TEST_F(TriggerCaptureTest, NumbersFilesWithoutOverwriting) {
+    uint64_t written = 0;
+    writeRamp(*ring_, written, 2 * SAMPLE_RATE);
+    {
+        std::ofstream existing(dir_ / "take-0001.wav");
+        existing << "keep";
+    }
+
+    auto options = makeOptions(0.1f, 0.1f);
+    options.prefix = "take";
+    TriggerCapture capture({ring_.get()}, SAMPLE_RATE, options);
+    capture.trigger(SAMPLE_RATE);
+    ASSERT_TRUE(waitFor(capture, 1));
+    EXPECT_EQ(capture.getLastPath(), (dir_ / "take-0002.wav").string());
+    capture.trigger(SAMPLE_RATE);
+    ASSERT_TRUE(waitFor(capture, 2));
+    EXPECT_EQ(capture.getLastPath(), (dir_ / "take-0003.wav").string());
+
+    std::ifstream existing(dir_ / "take-0001.wav");
+    std::string content;
+    existing >> content;
+    EXPECT_EQ(content, "keep");
+}
@@ -0,0 +1,116 @@
+/**
+ * @file ui_batch_test.cpp
+ * @brief Unit tests for UiBatch
+ *
+ * Tests cover:
+ * - Rectangles, outlines and lines queued as quads
+ * - One draw call per flush, none for an empty batch
+ * - Degenerate shapes skipped
+ *
+ * Headless (dummy video driver, software renderer): the geometry is
+ * checked, not the pixels.
+ */
+
+#include <gtest/gtest.h>
+#include <friture/ui/ui_batch.hpp>
+#include <SDL2/SDL.h>
+
+using namespace friture;
+
+class UiBatchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+        if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+            GTEST_SKIP() << "SDL_Init failed: " << SDL_GetError();
+        }
+
+        window_ = SDL_CreateWindow("Test", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                                   800, 600, SDL_WINDOW_HIDDEN);
+        if (!window_) {
+            SDL_Quit();
+            GTEST_SKIP() << "SDL_CreateWindow failed: " << SDL_GetError();
+        }
+
+        renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_SOFTWARE);
+        if (!renderer_) {
+            SDL_DestroyWindow(window_);
+            SDL_Quit();
+            GTEST_SKIP() << "SDL_CreateRenderer failed: " << SDL_GetError();
+        }
+    }
+
+    void TearDown() override {
+        if (renderer_) {
+            SDL_DestroyRenderer(renderer_);
+        }
+        if (window_) {
+            SDL_DestroyWindow(window_);
+        }
+        SDL_Quit();
+    }
+
+    SDL_Window* window_ = nullptr;
+    SDL_Renderer* renderer_ = nullptr;
+};
+
+TEST_F(UiBatchTest, ShapesDrawInOneCall) {
+    const SDL_Color gray = {100, 100, 100, 255};
+    UiBatch batch(renderer_);
+    batch.begin();
+
+    batch.fillRect({0, 570, 800, 30}, {0, 0, 0, 200});
+    batch.drawRect({660, 550, 120, 12}, gray);       // Four edges
+    batch.drawLine(700, 550, 700, 561, gray);        // Vertical tick
+    batch.drawLine(0, 300, 799, 300, gray);          // Lane separator
+    batch.drawLine(10, 10, 50, 40, gray);            // Diagonal
+    EXPECT_EQ(batch.getQuadCount(), 8u);
+
+    EXPECT_TRUE(batch.flush());
+    EXPECT_EQ(batch.getDrawCallCount(), 1u);
+    EXPECT_EQ(batch.getLastQuadCount(), 8u);
+    EXPECT_EQ(batch.getQuadCount(), 0u);
+
+    // Storage is reused for the next frame
+    batch.begin();
+    batch.fillRect({0, 0, 10, 10}, gray);
+    EXPECT_TRUE(batch.flush());
+    EXPECT_EQ(batch.getDrawCallCount(), 2u);
+    EXPECT_EQ(batch.getLastQuadCount(), 1u);
+}
+
+TEST_F(UiBatchTest, EmptyBatchDrawsNothing) {
+    UiBatch batch(renderer_);
+    batch.begin();
+    EXPECT_TRUE(batch.flush());
+    EXPECT_EQ(batch.getDrawCallCount(), 0u);
+    EXPECT_EQ(batch.getLastQuadCount(), 0u);
+}
+
+TEST_F(UiBatchTest, DegenerateShapesAreSkipped) {
+    const SDL_Color white = {255, 255, 255, 255};
+    UiBatch batch(renderer_);
+    batch.begin();
+
+    batch.fillRect({10, 10, 0, 5}, white);
+    batch.fillRect({10, 10, 5, -1}, white);
+    batch.drawRect({10, 10, 0, 0}, white);
+    EXPECT_EQ(batch.getQuadCount(), 0u);
+
+    // Thin outlines do not draw a pixel twice
+    batch.drawRect({10, 10, 5, 1}, white);
+    EXPECT_EQ(batch.getQuadCount(), 1u);
+    batch.drawRect({10, 10, 5, 2}, white);
+    EXPECT_EQ(batch.getQuadCount(), 3u);
+    batch.drawRect({10, 10, 1, 5}, white);
+    EXPECT_EQ(batch.getQuadCount(), 6u);
+
+    // A point is one pixel
+    batch.drawLine(3, 3, 3, 3, white);
+    EXPECT_EQ(batch.getQuadCount(), 7u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
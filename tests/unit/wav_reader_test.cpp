@@ -0,0 +1,422 @@
+/**
+ * @file wav_reader_test.cpp
+ * @brief Unit tests for WavReader
+ */
+
+#include <friture/audio/wav_reader.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace friture;
+
+// ============================================================================
+// WAV Image Helpers
+// ============================================================================
+
+/**
+ * @brief Build WAV files byte by byte, so headers can be bent on purpose
+ */
+class WavBuilder {
+public:
+    void u16(uint16_t v) { bytes.push_back(v & 0xFF); bytes.push_back(v >> 8); }
+    void u32(uint32_t v) { u16(v & 0xFFFF); u16(v >> 16); }
+    void tag(const char* id) { bytes.insert(bytes.end(), id, id + 4); }
+
+    void riff() {
+        tag("RIFF");
+        u32(0);  // Patched by write()
+        tag("WAVE");
+    }
+
+    void fmt(uint16_t format, uint16_t channels, uint32_t rate, uint16_t bits) {
+        tag("fmt ");
+        u32(16);
+        fmtBody(format, channels, rate, bits);
+    }
+
+    void fmtExtensible(uint16_t sub_format, uint16_t channels, uint32_t rate, uint16_t bits) {
+        tag("fmt ");
+        u32(40);
+        fmtBody(0xFFFE, channels, rate, bits);
+        u16(22);                // cbSize
+        u16(bits);              // wValidBitsPerSample
+        u32(0);                 // dwChannelMask
+        u16(sub_format);        // SubFormat GUID, first two bytes carry the code
+        static const uint8_t guid_tail[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80,
+                                              0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+        bytes.insert(bytes.end(), guid_tail, guid_tail + 14);
+    }
+
+    void chunk(const char* id, size_t size) {
+        tag(id);
+        u32(static_cast<uint32_t>(size));
+        bytes.insert(bytes.end(), size + (size % 2), 0);
+    }
+
+    void data(const std::vector<uint8_t>& payload, uint32_t declared_size) {
+        tag("data");
+        u32(declared_size);
+        bytes.insert(bytes.end(), payload.begin(), payload.end());
+    }
+
+    void data(const std::vector<uint8_t>& payload) {
+        data(payload, static_cast<uint32_t>(payload.size()));
+    }
+
+    bool write(const char* filename) {
+        uint32_t riff_size = static_cast<uint32_t>(bytes.size() - 8);
+        std::memcpy(bytes.data() + 4, &riff_size, 4);
+
+        FILE* fp = fopen(filename, "wb");
+        if (!fp) return false;
+        bool ok = fwrite(bytes.data(), 1, bytes.size(), fp) == bytes.size();
+        fclose(fp);
+        return ok;
+    }
+
+    std::vector<uint8_t> bytes;
+
+private:
+    void fmtBody(uint16_t format, uint16_t channels, uint32_t rate, uint16_t bits) {
+        u16(format);
+        u16(channels);
+        u32(rate);
+        u32(rate * channels * bits / 8);
+        u16(static_cast<uint16_t>(channels * bits / 8));
+        u16(bits);
+    }
+};
+
+std::vector<uint8_t> pcm16(const std::vector<int16_t>& samples) {
+    std::vector<uint8_t> out(samples.size() * 2);
+    std::memcpy(out.data(), samples.data(), out.size());
+    return out;
+}
+
+// ============================================================================
+// Test Fixtures
+// ============================================================================
+
+class WavReaderTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        remove(path_);
+    }
+
+    bool openBuilt(WavBuilder& builder) {
+        return builder.write(path_) && reader_.open(path_);
+    }
+
+    const char* path_ = "/tmp/test_wav_reader.wav";
+    WavReader reader_;
+};
+
+// ============================================================================
+// Decoding Tests
+// ============================================================================
+
+TEST_F(WavReaderTest, DecodesPCM16) {
+    WavBuilder b;
+    b.riff();
+    b.fmt(1, 1, 48000, 16);
+    b.data(pcm16({0, 16384, -16384, 32767, -32768}));
+    ASSERT_TRUE(openBuilt(b));
+
+    EXPECT_EQ(reader_.getFrameCount(), 5u);
+    EXPECT_EQ(reader_.getChannelCount(), 1u);
+    EXPECT_FLOAT_EQ(reader_.getSampleRate(), 48000.0f);
+
+    float out[5];
+    EXPECT_EQ(reader_.readMono(0, out, 5), 5u);
+    EXPECT_FLOAT_EQ(out[0], 0.0f);
+    EXPECT_FLOAT_EQ(out[1], 0.5f);
+    EXPECT_FLOAT_EQ(out[2], -0.5f);
+    EXPECT_FLOAT_EQ(out[3], 32767.0f / 32768.0f);
+    EXPECT_FLOAT_EQ(out[4], -1.0f);
+}
+
+TEST_F(WavReaderTest, DecodesPCM24WithSignExtension) {
+    WavBuilder b;
+    b.riff();
+    b.fmt(1, 1, 48000, 24);
+    // 0x400000 = +0.5, 0xC00000 = -0.5, 0xFFFFFF = -1 LSB
+    b.data({0x00, 0x00, 0x40, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0xFF});
+    ASSERT_TRUE(openBuilt(b));
+
+    float out[3];
+    ASSERT_EQ(reader_.readMono(0, out, 3), 3u);
+    EXPECT_FLOAT_EQ(out[0], 0.5f);
+    EXPECT_FLOAT_EQ(out[1], -0.5f);
+    EXPECT_FLOAT_EQ(out[2], -1.0f / 8388608.0f);
+}
+
+TEST_F(WavReaderTest, DecodesPCM32AndFloat32) {
+    {
+        WavBuilder b;
+        b.riff();
+        b.fmt(1, 1, 44100, 32);
+        b.data({0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x80});  // 2^30, -2^31
+        ASSERT_TRUE(openBuilt(b));
+
+        float out[2];
+        ASSERT_EQ(reader_.readMono(0, out, 2), 2u);
+        EXPECT_FLOAT_EQ(out[0], 0.5f);
+        EXPECT_FLOAT_EQ(out[1], -1.0f);
+    }
+    {
+        const float values[3] = {0.25f, -0.75f, 1.0f};
+        std::vector<uint8_t> payload(sizeof(values));
+        std::memcpy(payload.data(), values, sizeof(values));
+
+        WavBuilder b;
+        b.riff();
+        b.fmt(3, 1, 44100, 32);
+        b.data(payload);
+        ASSERT_TRUE(openBuilt(b));
+
+        float out[3];
+        ASSERT_EQ(reader_.readMono(0, out, 3), 3u);
+        EXPECT_FLOAT_EQ(out[0], 0.25f);
+        EXPECT_FLOAT_EQ(out[1], -0.75f);
+        EXPECT_FLOAT_EQ(out[2], 1.0f);
+    }
+}
+
+// ============================================================================
+// Channel Access Tests
+// ============================================================================
+
+TEST_F(WavReaderTest, ReadMonoAveragesChannels) {
+    WavBuilder b;
+    b.riff();
+    b.fmt(1, 2, 48000, 16);
+    b.data(pcm16({16384, 0, -16384, -16384, 8192, 24576}));
+    ASSERT_TRUE(openBuilt(b));
+
+    float out[3];
+    ASSERT_EQ(reader_.readMono(0, out, 3), 3u);
+    EXPECT_FLOAT_EQ(out[0], 0.25f);
+    EXPECT_FLOAT_EQ(out[1], -0.5f);
+    EXPECT_FLOAT_EQ(out[2], 0.5f);
+}
+
+TEST_F(WavReaderTest, ReadChannelAndInterleaved) {
+    WavBuilder b;
+    b.riff();
+    b.fmt(1, 3, 48000, 16);
+    b.data(pcm16({100, 200, 300, 101, 201, 301}));
+    ASSERT_TRUE(openBuilt(b));
+
+    constexpr float s = 1.0f / 32768.0f;
+    float out[2];
+    for (size_t c = 0; c < 3; ++c) {
+        ASSERT_EQ(reader_.readChannel(c, 0, out, 2), 2u);
+        EXPECT_FLOAT_EQ(out[0], (100.0f * (c + 1)) * s);
+        EXPECT_FLOAT_EQ(out[1], (100.0f * (c + 1) + 1.0f) * s);
+    }
+    EXPECT_EQ(reader_.readChannel(3, 0, out, 2), 0u);
+
+    float frames[6];
+    ASSERT_EQ(reader_.readInterleaved(0, frames, 2), 2u);
+    EXPECT_FLOAT_EQ(frames[2], 300.0f * s);
+    EXPECT_FLOAT_EQ(frames[3], 101.0f * s);
+}
+
+TEST_F(WavReaderTest, ChunkedDecodeMatchesAcrossBoundaries) {
+    // Long enough that the multichannel paths take several scratch chunks
+    constexpr size_t frames = 1000;
+    constexpr size_t channels = 4;
+    std::vector<int16_t> samples(frames * channels);
+    for (size_t i = 0; i < frames; ++i) {
+        for (size_t c = 0; c < channels; ++c) {
+            samples[i * channels + c] = static_cast<int16_t>((i * 7 + c * 1000) % 30000);
+        }
+    }
+
+    WavBuilder b;
+    b.riff();
+    b.fmt(1, channels, 48000, 16);
+    b.data(pcm16(samples));
+    ASSERT_TRUE(openBuilt(b));
+
+    std::vector<float> channel(frames - 3);
+    std::vector<float> mono(frames - 3);
+    ASSERT_EQ(reader_.readChannel(2, 3, channel.data(), channel.size()), channel.size());
+    ASSERT_EQ(reader_.readMono(3, mono.data(), mono.size()), mono.size());
+
+    for (size_t i = 0; i < channel.size(); ++i) {
+        const size_t frame = i + 3;
+        ASSERT_FLOAT_EQ(channel[i], samples[frame * channels + 2] / 32768.0f) << "frame " << frame;
+
+        float sum = 0.0f;
+        for (size_t c = 0; c < channels; ++c) {
+            sum += samples[frame * channels + c] / 32768.0f;
+        }
+        ASSERT_NEAR(mono[i], sum / channels, 1e-6f) << "frame " << frame;
+    }
+}
+
+TEST_F(WavReaderTest, ReadsAreClampedToTheFile) {
+    WavBuilder b;
+    b.riff();
+    b.fmt(1, 1, 48000, 16);
+    b.data(pcm16({1, 2, 3, 4}));
+    ASSERT_TRUE(openBuilt(b));
+
+    float out[8] = {};
+    EXPECT_EQ(reader_.readMono(2, out, 8), 2u);
+    EXPECT_FLOAT_EQ(out[1], 4.0f / 32768.0f);
+    EXPECT_EQ(reader_.readMono(4, out, 8), 0u);
+    EXPECT_EQ(reader_.readMono(1000, out, 8), 0u);
+}
+
+// ============================================================================
+// Header Variant Tests
+// ============================================================================
+
+TEST_F(WavReaderTest, AcceptsExtensibleHeader) {
+    WavBuilder b;
+    b.riff();
+    b.fmtExtensible(1, 2, 96000, 24);
+    b.data({0x00, 0x00, 0x40, 0x00, 0x00, 0xC0});
+    ASSERT_TRUE(openBuilt(b));
+
+    EXPECT_EQ(reader_.getInfo().audio_format, 1);
+    EXPECT_EQ(reader_.getChannelCount(), 2u);
+    EXPECT_FLOAT_EQ(reader_.getSampleRate(), 96000.0f);
+
+    float left;
+    float right;
+    ASSERT_EQ(reader_.readChannel(0, 0, &left, 1), 1u);
+    ASSERT_EQ(reader_.readChannel(1, 0, &right, 1), 1u);
+    EXPECT_FLOAT_EQ(left, 0.5f);
+    EXPECT_FLOAT_EQ(right, -0.5f);
+}
+
+TEST_F(WavReaderTest, SkipsOddSizedMetadataChunks) {
+    WavBuilder b;
+    b.riff();
+    b.chunk("LIST", 5);         // Padded to 6 bytes
+    b.fmt(1, 1, 48000, 16);
+    b.chunk("bext", 3);
+    b.data(pcm16({8192}));
+    ASSERT_TRUE(openBuilt(b));
+
+    float out;
+    ASSERT_EQ(reader_.readMono(0, &out, 1), 1u);
+    EXPECT_FLOAT_EQ(out, 0.25f);
+}
+
+TEST_F(WavReaderTest, TruncatesOversizedDataChunk) {
+    // Header claims a second of audio, file holds 3 frames and a partial one
+    WavBuilder b;
+    b.riff();
+    b.fmt(1, 2, 48000, 16);
+    std::vector<uint8_t> payload = pcm16({1, 2, 3, 4, 5, 6});
+    payload.push_back(0x7F);
+    b.data(payload, 48000 * 4);
+    ASSERT_TRUE(openBuilt(b));
+
+    EXPECT_EQ(reader_.getFrameCount(), 3u);
+    EXPECT_EQ(reader_.getInfo().num_samples, 3u);
+
+    float out[4];
+    EXPECT_EQ(reader_.readChannel(1, 0, out, 4), 3u);
+    EXPECT_FLOAT_EQ(out[2], 6.0f / 32768.0f);
+}
+
+// ============================================================================
+// Error Handling Tests
+// ============================================================================
+
+TEST_F(WavReaderTest, RejectsBadFiles) {
+    EXPECT_FALSE(reader_.open("/nonexistent/file.wav"));
+    EXPECT_FALSE(reader_.getError().empty());
+    EXPECT_FALSE(reader_.isOpen());
+
+    {
+        WavBuilder b;
+        b.tag("RIFX");
+        b.u32(0);
+        b.tag("WAVE");
+        EXPECT_FALSE(openBuilt(b));
+    }
+    {
+        WavBuilder b;  // 8-bit PCM is not supported
+        b.riff();
+        b.fmt(1, 1, 8000, 8);
+        b.data({0x80, 0x80});
+        EXPECT_FALSE(openBuilt(b));
+        EXPECT_NE(reader_.getError().find("Unsupported"), std::string::npos);
+    }
+    {
+        WavBuilder b;
+        b.riff();
+        b.fmt(1, AudioFileLoader::MAX_CHANNELS + 1, 48000, 16);
+        b.data(pcm16({0}));
+        EXPECT_FALSE(openBuilt(b));
+    }
+    {
+        WavBuilder b;
+        b.riff();
+        b.data(pcm16({0}));
+        EXPECT_FALSE(openBuilt(b));
+    }
+    {
+        WavBuilder b;
+        b.riff();
+        b.fmt(1, 1, 48000, 16);
+        EXPECT_FALSE(openBuilt(b));
+        EXPECT_NE(reader_.getError().find("data"), std::string::npos);
+    }
+    EXPECT_FALSE(reader_.isOpen());
+}
+
+TEST_F(WavReaderTest, CloseAndReopen) {
+    WavBuilder b;
+    b.riff();
+    b.fmt(1, 1, 48000, 16);
+    b.data(pcm16({1, 2, 3}));
+    ASSERT_TRUE(openBuilt(b));
+
+    reader_.close();
+    EXPECT_FALSE(reader_.isOpen());
+    EXPECT_EQ(reader_.getFrameCount(), 0u);
+
+    float out[3];
+    EXPECT_EQ(reader_.readMono(0, out, 3), 0u);
+
+    ASSERT_TRUE(reader_.open(path_));
+    EXPECT_EQ(reader_.readMono(0, out, 3), 3u);
+}
+
+TEST_F(WavReaderTest, ReleasedFramesStayReadable) {
+    // Several pages of audio, released in steps and read again afterwards
+    std::vector<int16_t> samples(40000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<int16_t>(i % 20000);
+    }
+
+    WavBuilder b;
+    b.riff();
+    b.fmt(1, 1, 48000, 16);
+    b.data(pcm16(samples));
+    ASSERT_TRUE(openBuilt(b));
+
+    std::vector<float> out(samples.size());
+    for (uint64_t pos = 0; pos < samples.size(); pos += 5000) {
+        reader_.readMono(pos, out.data() + pos, 5000);
+        reader_.releaseBefore(pos + 5000);
+    }
+    reader_.releaseBefore(0);  // Rewind
+
+    std::vector<float> again(samples.size());
+    ASSERT_EQ(reader_.readMono(0, again.data(), again.size()), samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        ASSERT_EQ(again[i], out[i]) << "frame " << i;
+        ASSERT_FLOAT_EQ(again[i], samples[i] / 32768.0f) << "frame " << i;
+    }
+}
@@ -0,0 +1,207 @@
+/**
+ * @file window_functions_test.cpp
+ * @brief Unit tests for the shared window tables
+ *
+ * Tests cover:
+ * - Cache: one table per (window, size, Kaiser β), shared by processors
+ * - Coefficients: original Hann/Hamming values, symmetry, Kaiser limits
+ * - Coherent gain correction: same tone level with every window
+ * - Flat-top scalloping, Blackman-Harris sidelobes
+ * - Chains: Kaiser β in the key, sliding DFT only for two-term windows
+ */
+
+#define _USE_MATH_DEFINES  // For M_PI on Windows/MSVC
+#include <gtest/gtest.h>
+#include <friture/window_functions.hpp>
+#include <friture/fft_processor.hpp>
+#include <friture/processing_chain.hpp>
+#include <friture/sliding_dft.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr size_t FFT_SIZE = 4096;
+constexpr WindowFunction ALL_WINDOWS[] = {WindowFunction::Hann, WindowFunction::Hamming,
+                                          WindowFunction::BlackmanHarris, WindowFunction::FlatTop,
+                                          WindowFunction::Kaiser};
+
+// Sine at a fractional bin, amplitude 0.5
+std::vector<float> sineAtBin(double bin) {
+    std::vector<float> signal(FFT_SIZE);
+    for (size_t i = 0; i < FFT_SIZE; ++i) {
+        signal[i] = static_cast<float>(0.5 * std::sin(2.0 * PI * bin * static_cast<double>(i) / FFT_SIZE));
+    }
+    return signal;
+}
+
+float peakDb(WindowFunction window, double bin) {
+    FFTProcessor processor(FFT_SIZE, window);
+    processor.setExactLog10(true);
+    std::vector<float> spectrum(processor.getNumBins());
+    const std::vector<float> signal = sineAtBin(bin);
+    processor.process(signal.data(), spectrum.data());
+    return *std::max_element(spectrum.begin(), spectrum.end());
+}
+
+} // namespace
+
+// ============================================================================
+// Cache Tests
+// ============================================================================
+
+TEST(WindowFunctionsTest, TablesAreShared) {
+    const WindowTable a = windowTable(WindowFunction::BlackmanHarris, 1024);
+    const WindowTable b = windowTable(WindowFunction::BlackmanHarris, 1024);
+    EXPECT_EQ(a.data(), b.data());
+    EXPECT_NE(windowTable(WindowFunction::BlackmanHarris, 2048).data(), a.data());
+    EXPECT_NE(windowTable(WindowFunction::FlatTop, 1024).data(), a.data());
+
+    // β only matters for Kaiser
+    EXPECT_EQ(windowTable(WindowFunction::Hann, 1024, 3.0f).data(),
+              windowTable(WindowFunction::Hann, 1024, 9.0f).data());
+    EXPECT_NE(windowTable(WindowFunction::Kaiser, 1024, 3.0f).data(),
+              windowTable(WindowFunction::Kaiser, 1024, 9.0f).data());
+
+    // Processors hold the cached table rather than a copy
+    FFTProcessor first(1024, WindowFunction::FlatTop);
+    FFTProcessor second(1024, WindowFunction::Hann);
+    second.setWindowFunction(WindowFunction::FlatTop);
+    EXPECT_EQ(first.getWindow().data(), second.getWindow().data());
+    EXPECT_EQ(first.getWindow().data(), windowTable(WindowFunction::FlatTop, 1024).data());
+}
+
+TEST(WindowFunctionsTest, InvalidParametersThrow) {
+    EXPECT_THROW(windowTable(WindowFunction::Hann, 1), std::invalid_argument);
+    EXPECT_THROW(windowTable(WindowFunction::Kaiser, 1024, -1.0f), std::invalid_argument);
+    EXPECT_THROW(windowTable(WindowFunction::Kaiser, 1024, MAX_KAISER_BETA + 1.0f), std::invalid_argument);
+    EXPECT_THROW(FFTProcessor(1024, WindowFunction::Kaiser, -1.0f), std::invalid_argument);
+
+    FFTProcessor processor(1024, WindowFunction::Hann);
+    EXPECT_THROW(processor.setWindowFunction(WindowFunction::Kaiser, 100.0f), std::invalid_argument);
+    EXPECT_EQ(processor.getWindowFunction(), WindowFunction::Hann);
+}
+
+// ============================================================================
+// Coefficient Tests
+// ============================================================================
+
+TEST(WindowFunctionsTest, HannAndHammingKeepOriginalValues) {
+    const WindowTable hann = windowTable(WindowFunction::Hann, 512);
+    const WindowTable hamming = windowTable(WindowFunction::Hamming, 512);
+    const float n = 511.0f;
+    for (size_t i = 0; i < 512; ++i) {
+        ASSERT_EQ(hann.data()[i], static_cast<float>(0.5f * (1.0f - std::cos(2.0f * M_PI * i / n)))) << i;
+        ASSERT_EQ(hamming.data()[i], static_cast<float>(0.54f - 0.46f * std::cos(2.0f * M_PI * i / n))) << i;
+    }
+}
+
+TEST(WindowFunctionsTest, WindowsAreSymmetricWithKnownGains) {
+    for (WindowFunction window : ALL_WINDOWS) {
+        const WindowTable table = windowTable(window, 1024);
+        for (size_t i = 0; i < 512; ++i) {
+            ASSERT_NEAR(table.data()[i], table.data()[1023 - i], 1e-6f) << toString(window) << " " << i;
+        }
+        EXPECT_NEAR(table.data()[511], 1.0f, 1e-4f) << toString(window);   // Next to the centre
+    }
+
+    // Coherent gain ≈ a0 of the cosine sums
+    EXPECT_NEAR(windowTable(WindowFunction::Hann, 4096).coherent_gain, 0.5f, 1e-3f);
+    EXPECT_NEAR(windowTable(WindowFunction::Hamming, 4096).coherent_gain, 0.54f, 1e-3f);
+    EXPECT_NEAR(windowTable(WindowFunction::BlackmanHarris, 4096).coherent_gain, 0.35875f, 1e-3f);
+    EXPECT_NEAR(windowTable(WindowFunction::FlatTop, 4096).coherent_gain, 0.21557895f, 1e-3f);
+}
+
+TEST(WindowFunctionsTest, KaiserLimits) {
+    // β = 0 is rectangular
+    const WindowTable rectangular = windowTable(WindowFunction::Kaiser, 256, 0.0f);
+    for (size_t i = 0; i < 256; ++i) {
+        ASSERT_FLOAT_EQ(rectangular.data()[i], 1.0f);
+    }
+    EXPECT_FLOAT_EQ(rectangular.coherent_gain, 1.0f);
+
+    // Edges are 1 / I0(β); I0(8.6) ≈ 750.5
+    const WindowTable kaiser = windowTable(WindowFunction::Kaiser, 256, DEFAULT_KAISER_BETA);
+    EXPECT_NEAR(kaiser.data()[0], 1.0f / 750.5f, 1e-5f);
+    EXPECT_LT(kaiser.coherent_gain, 0.5f);
+}
+
+// ============================================================================
+// Level Tests
+// ============================================================================
+
+TEST(WindowFunctionsTest, ToneLevelIndependentOfWindow) {
+    // Amplitude 0.5 on bin 100: 20·log10(0.5 / 2) with every window
+    const float expected = 20.0f * std::log10(0.25f);
+    for (WindowFunction window : ALL_WINDOWS) {
+        EXPECT_NEAR(peakDb(window, 100.0), expected, 0.01f) << toString(window);
+    }
+}
+
+TEST(WindowFunctionsTest, FlatTopHasNoScallopLoss) {
+    // Half a bin off: Hann loses ~1.4 dB, flat-top stays within 0.01 dB
+    const float expected = 20.0f * std::log10(0.25f);
+    EXPECT_LT(peakDb(WindowFunction::Hann, 100.5), expected - 1.0f);
+    EXPECT_NEAR(peakDb(WindowFunction::FlatTop, 100.5), expected, 0.02f);
+}
+
+TEST(WindowFunctionsTest, BlackmanHarrisSidelobesBelow90dB) {
+    FFTProcessor processor(FFT_SIZE, WindowFunction::BlackmanHarris);
+    processor.setExactLog10(true);
+    std::vector<float> spectrum(processor.getNumBins());
+    const std::vector<float> signal = sineAtBin(500.5);
+    processor.process(signal.data(), spectrum.data());
+
+    const float peak = *std::max_element(spectrum.begin(), spectrum.end());
+    for (size_t k = 0; k < spectrum.size(); ++k) {
+        if (k + 6 < 500 || k > 501 + 6) {
+            ASSERT_LT(spectrum[k], peak - 90.0f) << "bin " << k;
+        }
+    }
+}
+
+// ============================================================================
+// Chain Tests
+// ============================================================================
+
+TEST(WindowFunctionsTest, ChainsKeyOnKaiserBeta) {
+    SpectrogramSettings settings;
+    ASSERT_TRUE(settings.setWindow(WindowFunction::Kaiser, 5.0f));
+    EXPECT_FALSE(settings.setWindow(WindowFunction::Kaiser, -2.0f));
+    const ChainKey narrow = ChainKey::fromSettings(settings, 200);
+    EXPECT_EQ(narrow.kaiser_beta, 5.0f);
+
+    ASSERT_TRUE(settings.setWindow(WindowFunction::Kaiser, 12.0f));
+    const ChainKey wide = ChainKey::fromSettings(settings, 200);
+
+    ProcessingChainCache cache;
+    auto a = cache.acquire(narrow);
+    auto b = cache.acquire(wide);
+    EXPECT_NE(&a->fft(), &b->fft());
+    EXPECT_EQ(b->fft().getKaiserBeta(), 12.0f);
+
+    // β of another window does not split chains
+    settings.window_type = WindowFunction::Hann;
+    EXPECT_EQ(ChainKey::fromSettings(settings, 200).kaiser_beta, DEFAULT_KAISER_BETA);
+}
+
+TEST(WindowFunctionsTest, SlidingDftOnlyForTwoTermWindows) {
+    // As ProcessingChainTest.SlidingDFTOnlyForTinyHops: 2-sample hop
+    SpectrogramSettings settings;
+    settings.fft_size = 1024;
+    settings.freq_scale = FrequencyScale::Logarithmic;
+    settings.bin_aggregation = BinAggregation::Interpolate;
+    settings.overlap_percent = 99.8f;
+
+    ProcessingChainCache cache;
+    EXPECT_NE(cache.acquire(ChainKey::fromSettings(settings, 100))->slidingDFT(), nullptr);
+
+    settings.window_type = WindowFunction::BlackmanHarris;
+    EXPECT_EQ(cache.acquire(ChainKey::fromSettings(settings, 100))->slidingDFT(), nullptr);
+    EXPECT_THROW(SlidingDFT(4096, WindowFunction::FlatTop, 8, {10, 11}), std::invalid_argument);
+}
@@ -0,0 +1,256 @@
+/**
+ * @file zoom_analyzer_test.cpp
+ * @brief Unit tests for ZoomAnalyzer
+ *
+ * Tests cover:
+ * - Decimation choice per band and parameter validation
+ * - Tone frequency and level against FFTProcessor's scaling
+ * - Resolving tones closer than the largest plain FFT's bins
+ * - Alias rejection of the half-band cascade
+ * - Streaming updates equal to full-window restarts; gaps reseed
+ * - ProcessingChain integration
+ * - Throughput
+ */
+
+#include <gtest/gtest.h>
+#include <friture/zoom_analyzer.hpp>
+#include <friture/processing_chain.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace friture;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+ChainKey zoomKey(size_t fft_size, float min_freq, float max_freq) {
+    ChainKey key;
+    key.fft_size = fft_size;
+    key.scale = FrequencyScale::Linear;
+    key.min_freq = min_freq;
+    key.max_freq = max_freq;
+    key.sample_rate = 48000.0f;
+    key.height = 200;
+    key.aggregation = BinAggregation::PeakHold;
+    key.zoom = true;
+    return key;
+}
+
+std::vector<float> tones(const std::vector<std::pair<double, double>>& parts, size_t count) {
+    std::vector<float> samples(count, 0.0f);
+    for (size_t i = 0; i < count; ++i) {
+        double value = 0.0;
+        for (const auto& [frequency, amplitude] : parts) {
+            value += amplitude * std::sin(2.0 * PI * frequency * static_cast<double>(i) / 48000.0);
+        }
+        samples[i] = static_cast<float>(value);
+    }
+    return samples;
+}
+
+// Level of the strongest bin inside [low, high] Hz of the virtual spectrum
+float peakIn(const ZoomAnalyzer& zoom, double low, double high) {
+    const std::vector<float>& spectrum = zoom.getSpectrum();
+    const size_t first = static_cast<size_t>(std::ceil(low / zoom.getBinSpacing()));
+    const size_t last = static_cast<size_t>(std::floor(high / zoom.getBinSpacing()));
+    return *std::max_element(spectrum.begin() + first, spectrum.begin() + last + 1);
+}
+
+} // namespace
+
+// ============================================================================
+// Configuration Tests
+// ============================================================================
+
+TEST(ZoomAnalyzerTest, DecimationFollowsBandwidth) {
+    // 40-400 Hz at 48 kHz: D = 64 leaves ±300 Hz around the centre
+    EXPECT_EQ(ZoomAnalyzer::decimationFor(zoomKey(4096, 40.0f, 400.0f)), 64u);
+    EXPECT_EQ(ZoomAnalyzer::decimationFor(zoomKey(256, 40.0f, 400.0f)), 64u);
+    // 100 Hz wide: up to MAX_DECIMATION, limited by MAX_SPAN / fft_size
+    EXPECT_EQ(ZoomAnalyzer::decimationFor(zoomKey(1024, 1000.0f, 1100.0f)), 256u);
+    EXPECT_EQ(ZoomAnalyzer::decimationFor(zoomKey(4096, 1000.0f, 1100.0f)), 64u);
+    // Most of the spectrum: nothing to gain
+    EXPECT_EQ(ZoomAnalyzer::decimationFor(zoomKey(4096, 20.0f, 20000.0f)), 1u);
+}
+
+TEST(ZoomAnalyzerTest, RejectsWideBandsAndInvalidSizes) {
+    EXPECT_THROW(ZoomAnalyzer(zoomKey(4096, 20.0f, 20000.0f)), std::invalid_argument);
+    EXPECT_THROW(ZoomAnalyzer(zoomKey(100, 1000.0f, 1100.0f)), std::invalid_argument);
+}
+
+TEST(ZoomAnalyzerTest, LayoutMatchesDecimatedGrid) {
+    ZoomAnalyzer zoom(zoomKey(256, 1000.0f, 1100.0f));
+    const size_t d = zoom.getDecimation();
+    EXPECT_DOUBLE_EQ(zoom.getBinSpacing(), 48000.0 / static_cast<double>(d * 256));
+    EXPECT_NEAR(zoom.getCenterFrequency(), 1050.0, zoom.getBinSpacing());
+    EXPECT_GE(zoom.getWindowSize(), d * 256);
+    EXPECT_EQ(zoom.getSpectrum().size(), d * 256 / 2 + 1);
+    EXPECT_EQ(zoom.resampler().getOutputHeight(), 200u);
+}
+
+// ============================================================================
+// Accuracy Tests
+// ============================================================================
+
+TEST(ZoomAnalyzerTest, ToneAtRightFrequencyAndLevel) {
+    ZoomAnalyzer zoom(zoomKey(256, 1000.0f, 1100.0f));
+    const double spacing = zoom.getBinSpacing();
+
+    // On a zoom bin, amplitude 0.5
+    const double frequency = std::round(1037.0 / spacing) * spacing;
+    zoom.analyze(tones({{frequency, 0.5}}, zoom.getWindowSize()).data());
+
+    const std::vector<float>& spectrum = zoom.getSpectrum();
+    const auto peak = std::max_element(spectrum.begin(), spectrum.end());
+    EXPECT_NEAR(static_cast<double>(peak - spectrum.begin()) * spacing, frequency, 1e-6);
+
+    // FFTProcessor scaling: (A/2)², the window's coherent gain divided out
+    const double expected = 20.0 * std::log10(0.25);
+    EXPECT_NEAR(*peak, expected, 0.05);
+}
+
+TEST(ZoomAnalyzerTest, ResolvesTonesCloserThanLargestFFTBin) {
+    // 2.2 Hz apart: one bin of a 16384-point FFT at 48 kHz is 2.93 Hz
+    ZoomAnalyzer zoom(zoomKey(256, 1000.0f, 1100.0f));
+    const double spacing = zoom.getBinSpacing();
+    const double low = std::round(1050.0 / spacing) * spacing;
+    const double high = low + 3.0 * spacing;
+    zoom.analyze(tones({{low, 0.5}, {high, 0.5}}, zoom.getWindowSize()).data());
+
+    const float peak_low = peakIn(zoom, low - 0.1, low + 0.1);
+    const float peak_high = peakIn(zoom, high - 0.1, high + 0.1);
+    const float dip = peakIn(zoom, low + 1.4 * spacing, low + 1.6 * spacing);
+    EXPECT_GT(std::min(peak_low, peak_high) - dip, 3.0f);
+}
+
+TEST(ZoomAnalyzerTest, RejectsAliases) {
+    ZoomAnalyzer zoom(zoomKey(256, 1000.0f, 1100.0f));
+    const double rate_out = 48000.0 / static_cast<double>(zoom.getDecimation());
+
+    // Reference: a tone inside the band
+    zoom.analyze(tones({{1050.0, 0.5}}, zoom.getWindowSize()).data());
+    const float reference = peakIn(zoom, 1000.0, 1100.0);
+
+    // 0.75 × the output rate above the centre folds to 0.25 below it,
+    // i.e. into the displayed band, unless the last stage removed it
+    zoom.reset();
+    const double outside = zoom.getCenterFrequency() + 0.75 * rate_out;
+    zoom.analyze(tones({{outside, 0.5}}, zoom.getWindowSize()).data());
+    EXPECT_LT(peakIn(zoom, 1000.0, 1100.0) - reference, -70.0f);
+}
+
+// ============================================================================
+// Streaming Tests
+// ============================================================================
+
+TEST(ZoomAnalyzerTest, StreamingMatchesRestart) {
+    // 5-8 kHz: D = 8, and the 75 % hop of 64 is a multiple of it
+    ChainKey key = zoomKey(256, 5000.0f, 8000.0f);
+    ZoomAnalyzer streaming(key);
+    ZoomAnalyzer restarted(key);
+    ASSERT_EQ(streaming.getDecimation(), 8u);
+    const size_t hop = 64;
+    const size_t window = streaming.getWindowSize();
+
+    std::mt19937 rng(11);
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    std::vector<float> signal = tones({{5500.0, 0.3}, {7321.5, 0.1}}, window + 40 * hop);
+    for (float& sample : signal) {
+        sample += noise(rng);
+    }
+
+    for (size_t c = 0; c <= 40; ++c) {
+        const float* frame = signal.data() + c * hop;
+        streaming.analyze(frame);
+        restarted.reset();
+        restarted.analyze(frame);
+
+        const std::vector<float>& a = streaming.getSpectrum();
+        const std::vector<float>& b = restarted.getSpectrum();
+        for (size_t k = 0; k < a.size(); ++k) {
+            if (b[k] > -100.0f) {
+                ASSERT_NEAR(a[k], b[k], 0.01f) << "column " << c << " bin " << k;
+            }
+        }
+    }
+    EXPECT_EQ(streaming.getReseedCount(), 1u);
+    EXPECT_EQ(restarted.getReseedCount(), 41u);
+}
+
+TEST(ZoomAnalyzerTest, GapReseeds) {
+    ZoomAnalyzer zoom(zoomKey(256, 5000.0f, 8000.0f));
+    const size_t hop = 64;
+    std::vector<float> signal = tones({{6000.0, 0.5}}, zoom.getWindowSize() + 10 * hop);
+
+    zoom.analyze(signal.data());
+    zoom.analyze(signal.data() + hop);
+    EXPECT_EQ(zoom.getReseedCount(), 1u);
+
+    // Skipped columns: the window no longer continues the previous one
+    zoom.analyze(signal.data() + 5 * hop);
+    EXPECT_EQ(zoom.getReseedCount(), 2u);
+    EXPECT_NEAR(peakIn(zoom, 5990.0, 6010.0), 20.0f * std::log10(0.25f), 0.1f);
+}
+
+// ============================================================================
+// Chain Integration Tests
+// ============================================================================
+
+TEST(ZoomAnalyzerTest, ChainUsesZoomForNarrowBands) {
+    ProcessingChainCache cache;
+
+    ChainKey narrow = zoomKey(256, 40.0f, 400.0f);
+    narrow.multi_resolution = true;   // Zoom takes precedence
+    auto chain = cache.acquire(narrow);
+    ASSERT_NE(chain->zoom(), nullptr);
+    EXPECT_EQ(chain->multiResolution(), nullptr);
+    EXPECT_EQ(chain->getWindowSize(), chain->zoom()->getWindowSize());
+    EXPECT_EQ(chain->fft_input.size(), chain->getWindowSize());
+
+    // Too wide to zoom: the plain FFT path
+    auto wide = cache.acquire(zoomKey(256, 20.0f, 20000.0f));
+    EXPECT_EQ(wide->zoom(), nullptr);
+    EXPECT_EQ(wide->getWindowSize(), 256u);
+
+    // Off unless asked for
+    ChainKey plain = narrow;
+    plain.zoom = false;
+    plain.multi_resolution = false;
+    EXPECT_EQ(cache.acquire(plain)->zoom(), nullptr);
+}
+
+// ============================================================================
+// Performance Tests
+// ============================================================================
+
+TEST(ZoomAnalyzerTest, PerformanceRealtimeFactor) {
+    // 40-400 Hz vibration band, 10 s of audio in back-to-back frames
+    ChainKey key = zoomKey(1024, 40.0f, 400.0f);
+    key.overlap_percent = 0.0f;
+    ZoomAnalyzer zoom(key);
+    const size_t hop = 1024;
+    const size_t columns = 10 * 48000 / hop;
+    std::vector<float> signal = tones({{123.4, 0.5}}, zoom.getWindowSize() + columns * hop);
+
+    zoom.analyze(signal.data());
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t c = 1; c <= columns; ++c) {
+        zoom.analyze(signal.data() + c * hop);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    EXPECT_EQ(zoom.getReseedCount(), 1u);
+    // Far faster than real time even unoptimized
+    EXPECT_LT(ms, 1000.0);
+
+    std::cout << "\n=== Zoom 40-400 Hz, D = " << zoom.getDecimation() << ", "
+              << zoom.getBinSpacing() << " Hz bins ===\n";
+    std::cout << "10 s of audio: " << ms << " ms (" << 10000.0 / ms << "x real time)\n";
+}